@@ -78,7 +78,9 @@ from _babase import (
     mac_music_app_play_playlist,
     mac_music_app_set_volume,
     mac_music_app_stop,
+    mark_app_ready,
     menu_press,
+    mesh_load_benchmark,
     music_player_play,
     music_player_set_volume,
     music_player_shutdown,
@@ -110,6 +112,11 @@ from _babase import (
     shutdown_suppress_end,
     shutdown_suppress_count,
     SimpleSound,
+    startup_report,
+    step_profile_entries,
+    step_profile_report,
+    step_profile_start,
+    step_profile_stop,
     supports_max_fps,
     supports_vsync,
     supports_unicode_display,
@@ -311,7 +318,9 @@ __all__ = [
     'mac_music_app_set_volume',
     'mac_music_app_stop',
     'MapNotFoundError',
+    'mark_app_ready',
     'menu_press',
+    'mesh_load_benchmark',
     'MetadataSubsystem',
     'music_player_play',
     'music_player_set_volume',
@@ -358,6 +367,11 @@ __all__ = [
     'shutdown_suppress_count',
     'SimpleSound',
     'SpecialChar',
+    'startup_report',
+    'step_profile_entries',
+    'step_profile_report',
+    'step_profile_start',
+    'step_profile_stop',
     'storagename',
     'StringEditAdapter',
     'StringEditSubsystem',
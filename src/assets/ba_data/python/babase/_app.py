@@ -811,6 +811,8 @@ class App:
         self.health = self.register_subsystem(AppHealthSubsystem())
         self.net = NetworkSubsystem()
 
+        _babase.startup_phase_begin('py-app-subsystems')
+
         # __FEATURESET_APP_SUBSYSTEM_CREATE_BEGIN__
         # This section generated by batools.appmodule; do not edit.
 
@@ -821,6 +823,8 @@ class App:
 
         # __FEATURESET_APP_SUBSYSTEM_CREATE_END__
 
+        _babase.startup_phase_end('py-app-subsystems')
+
         # We're a pretty short-lived state. This should flip us to
         # 'loading'.
         self._init_completed = True
@@ -837,6 +841,9 @@ class App:
         """
         assert _babase.in_logic_thread()
 
+        # Covers sign-in and meta-scan; ends when we hit 'running'.
+        _babase.startup_phase_begin('py-loading')
+
         # Get meta-system scanning built-in stuff in the bg.
         self.meta.start_scan(scan_complete_cb=self._on_meta_scan_complete)
 
@@ -876,6 +883,21 @@ class App:
         """
         assert _babase.in_logic_thread()
 
+        _babase.startup_phase_end('py-loading')
+
+        # Startup is over as far as imports are concerned; hand over the
+        # slow ones to show up in the timeline.
+        import baenv
+
+        import_timings, clock_now = baenv.pop_import_timings()
+        _babase.startup_phases_add(
+            [
+                (f'import:{name}', thread, start, end)
+                for name, thread, start, end in import_timings
+            ],
+            clock_now,
+        )
+
         # Let our native layer know.
         _babase.on_app_running()
 
@@ -0,0 +1,183 @@
+# Released under the MIT License. See LICENSE for details.
+#
+"""Prefork server support.
+
+In prefork mode a parent process brings up Python and imports our
+modules once and then forks off a worker on request. This exists to make
+server restarts fast: a new worker skips interpreter startup and most
+module imports. It is not a way to pack several servers into shared
+memory; a parent serves a single server config (the server manager runs
+one per server) and only warms up Python, so assets and such still get
+loaded by each worker.
+
+Requests come in over a unix socket. A client sends a json request
+along with 3 file descriptors which become the worker's
+stdin/stdout/stderr. The parent replies with a json line containing the
+worker's pid, and later another with its exit code once it finishes.
+The request may contain an 'env' dict of environment variables to set
+in the worker. A request of {"stop": true} (with no fds) shuts the
+parent down; killing it works too. Workers are unaffected either way.
+"""
+
+from __future__ import annotations
+
+import os
+import sys
+import json
+import logging
+from typing import TYPE_CHECKING
+
+if TYPE_CHECKING:
+    import socket
+
+# Modules imported in the parent so workers don't each have to. Anything
+# failing to import here is simply left for workers to import.
+PREFORK_IMPORTS = [
+    'bascenev1',
+    'baclassic',
+    'bascenev1lib.actor.spaz',
+]
+
+# Largest request we accept.
+_MAX_REQUEST_SIZE = 65536
+
+
+def serve(control_path: str) -> bool:
+    """Serve worker requests until told to stop.
+
+    Returns True in forked workers and False in the parent.
+    """
+    # pylint: disable=too-many-locals
+    import gc
+    import select
+    import socket
+    import importlib
+
+    if not hasattr(os, 'fork'):
+        raise RuntimeError('Prefork mode is not supported on this platform.')
+
+    for modname in PREFORK_IMPORTS:
+        try:
+            importlib.import_module(modname)
+        except Exception:
+            logging.warning(
+                'Prefork parent unable to import %s.', modname, exc_info=True
+            )
+
+    listener = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+    if os.path.exists(control_path):
+        os.unlink(control_path)
+    listener.bind(control_path)
+    listener.listen(16)
+
+    # Move everything we've got into the permanent generation so gc
+    # passes in workers don't have to wade through (and copy) everything
+    # they inherited.
+    gc.collect()
+    gc.freeze()
+
+    logging.info("Prefork parent serving workers at '%s'.", control_path)
+
+    workers: dict[int, socket.socket] = {}
+    try:
+        while True:
+            _reap_workers(workers)
+            readable, _, _ = select.select([listener], [], [], 0.25)
+            if not readable:
+                continue
+            conn, _ = listener.accept()
+            try:
+                msg, fds, _flags, _addr = socket.recv_fds(
+                    conn, _MAX_REQUEST_SIZE, 3
+                )
+                request = json.loads(msg.decode())
+                if request.get('stop', False):
+                    conn.close()
+                    break
+                if len(fds) != 3:
+                    raise RuntimeError(f'Expected 3 fds; got {len(fds)}.')
+                env = request.get('env', {})
+                if not isinstance(env, dict):
+                    raise TypeError('Expected env to be a dict.')
+            except Exception:
+                logging.exception('Invalid prefork worker request.')
+                conn.close()
+                continue
+
+            pid = _fork()
+            if pid == 0:
+                # We're the worker. Drop everything belonging to the
+                # parent and take on the requested stdio.
+                listener.close()
+                conn.close()
+                for wconn in workers.values():
+                    wconn.close()
+                for i, fd in enumerate(fds):
+                    os.dup2(fd, i)
+                    os.close(fd)
+                os.environ.update({str(k): str(v) for k, v in env.items()})
+                _restart_log_handler()
+                return True
+
+            for fd in fds:
+                os.close(fd)
+            try:
+                conn.sendall(json.dumps({'pid': pid}).encode() + b'\n')
+            except OSError:
+                pass
+            workers[pid] = conn
+            logging.info('Prefork parent spawned worker %d.', pid)
+    except KeyboardInterrupt:
+        pass
+
+    # Workers keep running on their own; we just stop handing out new
+    # ones.
+    listener.close()
+    os.unlink(control_path)
+    for conn in workers.values():
+        conn.close()
+    logging.info('Prefork parent shutting down.')
+    return False
+
+
+def _fork() -> int:
+    import warnings
+
+    # Make sure nothing buffered gets written twice.
+    sys.stdout.flush()
+    sys.stderr.flush()
+
+    # Python warns about forking with threads running. Our only other
+    # thread at this point is the log handler's, which we restart in
+    # the child.
+    with warnings.catch_warnings():
+        warnings.simplefilter('ignore', DeprecationWarning)
+        return os.fork()
+
+
+def _reap_workers(workers: dict[int, socket.socket]) -> None:
+    while workers:
+        try:
+            pid, status = os.waitpid(-1, os.WNOHANG)
+        except ChildProcessError:
+            return
+        if pid == 0:
+            return
+        conn = workers.pop(pid, None)
+        if conn is None:
+            continue
+        code = os.waitstatus_to_exitcode(status)
+        logging.info('Prefork worker %d exited with code %d.', pid, code)
+        try:
+            conn.sendall(json.dumps({'exit': code}).encode() + b'\n')
+        except OSError:
+            pass
+        conn.close()
+
+
+def _restart_log_handler() -> None:
+    import baenv
+
+    log_handler = baenv.get_env_config().log_handler
+    if log_handler is not None:
+        log_handler.reinit_after_fork()
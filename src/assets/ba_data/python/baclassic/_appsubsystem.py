@@ -581,6 +581,80 @@ class ClassicAppSubsystem(babase.AppSubsystem):
 
         run_media_reload_benchmark()
 
+    def run_mesh_load_benchmark(self, iterations: int = 3) -> dict[str, Any]:
+        """Time loading all shipped meshes; returns results."""
+        from baclassic._benchmark import run_mesh_load_benchmark
+
+        return run_mesh_load_benchmark(iterations=iterations)
+
+    def run_bot_benchmark(
+        self,
+        *,
+        map_name: str = 'Courtyard',
+        bot_count: int = 16,
+        duration: float = 20.0,
+        navigation: bool = True,
+    ) -> None:
+        """Time bot AI updates with a crowd of bots on a map."""
+        from baclassic._benchmark import run_bot_benchmark
+
+        run_bot_benchmark(
+            map_name=map_name,
+            bot_count=bot_count,
+            duration=duration,
+            navigation=navigation,
+        )
+
+    def run_determinism_check(
+        self,
+        *,
+        map_name: str = 'Courtyard',
+        bot_count: int = 8,
+        duration: float = 10.0,
+        seed: int = 1234,
+    ) -> None:
+        """Run a seeded session twice and log where their states diverge."""
+        from baclassic._benchmark import run_determinism_check
+
+        run_determinism_check(
+            map_name=map_name,
+            bot_count=bot_count,
+            duration=duration,
+            seed=seed,
+        )
+
+    def run_snapshot_benchmark(
+        self,
+        *,
+        map_name: str = 'Courtyard',
+        player_count: int = 8,
+        iterations: int = 100,
+    ) -> None:
+        """Time scene snapshots and restores in a busy scene."""
+        from baclassic._benchmark import run_snapshot_benchmark
+
+        run_snapshot_benchmark(
+            map_name=map_name,
+            player_count=player_count,
+            iterations=iterations,
+        )
+
+    def run_rest_benchmark(
+        self,
+        *,
+        map_name: str = 'Courtyard',
+        object_count: int = 80,
+        duration: float = 5.0,
+    ) -> None:
+        """Time scene steps on a map littered with resting objects."""
+        from baclassic._benchmark import run_rest_benchmark
+
+        run_rest_benchmark(
+            map_name=map_name,
+            object_count=object_count,
+            duration=duration,
+        )
+
     def run_stress_test(
         self,
         *,
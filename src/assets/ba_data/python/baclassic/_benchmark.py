@@ -9,10 +9,11 @@ from typing import TYPE_CHECKING, override
 
 import babase
 import bascenev1
+import _babase
 import _baclassic
 
 if TYPE_CHECKING:
-    from typing import Any, Sequence
+    from typing import Any, Callable, Sequence
 
 
 def run_cpu_benchmark() -> None:
@@ -53,6 +54,516 @@ def run_cpu_benchmark() -> None:
     bascenev1.new_host_session(BenchmarkSession, benchmark_type='cpu')
 
 
+def run_mesh_load_benchmark(iterations: int = 3) -> dict[str, Any]:
+    """Time loading all shipped meshes with and without memory-mapping.
+
+    Results are logged and returned.
+    """
+    import os
+    import logging
+
+    meshdir = os.path.join(babase.app.env.data_directory, 'ba_data', 'meshes')
+    paths = (
+        sorted(
+            os.path.join(meshdir, name)
+            for name in os.listdir(meshdir)
+            if name.endswith('.bob')
+        )
+        if os.path.isdir(meshdir)
+        else []
+    )
+    results: dict[str, Any] = {}
+    for mode, mapped in (('read', False), ('mapped', True)):
+        results[mode] = result = babase.mesh_load_benchmark(
+            paths, iterations=iterations, mapped=mapped
+        )
+        logging.info(
+            'Mesh load benchmark (%s): %d files, %d bytes in %.4fs.',
+            mode,
+            result['files'],
+            result['bytes'],
+            result['seconds'],
+        )
+    return results
+
+
+def run_bot_benchmark(
+    map_name: str = 'Courtyard',
+    bot_count: int = 16,
+    duration: float = 20.0,
+    navigation: bool = True,
+) -> None:
+    """Time bot AI updates with a crowd of bots on a map.
+
+    Bots wander between the map's spawn points for the given duration
+    and the time spent in bot updates is then logged. Needs no players or
+    graphics, so works in headless builds too.
+    """
+    # pylint: disable=cyclic-import
+    import time
+    import logging
+
+    from bascenev1lib.actor.spazbot import SpazBotSet, BrawlerBot
+
+    class TimedBotSet(SpazBotSet):
+        """Bot-set keeping track of how long its updates take."""
+
+        update_seconds = 0.0
+        update_count = 0
+
+        @override
+        def _update(self) -> None:
+            start = time.perf_counter()
+            super()._update()
+            self.update_seconds += time.perf_counter() - start
+            self.update_count += 1
+
+    class BotBenchmarkGame(
+        bascenev1.GameActivity[bascenev1.Player, bascenev1.Team]
+    ):
+        """Game that just runs bots around a map."""
+
+        def __init__(self, settings: dict) -> None:
+            super().__init__(settings)
+            self._bots: TimedBotSet | None = None
+            self._retarget_timer: bascenev1.Timer | None = None
+            self._end_timer: bascenev1.Timer | None = None
+
+        @override
+        def on_begin(self) -> None:
+            super().on_begin()
+            self._bots = TimedBotSet(navigation=navigation)
+            points = self.map.ffa_spawn_points
+            for i in range(bot_count):
+                self._bots.spawn_bot(
+                    BrawlerBot, pos=points[i % len(points)][:3], spawn_time=0.1
+                )
+            self._retarget_timer = bascenev1.Timer(
+                3.0, self._retarget, repeat=True
+            )
+            self._end_timer = bascenev1.Timer(duration, self._finish)
+
+        def _retarget(self) -> None:
+            assert self._bots is not None
+            points = self.map.ffa_spawn_points
+            for bot in self._bots.get_living_bots():
+                bot.target_point_default = bascenev1.Vec3(
+                    random.choice(points)[:3]
+                )
+
+        def _finish(self) -> None:
+            assert self._bots is not None
+            count = max(1, self._bots.update_count)
+            logging.info(
+                'Bot benchmark (%s, %d bots, navigation %s): %d updates,'
+                ' %.3fms average.',
+                map_name,
+                bot_count,
+                'on' if navigation else 'off',
+                self._bots.update_count,
+                1000.0 * self._bots.update_seconds / count,
+            )
+            self._bots.clear()
+            self.session.end()
+
+    class BotBenchmarkSession(bascenev1.Session):
+        """Session type for the bot benchmark."""
+
+        def __init__(self) -> None:
+            super().__init__([])
+            self.setactivity(
+                bascenev1.newactivity(BotBenchmarkGame, {'map': map_name})
+            )
+
+        @override
+        def on_player_request(self, player: bascenev1.SessionPlayer) -> bool:
+            return False
+
+    bascenev1.new_host_session(BotBenchmarkSession)
+
+
+def run_determinism_check(
+    map_name: str = 'Courtyard',
+    bot_count: int = 8,
+    duration: float = 10.0,
+    seed: int = 1234,
+) -> None:
+    """Run the same scripted session twice and compare state each step.
+
+    Bots brawl on a map while bombs drop at random spots; everything is
+    seeded so both runs get identical inputs. A hash of node attributes
+    and rigid body states is recorded after every step of each run and
+    the first step where the runs diverge is logged along with the nodes
+    that differ. Needs no players or graphics, so works in headless
+    builds too.
+    """
+    # pylint: disable=cyclic-import
+    import logging
+
+    from bascenev1lib.actor.bomb import Bomb
+    from bascenev1lib.actor.spazbot import SpazBotSet, BrawlerBot
+
+    logs: list[dict[str, Any]] = []
+
+    class DeterminismGame(
+        bascenev1.GameActivity[bascenev1.Player, bascenev1.Team]
+    ):
+        """Game running seeded bots and bombs around a map."""
+
+        def __init__(self, settings: dict) -> None:
+            super().__init__(settings)
+            self._bots: SpazBotSet | None = None
+            self._bomb_timer: bascenev1.Timer | None = None
+            self._end_timer: bascenev1.Timer | None = None
+
+        @override
+        def on_transition_in(self) -> None:
+            bascenev1.begin_state_hash_log(per_node=True, seed=seed)
+            super().on_transition_in()
+
+        @override
+        def on_begin(self) -> None:
+            super().on_begin()
+            self._bots = SpazBotSet()
+            points = self.map.ffa_spawn_points
+            for i in range(bot_count):
+                self._bots.spawn_bot(
+                    BrawlerBot, pos=points[i % len(points)][:3], spawn_time=0.1
+                )
+            self._bomb_timer = bascenev1.Timer(
+                0.5, self._drop_bomb, repeat=True
+            )
+            self._end_timer = bascenev1.Timer(duration, self._finish)
+
+        def _drop_bomb(self) -> None:
+            point = random.choice(self.map.ffa_spawn_points)
+            Bomb(
+                position=(
+                    point[0] + random.uniform(-2.0, 2.0),
+                    point[1] + 4.0,
+                    point[2] + random.uniform(-2.0, 2.0),
+                ),
+                velocity=(random.uniform(-3.0, 3.0), 0.0, 0.0),
+            ).autoretain()
+
+        def _finish(self) -> None:
+            log = bascenev1.end_state_hash_log()
+            assert log is not None
+            logs.append(log)
+            assert self._bots is not None
+            self._bots.clear()
+            self.session.end()
+            if len(logs) == 1:
+                with babase.ContextRef.empty():
+                    babase.apptimer(
+                        1.0,
+                        babase.Call(
+                            babase.pushcall,
+                            babase.Call(
+                                bascenev1.new_host_session, DeterminismSession
+                            ),
+                        ),
+                    )
+            else:
+                _report_state_divergence(logs[0], logs[1])
+
+    class DeterminismSession(bascenev1.Session):
+        """Session type for the determinism check."""
+
+        def __init__(self) -> None:
+            super().__init__([])
+            random.seed(seed)
+            self.setactivity(
+                bascenev1.newactivity(DeterminismGame, {'map': map_name})
+            )
+
+        @override
+        def on_player_request(self, player: bascenev1.SessionPlayer) -> bool:
+            return False
+
+    logging.info(
+        'Determinism check (%s, %d bots, seed %d): running twice...',
+        map_name,
+        bot_count,
+        seed,
+    )
+    bascenev1.new_host_session(DeterminismSession)
+
+
+def _report_state_divergence(
+    first: dict[str, Any], second: dict[str, Any], max_nodes: int = 10
+) -> None:
+    """Log where two state hash logs first disagree (if anywhere)."""
+    import logging
+
+    steps1 = first['steps']
+    steps2 = second['steps']
+    for (step1, hash1, nodes1), (step2, hash2, nodes2) in zip(
+        steps1, steps2
+    ):
+        if step1 == step2 and hash1 == hash2:
+            continue
+        if step1 != step2:
+            logging.warning(
+                'Determinism check: runs diverged at step %d (step numbers'
+                ' differ: %d vs %d).',
+                min(step1, step2),
+                step1,
+                step2,
+            )
+            return
+        diffs = [
+            node_id
+            for node_id in sorted(set(nodes1) | set(nodes2))
+            if nodes1.get(node_id) != nodes2.get(node_id)
+        ]
+        lines = []
+        for node_id in diffs[:max_nodes]:
+            desc = first['nodes'].get(node_id) or second['nodes'].get(node_id)
+            if node_id not in nodes1 or node_id not in nodes2:
+                which = 'first' if node_id in nodes1 else 'second'
+                lines.append(f'  {desc} (only in {which} run)')
+            else:
+                lines.append(f'  {desc}')
+        if len(diffs) > max_nodes:
+            lines.append(f'  ...and {len(diffs) - max_nodes} more')
+        logging.warning(
+            'Determinism check: runs diverged at step %d; %d node(s)'
+            ' differ:\n%s',
+            step1,
+            len(diffs),
+            '\n'.join(lines),
+        )
+        return
+    if len(steps1) != len(steps2):
+        logging.warning(
+            'Determinism check: runs matched but lasted different numbers'
+            ' of steps (%d vs %d).',
+            len(steps1),
+            len(steps2),
+        )
+        return
+    logging.info(
+        'Determinism check: runs matched for all %d steps.', len(steps1)
+    )
+
+
+def run_snapshot_benchmark(
+    map_name: str = 'Courtyard',
+    player_count: int = 8,
+    iterations: int = 100,
+) -> None:
+    """Time scene snapshots and restores in a busy scene.
+
+    Bots standing in for a full party of players brawl on a map with
+    bombs going off. After a few seconds, full snapshot, incremental
+    snapshot and restore times are logged along with snapshot sizes.
+    Restores are refused while a replay is being recorded or clients
+    are connected, so run this in a headless build with nobody joined.
+    """
+    # pylint: disable=cyclic-import
+    import time
+    import logging
+
+    from bascenev1lib.actor.bomb import Bomb
+    from bascenev1lib.actor.spazbot import SpazBotSet, BrawlerBot
+
+    def timed(call: Callable[[], Any]) -> tuple[float, Any]:
+        result: Any = None
+        start = time.perf_counter()
+        for _i in range(iterations):
+            result = call()
+        return 1000.0 * (time.perf_counter() - start) / iterations, result
+
+    class SnapshotBenchmarkGame(
+        bascenev1.GameActivity[bascenev1.Player, bascenev1.Team]
+    ):
+        """Game keeping a crowd busy while we snapshot it."""
+
+        def __init__(self, settings: dict) -> None:
+            super().__init__(settings)
+            self._bots: SpazBotSet | None = None
+            self._base: bytes | None = None
+            self._timers: list[bascenev1.Timer] = []
+
+        @override
+        def on_begin(self) -> None:
+            super().on_begin()
+            self._bots = SpazBotSet()
+            points = self.map.ffa_spawn_points
+            for i in range(player_count):
+                self._bots.spawn_bot(
+                    BrawlerBot, pos=points[i % len(points)][:3], spawn_time=0.1
+                )
+            self._timers = [
+                bascenev1.Timer(0.5, self._drop_bomb, repeat=True),
+                bascenev1.Timer(4.0, self._take_base),
+                bascenev1.Timer(4.5, self._measure),
+            ]
+
+        def _drop_bomb(self) -> None:
+            point = random.choice(self.map.ffa_spawn_points)
+            Bomb(position=(point[0], point[1] + 4.0, point[2])).autoretain()
+
+        def _take_base(self) -> None:
+            self._base = bascenev1.snapshot_scene()
+
+        def _measure(self) -> None:
+            base = self._base
+            assert base is not None
+            full_ms, full = timed(bascenev1.snapshot_scene)
+            changed_ms, _ = timed(lambda: bascenev1.snapshot_scene(base))
+            same_ms, _ = timed(lambda: bascenev1.snapshot_scene(full))
+            start = time.perf_counter()
+            changed = 0
+            for _i in range(iterations):
+                changed = bascenev1.restore_scene_snapshot(base)
+                bascenev1.restore_scene_snapshot(full)
+            restore_ms = 500.0 * (time.perf_counter() - start) / iterations
+            round_trip = bascenev1.get_snapshot_hash(
+                bascenev1.snapshot_scene()
+            ) == bascenev1.get_snapshot_hash(full)
+            logging.info(
+                'Snapshot benchmark (%s, %d players, %d nodes):'
+                ' %d bytes; full snapshot %.3fms, incremental %.3fms'
+                ' (0.5s of changes) / %.3fms (no changes), restore %.3fms'
+                ' (%d nodes changed); round trip %s.',
+                map_name,
+                player_count,
+                len(bascenev1.getnodes()),
+                len(full),
+                full_ms,
+                changed_ms,
+                same_ms,
+                restore_ms,
+                changed,
+                'matched' if round_trip else 'DID NOT MATCH',
+            )
+            assert self._bots is not None
+            self._bots.clear()
+            self._timers = []
+            self.session.end()
+
+    class SnapshotBenchmarkSession(bascenev1.Session):
+        """Session type for the snapshot benchmark."""
+
+        def __init__(self) -> None:
+            super().__init__([])
+            self.setactivity(
+                bascenev1.newactivity(SnapshotBenchmarkGame, {'map': map_name})
+            )
+
+        @override
+        def on_player_request(self, player: bascenev1.SessionPlayer) -> bool:
+            return False
+
+    bascenev1.new_host_session(SnapshotBenchmarkSession)
+
+
+def run_rest_benchmark(
+    map_name: str = 'Courtyard',
+    object_count: int = 80,
+    duration: float = 5.0,
+) -> None:
+    """Time scene steps with a map littered with resting objects.
+
+    A pile of tnt boxes is dropped around the map's spawn points. Scene
+    step times and sleeping body counts are logged once while everything
+    is still settling and again after it has had time to come to rest.
+    Needs no players or graphics, so works in headless builds too.
+    """
+    # pylint: disable=cyclic-import
+    import logging
+
+    import _bascenev1
+    from bascenev1lib.actor.bomb import Bomb
+
+    def step_ms() -> float:
+        for entry in babase.step_profile_entries():
+            if entry['category'] == 'scene step':
+                return 1000.0 * entry['total'] / max(1, entry['count'])
+        return 0.0
+
+    class RestBenchmarkGame(
+        bascenev1.GameActivity[bascenev1.Player, bascenev1.Team]
+    ):
+        """Game that drops a pile of boxes and watches them settle."""
+
+        def __init__(self, settings: dict) -> None:
+            super().__init__(settings)
+            self._boxes: list[Bomb] = []
+            self._settling: tuple[float, dict[str, int]] | None = None
+            self._timers: list[bascenev1.Timer] = []
+
+        @override
+        def on_begin(self) -> None:
+            super().on_begin()
+            points = self.map.ffa_spawn_points
+            for i in range(object_count):
+                point = points[i % len(points)]
+                self._boxes.append(
+                    Bomb(
+                        bomb_type='tnt',
+                        position=(
+                            point[0] + random.uniform(-2.0, 2.0),
+                            point[1] + 1.0 + 1.5 * (i // len(points)),
+                            point[2] + random.uniform(-2.0, 2.0),
+                        ),
+                    )
+                )
+            babase.step_profile_start()
+            self._timers = [
+                bascenev1.Timer(1.0, self._take_settling),
+                bascenev1.Timer(1.0 + duration, self._finish),
+            ]
+
+        def _take_settling(self) -> None:
+            self._settling = (step_ms(), _bascenev1.get_dynamics_stats())
+            babase.step_profile_start()
+
+        def _finish(self) -> None:
+            assert self._settling is not None
+            settling_ms, settling = self._settling
+            resting_ms, resting = step_ms(), _bascenev1.get_dynamics_stats()
+            babase.step_profile_stop()
+            logging.info(
+                'Rest benchmark (%s, %d objects): settling %.3fms/step'
+                ' (%d of %d bodies asleep, %d contacts); resting'
+                ' %.3fms/step (%d of %d bodies asleep, %d contacts).',
+                map_name,
+                object_count,
+                settling_ms,
+                settling['sleeping'],
+                settling['bodies'],
+                settling['contacts'],
+                resting_ms,
+                resting['sleeping'],
+                resting['bodies'],
+                resting['contacts'],
+            )
+            for box in self._boxes:
+                if box.node:
+                    box.node.delete()
+            self._boxes = []
+            self._timers = []
+            self.session.end()
+
+    class RestBenchmarkSession(bascenev1.Session):
+        """Session type for the rest benchmark."""
+
+        def __init__(self) -> None:
+            super().__init__([])
+            self.setactivity(
+                bascenev1.newactivity(RestBenchmarkGame, {'map': map_name})
+            )
+
+        @override
+        def on_player_request(self, player: bascenev1.SessionPlayer) -> bool:
+            return False
+
+    bascenev1.new_host_session(RestBenchmarkSession)
+
+
 @dataclass
 class _StressTestArgs:
     playlist_type: str
@@ -161,9 +672,22 @@ def _update_attract_mode_test(args: _StressTestArgs) -> None:
 
 
 def _reset_stress_test(args: _StressTestArgs) -> None:
+    import logging
+
     _baclassic.set_stress_testing(False, args.player_count, False)
     if not args.attract_mode:
         babase.screenmessage('Resetting stress test...')
+
+        # Note how much bg-dynamics got scaled back over the round.
+        bgstats = _babase.bg_dynamics_stats(reset=True)
+        if bgstats is not None:
+            logging.info(
+                'Stress test bg-dynamics: created %d of %d requested;'
+                ' load scale %.2f.',
+                bgstats['created'],
+                bgstats['requested'],
+                bgstats['load_scale'],
+            )
     session = bascenev1.get_foreground_host_session()
     assert session is not None
     session.end()
@@ -96,6 +96,7 @@ class ServerController:
         self._prep_timer: babase.AppTimer | None = None
         self._next_stuck_login_warn_time = time.time() + 10.0
         self._first_run = True
+        self._signaled_ready = False
         self._shutdown_reason: ShutdownReason | None = None
         self._executing_shutdown = False
 
@@ -328,6 +329,30 @@ class ServerController:
             f'Invalid session_type: "{self._config.session_type}"'
         )
 
+    def _signal_ready(self) -> None:
+        """Note that we're up and hosting."""
+        import json
+
+        readytime = babase.mark_app_ready('server')
+        logging.info('Server ready in %.2fs.', readytime)
+        logging.getLogger('ba.lifecycle').debug(
+            'Startup timeline:\n%s', babase.startup_report()
+        )
+        if self._config.ready_file is not None:
+            try:
+                with open(
+                    self._config.ready_file, 'w', encoding='utf-8'
+                ) as outfile:
+                    json.dump(
+                        {'ready_seconds': readytime, 'time': time.time()},
+                        outfile,
+                    )
+            except Exception:
+                logging.exception(
+                    'Error writing ready-file \'%s\'.',
+                    self._config.ready_file,
+                )
+
     def _launch_server_session(self) -> None:
         """Kick off a host-session based on the current server config."""
         # pylint: disable=too-many-branches
@@ -416,6 +441,18 @@ class ServerController:
             self._config.enable_default_kick_voting
         )
         bascenev1.set_admins(self._config.admins)
+        # (Unset limits are passed as zero, which means no limit).
+        bascenev1.set_client_limits(
+            process_ms_per_second=(
+                self._config.client_process_ms_per_second or 0.0
+            ),
+            bytes_in_per_second=self._config.client_bytes_in_per_second or 0,
+            messages_in_per_second=(
+                self._config.client_messages_in_per_second or 0
+            ),
+            strikes_to_kick=self._config.client_limit_strikes_to_kick,
+            ban_seconds=self._config.client_limit_ban_seconds,
+        )
 
         # Call set-enabled last (will push state to the cloud).
         bascenev1.set_public_party_max_size(self._config.max_party_size)
@@ -452,6 +489,10 @@ class ServerController:
         else:
             bascenev1.new_host_session(sessiontype)
 
+        if not self._signaled_ready:
+            self._signal_ready()
+            self._signaled_ready = True
+
         # Run an access check if we're trying to make a public party.
         if not self._ran_access_check and self._config.party_is_public:
             self._run_access_check()
@@ -21,13 +21,16 @@ import sys
 import time
 import random
 import logging
+import threading
 from pathlib import Path
 from dataclasses import dataclass
 from typing import TYPE_CHECKING
 import __main__
 
 if TYPE_CHECKING:
-    from typing import Any, Callable
+    from typing import Any, Callable, Sequence
+    from types import ModuleType
+    from importlib.machinery import ModuleSpec
 
     from efro.logging import LogHandler
 
@@ -115,6 +118,7 @@ class _EnvGlobals:
     called_configure: bool = False
     paths_set_failed: bool = False
     modular_main_called: bool = False
+    import_timer: _ImportTimer | None = None
 
     @classmethod
     def get(cls) -> _EnvGlobals:
@@ -152,7 +156,9 @@ def get_env_config() -> EnvConfig:
     # paths to run Ballistica apps should be explicitly calling
     # configure() first to get a full featured setup.
     if not envglobals.called_configure:
-        configure(setup_logging=False, setup_pycache_prefix=False)
+        configure(
+            setup_logging=False, setup_pycache_prefix=False, time_imports=False
+        )
 
     config = envglobals.config
     if config is None:
@@ -175,12 +181,17 @@ def configure(
     setup_logging: bool = True,
     setup_pycache_prefix: bool = False,
     strict_threads_atexit: Callable[[Callable[[], None]], None] | None = None,
+    time_imports: bool = True,
 ) -> None:
     """Set up the environment for running a Ballistica app.
 
     This includes things such as Python path wrangling and app directory
     creation. This must be called before any actual Ballistica modules
     are imported; the environment is locked in as soon as that happens.
+
+    If ``time_imports`` is True, module imports get timed until
+    :func:`pop_import_timings()` is called (the app does this once it is
+    running) so they can show up in the app's startup timeline.
     """
     # pylint: disable=too-many-locals
 
@@ -201,6 +212,10 @@ def configure(
         )
     envglobals.called_configure = True
 
+    if time_imports:
+        envglobals.import_timer = _ImportTimer()
+        sys.meta_path.insert(0, envglobals.import_timer)
+
     # The very first thing we do is setup Python paths (while also
     # calculating some engine paths). This code needs to be bulletproof
     # since we have no logging yet at this point. We used to set up
@@ -311,6 +326,108 @@ def configure(
     )
 
 
+def pop_import_timings() -> tuple[list[tuple[str, str, float, float]], float]:
+    """Stop timing imports and return what was recorded.
+
+    Returns a list of module names, thread names, and start and end times
+    (from :func:`time.monotonic()`) for imports that took a noticeable
+    amount of time, along with the current time on that same clock.
+    Times include any imports done by the module itself.
+
+    :meta private:
+    """
+    envglobals = _EnvGlobals.get()
+    timer = envglobals.import_timer
+    now = time.monotonic()
+    if timer is None:
+        return [], now
+    envglobals.import_timer = None
+    try:
+        sys.meta_path.remove(timer)
+    except ValueError:
+        pass
+    return timer.records, now
+
+
+class _ImportTimer:
+    """Meta-path finder timing module imports during startup.
+
+    We don't find anything ourself; we just ask the finders after us and
+    wrap the loader they come up with so we can time its exec.
+    """
+
+    # Imports quicker than this aren't worth cluttering things up with.
+    MIN_DURATION = 0.001
+
+    def __init__(self) -> None:
+        self.records: list[tuple[str, str, float, float]] = []
+
+    def find_spec(
+        self,
+        fullname: str,
+        path: Sequence[str] | None,
+        target: ModuleType | None = None,
+    ) -> ModuleSpec | None:
+        """Find a spec via the other finders, timing its loading."""
+        for finder in sys.meta_path:
+            if finder is self:
+                continue
+            find_spec = getattr(finder, 'find_spec', None)
+            if find_spec is None:
+                continue
+            spec = find_spec(fullname, path, target)
+            if spec is not None:
+                break
+        else:
+            return None
+        if spec.loader is not None and hasattr(spec.loader, 'exec_module'):
+            spec.loader = _TimedLoader(self, spec.loader)
+        return spec
+
+
+class _TimedLoader:
+    """Stands in for a loader just long enough to time its exec."""
+
+    def __init__(self, timer: _ImportTimer, loader: Any) -> None:
+        self._timer = timer
+        self._loader = loader
+
+    def __getattr__(self, name: str) -> Any:
+        return getattr(self._loader, name)
+
+    def create_module(self, spec: ModuleSpec) -> ModuleType | None:
+        """Create the module via the real loader."""
+        create_module = getattr(self._loader, 'create_module', None)
+        return None if create_module is None else create_module(spec)
+
+    def exec_module(self, module: ModuleType) -> None:
+        """Exec the module via the real loader, timing it."""
+        # Put the real loader back so nothing else ever sees us.
+        if module.__spec__ is not None:
+            module.__spec__.loader = self._loader
+        module.__loader__ = self._loader
+
+        start = time.monotonic()
+        try:
+            self._loader.exec_module(module)
+        finally:
+            end = time.monotonic()
+            if end - start >= self._timer.MIN_DURATION:
+                self._timer.records.append(
+                    (module.__name__, _thread_name(), start, end)
+                )
+
+
+def _thread_name() -> str:
+    # Match the engine's names for its threads where we can.
+    if threading.current_thread() is threading.main_thread():
+        return 'main'
+    babase_native = sys.modules.get('_babase')
+    if babase_native is not None and babase_native.in_logic_thread():
+        return 'logic'
+    return threading.current_thread().name
+
+
 def _cache_ninja_rampage(cache_dir: str) -> None:
     assert os.path.isdir(cache_dir)
     for basename, _dirnames, filenames in os.walk(cache_dir):
@@ -548,6 +665,16 @@ def _setup_paths(
                 check_dir,
             )
 
+        # If we're not using the standard app-python-dir, any bundle of
+        # precompiled standard scripts would shadow what's there; drop
+        # it so everything comes from the chosen dir.
+        if app_python_dir != standard_app_python_dir:
+            sys.meta_path = [
+                f
+                for f in sys.meta_path
+                if not getattr(f, 'ba_python_bundle', False)
+            ]
+
         # Ok, now apply these to sys.path.
 
         # First off, strip out any instances of the path containing this
@@ -70,10 +70,13 @@ from _bascenev1 import (
     basetime,
     basetimer,
     BaseTimer,
+    begin_state_hash_log,
+    build_nav_grid,
     camerashake,
     capture_game_controller_input,
     capture_keyboard_input,
     chatmessage,
+    check_line_of_sight,
     client_info_query_response,
     CollisionMesh,
     connect_to_party,
@@ -82,7 +85,10 @@ from _bascenev1 import (
     disconnect_from_host,
     emitfx,
     end_host_scanning,
+    end_state_hash_log,
+    find_nav_paths,
     get_chat_messages,
+    get_client_usage,
     get_connection_to_host_info,
     get_connection_to_host_info_2,
     get_foreground_host_activity,
@@ -90,11 +96,17 @@ from _bascenev1 import (
     get_game_port,
     get_game_roster,
     get_local_active_input_devices_count,
+    get_nav_directions,
+    get_nearest_nodes,
+    get_nodes_in_box,
+    get_nodes_in_sphere,
     get_public_party_enabled,
     get_public_party_max_size,
     get_random_names,
     get_replay_speed_exponent,
     get_main_ui_input_device,
+    get_snapshot_hash,
+    get_state_hash,
     getactivity,
     getcollisionmesh,
     getdata,
@@ -105,6 +117,7 @@ from _bascenev1 import (
     getsound,
     gettexture,
     have_connected_clients,
+    have_nav_grid,
     have_touchscreen_input,
     host_scan_cycle,
     InputDevice,
@@ -122,9 +135,11 @@ from _bascenev1 import (
     pause_replay,
     printnodes,
     protocol_version,
+    raycast,
     release_game_controller_input,
     release_keyboard_input,
     reset_random_player_names,
+    restore_scene_snapshot,
     resume_replay,
     seek_replay,
     broadcastmessage,
@@ -132,6 +147,7 @@ from _bascenev1 import (
     SessionPlayer,
     set_admins,
     set_authenticate_clients,
+    set_client_limits,
     set_debug_speed_exponent,
     set_enable_default_kick_voting,
     set_internal_music,
@@ -146,6 +162,7 @@ from _bascenev1 import (
     set_public_party_stats_url,
     set_replay_speed_exponent,
     set_touchscreen_editing,
+    snapshot_scene,
     Sound,
     Texture,
     time,
@@ -156,7 +173,12 @@ from bascenev1._activity import Activity
 from bascenev1._activitytypes import JoinActivity, ScoreScreenActivity
 from bascenev1._actor import Actor
 from bascenev1._campaign import init_campaigns, Campaign
-from bascenev1._collision import Collision, getcollision
+from bascenev1._collision import (
+    BatchedMessage,
+    Collision,
+    CollisionEvent,
+    getcollision,
+)
 from bascenev1._coopgame import CoopGameActivity
 from bascenev1._coopsession import CoopSession
 from bascenev1._debug import print_live_object_warnings
@@ -272,7 +294,10 @@ __all__ = [
     'BaseTime',
     'basetimer',
     'BaseTimer',
+    'BatchedMessage',
+    'begin_state_hash_log',
     'BoolSetting',
+    'build_nav_grid',
     'Call',
     'cameraflash',
     'camerashake',
@@ -281,10 +306,12 @@ __all__ = [
     'capture_keyboard_input',
     'CelebrateMessage',
     'chatmessage',
+    'check_line_of_sight',
     'ChoiceSetting',
     'Chooser',
     'client_info_query_response',
     'Collision',
+    'CollisionEvent',
     'CollisionMesh',
     'connect_to_party',
     'ContextError',
@@ -312,8 +339,10 @@ __all__ = [
     'EmptyPlayer',
     'EmptyTeam',
     'end_host_scanning',
+    'end_state_hash_log',
     'existing',
     'fade_screen',
+    'find_nav_paths',
     'filter_playlist',
     'FloatChoiceSetting',
     'FloatSetting',
@@ -323,6 +352,7 @@ __all__ = [
     'GameResults',
     'GameTip',
     'get_chat_messages',
+    'get_client_usage',
     'get_connection_to_host_info',
     'get_connection_to_host_info_2',
     'get_default_free_for_all_playlist',
@@ -335,8 +365,12 @@ __all__ = [
     'get_game_roster',
     'get_game_roster',
     'get_local_active_input_devices_count',
+    'get_nav_directions',
     'get_map_class',
     'get_map_display_string',
+    'get_nearest_nodes',
+    'get_nodes_in_box',
+    'get_nodes_in_sphere',
     'get_player_colors',
     'get_player_profile_colors',
     'get_player_profile_icon',
@@ -345,6 +379,8 @@ __all__ = [
     'get_random_names',
     'get_remote_app_name',
     'get_replay_speed_exponent',
+    'get_snapshot_hash',
+    'get_state_hash',
     'get_trophy_string',
     'get_main_ui_input_device',
     'getactivity',
@@ -358,6 +394,7 @@ __all__ = [
     'getsound',
     'gettexture',
     'have_connected_clients',
+    'have_nav_grid',
     'have_touchscreen_input',
     'HitMessage',
     'HostInfo',
@@ -412,10 +449,12 @@ __all__ = [
     'printnodes',
     'protocol_version',
     'pushcall',
+    'raycast',
     'register_map',
     'release_game_controller_input',
     'release_keyboard_input',
     'reset_random_player_names',
+    'restore_scene_snapshot',
     'resume_replay',
     'seek_replay',
     'safecolor',
@@ -433,6 +472,7 @@ __all__ = [
     'set_admins',
     'set_analytics_screen',
     'set_authenticate_clients',
+    'set_client_limits',
     'set_debug_speed_exponent',
     'set_debug_speed_exponent',
     'set_enable_default_kick_voting',
@@ -454,6 +494,7 @@ __all__ = [
     'Setting',
     'ShouldShatterMessage',
     'show_damage_count',
+    'snapshot_scene',
     'Sound',
     'StandLocation',
     'StandMessage',
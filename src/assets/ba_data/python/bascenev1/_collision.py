@@ -4,12 +4,15 @@
 
 from __future__ import annotations
 
+from dataclasses import dataclass
 from typing import TYPE_CHECKING
 
 import babase
 import _bascenev1
 
 if TYPE_CHECKING:
+    from typing import Any
+
     import bascenev1
 
 
@@ -58,6 +61,51 @@ class Collision:
         return body
 
 
+@dataclass
+class CollisionEvent:
+    """One contact delivered to a ``'batch_call'`` material action.
+
+    These are filled in natively at the end of each sim step, so unlike
+    :class:`Collision` they can be stashed and read at any time.
+    """
+
+    #: The node containing the material that triggered the call, or None
+    #: if it has since died.
+    sourcenode: bascenev1.Node | None
+
+    #: The node the source node hit, or None if it has since died (as in
+    #: disconnects triggered by deleting a colliding node).
+    opposingnode: bascenev1.Node | None
+
+    #: The body index on the opposing node.
+    opposingbody: int
+
+    #: The (averaged) contact position.
+    position: bascenev1.Vec3
+
+    #: The (averaged) contact depth.
+    depth: float
+
+    #: Roughly the impulse needed to stop the two parts closing at the
+    #: time of contact; a handy measure of how hard a hit was.
+    impulse: float
+
+
+@dataclass
+class BatchedMessage:
+    """What a ``'batch_message'`` material action sends a node.
+
+    Each target node gets one of these per sim step, covering every
+    contact that would have sent it the message individually.
+    """
+
+    #: The message object the material action was given.
+    message: Any
+
+    #: The contacts this message covers, in the order they occurred.
+    events: list[CollisionEvent]
+
+
 # Simply recycle one instance...
 _collision = Collision()
 
@@ -60,10 +60,24 @@ def animate(
     relative to the current time. By default, times are specified in seconds,
     but timeformat can also be set to MILLISECONDS to recreate the old behavior
     (prior to ba 1.5) of taking milliseconds. Returns the animcurve node.
+
+    When hosting protocol 36 or newer, a single 'animtrack' node (which
+    reads scene time directly) is used instead of an 'animcurve'.
     """
     items = list(keys.items())
     items.sort()
 
+    if _use_anim_tracks():
+        return _animate_track(
+            node,
+            attr,
+            1,
+            [(time, [val]) for time, val in items],
+            output='out',
+            loop=loop,
+            offset=offset,
+        )
+
     curve = _bascenev1.newnode(
         'animcurve',
         owner=node,
@@ -115,10 +129,23 @@ def animate_array(
 
     Like bs.animate, but operates on array attributes.
     """
-    combine = _bascenev1.newnode('combine', owner=node, attrs={'size': size})
     items = list(keys.items())
     items.sort()
 
+    if _use_anim_tracks():
+        _animate_track(
+            node,
+            attr,
+            size,
+            items,
+            output='output',
+            loop=loop,
+            offset=offset,
+        )
+        return
+
+    combine = _bascenev1.newnode('combine', owner=node, attrs={'size': size})
+
     # We take seconds but operate on milliseconds internally.
     mult = 1000
 
@@ -166,6 +193,49 @@ def animate_array(
         )
 
 
+def _use_anim_tracks() -> bool:
+    # Clients older than protocol 36 don't know about animtrack nodes.
+    return _bascenev1.protocol_version() >= 36
+
+
+def _animate_track(
+    node: bascenev1.Node,
+    attr: str,
+    size: int,
+    items: Sequence[tuple[float, Sequence[float]]],
+    *,
+    output: str,
+    loop: bool,
+    offset: float,
+) -> bascenev1.Node:
+    """Drive an attr with a single animtrack node."""
+
+    # We take seconds but operate on milliseconds internally.
+    mult = 1000
+
+    track = _bascenev1.newnode(
+        'animtrack',
+        owner=node,
+        name='Driving ' + str(node) + ' \'' + attr + '\'',
+        attrs={
+            'size': size,
+            'times': [int(mult * time) for time, _val in items],
+            'values': [val[i] for _time, val in items for i in range(size)],
+            'offset': int(_bascenev1.time() * 1000.0) + int(mult * offset),
+            'loop': loop,
+        },
+    )
+
+    # If we're not looping, kill the track after its done its job.
+    if not loop:
+        _bascenev1.timer(
+            (int(mult * items[-1][0]) + 1000) / 1000.0, track.delete
+        )
+
+    track.connectattr(output, node, attr)
+    return track
+
+
 def show_damage_count(
     damage: str, position: Sequence[float], direction: Sequence[float]
 ) -> None:
@@ -45,6 +45,18 @@ def filter_chat_message(msg: str, client_id: int) -> str | None:
     return msg
 
 
+def client_over_limits(client_id: int, reason: str) -> bool:
+    """Decide whether to kick a client that has been over its limits.
+
+    Called while hosting when a client has used more than its share of
+    processing time, bandwidth, or messages for long enough (see
+    bascenev1.set_client_limits()). Return False to spare them; they
+    will continue to be throttled either way.
+    """
+    del client_id, reason  # Unused by default.
+    return True
+
+
 def local_chat_message(msg: str) -> None:
     classic = babase.app.classic
     assert classic is not None
@@ -139,6 +139,10 @@ class SpazBot(Spaz):
         self._have_dropped_throw_bomb: bool | None = None
         self._player_pts: list[tuple[bs.Vec3, bs.Vec3]] | None = None
 
+        # Filled in by bot-sets with navigation enabled; see SpazBotSet.
+        self.nav_direction: tuple[float, float] | None = None
+        self.nav_clear_shot = True
+
         # These cooldowns didn't exist when these bots were calibrated,
         # so take them out of the equation.
         self._jump_cooldown = 0
@@ -187,6 +191,15 @@ class SpazBot(Spaz):
             )
         return None, None
 
+    def get_target_point(self) -> bs.Vec3 | None:
+        """Return the point this bot is currently heading for, if any."""
+        if not self.node:
+            return None
+        target_pt, _target_vel = self._get_target_player_pt()
+        if target_pt is None:
+            return self.target_point_default
+        return target_pt
+
     def set_player_points(self, pts: list[tuple[bs.Vec3, bs.Vec3]]) -> None:
         """Provide the spaz-bot with the locations of its enemies."""
         self._player_pts = pts
@@ -366,8 +379,15 @@ class SpazBot(Spaz):
                     self._running = False
                     self.node.run = 0.0
 
-            self.node.move_left_right = to_target.x * self._charge_speed
-            self.node.move_up_down = to_target.z * -1.0 * self._charge_speed
+            # If we've been given a navigation direction, charge along
+            # that instead so we find our way around walls and gaps.
+            move_dir = to_target
+            if self.nav_direction is not None:
+                move_dir = bs.Vec3(
+                    self.nav_direction[0], 0.0, self.nav_direction[1]
+                )
+            self.node.move_left_right = move_dir.x * self._charge_speed
+            self.node.move_up_down = move_dir.z * -1.0 * self._charge_speed
 
         elif self._mode == 'wait':
             # Every now and then, aim towards our target.
@@ -410,6 +430,7 @@ class SpazBot(Spaz):
                 self.throw_dist_min <= dist < self.throw_dist_max
                 and random.random() < self.throwiness
                 and can_attack
+                and self.nav_clear_shot
             ):
                 self._mode = 'throw'
                 self._lead_amount = (
@@ -912,8 +933,14 @@ class SpazBotSet:
     category: Bot Classes
     """
 
-    def __init__(self) -> None:
-        """Create a bot-set."""
+    def __init__(self, navigation: bool = False) -> None:
+        """Create a bot-set.
+
+        If navigation is True, the set builds a native navigation grid for
+        the map and feeds its bots pathing directions and line-of-sight
+        results in batches, so they can find their way around obstacles
+        without holding up the game on bot-heavy maps.
+        """
 
         # We spread our bots out over a few lists so we can update
         # them in a staggered fashion.
@@ -926,6 +953,7 @@ class SpazBotSet:
         self._spawn_sound = bs.getsound('spawn')
         self._spawning_count = 0
         self._bot_update_timer: bs.Timer | None = None
+        self._navigation = navigation
         self.start_moving()
 
     def __del__(self) -> None:
@@ -1022,8 +1050,41 @@ class SpazBotSet:
 
         for bot in bot_list:
             bot.set_player_points(player_pts)
+        if self._navigation:
+            self._update_navigation(bot_list)
+        for bot in bot_list:
             bot.update_ai()
 
+    def _update_navigation(self, bot_list: list[SpazBot]) -> None:
+        # Gather everyone's position and target so we can hand them to
+        # the native nav layer in one go.
+        if not bs.have_nav_grid():
+            bs.build_nav_grid()
+        bots: list[SpazBot] = []
+        requests: list[tuple[Sequence[float], Sequence[float]]] = []
+        for bot in bot_list:
+            target = bot.get_target_point()
+            if target is None:
+                bot.nav_direction = None
+                bot.nav_clear_shot = True
+                continue
+            assert bot.node
+            bots.append(bot)
+            requests.append((bot.node.position, target))
+        if not requests:
+            return
+        directions = bs.get_nav_directions(requests)
+
+        # Look from chest height so low bumps don't block shots.
+        sightlines = [
+            ((pos[0], pos[1] + 0.5, pos[2]), (tgt[0], tgt[1] + 0.5, tgt[2]))
+            for pos, tgt in requests
+        ]
+        clear = bs.check_line_of_sight(sightlines)
+        for bot, direction, clear_shot in zip(bots, directions, clear):
+            bot.nav_direction = direction
+            bot.nav_clear_shot = clear_shot
+
     def clear(self) -> None:
         """Immediately clear out any bots in the set."""
 
@@ -14,6 +14,7 @@
 #include "ballistica/base/graphics/gl/renderer_gl.h"
 #include "ballistica/base/graphics/graphics.h"
 #include "ballistica/base/graphics/graphics_server.h"
+#include "ballistica/base/graphics/renderer/renderer_validating.h"
 #include "ballistica/base/input/device/joystick_input.h"
 #include "ballistica/base/input/input.h"
 #include "ballistica/base/logic/logic.h"
@@ -48,6 +49,11 @@ class AppAdapterSDL::ScopedAllowGraphics_ {
 AppAdapterSDL::AppAdapterSDL() {
   assert(!g_core->HeadlessMode());
   assert(g_core->InMainThread());
+
+  // Lets us run the full graphics pipeline on machines without a GPU
+  // (generally paired with SDL_VIDEODRIVER=dummy or offscreen).
+  auto validating{g_core->platform->GetEnv("BA_VALIDATING_RENDERER")};
+  validating_renderer_ = validating.has_value() && *validating == "1";
 }
 
 void AppAdapterSDL::OnMainThreadStartApp() {
@@ -167,11 +173,18 @@ void AppAdapterSDL::ApplyGraphicsSettings(
       vsync = VSync::kNever;
       break;
   }
+
+  // No GL means nothing to sync.
+  if (validating_renderer_) {
+    vsync = VSync::kNever;
+  }
   if (vsync != vsync_) {
     switch (vsync) {
       case VSync::kUnset:
       case VSync::kNever: {
-        SDL_GL_SetSwapInterval(0);
+        if (!validating_renderer_) {
+          SDL_GL_SetSwapInterval(0);
+        }
         vsync_actually_enabled_ = false;
         break;
       }
@@ -194,6 +207,10 @@ void AppAdapterSDL::ApplyGraphicsSettings(
       }
     }
     vsync_ = vsync;
+
+    // Frame pacing relies on presents being locked to the display.
+    g_base->graphics_server->frame_pacer().SetVSyncLocked(
+        vsync_actually_enabled_);
   }
 
   // This we can set anytime. Probably could have just set it from the logic
@@ -226,7 +243,10 @@ void AppAdapterSDL::RunMainThreadEventLoopToCompletion() {
     auto draw_start_time{g_core->AppTimeMicrosecs()};
     LogEventProcessingTime_(draw_start_time - cycle_start_time, event_count);
     if (!hidden_ && TryRender()) {
-      SDL_GL_SwapWindow(sdl_window_);
+      if (!validating_renderer_) {
+        SDL_GL_SwapWindow(sdl_window_);
+      }
+      g_base->graphics_server->OnFramePresented();
     }
 
     // Sleep.
@@ -748,8 +768,11 @@ void AppAdapterSDL::ReloadRenderer_(const GraphicsSettings_* settings) {
       height = static_cast<int>(kBaseVirtualResY * 0.8f);
     }
 
-    uint32_t flags = SDL_WINDOW_OPENGL | SDL_WINDOW_SHOWN
-                     | SDL_WINDOW_ALLOW_HIGHDPI | SDL_WINDOW_RESIZABLE;
+    uint32_t flags = SDL_WINDOW_SHOWN | SDL_WINDOW_ALLOW_HIGHDPI
+                     | SDL_WINDOW_RESIZABLE;
+    if (!validating_renderer_) {
+      flags |= SDL_WINDOW_OPENGL;
+    }
     if (settings->fullscreen) {
       flags |= SDL_WINDOW_FULLSCREEN_DESKTOP;
     }
@@ -791,19 +814,25 @@ void AppAdapterSDL::ReloadRenderer_(const GraphicsSettings_* settings) {
       FatalError("Unable to create SDL Window of size " + std::to_string(width)
                  + " by " + std::to_string(height));
     }
-    sdl_gl_context_ = SDL_GL_CreateContext(sdl_window_);
-    if (!sdl_gl_context_) {
-      FatalError("Unable to create SDL GL Context");
+    if (!validating_renderer_) {
+      sdl_gl_context_ = SDL_GL_CreateContext(sdl_window_);
+      if (!sdl_gl_context_) {
+        FatalError("Unable to create SDL GL Context");
+      }
     }
 
     SDL_SetWindowTitle(sdl_window_, "BallisticaKit");
 
     UpdateScreenSizes_();
 
-    // Now assign a GL renderer to the graphics-server to do its work.
+    // Now assign a renderer to the graphics-server to do its work.
     assert(!gs->renderer());
     if (!gs->renderer()) {
-      gs->set_renderer(new RendererGL());
+      if (validating_renderer_) {
+        gs->set_renderer(new RendererValidating());
+      } else {
+        gs->set_renderer(new RendererGL());
+      }
     }
   }
 
@@ -827,7 +856,12 @@ void AppAdapterSDL::UpdateScreenSizes_() {
   // Also grab the new size of the drawable; this is our physical (pixel)
   // dimensions.
   int pixels_x, pixels_y;
-  SDL_GL_GetDrawableSize(sdl_window_, &pixels_x, &pixels_y);
+  if (validating_renderer_) {
+    pixels_x = win_size_x;
+    pixels_y = win_size_y;
+  } else {
+    SDL_GL_GetDrawableSize(sdl_window_, &pixels_x, &pixels_y);
+  }
 
   // Push this over to the logic thread which owns the canonical value
   // for this.
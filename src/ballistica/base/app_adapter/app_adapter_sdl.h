@@ -83,6 +83,10 @@ class AppAdapterSDL : public AppAdapter {
   bool vsync_actually_enabled_{};
   bool hidden_{};
 
+  /// Render through a RendererValidating instead of GL; set via the
+  /// BA_VALIDATING_RENDERER env var.
+  bool validating_renderer_{};
+
   /// With this off, graphics call pushes simply get pushed to the main
   /// thread and graphics code is allowed to run any time in the main
   /// thread. When this is on, pushed graphics-context calls get enqueued
@@ -3,9 +3,12 @@
 #include "ballistica/base/assets/assets.h"
 
 #include <cstdio>
+#include <filesystem>
 #include <set>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "ballistica/base/app_adapter/app_adapter.h"
@@ -20,6 +23,7 @@
 #include "ballistica/base/graphics/graphics.h"
 #include "ballistica/base/graphics/graphics_server.h"
 #include "ballistica/base/graphics/text/text_packer.h"
+#include "ballistica/base/graphics/texture/texture_stream_plan.h"
 #include "ballistica/base/logic/logic.h"
 #include "ballistica/base/python/base_python.h"
 #include "ballistica/base/ui/ui.h"
@@ -759,6 +763,58 @@ auto Assets::RunPendingGraphicsLoads() -> bool {
   return RunPendingLoadList(&pending_loads_graphics_);
 }
 
+auto Assets::RunPendingTextureStreams() -> bool {
+  assert(g_base->app_adapter->InGraphicsContext());
+
+  std::vector<Object::Ref<Asset>*> l;
+  {
+    std::scoped_lock lock(pending_load_list_mutex_);
+    if (pending_texture_streams_.empty()) {
+      return false;
+    }
+    l.swap(pending_texture_streams_);
+  }
+
+  // Hand out this frame's budget in list order. The first texture to do
+  // any work is allowed to go over budget so huge levels still get through.
+  std::vector<Object::Ref<Asset>*> l_unfinished;
+  std::vector<Object::Ref<Asset>*> l_finished;
+  size_t budget{kTextureStreamFrameBudget};
+  bool oversized_ok{true};
+  for (auto&& i : l) {
+    assert((**i).GetAssetType() == AssetType::kTexture);
+    size_t budget_prev{budget};
+    if (static_cast<TextureAsset&>(**i).StreamLevels(&budget, oversized_ok)) {
+      l_unfinished.push_back(i);
+    } else {
+      l_finished.push_back(i);
+    }
+    if (budget != budget_prev) {
+      oversized_ok = false;
+    }
+  }
+
+  bool streams_remain{};
+  {
+    std::scoped_lock lock(pending_load_list_mutex_);
+
+    // Anything added while we were working goes after our leftovers.
+    l_unfinished.insert(l_unfinished.end(), pending_texture_streams_.begin(),
+                        pending_texture_streams_.end());
+    pending_texture_streams_.swap(l_unfinished);
+    for (auto&& i : l_finished) {
+      pending_loads_done_.push_back(i);
+    }
+    streams_remain = !pending_texture_streams_.empty();
+  }
+  if (!l_finished.empty()) {
+    assert(g_base->logic);
+    g_base->logic->event_loop()->PushCall(
+        [] { g_base->assets->ClearPendingLoadsDoneList(); });
+  }
+  return streams_remain;
+}
+
 // Runs the pending loads that run in the main thread.  Also clears the list of
 // done loads.
 auto Assets::RunPendingLoadsLogicThread() -> bool {
@@ -774,6 +830,7 @@ auto Assets::RunPendingLoadList(std::vector<Object::Ref<T>*>* c_list) -> bool {
   std::vector<Object::Ref<T>*> l;
   std::vector<Object::Ref<T>*> l_unfinished;
   std::vector<Object::Ref<T>*> l_finished;
+  std::vector<Object::Ref<T>*> l_streaming;
   {
     std::scoped_lock lock(pending_load_list_mutex_);
 
@@ -805,9 +862,15 @@ auto Assets::RunPendingLoadList(std::vector<Object::Ref<T>*>* c_list) -> bool {
         if (!out_of_time) {
           (***i).Load(false);
 
-          // If the load finished, pop it on our "done-loading" list.. otherwise
-          // keep it around.
-          l_finished.push_back(*i);  // else l_unfinished.push_back(*i);
+          // If the load finished, pop it on our "done-loading" list..
+          // otherwise keep it around. Textures may still have larger mip
+          // levels to stream in; those hang on to their ref until done.
+          if ((***i).GetAssetType() == AssetType::kTexture
+              && static_cast<TextureAsset&>(***i).streaming()) {
+            l_streaming.push_back(*i);
+          } else {
+            l_finished.push_back(*i);
+          }
           if (g_core->AppTimeMillisecs() - starttime > PENDING_LOAD_PROCESS_TIME
               && !flush) {
             out_of_time = true;
@@ -835,6 +898,9 @@ auto Assets::RunPendingLoadList(std::vector<Object::Ref<T>*>* c_list) -> bool {
     for (auto&& i : l_finished) {
       pending_loads_done_.push_back(i);
     }
+    for (auto&& i : l_streaming) {
+      pending_texture_streams_.push_back(i);
+    }
   }
 
   // If we dumped anything on the pending loads done list, shake the logic
@@ -1086,6 +1152,53 @@ void Assets::Prune(int level) {
   }
 }
 
+// Subdirectories of asset paths that FindAssetFile() looks in.
+static const char* kAssetFileDirs_[] = {"audio",    "audio2", "meshes",
+                                        "meshes2",  "data",   "data2",
+                                        "textures", "textures2"};
+
+void Assets::BuildFileIndex() {
+  assert(g_base->InAssetsThread());
+  assert(!file_index_ready_);
+
+  // Note that asset-paths are only set at construction time so we can
+  // safely read them from here.
+  std::unordered_set<std::string> file_index;
+  try {
+    for (auto&& asset_path : asset_paths_) {
+      for (auto&& dir : kAssetFileDirs_) {
+        std::string prefix = asset_path + "/" + dir + "/";
+        std::error_code err;
+        std::filesystem::directory_iterator entries(prefix, err);
+        if (err) {
+          continue;
+        }
+        for (auto&& entry : entries) {
+          file_index.insert(prefix + entry.path().filename().string());
+        }
+      }
+    }
+  } catch (const std::exception& exc) {
+    // No big deal; lookups will just keep hitting the filesystem.
+    g_core->logging->Log(
+        LogName::kBaAssets, LogLevel::kWarning,
+        std::string("Unable to index asset files: ") + exc.what());
+    return;
+  }
+  file_index_ = std::move(file_index);
+  file_index_ready_ = true;
+}
+
+auto Assets::AssetFileExists_(const std::string& path) -> bool {
+  // The index only lets us skip the filesystem for hits; files can show up
+  // after it is built (or live somewhere it doesn't cover), so a miss
+  // still has to go check.
+  if (file_index_ready_ && file_index_.find(path) != file_index_.end()) {
+    return true;
+  }
+  return g_core->platform->FilePathExists(path);
+}
+
 auto Assets::FindAssetFile(FileType type, const std::string& name)
     -> std::string {
   std::string file_out;
@@ -1176,9 +1289,9 @@ auto Assets::FindAssetFile(FileType type, const std::string& name)
         // Just look for one of them i guess.
         std::string tmp_name = file_out;
         tmp_name.replace(tmp_name.find('#'), 1, "_+x");
-        exists = g_core->platform->FilePathExists(tmp_name);
+        exists = AssetFileExists_(tmp_name);
       } else {
-        exists = g_core->platform->FilePathExists(file_out);
+        exists = AssetFileExists_(file_out);
       }
       if (exists) {
         return file_out;
@@ -3,9 +3,11 @@
 #ifndef BALLISTICA_BASE_ASSETS_ASSETS_H_
 #define BALLISTICA_BASE_ASSETS_ASSETS_H_
 
+#include <atomic>
 #include <mutex>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "ballistica/base/base.h"
@@ -30,6 +32,10 @@ class Assets {
 
   /// Return true if graphics loads remain to be done.
   auto RunPendingGraphicsLoads() -> bool;
+
+  /// Upload one frame's worth of streamed texture mip levels. Should be
+  /// called once per rendered frame. Returns true if streaming remains.
+  auto RunPendingTextureStreams() -> bool;
   void ClearPendingLoadsDoneList();
   template <typename T>
   auto RunPendingLoadList(std::vector<Object::Ref<T>*>* assets) -> bool;
@@ -41,6 +47,11 @@ class Assets {
   auto FindAssetFile(FileType fileType, const std::string& file_in)
       -> std::string;
 
+  /// Index the files in our asset directories so FindAssetFile() doesn't
+  /// need to hit the filesystem for each lookup. Run once in the assets
+  /// thread at startup; lookups simply stat files until it completes.
+  void BuildFileIndex();
+
   /// Unload renderer-specific bits only (gl display lists, etc) - used when
   /// recreating/adjusting the renderer.
   void UnloadRendererBits(bool textures, bool meshes);
@@ -128,6 +139,7 @@ class Assets {
   void LoadSystemData(SystemDataID id, const char* name);
   void LoadSystemMesh(SysMeshID id, const char* name);
   void InitSpecialChars();
+  auto AssetFileExists_(const std::string& path) -> bool;
 
   template <typename T>
   auto GetAssetPendingLoadCount(
@@ -149,6 +161,8 @@ class Assets {
   bool sys_assets_loaded_{};
 
   std::vector<std::string> asset_paths_;
+  std::unordered_set<std::string> file_index_;
+  std::atomic<bool> file_index_ready_{};
   std::unordered_map<std::string, std::string> packages_;
 
   // For use by AssetListLock; don't manually acquire.
@@ -176,6 +190,7 @@ class Assets {
   std::vector<Object::Ref<Asset>*> pending_loads_sounds_;
   std::vector<Object::Ref<Asset>*> pending_loads_datas_;
   std::vector<Object::Ref<Asset>*> pending_loads_other_;
+  std::vector<Object::Ref<Asset>*> pending_texture_streams_;
   std::vector<Object::Ref<Asset>*> pending_loads_done_;
 
   // Text & Language (need to mold this into more asset-like concepts).
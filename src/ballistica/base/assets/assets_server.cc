@@ -2,17 +2,28 @@
 
 #include "ballistica/base/assets/assets_server.h"
 
+#include <cstdio>
+#include <filesystem>
+#include <string>
 #include <vector>
 
 #include "ballistica/base/assets/asset.h"
 #include "ballistica/base/assets/assets.h"
 #include "ballistica/base/graphics/graphics.h"
 #include "ballistica/core/core.h"
+#include "ballistica/core/logging/logging.h"
+#include "ballistica/core/platform/core_platform.h"
+#include "ballistica/core/support/startup_timeline.h"
 #include "ballistica/shared/foundation/event_loop.h"
 #include "ballistica/shared/foundation/macros.h"
 
 namespace ballistica::base {
 
+// How many Python bytecode files we read per warmup step, and when we stop
+// bothering altogether.
+const int kWarmupFilesPerStep = 16;
+const size_t kWarmupMaxBytes = 64 * 1024 * 1024;
+
 AssetsServer::AssetsServer() = default;
 
 void AssetsServer::OnMainThreadStartApp() {
@@ -29,6 +40,71 @@ void AssetsServer::OnAppStartInThread_() {
   // *exactly* one second; try to avoid aliasing with similar updates).
   process_timer_ = event_loop()->NewTimer(
       987 * 1000, true, NewLambdaRunnable([this] { Process_(); }).get());
+
+  // Do some startup legwork in the background while the rest of the app
+  // spins up.
+  event_loop()->PushCall([this] { StartWarmup_(); });
+}
+
+void AssetsServer::StartWarmup_() {
+  assert(g_base->InAssetsThread());
+  {
+    core::StartupTimeline::ScopedPhase phase("asset-file-index");
+    g_base->assets->BuildFileIndex();
+  }
+
+  // Now pull Python bytecode files into the OS file cache so the imports
+  // that happen as the app inits aren't stuck waiting on lots of small
+  // cold reads. We don't need the GIL for any of this.
+  g_core->startup_timeline->BeginPhase("python-bytecode-warmup");
+  std::vector<std::string> dirs{g_core->GetCacheDirectory() + "/pyc"};
+  if (auto app_python_dir = g_core->GetAppPythonDirectory()) {
+    dirs.push_back(*app_python_dir);
+  }
+  try {
+    for (auto&& dir : dirs) {
+      std::error_code err;
+      std::filesystem::recursive_directory_iterator entries(dir, err);
+      if (err) {
+        continue;
+      }
+      for (auto&& entry : entries) {
+        if (entry.path().extension() == ".pyc") {
+          warmup_files_.push_back(entry.path().string());
+        }
+      }
+    }
+  } catch (const std::exception& exc) {
+    // Not a big deal if this fails.
+    g_core->logging->Log(
+        LogName::kBaAssets, LogLevel::kWarning,
+        std::string("Error gathering Python bytecode files: ") + exc.what());
+  }
+  WarmupStep_();
+}
+
+void AssetsServer::WarmupStep_() {
+  assert(g_base->InAssetsThread());
+
+  // Go a few files at a time so we don't hold up asset preloads that come
+  // in meanwhile.
+  char buffer[16384];
+  for (int i = 0; i < kWarmupFilesPerStep && !warmup_files_.empty(); ++i) {
+    if (FILE* f = g_core->platform->FOpen(warmup_files_.back().c_str(), "rb")) {
+      size_t count;
+      while ((count = fread(buffer, 1, sizeof(buffer), f)) > 0) {
+        warmup_bytes_ += count;
+      }
+      fclose(f);
+    }
+    warmup_files_.pop_back();
+  }
+  if (!warmup_files_.empty() && warmup_bytes_ < kWarmupMaxBytes) {
+    event_loop()->PushCall([this] { WarmupStep_(); });
+    return;
+  }
+  std::vector<std::string>().swap(warmup_files_);
+  g_core->startup_timeline->EndPhase("python-bytecode-warmup");
 }
 
 void AssetsServer::PushPendingPreload(Object::Ref<Asset>* asset_ref_ptr) {
@@ -5,6 +5,7 @@
 
 // #include <cstdio>
 // #include <list>
+#include <string>
 #include <vector>
 
 #include "ballistica/base/base.h"
@@ -31,6 +32,8 @@ class AssetsServer {
 
  private:
   void OnAppStartInThread_();
+  void StartWarmup_();
+  void WarmupStep_();
   void Process_();
   void WriteReplayMessages_();
 
@@ -38,6 +41,8 @@ class AssetsServer {
   std::vector<Object::Ref<Asset>*> pending_preloads_audio_;
   std::mutex processors_mutex_;
   std::vector<Processor*> processors_;
+  std::vector<std::string> warmup_files_;
+  size_t warmup_bytes_{};
   EventLoop* event_loop_{};
   Timer* process_timer_{};
 };
@@ -4,9 +4,9 @@
 #define BALLISTICA_BASE_ASSETS_MESH_ASSET_H_
 
 #include <string>
-#include <vector>
 
 #include "ballistica/base/assets/asset.h"
+#include "ballistica/base/assets/mesh_asset_preload_data.h"
 #include "ballistica/base/assets/mesh_asset_renderer_data.h"
 
 namespace ballistica::base {
@@ -25,34 +25,18 @@ class MeshAsset : public Asset {
     assert(renderer_data_.exists());
     return renderer_data_.get();
   }
-  auto vertices() const -> const std::vector<VertexObjectFull>& {
-    return vertices_;
-  }
-  auto indices8() const -> const std::vector<uint8_t>& { return indices8_; }
-  auto indices16() const -> const std::vector<uint16_t>& { return indices16_; }
-  auto indices32() const -> const std::vector<uint32_t>& { return indices32_; }
-  auto GetIndexSize() const -> int {
-    switch (format_) {
-      case MeshFormat::kUV16N8Index8:
-        return 1;
-      case MeshFormat::kUV16N8Index16:
-        return 2;
-      case MeshFormat::kUV16N8Index32:
-        return 4;
-      default:
-        throw Exception();
-    }
+
+  /// Raw file data for the renderer to upload from; only valid between
+  /// preload and load.
+  auto preload_data() const -> const MeshAssetPreloadData& {
+    return preload_data_;
   }
 
  private:
   Object::Ref<MeshAssetRendererData> renderer_data_;
   std::string file_name_;
   std::string file_name_full_;
-  MeshFormat format_{};
-  std::vector<VertexObjectFull> vertices_;
-  std::vector<uint8_t> indices8_;
-  std::vector<uint16_t> indices16_;
-  std::vector<uint32_t> indices32_;
+  MeshAssetPreloadData preload_data_;
   BA_DISALLOW_CLASS_COPIES(MeshAsset);
 };
 
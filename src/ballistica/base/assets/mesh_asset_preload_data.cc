@@ -0,0 +1,179 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/base/assets/mesh_asset_preload_data.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "ballistica/core/core.h"
+#include "ballistica/core/platform/core_platform.h"
+
+namespace ballistica::base {
+
+// We currently read/write in little-endian since that's all we run on at
+// the moment.
+#if WORDS_BIGENDIAN
+#error FIX THIS FOR BIG ENDIAN
+#endif
+
+// Legacy bob files are a 4 word header followed by tightly packed vertex
+// and index data.
+const size_t kBobLegacyHeaderSize = 16;
+
+MeshAssetPreloadData::~MeshAssetPreloadData() { Release(); }
+
+void MeshAssetPreloadData::Load(const std::string& path, bool allow_map) {
+  assert(!loaded());
+
+  if (allow_map) {
+    size_t size{};
+    if (auto* data = g_core->platform->MapFile(path.c_str(), &size)) {
+      data_ = static_cast<const uint8_t*>(data);
+      data_size_ = size;
+      mapped_ = true;
+    }
+  }
+
+  // Fall back to a single read of the whole file.
+  if (!data_) {
+    FILE* f = g_core->platform->FOpen(path.c_str(), "rb");
+    if (!f) {
+      throw Exception("Can't open mesh file: '" + path + "'");
+    }
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);  // NOLINT(runtime/int)
+    fseek(f, 0, SEEK_SET);
+    if (size <= 0) {
+      fclose(f);
+      throw Exception("Error reading file header for '" + path + "'");
+    }
+    buffer_.resize(static_cast<size_t>(size));
+    size_t result = fread(buffer_.data(), buffer_.size(), 1, f);
+    fclose(f);
+    if (result != 1) {
+      std::vector<uint8_t>().swap(buffer_);
+      throw Exception("Read failed for " + path);
+    }
+    data_ = buffer_.data();
+    data_size_ = buffer_.size();
+  }
+
+  try {
+    Parse_(path);
+  } catch (...) {
+    Release();
+    throw;
+  }
+}
+
+void MeshAssetPreloadData::Parse_(const std::string& path) {
+  assert(data_);
+  if (data_size_ < kBobLegacyHeaderSize) {
+    throw Exception("Error reading file header for '" + path + "'");
+  }
+  uint32_t file_id;
+  memcpy(&file_id, data_, sizeof(file_id));
+
+  uint32_t mesh_format;
+  uint32_t vertex_count;
+  uint32_t face_count;
+  uint64_t vertex_offset;
+  uint64_t index_offset;
+
+  if (file_id == kBobAlignedFileID) {
+    BobAlignedHeader header{};
+    if (data_size_ < sizeof(header)) {
+      throw Exception("Error reading file header for '" + path + "'");
+    }
+    memcpy(&header, data_, sizeof(header));
+    if (header.version != kBobAlignedVersion) {
+      throw Exception("File: '" + path + "' has unsupported bob version "
+                      + std::to_string(header.version) + " (expected "
+                      + std::to_string(kBobAlignedVersion) + ")");
+    }
+    if (header.data_size != data_size_
+        || header.vertex_offset % kBobAlignment != 0
+        || header.index_offset % kBobAlignment != 0) {
+      throw Exception("Invalid aligned bob header in '" + path + "'");
+    }
+    mesh_format = header.mesh_format;
+    vertex_count = header.vertex_count;
+    face_count = header.face_count;
+    vertex_offset = header.vertex_offset;
+    index_offset = header.index_offset;
+  } else if (file_id == kBobFileID) {
+    memcpy(&mesh_format, data_ + 4, sizeof(mesh_format));
+    memcpy(&vertex_count, data_ + 8, sizeof(vertex_count));
+    memcpy(&face_count, data_ + 12, sizeof(face_count));
+    vertex_offset = kBobLegacyHeaderSize;
+    index_offset =
+        vertex_offset
+        + static_cast<uint64_t>(vertex_count) * sizeof(VertexObjectFull);
+  } else {
+    throw Exception("File: '" + path
+                    + "' is an old format or not a bob file (got id "
+                    + std::to_string(file_id) + ", "
+                    + std::to_string(kBobFileID) + ")");
+  }
+
+  format_ = static_cast<MeshFormat>(mesh_format);
+  BA_PRECONDITION((format_ == MeshFormat::kUV16N8Index8)
+                  || (format_ == MeshFormat::kUV16N8Index16)
+                  || (format_ == MeshFormat::kUV16N8Index32));
+
+  // Make sure everything lands within the file (doing the math in 64 bits
+  // so bogus counts can't wrap around).
+  uint64_t vertex_end =
+      vertex_offset
+      + static_cast<uint64_t>(vertex_count) * sizeof(VertexObjectFull);
+  uint64_t index_end =
+      index_offset + static_cast<uint64_t>(face_count) * 3 * index_size();
+  if (vertex_end > index_offset || index_end > data_size_) {
+    throw Exception("Read failed for " + path);
+  }
+
+  // Legacy layouts are naturally aligned for everything we point at (the
+  // header and vertex stride are multiples of 4) as long as the base
+  // address is, which mappings and heap buffers both are.
+  assert(reinterpret_cast<uintptr_t>(data_ + vertex_offset)
+             % alignof(VertexObjectFull)
+         == 0);
+  assert(reinterpret_cast<uintptr_t>(data_ + index_offset) % index_size()
+         == 0);
+
+  vertices_ = reinterpret_cast<const VertexObjectFull*>(data_ + vertex_offset);
+  vertex_count_ = vertex_count;
+  indices_ = data_ + index_offset;
+  index_count_ = face_count * 3;
+}
+
+void MeshAssetPreloadData::Release() {
+  if (mapped_) {
+    assert(data_);
+    g_core->platform->UnmapFile(data_, data_size_);
+    mapped_ = false;
+  }
+  std::vector<uint8_t>().swap(buffer_);
+  data_ = nullptr;
+  data_size_ = 0;
+  vertices_ = nullptr;
+  vertex_count_ = 0;
+  indices_ = nullptr;
+  index_count_ = 0;
+}
+
+auto MeshAssetPreloadData::index_size() const -> int {
+  switch (format_) {
+    case MeshFormat::kUV16N8Index8:
+      return 1;
+    case MeshFormat::kUV16N8Index16:
+      return 2;
+    case MeshFormat::kUV16N8Index32:
+      return 4;
+    default:
+      throw Exception();
+  }
+}
+
+}  // namespace ballistica::base
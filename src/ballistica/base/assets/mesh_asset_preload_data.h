@@ -0,0 +1,79 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_BASE_ASSETS_MESH_ASSET_PRELOAD_DATA_H_
+#define BALLISTICA_BASE_ASSETS_MESH_ASSET_PRELOAD_DATA_H_
+
+#include <string>
+#include <vector>
+
+#include "ballistica/base/base.h"
+
+namespace ballistica::base {
+
+/// Current version of the aligned bob layout.
+const uint32_t kBobAlignedVersion = 1;
+
+/// Vertex and index data in aligned bob files start on multiples of this.
+const uint32_t kBobAlignment = 16;
+
+/// Header for aligned bob files (ones starting with kBobAlignedFileID).
+/// Unlike legacy bob files, data offsets and total size are explicit so
+/// the file can be validated up front and used in-place from a mapping.
+/// Everything is little-endian.
+struct BobAlignedHeader {
+  uint32_t file_id;
+  uint32_t version;
+  uint32_t mesh_format;
+  uint32_t vertex_count;
+  uint32_t face_count;
+  uint32_t vertex_offset;
+  uint32_t index_offset;
+  uint32_t data_size;
+};
+static_assert(sizeof(BobAlignedHeader) == 32);
+static_assert(sizeof(VertexObjectFull) == 24);
+
+/// Raw contents of a bob file, passed along to the renderer when creating
+/// renderer-data. The file is memory-mapped when possible (or otherwise
+/// read with a single read) and vertex/index pointers point directly into
+/// it, so no per-array copies are made before upload. Both legacy and
+/// aligned bob files are supported.
+class MeshAssetPreloadData {
+ public:
+  MeshAssetPreloadData() = default;
+  ~MeshAssetPreloadData();
+
+  /// Load and validate a bob file. Throws an Exception on errors. If
+  /// `allow_map` is false, the file is always read into memory.
+  void Load(const std::string& path, bool allow_map = true);
+
+  /// Free the mapping/buffer. Pointers obtained from us become invalid.
+  void Release();
+
+  auto loaded() const -> bool { return data_ != nullptr; }
+  auto mapped() const -> bool { return mapped_; }
+  auto data_size() const -> size_t { return data_size_; }
+  auto format() const -> MeshFormat { return format_; }
+  auto vertices() const -> const VertexObjectFull* { return vertices_; }
+  auto vertex_count() const -> uint32_t { return vertex_count_; }
+  auto indices() const -> const void* { return indices_; }
+  auto index_count() const -> uint32_t { return index_count_; }
+  auto index_size() const -> int;
+
+ private:
+  void Parse_(const std::string& path);
+  const uint8_t* data_{};
+  size_t data_size_{};
+  bool mapped_{};
+  std::vector<uint8_t> buffer_;
+  MeshFormat format_{};
+  const VertexObjectFull* vertices_{};
+  uint32_t vertex_count_{};
+  const void* indices_{};
+  uint32_t index_count_{};
+  BA_DISALLOW_CLASS_COPIES(MeshAssetPreloadData);
+};
+
+}  // namespace ballistica::base
+
+#endif  // BALLISTICA_BASE_ASSETS_MESH_ASSET_PRELOAD_DATA_H_
@@ -460,8 +460,11 @@ void TextureAsset::DoLoad() {
   assert(!preload_datas_.empty());
   base_level_ = preload_datas_[0].base_level;
 
-  // If we're done, kill our preload data.
-  preload_datas_.clear();
+  // If we're done, kill our preload data. Streaming textures still need
+  // it for their remaining levels.
+  if (!renderer_data_->streaming()) {
+    preload_datas_.clear();
+  }
 }
 
 void TextureAsset::DoUnload() {
@@ -469,7 +472,37 @@ void TextureAsset::DoUnload() {
   assert(valid_);
   assert(renderer_data_.exists());
   renderer_data_.Clear();
+  preload_datas_.clear();
   base_level_ = 0;
 }
 
+auto TextureAsset::streaming() const -> bool {
+  assert(g_base->app_adapter->InGraphicsContext());
+  return renderer_data_.exists() && renderer_data_->streaming();
+}
+
+auto TextureAsset::StreamLevels(size_t* budget, bool oversized_ok) -> bool {
+  assert(g_base->app_adapter->InGraphicsContext());
+
+  // Don't hold up the frame waiting on someone else's lock; we'll just
+  // try again next time through.
+  if (!TryLock()) {
+    return true;
+  }
+  LockGuard lock(this, LockGuard::Type::kInheritLock);
+
+  // We may have been unloaded since streaming started.
+  if (!loaded() || !streaming()) {
+    return false;
+  }
+  renderer_data_->StreamLevels(budget, oversized_ok);
+
+  // Once the full chain is up we no longer need our source data.
+  if (!renderer_data_->streaming()) {
+    preload_datas_.clear();
+    return false;
+  }
+  return true;
+}
+
 }  // namespace ballistica::base
@@ -43,6 +43,15 @@ class TextureAsset : public Asset {
   }
   auto base_level() const -> int { return base_level_; }
 
+  /// Whether we're loaded but still have larger mip levels to upload.
+  /// Must be called from the graphics context.
+  auto streaming() const -> bool;
+
+  /// Upload more mip levels if we're streaming, drawing from `budget`.
+  /// Returns true if levels remain afterwards. Must be called from the
+  /// graphics context.
+  auto StreamLevels(size_t* budget, bool oversized_ok) -> bool;
+
  private:
   Object::Ref<TextPacker> packer_;
   bool is_qr_code_{};
@@ -19,6 +19,15 @@ class TextureAssetRendererData : public Object {
 
   // Load the data.
   virtual void Load() = 0;
+
+  // Whether larger mip levels are still waiting to be uploaded after
+  // Load(). Such textures are usable but get finished off in bits via
+  // StreamLevels().
+  virtual auto streaming() const -> bool { return false; }
+
+  // Upload more mip levels of a streaming texture, drawing from `budget`
+  // (see TextureStreamPlan::PopLevel() for how it applies).
+  virtual void StreamLevels(size_t* budget, bool oversized_ok) {}
 };
 
 }  // namespace ballistica::base
@@ -29,6 +29,7 @@
 #include "ballistica/base/logic/logic.h"
 #include "ballistica/core/core.h"
 #include "ballistica/core/platform/core_platform.h"
+#include "ballistica/core/support/startup_timeline.h"
 #include "ballistica/shared/foundation/event_loop.h"
 #include "ballistica/shared/math/vector3f.h"
 
@@ -225,6 +226,7 @@ void AudioServer::StartSync_() {
 
 void AudioServer::Start_() {
   assert(g_base->InAudioThread());
+  core::StartupTimeline::ScopedPhase phase("audio-init");
 
   // Get our thread to give us periodic processing time.
   process_timer_ =
@@ -30,11 +30,13 @@
 #include "ballistica/base/support/base_build_switches.h"
 #include "ballistica/base/support/plus_soft.h"
 #include "ballistica/base/support/stdio_console.h"
+#include "ballistica/base/support/step_profiler.h"
 #include "ballistica/base/ui/ui.h"
 #include "ballistica/base/ui/ui_delegate.h"
 #include "ballistica/core/logging/logging.h"
 #include "ballistica/core/logging/logging_macros.h"
 #include "ballistica/core/platform/core_platform.h"
+#include "ballistica/core/support/startup_timeline.h"
 #include "ballistica/shared/foundation/event_loop.h"
 #include "ballistica/shared/generic/utils.h"
 #include "ballistica/shared/math/vector4f.h"
@@ -69,6 +71,7 @@ BaseFeatureSet::BaseFeatureSet()
       python{new BasePython()},
       stdio_console{g_buildconfig.enable_stdio_console() ? new StdioConsole()
                                                          : nullptr},
+      step_profiler{new StepProfiler()},
       text_graphics{new TextGraphics()},
       ui{new UI()},
       utils{new Utils()},
@@ -233,16 +236,35 @@ void BaseFeatureSet::StartApp() {
   // devices with the logic thread before the logic thread applies the
   // current config to them).
 
-  python->OnMainThreadStartApp();
+  {
+    core::StartupTimeline::ScopedPhase phase("python-start-app");
+    python->OnMainThreadStartApp();
+  }
+
+  // Logic-thread init runs asynchronously while we spin up everything
+  // else here. Audio device bringup happens in the audio thread and the
+  // app-adapter's SDL/graphics-context bringup happens right here in the
+  // main thread, so both overlap with logic init. None of that touches
+  // logic state directly; anything pushed to the logic thread (such as
+  // the app-adapter registering initial input devices) simply queues up
+  // behind its init, and the app config gets applied to those devices
+  // only once everything below is done.
   logic->OnMainThreadStartApp();
+  audio_server->OnMainThreadStartApp();
   graphics_server->OnMainThreadStartApp();
   if (bg_dynamics_server) {
     bg_dynamics_server->OnMainThreadStartApp();
   }
   network_writer->OnMainThreadStartApp();
-  audio_server->OnMainThreadStartApp();
   assets_server->OnMainThreadStartApp();
-  app_adapter->OnMainThreadStartApp();
+  {
+    core::StartupTimeline::ScopedPhase phase("app-adapter-start");
+    app_adapter->OnMainThreadStartApp();
+  }
+  {
+    core::StartupTimeline::ScopedPhase phase("logic-start-wait");
+    logic->WaitForAppStart();
+  }
 
   // Ok; we're now official 'started'. Various code such as anything that
   // pushes messages to threads can watch for this state (via IsAppStarted()
@@ -43,6 +43,7 @@ class BaseFeatureSet;
 class BasePlatform;
 class BasePython;
 class BGDynamics;
+class BGDynamicsBudget;
 class BGDynamicsServer;
 class BGDynamicsDrawSnapshot;
 class BGDynamicsEmission;
@@ -71,6 +72,7 @@ class ImageMesh;
 class Input;
 class InputDevice;
 class InputDeviceDelegate;
+class InputLatency;
 class JoystickInput;
 class KeyboardInput;
 class Logic;
@@ -113,6 +115,7 @@ class SDLContext;
 class SoundAsset;
 class SpriteMesh;
 class StdioConsole;
+class StepProfiler;
 class Module;
 class TestInput;
 class TextGroup;
@@ -850,6 +853,7 @@ class BaseFeatureSet : public FeatureSetNativeComponent,
   NetworkReader* const network_reader;
   NetworkWriter* const network_writer;
   StdioConsole* const stdio_console;
+  StepProfiler* const step_profiler;
   TextGraphics* const text_graphics;
   UI* const ui;
   Utils* const utils;
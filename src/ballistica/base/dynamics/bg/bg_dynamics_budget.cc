@@ -0,0 +1,105 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/base/dynamics/bg/bg_dynamics_budget.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "ballistica/base/graphics/graphics_server.h"
+
+namespace ballistica::base {
+
+// Fraction of each step's sim time bg-dynamics processing can use before
+// we start cutting back.
+const float kBGDynamicsStepBudget{0.5f};
+
+// Emissions at least this big on screen (size over distance to camera)
+// get full detail; smaller ones scale down to kBGDynamicsMinDistanceScale.
+const float kBGDynamicsFullDetailScreenSize{0.03f};
+const float kBGDynamicsMinDistanceScale{0.25f};
+
+// How far we'll cut back when over budget.
+const float kBGDynamicsMinLoadScale{0.2f};
+
+// Frame interval to assume when we don't know the display's refresh rate.
+const microsecs_t kBGDynamicsDefaultFrameInterval{16667};
+
+void BGDynamicsBudget::OnStep(microsecs_t duration,
+                              microsecs_t step_interval) {
+  // Cut back if frames are taking longer to render than the display
+  // gives us.
+  bool frames_over_budget{};
+  if (g_base->graphics_server) {
+    auto& frame_pacer{g_base->graphics_server->frame_pacer()};
+    auto frame_interval{frame_pacer.vsync_interval()};
+    if (frame_interval <= 0) {
+      frame_interval = kBGDynamicsDefaultFrameInterval;
+    }
+    frames_over_budget = frame_pacer.render_estimate() > frame_interval;
+  }
+  OnStep(duration, step_interval, frames_over_budget);
+}
+
+void BGDynamicsBudget::OnStep(microsecs_t duration, microsecs_t step_interval,
+                              bool frames_over_budget) {
+  // Jump up to expensive steps immediately but only ease back down, so a
+  // single cheap step doesn't undo our cutbacks.
+  if (duration >= step_cost_) {
+    step_cost_ = duration;
+  } else {
+    step_cost_ -= std::max(microsecs_t{1}, (step_cost_ - duration) / 8);
+  }
+  auto budget{static_cast<microsecs_t>(static_cast<float>(step_interval)
+                                       * kBGDynamicsStepBudget)};
+  bool over_budget{step_cost_ > budget || frames_over_budget};
+
+  auto scale{load_scale_.load()};
+  if (over_budget) {
+    scale = std::max(kBGDynamicsMinLoadScale, scale * 0.9f);
+  } else if (step_cost_ < budget / 2) {
+    scale = std::min(1.0f, scale + 0.01f);
+  }
+  load_scale_ = scale;
+}
+
+auto BGDynamicsBudget::ScaleCount(int count, const Vector3f& position,
+                                  float size, const Vector3f& cam_pos) -> int {
+  if (count <= 0) {
+    return 0;
+  }
+  requested_count_ += count;
+
+  auto distance{std::max(1.0f, (position - cam_pos).Length())};
+  auto distance_scale{std::clamp(size / distance
+                                     / kBGDynamicsFullDetailScreenSize,
+                                 kBGDynamicsMinDistanceScale, 1.0f)};
+  auto scaled{static_cast<float>(count) * distance_scale * load_scale_};
+  auto whole{static_cast<int>(scaled)};
+
+  // Round the remainder up or down based on a hash of the emission
+  // instead of randomly, so repeats of an emission come out the same.
+  uint32_t hash{2166136261u};
+  for (auto value : {std::lround(position.x * 100.0f),
+                     std::lround(position.y * 100.0f),
+                     std::lround(position.z * 100.0f),
+                     static_cast<long>(count)}) {  // NOLINT
+    hash = (hash ^ static_cast<uint32_t>(value)) * 16777619u;
+  }
+  if (scaled - static_cast<float>(whole)
+      > static_cast<float>(hash & 0xFFFFu) / 65536.0f) {
+    whole++;
+  }
+  created_count_ += whole;
+  return whole;
+}
+
+auto BGDynamicsBudget::reduced_fidelity() const -> bool {
+  return load_scale_ < 0.5f;
+}
+
+void BGDynamicsBudget::ResetStats() {
+  requested_count_ = 0;
+  created_count_ = 0;
+}
+
+}  // namespace ballistica::base
@@ -0,0 +1,57 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_BASE_DYNAMICS_BG_BG_DYNAMICS_BUDGET_H_
+#define BALLISTICA_BASE_DYNAMICS_BG_BG_DYNAMICS_BUDGET_H_
+
+#include <atomic>
+
+#include "ballistica/base/base.h"
+#include "ballistica/shared/math/vector3f.h"
+
+namespace ballistica::base {
+
+/// Decides how much of each bg-dynamics emission actually gets created.
+///
+/// Emissions are scaled down by how small they will appear on screen
+/// (size over distance to the camera) and by a load scale that drops
+/// while bg-dynamics steps or rendered frames run over their time budget
+/// and recovers once they are back under it. Scaled counts are rounded
+/// using a hash of the emission instead of randomness, so identical
+/// emissions under identical conditions always get identical results.
+///
+/// Everything but the stats accessors is for the bg-dynamics thread.
+class BGDynamicsBudget {
+ public:
+  /// Call after each bg-dynamics step with how long it took to run and
+  /// how much sim time it covered.
+  void OnStep(microsecs_t duration, microsecs_t step_interval);
+
+  /// Same as above but with whether rendered frames are running over
+  /// their time budget passed in instead of looked up (handy for testing).
+  void OnStep(microsecs_t duration, microsecs_t step_interval,
+              bool frames_over_budget);
+
+  /// Return how many of an emission's `count` items to create.
+  auto ScaleCount(int count, const Vector3f& position, float size,
+                  const Vector3f& cam_pos) -> int;
+
+  /// Whether emissions should skip optional extras (spark smoke trails
+  /// and whatnot) to save simulation time.
+  auto reduced_fidelity() const -> bool;
+
+  auto load_scale() const { return load_scale_.load(); }
+  auto requested_count() const -> int64_t { return requested_count_; }
+  auto created_count() const -> int64_t { return created_count_; }
+  void ResetStats();
+
+ private:
+  // Smoothed cost of recent steps.
+  microsecs_t step_cost_{};
+  std::atomic<float> load_scale_{1.0f};
+  std::atomic<int64_t> requested_count_{};
+  std::atomic<int64_t> created_count_{};
+};
+
+}  // namespace ballistica::base
+
+#endif  // BALLISTICA_BASE_DYNAMICS_BG_BG_DYNAMICS_BUDGET_H_
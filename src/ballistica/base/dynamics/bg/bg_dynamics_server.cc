@@ -1065,6 +1065,11 @@ void BGDynamicsServer::Emit(const BGDynamicsEmission& def) {
 #endif
   }
 
+  // Now scale things down further for emissions that will be small on
+  // screen or if we're running over budget.
+  emit_count = budget_.ScaleCount(emit_count, def.position,
+                                  std::max(def.scale, def.spread), cam_pos_);
+
   if (def.emit_type == BGDynamicsEmitType::kTendrils) {
     if (def.tendril_type == BGDynamicsTendrilType::kThinSmoke) {
       // For thin tendrils, start scaling back once we pass 8 tendrils.
@@ -1167,6 +1172,11 @@ void BGDynamicsServer::Emit(const BGDynamicsEmission& def) {
           do_tendril = true;
         }
 
+        // Smoke trails are an extra we skip when over budget.
+        if (budget_.reduced_fidelity()) {
+          do_tendril = false;
+        }
+
         // If we're emitting sparks, occasionally give one of them a
         // smoke tendril.
         if (do_tendril) {
@@ -2277,6 +2287,8 @@ void BGDynamicsServer::Step(StepData* step_data) {
   // data.
   auto ref(Object::CompleteDeferred(step_data));
 
+  auto start_time{g_core->AppTimeMicrosecs()};
+
   // Keep our quality in sync with the graphics thread's.
   graphics_quality_ = step_data->graphics_quality;
   assert(graphics_quality_ != GraphicsQuality::kUnset);
@@ -2343,6 +2355,10 @@ void BGDynamicsServer::Step(StepData* step_data) {
   // there to fill itself in slowly.
   collision_cache_->Precalc();
 
+  // Let our budget know what that cost us.
+  budget_.OnStep(g_core->AppTimeMicrosecs() - start_time,
+                 step_data->step_millisecs * 1000);
+
   // Job's done!
   {
     std::scoped_lock lock(step_count_mutex_);
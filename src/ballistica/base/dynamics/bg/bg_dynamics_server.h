@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "ballistica/base/dynamics/bg/bg_dynamics.h"
+#include "ballistica/base/dynamics/bg/bg_dynamics_budget.h"
 #include "ballistica/shared/math/matrix44f.h"
 #include "ballistica/shared/math/vector3f.h"
 #include "ode/ode.h"
@@ -105,6 +106,7 @@ class BGDynamicsServer {
     return spark_particles_.get();
   }
   auto step_count() const -> int { return step_count_; }
+  auto budget() -> BGDynamicsBudget& { return budget_; }
   auto event_loop() const -> EventLoop* { return event_loop_; }
 
   auto& shadow_list_mutex() { return shadow_list_mutex_; }
@@ -188,6 +190,7 @@ class BGDynamicsServer {
   float step_seconds_{};
   float step_milliseconds_{};
   GraphicsQuality graphics_quality_{GraphicsQuality::kLow};
+  BGDynamicsBudget budget_;
 };
 
 }  // namespace ballistica::base
@@ -208,7 +208,13 @@ void CollisionCache::CollideAgainstGeom(dGeomID g1, void* data,
   }
 
   // While we're here, lets run one pass of tests on these cells to zero in
-  // on the actual collide/empty cutoff.
+  // on the actual collide/empty cutoff. Our test box changes size from
+  // cell to cell, so it would only clutter the triangle lists; keep
+  // coherence off for it even when colliding a whole space.
+  bool temporal_coherence{temporal_coherence_};
+  if (temporal_coherence) {
+    SetTemporalCoherence_(false);
+  }
   for (int z = z_min; z <= z_max; z++) {
     int base_index = z * grid_width_;
     for (int x = x_min; x <= x_max; x++) {
@@ -217,6 +223,9 @@ void CollisionCache::CollideAgainstGeom(dGeomID g1, void* data,
       TestCell(static_cast<uint32_t>(cell_index), x, z);
     }
   }
+  if (temporal_coherence) {
+    SetTemporalCoherence_(true);
+  }
 }
 
 void CollisionCache::TestCell(size_t cell_index, int x, int z) {
@@ -272,10 +281,36 @@ void CollisionCache::CollideAgainstSpace(dSpaceID space, void* data,
   // We handle our own testing against trimeshes, so we can bring our fancy
   // caching into play.
   if (!geoms_.empty()) {
+    // Space geoms tend to hang around the same bit of terrain from one step
+    // to the next, so we let the terrain remember which triangles were near
+    // each of them. A geom that stays within a slightly inflated copy of
+    // its last query volume just reuses that triangle list instead of
+    // walking the tree again. The lists are supersets kept in tree order,
+    // so the contacts that come out are the same either way.
+    SetTemporalCoherence_(true);
+
     // Intersect all geoms in the space against all terrains.
     for (dxGeom* g1 = space->first; g1; g1 = g1->next) {
       CollideAgainstGeom(g1, data, callback);
     }
+
+    // Queries reuse one-off geoms at arbitrary sizes, which would only
+    // clutter the lists, so this stays off outside of here.
+    SetTemporalCoherence_(false);
+  }
+}
+
+void CollisionCache::SetTemporalCoherence_(bool enable) {
+  temporal_coherence_ = enable;
+  for (dGeomID g : geoms_) {
+    dGeomTriMeshEnableTC(g, dSphereClass, enable);
+    dGeomTriMeshEnableTC(g, dBoxClass, enable);
+  }
+}
+
+void CollisionCache::ForgetGeom(dGeomID geom) {
+  for (dGeomID g : geoms_) {
+    dGeomTriMeshClearTCCacheForGeom(g, geom);
   }
 }
 
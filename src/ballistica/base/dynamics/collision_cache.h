@@ -23,12 +23,17 @@ class CollisionCache {
   void CollideAgainstSpace(dSpaceID space, void* data, dNearCallback* callback);
   void CollideAgainstGeom(dGeomID geom, void* data, dNearCallback* callback);
 
+  // Drop any triangle lists our geoms have cached for this geom. Call this
+  // before destroying or resizing a geom collided via CollideAgainstSpace.
+  void ForgetGeom(dGeomID geom);
+
   // Call this periodically (once per sim step or so) to slowly fill in
   // the cache so there's less to do during spurts of activity.
   void Precalc();
 
  private:
   void TestCell(size_t cell_index, int x, int z);
+  void SetTemporalCoherence_(bool enable);
   void Update();
   uint32_t precalc_index_{};
   std::vector<dGeomID> geoms_;
@@ -39,6 +44,7 @@ class CollisionCache {
   std::vector<Cell> cells_;
   std::vector<uint8_t> glow_;
   bool dirty_{true};
+  bool temporal_coherence_{};
   dGeomID shadow_ray_{};
   dGeomID test_box_{};
   int grid_width_{1};
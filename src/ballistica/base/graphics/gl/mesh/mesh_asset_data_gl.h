@@ -38,13 +38,16 @@ class RendererGL::MeshAssetDataGL : public MeshAssetRendererData {
 
     BA_DEBUG_CHECK_GL_ERROR;
 
-    // Fill our vertex data buffer.
+    // Fill our vertex data buffer. This points straight into the mapped
+    // (or single-read) file data so there's no intermediate copy.
+    const MeshAssetPreloadData& data{model.preload_data()};
+    assert(data.loaded());
     renderer_->BindArrayBuffer(vbos_[kVertices]);
     BA_DEBUG_CHECK_GL_ERROR;
     glBufferData(GL_ARRAY_BUFFER,
-                 static_cast_check_fit<GLsizeiptr>(model.vertices().size()
+                 static_cast_check_fit<GLsizeiptr>(data.vertex_count()
                                                    * sizeof(VertexObjectFull)),
-                 &(model.vertices()[0]), GL_STATIC_DRAW);
+                 data.vertices(), GL_STATIC_DRAW);
     BA_DEBUG_CHECK_GL_ERROR;
 
     glVertexAttribPointer(
@@ -64,33 +67,24 @@ class RendererGL::MeshAssetDataGL : public MeshAssetRendererData {
     // Fill our index data buffer.
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, vbos_[kIndices]);
 
-    const GLvoid* index_data;
-    switch (model.GetIndexSize()) {
-      case 1: {
-        elem_count_ = static_cast<uint32_t>(model.indices8().size());
+    elem_count_ = data.index_count();
+    switch (data.index_size()) {
+      case 1:
         index_type_ = GL_UNSIGNED_BYTE;
-        index_data = static_cast<const GLvoid*>(model.indices8().data());
         break;
-      }
-      case 2: {
-        elem_count_ = static_cast<uint32_t>(model.indices16().size());
+      case 2:
         index_type_ = GL_UNSIGNED_SHORT;
-        index_data = static_cast<const GLvoid*>(model.indices16().data());
         break;
-      }
-      case 4: {
-        elem_count_ = static_cast<uint32_t>(model.indices32().size());
+      case 4:
         index_type_ = GL_UNSIGNED_INT;
-        index_data = static_cast<const GLvoid*>(model.indices32().data());
         break;
-      }
       default:
         throw Exception();
     }
     glBufferData(
         GL_ELEMENT_ARRAY_BUFFER,
-        static_cast_check_fit<GLsizeiptr>(elem_count_ * model.GetIndexSize()),
-        index_data, GL_STATIC_DRAW);
+        static_cast_check_fit<GLsizeiptr>(elem_count_ * data.index_size()),
+        data.indices(), GL_STATIC_DRAW);
 
     BA_DEBUG_CHECK_GL_ERROR;
   }
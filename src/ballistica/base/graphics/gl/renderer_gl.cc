@@ -1007,6 +1007,7 @@ void RendererGL::ProcessRenderCommandBuffer(RenderCommandBuffer* buffer,
         break;
       case RenderCommandBuffer::Command::kShader: {
         auto shader = static_cast<ShadingType>(buffer->GetInt());
+        auto args_start{buffer->values_read()};
         switch (shader) {
           case ShadingType::kSimpleColor: {
             SetDoubleSided_(false);
@@ -1865,6 +1866,20 @@ void RendererGL::ProcessRenderCommandBuffer(RenderCommandBuffer* buffer,
           default:
             FatalError("Unhandled Shader Type.");
         }
+
+        // Other renderers decode shader binds using the shared table, so
+        // make sure it describes exactly what we just read.
+        if (g_buildconfig.debug_build()) {
+          auto args_end{buffer->values_read()};
+          auto args{RenderCommandBuffer::GetShaderArgs(shader)};
+          if (args_end.ints - args_start.ints != args.ints
+              || args_end.floats - args_start.floats != args.floats
+              || args_end.textures - args_start.textures != args.textures) {
+            FatalError("RenderCommandBuffer::GetShaderArgs() is wrong for"
+                       " shading type "
+                       + std::to_string(static_cast<int>(shader)) + ".");
+          }
+        }
         break;
       }
       case RenderCommandBuffer::Command::kSimpleComponentInlineColor: {
@@ -12,6 +12,7 @@
 #include "ballistica/base/assets/texture_asset_renderer_data.h"
 #include "ballistica/base/graphics/gl/renderer_gl.h"
 #include "ballistica/base/graphics/graphics_server.h"
+#include "ballistica/base/graphics/texture/texture_stream_plan.h"
 
 namespace ballistica::base {
 
@@ -49,6 +50,8 @@ class RendererGL::TextureDataGL : public TextureAssetRendererData {
 
   auto GetTexture() const -> GLuint { return texture_; }
 
+  auto streaming() const -> bool override { return stream_plan_.streaming(); }
+
   void Load() override {
     assert(g_base->app_adapter->InGraphicsContext());
     BA_DEBUG_CHECK_GL_ERROR;
@@ -157,8 +160,12 @@ class RendererGL::TextureDataGL : public TextureAssetRendererData {
       glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
       glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
 
-      int src_level = base_src_level;
-      int level = 0;
+      // Compressed chains get streamed; we upload just the smallest levels
+      // here and the rest come in through StreamLevels(). (For anything
+      // else the plan is empty and this starts at level 0 as usual).
+      stream_plan_ = TextureStreamPlan(tex_media_->preload_datas());
+      int src_level = base_src_level + stream_plan_.initial_level();
+      int level = stream_plan_.initial_level();
       bool all_levels_handled = false;
       while (preload_data->buffers[src_level] != nullptr
              && !all_levels_handled) {
@@ -226,11 +233,18 @@ class RendererGL::TextureDataGL : public TextureAssetRendererData {
         level++;
         BA_DEBUG_CHECK_GL_ERROR;
       }
+      if (stream_plan_.streaming()) {
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL,
+                        stream_plan_.resident_level());
+      }
       BA_GL_LABEL_OBJECT(GL_TEXTURE, texture_, tex_media_->GetName().c_str());
     } else if (tex_media_->texture_type() == TextureType::kCubeMap) {
       // Cube map.
       renderer_->BindTexture_(GL_TEXTURE_CUBE_MAP, texture_);
 
+      // As with 2d textures, compressed faces get streamed.
+      stream_plan_ = TextureStreamPlan(tex_media_->preload_datas());
+
       bool do_generate_mips = false;
       for (uint32_t i = 0; i < 6; i++) {
         const TextureAssetPreloadData* preload_data =
@@ -255,8 +269,8 @@ class RendererGL::TextureDataGL : public TextureAssetRendererData {
         glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T,
                         GL_CLAMP_TO_EDGE);
 
-        int src_level = base_src_level;
-        int level = 0;
+        int src_level = base_src_level + stream_plan_.initial_level();
+        int level = stream_plan_.initial_level();
         bool generating_remaining_mips = false;
         while (preload_data->buffers[src_level] != nullptr
                && !generating_remaining_mips) {
@@ -312,6 +326,10 @@ class RendererGL::TextureDataGL : public TextureAssetRendererData {
       if (do_generate_mips) {
         glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
       }
+      if (stream_plan_.streaming()) {
+        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_BASE_LEVEL,
+                        stream_plan_.resident_level());
+      }
 
       BA_GL_LABEL_OBJECT(GL_TEXTURE, texture_, tex_media_->GetName().c_str());
     } else {
@@ -320,10 +338,47 @@ class RendererGL::TextureDataGL : public TextureAssetRendererData {
     BA_DEBUG_CHECK_GL_ERROR;
   }
 
+  void StreamLevels(size_t* budget, bool oversized_ok) override {
+    assert(g_base->app_adapter->InGraphicsContext());
+    bool is_cube_map{tex_media_->texture_type() == TextureType::kCubeMap};
+    GLuint target = is_cube_map ? GL_TEXTURE_CUBE_MAP : GL_TEXTURE_2D;
+    int face_count{is_cube_map ? 6 : 1};
+    int resident_level_prev{stream_plan_.resident_level()};
+    int level;
+    while ((level = stream_plan_.PopLevel(budget, oversized_ok)) != -1) {
+      oversized_ok = false;
+      if (level == resident_level_prev - 1) {
+        renderer_->BindTexture_(target, texture_);
+      }
+      for (int face = 0; face < face_count; ++face) {
+        const TextureAssetPreloadData& preload_data{
+            tex_media_->preload_datas()[face]};
+        int src_level = preload_data.base_level + level;
+        assert(preload_data.buffers[src_level]);
+        glCompressedTexImage2D(
+            is_cube_map ? GL_TEXTURE_CUBE_MAP_POSITIVE_X + face
+                        : GL_TEXTURE_2D,
+            level, GetGLTextureFormat(preload_data.formats[src_level]),
+            preload_data.widths[src_level], preload_data.heights[src_level],
+            0, static_cast_check_fit<GLsizei>(preload_data.sizes[src_level]),
+            preload_data.buffers[src_level]);
+      }
+      BA_DEBUG_CHECK_GL_ERROR;
+    }
+
+    // Now that the new levels are complete, let sampling use them.
+    if (stream_plan_.resident_level() != resident_level_prev) {
+      glTexParameteri(target, GL_TEXTURE_BASE_LEVEL,
+                      stream_plan_.resident_level());
+      BA_DEBUG_CHECK_GL_ERROR;
+    }
+  }
+
  private:
   const TextureAsset* tex_media_;
   RendererGL* renderer_;
   GLuint texture_;
+  TextureStreamPlan stream_plan_;
 };
 
 }  // namespace ballistica::base
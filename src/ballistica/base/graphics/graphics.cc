@@ -823,6 +823,8 @@ void Graphics::BuildAndPushFrameDef() {
   frame_def->set_display_time_elapsed_millisecs(elapsed_millisecs);
   frame_def->set_frame_number(frame_def_count_);
   frame_def->set_frame_number_filtered(frame_def_count_filtered_);
+  frame_def->set_input_event_time(
+      g_base->input->latency().TakeFrameEventTime());
 
   if (!internal_components_inited_) {
     InitInternalComponents(frame_def);
@@ -2,6 +2,7 @@
 
 #include "ballistica/base/graphics/graphics_server.h"
 
+#include <chrono>
 #include <list>
 #include <vector>
 
@@ -9,10 +10,12 @@
 #include "ballistica/base/assets/assets.h"
 #include "ballistica/base/graphics/graphics.h"
 #include "ballistica/base/graphics/renderer/renderer.h"
+#include "ballistica/base/input/input.h"
 #include "ballistica/base/logic/logic.h"
 #include "ballistica/core/core.h"
 #include "ballistica/core/logging/logging.h"
 #include "ballistica/core/platform/core_platform.h"
+#include "ballistica/core/support/startup_timeline.h"
 #include "ballistica/shared/foundation/event_loop.h"
 
 namespace ballistica::base {
@@ -29,15 +32,16 @@ void GraphicsServer::OnMainThreadStartApp() {}
 
 void GraphicsServer::EnqueueFrameDef(FrameDef* framedef) {
   // Note: we're just setting the framedef directly here even though this
-  // gets called from the logic thread. Ideally it would seem we should push
-  // these to our thread event list, but currently we may spin-lock waiting
-  // for new frames to appear which would prevent that from working; we
-  // would need to change that code.
+  // gets called from the logic thread. We may be blocked in
+  // WaitForRenderFrameDef_() waiting for it, so pushing it to our thread's
+  // event list would not work; instead we hand it over directly and wake
+  // the waiter.
   {
     std::scoped_lock frame_def_lock(frame_def_mutex_);
     assert(frame_def_ == nullptr);
     frame_def_ = framedef;
   }
+  frame_def_cv_.notify_one();
 }
 
 void GraphicsServer::ApplySettings(const GraphicsSettings* settings) {
@@ -127,6 +131,9 @@ auto GraphicsServer::TryRender() -> bool {
     // Apply any new graphics settings passed along via the frame-def.
     ApplySettings(frame_def->settings());
 
+    // Push up this frame's share of any streaming texture mip levels.
+    g_base->assets->RunPendingTextureStreams();
+
     // Note: we run mesh-updates on each frame-def that comes through even
     // if we don't actually render the frame.
     RunFrameDefMeshUpdates(frame_def);
@@ -134,10 +141,23 @@ auto GraphicsServer::TryRender() -> bool {
     // Only actually render if we have a screen and aren't in a hold.
     auto target = renderer()->screen_render_target();
     if (target != nullptr && render_hold_ == 0) {
+      auto render_start_time{g_core->AppTimeMicrosecs()};
       PreprocessRenderFrameDef(frame_def);
       DrawRenderFrameDef(frame_def);
       FinishRenderFrameDef(frame_def);
+      frame_pacer_.OnFrameRendered(g_core->AppTimeMicrosecs()
+                                   - render_start_time);
       success = true;
+
+      // Input latency gets measured through to when this gets presented.
+      rendered_input_event_time_ = frame_def->input_event_time();
+
+      // For startup timing purposes, a gui app is 'ready' once something
+      // is on screen.
+      if (!drew_first_frame_) {
+        drew_first_frame_ = true;
+        g_core->startup_timeline->MarkReady("first-frame");
+      }
     }
 
     // Send this frame_def back to the logic thread for deletion or
@@ -152,7 +172,7 @@ auto GraphicsServer::WaitForRenderFrameDef_() -> FrameDef* {
   assert(g_base->app_adapter->InGraphicsContext());
   millisecs_t start_time = g_core->AppTimeMillisecs();
 
-  // Spin and wait for a short bit for a frame_def to appear.
+  // Wait for a short bit for a frame_def to appear.
   while (true) {
     // Stop waiting if we can't/shouldn't render anyway.
     if (!renderer_ || shutting_down_ || g_base->app_suspended()) {
@@ -164,21 +184,22 @@ auto GraphicsServer::WaitForRenderFrameDef_() -> FrameDef* {
 
     FrameDef* frame_def{};
     {
-      std::scoped_lock llock(frame_def_mutex_);
-      if (frame_def_) {
-        frame_def = frame_def_;
-        frame_def_ = nullptr;
-      }
+      // Sleep until the logic thread hands us a frame_def. We wake
+      // periodically even without one to keep loads moving and to notice
+      // suspends/shutdowns.
+      std::unique_lock lock(frame_def_mutex_);
+      frame_def_cv_.wait_for(lock, std::chrono::milliseconds(5),
+                             [this] { return frame_def_ != nullptr; });
+      frame_def = frame_def_;
+      frame_def_ = nullptr;
     }
     if (frame_def) {
       // As soon as we start working on rendering a frame, ask the logic
-      // thread to start working on the next one for us. Keeps things nice
-      // and pipelined.
-      g_base->logic->event_loop()->PushCall([] { g_base->logic->Draw(); });
+      // thread for the next one. Keeps things nice and pipelined.
+      RequestNextFrameDef_();
       return frame_def;
     }
 
-    // If there's no frame_def for us, sleep for a bit and wait for it.
     millisecs_t t = g_core->AppTimeMillisecs() - start_time;
     if (t >= 1000) {
       if (g_buildconfig.debug_build()) {
@@ -189,11 +210,32 @@ auto GraphicsServer::WaitForRenderFrameDef_() -> FrameDef* {
       }
       break;  // Fail.
     }
-    core::CorePlatform::SleepMillisecs(1);
   }
   return nullptr;
 }
 
+void GraphicsServer::RequestNextFrameDef_() {
+  // When pacing, the logic thread holds off building until just before
+  // we'll need the frame so it reflects the freshest input and state
+  // possible.
+  auto now{g_core->AppTimeMicrosecs()};
+  auto build_time{frame_pacer_.BuildStartTime(now)};
+  if (build_time <= now) {
+    g_base->logic->event_loop()->PushCall([] { g_base->logic->Draw(); });
+  } else {
+    g_base->logic->event_loop()->PushCall(
+        [build_time] { g_base->logic->DrawAt(build_time); });
+  }
+}
+
+void GraphicsServer::OnFramePresented() {
+  frame_pacer_.OnFramePresented(g_core->AppTimeMicrosecs());
+  if (rendered_input_event_time_ >= 0) {
+    g_base->input->latency().OnFramePresented(rendered_input_event_time_);
+    rendered_input_event_time_ = -1;
+  }
+}
+
 // Runs any mesh updates contained in the frame-def.
 void GraphicsServer::RunFrameDefMeshUpdates(FrameDef* frame_def) {
   assert(g_base->app_adapter->InGraphicsContext());
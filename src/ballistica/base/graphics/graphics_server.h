@@ -3,6 +3,7 @@
 #ifndef BALLISTICA_BASE_GRAPHICS_GRAPHICS_SERVER_H_
 #define BALLISTICA_BASE_GRAPHICS_GRAPHICS_SERVER_H_
 
+#include <condition_variable>
 #include <list>
 #include <memory>
 #include <mutex>
@@ -10,6 +11,7 @@
 #include <vector>
 
 #include "ballistica/base/base.h"
+#include "ballistica/base/graphics/support/frame_pacer.h"
 #include "ballistica/shared/foundation/object.h"
 #include "ballistica/shared/generic/snapshot.h"
 #include "ballistica/shared/math/matrix44f.h"
@@ -80,6 +82,13 @@ class GraphicsServer {
   // Returns true if a frame was rendered.
   auto TryRender() -> bool;
 
+  /// Should be called by the app-adapter once a rendered frame has been
+  /// presented (ie: right after a buffer swap returns).
+  void OnFramePresented();
+
+  /// Decides when the logic thread builds frame-defs for us.
+  auto frame_pacer() -> FramePacer& { return frame_pacer_; }
+
   // Init the modelview matrix to look here.
   void SetCamera(const Vector3f& eye, const Vector3f& target,
                  const Vector3f& up);
@@ -294,6 +303,9 @@ class GraphicsServer {
   // disposed of using the RenderFrameDef* calls.
   auto WaitForRenderFrameDef_() -> FrameDef*;
 
+  // Ask the logic thread for the next frame-def, timed by our frame pacer.
+  void RequestNextFrameDef_();
+
   // Update virtual screen dimensions based on the current physical ones.
   // static void CalcVirtualRes_(float* x, float* y);
   // void UpdateVirtualScreenRes_();
@@ -328,6 +340,8 @@ class GraphicsServer {
   bool cam_orient_matrix_dirty_{true};
   bool shutting_down_{};
   bool shutdown_completed_{};
+  bool drew_first_frame_{};
+  microsecs_t rendered_input_event_time_{-1};
   float res_x_{};
   float res_y_{};
   float res_x_virtual_{};
@@ -356,6 +370,8 @@ class GraphicsServer {
   Renderer* renderer_{};
   FrameDef* frame_def_{};
   std::mutex frame_def_mutex_{};
+  std::condition_variable frame_def_cv_{};
+  FramePacer frame_pacer_;
 };
 
 }  // namespace ballistica::base
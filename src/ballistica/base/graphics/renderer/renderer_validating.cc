@@ -0,0 +1,1323 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/base/graphics/renderer/renderer_validating.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "ballistica/base/app_adapter/app_adapter.h"
+#include "ballistica/base/assets/mesh_asset.h"
+#include "ballistica/base/assets/texture_asset_renderer_data.h"
+#include "ballistica/base/graphics/component/special_component.h"
+#include "ballistica/base/graphics/graphics_server.h"
+#include "ballistica/base/graphics/mesh/mesh_buffer.h"
+#include "ballistica/base/graphics/mesh/mesh_index_buffer_16.h"
+#include "ballistica/base/graphics/mesh/mesh_index_buffer_32.h"
+#include "ballistica/base/graphics/mesh/mesh_renderer_data.h"
+#include "ballistica/core/core.h"
+#include "ballistica/core/logging/logging.h"
+#include "ballistica/core/platform/core_platform.h"
+
+namespace ballistica::base {
+
+// Matches the transform stack depth the graphics-server allows.
+const int kMaxValidatingTransformDepth{19};
+
+// We stop logging individual errors after this many; they still get
+// counted.
+const int kMaxValidatingErrorLogs{10};
+
+namespace {
+
+enum class ShaderBlend {
+  kOpaque,
+  /// Blended; the first int says whether color is premultiplied.
+  kChoice,
+  kPremult,
+};
+
+/// Which inline-color commands a shader accepts.
+enum class ShaderFamily { kSimple, kObject, kOther };
+
+/// How we treat a shading type. What its shader-bind commands carry
+/// comes from RenderCommandBuffer::GetShaderArgs().
+struct ShadingInfo {
+  ShaderBlend blend;
+  ShaderFamily family;
+  /// Whether our flat rasterizer draws anything for it.
+  bool paint;
+  /// Which int is a LightShadowType (or -1 for none).
+  int light_shadow_int;
+};
+
+auto GetShadingInfo(ShadingType type) -> ShadingInfo {
+  using B = ShaderBlend;
+  using F = ShaderFamily;
+  switch (type) {
+    case ShadingType::kSimpleColor:
+      return {B::kOpaque, F::kSimple, true, -1};
+    case ShadingType::kSimpleColorTransparent:
+    case ShadingType::kSimpleColorTransparentDoubleSided:
+      return {B::kChoice, F::kSimple, true, -1};
+    case ShadingType::kSimpleTexture:
+      return {B::kOpaque, F::kSimple, true, -1};
+    case ShadingType::kSimpleTextureModulated:
+      return {B::kOpaque, F::kSimple, true, -1};
+    case ShadingType::kSimpleTextureModulatedColorized:
+      return {B::kOpaque, F::kSimple, true, -1};
+    case ShadingType::kSimpleTextureModulatedColorized2:
+      return {B::kOpaque, F::kSimple, true, -1};
+    case ShadingType::kSimpleTextureModulatedColorized2Masked:
+      return {B::kOpaque, F::kSimple, true, -1};
+    case ShadingType::kSimpleTextureModulatedTransparent:
+    case ShadingType::kSimpleTextureModulatedTransparentDoubleSided:
+      return {B::kChoice, F::kSimple, true, -1};
+    case ShadingType::kSimpleTextureModulatedTransFlatness:
+      return {B::kChoice, F::kSimple, true, -1};
+    case ShadingType::kSimpleTextureModulatedTransparentColorized:
+      return {B::kChoice, F::kSimple, true, -1};
+    case ShadingType::kSimpleTextureModulatedTransparentColorized2:
+      return {B::kChoice, F::kSimple, true, -1};
+    case ShadingType::kSimpleTextureModulatedTransparentColorized2Masked:
+      return {B::kChoice, F::kSimple, true, -1};
+    case ShadingType::kSimpleTextureModulatedTransparentShadow:
+      return {B::kChoice, F::kSimple, true, -1};
+    case ShadingType::kSimpleTexModulatedTransShadowFlatness:
+      return {B::kChoice, F::kSimple, true, -1};
+    case ShadingType::kSimpleTextureModulatedTransparentGlow:
+      return {B::kChoice, F::kSimple, true, -1};
+    case ShadingType::kSimpleTextureModulatedTransparentGlowMaskUV2:
+      return {B::kChoice, F::kSimple, true, -1};
+    case ShadingType::kObject:
+      return {B::kOpaque, F::kObject, true, -1};
+    case ShadingType::kObjectTransparent:
+      return {B::kChoice, F::kObject, true, -1};
+    case ShadingType::kObjectLightShadowTransparent:
+      return {B::kChoice, F::kObject, true, 1};
+    case ShadingType::kSpecial:
+      // Draws the contents of another buffer; nothing for us to show.
+      return {B::kPremult, F::kSimple, false, -1};
+    case ShadingType::kShield:
+      return {B::kPremult, F::kOther, false, -1};
+    case ShadingType::kObjectReflect:
+      return {B::kOpaque, F::kObject, true, -1};
+    case ShadingType::kObjectReflectTransparent:
+      return {B::kChoice, F::kObject, true, -1};
+    case ShadingType::kObjectReflectAddTransparent:
+      return {B::kChoice, F::kObject, true, -1};
+    case ShadingType::kObjectLightShadow:
+      return {B::kOpaque, F::kObject, true, 0};
+    case ShadingType::kObjectReflectLightShadow:
+    case ShadingType::kObjectReflectLightShadowDoubleSided:
+      return {B::kOpaque, F::kObject, true, 0};
+    case ShadingType::kObjectReflectLightShadowColorized:
+      return {B::kOpaque, F::kObject, true, 0};
+    case ShadingType::kObjectReflectLightShadowColorized2:
+      return {B::kOpaque, F::kObject, true, 0};
+    case ShadingType::kObjectReflectLightShadowAdd:
+      return {B::kOpaque, F::kObject, true, 0};
+    case ShadingType::kObjectReflectLightShadowAddColorized:
+      return {B::kOpaque, F::kObject, true, 0};
+    case ShadingType::kObjectReflectLightShadowAddColorized2:
+      return {B::kOpaque, F::kObject, true, 0};
+    case ShadingType::kSmoke:
+    case ShadingType::kSmokeOverlay:
+      return {B::kPremult, F::kOther, true, -1};
+    case ShadingType::kPostProcess:
+    case ShadingType::kPostProcessEyes:
+      return {B::kOpaque, F::kOther, true, -1};
+    case ShadingType::kPostProcessNormalDistort:
+      return {B::kOpaque, F::kOther, true, -1};
+    case ShadingType::kSprite:
+      // Sprites get expanded from their centers in the vertex shader;
+      // we just count them.
+      return {B::kPremult, F::kOther, false, -1};
+    default:
+      throw Exception("Unhandled shading type "
+                      + std::to_string(static_cast<int>(type)) + ".");
+  }
+}
+
+auto IsPostProcess(int shader) -> bool {
+  auto type{static_cast<ShadingType>(shader)};
+  return type == ShadingType::kPostProcess
+         || type == ShadingType::kPostProcessEyes
+         || type == ShadingType::kPostProcessNormalDistort;
+}
+
+template <typename T>
+void CopyPositions(const MeshBuffer<T>& src, std::vector<float>* dst) {
+  dst->resize(src.elements.size() * 3);
+  float* out{dst->data()};
+  for (auto&& vertex : src.elements) {
+    out[0] = vertex.position[0];
+    out[1] = vertex.position[1];
+    out[2] = vertex.position[2];
+    out += 3;
+  }
+}
+
+}  // namespace
+
+class RendererValidating::RenderTargetValidating : public RenderTarget {
+ public:
+  // Screen constructor.
+  explicit RenderTargetValidating(RendererValidating* renderer)
+      : RenderTarget(Type::kScreen), renderer_{renderer} {
+    assert(g_base->app_adapter->InGraphicsContext());
+    depth_ = true;
+
+    // This will update our width/height values.
+    OnScreenSizeChange();
+  }
+
+  // Framebuffer constructor.
+  RenderTargetValidating(RendererValidating* renderer, int width, int height,
+                         bool depth)
+      : RenderTarget(Type::kFramebuffer), renderer_{renderer} {
+    assert(g_base->app_adapter->InGraphicsContext());
+    physical_width_ = static_cast<float>(width);
+    physical_height_ = static_cast<float>(height);
+    depth_ = depth;
+  }
+
+  void DrawBegin(bool must_clear_color, float clear_r, float clear_g,
+                 float clear_b, float clear_a) override {
+    renderer_->OnDrawBegin_(this, must_clear_color, clear_r, clear_g, clear_b);
+  }
+
+  /// Size our pixel storage to match our current dimensions. Contents are
+  /// undefined after a size change (as with a real framebuffer).
+  void Allocate() {
+    width_ = std::max(1, static_cast<int>(physical_width_));
+    height_ = std::max(1, static_cast<int>(physical_height_));
+    auto count{static_cast<size_t>(width_) * static_cast<size_t>(height_)};
+    if (color.size() != count * 3) {
+      color.assign(count * 3, 0.0f);
+      depth.assign(depth_ ? count : 0, 1.0f);
+    }
+  }
+
+  auto width() const -> int { return width_; }
+  auto height() const -> int { return height_; }
+  auto has_depth() const -> bool { return depth_; }
+
+  // Linear rgb values with rows running bottom to top.
+  std::vector<float> color;
+  std::vector<float> depth;
+
+ private:
+  RendererValidating* renderer_{};
+  int width_{1};
+  int height_{1};
+};
+
+class RendererValidating::MeshAssetDataValidating
+    : public MeshAssetRendererData {
+ public:
+  explicit MeshAssetDataValidating(const MeshAsset& mesh) {
+    assert(g_base->app_adapter->InGraphicsContext());
+
+    // The asset lets go of its preload data once we're made, so grab what
+    // we need now.
+    const MeshAssetPreloadData& data{mesh.preload_data()};
+    assert(data.loaded());
+    positions.resize(static_cast<size_t>(data.vertex_count()) * 3);
+    for (uint32_t i = 0; i < data.vertex_count(); ++i) {
+      const VertexObjectFull& vertex{data.vertices()[i]};
+      positions[i * 3] = vertex.position[0];
+      positions[i * 3 + 1] = vertex.position[1];
+      positions[i * 3 + 2] = vertex.position[2];
+    }
+    if (data.index_size() == 4) {
+      auto* src{static_cast<const uint32_t*>(data.indices())};
+      indices.assign(src, src + data.index_count());
+    } else {
+      auto* src{static_cast<const uint16_t*>(data.indices())};
+      indices.assign(src, src + data.index_count());
+    }
+  }
+
+  std::vector<float> positions;
+  std::vector<uint32_t> indices;
+};
+
+class RendererValidating::TextureDataValidating
+    : public TextureAssetRendererData {
+ public:
+  void Load() override {
+    // We never sample textures so there's nothing to upload.
+  }
+};
+
+class RendererValidating::MeshDataValidating : public MeshRendererData {
+ public:
+  explicit MeshDataValidating(MeshDataType type) : type{type} {}
+
+  MeshDataType type;
+  std::vector<float> positions;
+  std::vector<uint32_t> indices;
+  uint32_t max_index{};
+  uint32_t index_state{};
+  uint32_t vertex_state{};
+  bool have_indices{};
+  bool have_vertices{};
+};
+
+std::mutex RendererValidating::active_mutex_;
+RendererValidating* RendererValidating::active_{};
+
+RendererValidating::RendererValidating() {
+  std::scoped_lock lock(active_mutex_);
+  active_ = this;
+}
+
+RendererValidating::~RendererValidating() {
+  std::scoped_lock lock(active_mutex_);
+  if (active_ == this) {
+    active_ = nullptr;
+  }
+}
+
+auto RendererValidating::WithActive(
+    const std::function<void(RendererValidating*)>& call) -> bool {
+  std::scoped_lock lock(active_mutex_);
+  if (!active_) {
+    return false;
+  }
+  call(active_);
+  return true;
+}
+
+auto RendererValidating::GetAutoGraphicsQuality() -> GraphicsQuality {
+  // Keep the default path simple: the world gets drawn straight to the
+  // screen with no intermediate buffers.
+  return GraphicsQuality::kMedium;
+}
+
+auto RendererValidating::GetAutoTextureQuality() -> TextureQuality {
+  return TextureQuality::kLow;
+}
+
+auto RendererValidating::NewMeshAssetData(const MeshAsset& mesh)
+    -> Object::Ref<MeshAssetRendererData> {
+  return Object::New<MeshAssetRendererData, MeshAssetDataValidating>(mesh);
+}
+
+auto RendererValidating::NewTextureData(const TextureAsset& texture)
+    -> Object::Ref<TextureAssetRendererData> {
+  return Object::New<TextureAssetRendererData, TextureDataValidating>();
+}
+
+auto RendererValidating::NewMeshData(MeshDataType type, MeshDrawType draw_type)
+    -> MeshRendererData* {
+  return new MeshDataValidating(type);
+}
+
+void RendererValidating::DeleteMeshData(MeshRendererData* data,
+                                        MeshDataType type) {
+  auto* m{static_cast<MeshDataValidating*>(data)};
+  assert(m && m == dynamic_cast<MeshDataValidating*>(data));
+  if (m->type != type) {
+    Error_("Mesh data deleted as the wrong type.");
+  }
+  delete m;
+}
+
+auto RendererValidating::NewScreenRenderTarget() -> RenderTarget* {
+  return Object::NewDeferred<RenderTargetValidating>(this);
+}
+
+auto RendererValidating::NewFramebufferRenderTarget(
+    int width, int height, bool linear_interp, bool depth, bool texture,
+    bool depth_texture, bool high_quality, bool msaa, bool alpha)
+    -> Object::Ref<RenderTarget> {
+  if (width <= 0 || height <= 0) {
+    Error_("Framebuffer requested with size " + std::to_string(width) + "x"
+           + std::to_string(height) + ".");
+  }
+  return Object::New<RenderTarget, RenderTargetValidating>(
+      this, std::max(1, width), std::max(1, height), depth);
+}
+
+void RendererValidating::UpdateMeshes(
+    const std::vector<Object::Ref<MeshDataClientHandle>>& meshes,
+    const std::vector<int8_t>& index_sizes,
+    const std::vector<Object::Ref<MeshBufferBase>>& buffers) {
+  auto index_size = index_sizes.begin();
+  auto buffer = buffers.begin();
+  for (auto&& mesh : meshes) {
+    MeshData* mesh_data = mesh->mesh_data;
+    auto* m{static_cast<MeshDataValidating*>(mesh_data->renderer_data())};
+    assert(m
+           && m
+                  == dynamic_cast<MeshDataValidating*>(
+                      mesh_data->renderer_data()));
+    frame_stats_.mesh_updates++;
+
+    // Each mesh gets an index buffer followed by its vertex buffer (or
+    // static and dynamic vertex buffers for split types).
+    bool split{mesh_data->type() == MeshDataType::kIndexedSimpleSplit
+               || mesh_data->type() == MeshDataType::kIndexedObjectSplit};
+    auto buffer_count{split ? 3 : 2};
+    if (index_size == index_sizes.end() || buffers.end() - buffer < buffer_count
+        || !buffer[0].exists() || !buffer[1].exists()
+        || (split && !buffer[2].exists())) {
+      Error_("Mesh update is missing buffers.");
+      return;
+    }
+    if (m->type != mesh_data->type()) {
+      Error_("Mesh data type does not match its renderer data.");
+    }
+
+    // Indices.
+    if (!m->have_indices || (*buffer)->state != m->index_state) {
+      if (*index_size == 4) {
+        auto& elements{
+            static_cast<MeshIndexBuffer32*>(buffer->get())->elements};
+        m->indices.assign(elements.begin(), elements.end());
+      } else if (*index_size == 2) {
+        auto& elements{
+            static_cast<MeshIndexBuffer16*>(buffer->get())->elements};
+        m->indices.assign(elements.begin(), elements.end());
+      } else {
+        Error_("Invalid mesh index size "
+               + std::to_string(static_cast<int>(*index_size)) + ".");
+        m->indices.clear();
+      }
+      if (m->indices.size() % 3 != 0) {
+        Error_("Mesh index count is not a multiple of 3.");
+      }
+      m->max_index = 0;
+      for (auto index : m->indices) {
+        m->max_index = std::max(m->max_index, index);
+      }
+      m->index_state = (*buffer)->state;
+      m->have_indices = true;
+    }
+    index_size++;
+    buffer++;
+
+    // Vertices. We only care about positions; for split types those live
+    // in the dynamic buffer.
+    size_t static_count{};
+    if (split) {
+      if (mesh_data->type() == MeshDataType::kIndexedSimpleSplit) {
+        static_count =
+            static_cast<MeshBuffer<VertexSimpleSplitStatic>*>(buffer->get())
+                ->elements.size();
+      } else {
+        static_count =
+            static_cast<MeshBuffer<VertexObjectSplitStatic>*>(buffer->get())
+                ->elements.size();
+      }
+      buffer++;
+    }
+    if (!m->have_vertices || (*buffer)->state != m->vertex_state) {
+      switch (mesh_data->type()) {
+        case MeshDataType::kIndexedSimpleSplit:
+          CopyPositions(*static_cast<MeshBuffer<VertexSimpleSplitDynamic>*>(
+                            buffer->get()),
+                        &m->positions);
+          break;
+        case MeshDataType::kIndexedObjectSplit:
+          CopyPositions(*static_cast<MeshBuffer<VertexObjectSplitDynamic>*>(
+                            buffer->get()),
+                        &m->positions);
+          break;
+        case MeshDataType::kIndexedSimpleFull:
+          CopyPositions(
+              *static_cast<MeshBuffer<VertexSimpleFull>*>(buffer->get()),
+              &m->positions);
+          break;
+        case MeshDataType::kIndexedDualTextureFull:
+          CopyPositions(
+              *static_cast<MeshBuffer<VertexDualTextureFull>*>(buffer->get()),
+              &m->positions);
+          break;
+        case MeshDataType::kIndexedSmokeFull:
+          CopyPositions(
+              *static_cast<MeshBuffer<VertexSmokeFull>*>(buffer->get()),
+              &m->positions);
+          break;
+        case MeshDataType::kSprite:
+          CopyPositions(*static_cast<MeshBuffer<VertexSprite>*>(buffer->get()),
+                        &m->positions);
+          break;
+        default:
+          Error_("Invalid mesh data type.");
+          m->positions.clear();
+          break;
+      }
+      m->vertex_state = (*buffer)->state;
+      m->have_vertices = true;
+    }
+    buffer++;
+
+    auto vertex_count{m->positions.size() / 3};
+    if (split && static_count != vertex_count) {
+      Error_("Split mesh static/dynamic vertex counts differ ("
+             + std::to_string(static_count) + " vs "
+             + std::to_string(vertex_count) + ").");
+    }
+    if (!m->indices.empty() && m->max_index >= vertex_count) {
+      Error_("Mesh index " + std::to_string(m->max_index)
+             + " is out of range for " + std::to_string(vertex_count)
+             + " vertices.");
+    }
+  }
+  if (index_size != index_sizes.end() || buffer != buffers.end()) {
+    Error_("Mesh update has leftover buffers.");
+  }
+}
+
+void RendererValidating::ProcessRenderCommandBuffer(
+    RenderCommandBuffer* buffer, const RenderPass& pass,
+    RenderTarget* render_target) {
+  auto start_time{g_core->AppTimeMicrosecs()};
+  auto* graphics_server{g_base->graphics_server};
+  frame_stats_.command_buffers++;
+
+  if (render_target != target_) {
+    Error_("Command buffer drawn to a render-target that was not begun.");
+  }
+
+  bool malformed{};
+  auto have = [this, buffer, &malformed](size_t ints, size_t floats,
+                                         size_t textures, size_t meshes,
+                                         size_t mesh_datas) {
+    if (!buffer->HasRemaining(ints, floats, textures, meshes, mesh_datas)) {
+      Error_("Command buffer ran out of data mid-command.");
+      malformed = true;
+    }
+    return !malformed;
+  };
+
+  bool cull_flipped_at_start{cull_flipped_};
+  buffer->ReadBegin();
+  RenderCommandBuffer::Command cmd;
+  while (!malformed
+         && (cmd = buffer->GetCommand())
+                != RenderCommandBuffer::Command::kEnd) {
+    frame_stats_.commands++;
+    switch (cmd) {
+      case RenderCommandBuffer::Command::kShader: {
+        malformed = !BindShader_(buffer);
+        break;
+      }
+      case RenderCommandBuffer::Command::kSimpleComponentInlineColor:
+      case RenderCommandBuffer::Command::kObjectComponentInlineColor: {
+        if (!have(0, 4, 0, 0, 0)) {
+          break;
+        }
+        buffer->GetFloats(&color_[0], &color_[1], &color_[2], &color_[3]);
+        auto family{
+            cmd == RenderCommandBuffer::Command::kSimpleComponentInlineColor
+                ? ShaderFamily::kSimple
+                : ShaderFamily::kObject};
+        if (shader_ < 0
+            || GetShadingInfo(static_cast<ShadingType>(shader_)).family
+                   != family) {
+          Error_("Inline color for a shader that does not take one.");
+        }
+        break;
+      }
+      case RenderCommandBuffer::Command::kObjectComponentInlineAddColor: {
+        if (!have(0, 3, 0, 0, 0)) {
+          break;
+        }
+        float r, g, b;
+        buffer->GetFloats(&r, &g, &b);
+        if (shader_ < 0
+            || GetShadingInfo(static_cast<ShadingType>(shader_)).family
+                   != ShaderFamily::kObject) {
+          Error_("Inline add-color for a shader that does not take one.");
+        }
+        break;
+      }
+      case RenderCommandBuffer::Command::kDrawMeshAsset: {
+        if (!have(1, 0, 0, 1, 0)) {
+          break;
+        }
+        int flags = buffer->GetInt();
+        const MeshAsset* m = buffer->GetMesh();
+        if (!m) {
+          Error_("Null mesh in draw command.");
+          break;
+        }
+        if ((flags & kMeshDrawFlagNoReflection) && drawing_reflection()) {
+          break;
+        }
+        auto* mesh{static_cast<MeshAssetDataValidating*>(m->renderer_data())};
+        frame_stats_.draws++;
+        DrawTriangles_(mesh->positions, mesh->indices);
+        break;
+      }
+      case RenderCommandBuffer::Command::kDrawMeshAssetInstanced: {
+        if (!have(2, 0, 0, 1, 0)) {
+          break;
+        }
+        int flags = buffer->GetInt();
+        const MeshAsset* m = buffer->GetMesh();
+        int count{buffer->PeekInt()};
+        if (count < 0) {
+          Error_("Negative instance count.");
+          malformed = true;
+          break;
+        }
+        if (!have(1, static_cast<size_t>(count) * 16, 0, 0, 0)) {
+          break;
+        }
+        Matrix44f* mats = buffer->GetMatrices(&count);
+        if (!m) {
+          Error_("Null mesh in instanced draw command.");
+          break;
+        }
+        if ((flags & kMeshDrawFlagNoReflection) && drawing_reflection()) {
+          break;
+        }
+        auto* mesh{static_cast<MeshAssetDataValidating*>(m->renderer_data())};
+        for (int i = 0; i < count; i++) {
+          graphics_server->PushTransform();
+          graphics_server->MultMatrix(mats[i]);
+          frame_stats_.draws++;
+          DrawTriangles_(mesh->positions, mesh->indices);
+          graphics_server->PopTransform();
+        }
+        break;
+      }
+      case RenderCommandBuffer::Command::kBeginDebugDrawTriangles:
+      case RenderCommandBuffer::Command::kBeginDebugDrawLines:
+      case RenderCommandBuffer::Command::kEndDebugDraw:
+        break;
+      case RenderCommandBuffer::Command::kDebugDrawVertex3: {
+        if (have(0, 3, 0, 0, 0)) {
+          buffer->GetFloat();
+          buffer->GetFloat();
+          buffer->GetFloat();
+        }
+        break;
+      }
+      case RenderCommandBuffer::Command::kDrawMesh: {
+        if (!have(1, 0, 0, 0, 1)) {
+          break;
+        }
+        int flags = buffer->GetInt();
+        auto* mesh = buffer->GetMeshRendererData<MeshDataValidating>();
+        if ((flags & kMeshDrawFlagNoReflection) && drawing_reflection()) {
+          break;
+        }
+        frame_stats_.draws++;
+        DrawTriangles_(mesh->positions, mesh->indices);
+        break;
+      }
+      case RenderCommandBuffer::Command::kDrawScreenQuad: {
+        frame_stats_.draws++;
+        DrawScreenQuad_();
+        break;
+      }
+      case RenderCommandBuffer::Command::kScissorPush: {
+        if (!have(0, 4, 0, 0, 0)) {
+          break;
+        }
+        Rect r;
+        buffer->GetFloats(&r.l, &r.b, &r.r, &r.t);
+
+        // Same conversion to view space RendererGL does.
+        Vector3f bot_left_pt =
+            graphics_server->model_view_matrix() * Vector3f(r.l, r.b, 0);
+        Vector3f top_right_pt =
+            graphics_server->model_view_matrix() * Vector3f(r.r, r.t, 0);
+        r.l = bot_left_pt.x;
+        r.b = bot_left_pt.y;
+        r.r = top_right_pt.x;
+        r.t = top_right_pt.y;
+        if (!scissor_rects_.empty()) {
+          const Rect& rp{scissor_rects_.back()};
+          r.l = std::max(r.l, rp.l);
+          r.r = std::min(r.r, rp.r);
+          r.b = std::max(r.b, rp.b);
+          r.t = std::min(r.t, rp.t);
+        }
+        scissor_rects_.push_back(r);
+        frame_stats_.scissor_pushes++;
+        UpdateScissorClip_();
+        break;
+      }
+      case RenderCommandBuffer::Command::kScissorPop: {
+        if (scissor_rects_.empty()) {
+          Error_("Scissor pop with no scissor pushed.");
+          break;
+        }
+        scissor_rects_.pop_back();
+        UpdateScissorClip_();
+        break;
+      }
+      case RenderCommandBuffer::Command::kPushTransform: {
+        if (transform_depth_ >= kMaxValidatingTransformDepth) {
+          Error_("Transform stack overflow.");
+          malformed = true;
+          break;
+        }
+        graphics_server->PushTransform();
+        transform_depth_++;
+        frame_stats_.transform_ops++;
+        break;
+      }
+      case RenderCommandBuffer::Command::kPopTransform: {
+        if (transform_depth_ <= 0) {
+          Error_("Transform pop with no transform pushed.");
+          break;
+        }
+        graphics_server->PopTransform();
+        transform_depth_--;
+        frame_stats_.transform_ops++;
+        break;
+      }
+      case RenderCommandBuffer::Command::kTranslate2: {
+        if (!have(0, 2, 0, 0, 0)) {
+          break;
+        }
+        float x, y;
+        buffer->GetFloats(&x, &y);
+        graphics_server->Translate(Vector3f(x, y, 0));
+        frame_stats_.transform_ops++;
+        break;
+      }
+      case RenderCommandBuffer::Command::kTranslate3: {
+        if (!have(0, 3, 0, 0, 0)) {
+          break;
+        }
+        float x, y, z;
+        buffer->GetFloats(&x, &y, &z);
+        graphics_server->Translate(Vector3f(x, y, z));
+        frame_stats_.transform_ops++;
+        break;
+      }
+      case RenderCommandBuffer::Command::kCursorTranslate: {
+        float x, y;
+        g_base->app_adapter->CursorPositionForDraw(&x, &y);
+        graphics_server->Translate(Vector3f(x, y, 0));
+        frame_stats_.transform_ops++;
+        break;
+      }
+      case RenderCommandBuffer::Command::kScale2: {
+        if (!have(0, 2, 0, 0, 0)) {
+          break;
+        }
+        float x, y;
+        buffer->GetFloats(&x, &y);
+        graphics_server->scale(Vector3f(x, y, 1.0f));
+        frame_stats_.transform_ops++;
+        break;
+      }
+      case RenderCommandBuffer::Command::kScale3: {
+        if (!have(0, 3, 0, 0, 0)) {
+          break;
+        }
+        float x, y, z;
+        buffer->GetFloats(&x, &y, &z);
+        graphics_server->scale(Vector3f(x, y, z));
+        frame_stats_.transform_ops++;
+        break;
+      }
+      case RenderCommandBuffer::Command::kScaleUniform: {
+        if (!have(0, 1, 0, 0, 0)) {
+          break;
+        }
+        float s = buffer->GetFloat();
+        graphics_server->scale(Vector3f(s, s, s));
+        frame_stats_.transform_ops++;
+        break;
+      }
+#if BA_VR_BUILD
+      case RenderCommandBuffer::Command::kTransformToRightHand: {
+        VRTransformToRightHand();
+        frame_stats_.transform_ops++;
+        break;
+      }
+      case RenderCommandBuffer::Command::kTransformToLeftHand: {
+        VRTransformToLeftHand();
+        frame_stats_.transform_ops++;
+        break;
+      }
+      case RenderCommandBuffer::Command::kTransformToHead: {
+        VRTransformToHead();
+        frame_stats_.transform_ops++;
+        break;
+      }
+#endif  // BA_VR_BUILD
+      case RenderCommandBuffer::Command::kTranslateToProjectedPoint: {
+        if (!have(0, 3, 0, 0, 0)) {
+          break;
+        }
+        float x, y, z;
+        buffer->GetFloats(&x, &y, &z);
+        Vector3f t = pass.frame_def()->beauty_pass()->tex_project_matrix()
+                     * Vector3f(x, y, z);
+        graphics_server->Translate(
+            Vector3f(t.x * graphics_server->screen_virtual_width(),
+                     t.y * graphics_server->screen_virtual_height(), 0));
+        frame_stats_.transform_ops++;
+        break;
+      }
+      case RenderCommandBuffer::Command::kRotate: {
+        if (!have(0, 4, 0, 0, 0)) {
+          break;
+        }
+        float angle, x, y, z;
+        buffer->GetFloats(&angle, &x, &y, &z);
+        graphics_server->Rotate(angle, Vector3f(x, y, z));
+        frame_stats_.transform_ops++;
+        break;
+      }
+      case RenderCommandBuffer::Command::kMultMatrix: {
+        if (!have(0, 16, 0, 0, 0)) {
+          break;
+        }
+        graphics_server->MultMatrix(*(buffer->GetMatrix()));
+        frame_stats_.transform_ops++;
+        break;
+      }
+      case RenderCommandBuffer::Command::kFlipCullFace: {
+        FlipCullFace();
+        break;
+      }
+      default:
+        Error_("Invalid command "
+               + std::to_string(static_cast<int>(cmd))
+               + " in render-command-buffer.");
+        malformed = true;
+        break;
+    }
+  }
+
+  // Once the streams are out of step there's no point complaining about
+  // what's left in them.
+  if (!malformed && !buffer->IsEmpty()) {
+    Error_("Command buffer has unread data left over.");
+  }
+
+  // Leave things as we found them so one bad buffer doesn't cascade.
+  if (transform_depth_ != 0) {
+    Error_("Command buffer left " + std::to_string(transform_depth_)
+           + " transform(s) pushed.");
+    while (transform_depth_ > 0) {
+      graphics_server->PopTransform();
+      transform_depth_--;
+    }
+  }
+  if (!scissor_rects_.empty()) {
+    Error_("Command buffer left a scissor pushed.");
+    scissor_rects_.clear();
+    UpdateScissorClip_();
+  }
+  if (cull_flipped_ != cull_flipped_at_start) {
+    Error_("Command buffer left the cull face flipped.");
+    cull_flipped_ = cull_flipped_at_start;
+  }
+  frame_stats_.process_time += g_core->AppTimeMicrosecs() - start_time;
+}
+
+auto RendererValidating::BindShader_(RenderCommandBuffer* buffer) -> bool {
+  if (!buffer->HasRemaining(1, 0)) {
+    Error_("Command buffer ran out of data mid-command.");
+    return false;
+  }
+  int shader{buffer->GetInt()};
+  if (shader < 0 || shader >= static_cast<int>(ShadingType::kCount)) {
+    Error_("Invalid shading type " + std::to_string(shader) + ".");
+    return false;
+  }
+  auto info{GetShadingInfo(static_cast<ShadingType>(shader))};
+  auto args{
+      RenderCommandBuffer::GetShaderArgs(static_cast<ShadingType>(shader))};
+  if (!buffer->HasRemaining(args.ints, args.floats, args.textures)) {
+    Error_("Command buffer ran out of data for shading type "
+           + std::to_string(shader) + ".");
+    return false;
+  }
+  frame_stats_.shader_binds++;
+  if (shader != shader_) {
+    frame_stats_.shader_changes++;
+    shader_ = shader;
+  }
+
+  int ints[2]{};
+  for (int i = 0; i < args.ints; ++i) {
+    ints[i] = buffer->GetInt();
+  }
+  float floats[15]{};
+  for (int i = 0; i < args.floats; ++i) {
+    floats[i] = buffer->GetFloat();
+  }
+  for (int i = 0; i < args.textures; ++i) {
+    frame_stats_.texture_refs++;
+    if (!buffer->GetTexture()) {
+      Error_("Null texture for shading type " + std::to_string(shader) + ".");
+    }
+  }
+
+  if (info.light_shadow_int >= 0) {
+    auto light_shadow{
+        static_cast<LightShadowType>(ints[info.light_shadow_int])};
+    if (light_shadow != LightShadowType::kTerrain
+        && light_shadow != LightShadowType::kObject) {
+      Error_("Invalid light-shadow type for shading type "
+             + std::to_string(shader) + ".");
+    }
+  }
+  if (static_cast<ShadingType>(shader) == ShadingType::kSpecial) {
+    auto source{static_cast<SpecialComponent::Source>(ints[0])};
+    if (source != SpecialComponent::Source::kLightBuffer
+        && source != SpecialComponent::Source::kLightShadowBuffer
+        && source != SpecialComponent::Source::kVROverlayBuffer) {
+      Error_("Invalid special-component source.");
+    }
+  }
+
+  blend_ = info.blend != ShaderBlend::kOpaque;
+  premult_ = info.blend == ShaderBlend::kPremult
+             || (info.blend == ShaderBlend::kChoice && ints[0] != 0);
+  paint_ = info.paint;
+  color_[0] = color_[1] = color_[2] = color_[3] = 1.0f;
+  if (args.floats >= 3) {
+    color_[0] = floats[0];
+    color_[1] = floats[1];
+    color_[2] = floats[2];
+    if (blend_ && args.floats >= 4) {
+      color_[3] = floats[3];
+    }
+  }
+  copy_source_ = nullptr;
+  if (rasterizing_ && IsPostProcess(shader) && has_camera_render_target()) {
+    copy_source_ =
+        static_cast<RenderTargetValidating*>(camera_render_target());
+    if (copy_source_->color.empty()) {
+      copy_source_ = nullptr;
+    }
+  }
+  return true;
+}
+
+void RendererValidating::DrawTriangles_(const std::vector<float>& positions,
+                                        const std::vector<uint32_t>& indices) {
+  if (shader_ < 0) {
+    Error_("Draw with no shader bound.");
+    return;
+  }
+  frame_stats_.triangles += static_cast<int64_t>(indices.size() / 3);
+  if (!rasterizing_ || !paint_ || !target_) {
+    return;
+  }
+
+  // Take everything to window space up front.
+  const Matrix44f& mvp{
+      g_base->graphics_server->GetModelViewProjectionMatrix()};
+  auto vertex_count{positions.size() / 3};
+  auto width{static_cast<float>(target_->width())};
+  auto height{static_cast<float>(target_->height())};
+  window_coords_.resize(vertex_count * 4);
+  for (size_t v = 0; v < vertex_count; ++v) {
+    const float* p{&positions[v * 3]};
+    float clip[4];
+    for (int r = 0; r < 4; ++r) {
+      clip[r] = p[0] * mvp.m[r] + p[1] * mvp.m[4 + r] + p[2] * mvp.m[8 + r]
+                + mvp.m[12 + r];
+    }
+    float* out{&window_coords_[v * 4]};
+
+    // We don't clip against the near plane; anything touching it or
+    // behind it gets flagged and its triangles skipped.
+    if (clip[3] <= 0.00001f) {
+      out[3] = 0.0f;
+      continue;
+    }
+    float inv_w{1.0f / clip[3]};
+    out[0] = (clip[0] * inv_w * 0.5f + 0.5f) * width;
+    out[1] = (clip[1] * inv_w * 0.5f + 0.5f) * height;
+    out[2] = clip[2] * inv_w;
+    out[3] = 1.0f;
+  }
+  for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+    auto i0{indices[i]};
+    auto i1{indices[i + 1]};
+    auto i2{indices[i + 2]};
+    if (i0 >= vertex_count || i1 >= vertex_count || i2 >= vertex_count) {
+      Error_("Draw with out-of-range mesh index.");
+      return;
+    }
+    const float* p0{&window_coords_[i0 * 4]};
+    const float* p1{&window_coords_[i1 * 4]};
+    const float* p2{&window_coords_[i2 * 4]};
+    if (p0[3] == 0.0f || p1[3] == 0.0f || p2[3] == 0.0f) {
+      continue;
+    }
+    FillTriangle_(p0, p1, p2);
+  }
+}
+
+void RendererValidating::DrawScreenQuad_() {
+  if (shader_ < 0) {
+    Error_("Draw with no shader bound.");
+    return;
+  }
+  frame_stats_.triangles += 2;
+  if (!rasterizing_ || !paint_ || !target_) {
+    return;
+  }
+
+  // Screen quads sit at the back of the depth range; we skip depth
+  // testing for them and just cover whatever the scissor allows.
+  for (int y = scissor_clip_[1]; y < scissor_clip_[3]; ++y) {
+    for (int x = scissor_clip_[0]; x < scissor_clip_[2]; ++x) {
+      ShadePixel_(x, y);
+    }
+  }
+}
+
+void RendererValidating::FillTriangle_(const float* p0, const float* p1,
+                                       const float* p2) {
+  float area{(p1[0] - p0[0]) * (p2[1] - p0[1])
+             - (p2[0] - p0[0]) * (p1[1] - p0[1])};
+  if (std::abs(area) < 0.000001f) {
+    return;
+  }
+  float inv_area{1.0f / area};
+
+  // We accept either winding; culling isn't something golden images need.
+  auto min_x{std::max(
+      scissor_clip_[0],
+      static_cast<int>(std::floor(std::min({p0[0], p1[0], p2[0]}))))};
+  auto max_x{std::min(
+      scissor_clip_[2],
+      static_cast<int>(std::ceil(std::max({p0[0], p1[0], p2[0]}))))};
+  auto min_y{std::max(
+      scissor_clip_[1],
+      static_cast<int>(std::floor(std::min({p0[1], p1[1], p2[1]}))))};
+  auto max_y{std::min(
+      scissor_clip_[3],
+      static_cast<int>(std::ceil(std::max({p0[1], p1[1], p2[1]}))))};
+
+  bool has_depth{target_->has_depth()};
+  auto width{target_->width()};
+  for (int y = min_y; y < max_y; ++y) {
+    float py{static_cast<float>(y) + 0.5f};
+    for (int x = min_x; x < max_x; ++x) {
+      float px{static_cast<float>(x) + 0.5f};
+      float w0{((p1[0] - px) * (p2[1] - py) - (p2[0] - px) * (p1[1] - py))
+               * inv_area};
+      float w1{((p2[0] - px) * (p0[1] - py) - (p0[0] - px) * (p2[1] - py))
+               * inv_area};
+      float w2{1.0f - w0 - w1};
+      if (w0 < 0.0f || w1 < 0.0f || w2 < 0.0f) {
+        continue;
+      }
+      float z{w0 * p0[2] + w1 * p1[2] + w2 * p2[2]};
+      if (z < -1.0f || z > 1.0f) {
+        continue;
+      }
+      if (has_depth) {
+        float depth{depth_min_ + (z * 0.5f + 0.5f) * (depth_max_ - depth_min_)};
+        float& stored{target_->depth[y * width + x]};
+        if (depth_testing_
+            && (draw_at_equal_depth_ ? depth > stored : depth >= stored)) {
+          continue;
+        }
+        if (depth_writing_) {
+          stored = depth;
+        }
+      }
+      ShadePixel_(x, y);
+    }
+  }
+}
+
+void RendererValidating::ShadePixel_(int x, int y) {
+  float* dst{&target_->color[(static_cast<size_t>(y) * target_->width() + x)
+                             * 3]};
+  float src[3]{color_[0], color_[1], color_[2]};
+  if (copy_source_) {
+    // Post-process; pull from the camera buffer.
+    auto sx{x * copy_source_->width() / target_->width()};
+    auto sy{y * copy_source_->height() / target_->height()};
+    const float* c{&copy_source_->color[(static_cast<size_t>(sy)
+                                             * copy_source_->width()
+                                         + sx)
+                                        * 3]};
+    src[0] = c[0];
+    src[1] = c[1];
+    src[2] = c[2];
+  }
+  if (!blend_) {
+    dst[0] = src[0];
+    dst[1] = src[1];
+    dst[2] = src[2];
+    return;
+  }
+  float a{color_[3]};
+  float src_scale{premult_ ? 1.0f : a};
+  for (int i = 0; i < 3; ++i) {
+    dst[i] = src[i] * src_scale + dst[i] * (1.0f - a);
+  }
+}
+
+void RendererValidating::OnDrawBegin_(RenderTargetValidating* target,
+                                      bool clear, float r, float g, float b) {
+  assert(g_base->app_adapter->InGraphicsContext());
+  if (target != target_) {
+    frame_stats_.state_changes++;
+    target_ = target;
+  }
+  if (rasterizing_) {
+    target->Allocate();
+    if (clear) {
+      for (size_t i = 0; i < target->color.size(); i += 3) {
+        target->color[i] = r;
+        target->color[i + 1] = g;
+        target->color[i + 2] = b;
+      }
+    }
+    std::fill(target->depth.begin(), target->depth.end(), 1.0f);
+  }
+  UpdateScissorClip_();
+}
+
+void RendererValidating::UpdateScissorClip_() {
+  if (!target_) {
+    return;
+  }
+  auto width{rasterizing_ ? target_->width() : 0};
+  auto height{rasterizing_ ? target_->height() : 0};
+  scissor_clip_[0] = 0;
+  scissor_clip_[1] = 0;
+  scissor_clip_[2] = width;
+  scissor_clip_[3] = height;
+  if (scissor_rects_.empty()) {
+    return;
+  }
+  Rect clip = scissor_rects_.back();
+  if (clip.l > clip.r) {
+    clip.l = clip.r;
+  }
+  if (clip.b > clip.t) {
+    clip.b = clip.t;
+  }
+  auto x{static_cast<int>(target_->GetScissorX(clip.l))};
+  auto y{static_cast<int>(target_->GetScissorY(clip.b))};
+  auto w{static_cast<int>(target_->GetScissorScaleX() * (clip.r - clip.l))};
+  auto h{static_cast<int>(target_->GetScissorScaleY() * (clip.t - clip.b))};
+  scissor_clip_[0] = std::clamp(x, 0, width);
+  scissor_clip_[1] = std::clamp(y, 0, height);
+  scissor_clip_[2] = std::clamp(x + w, 0, width);
+  scissor_clip_[3] = std::clamp(y + h, 0, height);
+}
+
+void RendererValidating::BlitBuffer(RenderTarget* src_in, RenderTarget* dst_in,
+                                    bool depth, bool linear_interpolation,
+                                    bool force_shader_blit,
+                                    bool invalidate_source) {
+  auto* src{static_cast<RenderTargetValidating*>(src_in)};
+  assert(src && src == dynamic_cast<RenderTargetValidating*>(src_in));
+  auto* dst{static_cast<RenderTargetValidating*>(dst_in)};
+  assert(dst && dst == dynamic_cast<RenderTargetValidating*>(dst_in));
+  if (depth && (!src->has_depth() || !dst->has_depth())) {
+    Error_("Depth blit between render-targets lacking depth.");
+    depth = false;
+  }
+  frame_stats_.draws++;
+
+  // Blits leave the destination bound (as they do in RendererGL).
+  if (dst != target_) {
+    frame_stats_.state_changes++;
+    target_ = dst;
+  }
+  if (rasterizing_) {
+    dst->Allocate();
+    for (int y = 0; y < dst->height(); ++y) {
+      auto sy{y * src->height() / dst->height()};
+      for (int x = 0; x < dst->width(); ++x) {
+        auto sx{x * src->width() / dst->width()};
+        auto si{static_cast<size_t>(sy) * src->width() + sx};
+        auto di{static_cast<size_t>(y) * dst->width() + x};
+        dst->color[di * 3] = src->color[si * 3];
+        dst->color[di * 3 + 1] = src->color[si * 3 + 1];
+        dst->color[di * 3 + 2] = src->color[si * 3 + 2];
+        if (depth) {
+          dst->depth[di] = src->depth[si];
+        }
+      }
+    }
+  }
+  UpdateScissorClip_();
+}
+
+void RendererValidating::SetDepthRange(float min, float max) {
+  if (min < 0.0f || max > 1.0f || min > max) {
+    Error_("Invalid depth range.");
+  }
+  depth_min_ = min;
+  depth_max_ = max;
+}
+
+void RendererValidating::FlipCullFace() {
+  cull_flipped_ = !cull_flipped_;
+  frame_stats_.state_changes++;
+}
+
+void RendererValidating::SetDepthWriting(bool enable) {
+  if (enable != depth_writing_) {
+    depth_writing_ = enable;
+    frame_stats_.state_changes++;
+  }
+}
+
+void RendererValidating::SetDepthTesting(bool enable) {
+  if (enable != depth_testing_) {
+    depth_testing_ = enable;
+    frame_stats_.state_changes++;
+  }
+}
+
+void RendererValidating::SetDrawAtEqualDepth(bool enable) {
+  if (enable != draw_at_equal_depth_) {
+    draw_at_equal_depth_ = enable;
+    frame_stats_.state_changes++;
+  }
+}
+
+void RendererValidating::Error_(const std::string& message) {
+  frame_stats_.errors++;
+  frame_error_ = message;
+  if (logged_error_count_ < kMaxValidatingErrorLogs) {
+    logged_error_count_++;
+    g_core->logging->Log(LogName::kBaGraphics, LogLevel::kError,
+                         "RendererValidating: " + message);
+  }
+}
+
+void RendererValidating::RenderFrameDefEnd() {
+  assert(g_base->app_adapter->InGraphicsContext());
+  frame_stats_.frames = 1;
+  std::string capture_path;
+  {
+    std::scoped_lock lock(mutex_);
+    auto& t{total_stats_};
+    auto& f{frame_stats_};
+    t.frames += f.frames;
+    t.command_buffers += f.command_buffers;
+    t.commands += f.commands;
+    t.shader_binds += f.shader_binds;
+    t.shader_changes += f.shader_changes;
+    t.texture_refs += f.texture_refs;
+    t.draws += f.draws;
+    t.triangles += f.triangles;
+    t.transform_ops += f.transform_ops;
+    t.scissor_pushes += f.scissor_pushes;
+    t.state_changes += f.state_changes;
+    t.mesh_updates += f.mesh_updates;
+    t.errors += f.errors;
+    t.process_time += f.process_time;
+    last_frame_stats_ = f;
+    if (!frame_error_.empty()) {
+      last_error_ = frame_error_;
+    }
+
+    // A capture only happens for a frame we rasterized start to finish;
+    // requests coming in mid-frame kick in next time around.
+    if (rasterizing_ && !capture_path_.empty()) {
+      capture_path.swap(capture_path_);
+    }
+    rasterizing_ = !capture_path_.empty();
+  }
+  frame_stats_ = {};
+  frame_error_.clear();
+  if (!capture_path.empty()) {
+    WriteCapture_(
+        *static_cast<RenderTargetValidating*>(screen_render_target()),
+        capture_path);
+  }
+}
+
+void RendererValidating::ProcessTestFrame(RenderCommandBuffer* buffer,
+                                          const RenderPass& pass, int width,
+                                          int height,
+                                          const std::string& capture_path,
+                                          Stats* stats, std::string* error) {
+  assert(g_base->app_adapter->InGraphicsContext());
+  auto target{NewFramebufferRenderTarget(width, height, false, true, false,
+                                         false, false, false, false)};
+  frame_stats_ = {};
+  frame_error_.clear();
+  rasterizing_ = !capture_path.empty();
+  target->DrawBegin(true, 0.0f, 0.0f, 0.0f, 1.0f);
+  ProcessRenderCommandBuffer(buffer, pass, target.get());
+  frame_stats_.frames = 1;
+  *stats = frame_stats_;
+  *error = frame_error_;
+  if (rasterizing_) {
+    WriteCapture_(*static_cast<RenderTargetValidating*>(target.get()),
+                  capture_path);
+  }
+  frame_stats_ = {};
+  frame_error_.clear();
+  rasterizing_ = false;
+  target_ = nullptr;
+}
+
+void RendererValidating::WriteCapture_(const RenderTargetValidating& target,
+                                       const std::string& path) {
+  FILE* f = g_core->platform->FOpen(path.c_str(), "wb");
+  if (!f) {
+    g_core->logging->Log(LogName::kBaGraphics, LogLevel::kError,
+                         "RendererValidating: unable to write capture to '"
+                             + path + "'.");
+    return;
+  }
+  auto width{target.width()};
+  auto height{target.height()};
+  if (target.color.size() != static_cast<size_t>(width) * height * 3) {
+    g_core->logging->Log(LogName::kBaGraphics, LogLevel::kError,
+                         "RendererValidating: nothing drawn to capture.");
+    fclose(f);
+    return;
+  }
+  fprintf(f, "P6\n%d %d\n255\n", width, height);
+
+  // Image rows run top to bottom; ours are the other way around.
+  std::vector<uint8_t> row(static_cast<size_t>(width) * 3);
+  for (int y = height - 1; y >= 0; --y) {
+    const float* src{&target.color[static_cast<size_t>(y) * width * 3]};
+    for (size_t i = 0; i < row.size(); ++i) {
+      row[i] = static_cast<uint8_t>(
+          std::round(std::clamp(src[i], 0.0f, 1.0f) * 255.0f));
+    }
+    fwrite(row.data(), 1, row.size(), f);
+  }
+  fclose(f);
+}
+
+void RendererValidating::GetStats(Stats* total, Stats* last_frame,
+                                  std::string* last_error) {
+  std::scoped_lock lock(mutex_);
+  *total = total_stats_;
+  *last_frame = last_frame_stats_;
+  *last_error = last_error_;
+}
+
+void RendererValidating::ResetStats() {
+  std::scoped_lock lock(mutex_);
+  total_stats_ = {};
+  last_frame_stats_ = {};
+  last_error_.clear();
+}
+
+void RendererValidating::RequestCapture(const std::string& path) {
+  std::scoped_lock lock(mutex_);
+  capture_path_ = path;
+}
+
+}  // namespace ballistica::base
@@ -0,0 +1,188 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_BASE_GRAPHICS_RENDERER_RENDERER_VALIDATING_H_
+#define BALLISTICA_BASE_GRAPHICS_RENDERER_RENDERER_VALIDATING_H_
+
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "ballistica/base/graphics/renderer/renderer.h"
+#include "ballistica/shared/math/rect.h"
+
+namespace ballistica::base {
+
+/// A renderer that needs no GPU.
+///
+/// It decodes every render-command-buffer it is handed exactly as a real
+/// renderer would, flags anything malformed or unbalanced, and counts
+/// commands, draws, and state changes. When asked to, it also rasterizes a
+/// frame on the CPU into its own offscreen buffers and writes the result
+/// out as an image. Shading for that is flat (each draw gets the base
+/// color of its shader; no texturing, lighting, or post-processing) which
+/// keeps captures cheap and stable enough to compare against golden
+/// images. Meant for exercising the full graphics pipeline on build
+/// machines.
+class RendererValidating : public Renderer {
+ public:
+  class RenderTargetValidating;
+  class MeshAssetDataValidating;
+  class TextureDataValidating;
+  class MeshDataValidating;
+
+  struct Stats {
+    int64_t frames{};
+    int64_t command_buffers{};
+    int64_t commands{};
+    int64_t shader_binds{};
+    /// Shader binds that switched to a different shading type.
+    int64_t shader_changes{};
+    int64_t texture_refs{};
+    /// Draw calls of all kinds; instanced draws count once per instance.
+    int64_t draws{};
+    int64_t triangles{};
+    int64_t transform_ops{};
+    int64_t scissor_pushes{};
+    /// Depth, cull, and render-target changes.
+    int64_t state_changes{};
+    int64_t mesh_updates{};
+    int64_t errors{};
+    /// Time spent processing command buffers.
+    microsecs_t process_time{};
+  };
+
+  RendererValidating();
+  ~RendererValidating() override;
+
+  /// Run `call` on the validating renderer in use, if there is one, and
+  /// return whether there was. The renderer itself belongs to the graphics
+  /// context, so this is how other threads should get at it; it is kept
+  /// alive until `call` returns.
+  static auto WithActive(const std::function<void(RendererValidating*)>& call)
+      -> bool;
+
+  /// Fetch stats totalled since the last reset along with those of the
+  /// most recent frame and the most recent error message. Safe to call
+  /// from any thread.
+  void GetStats(Stats* total, Stats* last_frame, std::string* last_error);
+  void ResetStats();
+
+  /// Rasterize the next complete frame and write it to `path` as a binary
+  /// PPM image. Safe to call from any thread.
+  void RequestCapture(const std::string& path);
+
+  /// Run `buffer` through as a complete frame drawn to a fresh offscreen
+  /// target of the given size, filling in that frame's stats and most
+  /// recent error. When `capture_path` is not empty the frame is
+  /// rasterized and written there. Lets tests exercise the renderer with
+  /// no app driving it. Does not count towards GetStats() totals; must be
+  /// called in the graphics context.
+  void ProcessTestFrame(RenderCommandBuffer* buffer, const RenderPass& pass,
+                        int width, int height,
+                        const std::string& capture_path, Stats* stats,
+                        std::string* error);
+
+  auto GetAutoGraphicsQuality() -> GraphicsQuality override;
+  auto GetAutoTextureQuality() -> TextureQuality override;
+  auto NewMeshAssetData(const MeshAsset& mesh)
+      -> Object::Ref<MeshAssetRendererData> override;
+  auto NewTextureData(const TextureAsset& texture)
+      -> Object::Ref<TextureAssetRendererData> override;
+  auto NewMeshData(MeshDataType type, MeshDrawType draw_type)
+      -> MeshRendererData* override;
+  void DeleteMeshData(MeshRendererData* data, MeshDataType type) override;
+  void ProcessRenderCommandBuffer(RenderCommandBuffer* buffer,
+                                  const RenderPass& pass,
+                                  RenderTarget* render_target) override;
+  void SetDepthRange(float min, float max) override;
+  void FlipCullFace() override;
+
+ protected:
+  void DrawDebug() override {}
+  void CheckForErrors() override {}
+  void UpdateVignetteTex_(bool force) override {}
+  void GenerateCameraBufferBlurPasses() override {}
+  void UpdateMeshes(
+      const std::vector<Object::Ref<MeshDataClientHandle>>& meshes,
+      const std::vector<int8_t>& index_sizes,
+      const std::vector<Object::Ref<MeshBufferBase>>& buffers) override;
+  void SetDepthWriting(bool enable) override;
+  void SetDepthTesting(bool enable) override;
+  void SetDrawAtEqualDepth(bool enable) override;
+  void InvalidateFramebuffer(bool color, bool depth,
+                             bool target_read_framebuffer) override {}
+  auto NewScreenRenderTarget() -> RenderTarget* override;
+  auto NewFramebufferRenderTarget(int width, int height, bool linear_interp,
+                                  bool depth, bool texture,
+                                  bool depth_texture, bool high_quality,
+                                  bool msaa, bool alpha)
+      -> Object::Ref<RenderTarget> override;
+  void PushGroupMarker(const char* label) override {}
+  void PopGroupMarker() override {}
+  void BlitBuffer(RenderTarget* src, RenderTarget* dst, bool depth,
+                  bool linear_interpolation, bool force_shader_blit,
+                  bool invalidate_source) override;
+  auto IsMSAAEnabled() const -> bool override { return false; }
+  void UpdateMSAAEnabled_() override {}
+  void VREyeRenderBegin() override {}
+  void RenderFrameDefEnd() override;
+  void CardboardDisableScissor() override {}
+  void CardboardEnableScissor() override {}
+#if BA_VR_BUILD
+  void VRSyncRenderStates() override {}
+#endif
+
+ private:
+  void OnDrawBegin_(RenderTargetValidating* target, bool clear, float r,
+                    float g, float b);
+  void Error_(const std::string& message);
+  auto BindShader_(RenderCommandBuffer* buffer) -> bool;
+  void DrawTriangles_(const std::vector<float>& positions,
+                      const std::vector<uint32_t>& indices);
+  void DrawScreenQuad_();
+  void FillTriangle_(const float* p0, const float* p1, const float* p2);
+  void ShadePixel_(int x, int y);
+  void UpdateScissorClip_();
+  void WriteCapture_(const RenderTargetValidating& target,
+                     const std::string& path);
+
+  // Per-frame state; graphics context only.
+  Stats frame_stats_;
+  std::string frame_error_;
+  int logged_error_count_{};
+  bool rasterizing_{};
+  RenderTargetValidating* target_{};
+  RenderTargetValidating* copy_source_{};
+  std::vector<float> window_coords_;
+  std::vector<Rect> scissor_rects_;
+  int scissor_clip_[4]{};
+  int transform_depth_{};
+  int shader_{-1};
+  float color_[4]{1.0f, 1.0f, 1.0f, 1.0f};
+  bool blend_{};
+  bool premult_{};
+  bool paint_{};
+  bool depth_writing_{};
+  bool depth_testing_{};
+  bool draw_at_equal_depth_{};
+  bool cull_flipped_{};
+  float depth_min_{0.0f};
+  float depth_max_{1.0f};
+
+  // Guards the validating renderer in use against being torn down by
+  // the graphics context while others are talking to it.
+  static std::mutex active_mutex_;
+  static RendererValidating* active_;
+
+  // Shared with other threads.
+  std::mutex mutex_;
+  Stats total_stats_;
+  Stats last_frame_stats_;
+  std::string last_error_;
+  std::string capture_path_;
+};
+
+}  // namespace ballistica::base
+
+#endif  // BALLISTICA_BASE_GRAPHICS_RENDERER_RENDERER_VALIDATING_H_
@@ -66,6 +66,7 @@ void FrameDef::Reset() {
   display_time_microsecs_ = 0;
   display_time_elapsed_microsecs_ = 0;
   frame_number_ = 0;
+  input_event_time_ = -1;
 
 #if BA_DEBUG_BUILD
   defining_component_ = false;
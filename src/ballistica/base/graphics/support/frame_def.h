@@ -159,6 +159,11 @@ class FrameDef {
     display_time_microsecs_ = val;
   }
   void set_frame_number(int64_t val) { frame_number_ = val; }
+
+  /// When the oldest input event first reflected in this frame came in
+  /// (app-time microseconds), or -1 if there is none.
+  auto input_event_time() const -> microsecs_t { return input_event_time_; }
+  void set_input_event_time(microsecs_t val) { input_event_time_ = val; }
   void set_frame_number_filtered(int64_t val) { frame_number_filtered_ = val; }
 
   auto overlay_flat_pass() const -> RenderPass* {
@@ -270,6 +275,7 @@ class FrameDef {
   microsecs_t display_time_microsecs_{};
   microsecs_t display_time_elapsed_microsecs_{};
   microsecs_t display_time_elapsed_millisecs_{};
+  microsecs_t input_event_time_{-1};
   int64_t frame_number_{};
   int64_t frame_number_filtered_{};
   Vector3f shadow_offset_{0.0f, 0.0f, 0.0f};
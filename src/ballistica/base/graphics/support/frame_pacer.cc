@@ -0,0 +1,143 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/base/graphics/support/frame_pacer.h"
+
+#include <algorithm>
+
+namespace ballistica::base {
+
+// Present intervals outside of this range (500hz to 10hz) are ignored.
+const microsecs_t kFramePacerMinVSyncInterval{2000};
+const microsecs_t kFramePacerMaxVSyncInterval{100000};
+
+// How many steady present intervals we need to see before trusting our
+// measured refresh rate.
+const int kFramePacerMinIntervalSamples{8};
+
+// Minimum slack we leave between a frame-def finishing building and the
+// graphics thread wanting it.
+const microsecs_t kFramePacerMinMargin{1000};
+
+void FramePacer::SetVSyncLocked(bool locked) {
+  std::scoped_lock lock(mutex_);
+  vsync_locked_ = locked;
+}
+
+void FramePacer::SetSyntheticVSync(microsecs_t interval, microsecs_t origin) {
+  std::scoped_lock lock(mutex_);
+  if (interval > 0) {
+    synthetic_ = true;
+    vsync_interval_ = interval;
+    vsync_origin_ = origin;
+  } else {
+    // Start measuring real presents from scratch.
+    synthetic_ = false;
+    vsync_interval_ = 0;
+    vsync_origin_ = -1;
+  }
+  interval_samples_ = 0;
+}
+
+void FramePacer::OnFramePresented(microsecs_t time) {
+  std::scoped_lock lock(mutex_);
+  if (synthetic_) {
+    return;
+  }
+  if (vsync_origin_ >= 0) {
+    auto delta{time - vsync_origin_};
+    if (delta >= kFramePacerMinVSyncInterval
+        && delta <= kFramePacerMaxVSyncInterval) {
+      if (vsync_interval_ == 0) {
+        vsync_interval_ = delta;
+      } else if (delta < vsync_interval_ * 3 / 2) {
+        // Skip anything that looks like a missed vsync; we only want to
+        // track the actual refresh interval.
+        vsync_interval_ += (delta - vsync_interval_) / 16;
+        interval_samples_++;
+      }
+    }
+  }
+  // Presents return just after a vsync, so each one re-anchors our clock.
+  vsync_origin_ = time;
+}
+
+void FramePacer::OnFrameBuilt(microsecs_t duration) {
+  std::scoped_lock lock(mutex_);
+  UpdateEstimate_(&build_estimate_, duration);
+}
+
+void FramePacer::OnFrameRendered(microsecs_t duration) {
+  std::scoped_lock lock(mutex_);
+  UpdateEstimate_(&render_estimate_, duration);
+}
+
+void FramePacer::UpdateEstimate_(microsecs_t* estimate, microsecs_t sample) {
+  // Jump up to slow frames immediately but only ease back down, so a
+  // single fast frame doesn't leave us cutting things close.
+  sample = std::max(microsecs_t{0}, sample);
+  if (sample >= *estimate) {
+    *estimate = sample;
+  } else {
+    *estimate -= std::max(microsecs_t{1}, (*estimate - sample) / 16);
+  }
+}
+
+auto FramePacer::Pacing() const -> bool {
+  std::scoped_lock lock(mutex_);
+  return Pacing_();
+}
+
+auto FramePacer::Pacing_() const -> bool {
+  if (vsync_interval_ <= 0 || vsync_origin_ < 0) {
+    return false;
+  }
+  return synthetic_
+         || (vsync_locked_
+             && interval_samples_ >= kFramePacerMinIntervalSamples);
+}
+
+auto FramePacer::NextVSyncTime(microsecs_t time) const -> microsecs_t {
+  std::scoped_lock lock(mutex_);
+  return NextVSyncTime_(time);
+}
+
+auto FramePacer::NextVSyncTime_(microsecs_t time) const -> microsecs_t {
+  if (vsync_interval_ <= 0) {
+    return time;
+  }
+  auto offset{time - vsync_origin_};
+  auto ticks{offset >= 0 ? (offset + vsync_interval_ - 1) / vsync_interval_
+                         : -(-offset / vsync_interval_)};
+  return vsync_origin_ + ticks * vsync_interval_;
+}
+
+auto FramePacer::BuildStartTime(microsecs_t now) const -> microsecs_t {
+  std::scoped_lock lock(mutex_);
+  if (!Pacing_()) {
+    return now;
+  }
+
+  // The graphics thread will want this frame-def once it has presented
+  // the one it is starting to render now.
+  auto needed_time{NextVSyncTime_(now + render_estimate_)};
+  auto margin{std::max(kFramePacerMinMargin, vsync_interval_ / 8)};
+  auto start_time{needed_time - build_estimate_ - margin};
+  return std::clamp(start_time, now, now + vsync_interval_);
+}
+
+auto FramePacer::vsync_interval() const -> microsecs_t {
+  std::scoped_lock lock(mutex_);
+  return vsync_interval_;
+}
+
+auto FramePacer::build_estimate() const -> microsecs_t {
+  std::scoped_lock lock(mutex_);
+  return build_estimate_;
+}
+
+auto FramePacer::render_estimate() const -> microsecs_t {
+  std::scoped_lock lock(mutex_);
+  return render_estimate_;
+}
+
+}  // namespace ballistica::base
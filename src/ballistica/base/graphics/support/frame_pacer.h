@@ -0,0 +1,81 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_BASE_GRAPHICS_SUPPORT_FRAME_PACER_H_
+#define BALLISTICA_BASE_GRAPHICS_SUPPORT_FRAME_PACER_H_
+
+#include <mutex>
+
+#include "ballistica/base/base.h"
+
+namespace ballistica::base {
+
+/// Decides when the logic thread should start building each frame-def.
+///
+/// Without pacing, the graphics server asks for the next frame as soon as
+/// it picks up the current one, so on a vsynced display frames are
+/// usually built most of a refresh interval before they are needed and
+/// any input they sample is that much older by the time it shows up.
+/// With pacing we instead aim to have each frame finish building just
+/// before the graphics thread will want it (roughly when the frame
+/// currently rendering gets presented), using measured build and render
+/// durations plus a safety margin.
+///
+/// Present timing comes either from real presents reported by the app
+/// adapter or from a synthetic vsync clock (used for testing and in
+/// headless builds where nothing is ever presented). Pacing only kicks in
+/// once present timing is known to be vsync-locked; otherwise delaying
+/// builds would just slow us down. All times are app-time microseconds.
+/// Safe to use from any thread.
+class FramePacer {
+ public:
+  /// Whether real presents are locked to vsync. Should be set by the app
+  /// adapter; pacing against real presents is disabled when false.
+  void SetVSyncLocked(bool locked);
+
+  /// Switch to a synthetic vsync clock ticking at the given interval with
+  /// a tick at `origin`. An interval of 0 switches back to real presents.
+  void SetSyntheticVSync(microsecs_t interval, microsecs_t origin);
+
+  /// Should be called when a frame has been presented.
+  void OnFramePresented(microsecs_t time);
+
+  /// Should be called with how long building a frame-def took.
+  void OnFrameBuilt(microsecs_t duration);
+
+  /// Should be called with how long rendering a frame-def took (not
+  /// including waiting to present).
+  void OnFrameRendered(microsecs_t duration);
+
+  /// Whether we've got enough info to pace.
+  auto Pacing() const -> bool;
+
+  /// When the frame-def we should request at `now` should start building.
+  /// Returns `now` (build immediately) when not pacing.
+  auto BuildStartTime(microsecs_t now) const -> microsecs_t;
+
+  /// The first predicted vsync at or after a time. Only meaningful when
+  /// pacing.
+  auto NextVSyncTime(microsecs_t time) const -> microsecs_t;
+
+  auto vsync_interval() const -> microsecs_t;
+  auto build_estimate() const -> microsecs_t;
+  auto render_estimate() const -> microsecs_t;
+
+ private:
+  auto Pacing_() const -> bool;
+  auto NextVSyncTime_(microsecs_t time) const -> microsecs_t;
+  static void UpdateEstimate_(microsecs_t* estimate, microsecs_t sample);
+
+  mutable std::mutex mutex_;
+  bool vsync_locked_{};
+  bool synthetic_{};
+  int interval_samples_{};
+  microsecs_t vsync_interval_{};
+  microsecs_t vsync_origin_{-1};
+  microsecs_t build_estimate_{};
+  microsecs_t render_estimate_{};
+};
+
+}  // namespace ballistica::base
+
+#endif  // BALLISTICA_BASE_GRAPHICS_SUPPORT_FRAME_PACER_H_
@@ -3,6 +3,7 @@
 #ifndef BALLISTICA_BASE_GRAPHICS_SUPPORT_RENDER_COMMAND_BUFFER_H_
 #define BALLISTICA_BASE_GRAPHICS_SUPPORT_RENDER_COMMAND_BUFFER_H_
 
+#include <string>
 #include <vector>
 
 #include "ballistica/base/assets/texture_asset.h"
@@ -51,6 +52,99 @@ class RenderCommandBuffer {
     kDebugDrawVertex3
   };
 
+  /// Counts of ints, floats, and textures.
+  struct ValueCounts {
+    int ints{};
+    int floats{};
+    int textures{};
+  };
+
+  /// What a kShader command carries after its ShadingType int. Shader
+  /// binds aren't self-describing, so whatever writes them and every
+  /// renderer reading them must agree with this.
+  static auto GetShaderArgs(ShadingType type) -> ValueCounts {
+    switch (type) {
+      case ShadingType::kSimpleColor:
+        return {0, 3, 0};
+      case ShadingType::kSimpleColorTransparent:
+      case ShadingType::kSimpleColorTransparentDoubleSided:
+        return {1, 4, 0};
+      case ShadingType::kSimpleTexture:
+        return {0, 0, 1};
+      case ShadingType::kSimpleTextureModulated:
+        return {0, 3, 1};
+      case ShadingType::kSimpleTextureModulatedColorized:
+        return {0, 6, 2};
+      case ShadingType::kSimpleTextureModulatedColorized2:
+        return {0, 9, 2};
+      case ShadingType::kSimpleTextureModulatedColorized2Masked:
+        return {0, 10, 3};
+      case ShadingType::kSimpleTextureModulatedTransparent:
+      case ShadingType::kSimpleTextureModulatedTransparentDoubleSided:
+        return {1, 4, 1};
+      case ShadingType::kSimpleTextureModulatedTransFlatness:
+        return {1, 5, 1};
+      case ShadingType::kSimpleTextureModulatedTransparentColorized:
+        return {1, 7, 2};
+      case ShadingType::kSimpleTextureModulatedTransparentColorized2:
+        return {1, 10, 2};
+      case ShadingType::kSimpleTextureModulatedTransparentColorized2Masked:
+        return {1, 10, 3};
+      case ShadingType::kSimpleTextureModulatedTransparentShadow:
+        return {1, 8, 2};
+      case ShadingType::kSimpleTexModulatedTransShadowFlatness:
+        return {1, 9, 2};
+      case ShadingType::kSimpleTextureModulatedTransparentGlow:
+        return {1, 6, 1};
+      case ShadingType::kSimpleTextureModulatedTransparentGlowMaskUV2:
+        return {1, 6, 2};
+      case ShadingType::kObject:
+        return {0, 3, 1};
+      case ShadingType::kObjectTransparent:
+        return {1, 4, 1};
+      case ShadingType::kObjectLightShadowTransparent:
+        return {2, 4, 1};
+      case ShadingType::kSpecial:
+        return {1, 0, 0};
+      case ShadingType::kShield:
+        return {0, 0, 0};
+      case ShadingType::kObjectReflect:
+        return {1, 6, 2};
+      case ShadingType::kObjectReflectTransparent:
+        return {1, 7, 2};
+      case ShadingType::kObjectReflectAddTransparent:
+        return {1, 10, 2};
+      case ShadingType::kObjectLightShadow:
+        return {2, 3, 1};
+      case ShadingType::kObjectReflectLightShadow:
+      case ShadingType::kObjectReflectLightShadowDoubleSided:
+        return {2, 6, 2};
+      case ShadingType::kObjectReflectLightShadowColorized:
+        return {1, 9, 3};
+      case ShadingType::kObjectReflectLightShadowColorized2:
+        return {1, 12, 3};
+      case ShadingType::kObjectReflectLightShadowAdd:
+        return {1, 9, 2};
+      case ShadingType::kObjectReflectLightShadowAddColorized:
+        return {1, 12, 3};
+      case ShadingType::kObjectReflectLightShadowAddColorized2:
+        return {1, 15, 3};
+      case ShadingType::kSmoke:
+      case ShadingType::kSmokeOverlay:
+        return {0, 4, 1};
+      case ShadingType::kPostProcess:
+      case ShadingType::kPostProcessEyes:
+        return {0, 0, 0};
+      case ShadingType::kPostProcessNormalDistort:
+        return {0, 1, 0};
+      case ShadingType::kSprite:
+        return {2, 4, 1};
+      default:
+        throw Exception("Unhandled shading type "
+                        + std::to_string(static_cast<int>(type)) + ".");
+    }
+  }
+
   RenderCommandBuffer() = default;
   void PutCommand(Command c) {
     assert(!finalized_);
@@ -536,6 +630,30 @@ class RenderCommandBuffer {
     return false;
   }
 
+  // Whether at least this many of each value type remain to be read. Lets
+  // validating readers catch malformed buffers without tripping asserts.
+  auto HasRemaining(size_t ints, size_t floats, size_t textures = 0,
+                    size_t meshes = 0, size_t mesh_datas = 0) const -> bool {
+    return ivals_index_ + ints <= ivals_.size()
+           && fvals_index_ + floats <= fvals_.size()
+           && textures_index_ + textures <= textures_.size()
+           && meshes_index_ + meshes <= meshes_.size()
+           && mesh_datas_index_ + mesh_datas <= mesh_datas_.size();
+  }
+
+  // How many ints, floats, and textures have been read so far.
+  auto values_read() const -> ValueCounts {
+    return {static_cast<int>(ivals_index_), static_cast<int>(fvals_index_),
+            static_cast<int>(textures_index_)};
+  }
+
+  // Return the next int without consuming it.
+  auto PeekInt() const -> int {
+    assert(finalized_);
+    assert(ivals_index_ < ivals_.size());
+    return ivals_[ivals_index_];
+  }
+
   // Sanity check: Makes sure all buffer iterators are at their end.
   auto IsEmpty() -> bool {
     return (
@@ -0,0 +1,93 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/base/graphics/texture/texture_stream_plan.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "ballistica/base/assets/texture_asset_preload_data.h"
+
+namespace ballistica::base {
+
+static auto IsUncompressedFormat_(TextureFormat format) -> bool {
+  switch (format) {
+    case TextureFormat::kRGBA_8888:
+    case TextureFormat::kRGB_888:
+    case TextureFormat::kRGBA_4444:
+    case TextureFormat::kRGB_565:
+      return true;
+    default:
+      return false;
+  }
+}
+
+TextureStreamPlan::TextureStreamPlan(
+    const std::vector<TextureAssetPreloadData>& preload_datas) {
+  if (preload_datas.empty()) {
+    return;
+  }
+  const TextureAssetPreloadData& first{preload_datas[0]};
+  int base_level = first.base_level;
+
+  // Gather the explicit chain starting at our base level. An uncompressed
+  // level means the gpu generates everything below it, so in that case
+  // we leave the plan empty and everything goes up in one shot.
+  for (int src_level = base_level;
+       src_level < kMaxTextureLevels && first.buffers[src_level] != nullptr;
+       ++src_level) {
+    if (IsUncompressedFormat_(first.formats[src_level])) {
+      levels_.clear();
+      return;
+    }
+    Level level{first.widths[src_level], first.heights[src_level], 0};
+    for (auto&& preload_data : preload_datas) {
+      if (preload_data.base_level != base_level
+          || preload_data.buffers[src_level] == nullptr) {
+        levels_.clear();
+        return;
+      }
+      level.size += preload_data.sizes[src_level];
+    }
+    levels_.push_back(level);
+  }
+  CalcInitialLevel_();
+}
+
+TextureStreamPlan::TextureStreamPlan(std::vector<Level> levels)
+    : levels_(std::move(levels)) {
+  CalcInitialLevel_();
+}
+
+void TextureStreamPlan::CalcInitialLevel_() {
+  initial_level_ = 0;
+  for (int i = 0; i < level_count(); ++i) {
+    initial_level_ = i;
+    if (std::max(levels_[i].width, levels_[i].height)
+        <= kTextureStreamTailSize) {
+      break;
+    }
+  }
+  resident_level_ = initial_level_;
+}
+
+auto TextureStreamPlan::PopLevel(size_t* budget, bool oversized_ok) -> int {
+  assert(budget);
+  if (resident_level_ <= 0) {
+    return -1;
+  }
+  int next = resident_level_ - 1;
+  size_t size = levels_[next].size;
+  if (size > *budget) {
+    if (!oversized_ok) {
+      return -1;
+    }
+    *budget = 0;
+  } else {
+    *budget -= size;
+  }
+  resident_level_ = next;
+  return next;
+}
+
+}  // namespace ballistica::base
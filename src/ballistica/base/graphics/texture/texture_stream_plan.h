@@ -0,0 +1,83 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_BASE_GRAPHICS_TEXTURE_TEXTURE_STREAM_PLAN_H_
+#define BALLISTICA_BASE_GRAPHICS_TEXTURE_TEXTURE_STREAM_PLAN_H_
+
+#include <vector>
+
+#include "ballistica/base/base.h"
+
+namespace ballistica::base {
+
+/// Mip levels whose largest dimension is at or below this are uploaded
+/// immediately when a streamed texture loads.
+const int kTextureStreamTailSize = 128;
+
+/// How many bytes of streamed mip levels we upload per rendered frame.
+const size_t kTextureStreamFrameBudget = 1024 * 1024;
+
+/// Decides the order in which a texture's mip levels get uploaded.
+///
+/// The smallest levels (the 'tail' of the chain) go up immediately so the
+/// texture is usable right away. Larger levels are then handed out
+/// smallest-first under a per-frame byte budget. This is pure
+/// bookkeeping with no renderer calls, so it works in headless builds.
+///
+/// Level indices here are relative to the preload-data base-level, so
+/// index 0 is the largest level that will be used (and corresponds to
+/// renderer level 0).
+class TextureStreamPlan {
+ public:
+  struct Level {
+    int width{};
+    int height{};
+    // Bytes for this level summed across all faces.
+    size_t size{};
+  };
+
+  /// An empty plan; nothing to stream.
+  TextureStreamPlan() = default;
+
+  /// Build a plan for a set of preload-datas (1 for 2d textures or 6 for
+  /// cube-maps). Results in an empty plan unless every level in the chain
+  /// is explicitly provided (uncompressed textures, for instance, rely on
+  /// the gpu to generate mips so there is nothing to stream).
+  explicit TextureStreamPlan(
+      const std::vector<TextureAssetPreloadData>& preload_datas);
+
+  /// Build a plan for an explicit level list (largest first).
+  explicit TextureStreamPlan(std::vector<Level> levels);
+
+  auto level_count() const -> int { return static_cast<int>(levels_.size()); }
+  auto level(int index) const -> const Level& {
+    assert(index >= 0 && index < level_count());
+    return levels_[index];
+  }
+
+  /// The first level uploaded when the texture loads; it and everything
+  /// smaller go up at once.
+  auto initial_level() const -> int { return initial_level_; }
+
+  /// The largest level currently handed out.
+  auto resident_level() const -> int { return resident_level_; }
+
+  /// Whether larger levels remain to be handed out.
+  auto streaming() const -> bool { return resident_level_ > 0; }
+
+  /// Pop the next-larger level to upload and subtract its size from
+  /// `budget`. Returns -1 if nothing remains or the level does not fit.
+  /// When `oversized_ok` is set, a level larger than the whole budget is
+  /// still returned (leaving a zero budget) so huge levels can't stall
+  /// streaming forever.
+  auto PopLevel(size_t* budget, bool oversized_ok) -> int;
+
+ private:
+  void CalcInitialLevel_();
+  std::vector<Level> levels_;
+  int initial_level_{};
+  int resident_level_{};
+};
+
+}  // namespace ballistica::base
+
+#endif  // BALLISTICA_BASE_GRAPHICS_TEXTURE_TEXTURE_STREAM_PLAN_H_
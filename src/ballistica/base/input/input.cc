@@ -4,6 +4,7 @@
 
 #include <cstdio>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "ballistica/base/app_adapter/app_adapter.h"
@@ -14,12 +15,15 @@
 #include "ballistica/base/input/device/joystick_input.h"
 #include "ballistica/base/input/device/keyboard_input.h"
 #include "ballistica/base/input/device/touch_input.h"
+#include "ballistica/base/input/support/remote_app_server.h"
 #include "ballistica/base/logic/logic.h"
 #include "ballistica/base/python/base_python.h"
+#include "ballistica/base/support/app_config.h"
 #include "ballistica/base/ui/dev_console.h"
 #include "ballistica/base/ui/ui.h"
 #include "ballistica/core/platform/core_platform.h"
 #include "ballistica/shared/foundation/event_loop.h"
+#include "ballistica/shared/generic/lambda_runnable.h"
 #include "ballistica/shared/generic/utils.h"
 
 namespace ballistica::base {
@@ -557,6 +561,9 @@ void Input::ApplyAppConfig() {
 
   // Some config settings can affect this.
   UpdateInputDeviceCounts_();
+
+  late_sampling_ =
+      g_base->app_config->Resolve(AppConfig::BoolID::kLateInputSampling);
 }
 
 void Input::OnScreenSizeChange() { assert(g_base->InLogicThread()); }
@@ -794,12 +801,85 @@ void Input::PushTextInputEvent(const std::string& text) {
   });
 }
 
+void Input::PushEventRunnable_(Runnable* runnable) {
+  assert(g_base->logic->event_loop());
+
+  // Timestamp events as they come in so we can track how long they take
+  // to have effects.
+  auto event_time{g_core->AppTimeMicrosecs()};
+
+  if (late_sampling_) {
+    // Hold events for the logic thread to grab right before it steps, so
+    // the step sees everything that arrived up until then (even if the
+    // step was already queued ahead of the event). We also keep a single
+    // drain call queued in case no step comes along for a while, so events
+    // never get handled later than they otherwise would; any number of
+    // events arriving in the meantime share it instead of each getting
+    // their own trip through the event loop.
+    bool push_drain{};
+    {
+      std::scoped_lock lock(pending_events_mutex_);
+      pending_events_.emplace_back(event_time, runnable);
+      push_drain = !drain_call_pending_;
+      drain_call_pending_ = true;
+    }
+    if (push_drain) {
+      g_base->logic->event_loop()->PushCall([this] { DrainPendingEvents(); });
+    }
+    return;
+  }
+  g_base->logic->event_loop()->PushCall(
+      [this, event_time, runnable] { RunEvent_(event_time, runnable); });
+}
+
+void Input::RunEvent_(microsecs_t event_time, Runnable* runnable) {
+  assert(g_base->InLogicThread());
+  latency_.OnEventDispatched(event_time);
+  current_event_time_ = event_time;
+  runnable->RunAndLogErrors();
+  delete runnable;
+  current_event_time_ = -1;
+}
+
+void Input::DrainPendingEvents() {
+  assert(g_base->InLogicThread());
+  std::vector<std::pair<microsecs_t, Runnable*>> events;
+  {
+    std::scoped_lock lock(pending_events_mutex_);
+    drain_call_pending_ = false;
+    if (pending_events_.empty()) {
+      return;
+    }
+    pending_events_.swap(events);
+  }
+  for (auto&& event : events) {
+    RunEvent_(event.first, event.second);
+  }
+}
+
+void Input::ApplyRemoteAppStates() {
+  assert(g_base->InLogicThread());
+  if (remote_app_server_) {
+    remote_app_server_->ApplyClientStates();
+  }
+}
+
+void Input::HandleJoystickEvent(microsecs_t event_time, const SDL_Event& event,
+                                InputDevice* input_device) {
+  assert(g_base->InLogicThread());
+  latency_.OnEventDispatched(event_time);
+  current_event_time_ = event_time;
+  HandleJoystickEvent_(event, input_device);
+  current_event_time_ = -1;
+}
+
 void Input::PushJoystickEvent(const SDL_Event& event,
                               InputDevice* input_device) {
   assert(g_base->logic->event_loop());
-  g_base->logic->event_loop()->PushCall([this, event, input_device] {
-    HandleJoystickEvent_(event, input_device);
-  });
+  PushEventRunnable_(
+      NewLambdaRunnableUnmanaged([this, event, input_device] {
+        HandleJoystickEvent_(event, input_device);
+      }));
 }
 
 void Input::HandleJoystickEvent_(const SDL_Event& event,
@@ -830,26 +910,26 @@ void Input::HandleJoystickEvent_(const SDL_Event& event,
 
 void Input::PushKeyPressEventSimple(int key) {
   assert(g_base->logic->event_loop());
-  g_base->logic->event_loop()->PushCall(
-      [this, key] { HandleKeyPressSimple_(key); });
+  PushEventRunnable_(NewLambdaRunnableUnmanaged(
+      [this, key] { HandleKeyPressSimple_(key); }));
 }
 
 void Input::PushKeyReleaseEventSimple(int key) {
   assert(g_base->logic->event_loop());
-  g_base->logic->event_loop()->PushCall(
-      [this, key] { HandleKeyReleaseSimple_(key); });
+  PushEventRunnable_(NewLambdaRunnableUnmanaged(
+      [this, key] { HandleKeyReleaseSimple_(key); }));
 }
 
 void Input::PushKeyPressEvent(const SDL_Keysym& keysym) {
   assert(g_base->logic->event_loop());
-  g_base->logic->event_loop()->PushCall(
-      [this, keysym] { HandleKeyPress_(keysym); });
+  PushEventRunnable_(NewLambdaRunnableUnmanaged(
+      [this, keysym] { HandleKeyPress_(keysym); }));
 }
 
 void Input::PushKeyReleaseEvent(const SDL_Keysym& keysym) {
   assert(g_base->logic->event_loop());
-  g_base->logic->event_loop()->PushCall(
-      [this, keysym] { HandleKeyRelease_(keysym); });
+  PushEventRunnable_(NewLambdaRunnableUnmanaged(
+      [this, keysym] { HandleKeyRelease_(keysym); }));
 }
 
 void Input::CaptureKeyboardInput(HandleKeyPressCall* press_call,
@@ -1163,8 +1243,8 @@ void Input::UpdateModKeyStates_(const SDL_Keysym* keysym, bool press) {
 
 void Input::PushMouseScrollEvent(const Vector2f& amount) {
   assert(g_base->logic->event_loop());
-  g_base->logic->event_loop()->PushCall(
-      [this, amount] { HandleMouseScroll_(amount); });
+  PushEventRunnable_(NewLambdaRunnableUnmanaged(
+      [this, amount] { HandleMouseScroll_(amount); }));
 }
 
 void Input::HandleMouseScroll_(const Vector2f& amount) {
@@ -1200,9 +1280,10 @@ void Input::HandleMouseScroll_(const Vector2f& amount) {
 void Input::PushSmoothMouseScrollEvent(const Vector2f& velocity,
                                        bool momentum) {
   assert(g_base->logic->event_loop());
-  g_base->logic->event_loop()->PushCall([this, velocity, momentum] {
-    HandleSmoothMouseScroll_(velocity, momentum);
-  });
+  PushEventRunnable_(
+      NewLambdaRunnableUnmanaged([this, velocity, momentum] {
+        HandleSmoothMouseScroll_(velocity, momentum);
+      }));
 }
 
 void Input::HandleSmoothMouseScroll_(const Vector2f& velocity, bool momentum) {
@@ -1243,8 +1324,8 @@ void Input::PushMouseMotionEvent(const Vector2f& position) {
     return;
   }
 
-  g_base->logic->event_loop()->PushCall(
-      [this, position] { HandleMouseMotion_(position); });
+  PushEventRunnable_(NewLambdaRunnableUnmanaged(
+      [this, position] { HandleMouseMotion_(position); }));
 }
 
 void Input::HandleMouseMotion_(const Vector2f& position) {
@@ -1298,8 +1379,8 @@ void Input::HandleMouseMotion_(const Vector2f& position) {
 
 void Input::PushMouseDownEvent(int button, const Vector2f& position) {
   assert(g_base->logic->event_loop());
-  g_base->logic->event_loop()->PushCall(
-      [this, button, position] { HandleMouseDown_(button, position); });
+  PushEventRunnable_(NewLambdaRunnableUnmanaged(
+      [this, button, position] { HandleMouseDown_(button, position); }));
 }
 
 void Input::HandleMouseDown_(int button, const Vector2f& position) {
@@ -1362,8 +1443,8 @@ void Input::HandleMouseDown_(int button, const Vector2f& position) {
 
 void Input::PushMouseUpEvent(int button, const Vector2f& position) {
   assert(g_base->logic->event_loop());
-  g_base->logic->event_loop()->PushCall(
-      [this, button, position] { HandleMouseUp_(button, position); });
+  PushEventRunnable_(NewLambdaRunnableUnmanaged(
+      [this, button, position] { HandleMouseUp_(button, position); }));
 }
 
 static void ApplyMouseUpCancelToCamera(int button) {
@@ -1437,7 +1518,8 @@ void Input::PushTouchEvent(const TouchEvent& e) {
   assert(g_base->logic->event_loop());
   auto* loop{g_base->logic->event_loop()};
   if (loop->CheckPushSafety()) {
-    loop->PushCall([e, this] { HandleTouchEvent_(e); });
+    PushEventRunnable_(
+        NewLambdaRunnableUnmanaged([e, this] { HandleTouchEvent_(e); }));
   }
 }
 
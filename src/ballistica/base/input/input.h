@@ -3,13 +3,17 @@
 #ifndef BALLISTICA_BASE_INPUT_INPUT_H_
 #define BALLISTICA_BASE_INPUT_INPUT_H_
 
+#include <atomic>
 #include <list>
+#include <mutex>
 #include <set>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "ballistica/base/base.h"
+#include "ballistica/base/input/support/input_latency.h"
 #include "ballistica/shared/foundation/object.h"
 
 namespace ballistica::base {
@@ -156,6 +160,31 @@ class Input {
   /// Roughly how long in milliseconds have all input devices been idle.
   auto input_idle_time() const { return input_idle_time_; }
 
+  /// Tracks how long input events take to have effects.
+  auto latency() -> InputLatency& { return latency_; }
+
+  /// When the input event currently being handled came in (in app-time
+  /// microseconds), or -1 if we're not handling one.
+  auto current_event_time() const -> microsecs_t { return current_event_time_; }
+
+  /// Handle any input events being held for late sampling. Should be
+  /// called right before stepping.
+  void DrainPendingEvents();
+
+  /// Apply the latest remote-app controller states. Should be called
+  /// right before stepping.
+  void ApplyRemoteAppStates();
+
+  /// Set by the remote-app server once it has states for us to apply.
+  void set_remote_app_server(RemoteAppServer* server) {
+    remote_app_server_ = server;
+  }
+
+  /// Handle a joystick event immediately (in the logic thread).
+  /// `event_time` is when it came in, for latency tracking.
+  void HandleJoystickEvent(microsecs_t event_time, const SDL_Event& event,
+                           InputDevice* input_device);
+
   typedef bool(HandleJoystickEventCall)(const SDL_Event& event,
                                         InputDevice* input_device);
   typedef bool(HandleKeyPressCall)(const SDL_Keysym& keysym);
@@ -173,6 +202,8 @@ class Input {
   void set_attract_mode(bool val) { attract_mode_ = val; }
 
  private:
+  void PushEventRunnable_(Runnable* runnable);
+  void RunEvent_(microsecs_t event_time, Runnable* runnable);
   auto ShouldAllowInputInAttractMode_(InputDevice* device) const -> bool;
   void UpdateInputDeviceCounts_();
   auto GetNewNumberedIdentifier_(const std::string& name) -> int;
@@ -210,6 +241,13 @@ class Input {
       reserved_identifiers_;
   std::vector<Object::Ref<InputDevice> > input_devices_;
   std::set<int> keys_held_;
+  std::vector<std::pair<microsecs_t, Runnable*> > pending_events_;
+  std::mutex pending_events_mutex_;
+  bool drain_call_pending_{};
+  InputLatency latency_;
+  microsecs_t current_event_time_{-1};
+  RemoteAppServer* remote_app_server_{};
+  std::atomic_bool late_sampling_{};
   void* single_touch_{};
   KeyboardInput* keyboard_input_{};
   KeyboardInput* keyboard_input_2_{};
@@ -0,0 +1,133 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/base/input/support/input_latency.h"
+
+#include <algorithm>
+
+#include "ballistica/core/core.h"
+
+namespace ballistica::base {
+
+// Stats are calculated over this many of the most recent samples.
+const int kInputLatencySampleCount{256};
+
+InputLatency::InputLatency() {
+  for (auto& samples : samples_) {
+    samples.recent.resize(kInputLatencySampleCount);
+  }
+}
+
+auto InputLatency::StageName(InputLatencyStage stage) -> const char* {
+  switch (stage) {
+    case InputLatencyStage::kDispatch:
+      return "dispatch";
+    case InputLatencyStage::kSim:
+      return "sim";
+    case InputLatencyStage::kFrame:
+      return "frame";
+    case InputLatencyStage::kPresent:
+      return "present";
+    case InputLatencyStage::kNetwork:
+      return "network";
+    default:
+      return "unknown";
+  }
+}
+
+void InputLatency::SetSyntheticTime(microsecs_t time) {
+  std::scoped_lock lock(mutex_);
+  synthetic_time_ = time;
+}
+
+void InputLatency::AddSample_(InputLatencyStage stage,
+                              microsecs_t event_time) {
+  auto& samples{samples_[static_cast<int>(stage)]};
+  auto now{synthetic_time_ >= 0 ? synthetic_time_
+                                : g_core->AppTimeMicrosecs()};
+  samples.recent[samples.next] = std::max(microsecs_t{0}, now - event_time);
+  samples.next = (samples.next + 1) % kInputLatencySampleCount;
+  samples.count++;
+}
+
+void InputLatency::OnEventDispatched(microsecs_t event_time) {
+  std::scoped_lock lock(mutex_);
+  AddSample_(InputLatencyStage::kDispatch, event_time);
+}
+
+void InputLatency::OnEventConsumed(microsecs_t event_time) {
+  std::scoped_lock lock(mutex_);
+  if (pending_sim_event_time_ < 0 || event_time < pending_sim_event_time_) {
+    pending_sim_event_time_ = event_time;
+  }
+}
+
+void InputLatency::OnSimStep() {
+  std::scoped_lock lock(mutex_);
+  if (pending_sim_event_time_ < 0) {
+    return;
+  }
+  AddSample_(InputLatencyStage::kSim, pending_sim_event_time_);
+  if (pending_frame_event_time_ < 0) {
+    pending_frame_event_time_ = pending_sim_event_time_;
+  }
+  pending_sim_event_time_ = -1;
+}
+
+auto InputLatency::TakeFrameEventTime() -> microsecs_t {
+  std::scoped_lock lock(mutex_);
+  auto event_time{pending_frame_event_time_};
+  if (event_time >= 0) {
+    AddSample_(InputLatencyStage::kFrame, event_time);
+    pending_frame_event_time_ = -1;
+  }
+  return event_time;
+}
+
+void InputLatency::OnFramePresented(microsecs_t event_time) {
+  std::scoped_lock lock(mutex_);
+  AddSample_(InputLatencyStage::kPresent, event_time);
+}
+
+void InputLatency::OnEventSent(microsecs_t event_time) {
+  std::scoped_lock lock(mutex_);
+  AddSample_(InputLatencyStage::kNetwork, event_time);
+}
+
+auto InputLatency::GetStats(InputLatencyStage stage) const -> Stats {
+  std::vector<microsecs_t> recent;
+  Stats stats;
+  {
+    std::scoped_lock lock(mutex_);
+    auto& samples{samples_[static_cast<int>(stage)]};
+    stats.count = samples.count;
+    recent.assign(samples.recent.begin(),
+                  samples.recent.begin()
+                      + std::min(samples.count, kInputLatencySampleCount));
+  }
+  if (recent.empty()) {
+    return stats;
+  }
+  std::sort(recent.begin(), recent.end());
+  double total{};
+  for (auto&& sample : recent) {
+    total += static_cast<double>(sample);
+  }
+  auto size{recent.size()};
+  stats.mean_ms = total / static_cast<double>(size) / 1000.0;
+  stats.p50_ms = static_cast<double>(recent[size / 2]) / 1000.0;
+  stats.p95_ms = static_cast<double>(recent[size * 95 / 100]) / 1000.0;
+  stats.max_ms = static_cast<double>(recent.back()) / 1000.0;
+  return stats;
+}
+
+void InputLatency::Reset() {
+  std::scoped_lock lock(mutex_);
+  for (auto& samples : samples_) {
+    samples.next = 0;
+    samples.count = 0;
+  }
+  pending_sim_event_time_ = -1;
+  pending_frame_event_time_ = -1;
+}
+
+}  // namespace ballistica::base
@@ -0,0 +1,95 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_BASE_INPUT_SUPPORT_INPUT_LATENCY_H_
+#define BALLISTICA_BASE_INPUT_SUPPORT_INPUT_LATENCY_H_
+
+#include <mutex>
+#include <vector>
+
+#include "ballistica/base/base.h"
+
+namespace ballistica::base {
+
+/// Points along the way from an input event to its effects.
+enum class InputLatencyStage {
+  /// The event reached its handler in the logic thread.
+  kDispatch,
+  /// A sim step ran with the event applied to a local player.
+  kSim,
+  /// A frame-def reflecting that sim step was built.
+  kFrame,
+  /// That frame was presented on screen.
+  kPresent,
+  /// The event went out to a host in an input-commands message.
+  kNetwork,
+  kLast  // Sentinel.
+};
+
+/// Tracks how long input events take to reach various stages.
+///
+/// Events are timestamped (in app-time microseconds) when they are pushed
+/// to the logic thread, and that timestamp is carried along to each stage.
+/// Only the oldest not-yet-shown event is tracked through the sim, frame,
+/// and present stages; that's the one whose latency the user feels. Safe
+/// to use from any thread.
+class InputLatency {
+ public:
+  struct Stats {
+    int count{};
+    double mean_ms{};
+    double p50_ms{};
+    double p95_ms{};
+    double max_ms{};
+  };
+
+  InputLatency();
+
+  static auto StageName(InputLatencyStage stage) -> const char*;
+
+  /// Measure samples against the provided time instead of the current
+  /// app-time (for testing). Pass -1 to go back to app-time.
+  void SetSyntheticTime(microsecs_t time);
+
+  /// An event was handed to its handler in the logic thread.
+  void OnEventDispatched(microsecs_t event_time);
+
+  /// An event was applied to a local player. Its effects show up in the
+  /// next sim step.
+  void OnEventConsumed(microsecs_t event_time);
+
+  /// A sim step is about to run.
+  void OnSimStep();
+
+  /// Return the time of the oldest event reflected in a frame-def being
+  /// built now (or -1 if there is none) and record its frame latency.
+  auto TakeFrameEventTime() -> microsecs_t;
+
+  /// A frame-def carrying an event time was presented.
+  void OnFramePresented(microsecs_t event_time);
+
+  /// An event went out over the network.
+  void OnEventSent(microsecs_t event_time);
+
+  auto GetStats(InputLatencyStage stage) const -> Stats;
+  void Reset();
+
+ private:
+  void AddSample_(InputLatencyStage stage, microsecs_t event_time);
+
+  struct Samples {
+    // Ring buffer of recent samples.
+    std::vector<microsecs_t> recent;
+    int next{};
+    int count{};
+  };
+
+  mutable std::mutex mutex_;
+  Samples samples_[static_cast<int>(InputLatencyStage::kLast)];
+  microsecs_t pending_sim_event_time_{-1};
+  microsecs_t pending_frame_event_time_{-1};
+  microsecs_t synthetic_time_{-1};
+};
+
+}  // namespace ballistica::base
+
+#endif  // BALLISTICA_BASE_INPUT_SUPPORT_INPUT_LATENCY_H_
@@ -41,10 +41,76 @@ enum class RemoteAppServer::RemoteEventType {
   kRunRelease
 };
 
+// While v3 states are streaming in, we ack at most this often (in
+// milliseconds).
+const millisecs_t kRemoteAppStateAckInterval{20};
+
 RemoteAppServer::RemoteAppServer() = default;
 
 RemoteAppServer::~RemoteAppServer() = default;
 
+template <typename F>
+void RemoteAppServer::DiffStates_(uint32_t last_state, uint32_t state,
+                                  F&& handle_event) {
+  uint32_t h_raw = (state >> 8u) & 0xFFu;
+  uint32_t v_raw = (state >> 16u) & 0xFFu;
+  uint32_t h_raw_last = (last_state >> 8u) & 0xFFu;
+  uint32_t v_raw_last = (last_state >> 16u) & 0xFFu;
+  float dpad_h, dpad_v;
+  dpad_h = -1.0f + 2.0f * (static_cast<float>(h_raw) / 255.0f);
+  dpad_v = -1.0f + 2.0f * (static_cast<float>(v_raw) / 255.0f);
+  float last_dpad_h, last_dpad_v;
+  last_dpad_h = -1.0f + 2.0f * (static_cast<float>(h_raw_last) / 255.0f);
+  last_dpad_v = -1.0f + 2.0f * (static_cast<float>(v_raw_last) / 255.0f);
+
+  // Process this first since it can affect how other events are handled.
+  if ((last_state & kRemoteStateHoldPosition)
+      && !(state & kRemoteStateHoldPosition)) {
+    handle_event(RemoteEventType::kHoldPositionRelease, 0.0f);
+  } else if (!(last_state & kRemoteStateHoldPosition)
+             && (state & kRemoteStateHoldPosition)) {
+    handle_event(RemoteEventType::kHoldPositionPress, 0.0f);
+  }
+  if (dpad_h != last_dpad_h) {
+    handle_event(RemoteEventType::kDPadH, dpad_h);
+  }
+  if (dpad_v != last_dpad_v) {
+    handle_event(RemoteEventType::kDPadV, dpad_v);
+  }
+  if ((last_state & kRemoteStateBomb) && !(state & kRemoteStateBomb)) {
+    handle_event(RemoteEventType::kBombRelease, 0.0f);
+  } else if (!(last_state & kRemoteStateBomb) && (state & kRemoteStateBomb)) {
+    handle_event(RemoteEventType::kBombPress, 0.0f);
+  }
+  if ((last_state & kRemoteStateJump) && !(state & kRemoteStateJump)) {
+    handle_event(RemoteEventType::kJumpRelease, 0.0f);
+  } else if (!(last_state & kRemoteStateJump) && (state & kRemoteStateJump)) {
+    handle_event(RemoteEventType::kJumpPress, 0.0f);
+  }
+  if ((last_state & kRemoteStatePunch) && !(state & kRemoteStatePunch)) {
+    handle_event(RemoteEventType::kPunchRelease, 0.0f);
+  } else if (!(last_state & kRemoteStatePunch)
+             && (state & kRemoteStatePunch)) {
+    handle_event(RemoteEventType::kPunchPress, 0.0f);
+  }
+  if ((last_state & kRemoteStateThrow) && !(state & kRemoteStateThrow)) {
+    handle_event(RemoteEventType::kThrowRelease, 0.0f);
+  } else if (!(last_state & kRemoteStateThrow)
+             && (state & kRemoteStateThrow)) {
+    handle_event(RemoteEventType::kThrowPress, 0.0f);
+  }
+  if ((last_state & kRemoteStateMenu) && !(state & kRemoteStateMenu)) {
+    handle_event(RemoteEventType::kMenuRelease, 0.0f);
+  } else if (!(last_state & kRemoteStateMenu) && (state & kRemoteStateMenu)) {
+    handle_event(RemoteEventType::kMenuPress, 0.0f);
+  }
+  if ((last_state & kRemoteStateRun) && !(state & kRemoteStateRun)) {
+    handle_event(RemoteEventType::kRunRelease, 0.0f);
+  } else if (!(last_state & kRemoteStateRun) && (state & kRemoteStateRun)) {
+    handle_event(RemoteEventType::kRunPress, 0.0f);
+  }
+}
+
 void RemoteAppServer::HandleData(int socket, uint8_t* buffer, size_t amt,
                                  struct sockaddr* addr, size_t addr_len) {
   if (amt == 0) {
@@ -110,9 +176,14 @@ void RemoteAppServer::HandleData(int socket, uint8_t* buffer, size_t amt,
       // If they sent 50, it means they want protocol v2 (24 bit states).
       // In that case we return 100 to say 'ok, we support that version'.
       // Note to self (years later): please explain to me why I did this.
-      bool using_v2 = (protocol_request == 50);
-      if (using_v2) {
-        protocol_response = 100;
+      // V3 works the same way (sequenced full-state snapshots).
+      int state_protocol{1};
+      if (protocol_request == kRemoteAppStateProtocolRequestV2) {
+        state_protocol = 2;
+        protocol_response = kRemoteAppStateProtocolResponseV2;
+      } else if (protocol_request == kRemoteAppStateProtocolRequestV3) {
+        state_protocol = 3;
+        protocol_response = kRemoteAppStateProtocolResponseV3;
       }
 
       // Remaining bytes are name (up to 100 bytes).
@@ -125,7 +196,7 @@ void RemoteAppServer::HandleData(int socket, uint8_t* buffer, size_t amt,
       strncpy(name, reinterpret_cast<char*>(buffer) + 5, name_len);
       name[name_len] = 0;
       int client_id = GetClient(request_id, addr, static_cast<int>(addr_len),
-                                name, using_v2);
+                                name, state_protocol);
 
       // If we've got a slot for this client, tell them what their id is.
       if (client_id != -1) {
@@ -172,6 +243,7 @@ void RemoteAppServer::HandleData(int socket, uint8_t* buffer, size_t amt,
           });
           g_base->logic->event_loop()->PushCall(
               [] { g_base->audio->SafePlaySysSound(SysSoundID::kCorkPop); });
+          PushSetAppliedJoystickCall_(joystickID, nullptr);
           g_base->input->PushRemoveInputDeviceCall(client->joystick_, false);
           client->joystick_ = nullptr;
           client->in_use = false;
@@ -198,6 +270,9 @@ void RemoteAppServer::HandleData(int socket, uint8_t* buffer, size_t amt,
       uint8_t joystick_id = buffer[1];
       uint8_t state_count = buffer[2];
       uint8_t state_id = buffer[3];
+      if (joystick_id >= kMaxRemoteAppClients) {
+        break;
+      }
 
       // If its not an active joystick, let them know they're not playing
       // (this can happen if they time-out but still try to keep talking to us).
@@ -238,74 +313,15 @@ void RemoteAppServer::HandleData(int socket, uint8_t* buffer, size_t amt,
 
         // If this is the next state we're looking for, apply it.
         if (client->next_state_id == state_id) {
-          uint32_t last_state = client->state;
           uint32_t state = val[0] + (val[1] << 8u) + (val[2] << 16u);
-          uint32_t h_raw = (state >> 8u) & 0xFFu;
-          uint32_t v_raw = (state >> 16u) & 0xFFu;
-          uint32_t h_raw_last = (last_state >> 8u) & 0xFFu;
-          uint32_t v_raw_last = (last_state >> 16u) & 0xFFu;
-          float dpad_h, dpad_v;
-          dpad_h = -1.0f + 2.0f * (static_cast<float>(h_raw) / 255.0f);
-          dpad_v = -1.0f + 2.0f * (static_cast<float>(v_raw) / 255.0f);
-          float last_dpad_h, last_dpad_v;
-          last_dpad_h =
-              -1.0f + 2.0f * (static_cast<float>(h_raw_last) / 255.0f);
-          last_dpad_v =
-              -1.0f + 2.0f * (static_cast<float>(v_raw_last) / 255.0f);
-
-          // Process this first since it can affect how other events are
-          // handled.
-          if ((last_state & kRemoteStateHoldPosition)
-              && !(state & kRemoteStateHoldPosition)) {
-            HandleRemoteEvent(client, RemoteEventType::kHoldPositionRelease);
-          } else if (!(last_state & kRemoteStateHoldPosition)
-                     && (state & kRemoteStateHoldPosition)) {
-            HandleRemoteEvent(client, RemoteEventType::kHoldPositionPress);
-          }
-          if (dpad_h != last_dpad_h) {
-            HandleRemoteFloatEvent(client, RemoteEventType::kDPadH, dpad_h);
-          }
-          if (dpad_v != last_dpad_v) {
-            HandleRemoteFloatEvent(client, RemoteEventType::kDPadV, dpad_v);
-          }
-          if ((last_state & kRemoteStateBomb) && !(state & kRemoteStateBomb)) {
-            HandleRemoteEvent(client, RemoteEventType::kBombRelease);
-          } else if (!(last_state & kRemoteStateBomb)
-                     && (state & kRemoteStateBomb)) {
-            HandleRemoteEvent(client, RemoteEventType::kBombPress);
-          }
-          if ((last_state & kRemoteStateJump) && !(state & kRemoteStateJump)) {
-            HandleRemoteEvent(client, RemoteEventType::kJumpRelease);
-          } else if (!(last_state & kRemoteStateJump)
-                     && (state & kRemoteStateJump)) {
-            HandleRemoteEvent(client, RemoteEventType::kJumpPress);
-          }
-          if ((last_state & kRemoteStatePunch)
-              && !(state & kRemoteStatePunch)) {
-            HandleRemoteEvent(client, RemoteEventType::kPunchRelease);
-          } else if (!(last_state & kRemoteStatePunch)
-                     && (state & kRemoteStatePunch)) {
-            HandleRemoteEvent(client, RemoteEventType::kPunchPress);
-          }
-          if ((last_state & kRemoteStateThrow)
-              && !(state & kRemoteStateThrow)) {
-            HandleRemoteEvent(client, RemoteEventType::kThrowRelease);
-          } else if (!(last_state & kRemoteStateThrow)
-                     && (state & kRemoteStateThrow)) {
-            HandleRemoteEvent(client, RemoteEventType::kThrowPress);
-          }
-          if ((last_state & kRemoteStateMenu) && !(state & kRemoteStateMenu)) {
-            HandleRemoteEvent(client, RemoteEventType::kMenuRelease);
-          } else if (!(last_state & kRemoteStateMenu)
-                     && (state & kRemoteStateMenu)) {
-            HandleRemoteEvent(client, RemoteEventType::kMenuPress);
-          }
-          if ((last_state & kRemoteStateRun) && !(state & kRemoteStateRun)) {
-            HandleRemoteEvent(client, RemoteEventType::kRunRelease);
-          } else if (!(last_state & kRemoteStateRun)
-                     && (state & kRemoteStateRun)) {
-            HandleRemoteEvent(client, RemoteEventType::kRunPress);
-          }
+          DiffStates_(client->state, state,
+                      [client](RemoteEventType type, float value) {
+                        SDL_Event e{};
+                        if (MakeRemoteEvent_(type, value, &e)) {
+                          g_base->input->PushJoystickEvent(e,
+                                                           client->joystick_);
+                        }
+                      });
           client->state = state;
           client->next_state_id++;
         }
@@ -323,6 +339,10 @@ void RemoteAppServer::HandleData(int socket, uint8_t* buffer, size_t amt,
 
       break;
     }
+    case BA_PACKET_REMOTE_STATE3: {
+      HandleStateV3_(socket, buffer, amt, addr, addr_len);
+      break;
+    }
     case BA_PACKET_REMOTE_STATE: {
       // Has to be at least 4 bytes.
       // (msg-type, joystick-id, state-count, starting-state-id)
@@ -348,7 +368,7 @@ void RemoteAppServer::HandleData(int socket, uint8_t* buffer, size_t amt,
 
 auto RemoteAppServer::GetClient(int request_id, struct sockaddr* addr,
                                 size_t addr_len, const char* name,
-                                bool using_v2) -> int {
+                                int state_protocol) -> int {
   // If we're not accepting connections at all, reject 'em.
   if (!g_base->networking->remote_server_accepting_connections()) {
     return -1;
@@ -365,6 +385,7 @@ auto RemoteAppServer::GetClient(int request_id, struct sockaddr* addr,
       // or something; lets take note of that.
       if (clients_[i].request_id != request_id) {
         clients_[i].request_id = request_id;
+        clients_[i].state_sequencer.Reset();
 
         // Print 'Billy Bob's iPhone Reconnected'.
         char m[256];
@@ -385,6 +406,15 @@ auto RemoteAppServer::GetClient(int request_id, struct sockaddr* addr,
         });
       }
       clients_[i].in_use = true;
+
+      // They may have switched protocols; v3 states get applied from the
+      // logic thread so it needs to know about their joystick.
+      if (clients_[i].state_protocol != state_protocol) {
+        clients_[i].state_protocol = state_protocol;
+        clients_[i].state_sequencer.Reset();
+        PushSetAppliedJoystickCall_(
+            i, state_protocol == 3 ? clients_[i].joystick_ : nullptr);
+      }
       return i;
     }
   }
@@ -401,6 +431,9 @@ auto RemoteAppServer::GetClient(int request_id, struct sockaddr* addr,
       clients_[i].in_use = true;
       clients_[i].next_state_id = 0;
       clients_[i].state = 0;
+      clients_[i].state_protocol = state_protocol;
+      clients_[i].state_sequencer.Reset();
+      clients_[i].latest_state = 0;
       BA_PRECONDITION(addr_len <= sizeof(clients_[i].address));
       memcpy(&clients_[i].address, addr, addr_len);
       clients_[i].address_size = addr_len;
@@ -441,7 +474,7 @@ auto RemoteAppServer::GetClient(int request_id, struct sockaddr* addr,
           "RemoteApp: "
               + utf8,  // device name (we now incorporate the name they send us)
           false,       // don't allow configuring
-          using_v2);   // calibrate in v2; not v1
+          state_protocol >= 2);  // calibrate in v2 and up; not v1
       clients_[i].joystick_->set_is_remote_app(true);
 
       // If they name they supplied was <= 10 characters, use it as our default
@@ -451,6 +484,9 @@ auto RemoteAppServer::GetClient(int request_id, struct sockaddr* addr,
       }
       assert(g_base->logic);
       g_base->input->PushAddInputDeviceCall(clients_[i].joystick_, false);
+      if (state_protocol == 3) {
+        PushSetAppliedJoystickCall_(i, clients_[i].joystick_);
+      }
       return i;
     }
   }
@@ -458,118 +494,212 @@ auto RemoteAppServer::GetClient(int request_id, struct sockaddr* addr,
   return -1;
 }
 
-void RemoteAppServer::HandleRemoteEvent(RemoteAppClient* client,
-                                        RemoteEventType b) {
-  bool send{true};
+void RemoteAppServer::HandleStateV3_(int socket, uint8_t* buffer,
+                                     size_t amt, struct sockaddr* addr,
+                                     size_t addr_len) {
+  // (msg-type, joystick-id, 4 byte sequence number, 3 byte state)
+  if (amt != 9 || buffer[1] >= kMaxRemoteAppClients) {
+    BA_LOG_ONCE(LogName::kBaInput, LogLevel::kError, "Invalid state3 packet");
+    return;
+  }
+  int client_id = buffer[1];
+  RemoteAppClient* client = clients_ + client_id;
+
+  if (!client->in_use || client->state_protocol != 3) {
+    uint8_t data[2] = {
+        BA_PACKET_REMOTE_DISCONNECT,
+        static_cast_check_fit<uint8_t>(RemoteError::kNotConnected)};
+
+    // This needs to be locked during any sd changes/writes.
+    std::scoped_lock lock(g_base->network_reader->sd_mutex());
+    sendto(socket, reinterpret_cast<char*>(data), sizeof(data), 0, addr,
+           static_cast<socklen_t>(addr_len));
+    return;
+  }
+
+  millisecs_t now = g_core->AppTimeMillisecs();
+  client->last_contact_time = now;
+
+  uint32_t seq = buffer[2] + (buffer[3] << 8u) + (buffer[4] << 16u)
+                 + (static_cast<uint32_t>(buffer[5]) << 24u);
+  bool send_ack{};
+  if (client->state_sequencer.OnState(seq, now, &send_ack)) {
+    uint32_t state = buffer[6] + (buffer[7] << 8u) + (buffer[8] << 16u);
+    client->latest_state_time.store(g_core->AppTimeMicrosecs(),
+                                    std::memory_order_relaxed);
+    client->latest_state.store(state, std::memory_order_release);
+  }
+  if (send_ack) {
+    SendStateAckV3_(socket, client_id, addr, addr_len);
+  }
+}
+
+void RemoteAppServer::SendStateAckV3_(int socket, int client_id,
+                                      struct sockaddr* addr,
+                                      size_t addr_len) {
+  RemoteAppClient* client = clients_ + client_id;
+  uint32_t seq = client->state_sequencer.seq();
+
+  uint8_t data[6];
+  data[0] = BA_PACKET_REMOTE_STATE3_ACK;
+  data[1] = static_cast<uint8_t>(client_id);
+  for (int i = 0; i < 4; i++) {
+    data[2 + i] = static_cast<uint8_t>(seq >> (8u * i));
+  }
 
-  // Ok we got some data from the remote.
-  // All we have to do is translate it into an SDL event and feed it to our
-  // manual joystick we made.
-  SDL_Event e{};
+  // This needs to be locked during any sd changes/writes.
+  std::scoped_lock lock(g_base->network_reader->sd_mutex());
+  sendto(socket, reinterpret_cast<char*>(data), sizeof(data), 0, addr,
+         static_cast<socklen_t>(addr_len));
+}
+
+auto RemoteAppStateSequencer::OnState(uint32_t seq, millisecs_t now,
+                                      bool* send_ack) -> bool {
+  assert(send_ack);
+
+  // Each packet carries the full state, so anything not newer than what
+  // we've got is useless to us. Sequence numbers can wrap.
+  bool first = !have_seq_;
+  bool newer = first || static_cast<int32_t>(seq - seq_) > 0;
+  if (newer) {
+    have_seq_ = true;
+    seq_ = seq;
+  }
+
+  // Acks are cumulative (they cover everything up to the sequence number
+  // they carry) so we don't need to send one for every packet while
+  // states are streaming in. We always respond to stale packets though,
+  // since those mean the remote is still waiting to hear from us.
+  *send_ack =
+      first || !newer || now - last_ack_time_ >= kRemoteAppStateAckInterval;
+  if (*send_ack) {
+    last_ack_time_ = now;
+  }
+  return newer;
+}
+
+void RemoteAppServer::PushSetAppliedJoystickCall_(int client_id,
+                                                  JoystickInput* joystick) {
+  // Make sure the logic thread knows to come looking for our states.
+  if (!registered_with_input_) {
+    registered_with_input_ = true;
+    g_base->logic->event_loop()->PushCall(
+        [this] { g_base->input->set_remote_app_server(this); });
+  }
+
+  // Joysticks come and go via calls pushed to the logic thread, so we
+  // hand them to the logic-thread side the same way to keep things in
+  // order.
+  g_base->logic->event_loop()->PushCall([this, client_id, joystick] {
+    RemoteAppClient* client = clients_ + client_id;
+    client->applied_joystick = joystick;
+    client->applied_state = 0;
+  });
+}
+
+void RemoteAppServer::ApplyClientStates() {
+  assert(g_base->InLogicThread());
+  for (auto& client : clients_) {
+    if (!client.applied_joystick) {
+      continue;
+    }
+    uint32_t state = client.latest_state.load(std::memory_order_acquire);
+    if (state == client.applied_state) {
+      continue;
+    }
+    microsecs_t state_time =
+        client.latest_state_time.load(std::memory_order_relaxed);
+    JoystickInput* joystick = client.applied_joystick;
+    DiffStates_(client.applied_state, state,
+                [joystick, state_time](RemoteEventType type, float value) {
+                  SDL_Event e{};
+                  if (MakeRemoteEvent_(type, value, &e)) {
+                    g_base->input->HandleJoystickEvent(state_time, e,
+                                                       joystick);
+                  }
+                });
+    client.applied_state = state;
+  }
+}
+
+auto RemoteAppServer::MakeRemoteEvent_(RemoteEventType b, float val,
+                                       SDL_Event* e) -> bool {
+  // All we have to do is translate remote events into SDL events to feed
+  // to the manual joysticks we made.
   switch (b) {
     case RemoteEventType::kBombPress:
-      e.type = SDL_JOYBUTTONDOWN;
-      e.jbutton.button = 2;
-      break;
+      e->type = SDL_JOYBUTTONDOWN;
+      e->jbutton.button = 2;
+      return true;
     case RemoteEventType::kBombRelease:
-      e.type = SDL_JOYBUTTONUP;
-      e.jbutton.button = 2;
-      break;
+      e->type = SDL_JOYBUTTONUP;
+      e->jbutton.button = 2;
+      return true;
 
       // Could actually call the menu func directly,
       // but it should be fine to just emulate it via the button-press.
     case RemoteEventType::kMenu:
     case RemoteEventType::kMenuPress:
-      e.type = SDL_JOYBUTTONDOWN;
-      e.jbutton.button = 5;
-      break;
+      e->type = SDL_JOYBUTTONDOWN;
+      e->jbutton.button = 5;
+      return true;
     case RemoteEventType::kMenuRelease:
-      e.type = SDL_JOYBUTTONUP;
-      e.jbutton.button = 5;
-      break;
+      e->type = SDL_JOYBUTTONUP;
+      e->jbutton.button = 5;
+      return true;
     case RemoteEventType::kJumpPress:
-      e.type = SDL_JOYBUTTONDOWN;
-      e.jbutton.button = 0;
-      break;
+      e->type = SDL_JOYBUTTONDOWN;
+      e->jbutton.button = 0;
+      return true;
     case RemoteEventType::kJumpRelease:
-      e.type = SDL_JOYBUTTONUP;
-      e.jbutton.button = 0;
-      break;
+      e->type = SDL_JOYBUTTONUP;
+      e->jbutton.button = 0;
+      return true;
     case RemoteEventType::kThrowPress:
-      e.type = SDL_JOYBUTTONDOWN;
-      e.jbutton.button = 3;
-      break;
+      e->type = SDL_JOYBUTTONDOWN;
+      e->jbutton.button = 3;
+      return true;
     case RemoteEventType::kThrowRelease:
-      e.type = SDL_JOYBUTTONUP;
-      e.jbutton.button = 3;
-      break;
+      e->type = SDL_JOYBUTTONUP;
+      e->jbutton.button = 3;
+      return true;
     case RemoteEventType::kPunchPress:
-      e.type = SDL_JOYBUTTONDOWN;
-      e.jbutton.button = 1;
-      break;
+      e->type = SDL_JOYBUTTONDOWN;
+      e->jbutton.button = 1;
+      return true;
     case RemoteEventType::kPunchRelease:
-      e.type = SDL_JOYBUTTONUP;
-      e.jbutton.button = 1;
-      break;
+      e->type = SDL_JOYBUTTONUP;
+      e->jbutton.button = 1;
+      return true;
     case RemoteEventType::kHoldPositionPress:
-      e.type = SDL_JOYBUTTONDOWN;
-      e.jbutton.button = 25;
-      break;
+      e->type = SDL_JOYBUTTONDOWN;
+      e->jbutton.button = 25;
+      return true;
     case RemoteEventType::kHoldPositionRelease:
-      e.type = SDL_JOYBUTTONUP;
-      e.jbutton.button = 25;
-      break;
+      e->type = SDL_JOYBUTTONUP;
+      e->jbutton.button = 25;
+      return true;
     case RemoteEventType::kRunPress:
-      e.type = SDL_JOYBUTTONDOWN;
-      e.jbutton.button = 64;
-      break;
+      e->type = SDL_JOYBUTTONDOWN;
+      e->jbutton.button = 64;
+      return true;
     case RemoteEventType::kRunRelease:
-      e.type = SDL_JOYBUTTONUP;
-      e.jbutton.button = 64;
-      break;
-
-#pragma clang diagnostic push
-#pragma ide diagnostic ignored "UnreachableCode"
-#pragma ide diagnostic ignored "ConstantConditionsOC"
-    default:
-      send = false;
-      break;
-  }
-  if (send) {
-    assert(g_base->logic);
-    g_base->input->PushJoystickEvent(e, client->joystick_);
-  }
-#pragma clang diagnostic pop
-}
-
-void RemoteAppServer::HandleRemoteFloatEvent(RemoteAppClient* client,
-                                             RemoteEventType b, float val) {
-  SDL_Event e{};
-  bool send = true;
-  switch (b) {
+      e->type = SDL_JOYBUTTONUP;
+      e->jbutton.button = 64;
+      return true;
     case RemoteEventType::kDPadH:
-      e.type = SDL_JOYAXISMOTION;
-      e.jaxis.axis = 0;
-      e.jaxis.value = static_cast<int16_t>(32767 * val);
-      break;
+      e->type = SDL_JOYAXISMOTION;
+      e->jaxis.axis = 0;
+      e->jaxis.value = static_cast<int16_t>(32767 * val);
+      return true;
     case RemoteEventType::kDPadV:
-      e.type = SDL_JOYAXISMOTION;
-      e.jaxis.axis = 1;
-      e.jaxis.value = static_cast<int16_t>(32767 * val);
-      break;
-
-#pragma clang diagnostic push
-#pragma ide diagnostic ignored "UnreachableCode"
-#pragma ide diagnostic ignored "ConstantConditionsOC"
+      e->type = SDL_JOYAXISMOTION;
+      e->jaxis.axis = 1;
+      e->jaxis.value = static_cast<int16_t>(32767 * val);
+      return true;
     default:
-      send = false;
-      break;
-  }
-  if (send) {
-    assert(g_base->logic);
-    g_base->input->PushJoystickEvent(e, client->joystick_);
+      return false;
   }
-#pragma clang diagnostic pop
 }
 
 }  // namespace ballistica::base
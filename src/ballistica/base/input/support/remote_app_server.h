@@ -3,6 +3,8 @@
 #ifndef BALLISTICA_BASE_INPUT_SUPPORT_REMOTE_APP_SERVER_H_
 #define BALLISTICA_BASE_INPUT_SUPPORT_REMOTE_APP_SERVER_H_
 
+#include <atomic>
+
 #include "ballistica/base/input/device/joystick_input.h"
 #include "ballistica/base/networking/networking.h"
 #include "ballistica/shared/networking/networking_sys.h"
@@ -10,7 +12,14 @@
 namespace ballistica::base {
 
 constexpr int kRemoteAppProtocolVersion = 121;
-constexpr int kMaxRemoteAppClients = 24;
+constexpr int kMaxRemoteAppClients = 64;
+
+// Values remote apps send in id requests to ask for newer state protocols
+// (and what we send back to say we support them).
+constexpr int kRemoteAppStateProtocolRequestV2 = 50;
+constexpr int kRemoteAppStateProtocolResponseV2 = 100;
+constexpr int kRemoteAppStateProtocolRequestV3 = 60;
+constexpr int kRemoteAppStateProtocolResponseV3 = 120;
 
 enum class RemoteError {
   kVersionMismatch,
@@ -31,6 +40,28 @@ enum RemoteState {
   // Second byte is d-pad h-value and third byte is d-pad v-value.
 };
 
+/// Tracks sequence numbers of a remote's incoming v3 state snapshots,
+/// deciding which ones are worth applying and when to ack.
+class RemoteAppStateSequencer {
+ public:
+  /// Forget any previous sequence (for new or reconnected remotes).
+  void Reset() { have_seq_ = false; }
+
+  /// Handle a snapshot with the provided sequence number arriving at
+  /// `now`. Returns whether it is newer than anything seen so far (and
+  /// thus should be applied). Sets `send_ack` to whether an ack carrying
+  /// seq() should go out in response.
+  auto OnState(uint32_t seq, millisecs_t now, bool* send_ack) -> bool;
+
+  /// The newest sequence number seen (which acks cover).
+  auto seq() const -> uint32_t { return seq_; }
+
+ private:
+  bool have_seq_{};
+  uint32_t seq_{};
+  millisecs_t last_ack_time_{};
+};
+
 class RemoteAppServer {
  public:
   RemoteAppServer();
@@ -40,9 +71,11 @@ class RemoteAppServer {
   void HandleData(int sd, uint8_t* data, size_t data_size,
                   struct sockaddr* from, size_t from_size);
 
+  // Apply the latest states received from v3 clients to their joysticks.
+  // Should be called in the logic thread once per step.
+  void ApplyClientStates();
+
  private:
-  auto GetClient(int request_id, struct sockaddr* addr, size_t addr_len,
-                 const char* name, bool using_v2) -> int;
   struct RemoteAppClient {
     bool in_use{};
     int request_id{};
@@ -51,15 +84,42 @@ class RemoteAppServer {
     sockaddr_storage address{};
     size_t address_size{};
     millisecs_t last_contact_time{};
+    int state_protocol{};
     uint8_t next_state_id{};
     uint32_t state{};
     JoystickInput* joystick_{};
+
+    // V3 state tracking (network-reader thread only).
+    RemoteAppStateSequencer state_sequencer;
+
+    // The most recent v3 state and when it came in. Written by the
+    // network-reader thread and read by the logic thread; no lock needed
+    // since each packet carries a full state and only the newest matters.
+    std::atomic<uint32_t> latest_state{};
+    std::atomic<microsecs_t> latest_state_time{};
+
+    // Logic thread only.
+    JoystickInput* applied_joystick{};
+    uint32_t applied_state{};
   };
+  auto GetClient(int request_id, struct sockaddr* addr, size_t addr_len,
+                 const char* name, int state_protocol) -> int;
+  void HandleStateV3_(int socket, uint8_t* buffer, size_t amt,
+                      struct sockaddr* addr, size_t addr_len);
+  void SendStateAckV3_(int socket, int client_id, struct sockaddr* addr,
+                       size_t addr_len);
+  void PushSetAppliedJoystickCall_(int client_id, JoystickInput* joystick);
+
+  // Emit events for everything that differs between two states.
+  template <typename F>
+  static void DiffStates_(uint32_t last_state, uint32_t state,
+                          F&& handle_event);
+
   RemoteAppClient clients_[kMaxRemoteAppClients]{};
+  bool registered_with_input_{};
   enum class RemoteEventType;
-  void HandleRemoteEvent(RemoteAppClient* client, RemoteEventType msg);
-  void HandleRemoteFloatEvent(RemoteAppClient* client, RemoteEventType msg,
-                              float val);
+  static auto MakeRemoteEvent_(RemoteEventType msg, float val, SDL_Event* e)
+      -> bool;
 };
 
 }  // namespace ballistica::base
@@ -12,6 +12,7 @@
 #include "ballistica/base/app_mode/app_mode.h"
 #include "ballistica/base/audio/audio.h"
 #include "ballistica/base/graphics/graphics.h"
+#include "ballistica/base/graphics/graphics_server.h"
 #include "ballistica/base/input/input.h"
 #include "ballistica/base/networking/networking.h"
 #include "ballistica/base/platform/base_platform.h"
@@ -22,6 +23,7 @@
 #include "ballistica/base/ui/dev_console.h"
 #include "ballistica/base/ui/ui.h"
 #include "ballistica/core/platform/core_platform.h"
+#include "ballistica/core/support/startup_timeline.h"
 #include "ballistica/shared/foundation/event_loop.h"
 
 namespace ballistica::base {
@@ -29,14 +31,24 @@ namespace ballistica::base {
 Logic::Logic() : display_timers_(new TimerList()) {}
 
 void Logic::OnMainThreadStartApp() {
-  // Spin up our logic thread and sit and wait for it to init.
+  // Spin up our logic thread and have it init. This runs asynchronously;
+  // use WaitForAppStart() to wait for it to finish.
   event_loop_ = new EventLoop(EventLoopID::kLogic);
   g_core->suspendable_event_loops.push_back(event_loop_);
-  event_loop_->PushCallSynchronous([this] { OnAppStart(); });
+  event_loop_->PushCall([this] { OnAppStart(); });
+}
+
+void Logic::WaitForAppStart() {
+  assert(g_core->InMainThread());
+  assert(event_loop_);
+
+  // Calls run in order, so once this one goes through our init has too.
+  event_loop_->PushCallSynchronous([] {});
 }
 
 void Logic::OnAppStart() {
   assert(g_base->InLogicThread());
+  core::StartupTimeline::ScopedPhase phase("logic-on-app-start");
   g_core->logging->Log(LogName::kBaLifecycle, LogLevel::kInfo,
                        "on-app-start begin (logic thread)");
 
@@ -355,6 +367,13 @@ void Logic::StepDisplayTime_() {
     UpdateDisplayTimeForFrameDraw_();
   }
 
+  // With late input sampling on, this is where input events get handled
+  // so they make it into this step.
+  g_base->input->DrainPendingEvents();
+
+  // Remote-app controllers speaking v3 get sampled here too.
+  g_base->input->ApplyRemoteAppStates();
+
   // Give all our subsystems some update love.
   // Note: keep these in the same order as OnAppStart.
   g_base->graphics->StepDisplayTime();
@@ -637,7 +656,10 @@ void Logic::Draw() {
 
   // Push a snapshot of our current state to be rendered in the graphics
   // thread.
+  auto build_start_time{g_core->AppTimeMicrosecs()};
   g_base->graphics->BuildAndPushFrameDef();
+  g_base->graphics_server->frame_pacer().OnFrameBuilt(
+      g_core->AppTimeMicrosecs() - build_start_time);
 
   // Now bring logic up to date. By doing this *after* fulfilling the draw
   // request, we're minimizing the chance of long logic updates leading to
@@ -650,6 +672,19 @@ void Logic::Draw() {
   StepDisplayTime_();
 }
 
+void Logic::DrawAt(microsecs_t time) {
+  assert(g_base->InLogicThread());
+
+  // Not worth scheduling a timer for tiny waits.
+  auto now{g_core->AppTimeMicrosecs()};
+  if (time - now < 500) {
+    Draw();
+    return;
+  }
+  event_loop()->NewTimer(time - now, false,
+                         NewLambdaRunnable([this] { Draw(); }).get());
+}
+
 void Logic::NotifyOfPendingAssetLoads() {
   assert(g_base->InLogicThread());
   have_pending_loads_ = true;
@@ -32,9 +32,13 @@ class Logic {
   /// not started running yet.
   auto event_loop() const -> EventLoop* { return event_loop_; }
 
-  /// Called in the main thread when the app is starting.
+  /// Called in the main thread when the app is starting. Logic-thread
+  /// init happens asynchronously.
   void OnMainThreadStartApp();
 
+  /// Block the main thread until logic-thread init has completed.
+  void WaitForAppStart();
+
   /// Called in the logic thread when the app is starting.
   void OnAppStart();
 
@@ -73,6 +77,10 @@ class Logic {
   /// graphical builds we also use this opportunity to step our logic.
   void Draw();
 
+  /// Draw() at a particular app-time (or immediately if that has passed).
+  /// Used by frame pacing to build frames as late as is safe.
+  void DrawAt(microsecs_t time);
+
   /// Kick off a low level app shutdown. Shutdown is an asynchronous process
   /// which may take up to a few seconds to complete. This is safe to call
   /// repeatedly but must be called from the logic thread.
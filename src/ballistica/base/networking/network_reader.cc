@@ -5,6 +5,7 @@
 #include <algorithm>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "ballistica/base/app_mode/app_mode.h"
@@ -286,6 +287,9 @@ auto NetworkReader::RunThread_() -> int {
             case BA_PACKET_POKE:
               break;
             case BA_PACKET_SIMPLE_PING: {
+              if (!admission_.AdmitQueryPacket(from)) {
+                break;
+              }
               // This needs to be locked during any sd changes/writes.
               std::scoped_lock lock(sd_mutex_);
               char msg[1] = {BA_PACKET_SIMPLE_PONG};
@@ -294,7 +298,7 @@ auto NetworkReader::RunThread_() -> int {
               break;
             }
             case BA_PACKET_JSON_PING: {
-              if (rresult2 > 1) {
+              if (rresult2 > 1 && admission_.AdmitQueryPacket(from)) {
                 std::vector<char> s_buffer(rresult2);
                 memcpy(s_buffer.data(), buffer + 1, rresult2 - 1);
                 s_buffer[rresult2 - 1] = 0;  // terminate string
@@ -332,6 +336,7 @@ auto NetworkReader::RunThread_() -> int {
             case BA_PACKET_REMOTE_DISCONNECT:
             case BA_PACKET_REMOTE_STATE:
             case BA_PACKET_REMOTE_STATE2:
+            case BA_PACKET_REMOTE_STATE3:
             case BA_PACKET_REMOTE_STATE_ACK:
             case BA_PACKET_REMOTE_DISCONNECT_ACK:
             case BA_PACKET_REMOTE_GAME_QUERY:
@@ -347,6 +352,8 @@ auto NetworkReader::RunThread_() -> int {
               break;
 
             case BA_PACKET_CLIENT_REQUEST:
+            case BA_PACKET_CLIENT_REQUEST_COOKIE:
+            case BA_PACKET_CLIENT_COOKIE:
             case BA_PACKET_CLIENT_ACCEPT:
             case BA_PACKET_CLIENT_DENY:
             case BA_PACKET_CLIENT_DENY_ALREADY_IN_PARTY:
@@ -359,14 +366,24 @@ auto NetworkReader::RunThread_() -> int {
             case BA_PACKET_CLIENT_GAMEPACKET_COMPRESSED:
             case BA_PACKET_HOST_GAMEPACKET_COMPRESSED: {
               // These messages are associated with udp host/client
-              // connections; pass them to the logic thread to wrangle.
+              // connections; pass them to the logic thread to wrangle
+              // (assuming they're not junk).
+              if (!admission_.AdmitConnectionPacket(
+                      sd, reinterpret_cast<uint8_t*>(buffer), &rresult2, from,
+                      from_size)) {
+                break;
+              }
               std::vector<uint8_t> msg_buffer(rresult2);
               memcpy(msg_buffer.data(), buffer, rresult2);
-              PushIncomingUDPPacketCall_(msg_buffer, SockAddr(from));
+              PushIncomingUDPPacketCall_(std::move(msg_buffer),
+                                         SockAddr(from));
               break;
             }
 
             case BA_PACKET_HOST_QUERY: {
+              if (!admission_.AdmitQueryPacket(from)) {
+                break;
+              }
               g_base->app_mode()->HandleGameQuery(buffer, rresult2, &from);
               break;
             }
@@ -388,7 +405,7 @@ auto NetworkReader::RunThread_() -> int {
   }
 }
 
-void NetworkReader::PushIncomingUDPPacketCall_(const std::vector<uint8_t>& data,
+void NetworkReader::PushIncomingUDPPacketCall_(std::vector<uint8_t>&& data,
                                                const SockAddr& addr) {
   // Avoid buffer-full errors if something is causing us to write too often;
   // these are unreliable messages so its ok to just drop them.
@@ -398,7 +415,7 @@ void NetworkReader::PushIncomingUDPPacketCall_(const std::vector<uint8_t>& data,
     return;
   }
 
-  g_base->logic->event_loop()->PushCall([data, addr] {
+  g_base->logic->event_loop()->PushCall([data{std::move(data)}, addr] {
     g_base->app_mode()->HandleIncomingUDPPacket(data, addr);
   });
 }
@@ -11,6 +11,7 @@
 #include <vector>
 
 #include "ballistica/base/base.h"
+#include "ballistica/base/networking/udp_admission.h"
 
 namespace ballistica::base {
 
@@ -32,13 +33,17 @@ class NetworkReader {
   auto sd4() const { return sd4_; }
   auto sd6() const { return sd6_; }
 
+  /// Filters incoming connection traffic before it reaches the logic
+  /// thread.
+  auto admission() -> UDPAdmission& { return admission_; }
+
  private:
   void DoSelect_(bool* can_read_4, bool* can_read_6);
   void DoPoll_(bool* can_read_4, bool* can_read_6);
   void OpenSockets_();
   void PokeSelf_();
   auto RunThread_() -> int;
-  void PushIncomingUDPPacketCall_(const std::vector<uint8_t>& data,
+  void PushIncomingUDPPacketCall_(std::vector<uint8_t>&& data,
                                   const SockAddr& addr);
   static auto RunThreadStatic_(void* self) -> int {
     return static_cast<NetworkReader*>(self)->RunThread_();
@@ -58,6 +63,7 @@ class NetworkReader {
   std::mutex paused_mutex_;
   std::condition_variable paused_cv_;
   std::unique_ptr<RemoteAppServer> remote_server_;
+  UDPAdmission admission_;
 };
 
 }  // namespace ballistica::base
@@ -33,6 +33,16 @@ namespace ballistica::base {
 #define BA_PACKET_JSON_PING 13
 #define BA_PACKET_JSON_PONG 14
 
+// Remote app protocol v3: sequenced full-state snapshots and cumulative
+// acks.
+#define BA_PACKET_REMOTE_STATE3 15
+#define BA_PACKET_REMOTE_STATE3_ACK 16
+
+// Stateless connection admission. Under load, hosts answer client requests
+// with a cookie which clients then include in their requests.
+#define BA_PACKET_CLIENT_COOKIE 17
+#define BA_PACKET_CLIENT_REQUEST_COOKIE 18
+
 // Used on android to wake our socket up so we can kill it.
 #define BA_PACKET_POKE 21
 
@@ -101,7 +111,16 @@ namespace ballistica::base {
 #define BA_MESSAGE_JMESSAGE 20
 #define BA_MESSAGE_CLIENT_PLAYER_PROFILES_JSON 21
 
+// Compact replacement for CLIENT_INFO and CLIENT_PLAYER_PROFILES_JSON; only
+// sent to hosts that advertise support for it in their handshake.
+#define BA_MESSAGE_CLIENT_INFO_BINARY 22
+
+// Compressed full-state session-commands for clients joining mid-session;
+// only sent to clients that advertise support for it in their handshake.
+#define BA_MESSAGE_SESSION_SNAPSHOT 23
+
 #define BA_JMESSAGE_SCREEN_MESSAGE 0
+#define BA_JMESSAGE_SCREEN_MESSAGES 1
 
 // Enable huffman compression for all net packets?
 #define BA_HUFFMAN_NET_COMPRESSION 1
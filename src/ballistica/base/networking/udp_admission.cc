@@ -0,0 +1,397 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/base/networking/udp_admission.h"
+
+#include <algorithm>
+#include <random>
+
+#include "ballistica/base/networking/network_reader.h"
+#include "ballistica/base/networking/networking.h"
+#include "ballistica/core/core.h"
+
+namespace ballistica::base {
+
+// Packets per second (and burst size) we allow from any one source IP.
+// Game traffic from a healthy client is well under this, with room for a
+// few of them sharing an IP behind a NAT.
+const double kUDPAdmissionSourceRate{500.0};
+const double kUDPAdmissionSourceBurst{1000.0};
+
+// When we're tracking too many sources to add more, new ones share a
+// single bucket with these limits.
+const size_t kUDPAdmissionMaxSources{4096};
+const double kUDPAdmissionOverflowRate{1000.0};
+const double kUDPAdmissionOverflowBurst{2000.0};
+
+// Connection requests per second (and burst size) we admit without
+// cookies. Legit clients send a couple per second while connecting.
+const double kUDPAdmissionRequestRate{20.0};
+const double kUDPAdmissionRequestBurst{60.0};
+
+// Cookies per second (and burst size) we send out. Requests beyond this
+// are dropped; this keeps spoofed requests from using us to flood
+// whoever they claim to be from.
+const double kUDPAdmissionCookieRate{2000.0};
+const double kUDPAdmissionCookieBurst{4000.0};
+
+// Cookies are good for the time window they were made in plus the one
+// after it.
+const millisecs_t kUDPAdmissionCookieWindow{10000};
+
+static inline auto RotL_(uint64_t x, int b) -> uint64_t {
+  return (x << b) | (x >> (64 - b));
+}
+
+// SipHash-2-4; a fast keyed hash so sources can't predict (and thus
+// forge or collide) our values.
+static auto SipHash_(const uint64_t key[2], const uint8_t* data, size_t len)
+    -> uint64_t {
+  uint64_t v0{0x736f6d6570736575ULL ^ key[0]};
+  uint64_t v1{0x646f72616e646f6dULL ^ key[1]};
+  uint64_t v2{0x6c7967656e657261ULL ^ key[0]};
+  uint64_t v3{0x7465646279746573ULL ^ key[1]};
+  auto round = [&] {
+    v0 += v1;
+    v1 = RotL_(v1, 13);
+    v1 ^= v0;
+    v0 = RotL_(v0, 32);
+    v2 += v3;
+    v3 = RotL_(v3, 16);
+    v3 ^= v2;
+    v0 += v3;
+    v3 = RotL_(v3, 21);
+    v3 ^= v0;
+    v2 += v1;
+    v1 = RotL_(v1, 17);
+    v1 ^= v2;
+    v2 = RotL_(v2, 32);
+  };
+  size_t full{len / 8 * 8};
+  for (size_t i = 0; i < full; i += 8) {
+    uint64_t m{};
+    for (int j = 0; j < 8; ++j) {
+      m |= static_cast<uint64_t>(data[i + j]) << (8 * j);
+    }
+    v3 ^= m;
+    round();
+    round();
+    v0 ^= m;
+  }
+  uint64_t last{static_cast<uint64_t>(len) << 56};
+  for (size_t j = 0; j < len - full; ++j) {
+    last |= static_cast<uint64_t>(data[full + j]) << (8 * j);
+  }
+  v3 ^= last;
+  round();
+  round();
+  v0 ^= last;
+  v2 ^= 0xff;
+  round();
+  round();
+  round();
+  round();
+  return v0 ^ v1 ^ v2 ^ v3;
+}
+
+UDPAdmission::UDPAdmission() {
+  std::random_device rd;
+  for (auto& k : key_) {
+    k = (static_cast<uint64_t>(rd()) << 32) ^ rd();
+  }
+  request_bucket_.tokens = kUDPAdmissionRequestBurst;
+  cookie_bucket_.tokens = kUDPAdmissionCookieBurst;
+  overflow_bucket_.tokens = kUDPAdmissionOverflowBurst;
+}
+
+void UDPAdmission::SetSyntheticTime(microsecs_t time) {
+  synthetic_time_ = time;
+}
+
+auto UDPAdmission::Now_() const -> microsecs_t {
+  auto time{synthetic_time_.load()};
+  return time >= 0 ? time : g_core->AppTimeMicrosecs();
+}
+
+auto UDPAdmission::DropReasonName(UDPDropReason reason) -> const char* {
+  switch (reason) {
+    case UDPDropReason::kRateLimited:
+      return "rate_limited";
+    case UDPDropReason::kMalformed:
+      return "malformed";
+    case UDPDropReason::kUnknownSource:
+      return "unknown_source";
+    case UDPDropReason::kBadCookie:
+      return "bad_cookie";
+    default:
+      return "unknown";
+  }
+}
+
+auto UDPAdmission::Drop_(UDPDropReason reason) -> bool {
+  drop_counts_[static_cast<int>(reason)]++;
+  return false;
+}
+
+void UDPAdmission::ResetStats() {
+  for (auto& count : drop_counts_) {
+    count = 0;
+  }
+  admitted_count_ = 0;
+  cookies_sent_count_ = 0;
+}
+
+auto UDPAdmission::TakeToken_(Bucket* bucket, microsecs_t now, double rate,
+                              double burst) -> bool {
+  auto elapsed{static_cast<double>(now - bucket->last_time) / 1000000.0};
+  bucket->last_time = now;
+  bucket->tokens = std::min(burst, bucket->tokens + elapsed * rate);
+  if (bucket->tokens < 1.0) {
+    return false;
+  }
+  bucket->tokens -= 1.0;
+  return true;
+}
+
+auto UDPAdmission::HashAddr_(const sockaddr_storage& from, uint64_t extra,
+                             bool include_port) const -> uint64_t {
+  uint8_t buffer[1 + 2 + 16 + 8];
+  size_t len{};
+  buffer[len++] = static_cast<uint8_t>(from.ss_family);
+  if (from.ss_family == AF_INET6) {
+    auto* addr{reinterpret_cast<const sockaddr_in6*>(&from)};
+    if (include_port) {
+      memcpy(buffer + len, &addr->sin6_port, 2);
+      len += 2;
+    }
+    memcpy(buffer + len, &addr->sin6_addr, 16);
+    len += 16;
+  } else {
+    auto* addr{reinterpret_cast<const sockaddr_in*>(&from)};
+    if (include_port) {
+      memcpy(buffer + len, &addr->sin_port, 2);
+      len += 2;
+    }
+    memcpy(buffer + len, &addr->sin_addr, 4);
+    len += 4;
+  }
+  memcpy(buffer + len, &extra, 8);
+  len += 8;
+  return SipHash_(key_, buffer, len);
+}
+
+void UDPAdmission::PruneSources_(microsecs_t now) {
+  // Anything that's been quiet long enough to have refilled its bucket is
+  // no different from a source we've never seen.
+  auto refill_time{static_cast<microsecs_t>(
+      kUDPAdmissionSourceBurst / kUDPAdmissionSourceRate * 1000000.0)};
+  for (auto i = source_buckets_.begin(); i != source_buckets_.end();) {
+    if (now - i->second.last_time >= refill_time) {
+      i = source_buckets_.erase(i);
+    } else {
+      ++i;
+    }
+  }
+  last_prune_time_ = now;
+}
+
+auto UDPAdmission::CheckSourceRate_(const sockaddr_storage& from,
+                                    microsecs_t now, bool verified) -> bool {
+  // Sources are IPs; cycling through ports gets a source nowhere.
+  auto key{HashAddr_(from, 0, false)};
+  auto i{source_buckets_.find(key)};
+  if (i != source_buckets_.end()) {
+    return TakeToken_(&i->second, now, kUDPAdmissionSourceRate,
+                      kUDPAdmissionSourceBurst);
+  }
+
+  // Don't let a flood of made-up sources grow our table without bound
+  // (or have us sweep it for every packet).
+  if (source_buckets_.size() >= kUDPAdmissionMaxSources
+      && now - last_prune_time_ > 1000000) {
+    PruneSources_(now);
+  }
+  // Verified sources (known peers or ones that echoed a cookie) can't be
+  // made up, so they always get a bucket of their own; only unverified
+  // ones have to share when we're full.
+  if (!verified && source_buckets_.size() >= kUDPAdmissionMaxSources) {
+    return TakeToken_(&overflow_bucket_, now, kUDPAdmissionOverflowRate,
+                      kUDPAdmissionOverflowBurst);
+  }
+  auto& bucket{source_buckets_[key]};
+  bucket.tokens = kUDPAdmissionSourceBurst;
+  bucket.last_time = now;
+  return TakeToken_(&bucket, now, kUDPAdmissionSourceRate,
+                    kUDPAdmissionSourceBurst);
+}
+
+auto UDPAdmission::MakeCookie_(const sockaddr_storage& from,
+                               int64_t window) const -> uint64_t {
+  return HashAddr_(from, static_cast<uint64_t>(window), true);
+}
+
+auto UDPAdmission::CurrentCookie(const sockaddr_storage& from) const
+    -> uint64_t {
+  return MakeCookie_(from, Now_() / 1000 / kUDPAdmissionCookieWindow);
+}
+
+auto UDPAdmission::CookieValid_(const sockaddr_storage& from, uint64_t cookie,
+                                microsecs_t now) const -> bool {
+  auto window{now / 1000 / kUDPAdmissionCookieWindow};
+  return cookie == MakeCookie_(from, window)
+         || cookie == MakeCookie_(from, window - 1);
+}
+
+void UDPAdmission::SendCookie_(int sd, uint8_t request_id,
+                               const sockaddr_storage& from,
+                               socklen_t from_size, microsecs_t now) {
+  auto cookie{MakeCookie_(from, now / 1000 / kUDPAdmissionCookieWindow)};
+  uint8_t msg[10];
+  msg[0] = BA_PACKET_CLIENT_COOKIE;
+  msg[1] = request_id;
+  memcpy(msg + 2, &cookie, sizeof(cookie));
+  cookies_sent_count_++;
+  if (sd == -1) {
+    return;
+  }
+
+  // This needs to be locked during any sd changes/writes.
+  std::scoped_lock lock(g_base->network_reader->sd_mutex());
+  sendto(sd, reinterpret_cast<char*>(msg), sizeof(msg), 0,
+         reinterpret_cast<const sockaddr*>(&from), from_size);
+}
+
+auto UDPAdmission::IsKnownClient_(int client_id, const sockaddr_storage& from)
+    -> bool {
+  std::scoped_lock lock(peers_mutex_);
+  auto& addr{client_addrs_[client_id]};
+  return addr && *addr == SockAddr(from);
+}
+
+auto UDPAdmission::IsKnownHost_(const sockaddr_storage& from) -> bool {
+  std::scoped_lock lock(peers_mutex_);
+  return host_addr_ && *host_addr_ == SockAddr(from);
+}
+
+auto UDPAdmission::AdmitQueryPacket(const sockaddr_storage& from) -> bool {
+  if (!CheckSourceRate_(from, Now_(), false)) {
+    return Drop_(UDPDropReason::kRateLimited);
+  }
+  return true;
+}
+
+auto UDPAdmission::AdmitConnectionPacket(int sd, uint8_t* data, size_t* size,
+                                         const sockaddr_storage& from,
+                                         socklen_t from_size) -> bool {
+  // Note that we check whatever we can about where a packet came from
+  // before rate-limiting it by source, so sources that can be forged
+  // never get the chance to crowd out ones that can't.
+  auto now{Now_()};
+  size_t amt{*size};
+  switch (data[0]) {
+    case BA_PACKET_CLIENT_REQUEST: {
+      // Protocol version (2 bytes), request id, and session id.
+      if (amt <= 4) {
+        return Drop_(UDPDropReason::kMalformed);
+      }
+
+      // Let requests straight through unless they're flooding in; then we
+      // make everyone prove they can hear us. These are limited globally
+      // instead of per-source; sources here are as likely as not forged.
+      if (!TakeToken_(&request_bucket_, now, kUDPAdmissionRequestRate,
+                      kUDPAdmissionRequestBurst)) {
+        if (!TakeToken_(&cookie_bucket_, now, kUDPAdmissionCookieRate,
+                        kUDPAdmissionCookieBurst)) {
+          return Drop_(UDPDropReason::kRateLimited);
+        }
+        SendCookie_(sd, data[3], from, from_size, now);
+        return false;
+      }
+      break;
+    }
+    case BA_PACKET_CLIENT_REQUEST_COOKIE: {
+      // A regular request with the cookie we gave them stuck on the front.
+      if (amt <= 12) {
+        return Drop_(UDPDropReason::kMalformed);
+      }
+      uint64_t cookie;
+      memcpy(&cookie, data + 1, sizeof(cookie));
+      if (!CookieValid_(from, cookie, now)) {
+        return Drop_(UDPDropReason::kBadCookie);
+      }
+      if (!CheckSourceRate_(from, now, true)) {
+        return Drop_(UDPDropReason::kRateLimited);
+      }
+
+      // Strip the cookie so the logic thread sees a regular request.
+      data[8] = BA_PACKET_CLIENT_REQUEST;
+      memmove(data, data + 8, amt - 8);
+      *size = amt - 8;
+      break;
+    }
+    case BA_PACKET_CLIENT_GAMEPACKET_COMPRESSED:
+    case BA_PACKET_DISCONNECT_FROM_CLIENT_REQUEST: {
+      if (amt < 2
+          || (data[0] == BA_PACKET_CLIENT_GAMEPACKET_COMPRESSED && amt == 2)) {
+        return Drop_(UDPDropReason::kMalformed);
+      }
+      if (!IsKnownClient_(data[1], from)) {
+        return Drop_(UDPDropReason::kUnknownSource);
+      }
+      if (!CheckSourceRate_(from, now, true)) {
+        return Drop_(UDPDropReason::kRateLimited);
+      }
+      break;
+    }
+    case BA_PACKET_DISCONNECT_FROM_HOST_ACK:
+      // Clients send these once they're gone; nothing left for us to do.
+      return false;
+    case BA_PACKET_DISCONNECT_FROM_HOST_REQUEST:
+      // We ack these even with no host connection so hosts can wrap up
+      // connections we've already given up on.
+      if (!CheckSourceRate_(from, now, false)) {
+        return Drop_(UDPDropReason::kRateLimited);
+      }
+      break;
+    default: {
+      // Everything else is a host talking to us as a client.
+      if (!IsKnownHost_(from)) {
+        return Drop_(UDPDropReason::kUnknownSource);
+      }
+      if (!CheckSourceRate_(from, now, true)) {
+        return Drop_(UDPDropReason::kRateLimited);
+      }
+      break;
+    }
+  }
+  admitted_count_++;
+  return true;
+}
+
+void UDPAdmission::SetClientAddr(int client_id, const SockAddr& addr) {
+  assert(client_id >= 0 && client_id < 256);
+  std::scoped_lock lock(peers_mutex_);
+  client_addrs_[client_id] = addr;
+}
+
+void UDPAdmission::ClearClientAddr(int client_id, const SockAddr& addr) {
+  assert(client_id >= 0 && client_id < 256);
+  std::scoped_lock lock(peers_mutex_);
+  auto& registered{client_addrs_[client_id]};
+  if (registered && *registered == addr) {
+    registered.reset();
+  }
+}
+
+void UDPAdmission::SetHostAddr(const SockAddr& addr) {
+  std::scoped_lock lock(peers_mutex_);
+  host_addr_ = addr;
+}
+
+void UDPAdmission::ClearHostAddr(const SockAddr& addr) {
+  std::scoped_lock lock(peers_mutex_);
+  if (host_addr_ && *host_addr_ == addr) {
+    host_addr_.reset();
+  }
+}
+
+}  // namespace ballistica::base
@@ -0,0 +1,143 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_BASE_NETWORKING_UDP_ADMISSION_H_
+#define BALLISTICA_BASE_NETWORKING_UDP_ADMISSION_H_
+
+#include <atomic>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+#include "ballistica/base/base.h"
+#include "ballistica/shared/networking/sockaddr.h"
+
+namespace ballistica::base {
+
+/// Why the network reader threw away a packet.
+enum class UDPDropReason {
+  /// Its source was sending faster than we allow.
+  kRateLimited,
+  /// Its size or contents didn't make sense for its type.
+  kMalformed,
+  /// It was aimed at a connection that doesn't exist (or came from an
+  /// address other than the connection's).
+  kUnknownSource,
+  /// It was a connection request with a missing, stale, or forged cookie
+  /// while we were requiring them.
+  kBadCookie,
+  kLast  // Sentinel.
+};
+
+/// Decides which incoming udp connection packets are worth handing to the
+/// logic thread.
+///
+/// This runs in the network-reader thread and does its work before any
+/// allocation or logic-thread calls happen, so junk traffic costs us as
+/// little as possible. It does three things:
+///
+/// - Drops client/host packets that don't belong to a connection we
+///   know about. The logic thread keeps us informed of connections as
+///   they come and go.
+/// - Rate-limits each source IP (all ports together) with a token
+///   bucket. Packets that must come from a known peer or carry a valid
+///   cookie are checked for that first, so forged traffic can't crowd
+///   real peers out of the source table.
+/// - Admits connection requests statelessly when they are flooding in.
+///   Normally requests pass straight through (subject to a global rate
+///   rather than per-source ones), but once they exceed that rate we
+///   answer them with a cookie (a keyed hash of the source address and
+///   current time window) and only admit requests that echo back a valid
+///   one. Spoofed sources never see their cookie so they never get past
+///   this point, and we store nothing for them. Cookie replies have
+///   their own global rate limit so we can't be used to flood others.
+///
+/// Drop counts are kept for diagnostics. Admission calls must come from
+/// the network-reader thread; everything else is safe from any thread.
+class UDPAdmission {
+ public:
+  UDPAdmission();
+
+  /// Whether a host/client connection packet should be passed on to the
+  /// logic thread. Cookie requests that check out get rewritten in place
+  /// into regular requests (`size` is updated). May send cookies out on
+  /// `sd`.
+  auto AdmitConnectionPacket(int sd, uint8_t* data, size_t* size,
+                             const sockaddr_storage& from, socklen_t from_size)
+      -> bool;
+
+  /// Whether a simple query/ping packet from a source should be answered.
+  auto AdmitQueryPacket(const sockaddr_storage& from) -> bool;
+
+  /// The cookie a source would be sent right now.
+  auto CurrentCookie(const sockaddr_storage& from) const -> uint64_t;
+
+  /// Use the provided time instead of the current app-time (for testing).
+  /// Pass -1 to go back to app-time. An `sd` of -1 passed to
+  /// AdmitConnectionPacket() can also be handy for testing; cookies then
+  /// get counted but not actually sent.
+  void SetSyntheticTime(microsecs_t time);
+
+  /// Let us know about a udp client connection coming or going. Clearing
+  /// only happens if `addr` still matches what is registered for the id.
+  void SetClientAddr(int client_id, const SockAddr& addr);
+  void ClearClientAddr(int client_id, const SockAddr& addr);
+
+  /// Same for our udp connection to a host.
+  void SetHostAddr(const SockAddr& addr);
+  void ClearHostAddr(const SockAddr& addr);
+
+  static auto DropReasonName(UDPDropReason reason) -> const char*;
+  auto drop_count(UDPDropReason reason) const -> int64_t {
+    return drop_counts_[static_cast<int>(reason)];
+  }
+  auto admitted_count() const -> int64_t { return admitted_count_; }
+  auto cookies_sent_count() const -> int64_t { return cookies_sent_count_; }
+  void ResetStats();
+
+ private:
+  struct Bucket {
+    double tokens{};
+    microsecs_t last_time{};
+  };
+  auto Now_() const -> microsecs_t;
+  auto Drop_(UDPDropReason reason) -> bool;
+  auto CheckSourceRate_(const sockaddr_storage& from, microsecs_t now,
+                        bool verified) -> bool;
+  void PruneSources_(microsecs_t now);
+  static auto TakeToken_(Bucket* bucket, microsecs_t now, double rate,
+                         double burst) -> bool;
+  auto HashAddr_(const sockaddr_storage& from, uint64_t extra,
+                 bool include_port) const -> uint64_t;
+  auto MakeCookie_(const sockaddr_storage& from, int64_t window) const
+      -> uint64_t;
+  auto CookieValid_(const sockaddr_storage& from, uint64_t cookie,
+                    microsecs_t now) const -> bool;
+  void SendCookie_(int sd, uint8_t request_id, const sockaddr_storage& from,
+                   socklen_t from_size, microsecs_t now);
+  auto IsKnownClient_(int client_id, const sockaddr_storage& from) -> bool;
+  auto IsKnownHost_(const sockaddr_storage& from) -> bool;
+
+  // Secret key for source hashes and cookies; randomized at launch.
+  uint64_t key_[2]{};
+
+  // Network-reader thread only.
+  std::unordered_map<uint64_t, Bucket> source_buckets_;
+  Bucket overflow_bucket_;
+  Bucket request_bucket_;
+  Bucket cookie_bucket_;
+  microsecs_t last_prune_time_{};
+  std::atomic<microsecs_t> synthetic_time_{-1};
+
+  // Connections we know about (set from the logic thread).
+  std::mutex peers_mutex_;
+  std::optional<SockAddr> client_addrs_[256];
+  std::optional<SockAddr> host_addr_;
+
+  std::atomic<int64_t> drop_counts_[static_cast<int>(UDPDropReason::kLast)]{};
+  std::atomic<int64_t> admitted_count_{};
+  std::atomic<int64_t> cookies_sent_count_{};
+};
+
+}  // namespace ballistica::base
+
+#endif  // BALLISTICA_BASE_NETWORKING_UDP_ADMISSION_H_
@@ -2,8 +2,11 @@
 
 #include "ballistica/base/python/methods/python_methods_base_1.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <list>
+#include <optional>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -15,10 +18,12 @@
 #include "ballistica/base/logic/logic.h"
 #include "ballistica/base/python/base_python.h"
 #include "ballistica/base/python/support/python_context_call_runnable.h"
+#include "ballistica/base/support/step_profiler.h"
 #include "ballistica/base/ui/dev_console.h"
 #include "ballistica/base/ui/ui.h"
 #include "ballistica/core/logging/logging.h"
 #include "ballistica/core/platform/core_platform.h"
+#include "ballistica/core/support/startup_timeline.h"
 #include "ballistica/shared/foundation/event_loop.h"
 #include "ballistica/shared/python/python.h"
 #include "ballistica/shared/python/python_command.h"
@@ -1894,6 +1899,384 @@ static PyMethodDef PyGraphicsShutdownIsCompleteDef = {
     ":meta private:\n",
 };
 
+// -------------------------- startup_phase_begin ------------------------------
+
+static auto PyStartupPhaseBegin(PyObject* self, PyObject* args,
+                                PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  const char* name;
+  static const char* kwlist[] = {"name", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "s",
+                                   const_cast<char**>(kwlist), &name)) {
+    return nullptr;
+  }
+  g_core->startup_timeline->BeginPhase(name);
+  Py_RETURN_NONE;
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyStartupPhaseBeginDef = {
+    "startup_phase_begin",             // name
+    (PyCFunction)PyStartupPhaseBegin,  // method
+    METH_VARARGS | METH_KEYWORDS,      // flags
+
+    "startup_phase_begin(name: str) -> None\n"
+    "\n"
+    "Begin a named phase in the app's startup timeline.\n"
+    "\n"
+    ":meta private:",
+};
+
+// --------------------------- startup_phase_end -------------------------------
+
+static auto PyStartupPhaseEnd(PyObject* self, PyObject* args,
+                              PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  const char* name;
+  static const char* kwlist[] = {"name", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "s",
+                                   const_cast<char**>(kwlist), &name)) {
+    return nullptr;
+  }
+  g_core->startup_timeline->EndPhase(name);
+  Py_RETURN_NONE;
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyStartupPhaseEndDef = {
+    "startup_phase_end",             // name
+    (PyCFunction)PyStartupPhaseEnd,  // method
+    METH_VARARGS | METH_KEYWORDS,    // flags
+
+    "startup_phase_end(name: str) -> None\n"
+    "\n"
+    "End a named phase in the app's startup timeline.\n"
+    "\n"
+    ":meta private:",
+};
+
+// --------------------------- startup_phases_add ------------------------------
+
+static auto PyStartupPhasesAdd(PyObject* self, PyObject* args,
+                               PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  PyObject* phases_obj;
+  double clock_now;
+  static const char* kwlist[] = {"phases", "clock_now", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "Od",
+                                   const_cast<char**>(kwlist), &phases_obj,
+                                   &clock_now)) {
+    return nullptr;
+  }
+  auto* timeline{g_core->startup_timeline};
+
+  // Phases come in on some other clock; line it up with ours using the
+  // caller's idea of now.
+  auto now{core::CorePlatform::TimeMonotonicMicrosecs()};
+  auto to_ours = [now, clock_now](double t) {
+    return now - static_cast<microsecs_t>((clock_now - t) * 1000000.0);
+  };
+  PythonRef phases_seq{
+      PySequence_Fast(phases_obj, "Expected a sequence of phases."),
+      PythonRef::kSteal};
+  if (!phases_seq.exists()) {
+    return nullptr;
+  }
+  for (Py_ssize_t i = 0; i < PySequence_Fast_GET_SIZE(phases_seq.get());
+       ++i) {
+    const char* name;
+    const char* thread_name;
+    double start;
+    double end;
+    if (!PyArg_ParseTuple(PySequence_Fast_GET_ITEM(phases_seq.get(), i),
+                          "ssdd", &name, &thread_name, &start, &end)) {
+      return nullptr;
+    }
+    if (end < start) {
+      throw Exception("Phase end can't be before its start.",
+                      PyExcType::kValue);
+    }
+    // Anything from before our current origin belongs to a previous run
+    // (such as a prefork parent's imports as seen by a worker).
+    auto start_ours{to_ours(start)};
+    if (start_ours < timeline->origin()) {
+      continue;
+    }
+    timeline->AddPhase(name, start_ours, std::max(start_ours, to_ours(end)),
+                       thread_name);
+  }
+  Py_RETURN_NONE;
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyStartupPhasesAddDef = {
+    "startup_phases_add",             // name
+    (PyCFunction)PyStartupPhasesAdd,  // method
+    METH_VARARGS | METH_KEYWORDS,     // flags
+
+    "startup_phases_add(phases: Sequence[tuple[str, str, float, float]],\n"
+    "  clock_now: float) -> None\n"
+    "\n"
+    "Add completed phases to the app's startup timeline.\n"
+    "\n"
+    "Each phase is a name, thread name, start time and end time in seconds\n"
+    "on some monotonic clock; clock_now is the current time on that same\n"
+    "clock.\n"
+    "\n"
+    ":meta private:",
+};
+
+// ----------------------------- startup_phases --------------------------------
+
+static auto PyStartupPhases(PyObject* self) -> PyObject* {
+  BA_PYTHON_TRY;
+  auto* timeline{g_core->startup_timeline};
+  auto origin{timeline->origin()};
+  auto phases{timeline->GetPhases()};
+  auto list{PythonRef::Stolen(PyList_New(0))};
+  for (auto&& phase : phases) {
+    auto start{static_cast<double>(phase.start - origin) / 1000000.0};
+    auto entry{PythonRef::Stolen(
+        phase.end == -1
+            ? Py_BuildValue("(ssdO)", phase.name.c_str(),
+                            phase.thread_name.c_str(), start, Py_None)
+            : Py_BuildValue(
+                  "(ssdd)", phase.name.c_str(), phase.thread_name.c_str(),
+                  start,
+                  static_cast<double>(phase.end - origin) / 1000000.0))};
+    PyList_Append(list.get(), entry.get());
+  }
+  return list.HandOver();
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyStartupPhasesDef = {
+    "startup_phases",              // name
+    (PyCFunction)PyStartupPhases,  // method
+    METH_NOARGS,                   // flags
+
+    "startup_phases() -> list[tuple[str, str, float, float | None]]\n"
+    "\n"
+    "Return recorded app startup phases.\n"
+    "\n"
+    "Each entry is a name, thread name, start time and end time (or None\n"
+    "if still running), with times in seconds since startup began.\n"
+    "\n"
+    ":meta private:",
+};
+
+// ----------------------------- startup_report --------------------------------
+
+static auto PyStartupReport(PyObject* self) -> PyObject* {
+  BA_PYTHON_TRY;
+  return PyUnicode_FromString(g_core->startup_timeline->GetReport().c_str());
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyStartupReportDef = {
+    "startup_report",              // name
+    (PyCFunction)PyStartupReport,  // method
+    METH_NOARGS,                   // flags
+
+    "startup_report() -> str\n"
+    "\n"
+    "Return a human readable breakdown of where app startup time went.\n"
+    "\n"
+    ":meta private:",
+};
+
+// ----------------------------- mark_app_ready --------------------------------
+
+static auto PyMarkAppReady(PyObject* self, PyObject* args, PyObject* keywds)
+    -> PyObject* {
+  BA_PYTHON_TRY;
+  const char* label;
+  static const char* kwlist[] = {"label", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "s",
+                                   const_cast<char**>(kwlist), &label)) {
+    return nullptr;
+  }
+  return PyFloat_FromDouble(g_core->startup_timeline->MarkReady(label));
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyMarkAppReadyDef = {
+    "mark_app_ready",              // name
+    (PyCFunction)PyMarkAppReady,   // method
+    METH_VARARGS | METH_KEYWORDS,  // flags
+
+    "mark_app_ready(label: str) -> float\n"
+    "\n"
+    "Note that the app is ready to do its job.\n"
+    "\n"
+    "Gui builds do this automatically when drawing their first frame and\n"
+    "servers do it once they are hosting. Only the first call has an\n"
+    "effect. Returns seconds elapsed between startup and becoming ready.\n"
+    "\n"
+    ":meta private:",
+};
+
+// ----------------------------- app_ready_time --------------------------------
+
+static auto PyAppReadyTime(PyObject* self) -> PyObject* {
+  BA_PYTHON_TRY;
+  auto seconds{g_core->startup_timeline->ReadySeconds()};
+  if (seconds < 0.0) {
+    Py_RETURN_NONE;
+  }
+  return PyFloat_FromDouble(seconds);
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyAppReadyTimeDef = {
+    "app_ready_time",             // name
+    (PyCFunction)PyAppReadyTime,  // method
+    METH_NOARGS,                  // flags
+
+    "app_ready_time() -> float | None\n"
+    "\n"
+    "Return seconds between startup and the app becoming ready, or None\n"
+    "if it is not yet ready.\n"
+    "\n"
+    ":meta private:",
+};
+
+// --------------------------- step_profile_start ------------------------------
+
+static auto PyStepProfileStart(PyObject* self, PyObject* args,
+                               PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  int interval{1};
+  static const char* kwlist[] = {"interval", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "|i",
+                                   const_cast<char**>(kwlist), &interval)) {
+    return nullptr;
+  }
+  if (interval < 1) {
+    throw Exception("interval must be at least 1.", PyExcType::kValue);
+  }
+  BA_PRECONDITION(g_base->InLogicThread());
+  g_base->step_profiler->Start(interval);
+  Py_RETURN_NONE;
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyStepProfileStartDef = {
+    "step_profile_start",             // name
+    (PyCFunction)PyStepProfileStart,  // method
+    METH_VARARGS | METH_KEYWORDS,     // flags
+
+    "step_profile_start(interval: int = 1) -> None\n"
+    "\n"
+    "Start profiling where logic time goes.\n"
+    "\n"
+    "One of every ``interval`` session updates is sampled, and its time\n"
+    "is attributed to scene steps, node types (stepping and attr\n"
+    "connections), material actions, Python calls (timers, collision\n"
+    "and input calls) and handlemessage() calls. Python entries are\n"
+    "listed by qualname and file:line. Clears any previous results.\n"
+    "\n"
+    ":meta private:",
+};
+
+// ---------------------------- step_profile_stop ------------------------------
+
+static auto PyStepProfileStop(PyObject* self) -> PyObject* {
+  BA_PYTHON_TRY;
+  BA_PRECONDITION(g_base->InLogicThread());
+  g_base->step_profiler->Stop();
+  Py_RETURN_NONE;
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyStepProfileStopDef = {
+    "step_profile_stop",             // name
+    (PyCFunction)PyStepProfileStop,  // method
+    METH_NOARGS,                     // flags
+
+    "step_profile_stop() -> None\n"
+    "\n"
+    "Stop profiling; results stay available until the next start.\n"
+    "\n"
+    ":meta private:",
+};
+
+// --------------------------- step_profile_entries ----------------------------
+
+auto PythonMethodsBase1::StepProfileEntriesToPython(
+    const StepProfiler& profiler) -> PythonRef {
+  auto entries{profiler.GetEntries()};
+  PythonRef list{PyList_New(static_cast<Py_ssize_t>(entries.size())),
+                 PythonRef::kSteal};
+  for (size_t i = 0; i < entries.size(); ++i) {
+    auto& entry{entries[i]};
+    PyObject* item{Py_BuildValue(
+        "{sssssLsdsd}", "category", StepProfiler::CategoryName(entry.category),
+        "name", entry.name.c_str(), "count",
+        static_cast<long long>(entry.count),  // NOLINT
+        "total", static_cast<double>(entry.total) / 1000000.0, "max",
+        static_cast<double>(entry.max) / 1000000.0)};
+    if (!item) {
+      throw Exception();
+    }
+    PyList_SET_ITEM(list.get(), static_cast<Py_ssize_t>(i), item);
+  }
+  return list;
+}
+
+static auto PyStepProfileEntries(PyObject* self) -> PyObject* {
+  BA_PYTHON_TRY;
+  BA_PRECONDITION(g_base->InLogicThread());
+  return PythonMethodsBase1::StepProfileEntriesToPython(
+             *g_base->step_profiler)
+      .HandOver();
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyStepProfileEntriesDef = {
+    "step_profile_entries",             // name
+    (PyCFunction)PyStepProfileEntries,  // method
+    METH_NOARGS,                        // flags
+
+    "step_profile_entries() -> list[dict[str, Any]]\n"
+    "\n"
+    "Return collected profile entries, most total time first.\n"
+    "\n"
+    "Each is a dict with 'category', 'name', 'count', and 'total' and\n"
+    "'max' times in seconds.\n"
+    "\n"
+    ":meta private:",
+};
+
+// --------------------------- step_profile_report -----------------------------
+
+static auto PyStepProfileReport(PyObject* self, PyObject* args,
+                                PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  int max_entries{30};
+  static const char* kwlist[] = {"max_entries", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "|i",
+                                   const_cast<char**>(kwlist), &max_entries)) {
+    return nullptr;
+  }
+  BA_PRECONDITION(g_base->InLogicThread());
+  return PyUnicode_FromString(
+      g_base->step_profiler->GetReport(max_entries).c_str());
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyStepProfileReportDef = {
+    "step_profile_report",             // name
+    (PyCFunction)PyStepProfileReport,  // method
+    METH_VARARGS | METH_KEYWORDS,      // flags
+
+    "step_profile_report(max_entries: int = 30) -> str\n"
+    "\n"
+    "Return a human readable table of the top profile entries.\n"
+    "\n"
+    ":meta private:",
+};
+
 // -----------------------------------------------------------------------------
 
 auto PythonMethodsBase1::GetMethods() -> std::vector<PyMethodDef> {
@@ -1961,6 +2344,17 @@ auto PythonMethodsBase1::GetMethods() -> std::vector<PyMethodDef> {
       PyAudioShutdownIsCompleteDef,
       PyGraphicsShutdownBeginDef,
       PyGraphicsShutdownIsCompleteDef,
+      PyStartupPhaseBeginDef,
+      PyStartupPhaseEndDef,
+      PyStartupPhasesAddDef,
+      PyStartupPhasesDef,
+      PyStartupReportDef,
+      PyMarkAppReadyDef,
+      PyAppReadyTimeDef,
+      PyStepProfileStartDef,
+      PyStepProfileStopDef,
+      PyStepProfileEntriesDef,
+      PyStepProfileReportDef,
   };
 }
 
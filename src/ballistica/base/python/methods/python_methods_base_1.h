@@ -5,7 +5,7 @@
 
 #include <vector>
 
-#include "ballistica/shared/ballistica.h"
+#include "ballistica/base/base.h"
 
 namespace ballistica::base {
 
@@ -13,6 +13,10 @@ namespace ballistica::base {
 class PythonMethodsBase1 {
  public:
   static auto GetMethods() -> std::vector<PyMethodDef>;
+
+  /// Build the entry list step_profile_entries() returns for a profiler.
+  static auto StepProfileEntriesToPython(const StepProfiler& profiler)
+      -> PythonRef;
 };
 
 }  // namespace ballistica::base
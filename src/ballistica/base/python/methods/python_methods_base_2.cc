@@ -7,6 +7,7 @@
 
 #include "ballistica/base/app_adapter/app_adapter.h"
 #include "ballistica/base/assets/assets.h"
+#include "ballistica/base/assets/mesh_asset_preload_data.h"
 #include "ballistica/base/graphics/graphics.h"
 #include "ballistica/base/graphics/support/camera.h"
 #include "ballistica/base/graphics/support/screen_messages.h"
@@ -1082,6 +1083,82 @@ static PyMethodDef PyAtExitDef = {
     "should still be used on modular builds as this function is not available\n"
     "there."};
 
+// -------------------------- mesh_load_benchmark ------------------------------
+
+static auto PyMeshLoadBenchmark(PyObject* self, PyObject* args,
+                                PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  PyObject* paths_obj;
+  int iterations{1};
+  int mapped{1};
+  static const char* kwlist[] = {"paths", "iterations", "mapped", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "O|ip",
+                                   const_cast<char**>(kwlist), &paths_obj,
+                                   &iterations, &mapped)) {
+    return nullptr;
+  }
+  if (iterations < 1) {
+    throw Exception("iterations must be positive.", PyExcType::kValue);
+  }
+  auto paths{Python::GetStrings(paths_obj)};
+
+  int64_t byte_count{};
+  int mapped_count{};
+  uint64_t checksum{};
+  auto start_time{core::CorePlatform::TimeMonotonicMicrosecs()};
+  for (int i = 0; i < iterations; ++i) {
+    for (auto&& path : paths) {
+      MeshAssetPreloadData data;
+      data.Load(path, mapped);
+
+      // Touch everything an upload would so mapped pages actually get
+      // faulted in and the comparison with buffered reads is fair.
+      auto* vertices{reinterpret_cast<const uint8_t*>(data.vertices())};
+      size_t vertex_bytes{data.vertex_count() * sizeof(VertexObjectFull)};
+      auto* indices{static_cast<const uint8_t*>(data.indices())};
+      size_t index_bytes{static_cast<size_t>(data.index_count())
+                         * data.index_size()};
+      for (size_t j = 0; j < vertex_bytes; ++j) {
+        checksum += vertices[j];
+      }
+      for (size_t j = 0; j < index_bytes; ++j) {
+        checksum += indices[j];
+      }
+      byte_count += static_cast<int64_t>(data.data_size());
+      if (data.mapped()) {
+        mapped_count++;
+      }
+    }
+  }
+  auto duration{core::CorePlatform::TimeMonotonicMicrosecs() - start_time};
+  return Py_BuildValue("{s:i,s:L,s:i,s:d,s:K}", "files",
+                       static_cast<int>(paths.size()) * iterations, "bytes",
+                       static_cast<long long>(byte_count),  // NOLINT
+                       "mapped_files", mapped_count, "seconds",
+                       static_cast<double>(duration) / 1000000.0, "checksum",
+                       static_cast<unsigned long long>(checksum));  // NOLINT
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyMeshLoadBenchmarkDef = {
+    "mesh_load_benchmark",             // name
+    (PyCFunction)PyMeshLoadBenchmark,  // method
+    METH_VARARGS | METH_KEYWORDS,      // flags
+
+    "mesh_load_benchmark(paths: Sequence[str], iterations: int = 1,\n"
+    "  mapped: bool = True) -> dict[str, Any]\n"
+    "\n"
+    "Time loading the provided bob mesh files the way mesh assets do.\n"
+    "\n"
+    "Returns a dict with 'files', 'bytes', 'mapped_files', 'seconds' and\n"
+    "'checksum' entries. Pass mapped=False to force plain file reads; the\n"
+    "checksum should match either way.\n"
+    "\n"
+    ":meta private:",
+};
+
+// -----------------------------------------------------------------------------
+
 auto PythonMethodsBase2::GetMethods() -> std::vector<PyMethodDef> {
   return {
       PyOpenURLDef,
@@ -1118,6 +1195,7 @@ auto PythonMethodsBase2::GetMethods() -> std::vector<PyMethodDef> {
       PyGetVirtualScreenSizeDef,
       PyGetVirtualSafeAreaSizeDef,
       PyAtExitDef,
+      PyMeshLoadBenchmarkDef,
   };
 }
 
@@ -5,14 +5,18 @@
 #include <list>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "ballistica/base/app_adapter/app_adapter.h"
 #include "ballistica/base/app_mode/app_mode.h"
 #include "ballistica/base/assets/sound_asset.h"
+#include "ballistica/base/dynamics/bg/bg_dynamics_server.h"
 #include "ballistica/base/graphics/graphics.h"
+#include "ballistica/base/graphics/renderer/renderer_validating.h"
 #include "ballistica/base/input/input.h"
 #include "ballistica/base/logic/logic.h"
+#include "ballistica/base/networking/network_reader.h"
 #include "ballistica/base/platform/base_platform.h"
 #include "ballistica/base/python/base_python.h"
 #include "ballistica/base/python/class/python_class_simple_sound.h"
@@ -2092,6 +2096,279 @@ static PyMethodDef PyUpdateInternalLoggerLevelsDef = {
     "is properly reflected in logs originating from the native layer.\n"
     "\n"
     ":meta private:"};
+
+// -------------------------- input_latency_stats ------------------------------
+
+auto PythonMoethodsBase3::InputLatencyStatsToPython(
+    const InputLatency& latency) -> PythonRef {
+  auto result{PythonRef::Stolen(PyDict_New())};
+  for (int i = 0; i < static_cast<int>(InputLatencyStage::kLast); ++i) {
+    auto stage{static_cast<InputLatencyStage>(i)};
+    auto stats{latency.GetStats(stage)};
+    auto entry{PythonRef::Stolen(Py_BuildValue(
+        "{s:i,s:d,s:d,s:d,s:d}", "count", stats.count, "mean_ms",
+        stats.mean_ms, "p50_ms", stats.p50_ms, "p95_ms", stats.p95_ms,
+        "max_ms", stats.max_ms))};
+    PyDict_SetItemString(result.get(), InputLatency::StageName(stage),
+                         entry.get());
+  }
+  return result;
+}
+
+static auto PyInputLatencyStats(PyObject* self, PyObject* args,
+                                PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  int reset{};
+  static const char* kwlist[] = {"reset", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "|p",
+                                   const_cast<char**>(kwlist), &reset)) {
+    return nullptr;
+  }
+  auto& latency{g_base->input->latency()};
+  auto result{PythonMoethodsBase3::InputLatencyStatsToPython(latency)};
+  if (reset) {
+    latency.Reset();
+  }
+  return result.HandOver();
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyInputLatencyStatsDef = {
+    "input_latency_stats",             // name
+    (PyCFunction)PyInputLatencyStats,  // method
+    METH_VARARGS | METH_KEYWORDS,      // flags
+
+    "input_latency_stats(reset: bool = False)\n"
+    "  -> dict[str, dict[str, float]]\n"
+    "\n"
+    "Return how long input events have been taking to have effects.\n"
+    "\n"
+    "Keys are stages: 'dispatch' (reaching the logic thread), 'sim'\n"
+    "(applied in a sim step), 'frame' (included in a built frame),\n"
+    "'present' (on screen), and 'network' (sent to a host). Each value\n"
+    "has a total 'count' plus 'mean_ms', 'p50_ms', 'p95_ms', and 'max_ms'\n"
+    "over recent samples. Pass reset=True to start fresh after reading;\n"
+    "handy for comparing numbers before and after a change.\n"
+    "\n"
+    ":meta private:",
+};
+
+// -------------------------- udp_admission_stats ------------------------------
+
+static auto PyUDPAdmissionStats(PyObject* self, PyObject* args,
+                                PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  int reset{};
+  static const char* kwlist[] = {"reset", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "|p",
+                                   const_cast<char**>(kwlist), &reset)) {
+    return nullptr;
+  }
+  auto& admission{g_base->network_reader->admission()};
+  auto dropped{PythonRef::Stolen(PyDict_New())};
+  for (int i = 0; i < static_cast<int>(UDPDropReason::kLast); ++i) {
+    auto reason{static_cast<UDPDropReason>(i)};
+    auto count{PythonRef::Stolen(
+        PyLong_FromLongLong(admission.drop_count(reason)))};
+    PyDict_SetItemString(dropped.get(), UDPAdmission::DropReasonName(reason),
+                         count.get());
+  }
+  auto result{PythonRef::Stolen(Py_BuildValue(
+      "{s:L,s:L,s:O}", "admitted",
+      static_cast<long long>(admission.admitted_count()),  // NOLINT
+      "cookies_sent",
+      static_cast<long long>(admission.cookies_sent_count()),  // NOLINT
+      "dropped", dropped.get()))};
+  if (reset) {
+    admission.ResetStats();
+  }
+  return result.HandOver();
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyUDPAdmissionStatsDef = {
+    "udp_admission_stats",             // name
+    (PyCFunction)PyUDPAdmissionStats,  // method
+    METH_VARARGS | METH_KEYWORDS,      // flags
+
+    "udp_admission_stats(reset: bool = False) -> dict[str, Any]\n"
+    "\n"
+    "Return counts of incoming connection traffic we let in or dropped.\n"
+    "\n"
+    "'admitted' counts connection packets passed along to the logic\n"
+    "thread, 'cookies_sent' counts cookie challenges sent to connection\n"
+    "requests while they were flooding in, and 'dropped' maps reasons\n"
+    "('rate_limited', 'malformed', 'unknown_source', 'bad_cookie') to\n"
+    "counts of packets thrown away. Pass reset=True to zero everything\n"
+    "after reading.\n"
+    "\n"
+    ":meta private:",
+};
+
+// --------------------------- bg_dynamics_stats -------------------------------
+
+static auto PyBGDynamicsStats(PyObject* self, PyObject* args,
+                              PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  int reset{};
+  static const char* kwlist[] = {"reset", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "|p",
+                                   const_cast<char**>(kwlist), &reset)) {
+    return nullptr;
+  }
+  // No bg dynamics in headless builds.
+  if (!g_base->bg_dynamics_server) {
+    Py_RETURN_NONE;
+  }
+  auto& budget{g_base->bg_dynamics_server->budget()};
+  auto result{PythonRef::Stolen(Py_BuildValue(
+      "{s:d,s:L,s:L}", "load_scale",
+      static_cast<double>(budget.load_scale()), "requested",
+      static_cast<long long>(budget.requested_count()),  // NOLINT
+      "created",
+      static_cast<long long>(budget.created_count())))};  // NOLINT
+  if (reset) {
+    budget.ResetStats();
+  }
+  return result.HandOver();
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyBGDynamicsStatsDef = {
+    "bg_dynamics_stats",             // name
+    (PyCFunction)PyBGDynamicsStats,  // method
+    METH_VARARGS | METH_KEYWORDS,    // flags
+
+    "bg_dynamics_stats(reset: bool = False) -> dict[str, Any] | None\n"
+    "\n"
+    "Return how bg-dynamics emissions are being scaled back.\n"
+    "\n"
+    "'requested' and 'created' count debris/smoke/etc. items asked for\n"
+    "and actually made after scaling for camera distance and load.\n"
+    "'load_scale' is the current scale applied due to load (1.0 means\n"
+    "none). Returns None when there are no bg-dynamics (headless builds).\n"
+    "Pass reset=True to zero the counts after reading.\n"
+    "\n"
+    ":meta private:",
+};
+
+// ---------------------------- renderer_stats ---------------------------------
+
+auto PythonMoethodsBase3::RendererStatsToPython(
+    const RendererValidating::Stats& stats) -> PythonRef {
+  auto dict{PythonRef::Stolen(PyDict_New())};
+  const std::pair<const char*, int64_t> counts[] = {
+      {"frames", stats.frames},
+      {"command_buffers", stats.command_buffers},
+      {"commands", stats.commands},
+      {"shader_binds", stats.shader_binds},
+      {"shader_changes", stats.shader_changes},
+      {"texture_refs", stats.texture_refs},
+      {"draws", stats.draws},
+      {"triangles", stats.triangles},
+      {"transform_ops", stats.transform_ops},
+      {"scissor_pushes", stats.scissor_pushes},
+      {"state_changes", stats.state_changes},
+      {"mesh_updates", stats.mesh_updates},
+      {"errors", stats.errors},
+  };
+  for (auto&& [name, value] : counts) {
+    PyDict_SetItemString(dict.get(), name,
+                         PythonRef::Stolen(PyLong_FromLongLong(value)).get());
+  }
+  PyDict_SetItemString(
+      dict.get(), "process_time",
+      PythonRef::Stolen(
+          PyFloat_FromDouble(static_cast<double>(stats.process_time)
+                             / 1000000.0))
+          .get());
+  return dict;
+}
+
+static auto PyRendererStats(PyObject* self, PyObject* args, PyObject* keywds)
+    -> PyObject* {
+  BA_PYTHON_TRY;
+  int reset{};
+  static const char* kwlist[] = {"reset", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "|p",
+                                   const_cast<char**>(kwlist), &reset)) {
+    return nullptr;
+  }
+  // Note that the renderer belongs to the graphics context; we can't
+  // simply ask the graphics-server for it from here.
+  RendererValidating::Stats total;
+  RendererValidating::Stats last_frame;
+  std::string last_error;
+  if (!RendererValidating::WithActive([&](RendererValidating* renderer) {
+        renderer->GetStats(&total, &last_frame, &last_error);
+        if (reset) {
+          renderer->ResetStats();
+        }
+      })) {
+    Py_RETURN_NONE;
+  }
+  auto total_dict{PythonMoethodsBase3::RendererStatsToPython(total)};
+  auto last_frame_dict{PythonMoethodsBase3::RendererStatsToPython(last_frame)};
+  return Py_BuildValue("{s:O,s:O,s:s}", "total", total_dict.get(),
+                       "last_frame", last_frame_dict.get(), "last_error",
+                       last_error.c_str());
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyRendererStatsDef = {
+    "renderer_stats",               // name
+    (PyCFunction)PyRendererStats,   // method
+    METH_VARARGS | METH_KEYWORDS,   // flags
+
+    "renderer_stats(reset: bool = False) -> dict[str, Any] | None\n"
+    "\n"
+    "Return counts from the validating renderer.\n"
+    "\n"
+    "The result holds 'total' and 'last_frame' dicts of command, draw,\n"
+    "and state-change counts (plus 'process_time' in seconds) and the\n"
+    "most recent validation error as 'last_error'. Returns None unless\n"
+    "the app was launched with BA_VALIDATING_RENDERER=1. Pass reset=True\n"
+    "to zero the totals after reading.\n"
+    "\n"
+    ":meta private:",
+};
+
+// --------------------------- renderer_capture --------------------------------
+
+static auto PyRendererCapture(PyObject* self, PyObject* args, PyObject* keywds)
+    -> PyObject* {
+  BA_PYTHON_TRY;
+  const char* path;
+  static const char* kwlist[] = {"path", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "s",
+                                   const_cast<char**>(kwlist), &path)) {
+    return nullptr;
+  }
+  if (RendererValidating::WithActive([path](RendererValidating* renderer) {
+        renderer->RequestCapture(path);
+      })) {
+    Py_RETURN_TRUE;
+  }
+  Py_RETURN_FALSE;
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyRendererCaptureDef = {
+    "renderer_capture",              // name
+    (PyCFunction)PyRendererCapture,  // method
+    METH_VARARGS | METH_KEYWORDS,    // flags
+
+    "renderer_capture(path: str) -> bool\n"
+    "\n"
+    "Write the next full frame to an image file.\n"
+    "\n"
+    "Only works with the validating renderer (see renderer_stats());\n"
+    "returns False otherwise. The frame is rasterized on the cpu with flat\n"
+    "shading and written asynchronously as a binary PPM.\n"
+    "\n"
+    ":meta private:",
+};
+
 // -----------------------------------------------------------------------------
 
 auto PythonMoethodsBase3::GetMethods() -> std::vector<PyMethodDef> {
@@ -2170,6 +2447,11 @@ auto PythonMoethodsBase3::GetMethods() -> std::vector<PyMethodDef> {
       PyGetInitialAppConfigDef,
       PySetAppConfigDef,
       PyUpdateInternalLoggerLevelsDef,
+      PyInputLatencyStatsDef,
+      PyUDPAdmissionStatsDef,
+      PyBGDynamicsStatsDef,
+      PyRendererStatsDef,
+      PyRendererCaptureDef,
   };
 }
 
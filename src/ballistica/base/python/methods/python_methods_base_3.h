@@ -5,7 +5,8 @@
 
 #include <vector>
 
-#include "ballistica/shared/ballistica.h"
+#include "ballistica/base/base.h"
+#include "ballistica/base/graphics/renderer/renderer_validating.h"
 
 namespace ballistica::base {
 
@@ -13,6 +14,14 @@ namespace ballistica::base {
 class PythonMoethodsBase3 {
  public:
   static auto GetMethods() -> std::vector<PyMethodDef>;
+
+  /// Build the per-stage dict input_latency_stats() returns.
+  static auto InputLatencyStatsToPython(const InputLatency& latency)
+      -> PythonRef;
+
+  /// Build a dict of the counts in validating-renderer stats.
+  static auto RendererStatsToPython(const RendererValidating::Stats& stats)
+      -> PythonRef;
 };
 
 }  // namespace ballistica::base
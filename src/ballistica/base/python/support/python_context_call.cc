@@ -5,6 +5,7 @@
 #include <string>
 
 #include "ballistica/base/logic/logic.h"
+#include "ballistica/base/support/step_profiler.h"
 #include "ballistica/base/ui/ui.h"
 #include "ballistica/core/python/core_python.h"
 #include "ballistica/shared/foundation/event_loop.h"
@@ -87,13 +88,17 @@ void PythonContextCall::Run(PyObject* args) {
   PythonContextCall* prev_call = current_call_;
   current_call_ = this;
   assert(Python::HaveGIL());
-  PyObject* o =
-      PyObject_Call(object_.get(),
-                    args ? args
-                         : g_core->python->objs()
-                               .Get(core::CorePython::ObjID::kEmptyTuple)
-                               .get(),
-                    nullptr);
+  PyObject* o;
+  {
+    StepProfiler::ScopedSample sample{StepProfiler::Category::kPythonCall,
+                                      object_.get()};
+    o = PyObject_Call(object_.get(),
+                      args ? args
+                           : g_core->python->objs()
+                                 .Get(core::CorePython::ObjID::kEmptyTuple)
+                                 .get(),
+                      nullptr);
+  }
   current_call_ = prev_call;
 
   if (o) {
@@ -76,6 +76,7 @@ class AppConfig {
     kShowDemosWhenIdle,
     kShowDeprecatedLoginTypes,
     kHighlightPotentialTokenPurchases,
+    kLateInputSampling,
     kLast  // Sentinel.
   };
 
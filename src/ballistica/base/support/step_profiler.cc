@@ -0,0 +1,236 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/base/support/step_profiler.h"
+
+#include <Python.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ballistica/core/core.h"
+
+namespace ballistica::base {
+
+// How far we'll dig through wrappers looking for an actual function.
+const int kMaxUnwrapDepth{8};
+
+namespace {
+
+// Dig down to the function object that will actually run for a callable.
+// Handles bound methods plus babase.Call/WeakCall (_call), WeakMethod
+// (_func) and functools.partial (func).
+auto UnwrapCallable(PyObject* callable) -> PythonRef {
+  PythonRef obj{callable, PythonRef::kAcquire};
+  for (int i = 0; i < kMaxUnwrapDepth; ++i) {
+    if (PyMethod_Check(obj.get())) {
+      obj.Acquire(PyMethod_GET_FUNCTION(obj.get()));
+      continue;
+    }
+    if (PyFunction_Check(obj.get())) {
+      break;
+    }
+    PyObject* inner{};
+    for (const char* attr : {"_call", "_func", "func"}) {
+      inner = PyObject_GetAttrString(obj.get(), attr);
+      if (inner) {
+        break;
+      }
+      PyErr_Clear();
+    }
+    if (!inner || !PyCallable_Check(inner)) {
+      Py_XDECREF(inner);
+      break;
+    }
+    obj.Steal(inner);
+  }
+  return obj;
+}
+
+auto GetCodeName(PyObject* code) -> std::string {
+  PythonRef qualname{PyObject_GetAttrString(code, "co_qualname"),
+                     PythonRef::kSteal};
+  PythonRef filename{PyObject_GetAttrString(code, "co_filename"),
+                     PythonRef::kSteal};
+  PythonRef lineno{PyObject_GetAttrString(code, "co_firstlineno"),
+                   PythonRef::kSteal};
+  if (!qualname.exists() || !filename.exists() || !lineno.exists()) {
+    PyErr_Clear();
+    return "<unknown>";
+  }
+  return qualname.Str() + " (" + filename.Str() + ":" + lineno.Str() + ")";
+}
+
+}  // namespace
+
+StepProfiler::ScopedSample::ScopedSample(Category category, const void* key,
+                                         const char* name)
+    : ScopedSample(g_base->step_profiler, category, key, name) {}
+
+StepProfiler::ScopedSample::ScopedSample(Category category,
+                                         PyObject* callable)
+    : ScopedSample(g_base->step_profiler, category, callable) {}
+
+StepProfiler::ScopedSample::ScopedSample(StepProfiler* profiler,
+                                         Category category, const void* key,
+                                         const char* name) {
+  if (profiler->sampling()) {
+    profiler_ = profiler;
+    entry_ = profiler->GetEntry_(category, key, name);
+    generation_ = profiler->generation_;
+    start_ = profiler->Now_();
+  }
+}
+
+StepProfiler::ScopedSample::ScopedSample(StepProfiler* profiler,
+                                         Category category,
+                                         PyObject* callable) {
+  if (profiler->sampling()) {
+    profiler_ = profiler;
+    entry_ = profiler->GetPythonEntry_(category, callable);
+    generation_ = profiler->generation_;
+    start_ = profiler->Now_();
+  }
+}
+
+StepProfiler::ScopedSample::~ScopedSample() {
+  if (entry_ && generation_ == profiler_->generation_) {
+    auto duration{profiler_->Now_() - start_};
+    entry_->count++;
+    entry_->total += duration;
+    entry_->max = std::max(entry_->max, duration);
+  }
+}
+
+StepProfiler::StepProfiler() = default;
+
+void StepProfiler::Start(int interval) {
+  Reset();
+  interval_ = std::max(1, interval);
+  running_ = true;
+}
+
+void StepProfiler::Stop() {
+  running_ = false;
+  sampling_ = false;
+}
+
+void StepProfiler::Reset() {
+  entries_.clear();
+  held_keys_.clear();
+  total_updates_ = 0;
+  sampled_updates_ = 0;
+  generation_++;
+}
+
+auto StepProfiler::Now_() const -> microsecs_t {
+  return synthetic_time_ >= 0 ? synthetic_time_ : g_core->AppTimeMicrosecs();
+}
+
+void StepProfiler::OnSessionUpdate() {
+  if (!running_) {
+    return;
+  }
+  sampling_ = (total_updates_ % interval_ == 0);
+  total_updates_++;
+  if (sampling_) {
+    sampled_updates_++;
+  }
+}
+
+auto StepProfiler::GetEntry_(Category category, const void* key,
+                             const char* name) -> Entry* {
+  auto [i, inserted] = entries_.try_emplace({category, key});
+  if (inserted) {
+    i->second.category = category;
+    i->second.name = name;
+  }
+  return &i->second;
+}
+
+auto StepProfiler::GetPythonEntry_(Category category, PyObject* callable)
+    -> Entry* {
+  assert(callable);
+  PythonRef target{UnwrapCallable(callable)};
+
+  // Functions are keyed by their code (shared by all closures and methods
+  // made from them); anything else by its type.
+  PyObject* key{PyFunction_Check(target.get())
+                    ? PyFunction_GET_CODE(target.get())
+                    : reinterpret_cast<PyObject*>(Py_TYPE(target.get()))};
+  auto [i, inserted] = entries_.try_emplace({category, key});
+  if (inserted) {
+    i->second.category = category;
+    i->second.name = PyFunction_Check(target.get())
+                         ? GetCodeName(key)
+                         : std::string(Py_TYPE(target.get())->tp_name)
+                               + " (callable)";
+    held_keys_.emplace_back(key, PythonRef::kAcquire);
+  }
+  return &i->second;
+}
+
+auto StepProfiler::GetEntries() const -> std::vector<Entry> {
+  std::vector<Entry> entries;
+  entries.reserve(entries_.size());
+  for (auto&& i : entries_) {
+    entries.push_back(i.second);
+  }
+  std::sort(entries.begin(), entries.end(),
+            [](const Entry& a, const Entry& b) { return a.total > b.total; });
+  return entries;
+}
+
+auto StepProfiler::CategoryName(Category category) -> const char* {
+  switch (category) {
+    case Category::kSceneStep:
+      return "scene step";
+    case Category::kNodeStep:
+      return "node step";
+    case Category::kNodeConnections:
+      return "connections";
+    case Category::kMaterialAction:
+      return "material action";
+    case Category::kPythonCall:
+      return "python call";
+    case Category::kHandleMessage:
+      return "handlemessage";
+  }
+  return "?";
+}
+
+auto StepProfiler::GetReport(int max_entries) const -> std::string {
+  char buffer[256];
+  snprintf(buffer, sizeof(buffer),
+           "Step profile: %lld of %lld updates sampled (every %d).\n",
+           static_cast<long long>(sampled_updates_),  // NOLINT
+           static_cast<long long>(total_updates_),    // NOLINT
+           interval_);
+  std::string out{buffer};
+  if (sampled_updates_ == 0) {
+    return out;
+  }
+  snprintf(buffer, sizeof(buffer), "%10s %10s %9s %9s  %-16s %s\n",
+           "total ms", "ms/update", "calls", "max us", "category", "name");
+  out += buffer;
+  auto entries{GetEntries()};
+  auto updates{static_cast<double>(sampled_updates_)};
+  int count{};
+  for (auto&& entry : entries) {
+    if (count++ >= max_entries) {
+      break;
+    }
+    snprintf(buffer, sizeof(buffer), "%10.2f %10.4f %9lld %9lld  %-16s ",
+             static_cast<double>(entry.total) / 1000.0,
+             static_cast<double>(entry.total) / 1000.0 / updates,
+             static_cast<long long>(entry.count),  // NOLINT
+             static_cast<long long>(entry.max),    // NOLINT
+             CategoryName(entry.category));
+    out += buffer + entry.name + "\n";
+  }
+  return out;
+}
+
+}  // namespace ballistica::base
@@ -0,0 +1,126 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_BASE_SUPPORT_STEP_PROFILER_H_
+#define BALLISTICA_BASE_SUPPORT_STEP_PROFILER_H_
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ballistica/base/base.h"
+#include "ballistica/shared/foundation/macros.h"
+#include "ballistica/shared/python/python_ref.h"
+
+namespace ballistica::base {
+
+/// Opt-in profiler attributing logic time to node types, material actions
+/// and Python callables so server operators can find expensive mods and
+/// minigames without a native profiler.
+///
+/// When started, one of every `interval` host-session updates is sampled
+/// (each is a frame's worth of timers and sim steps), along with whatever
+/// else runs on the logic thread until the next update (input calls,
+/// etc). Times are inclusive, so a Python call made from within a node
+/// step counts toward both. Logic thread only.
+class StepProfiler {
+ public:
+  enum class Category {
+    kSceneStep,
+    kNodeStep,
+    kNodeConnections,
+    kMaterialAction,
+    kPythonCall,
+    kHandleMessage,
+  };
+
+  struct Entry {
+    Category category{};
+    std::string name;
+    int64_t count{};
+    microsecs_t total{};
+    microsecs_t max{};
+  };
+
+  /// Times its lifetime as a sample of something if the global profiler
+  /// is sampling; otherwise does nothing. `name` is only read the first
+  /// time a given key is seen.
+  class ScopedSample {
+   public:
+    ScopedSample(Category category, const void* key, const char* name);
+
+    /// Sample a Python call; the callable is unwrapped as far as possible
+    /// (bound methods, Call/WeakCall wrappers, partials) and attributed to
+    /// the underlying function's qualname and file:line.
+    ScopedSample(Category category, PyObject* callable);
+
+    /// Versions of the above for a specific profiler (for testing).
+    ScopedSample(StepProfiler* profiler, Category category, const void* key,
+                 const char* name);
+    ScopedSample(StepProfiler* profiler, Category category,
+                 PyObject* callable);
+    ~ScopedSample();
+
+   private:
+    StepProfiler* profiler_{};
+    Entry* entry_{};
+    microsecs_t start_{};
+    int generation_{};
+    BA_DISALLOW_CLASS_COPIES(ScopedSample);
+  };
+
+  StepProfiler();
+
+  /// Begin sampling one of every `interval` session updates. Clears any
+  /// existing results. Start/Stop/Reset on the global profiler must
+  /// happen in the logic thread.
+  void Start(int interval);
+  void Stop();
+  void Reset();
+  auto running() const { return running_; }
+  auto sampling() const { return sampling_; }
+
+  /// Called as each host-session update begins; decides whether it (and
+  /// what follows until the next one) gets sampled.
+  void OnSessionUpdate();
+
+  /// All entries, most total time first.
+  auto GetEntries() const -> std::vector<Entry>;
+  auto sampled_updates() const { return sampled_updates_; }
+  auto total_updates() const { return total_updates_; }
+
+  /// A human readable table of the top `max_entries` entries.
+  auto GetReport(int max_entries) const -> std::string;
+
+  static auto CategoryName(Category category) -> const char*;
+
+  /// Measure samples against the provided time instead of the current
+  /// app-time (for testing). Pass -1 to go back to app-time.
+  void SetSyntheticTime(microsecs_t time) { synthetic_time_ = time; }
+
+ private:
+  auto Now_() const -> microsecs_t;
+  auto GetEntry_(Category category, const void* key, const char* name)
+      -> Entry*;
+  auto GetPythonEntry_(Category category, PyObject* callable) -> Entry*;
+
+  std::map<std::pair<Category, const void*>, Entry> entries_;
+
+  // Python objects we key entries by; held so their addresses can't be
+  // reused by something else while we're collecting.
+  std::vector<PythonRef> held_keys_;
+  int interval_{1};
+
+  // Bumped whenever entries are cleared so samples in flight at the time
+  // know to drop themselves.
+  int generation_{};
+  int64_t total_updates_{};
+  int64_t sampled_updates_{};
+  microsecs_t synthetic_time_{-1};
+  bool running_{};
+  bool sampling_{};
+};
+
+}  // namespace ballistica::base
+
+#endif  // BALLISTICA_BASE_SUPPORT_STEP_PROFILER_H_
@@ -11,6 +11,7 @@
 #include "ballistica/core/logging/logging.h"
 #include "ballistica/core/platform/core_platform.h"
 #include "ballistica/core/python/core_python.h"
+#include "ballistica/core/support/startup_timeline.h"
 #include "ballistica/shared/foundation/macros.h"
 #include "ballistica/shared/generic/runnable.h"
 
@@ -85,6 +86,7 @@ CoreFeatureSet::CoreFeatureSet(CoreConfig config)
       platform{CorePlatform::Create()},
       core_config_{std::move(config)},
       logging{new Logging()},
+      startup_timeline{new StartupTimeline()},
       last_app_time_measure_microsecs_{CorePlatform::TimeMonotonicMicrosecs()},
       vr_mode_{config.vr_mode} {
   // We're a singleton. If there's already one of us, something's wrong.
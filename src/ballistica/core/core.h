@@ -21,6 +21,7 @@ class CoreFeatureSet;
 class CorePlatform;
 class CorePython;
 class Logging;
+class StartupTimeline;
 
 // Our feature-set's globals.
 //
@@ -169,6 +170,7 @@ class CoreFeatureSet {
   CorePython* const python;
   CorePlatform* const platform;
   Logging* const logging;
+  StartupTimeline* const startup_timeline;
 
   // The following are misc values that should be migrated to applicable
   // component classes or private vars.
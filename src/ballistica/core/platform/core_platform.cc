@@ -25,6 +25,7 @@
 
 #if !BA_PLATFORM_WINDOWS
 #include <cxxabi.h>
+#include <sys/mman.h>
 #include <unistd.h>
 #endif
 
@@ -331,6 +332,45 @@ auto CorePlatform::FOpen(const char* path, const char* mode) -> FILE* {
 #endif
 }
 
+auto CorePlatform::MapFile(const char* path, size_t* size) -> const void* {
+// This default implementation covers non-windows platforms.
+#if BA_PLATFORM_WINDOWS
+  throw Exception();
+#else
+  assert(size);
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    return nullptr;
+  }
+  struct stat st {};
+  if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+    close(fd);
+    return nullptr;
+  }
+  void* data =
+      mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE,
+           fd, 0);
+
+  // The mapping holds its own reference to the file.
+  close(fd);
+  if (data == MAP_FAILED) {
+    return nullptr;
+  }
+  *size = static_cast<size_t>(st.st_size);
+  return data;
+#endif
+}
+
+void CorePlatform::UnmapFile(const void* data, size_t size) {
+// This default implementation covers non-windows platforms.
+#if BA_PLATFORM_WINDOWS
+  throw Exception();
+#else
+  assert(data);
+  munmap(const_cast<void*>(data), size);
+#endif
+}
+
 auto CorePlatform::FilePathExists(const std::string& name) -> bool {
   struct BA_STAT buffer {};
   return (Stat(name.c_str(), &buffer) == 0);
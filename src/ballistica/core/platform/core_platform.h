@@ -55,6 +55,15 @@ class CorePlatform {
   /// fopen() supporting UTF8 strings.
   virtual auto FOpen(const char* path, const char* mode) -> FILE*;
 
+  /// Map a file read-only into memory, supporting UTF8 strings. Returns
+  /// nullptr on failure (including for empty files), in which case callers
+  /// should fall back to regular reads. On success, `size` is set to the
+  /// file's size and the mapping must be released with UnmapFile().
+  virtual auto MapFile(const char* path, size_t* size) -> const void*;
+
+  /// Release a mapping returned by MapFile().
+  virtual void UnmapFile(const void* data, size_t size);
+
   /// rename() supporting UTF8 strings. For cross-platform consistency, this
   /// should also remove any file that exists at the target location first.
   virtual auto Rename(const char* oldname, const char* newname) -> int;
@@ -384,6 +384,42 @@ auto CorePlatformWindows::FOpen(const char* path, const char* mode) -> FILE* {
   return _wfopen(UTF8Decode(path).c_str(), UTF8Decode(mode).c_str());
 }
 
+auto CorePlatformWindows::MapFile(const char* path, size_t* size)
+    -> const void* {
+  assert(size);
+  HANDLE file =
+      CreateFileW(UTF8Decode(path).c_str(), GENERIC_READ, FILE_SHARE_READ,
+                  nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    return nullptr;
+  }
+  LARGE_INTEGER file_size{};
+  if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart <= 0) {
+    CloseHandle(file);
+    return nullptr;
+  }
+  HANDLE mapping =
+      CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  CloseHandle(file);
+  if (mapping == nullptr) {
+    return nullptr;
+  }
+
+  // The view keeps the mapping (and file) alive until it is unmapped.
+  void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  CloseHandle(mapping);
+  if (data == nullptr) {
+    return nullptr;
+  }
+  *size = static_cast<size_t>(file_size.QuadPart);
+  return data;
+}
+
+void CorePlatformWindows::UnmapFile(const void* data, size_t size) {
+  assert(data);
+  UnmapViewOfFile(data);
+}
+
 void CorePlatformWindows::DoMakeDir(const std::string& dir, bool quiet) {
   std::wstring stemp = UTF8Decode(dir);
   int result = CreateDirectory(stemp.c_str(), 0);
@@ -36,6 +36,8 @@ class CorePlatformWindows : public CorePlatform {
   auto DoAbsPath(const std::string& path, std::string* outpath)
       -> bool override;
   auto FOpen(const char* path, const char* mode) -> FILE* override;
+  auto MapFile(const char* path, size_t* size) -> const void* override;
+  void UnmapFile(const void* data, size_t size) override;
   auto GetErrnoString() -> std::string override;
   auto GetSocketErrorString() -> std::string override;
   auto GetSocketError() -> int override;
@@ -340,6 +340,10 @@ void CorePython::ImportPythonObjs() {
     objs_.StoreCallable(ObjID::kBaEnvAtExitCall, *ctx.DictGetItem("atexit"));
     objs_.StoreCallable(ObjID::kBaEnvPreFinalizeCall,
                         *ctx.DictGetItem("pre_finalize"));
+    objs_.StoreCallable(ObjID::kBaEnvInstallPythonBundleCall,
+                        *ctx.DictGetItem("install_python_bundle"));
+    objs_.StoreCallable(ObjID::kBaEnvRunPreforkServerCall,
+                        *ctx.DictGetItem("run_prefork_server"));
   }
 }
 
@@ -461,6 +465,10 @@ void CorePython::MonolithicModeBaEnvConfigure() {
   auto args = PythonRef::Stolen(Py_BuildValue("(s)", default_py_dir.c_str()));
   objs().Get(ObjID::kPrependSysPathCall).Call(args);
 
+  // If a precompiled bundle of our scripts is present, serve imports out
+  // of it (baenv included).
+  InstallPythonBundle_(default_py_dir);
+
   // Import and run baenv.configure() using our 'monolithic' default values
   // for all paths.
   std::optional<std::string> config_dir =
@@ -512,6 +520,93 @@ void CorePython::MonolithicModeBaEnvConfigure() {
                        "baenv.configure() end");
 }
 
+static auto PyPythonBundleFind(PyObject* self, PyObject* args) -> PyObject* {
+  const char* name;
+  if (!PyArg_ParseTuple(args, "s", &name)) {
+    return nullptr;
+  }
+  auto& bundle{g_core->python->python_bundle()};
+  auto* entry{bundle.Find(name)};
+  if (!entry) {
+    Py_RETURN_NONE;
+  }
+  return Py_BuildValue("(OsII)", entry->is_package ? Py_True : Py_False,
+                       bundle.EntryPath(*entry).c_str(), entry->source_mtime,
+                       entry->source_size);
+}
+
+static PyMethodDef PyPythonBundleFindDef = {
+    "python_bundle_find",            // name
+    (PyCFunction)PyPythonBundleFind,  // method
+    METH_VARARGS,                    // flags
+    nullptr,
+};
+
+static auto PyPythonBundleGetCode(PyObject* self, PyObject* args)
+    -> PyObject* {
+  const char* name;
+  if (!PyArg_ParseTuple(args, "s", &name)) {
+    return nullptr;
+  }
+  auto& bundle{g_core->python->python_bundle()};
+  auto* entry{bundle.Find(name)};
+  if (!entry) {
+    PyErr_Format(PyExc_ImportError, "'%s' is not in the Python bundle.",
+                 name);
+    return nullptr;
+  }
+  return bundle.GetCode(*entry);
+}
+
+static PyMethodDef PyPythonBundleGetCodeDef = {
+    "python_bundle_get_code",           // name
+    (PyCFunction)PyPythonBundleGetCode,  // method
+    METH_VARARGS,                       // flags
+    nullptr,
+};
+
+void CorePython::InstallPythonBundle_(const std::string& app_python_dir) {
+  assert(Python::HaveGIL());
+
+  // Allow opting out without having to go delete files.
+  auto disable{g_core->platform->GetEnv("BA_NO_PYTHON_BUNDLE")};
+  if (disable.has_value() && *disable == "1") {
+    return;
+  }
+  if (!python_bundle_.Load(app_python_dir + ".babundle")) {
+    return;
+  }
+  auto find{
+      PythonRef::Stolen(PyCFunction_New(&PyPythonBundleFindDef, nullptr))};
+  auto get_code{PythonRef::Stolen(
+      PyCFunction_New(&PyPythonBundleGetCodeDef, nullptr))};
+  auto args{PythonRef::Stolen(Py_BuildValue(
+      "(sOO)", app_python_dir.c_str(), find.get(), get_code.get()))};
+  objs().Get(ObjID::kBaEnvInstallPythonBundleCall).Call(args);
+  g_core->logging->Log(LogName::kBaLifecycle, LogLevel::kInfo,
+                       "Using Python bundle with "
+                           + std::to_string(python_bundle_.entry_count())
+                           + " modules.");
+}
+
+auto CorePython::MonolithicModePreforkServe() -> bool {
+  assert(g_buildconfig.monolithic_build());
+  assert(g_core->InMainThread());
+  auto& control_path{g_core->core_config().prefork_control_path};
+  assert(control_path.has_value());
+
+  auto gil{Python::ScopedInterpreterLock()};
+  auto args{PythonRef::Stolen(Py_BuildValue("(s)", control_path->c_str()))};
+  auto result{objs().Get(ObjID::kBaEnvRunPreforkServerCall).Call(args)};
+  if (!result.exists()) {
+    FatalError("Prefork server failed (no error info available).");
+  }
+  if (result.ValueIsString()) {
+    FatalError("Prefork server failed:\n" + result.ValueAsString());
+  }
+  return result.get() == Py_True;
+}
+
 void CorePython::LoggingCall(LogName logname, LogLevel loglevel,
                              const std::string& msg) {
   // If we're not yet sending logs to Python, store this one away until we
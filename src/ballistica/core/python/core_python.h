@@ -9,6 +9,7 @@
 #include <vector>
 
 #include "ballistica/core/core.h"
+#include "ballistica/core/python/python_bundle.h"
 #include "ballistica/shared/python/python_object_set.h"
 
 namespace ballistica::core {
@@ -57,6 +58,8 @@ class CorePython {
     kBaEnvGetConfigCall,
     kBaEnvAtExitCall,
     kBaEnvPreFinalizeCall,
+    kBaEnvInstallPythonBundleCall,
+    kBaEnvRunPreforkServerCall,
     kLast  // Sentinel; must be at end.
   };
 
@@ -71,6 +74,11 @@ class CorePython {
   /// Run baenv.configure() with all of our monolithic-mode paths/etc.
   void MonolithicModeBaEnvConfigure();
 
+  /// Run as a prefork parent, forking off workers on request. Returns
+  /// true in forked workers, which should continue on with a normal app
+  /// run, or false in the parent once it is told to shut down.
+  auto MonolithicModePreforkServe() -> bool;
+
   /// Call once we should start forwarding our Log calls (along with all
   /// pent up ones) to Python.
   void EnablePythonLoggingCalls();
@@ -95,8 +103,14 @@ class CorePython {
 
   const auto& objs() { return objs_; }
 
+  /// Precompiled bundle of our app Python modules, if one is in use.
+  auto python_bundle() const -> const PythonBundle& { return python_bundle_; }
+
  private:
+  void InstallPythonBundle_(const std::string& app_python_dir);
+
   PythonObjectSet<ObjID> objs_;
+  PythonBundle python_bundle_;
 
   bool monolithic_init_complete_{};
   bool python_logging_calls_enabled_{};
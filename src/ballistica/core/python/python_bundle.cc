@@ -0,0 +1,154 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/core/python/python_bundle.h"
+
+#include <Python.h>
+#include <marshal.h>
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+#include "ballistica/core/logging/logging.h"
+#include "ballistica/core/platform/core_platform.h"
+#include "ballistica/shared/python/python.h"
+
+namespace ballistica::core {
+
+// We currently read/write in little-endian since that's all we run on at
+// the moment.
+#if WORDS_BIGENDIAN
+#error FIX THIS FOR BIG ENDIAN
+#endif
+
+static const char kPythonBundleMagic[8] = {'B', 'A', 'P', 'Y',
+                                           'B', 'N', 'D', 'L'};
+
+PythonBundle::~PythonBundle() { Release_(); }
+
+void PythonBundle::Release_() {
+  if (data_) {
+    g_core->platform->UnmapFile(data_, data_size_);
+    data_ = nullptr;
+    data_size_ = 0;
+    entries_ = nullptr;
+    entry_count_ = 0;
+  }
+}
+
+static auto InBounds_(size_t data_size, uint64_t offset, uint64_t size)
+    -> bool {
+  return offset <= data_size && size <= data_size - offset;
+}
+
+auto PythonBundle::Load(const std::string& path) -> bool {
+  assert(!loaded());
+
+  // No bundle is the normal case for development builds; no need to
+  // complain.
+  size_t size{};
+  auto* data = static_cast<const char*>(
+      g_core->platform->MapFile(path.c_str(), &size));
+  if (!data) {
+    return false;
+  }
+  data_ = data;
+  data_size_ = size;
+
+  std::string error;
+  PythonBundleHeader header{};
+  if (data_size_ < sizeof(header)) {
+    error = "file is truncated";
+  } else {
+    memcpy(&header, data_, sizeof(header));
+    auto python_magic{static_cast<uint32_t>(PyImport_GetMagicNumber())};
+    uint32_t optimize{g_buildconfig.debug_build() ? 0u : 1u};
+    if (memcmp(header.magic, kPythonBundleMagic, sizeof(header.magic)) != 0) {
+      error = "bad file magic";
+    } else if (header.version != kPythonBundleVersion) {
+      error = "unsupported version " + std::to_string(header.version);
+    } else if (header.python_magic != python_magic) {
+      error = "built for a different Python version";
+    } else if (header.optimize != optimize) {
+      error = "built with optimize=" + std::to_string(header.optimize)
+              + " but we need " + std::to_string(optimize);
+    } else if (header.data_size != data_size_
+               || !InBounds_(data_size_, header.index_offset,
+                             static_cast<uint64_t>(header.entry_count)
+                                 * sizeof(PythonBundleEntry))
+               || header.index_offset % alignof(PythonBundleEntry) != 0) {
+      error = "bad index";
+    }
+  }
+
+  // Validate every entry up front so lookups don't need to.
+  if (error.empty()) {
+    entries_ =
+        reinterpret_cast<const PythonBundleEntry*>(data_ + header.index_offset);
+    entry_count_ = header.entry_count;
+    for (uint32_t i = 0; i < entry_count_; ++i) {
+      auto& entry{entries_[i]};
+      if (!InBounds_(data_size_, entry.name_offset, entry.name_size)
+          || !InBounds_(data_size_, entry.path_offset, entry.path_size)
+          || !InBounds_(data_size_, entry.code_offset, entry.code_size)
+          || entry.name_size == 0 || entry.code_size == 0) {
+        error = "bad entry " + std::to_string(i);
+        break;
+      }
+    }
+  }
+
+  if (!error.empty()) {
+    Release_();
+    g_core->logging->Log(LogName::kBa, LogLevel::kWarning,
+                         "Ignoring Python bundle '" + path + "' (" + error
+                             + "); using regular imports.");
+    return false;
+  }
+  return true;
+}
+
+auto PythonBundle::Find(const char* name) const -> const PythonBundleEntry* {
+  if (!data_) {
+    return nullptr;
+  }
+  auto name_size{strlen(name)};
+
+  // Entries are sorted bytewise by name; binary search them in place.
+  uint32_t lo{};
+  uint32_t hi{entry_count_};
+  while (lo < hi) {
+    uint32_t mid{lo + (hi - lo) / 2};
+    auto& entry{entries_[mid]};
+    auto cmp{memcmp(data_ + entry.name_offset, name,
+                    std::min(static_cast<size_t>(entry.name_size), name_size))};
+    if (cmp == 0) {
+      if (entry.name_size == name_size) {
+        return &entry;
+      }
+      cmp = entry.name_size < name_size ? -1 : 1;
+    }
+    if (cmp < 0) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return nullptr;
+}
+
+auto PythonBundle::EntryPath(const PythonBundleEntry& entry) const
+    -> std::string {
+  assert(data_);
+  return std::string(data_ + entry.path_offset, entry.path_size);
+}
+
+auto PythonBundle::GetCode(const PythonBundleEntry& entry) const
+    -> PyObject* {
+  assert(data_);
+  assert(Python::HaveGIL());
+  return PyMarshal_ReadObjectFromString(
+      data_ + entry.code_offset, static_cast<Py_ssize_t>(entry.code_size));
+}
+
+}  // namespace ballistica::core
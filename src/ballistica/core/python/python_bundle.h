@@ -0,0 +1,95 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_CORE_PYTHON_PYTHON_BUNDLE_H_
+#define BALLISTICA_CORE_PYTHON_PYTHON_BUNDLE_H_
+
+#include <string>
+
+#include "ballistica/core/core.h"
+#include "ballistica/shared/foundation/macros.h"
+
+namespace ballistica::core {
+
+/// Current version of the Python bundle layout.
+const uint32_t kPythonBundleVersion = 2;
+
+/// Header for Python bundle files. Everything is little-endian.
+struct PythonBundleHeader {
+  char magic[8];
+  uint32_t version;
+  // Must match PyImport_GetMagicNumber() for the running interpreter.
+  uint32_t python_magic;
+  // The optimization level modules were compiled at.
+  uint32_t optimize;
+  uint32_t entry_count;
+  uint32_t index_offset;
+  uint32_t data_size;
+};
+static_assert(sizeof(PythonBundleHeader) == 32);
+
+/// Index entry for a single module. Entries are sorted by name. Offsets
+/// are from the start of the file.
+struct PythonBundleEntry {
+  uint32_t name_offset;
+  uint32_t name_size;
+  // Path of the module's source relative to the app-python-dir (using
+  // forward slashes).
+  uint32_t path_offset;
+  uint32_t path_size;
+  // Marshalled code object.
+  uint32_t code_offset;
+  uint32_t code_size;
+  uint32_t is_package;
+  // Modification time and size of the source file the code was compiled
+  // from (both truncated to 32 bits, as .pyc files do). Entries whose
+  // source no longer matches get imported from the source instead.
+  uint32_t source_mtime;
+  uint32_t source_size;
+  uint32_t reserved;
+};
+static_assert(sizeof(PythonBundleEntry) == 40);
+
+/// A set of precompiled Python modules packed into a single file.
+///
+/// Release builds can ship one of these alongside ba_data/python so our
+/// built-in modules can be imported without the per-module stats and
+/// opens of the regular filesystem import machinery. The file is
+/// memory-mapped and code objects are unmarshalled straight out of the
+/// mapping; the raw file pages are shared by all processes using it,
+/// though each process still builds its own code objects from them. See
+/// batools.pybundle for the writer side.
+class PythonBundle {
+ public:
+  PythonBundle() = default;
+  ~PythonBundle();
+
+  /// Map and validate a bundle file. Returns false if the file does not
+  /// exist or can't be used with this interpreter (details of the latter
+  /// are logged).
+  auto Load(const std::string& path) -> bool;
+
+  auto loaded() const -> bool { return data_ != nullptr; }
+  auto entry_count() const -> int { return static_cast<int>(entry_count_); }
+
+  /// Look up a module by its full dotted name. Returns nullptr if the
+  /// bundle does not contain it.
+  auto Find(const char* name) const -> const PythonBundleEntry*;
+
+  auto EntryPath(const PythonBundleEntry& entry) const -> std::string;
+
+  /// Unmarshal an entry's code object. Returns a new reference, or
+  /// nullptr with a Python exception set. Requires the GIL.
+  auto GetCode(const PythonBundleEntry& entry) const -> PyObject*;
+
+ private:
+  void Release_();
+  const char* data_{};
+  size_t data_size_{};
+  const PythonBundleEntry* entries_{};
+  uint32_t entry_count_{};
+  BA_DISALLOW_CLASS_COPIES(PythonBundle);
+};
+
+}  // namespace ballistica::core
+
+#endif  // BALLISTICA_CORE_PYTHON_PYTHON_BUNDLE_H_
@@ -50,7 +50,9 @@ static void PrintHelp() {
       " -C, --config-dir   <path>  Override the app config directory.\n"
       " -m, --mods-dir     <path>  Override the app mods directory.\n"
       " -a, --cache-dir    <path>  Override the app cache directory.\n"
-      " -B, --dont-write-bytecode  Don\'t write bytecode (.pyc) files.\n");
+      " -B, --dont-write-bytecode  Don\'t write bytecode (.pyc) files.\n"
+      "     --prefork      <path>  Run as a prefork parent serving worker\n"
+      "                            requests on a unix socket at <path>.\n");
 }
 
 /// If the arg at the provided index matches the long/short names given,
@@ -188,6 +190,8 @@ void CoreConfig::ApplyArgs(int argc, char** argv) {
         }
       } else if ((ParseFlag(argc, argv, &i, "--dont-write-bytecode", "-B"))) {
         dont_write_bytecode = true;
+      } else if ((value = ParseArgValue(argc, argv, &i, "--prefork"))) {
+        prefork_control_path = *value;
       } else {
         printf(
             "Error: Invalid arg '%s'.\n"
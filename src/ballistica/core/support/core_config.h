@@ -66,6 +66,11 @@ class CoreConfig {
 
   /// Disable writing of bytecode (.pyc) files.
   bool dont_write_bytecode{};
+
+  /// If set, run as a prefork parent: bring up Python and import our
+  /// modules, then fork worker processes on request via a unix socket at
+  /// this path (monolithic builds on unixy platforms only).
+  std::optional<std::string> prefork_control_path{};
 };
 
 }  // namespace ballistica::core
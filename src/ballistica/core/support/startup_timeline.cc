@@ -0,0 +1,145 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/core/support/startup_timeline.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ballistica/core/core.h"
+#include "ballistica/core/logging/logging_macros.h"
+#include "ballistica/core/platform/core_platform.h"
+
+namespace ballistica::core {
+
+static auto CurrentThreadName_() -> std::string {
+  // We can get used before the core singleton is fully in place.
+  return g_core ? g_core->CurrentThreadName() : "unknown";
+}
+
+StartupTimeline::ScopedPhase::ScopedPhase(const char* name) : name_{name} {
+  if (g_core) {
+    g_core->startup_timeline->BeginPhase(name_);
+  }
+}
+
+StartupTimeline::ScopedPhase::~ScopedPhase() {
+  if (g_core) {
+    g_core->startup_timeline->EndPhase(name_);
+  }
+}
+
+StartupTimeline::StartupTimeline()
+    : origin_{CorePlatform::TimeMonotonicMicrosecs()} {}
+
+void StartupTimeline::Restart() {
+  std::scoped_lock lock(mutex_);
+  phases_.clear();
+  ready_label_.clear();
+  ready_time_ = -1;
+  origin_ = CorePlatform::TimeMonotonicMicrosecs();
+}
+
+void StartupTimeline::AddPhase(const std::string& name, microsecs_t start,
+                               microsecs_t end,
+                               const std::string& thread_name) {
+  assert(end >= start);
+  auto phase_thread_name{thread_name.empty() ? CurrentThreadName_()
+                                             : thread_name};
+  std::scoped_lock lock(mutex_);
+
+  // Phases measured before we existed (core import, etc.) pull our origin
+  // back so everything stays non-negative.
+  if (start < origin_) {
+    origin_ = start;
+  }
+  phases_.push_back({name, std::move(phase_thread_name), start, end});
+}
+
+void StartupTimeline::BeginPhase(const std::string& name) {
+  auto thread_name{CurrentThreadName_()};
+  std::scoped_lock lock(mutex_);
+  phases_.push_back(
+      {name, std::move(thread_name), CorePlatform::TimeMonotonicMicrosecs()});
+}
+
+void StartupTimeline::EndPhase(const std::string& name) {
+  auto now{CorePlatform::TimeMonotonicMicrosecs()};
+  std::scoped_lock lock(mutex_);
+
+  // End the most recent running phase with this name.
+  for (auto i = phases_.rbegin(); i != phases_.rend(); ++i) {
+    if (i->end == -1 && i->name == name) {
+      i->end = now;
+      return;
+    }
+  }
+  BA_LOG_ONCE(LogName::kBaLifecycle, LogLevel::kWarning,
+              "StartupTimeline::EndPhase() called for phase '" + name
+                  + "' which is not running.");
+}
+
+auto StartupTimeline::MarkReady(const std::string& label) -> double {
+  auto now{CorePlatform::TimeMonotonicMicrosecs()};
+  microsecs_t expected{-1};
+  std::scoped_lock lock(mutex_);
+  if (ready_time_.compare_exchange_strong(expected, now)) {
+    ready_label_ = label;
+  }
+  return ReadySeconds();
+}
+
+auto StartupTimeline::ReadySeconds() const -> double {
+  auto ready_time{ready_time_.load()};
+  if (ready_time == -1) {
+    return -1.0;
+  }
+  return static_cast<double>(ready_time - origin_) / 1000000.0;
+}
+
+auto StartupTimeline::GetPhases() -> std::vector<Phase> {
+  std::vector<Phase> phases;
+  {
+    std::scoped_lock lock(mutex_);
+    phases = phases_;
+  }
+  std::stable_sort(phases.begin(), phases.end(),
+                   [](const Phase& a, const Phase& b) {
+                     return a.start < b.start;
+                   });
+  return phases;
+}
+
+auto StartupTimeline::GetReport() -> std::string {
+  auto phases{GetPhases()};
+  microsecs_t origin{origin_};
+  std::string out{"Startup timeline (ms since launch):\n"};
+  char buffer[256];
+  for (auto&& phase : phases) {
+    if (phase.end == -1) {
+      snprintf(buffer, sizeof(buffer), "  %8.1f  (running)  %s [%s]\n",
+               static_cast<double>(phase.start - origin) / 1000.0,
+               phase.name.c_str(), phase.thread_name.c_str());
+    } else {
+      snprintf(buffer, sizeof(buffer), "  %8.1f  %8.1f ms  %s [%s]\n",
+               static_cast<double>(phase.start - origin) / 1000.0,
+               static_cast<double>(phase.end - phase.start) / 1000.0,
+               phase.name.c_str(), phase.thread_name.c_str());
+    }
+    out += buffer;
+  }
+  std::scoped_lock lock(mutex_);
+  auto ready_seconds{ReadySeconds()};
+  if (ready_seconds >= 0.0) {
+    snprintf(buffer, sizeof(buffer), "Ready (%s) at %.1f ms.",
+             ready_label_.c_str(), ready_seconds * 1000.0);
+  } else {
+    snprintf(buffer, sizeof(buffer), "Not yet ready.");
+  }
+  out += buffer;
+  return out;
+}
+
+}  // namespace ballistica::core
@@ -0,0 +1,84 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_CORE_SUPPORT_STARTUP_TIMELINE_H_
+#define BALLISTICA_CORE_SUPPORT_STARTUP_TIMELINE_H_
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "ballistica/shared/ballistica.h"
+#include "ballistica/shared/foundation/macros.h"
+
+namespace ballistica::core {
+
+/// Records when the various phases of app startup begin and end so we can
+/// see where cold-boot time goes. Phases may overlap and can be recorded
+/// from any thread. Times are monotonic microseconds.
+class StartupTimeline {
+ public:
+  struct Phase {
+    std::string name;
+    std::string thread_name;
+    microsecs_t start{};
+    // -1 while the phase is still running.
+    microsecs_t end{-1};
+  };
+
+  /// Begins/ends a phase over the lifetime of the object.
+  class ScopedPhase {
+   public:
+    explicit ScopedPhase(const char* name);
+    ~ScopedPhase();
+
+   private:
+    const char* name_;
+    BA_DISALLOW_CLASS_COPIES(ScopedPhase);
+  };
+
+  StartupTimeline();
+
+  /// Clear everything and start measuring from now. Used by forked prefork
+  /// workers, whose startup begins at the fork.
+  void Restart();
+
+  /// Record an already-completed phase. It is attributed to the current
+  /// thread unless a thread name is passed.
+  void AddPhase(const std::string& name, microsecs_t start, microsecs_t end,
+                const std::string& thread_name = {});
+
+  /// Begin a phase on the current thread. Should be paired with a call to
+  /// EndPhase() with the same name.
+  void BeginPhase(const std::string& name);
+  void EndPhase(const std::string& name);
+
+  /// Mark the app as ready to do its job (first frame drawn for gui
+  /// builds; hosting and accepting connections for servers). Only the
+  /// first call has an effect. Returns seconds elapsed since startup began.
+  auto MarkReady(const std::string& label) -> double;
+
+  /// Seconds from startup until MarkReady() was called, or -1 if it has
+  /// not been.
+  auto ReadySeconds() const -> double;
+
+  /// Return a snapshot of all recorded phases in order of start time.
+  auto GetPhases() -> std::vector<Phase>;
+
+  /// The time everything is measured from.
+  auto origin() const -> microsecs_t { return origin_; }
+
+  /// Return a human readable breakdown of startup.
+  auto GetReport() -> std::string;
+
+ private:
+  std::mutex mutex_;
+  std::vector<Phase> phases_;
+  std::string ready_label_;
+  std::atomic<microsecs_t> origin_;
+  std::atomic<microsecs_t> ready_time_{-1};
+};
+
+}  // namespace ballistica::core
+
+#endif  // BALLISTICA_CORE_SUPPORT_STARTUP_TIMELINE_H_
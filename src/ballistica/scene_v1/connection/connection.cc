@@ -2,7 +2,9 @@
 
 #include "ballistica/scene_v1/connection/connection.h"
 
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "ballistica/base/base.h"
@@ -139,11 +141,12 @@ void Connection::HandleResends(millisecs_t real_time,
 
       // Add our header/acks and go ahead and send this one out.
       // 1 byte for type, 2 for packet-num, 3 for acks
-      std::vector<uint8_t> data_out(msg.data.size() + kMessagePacketHeaderSize);
+      auto& data{*msg.data};
+      std::vector<uint8_t> data_out(data.size() + kMessagePacketHeaderSize);
       data_out[0] = BA_SCENEPACKET_MESSAGE;
       memcpy(data_out.data() + 1, &num, sizeof(num));
       EmbedAcks(real_time, &data_out, 3);
-      memcpy(&(data_out[6]), &(msg.data[0]), msg.data.size());
+      memcpy(&(data_out[6]), data.data(), data.size());
       SendGamePacket(data_out);
       resend_packet_count_++;
       resend_bytes_out_ += data_out.size();
@@ -258,6 +261,16 @@ void Connection::HandleGamePacket(const std::vector<uint8_t>& data) {
   }
 }
 
+void Connection::HandleGamePacketAcks(const std::vector<uint8_t>& data) {
+  // Same size requirements as in HandleGamePacket().
+  if (!data.empty()
+      && ((data[0] == BA_SCENEPACKET_KEEPALIVE && data.size() == 4)
+          || (data[0] == BA_SCENEPACKET_MESSAGE && data.size() >= 7))) {
+    HandleResends(g_core->AppTimeMillisecs(), data,
+                  data[0] == BA_SCENEPACKET_KEEPALIVE ? 1 : 3);
+  }
+}
+
 void Connection::Error(const std::string& msg) {
   // If we've already errored, just ignore.
   if (errored_) {
@@ -304,7 +317,26 @@ void Connection::SendReliableMessage(const std::vector<uint8_t>& data) {
       part_start += part_size;
     }
   }
+  QueueReliableMessage_(std::make_shared<const std::vector<uint8_t>>(data));
+}
+
+void Connection::SendSharedReliableMessage(
+    const std::shared_ptr<const std::vector<uint8_t>>& data) {
+  assert(data && !data->empty());
+  if (connection_dying_) {
+    return;
+  }
 
+  // Large messages get split up per connection like any other.
+  if (data->size() > 480) {
+    SendReliableMessage(*data);
+    return;
+  }
+  QueueReliableMessage_(data);
+}
+
+void Connection::QueueReliableMessage_(
+    std::shared_ptr<const std::vector<uint8_t>> data) {
   uint16_t num = next_out_message_num_++;
 
   // By incrementing reliable-message-num we reset the unreliable num.
@@ -316,19 +348,19 @@ void Connection::SendReliableMessage(const std::vector<uint8_t>& data) {
 
   millisecs_t real_time = g_core->AppTimeMillisecs();
 
-  msg.data = data;
   msg.first_send_time = msg.last_send_time = real_time;
   msg.resend_time = kPacketResendTime;
   msg.acked = false;
 
   // Add our header/acks and go ahead and send this one out.
   // 1 byte for type, 2 for packet-num, 3 for acks
-  std::vector<uint8_t> data_out(data.size() + kMessagePacketHeaderSize);
+  std::vector<uint8_t> data_out(data->size() + kMessagePacketHeaderSize);
 
   data_out[0] = BA_SCENEPACKET_MESSAGE;
   memcpy(data_out.data() + 1, &num, sizeof(num));
   EmbedAcks(real_time, &data_out, 3);
-  memcpy(&(data_out[6]), &(data[0]), data.size());
+  memcpy(&(data_out[6]), data->data(), data->size());
+  msg.data = std::move(data);
   SendGamePacket(data_out);
 }
 
@@ -363,13 +395,31 @@ void Connection::SendUnreliableMessage(const std::vector<uint8_t>& data) {
 }
 
 void Connection::SendJMessage(cJSON* val) {
+  SendReliableMessage(JMessageData(val));
+}
+
+auto Connection::JMessageData(cJSON* val) -> std::vector<uint8_t> {
   char* s = cJSON_PrintUnformatted(val);
   auto s_len = static_cast<size_t>(strlen(s));
   std::vector<uint8_t> msg(1u + s_len + 1u);
   msg[0] = BA_MESSAGE_JMESSAGE;
   memcpy(msg.data() + 1u, s, s_len + 1u);
   free(s);
-  SendReliableMessage(msg);
+  return msg;
+}
+
+auto Connection::ChatMessageData(const std::string& spec_string,
+                                 const std::string& message)
+    -> std::vector<uint8_t> {
+  // 1 byte type + 1 byte spec-string-length + spec-string + message.
+  std::vector<uint8_t> msg(1 + 1 + spec_string.size() + message.size());
+  msg[0] = BA_MESSAGE_CHAT;
+  size_t spec_size = spec_string.size();
+  assert(spec_size < 256);
+  msg[1] = static_cast<uint8_t>(spec_size);
+  memcpy(&(msg[2]), spec_string.c_str(), spec_size);
+  memcpy(&(msg[2 + spec_size]), message.c_str(), message.size());
+  return msg;
 }
 
 void Connection::Update() {
@@ -508,6 +558,7 @@ void Connection::SendGamePacket(const std::vector<uint8_t>& data) {
 
   packet_count_out_++;
   bytes_out_ += data.size();
+  bytes_out_total_ += data.size();
 
   // We huffman-compress gamepackets on their way out.
   std::vector<uint8_t> data_compressed = g_scene_v1->huffman->compress(data);
@@ -3,6 +3,7 @@
 #ifndef BALLISTICA_SCENE_V1_CONNECTION_CONNECTION_H_
 #define BALLISTICA_SCENE_V1_CONNECTION_CONNECTION_H_
 
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -27,6 +28,12 @@ class Connection : public Object {
   /// in the order sent.
   void SendReliableMessage(const std::vector<uint8_t>& data);
 
+  /// Send a reliable message whose data may be shared with other
+  /// connections. Used when broadcasting so each connection's resend
+  /// queue references one copy instead of holding its own.
+  void SendSharedReliableMessage(
+      const std::shared_ptr<const std::vector<uint8_t>>& data);
+
   /// Send an unreliable message to the client; these are not guaranteed to
   /// be delivered, but when they are, they're delivered properly in order
   /// between other unreliable/reliable messages.
@@ -34,6 +41,14 @@ class Connection : public Object {
 
   /// Send a json-based reliable message.
   void SendJMessage(cJSON* val);
+
+  /// Return the reliable-message data for a json-based message.
+  static auto JMessageData(cJSON* val) -> std::vector<uint8_t>;
+
+  /// Return the reliable-message data for a chat message.
+  static auto ChatMessageData(const std::string& spec_string,
+                              const std::string& message)
+      -> std::vector<uint8_t>;
   virtual void Update();
 
   /// Called with raw packets as they come in from the network.
@@ -65,6 +80,7 @@ class Connection : public Object {
   auto GetBytesResentPerSecond() const -> int64_t {
     return last_resend_bytes_out_;
   }
+  auto GetBytesOutTotal() const -> int64_t { return bytes_out_total_; }
   auto current_ping() const -> float { return current_ping_; }
   auto can_communicate() const -> bool { return can_communicate_; }
   auto peer_spec() const -> const PlayerSpec& { return peer_spec_; }
@@ -85,8 +101,13 @@ class Connection : public Object {
   void set_connection_dying(bool val) { connection_dying_ = val; }
   void set_errored(bool val) { errored_ = val; }
 
+  /// Process only the acks carried by a game packet (if any), ignoring
+  /// everything else in it.
+  void HandleGamePacketAcks(const std::vector<uint8_t>& data);
+
  private:
   void ProcessWaitingMessages();
+  void QueueReliableMessage_(std::shared_ptr<const std::vector<uint8_t>> data);
   void HandleResends(millisecs_t real_time, const std::vector<uint8_t>& data,
                      int offset);
   void EmbedAcks(millisecs_t real_time, std::vector<uint8_t>* data, int offset);
@@ -98,7 +119,7 @@ class Connection : public Object {
   };
 
   struct ReliableMessageOut {
-    std::vector<uint8_t> data;
+    std::shared_ptr<const std::vector<uint8_t>> data;
     millisecs_t first_send_time;
     millisecs_t last_send_time;
     millisecs_t resend_time;
@@ -124,6 +145,7 @@ class Connection : public Object {
   int64_t bytes_in_compressed_{};
   int64_t last_packet_count_in_{};
   int64_t packet_count_in_{};
+  int64_t bytes_out_total_{};
   millisecs_t last_average_update_time_{};
   millisecs_t creation_time_{};
   millisecs_t last_prune_time_{};
@@ -4,11 +4,16 @@
 
 #include <Python.h>
 
+#include <algorithm>
+#include <map>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "ballistica/base/assets/assets.h"
 #include "ballistica/base/logic/logic.h"
+#include "ballistica/base/networking/networking.h"
 #include "ballistica/base/networking/network_writer.h"
 #include "ballistica/classic/support/classic_app_mode.h"
 #include "ballistica/core/logging/logging_macros.h"
@@ -18,6 +23,7 @@
 #include "ballistica/scene_v1/support/host_session.h"
 #include "ballistica/scene_v1/support/scene_v1_input_device_delegate.h"
 #include "ballistica/shared/foundation/event_loop.h"
+#include "ballistica/shared/generic/json.h"
 #include "ballistica/shared/python/python.h"
 
 namespace ballistica::scene_v1 {
@@ -55,6 +61,8 @@ void ConnectionSet::RegisterClientController(ClientControllerInterface* c) {
 }
 
 void ConnectionSet::Update() {
+  FlushScreenMessages_();
+
   // First do housekeeping on our client/host connections.
   for (auto&& i : connections_to_clients_) {
     BA_IFDEBUG(Object::WeakRef<ConnectionToClient> test_ref(i.second));
@@ -163,15 +171,7 @@ void ConnectionSet::SendChatMessage(const std::string& message,
     return;
   }
 
-  // 1 byte type + 1 byte spec-string-length + message.
-  std::vector<uint8_t> msg_out(1 + 1 + our_spec_string.size()
-                               + message2.size());
-  msg_out[0] = BA_MESSAGE_CHAT;
-  size_t spec_size = our_spec_string.size();
-  assert(spec_size < 256);
-  msg_out[1] = static_cast<uint8_t>(spec_size);
-  memcpy(&(msg_out[2]), our_spec_string.c_str(), spec_size);
-  memcpy(&(msg_out[2 + spec_size]), message2.c_str(), message2.size());
+  auto msg_out{Connection::ChatMessageData(our_spec_string, message2)};
 
   // If we're a client, send this to the host (it will make its way back to us
   // when they send to clients).
@@ -181,24 +181,7 @@ void ConnectionSet::SendChatMessage(const std::string& message,
     // Ok we're the host.
 
     // Send to all (or at least some) connected clients.
-    for (auto&& i : connections_to_clients_) {
-      // Skip if its going to specific ones and this one doesn't match.
-      if (clients != nullptr) {
-        auto found = false;
-        for (auto&& c : *clients) {
-          if (c == i.second->id()) {
-            found = true;
-          }
-        }
-        if (!found) {
-          continue;
-        }
-      }
-
-      if (i.second->can_communicate()) {
-        i.second->SendReliableMessage(msg_out);
-      }
-    }
+    BroadcastReliableMessage(msg_out, clients);
 
     // And display locally if the message is addressed to all.
     if (clients == nullptr) {
@@ -225,6 +208,8 @@ auto ConnectionSet::GetConnectionsToClients()
 }
 
 void ConnectionSet::Shutdown() {
+  FlushScreenMessages_();
+
   // If we have any client/host connections, give them
   // a chance to shoot off disconnect packets or whatnot.
   for (auto& connection : connections_to_clients_) {
@@ -235,29 +220,36 @@ void ConnectionSet::Shutdown() {
   }
 }
 
-void ConnectionSet::SendScreenMessageToClients(const std::string& s, float r,
-                                               float g, float b) {
+void ConnectionSet::BroadcastReliableMessage(const std::vector<uint8_t>& data,
+                                             const std::vector<int>* clients) {
+  std::shared_ptr<const std::vector<uint8_t>> shared_data;
   for (auto&& i : connections_to_clients_) {
-    if (i.second.exists() && i.second->can_communicate()) {
-      i.second->SendScreenMessage(s, r, g, b);
+    if (!i.second.exists() || !i.second->can_communicate()) {
+      continue;
+    }
+    // Skip if its going to specific ones and this one doesn't match.
+    if (clients != nullptr
+        && std::find(clients->begin(), clients->end(), i.second->id())
+               == clients->end()) {
+      continue;
+    }
+    if (!shared_data) {
+      shared_data = std::make_shared<const std::vector<uint8_t>>(data);
     }
+    i.second->SendSharedReliableMessage(shared_data);
   }
 }
 
+void ConnectionSet::SendScreenMessageToClients(const std::string& s, float r,
+                                               float g, float b) {
+  // These go out in batches on our next update.
+  pending_screen_messages_.push_back({s, r, g, b, true, {}});
+}
+
 void ConnectionSet::SendScreenMessageToSpecificClients(
     const std::string& s, float r, float g, float b,
     const std::vector<int>& clients) {
-  for (auto&& i : connections_to_clients_) {
-    if (i.second.exists() && i.second->can_communicate()) {
-      // Only send if this client is in our list.
-      for (auto c : clients) {
-        if (c == i.second->id()) {
-          i.second->SendScreenMessage(s, r, g, b);
-          break;
-        }
-      }
-    }
-  }
+  pending_screen_messages_.push_back({s, r, g, b, false, clients});
 
   // Now print locally only if -1 is in our list.
   for (auto c : clients) {
@@ -274,6 +266,101 @@ void ConnectionSet::SendScreenMessageToAll(const std::string& s, float r,
   g_base->ScreenMessage(s, {r, g, b});
 }
 
+auto ConnectionSet::ScreenMessageFormat_(int build_number, int batch_format)
+    -> int {
+  // Format 0 is chat-messages, 1 is individual screen-messages, and 2 is
+  // batches.
+  if (build_number < 14248) {
+    return 0;
+  }
+  if (batch_format < 1) {
+    return 1;
+  }
+  return 2;
+}
+
+auto ConnectionSet::ScreenMessagePayloads(
+    const std::vector<PendingScreenMessage>& messages,
+    const std::vector<size_t>& indices, int build_number, int batch_format)
+    -> std::vector<std::shared_ptr<const std::vector<uint8_t>>> {
+  std::vector<std::shared_ptr<const std::vector<uint8_t>>> payloads;
+  if (ScreenMessageFormat_(build_number, batch_format) == 2
+      && indices.size() > 1) {
+    cJSON* msg = cJSON_CreateObject();
+    cJSON_AddNumberToObject(msg, "t", BA_JMESSAGE_SCREEN_MESSAGES);
+    cJSON* entries = cJSON_AddArrayToObject(msg, "m");
+    for (auto m : indices) {
+      auto& entry{messages[m]};
+      cJSON* item = cJSON_CreateArray();
+      cJSON_AddItemToArray(item, cJSON_CreateString(entry.message.c_str()));
+      cJSON_AddItemToArray(item, cJSON_CreateNumber(entry.r));
+      cJSON_AddItemToArray(item, cJSON_CreateNumber(entry.g));
+      cJSON_AddItemToArray(item, cJSON_CreateNumber(entry.b));
+      cJSON_AddItemToArray(entries, item);
+    }
+    payloads.push_back(std::make_shared<const std::vector<uint8_t>>(
+        Connection::JMessageData(msg)));
+    cJSON_Delete(msg);
+  } else {
+    for (auto m : indices) {
+      auto& entry{messages[m]};
+      payloads.push_back(std::make_shared<const std::vector<uint8_t>>(
+          ConnectionToClient::ScreenMessageData(entry.message, entry.r,
+                                                entry.g, entry.b,
+                                                build_number)));
+    }
+  }
+  return payloads;
+}
+
+void ConnectionSet::FlushScreenMessages_() {
+  if (pending_screen_messages_.empty()) {
+    return;
+  }
+  auto messages{std::move(pending_screen_messages_)};
+  pending_screen_messages_.clear();
+
+  // Group clients by which messages they get and which format they want
+  // them in so we only build each distinct payload once.
+  std::map<std::pair<int, std::vector<size_t>>,
+           std::vector<ConnectionToClient*>>
+      groups;
+  for (auto&& i : connections_to_clients_) {
+    auto* client{i.second.get()};
+    if (client == nullptr || !client->can_communicate()) {
+      continue;
+    }
+    std::vector<size_t> indices;
+    for (size_t m = 0; m < messages.size(); ++m) {
+      auto& msg{messages[m]};
+      if (msg.to_all
+          || std::find(msg.clients.begin(), msg.clients.end(), client->id())
+                 != msg.clients.end()) {
+        indices.push_back(m);
+      }
+    }
+    if (indices.empty()) {
+      continue;
+    }
+    groups[{ScreenMessageFormat_(client->build_number(),
+                                 client->screen_message_batch_format()),
+            std::move(indices)}]
+        .push_back(client);
+  }
+
+  for (auto&& [key, clients] : groups) {
+    auto* first{clients.front()};
+    auto payloads{ScreenMessagePayloads(messages, key.second,
+                                        first->build_number(),
+                                        first->screen_message_batch_format())};
+    for (auto* client : clients) {
+      for (auto&& payload : payloads) {
+        client->SendSharedReliableMessage(payload);
+      }
+    }
+  }
+}
+
 void ConnectionSet::PrepareForLaunchHostSession() {
   // If for some reason we're still attached to a host, kill the connection.
   if (connection_to_host_.exists()) {
@@ -346,6 +433,9 @@ auto ConnectionSet::DisconnectClient(int client_id, int ban_seconds) -> bool {
           appmode->BanPlayer(i->second->peer_spec(), 1000 * ban_seconds);
         }
       }
+      // Get any queued screen-messages (such as the kick announcement) to
+      // them before they go.
+      FlushScreenMessages_();
       i->second->RequestDisconnect();
 
       // Do the official local disconnect immediately with the sounds and all
@@ -430,6 +520,22 @@ void ConnectionSet::UnregisterClientController(ClientControllerInterface* c) {
   client_controller_ = nullptr;
 }
 
+void ConnectionSet::HandleClientOverLimits(int client_id,
+                                           const std::string& reason) {
+  assert(g_base->InLogicThread());
+  auto i = connections_to_clients_.find(client_id);
+  if (i == connections_to_clients_.end()) {
+    return;
+  }
+  if (!g_scene_v1->python->ShouldKickClientOverLimits(client_id, reason)) {
+    return;
+  }
+  g_core->logging->Log(LogName::kBaNetworking, LogLevel::kWarning,
+                       "Client '" + i->second->peer_spec().GetShortName()
+                           + "' over " + reason + " limit; kicking.");
+  DisconnectClient(client_id, client_limits_.ban_seconds);
+}
+
 void ConnectionSet::ForceDisconnectClients() {
   for (auto&& i : connections_to_clients_) {
     if (ConnectionToClient* client = i.second.get()) {
@@ -463,6 +569,18 @@ void ConnectionSet::HandleIncomingUDPPacket(const std::vector<uint8_t>& data_in,
       }
       break;
     }
+    case BA_PACKET_CLIENT_COOKIE: {
+      // Host is busy and wants us to prove we're real before it lets us
+      // in.
+      if (data_size == 10) {
+        uint8_t request_id = data[1];
+        ConnectionToHostUDP* hc = GetConnectionToHostUDP();
+        if (hc && hc->request_id() == request_id) {
+          hc->SetCookie(data + 2);
+        }
+      }
+      break;
+    }
     case BA_PACKET_DISCONNECT_FROM_CLIENT_REQUEST: {
       if (data_size == 2) {
         // Client is telling us (host) that it wants to disconnect.
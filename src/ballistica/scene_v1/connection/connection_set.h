@@ -3,6 +3,7 @@
 #ifndef BALLISTICA_SCENE_V1_CONNECTION_CONNECTION_SET_H_
 #define BALLISTICA_SCENE_V1_CONNECTION_CONNECTION_SET_H_
 
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -13,8 +14,28 @@
 
 namespace ballistica::scene_v1 {
 
+/// Newest batched screen-message format we can read or write. Clients
+/// advertise this in their handshake response; hosts only send
+/// BA_JMESSAGE_SCREEN_MESSAGES batches to clients that do.
+const int kScreenMessageBatchFormat = 1;
+
 class ConnectionSet {
  public:
+  /// Caps on what any one client can cost us. Zero values mean no limit.
+  struct ClientLimits {
+    /// Logic-thread time spent on a client's incoming traffic per second.
+    microsecs_t process_time_per_second{};
+    int64_t bytes_in_per_second{};
+    int64_t messages_in_per_second{};
+
+    /// Consecutive over-limit seconds before a client gets kicked (0 to
+    /// never kick; they just keep getting throttled).
+    int strikes_to_kick{};
+
+    /// How long kicked clients are banned for.
+    int ban_seconds{300};
+  };
+
   ConnectionSet();
 
   // Whoever wants to wrangle current client connections should call this
@@ -56,6 +77,15 @@ class ConnectionSet {
   // Returns true if disconnect attempts are supported.
   auto DisconnectClient(int client_id, int ban_seconds) -> bool;
   void ForceDisconnectClients();
+
+  auto client_limits() const -> const ClientLimits& { return client_limits_; }
+  void set_client_limits(const ClientLimits& limits) {
+    client_limits_ = limits;
+  }
+
+  /// Called when a client has been over its limits long enough to be
+  /// kicked. Lets Python weigh in and then kicks them.
+  void HandleClientOverLimits(int client_id, const std::string& reason);
   void PushHostConnectedUDPCall(const SockAddr& addr,
                                 bool print_connect_progress);
   void PushDisconnectFromHostCall();
@@ -94,12 +124,38 @@ class ConnectionSet {
                                           float g, float b,
                                           const std::vector<int>& clients);
 
+  /// Send a reliable message to all connected clients (or only those
+  /// with ids in `clients` if passed). The message data is shared between
+  /// connections instead of being copied for each.
+  void BroadcastReliableMessage(const std::vector<uint8_t>& data,
+                                const std::vector<int>* clients = nullptr);
+
   void HandleIncomingUDPPacket(const std::vector<uint8_t>& data_in,
                                const SockAddr& addr);
   void PushClientDisconnectedCall(int id);
 
+  struct PendingScreenMessage {
+    std::string message;
+    float r{};
+    float g{};
+    float b{};
+    bool to_all{};
+    std::vector<int> clients;
+  };
+
+  /// Build the reliable-message payloads that deliver the messages at
+  /// `indices` to a client of the provided build number and advertised
+  /// screen-message batch format.
+  static auto ScreenMessagePayloads(
+      const std::vector<PendingScreenMessage>& messages,
+      const std::vector<size_t>& indices, int build_number, int batch_format)
+      -> std::vector<std::shared_ptr<const std::vector<uint8_t>>>;
+
  private:
   auto VerifyClientAddr(uint8_t client_id, const SockAddr& addr) -> bool;
+  void FlushScreenMessages_();
+  static auto ScreenMessageFormat_(int build_number, int batch_format)
+      -> int;
 
   // Try to minimize the chance a garbage packet will have this id.
   int next_connection_to_client_id_{113};
@@ -114,6 +170,8 @@ class ConnectionSet {
 
   // Prevents us from printing multiple 'you got disconnected' messages.
   bool printed_host_disconnect_{};
+  ClientLimits client_limits_;
+  std::vector<PendingScreenMessage> pending_screen_messages_;
 };
 
 }  // namespace ballistica::scene_v1
@@ -6,11 +6,14 @@
 
 #include <algorithm>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "ballistica/base/assets/assets.h"
 #include "ballistica/base/audio/audio.h"
 #include "ballistica/base/input/input.h"
+#include "ballistica/base/logic/logic.h"
+#include "ballistica/base/networking/network_writer.h"
 #include "ballistica/base/networking/networking.h"
 #include "ballistica/base/python/base_python.h"
 #include "ballistica/base/support/plus_soft.h"
@@ -20,9 +23,12 @@
 #include "ballistica/scene_v1/connection/connection_set.h"
 #include "ballistica/scene_v1/python/scene_v1_python.h"
 #include "ballistica/scene_v1/support/client_controller_interface.h"
+#include "ballistica/scene_v1/support/client_handshake_info.h"
 #include "ballistica/scene_v1/support/client_input_device.h"
 #include "ballistica/scene_v1/support/client_input_device_delegate.h"
 #include "ballistica/scene_v1/support/host_session.h"
+#include "ballistica/scene_v1/support/session_snapshot.h"
+#include "ballistica/shared/foundation/event_loop.h"
 #include "ballistica/shared/generic/json.h"
 #include "ballistica/shared/generic/utils.h"
 #include "ballistica/shared/python/python.h"
@@ -32,6 +38,12 @@ namespace ballistica::scene_v1 {
 // How long new clients have to wait before starting a kick vote.
 const int kNewClientKickVoteDelay = 60000;
 
+// Most a client can send us while we're decoding its client-info. Clients
+// only send a few small messages this early, so anything past this is
+// garbage or abuse.
+const size_t kMaxHeldMessages = 64;
+const size_t kMaxHeldMessageSize = 32 * 1024;
+
 ConnectionToClient::ConnectionToClient(int id)
     : id_(id),
       protocol_version_{
@@ -101,6 +113,8 @@ void ConnectionToClient::Update() {
 
   millisecs_t real_time = g_core->AppTimeMillisecs();
 
+  UpdateUsage_(real_time);
+
   // If we're waiting for handshake response still, keep sending out handshake
   // attempts.
   if (!can_communicate() && real_time - last_hand_shake_send_time_ > 1000) {
@@ -115,6 +129,9 @@ void ConnectionToClient::Update() {
       // We also add our random salt for hashing.
       dict.AddString("l", our_handshake_salt_);
 
+      // Let newer clients know they can send us binary client-info.
+      dict.AddNumber("ci", kClientHandshakeInfoFormat);
+
       std::string out = dict.PrintUnformatted();
       std::vector<uint8_t> data(3 + out.size());
       data[0] = BA_SCENEPACKET_HANDSHAKE;
@@ -138,7 +155,105 @@ void ConnectionToClient::Update() {
   }
 }
 
+auto ConnectionToClient::GetLimitExceeded_(const Usage& usage)
+    -> const char* {
+  auto* appmode = classic::ClassicAppMode::GetActiveOrWarn();
+  if (!appmode) {
+    return nullptr;
+  }
+  auto& limits{appmode->connections()->client_limits()};
+  if (limits.process_time_per_second > 0
+      && usage.process_time > limits.process_time_per_second) {
+    return "process_time";
+  }
+  if (limits.bytes_in_per_second > 0
+      && usage.bytes_in > limits.bytes_in_per_second) {
+    return "bytes_in";
+  }
+  if (limits.messages_in_per_second > 0
+      && usage.messages_in > limits.messages_in_per_second) {
+    return "messages_in";
+  }
+  return nullptr;
+}
+
+void ConnectionToClient::UpdateUsage_(millisecs_t real_time) {
+  if (real_time - usage_second_start_time_ < 1000) {
+    return;
+  }
+  const char* limit_exceeded{GetLimitExceeded_(usage_current_second_)};
+  usage_last_second_ = usage_current_second_;
+  usage_current_second_ = {};
+  usage_second_start_time_ = real_time;
+  throttled_ = false;
+
+  // Clients that keep going over their limits get kicked.
+  if (limit_exceeded == nullptr) {
+    limit_strikes_ = 0;
+    return;
+  }
+  limit_strikes_++;
+  auto* appmode = classic::ClassicAppMode::GetActiveOrWarn();
+  if (!appmode) {
+    return;
+  }
+  auto strikes_to_kick{appmode->connections()->client_limits().strikes_to_kick};
+  if (strikes_to_kick > 0 && limit_strikes_ >= strikes_to_kick) {
+    limit_strikes_ = 0;
+    appmode->connections()->HandleClientOverLimits(id(), limit_exceeded);
+  }
+}
+
+auto ConnectionToClient::GetThrottledHandling(const std::vector<uint8_t>& data)
+    -> ThrottledHandling {
+  if (data.empty()) {
+    return ThrottledHandling::kIgnore;
+  }
+  switch (data[0]) {
+    case BA_SCENEPACKET_KEEPALIVE:
+    case BA_SCENEPACKET_DISCONNECT:
+      return ThrottledHandling::kFull;
+    case BA_SCENEPACKET_MESSAGE:
+      return ThrottledHandling::kAcksOnly;
+    default:
+      return ThrottledHandling::kIgnore;
+  }
+}
+
 void ConnectionToClient::HandleGamePacket(const std::vector<uint8_t>& data) {
+  // Once a client has used up its budget for the current second we ignore
+  // them until the next. Anything reliable they sent will get resent. We
+  // still take their acks and disconnects though; ignoring those would
+  // only have us resending more to them and keeping them around longer.
+  if (throttled_) {
+    switch (GetThrottledHandling(data)) {
+      case ThrottledHandling::kFull:
+        HandleGamePacket_(data);
+        break;
+      case ThrottledHandling::kAcksOnly:
+        HandleGamePacketAcks(data);
+        break;
+      default:
+        break;
+    }
+    return;
+  }
+
+  // Charge them for the time we spend on this.
+  auto start_time{g_core->AppTimeMicrosecs()};
+  HandleGamePacket_(data);
+  auto process_time{g_core->AppTimeMicrosecs() - start_time};
+  usage_current_second_.process_time += process_time;
+  usage_total_.process_time += process_time;
+  usage_current_second_.bytes_in += static_cast<int64_t>(data.size());
+  usage_total_.bytes_in += static_cast<int64_t>(data.size());
+
+  if (can_communicate() && GetLimitExceeded_(usage_current_second_)) {
+    throttled_ = true;
+  }
+}
+
+void ConnectionToClient::HandleGamePacket_(const std::vector<uint8_t>& data) {
   // If we've errored, just respond to everything with 'GO AWAY!'.
   if (errored()) {
     std::vector<uint8_t> data2(1);
@@ -194,6 +309,20 @@ void ConnectionToClient::HandleGamePacket(const std::vector<uint8_t>& data) {
                             "Ignoring non-string public-device-id data.");
               }
             }
+
+            // Newer builds can take compressed session snapshots.
+            cJSON* snapshot_format = cJSON_GetObjectItem(handshake, "ss");
+            if (cJSON_IsNumber(snapshot_format)) {
+              session_snapshot_format_ = std::min(snapshot_format->valueint,
+                                                  kSessionSnapshotFormat);
+            }
+
+            // ...and batched screen-messages.
+            cJSON* batch_format = cJSON_GetObjectItem(handshake, "sm");
+            if (cJSON_IsNumber(batch_format)) {
+              screen_message_batch_format_ = std::min(
+                  batch_format->valueint, kScreenMessageBatchFormat);
+            }
           } else {
             BA_LOG_ONCE(LogName::kBaNetworking, LogLevel::kWarning,
                         "Ignoring non-object player-data container.");
@@ -353,31 +482,28 @@ void ConnectionToClient::Error(const std::string& msg) {
 
 void ConnectionToClient::SendScreenMessage(const std::string& s, float r,
                                            float g, float b) {
+  SendReliableMessage(ScreenMessageData(s, r, g, b, build_number()));
+}
+
+auto ConnectionToClient::ScreenMessageData(const std::string& s, float r,
+                                           float g, float b, int build_number)
+    -> std::vector<uint8_t> {
   // Older clients don't support the screen-message message, so in that case
   // we just send it as a chat-message from <HOST>.
-  if (build_number() < 14248) {
-    std::string value = g_base->assets->CompileResourceString(s);
-    std::string our_spec_string =
-        PlayerSpec::GetDummyPlayerSpec("<HOST>").GetSpecString();
-    std::vector<uint8_t> msg_out(1 + 1 + our_spec_string.size() + value.size());
-    msg_out[0] = BA_MESSAGE_CHAT;
-    size_t spec_size = our_spec_string.size();
-    assert(spec_size < 256);
-    msg_out[1] = static_cast<uint8_t>(spec_size);
-    memcpy(&(msg_out[2]), our_spec_string.c_str(),
-           static_cast<size_t>(spec_size));
-    memcpy(&(msg_out[2 + spec_size]), value.c_str(), value.size());
-    SendReliableMessage(msg_out);
-  } else {
-    cJSON* msg = cJSON_CreateObject();
-    cJSON_AddNumberToObject(msg, "t", BA_JMESSAGE_SCREEN_MESSAGE);
-    cJSON_AddStringToObject(msg, "m", s.c_str());
-    cJSON_AddNumberToObject(msg, "r", r);
-    cJSON_AddNumberToObject(msg, "g", g);
-    cJSON_AddNumberToObject(msg, "b", b);
-    SendJMessage(msg);
-    cJSON_Delete(msg);
+  if (build_number < 14248) {
+    return ChatMessageData(
+        PlayerSpec::GetDummyPlayerSpec("<HOST>").GetSpecString(),
+        g_base->assets->CompileResourceString(s));
   }
+  cJSON* msg = cJSON_CreateObject();
+  cJSON_AddNumberToObject(msg, "t", BA_JMESSAGE_SCREEN_MESSAGE);
+  cJSON_AddStringToObject(msg, "m", s.c_str());
+  cJSON_AddNumberToObject(msg, "r", r);
+  cJSON_AddNumberToObject(msg, "g", g);
+  cJSON_AddNumberToObject(msg, "b", b);
+  auto data{JMessageData(msg)};
+  cJSON_Delete(msg);
+  return data;
 }
 
 void ConnectionToClient::HandleMessagePacket(
@@ -393,9 +519,32 @@ void ConnectionToClient::HandleMessagePacket(
     return;
   }
 
+  message_counts_[buffer[0]]++;
+  usage_current_second_.messages_in++;
+  usage_total_.messages_in++;
+
+  // Anything arriving while we're decoding client-info waits for it.
+  if (message_hold_.Hold(buffer)) {
+    if (message_hold_.overflowed()) {
+      BA_LOG_ONCE(LogName::kBaNetworking, LogLevel::kWarning,
+                  "Too many messages ahead of clientinfo; kicking.");
+      Error("");
+    }
+    return;
+  }
+  HandleMessage_(buffer);
+}
+
+void ConnectionToClient::HandleMessage_(const std::vector<uint8_t>& buffer) {
+  auto* appmode = classic::ClassicAppMode::GetActiveOrWarn();
+  if (!appmode) {
+    return;
+  }
+
   // If the first message we get is not client-info, it means we're talking to
   // an older client that won't be sending us info.
-  if (!got_client_info_ && buffer[0] != BA_MESSAGE_CLIENT_INFO) {
+  if (!got_client_info_ && buffer[0] != BA_MESSAGE_CLIENT_INFO
+      && buffer[0] != BA_MESSAGE_CLIENT_INFO_BINARY) {
     build_number_ = 0;
     got_client_info_ = true;
   }
@@ -481,6 +630,52 @@ void ConnectionToClient::HandleMessagePacket(
       break;
     }
 
+    case BA_MESSAGE_CLIENT_INFO_BINARY: {
+      if (got_client_info_) {
+        BA_LOG_ONCE(LogName::kBaNetworking, LogLevel::kWarning,
+                    "Ignoring repeat binary clientinfo msg.");
+        break;
+      }
+      got_client_info_ = true;
+
+      // Decoding and validating happens on the net-write thread so that a
+      // burst of joins doesn't stall the logic thread; we get handed back
+      // a native struct to apply. Everything else this client sends in the
+      // meantime is held and handled after that, so joins and such always
+      // see their actual build-number and profiles.
+      auto* event_loop{g_base->network_writer->event_loop()};
+      if (!event_loop->CheckPushSafety()) {
+        BA_LOG_ONCE(LogName::kBaNetworking, LogLevel::kWarning,
+                    "Net-write thread backed up; decoding clientinfo here.");
+        ClientHandshakeInfo info;
+        std::string error;
+        bool valid{info.Decode(buffer, &error)};
+        ApplyClientHandshakeInfo_(info, valid, error);
+        break;
+      }
+      message_hold_.Start();
+      event_loop->PushCall([buffer, id = id_, self = this] {
+        ClientHandshakeInfo info;
+        std::string error;
+        bool valid{info.Decode(buffer, &error)};
+        g_base->logic->event_loop()->PushCall(
+            [info = std::move(info), valid, error, id, self] {
+              // Make sure the connection is still around; we can't hold
+              // a ref to it from another thread.
+              auto* appmode = classic::ClassicAppMode::GetActiveOrWarn();
+              if (!appmode) {
+                return;
+              }
+              auto&& clients{appmode->connections()->connections_to_clients()};
+              auto i{clients.find(id)};
+              if (i != clients.end() && i->second.get() == self) {
+                self->FinishClientHandshakeInfo_(info, valid, error);
+              }
+            });
+      });
+      break;
+    }
+
     case BA_MESSAGE_CLIENT_PLAYER_PROFILES_JSON: {
       // Newer type using json.
       //
@@ -612,25 +807,11 @@ void ConnectionToClient::HandleMessagePacket(
                   break;
                 }
 
-                std::string spec_string = GetCombinedSpec().GetSpecString();
-                std::vector<uint8_t> msg_out(1 + 1 + spec_string.size()
-                                             + message.size());
-                msg_out[0] = BA_MESSAGE_CHAT;
-                size_t spec_size = spec_string.size();
-                assert(spec_size < 256);
-                msg_out[1] = static_cast<unsigned char>(spec_size);
-                memcpy(&(msg_out[2]), spec_string.c_str(),
-                       static_cast<size_t>(spec_size));
-                memcpy(&(msg_out[2 + spec_size]), message.c_str(),
-                       message.size());
+                auto msg_out{ChatMessageData(
+                    GetCombinedSpec().GetSpecString(), message)};
 
                 // Send it out to all clients.
-                for (auto&& i :
-                     appmode->connections()->connections_to_clients()) {
-                  if (i.second->can_communicate()) {
-                    i.second->SendReliableMessage(msg_out);
-                  }
-                }
+                appmode->connections()->BroadcastReliableMessage(msg_out);
 
                 // Display it locally.
                 appmode->LocalDisplayChatMessage(msg_out);
@@ -824,10 +1005,92 @@ auto ConnectionToClient::GetClientInputDevice(int remote_id)
   return i->second;
 }
 
+auto ConnectionToClient::MessageHold::Hold(const std::vector<uint8_t>& buffer)
+    -> bool {
+  if (!holding_) {
+    return false;
+  }
+  // Once over our limits we just swallow things until the connection is
+  // torn down.
+  if (overflowed_) {
+    return true;
+  }
+  size_ += buffer.size();
+  if (messages_.size() >= kMaxHeldMessages || size_ > kMaxHeldMessageSize) {
+    overflowed_ = true;
+    messages_.clear();
+    return true;
+  }
+  messages_.push_back(buffer);
+  return true;
+}
+
+auto ConnectionToClient::MessageHold::Release()
+    -> std::vector<std::vector<uint8_t>> {
+  holding_ = false;
+  std::vector<std::vector<uint8_t>> messages;
+  messages.swap(messages_);
+  size_ = 0;
+  return messages;
+}
+
 auto ConnectionToClient::GetAsUDP() -> ConnectionToClientUDP* {
   return nullptr;
 }
 
+void ConnectionToClient::FinishClientHandshakeInfo_(
+    const ClientHandshakeInfo& info, bool valid, const std::string& error) {
+  assert(g_base->InLogicThread());
+  ApplyClientHandshakeInfo_(info, valid, error);
+
+  // Now handle everything that came in while we were decoding, in order.
+  for (auto&& buffer : message_hold_.Release()) {
+    if (errored()) {
+      break;
+    }
+    HandleMessage_(buffer);
+  }
+}
+
+void ConnectionToClient::ApplyClientHandshakeInfo_(
+    const ClientHandshakeInfo& info, bool valid, const std::string& error) {
+  assert(g_base->InLogicThread());
+  if (errored()) {
+    return;
+  }
+  auto* appmode = classic::ClassicAppMode::GetActiveOrWarn();
+  if (!appmode) {
+    return;
+  }
+  if (!valid) {
+    BA_LOG_ONCE(LogName::kBaNetworking, LogLevel::kWarning,
+                "Got invalid binary clientinfo message: " + error + ".");
+    Error("");
+    return;
+  }
+  build_number_ = info.build_number;
+  token_ = info.token;
+  peer_hash_ = info.peer_hash;
+  if (token_.empty()) {
+    BA_LOG_ONCE(LogName::kBaNetworking, LogLevel::kWarning,
+                "No token in clientinfo msg.");
+    Error("");
+    return;
+  }
+
+  // Kick off a query to the master-server for this client's info.
+  g_base->Plus()->ClientInfoQuery(
+      token_, our_handshake_player_spec_str_ + our_handshake_salt_, peer_hash_,
+      build_number_);
+
+  // Same rules as the json profiles message; only use what they tell us
+  // if we're not requiring official info from the master server.
+  if (!appmode->require_client_authentication()
+      && !got_info_from_master_server_) {
+    player_profiles_ = info.GetPlayerProfilesAsPython();
+  }
+}
+
 void ConnectionToClient::HandleMasterServerClientInfo(PyObject* info_obj) {
   auto* appmode = classic::ClassicAppMode::GetActiveOrThrow();
 
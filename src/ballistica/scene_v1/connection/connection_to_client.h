@@ -30,6 +30,12 @@ class ConnectionToClient : public Connection {
   auto build_number() const -> int { return build_number_; }
   void SendScreenMessage(const std::string& s, float r = 1.0f, float g = 1.0f,
                          float b = 1.0f);
+
+  /// Return the reliable-message data for a screen message as clients of
+  /// a given build number expect it.
+  static auto ScreenMessageData(const std::string& s, float r, float g,
+                                float b, int build_number)
+      -> std::vector<uint8_t>;
   auto token() const -> const std::string& { return token_; }
   void HandleMasterServerClientInfo(PyObject* info_obj);
 
@@ -52,6 +58,16 @@ class ConnectionToClient : public Connection {
   }
   auto next_kick_vote_allow_time() const { return next_kick_vote_allow_time_; }
   auto public_device_id() const { return public_device_id_; }
+
+  /// Newest BA_MESSAGE_SESSION_SNAPSHOT format this client can take, or 0
+  /// if it can't take them at all.
+  auto session_snapshot_format() const { return session_snapshot_format_; }
+
+  /// Newest batched screen-message format this client can take, or 0 if
+  /// it needs them one at a time.
+  auto screen_message_batch_format() const {
+    return screen_message_batch_format_;
+  }
   // Returns a spec for this client that incorporates their player names
   // or their peer name if they have no players.
   auto GetCombinedSpec() -> PlayerSpec;
@@ -61,9 +77,81 @@ class ConnectionToClient : public Connection {
     return protocol_version_;
   }
 
+  /// What a client's incoming traffic has cost us.
+  struct Usage {
+    microsecs_t process_time{};
+    int64_t bytes_in{};
+    int64_t messages_in{};
+  };
+
+  /// Usage since this client connected.
+  auto usage_total() const -> const Usage& { return usage_total_; }
+
+  /// Usage over the most recent full second.
+  auto usage_last_second() const -> const Usage& { return usage_last_second_; }
+
+  /// Incoming message counts, indexed by message type.
+  auto message_counts() const -> const int64_t* { return message_counts_; }
+
+  /// How many seconds in a row this client has been over its limits.
+  auto limit_strikes() const { return limit_strikes_; }
+
+  /// Whether we're ignoring this client for the rest of the current
+  /// second due to it being over its limits.
+  auto throttled() const { return throttled_; }
+
+  /// How much of a game packet we still handle while a client is
+  /// throttled.
+  enum class ThrottledHandling {
+    /// Ignore it entirely.
+    kIgnore,
+    /// Take the acks it carries but ignore its contents.
+    kAcksOnly,
+    /// Handle it normally (and without charging the client for it).
+    kFull
+  };
+  static auto GetThrottledHandling(const std::vector<uint8_t>& data)
+      -> ThrottledHandling;
+
+  /// Holds on to messages that arrive while a client's binary client-info
+  /// is being decoded off the logic thread, so nothing that follows it
+  /// (joins in particular) gets handled before the client's build-number
+  /// and profiles are in.
+  class MessageHold {
+   public:
+    /// Start holding everything passed to Hold().
+    void Start() { holding_ = true; }
+
+    /// If we're holding, keep a copy of a message and return true.
+    auto Hold(const std::vector<uint8_t>& buffer) -> bool;
+
+    /// Stop holding and return everything held, in arrival order.
+    auto Release() -> std::vector<std::vector<uint8_t>>;
+
+    auto holding() const { return holding_; }
+
+    /// Whether we've been sent more than we're willing to hold; the
+    /// connection should be dropped.
+    auto overflowed() const { return overflowed_; }
+
+   private:
+    std::vector<std::vector<uint8_t>> messages_;
+    size_t size_{};
+    bool holding_{};
+    bool overflowed_{};
+  };
+
  private:
+  void HandleMessage_(const std::vector<uint8_t>& buffer);
+  void FinishClientHandshakeInfo_(const ClientHandshakeInfo& info, bool valid,
+                                  const std::string& error);
+  void HandleGamePacket_(const std::vector<uint8_t>& buffer);
+  void UpdateUsage_(millisecs_t real_time);
+  static auto GetLimitExceeded_(const Usage& usage) -> const char*;
   virtual auto ShouldPrintIncompatibleClientErrors() const -> bool;
   auto GetClientInputDevice(int remote_id) -> ClientInputDevice*;
+  void ApplyClientHandshakeInfo_(const ClientHandshakeInfo& info, bool valid,
+                                 const std::string& error);
   void Error(const std::string& error_msg) override;
 
   int protocol_version_;
@@ -76,6 +164,8 @@ class ConnectionToClient : public Connection {
   millisecs_t last_hand_shake_send_time_{};
   int id_{-1};
   int build_number_{};
+  int session_snapshot_format_{};
+  int screen_message_batch_format_{};
   bool got_client_info_{};
   bool kick_voted_{};
   bool kick_vote_choice_{};
@@ -88,6 +178,14 @@ class ConnectionToClient : public Connection {
   millisecs_t chat_block_time_{};
   millisecs_t last_remove_player_time_{-99999};
   int next_chat_block_seconds_{10};
+  Usage usage_total_;
+  Usage usage_current_second_;
+  Usage usage_last_second_;
+  int64_t message_counts_[256]{};
+  millisecs_t usage_second_start_time_{};
+  int limit_strikes_{};
+  bool throttled_{};
+  MessageHold message_hold_;
 };
 
 }  // namespace ballistica::scene_v1
@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "ballistica/base/logic/logic.h"
+#include "ballistica/base/networking/network_reader.h"
 #include "ballistica/base/networking/network_writer.h"
 #include "ballistica/classic/support/classic_app_mode.h"
 #include "ballistica/core/core.h"
@@ -24,12 +25,15 @@ ConnectionToClientUDP::ConnectionToClientUDP(const SockAddr& addr,
       client_instance_uuid_(std::move(client_name)),
       last_client_response_time_millisecs_(
           static_cast<millisecs_t>(g_base->logic->display_time() * 1000.0)),
-      did_die_(false) {}
+      did_die_(false) {
+  g_base->network_reader->admission().SetClientAddr(client_id, addr);
+}
 
 ConnectionToClientUDP::~ConnectionToClientUDP() {
   // This prevents anything from trying to send
   // (and thus crashing in pure-virtual SendGamePacketCompressed) as we die.
   set_connection_dying(true);
+  g_base->network_reader->admission().ClearClientAddr(id(), *addr_);
 }
 
 void ConnectionToClientUDP::SendGamePacketCompressed(
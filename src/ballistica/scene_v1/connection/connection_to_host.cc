@@ -20,8 +20,11 @@
 #include "ballistica/core/logging/logging.h"
 #include "ballistica/core/logging/logging_macros.h"
 #include "ballistica/core/python/core_python.h"
+#include "ballistica/scene_v1/connection/connection_set.h"
+#include "ballistica/scene_v1/support/client_handshake_info.h"
 #include "ballistica/scene_v1/support/client_session_net.h"
 #include "ballistica/scene_v1/support/scene_v1_input_device_delegate.h"
+#include "ballistica/scene_v1/support/session_snapshot.h"
 #include "ballistica/shared/generic/json.h"
 #include "ballistica/shared/generic/utils.h"
 
@@ -137,6 +140,12 @@ void ConnectionToHost::HandleGamePacket(const std::vector<uint8_t>& data) {
         // use this to combat spammers.
         dict.AddString("d", g_base->platform->GetPublicDeviceUUID());
 
+        // Let the host know it can send us compressed session snapshots.
+        dict.AddNumber("ss", kSessionSnapshotFormat);
+
+        // ...and batched screen-messages.
+        dict.AddNumber("sm", kScreenMessageBatchFormat);
+
         std::string out = dict.PrintUnformatted();
 
         std::vector<uint8_t> data2(3 + out.size());
@@ -190,6 +199,13 @@ void ConnectionToHost::HandleGamePacket(const std::vector<uint8_t>& data) {
               if (cJSON_IsString(salt)) {
                 peer_hash_input_ += salt->valuestring;
               }
+
+              // Newer hosts accept our client-info in binary form.
+              cJSON* ci = cJSON_GetObjectItem(handshake, "ci");
+              if (cJSON_IsNumber(ci)) {
+                host_client_info_format_ =
+                    std::min(ci->valueint, kClientHandshakeInfoFormat);
+              }
             }
             cJSON_Delete(handshake);
           }
@@ -227,73 +243,13 @@ void ConnectionToHost::HandleGamePacket(const std::vector<uint8_t>& data) {
         client_session_ = cs;
         cs->SetConnectionToHost(this);
 
-        // The very first thing we send is our client-info
-        // which is a json dict with arbitrary data.
-        {
-          JsonDict dict;
-          dict.AddNumber("b", kEngineBuildNumber);
-
-          g_base->Plus()->V1SetClientInfo(&dict);
-
-          // Pass the hash we generated from their handshake; they can use
-          // this to make sure we're who we say we are.
-          dict.AddString("ph", peer_hash_);
-          std::string info = dict.PrintUnformatted();
-          std::vector<uint8_t> msg(info.size() + 1);
-          msg[0] = BA_MESSAGE_CLIENT_INFO;
-          memcpy(&(msg[1]), info.c_str(), info.size());
-          SendReliableMessage(msg);
-        }
-
-        // Send them our player-profiles so we can use them on their end.
-        // (the host generally will pull these from the master server
-        // to prevent cheating, but in some cases these are used)
-
-        // On newer hosts we send these as json.
-        if (protocol_version_ >= 32) {
-          // (This is a borrowed ref)
-          PyObject* profiles =
-              g_base->python->GetRawConfigValue("Player Profiles");
-          PythonRef empty_dict;
-          if (!profiles) {
-            g_core->logging->Log(
-                LogName::kBaNetworking, LogLevel::kError,
-                "No profiles found; sending empty list to host");
-            empty_dict.Steal(PyDict_New());
-            profiles = empty_dict.get();
-          }
-          if (profiles != nullptr) {
-            // Dump them to a json string.
-            PythonRef args(Py_BuildValue("(O)", profiles), PythonRef::kSteal);
-            PythonRef keywds(Py_BuildValue("{s(ss)}", "separators", ",", ":"),
-                             PythonRef::kSteal);
-            PythonRef results =
-                g_core->python->objs()
-                    .Get(core::CorePython::ObjID::kJsonDumpsCall)
-                    .Call(args, keywds);
-            if (!results.exists()) {
-              g_core->logging->Log(LogName::kBaNetworking, LogLevel::kError,
-                                   "Error getting json dump of local profiles");
-            } else {
-              try {
-                // Pull the string as utf8 and send.
-                std::string s = results.ValueAsLString();
-                std::vector<uint8_t> msg(s.size() + 1);
-                msg[0] = BA_MESSAGE_CLIENT_PLAYER_PROFILES_JSON;
-                memcpy(&(msg[1]), &s[0], s.size());
-                SendReliableMessage(msg);
-              } catch (const std::exception& e) {
-                g_core->logging->Log(
-                    LogName::kBaNetworking, LogLevel::kError,
-                    std::string("Error sending player profiles to host: ")
-                        + e.what());
-              }
-            }
-          }
+        // The very first thing we send is our client-info. Hosts that
+        // support it get this in compact binary form along with our
+        // player-profiles; older ones get json.
+        if (host_client_info_format_ >= 1) {
+          SendClientInfoBinary_();
         } else {
-          g_core->logging->Log(
-              LogName::kBaNetworking, LogLevel::kError,
-              "Connected to old protocol; can't send player profiles");
+          SendClientInfoJson_();
         }
       }
       break;
@@ -316,6 +272,97 @@ void ConnectionToHost::HandleGamePacket(const std::vector<uint8_t>& data) {
 
 #pragma clang diagnostic pop
 
+void ConnectionToHost::SendClientInfoBinary_() {
+  ClientHandshakeInfo info;
+  info.build_number = kEngineBuildNumber;
+
+  // Let plus fill in a json dict the same as for older hosts and pull our
+  // token from that.
+  JsonDict dict;
+  g_base->Plus()->V1SetClientInfo(&dict);
+  cJSON* token = cJSON_GetObjectItem(dict.obj(), "tk");
+  if (cJSON_IsString(token)) {
+    info.token = token->valuestring;
+  }
+
+  // Pass the hash we generated from their handshake; they can use this to
+  // make sure we're who we say we are.
+  info.peer_hash = peer_hash_;
+
+  // The host generally pulls our profiles from the master server to
+  // prevent cheating, but in some cases uses these.
+  info.SetPlayerProfilesFromPython(
+      g_base->python->GetRawConfigValue("Player Profiles"));
+  SendReliableMessage(info.Encode());
+}
+
+void ConnectionToHost::SendClientInfoJson_() {
+  // Client-info is a json dict with arbitrary data.
+  {
+    JsonDict dict;
+    dict.AddNumber("b", kEngineBuildNumber);
+
+    g_base->Plus()->V1SetClientInfo(&dict);
+
+    // Pass the hash we generated from their handshake; they can use
+    // this to make sure we're who we say we are.
+    dict.AddString("ph", peer_hash_);
+    std::string info = dict.PrintUnformatted();
+    std::vector<uint8_t> msg(info.size() + 1);
+    msg[0] = BA_MESSAGE_CLIENT_INFO;
+    memcpy(&(msg[1]), info.c_str(), info.size());
+    SendReliableMessage(msg);
+  }
+
+  // Send them our player-profiles so we can use them on their end.
+  // (the host generally will pull these from the master server
+  // to prevent cheating, but in some cases these are used)
+
+  // On newer hosts we send these as json.
+  if (protocol_version_ >= 32) {
+    // (This is a borrowed ref)
+    PyObject* profiles = g_base->python->GetRawConfigValue("Player Profiles");
+    PythonRef empty_dict;
+    if (!profiles) {
+      g_core->logging->Log(LogName::kBaNetworking, LogLevel::kError,
+                           "No profiles found; sending empty list to host");
+      empty_dict.Steal(PyDict_New());
+      profiles = empty_dict.get();
+    }
+    if (profiles != nullptr) {
+      // Dump them to a json string.
+      PythonRef args(Py_BuildValue("(O)", profiles), PythonRef::kSteal);
+      PythonRef keywds(Py_BuildValue("{s(ss)}", "separators", ",", ":"),
+                       PythonRef::kSteal);
+      PythonRef results = g_core->python->objs()
+                              .Get(core::CorePython::ObjID::kJsonDumpsCall)
+                              .Call(args, keywds);
+      if (!results.exists()) {
+        g_core->logging->Log(LogName::kBaNetworking, LogLevel::kError,
+                             "Error getting json dump of local profiles");
+      } else {
+        try {
+          // Pull the string as utf8 and send.
+          std::string s = results.ValueAsLString();
+          std::vector<uint8_t> msg(s.size() + 1);
+          msg[0] = BA_MESSAGE_CLIENT_PLAYER_PROFILES_JSON;
+          memcpy(&(msg[1]), &s[0], s.size());
+          SendReliableMessage(msg);
+        } catch (const std::exception& e) {
+          g_core->logging->Log(
+              LogName::kBaNetworking, LogLevel::kError,
+              std::string("Error sending player profiles to host: ")
+                  + e.what());
+        }
+      }
+    }
+  } else {
+    g_core->logging->Log(
+        LogName::kBaNetworking, LogLevel::kError,
+        "Connected to old protocol; can't send player profiles");
+  }
+}
+
 void ConnectionToHost::HandleMessagePacket(const std::vector<uint8_t>& buffer) {
   assert(g_base->InLogicThread());
 
@@ -423,6 +470,29 @@ void ConnectionToHost::HandleMessagePacket(const std::vector<uint8_t>& buffer) {
                   }
                   break;
                 }
+                case BA_JMESSAGE_SCREEN_MESSAGES: {
+                  // A list of [message, r, g, b] entries.
+                  cJSON* m_obj = cJSON_GetObjectItem(msg, "m");
+                  cJSON* entry;
+                  cJSON_ArrayForEach(entry, m_obj) {
+                    if (cJSON_GetArraySize(entry) != 4) {
+                      continue;
+                    }
+                    cJSON* s_obj = cJSON_GetArrayItem(entry, 0);
+                    cJSON* r_obj = cJSON_GetArrayItem(entry, 1);
+                    cJSON* g_obj = cJSON_GetArrayItem(entry, 2);
+                    cJSON* b_obj = cJSON_GetArrayItem(entry, 3);
+                    if (cJSON_IsString(s_obj) && cJSON_IsNumber(r_obj)
+                        && cJSON_IsNumber(g_obj) && cJSON_IsNumber(b_obj)) {
+                      g_base->ScreenMessage(
+                          s_obj->valuestring,
+                          {static_cast<float>(r_obj->valuedouble),
+                           static_cast<float>(g_obj->valuedouble),
+                           static_cast<float>(b_obj->valuedouble)});
+                    }
+                  }
+                  break;
+                }
                 default:
                   break;
               }
@@ -578,7 +648,8 @@ void ConnectionToHost::HandleMessagePacket(const std::vector<uint8_t>& buffer) {
 
     case BA_MESSAGE_SESSION_COMMANDS:
     case BA_MESSAGE_SESSION_RESET:
-    case BA_MESSAGE_SESSION_DYNAMICS_CORRECTION: {
+    case BA_MESSAGE_SESSION_DYNAMICS_CORRECTION:
+    case BA_MESSAGE_SESSION_SNAPSHOT: {
       // These commands are consumed directly by the session.
       if (client_session_.exists()) {
         client_session_->HandleSessionMessage(buffer);
@@ -30,6 +30,9 @@ class ConnectionToHost : public Connection {
   }
 
  private:
+  void SendClientInfoBinary_();
+  void SendClientInfoJson_();
+
   std::string party_name_;
   std::string peer_hash_input_;
   std::string peer_hash_;
@@ -39,6 +42,7 @@ class ConnectionToHost : public Connection {
   bool got_host_info_{};
   int protocol_version_{-1};
   int build_number_{};
+  int host_client_info_format_{};
   millisecs_t last_ping_send_time_{};
   // the client-session that we're driving
   Object::WeakRef<ClientSession> client_session_;
@@ -7,6 +7,7 @@
 
 #include "ballistica/base/assets/assets.h"
 #include "ballistica/base/logic/logic.h"
+#include "ballistica/base/networking/network_reader.h"
 #include "ballistica/base/networking/network_writer.h"
 #include "ballistica/classic/support/classic_app_mode.h"
 #include "ballistica/core/core.h"
@@ -38,6 +39,7 @@ ConnectionToHostUDP::ConnectionToHostUDP(const SockAddr& addr)
       last_host_response_time_millisecs_(
           static_cast<millisecs_t>(g_base->logic->display_time() * 1000.0)) {
   GetRequestID_();
+  g_base->network_reader->admission().SetHostAddr(addr);
   if (auto* appmode = classic::ClassicAppMode::GetActiveOrWarn()) {
     if (appmode->connections()->GetPrintUDPConnectProgress()) {
       g_base->ScreenMessage(
@@ -50,6 +52,15 @@ ConnectionToHostUDP::~ConnectionToHostUDP() {
   // This prevents anything from trying to send (and thus crashing in
   // pure-virtual SendGamePacketCompressed) as we die.
   set_connection_dying(true);
+  g_base->network_reader->admission().ClearHostAddr(*addr_);
+}
+
+void ConnectionToHostUDP::SetCookie(const uint8_t* cookie) {
+  memcpy(cookie_, cookie, sizeof(cookie_));
+  have_cookie_ = true;
+
+  // Get a new request out with it right away.
+  last_client_id_request_time_ = 0;
 }
 
 void ConnectionToHostUDP::GetRequestID_() {
@@ -80,14 +91,18 @@ void ConnectionToHostUDP::Update() {
 
       // Client request packet: contains our protocol version (2 bytes), our
       // request id (1 byte), and our session-identifier (remainder of the
-      // message).
+      // message). If the host has given us a cookie, that goes in front.
       const std::string& uuid{g_base->GetAppInstanceUUID()};
-      std::vector<uint8_t> msg(4 + uuid.size());
-      msg[0] = BA_PACKET_CLIENT_REQUEST;
+      size_t cookie_size{have_cookie_ ? sizeof(cookie_) : 0};
+      std::vector<uint8_t> msg(4 + cookie_size + uuid.size());
+      msg[0] = have_cookie_ ? BA_PACKET_CLIENT_REQUEST_COOKIE
+                            : BA_PACKET_CLIENT_REQUEST;
+      memcpy(&(msg[1]), cookie_, cookie_size);
+      uint8_t* body{&(msg[1 + cookie_size])};
       auto p_version = static_cast<uint16_t>(protocol_version());
-      memcpy(&(msg[1]), &p_version, 2);
-      msg[3] = request_id_;
-      memcpy(&(msg[4]), uuid.c_str(), uuid.size());
+      memcpy(body, &p_version, 2);
+      body[2] = request_id_;
+      memcpy(body + 3, uuid.c_str(), uuid.size());
       g_base->network_writer->PushSendToCall(msg, *addr_);
     }
   }
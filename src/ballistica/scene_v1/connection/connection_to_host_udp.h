@@ -23,6 +23,9 @@ class ConnectionToHostUDP : public ConnectionToHost {
   void set_client_id(int val) { client_id_ = val; }
   auto client_id() const -> int { return client_id_; }
 
+  /// The host wants us to include a cookie in our requests.
+  void SetCookie(const uint8_t* cookie);
+
   /// Attempt connecting via a different protocol. If none are left to try,
   /// returns false.
   auto SwitchProtocol() -> bool;
@@ -38,6 +41,8 @@ class ConnectionToHostUDP : public ConnectionToHost {
   void GetRequestID_();
 
   bool did_die_{};
+  bool have_cookie_{};
+  uint8_t cookie_[8]{};
   uint8_t request_id_{};
   int client_id_{};
   millisecs_t last_client_id_request_time_{};
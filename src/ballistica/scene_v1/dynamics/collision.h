@@ -29,6 +29,7 @@ class Collision : public Object {
   float y{};
   float z{};
   float impact{};
+  float impulse{};  // Rough impulse needed to stop the parts closing.
   float skid{};
   float roll{};
   Object::WeakRef<Part> src_part;  // Ref to make sure still alive.
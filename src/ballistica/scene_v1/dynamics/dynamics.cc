@@ -2,12 +2,15 @@
 
 #include "ballistica/scene_v1/dynamics/dynamics.h"
 
+#include <algorithm>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "ballistica/base/audio/audio.h"
 #include "ballistica/base/audio/audio_source.h"
 #include "ballistica/base/dynamics/collision_cache.h"
+#include "ballistica/base/support/step_profiler.h"
 #include "ballistica/core/core.h"
 #include "ballistica/core/logging/logging.h"
 #include "ballistica/scene_v1/assets/scene_sound.h"
@@ -26,6 +29,13 @@ namespace ballistica::scene_v1 {
 //  we may get contacts only at one end of an object, etc.
 #define MAX_CONTACTS 20
 
+// Bodies whose squared linear and angular speeds stay under these for
+// kAutoDisableSteps steps in a row are put to sleep until something
+// touches them or a joint pulls them along.
+const int kAutoDisableSteps{10};
+const float kAutoDisableLinearThreshold{0.1f};
+const float kAutoDisableAngularThreshold{0.1f};
+
 // Given two parts, returns true if part1 is major in
 // the storage order.
 static auto IsInStoreOrder(int64_t node1, int part1, int64_t node2, int part2)
@@ -44,6 +54,34 @@ static auto IsInStoreOrder(int64_t node1, int part1, int64_t node2, int part2)
   }
 }
 
+// Names for material actions in profiling output. These are string
+// literals so they double as stable profiler keys.
+static auto MaterialActionName(MaterialAction::Type type) -> const char* {
+  switch (type) {
+    case MaterialAction::Type::NODE_MESSAGE:
+      return "node message";
+    case MaterialAction::Type::SCRIPT_COMMAND:
+      return "script command";
+    case MaterialAction::Type::SCRIPT_CALL:
+      return "python call";
+    case MaterialAction::Type::SOUND:
+      return "sound";
+    case MaterialAction::Type::IMPACT_SOUND:
+      return "impact sound";
+    case MaterialAction::Type::SKID_SOUND:
+      return "skid sound";
+    case MaterialAction::Type::ROLL_SOUND:
+      return "roll sound";
+    case MaterialAction::Type::NODE_MOD:
+      return "node mod";
+    case MaterialAction::Type::PART_MOD:
+      return "part mod";
+    case MaterialAction::Type::NODE_USER_MESSAGE:
+      return "user message";
+  }
+  return "unknown";
+}
+
 // Modified version of dBodyGetPointVel - instead of applying the body's
 // linear and angular velocities, we apply a provided force and torque
 // to get its local equivalent.
@@ -206,6 +244,10 @@ void Dynamics::RemoveTrimesh(dGeomID g) {
   throw Exception("trimesh not found");
 }
 
+void Dynamics::ForgetTerrainContacts(dGeomID g) {
+  collision_cache_->ForgetGeom(g);
+}
+
 auto Dynamics::AreColliding_(const Part& p1_in, const Part& p2_in) -> bool {
   const Part* p1;
   const Part* p2;
@@ -448,6 +490,10 @@ void Dynamics::ProcessCollision_() {
   // called, etc).
   dSpaceCollide(ode_space_, this, &DoCollideCallback_);
 
+  // Test any sleeping pairs that have had something wake them up. This
+  // needs to happen before terrain so newly woken bodies get tested there.
+  CollideSleepingPairs_();
+
   // Collide our trimeshes against everything.
   collision_cache_->CollideAgainstSpace(ode_space_, this, &DoCollideCallback_);
 
@@ -506,10 +552,34 @@ void Dynamics::ProcessCollision_() {
     active_collision_ = i.collision.get();
     active_collide_src_node_ = i.node1;
     active_collide_dst_node_ = i.node2;
+    const char* name{MaterialActionName(i.action->GetType())};
+    base::StepProfiler::ScopedSample sample{
+        base::StepProfiler::Category::kMaterialAction, name, name};
     i.action->Execute(i.node1.get(), i.node2.get(), scene_);
   }
   active_collision_ = nullptr;
   collision_events_.clear();
+  delivered_messages_.clear();
+
+  // Deliver whatever batched calls and messages gathered above; one
+  // delivery each.
+  std::vector<Object::Ref<MaterialAction>> batched_actions;
+  batched_actions.swap(batched_actions_);
+  for (auto&& action : batched_actions) {
+    action->RunBatch();
+  }
+}
+
+void Dynamics::AddBatchedAction(MaterialAction* action) {
+  assert(action);
+  batched_actions_.emplace_back(action);
+}
+
+auto Dynamics::ClaimMessageDelivery(const MaterialAction* action,
+                                    int64_t target_id, int64_t other_id)
+    -> bool {
+  assert(action);
+  return delivered_messages_.emplace(action, target_id, other_id).second;
 }
 
 void Dynamics::Process() {
@@ -522,11 +592,119 @@ void Dynamics::Process() {
   in_process_ = false;
 }
 
+auto Dynamics::ClosingImpulse(dBodyID b1, dBodyID b2,
+                              const dContactGeom& contact) -> float {
+  dVector3 v1{0.0f, 0.0f, 0.0f};
+  dVector3 v2{0.0f, 0.0f, 0.0f};
+  float inv_mass{};
+  dMass mass;
+  if (b1) {
+    dBodyGetPointVel(b1, contact.pos[0], contact.pos[1], contact.pos[2], v1);
+    dBodyGetMass(b1, &mass);
+    inv_mass += 1.0f / mass.mass;
+  }
+  if (b2) {
+    dBodyGetPointVel(b2, contact.pos[0], contact.pos[1], contact.pos[2], v2);
+    dBodyGetMass(b2, &mass);
+    inv_mass += 1.0f / mass.mass;
+  }
+  if (inv_mass <= 0.0f) {
+    return 0.0f;
+  }
+  dVector3 rvel{v2[0] - v1[0], v2[1] - v1[1], v2[2] - v1[2]};
+  return std::abs(dDOT(contact.normal, rvel)) / inv_mass;
+}
+
 void Dynamics::DoCollideCallback_(void* data, dGeomID o1, dGeomID o2) {
   auto* d = static_cast<Dynamics*>(data);
   d->CollideCallback_(o1, o2);
 }
 
+// Poke any existing collision between these two so a disconnect event
+// doesn't occur while we skip testing them.
+void Dynamics::ClaimExistingCollision_(RigidBody* r1, RigidBody* r2) {
+  Part* p1_in = r1->part();
+  Part* p2_in = r2->part();
+  assert(p1_in && p2_in);
+  Part* p1;
+  Part* p2;
+
+  if (IsInStoreOrder(p1_in->node()->id(), p1_in->id(), p2_in->node()->id(),
+                     p2_in->id())) {
+    p1 = p1_in;
+    p2 = p2_in;
+  } else {
+    p1 = p2_in;
+    p2 = p1_in;
+  }
+  auto i = impl_->node_collisions_.find(p1->node()->id());
+  if (i != impl_->node_collisions_.end()) {
+    auto j = i->second.dst_nodes.find(p2->node()->id());
+    if (j != i->second.dst_nodes.end()) {
+      auto k = j->second.src_parts.find(p1->id());
+      if (k != j->second.src_parts.end()) {
+        auto l = k->second.dst_part_collisions.find(p2->id());
+        if (l != k->second.dst_part_collisions.end()) {
+#pragma clang diagnostic push
+#pragma ide diagnostic ignored "UnusedValue"
+          l->second->claim_count++;
+#pragma clang diagnostic pop
+        }
+      }
+    }
+  }
+}
+
+void Dynamics::CollideSleepingPairs_() {
+  // Testing a pair can wake more bodies, so keep passing over the list
+  // until nothing else wakes up.
+  bool tested_any{true};
+  while (tested_any) {
+    tested_any = false;
+    for (auto&& pair : sleeping_pairs_) {
+      if (pair.first == nullptr) {
+        continue;
+      }
+      if (dBodyIsEnabled(dGeomGetBody(pair.first))
+          || dBodyIsEnabled(dGeomGetBody(pair.second))) {
+        dGeomID o1{pair.first};
+        pair.first = nullptr;
+        CollideCallback_(o1, pair.second);
+        tested_any = true;
+      }
+    }
+  }
+
+  // Whatever is left is still asleep and can't have moved.
+  for (auto&& pair : sleeping_pairs_) {
+    if (pair.first != nullptr) {
+      ClaimExistingCollision_(
+          static_cast<RigidBody*>(dGeomGetData(pair.first)),
+          static_cast<RigidBody*>(dGeomGetData(pair.second)));
+    }
+  }
+  sleeping_pairs_.clear();
+}
+
+void Dynamics::WakeBody_(dBodyID body) {
+  if (dBodyIsEnabled(body)) {
+    return;
+  }
+  dBodyEnable(body);
+
+  // Anything jointed to it will join its island too.
+  int joint_count{dBodyGetNumJoints(body)};
+  for (int i = 0; i < joint_count; i++) {
+    dJointID joint{dBodyGetJoint(body, i)};
+    for (int j = 0; j < 2; j++) {
+      dBodyID other{dJointGetBody(joint, j)};
+      if (other && other != body) {
+        WakeBody_(other);
+      }
+    }
+  }
+}
+
 // Run collisions for everything. Store any callbacks that will need to be made
 // and run them after all collision constraints are made.
 // This way we know all bodies and their associated nodes, etc are valid
@@ -543,38 +721,7 @@ void Dynamics::CollideCallback_(dGeomID o1, dGeomID o2) {
   // we can skip actually testing for a collision.
   if ((dGeomGetClass(o1) == dTriMeshClass && b2 && !dBodyIsEnabled(b2))
       || (dGeomGetClass(o2) == dTriMeshClass && b1 && !dBodyIsEnabled(b1))) {
-    // We do, however, need to poke any existing collision so a disconnect event
-    // doesn't occur if we were colliding.
-    Part* p1_in = r1->part();
-    Part* p2_in = r2->part();
-    assert(p1_in && p2_in);
-    Part* p1;
-    Part* p2;
-
-    if (IsInStoreOrder(p1_in->node()->id(), p1_in->id(), p2_in->node()->id(),
-                       p2_in->id())) {
-      p1 = p1_in;
-      p2 = p2_in;
-    } else {
-      p1 = p2_in;
-      p2 = p1_in;
-    }
-    auto i = impl_->node_collisions_.find(p1->node()->id());
-    if (i != impl_->node_collisions_.end()) {
-      auto j = i->second.dst_nodes.find(p2->node()->id());
-      if (j != i->second.dst_nodes.end()) {
-        auto k = j->second.src_parts.find(p1->id());
-        if (k != j->second.src_parts.end()) {
-          auto l = k->second.dst_part_collisions.find(p2->id());
-          if (l != k->second.dst_part_collisions.end()) {
-#pragma clang diagnostic push
-#pragma ide diagnostic ignored "UnusedValue"
-            l->second->claim_count++;
-#pragma clang diagnostic pop
-          }
-        }
-      }
-    }
+    ClaimExistingCollision_(r1, r2);
     return;
   }
 
@@ -585,6 +732,14 @@ void Dynamics::CollideCallback_(dGeomID o1, dGeomID o2) {
     return;
   }
 
+  // Two sleeping bodies can't start touching while they sleep, so we hold
+  // off on testing them until we know whether anything is waking either
+  // of them this step (see CollideSleepingPairs_).
+  if (b1 && b2 && !dBodyIsEnabled(b1) && !dBodyIsEnabled(b2)) {
+    sleeping_pairs_.emplace_back(o1, o2);
+    return;
+  }
+
   Part* p1 = r1->part();
   Part* p2 = r2->part();
   assert(p1 && p2);
@@ -647,6 +802,7 @@ void Dynamics::CollideCallback_(dGeomID o1, dGeomID o2) {
     c->x = apx;
     c->y = apy;
     c->z = apz;
+    c->impulse = ClosingImpulse(b1, b2, contact[0].geom);
 
     // If theres an impact sound, skid sound, or roll sound attached to this
     // collision, calculate applicable values.
@@ -1103,12 +1259,168 @@ void Dynamics::CollideCallback_(dGeomID o1, dGeomID o2) {
             dJointSetFeedback(constraint, &c->collide_feedback[i]);
           }
         }
+
+        // A sleeper touching an awake body gets pulled into its island
+        // for the step anyway; wake it now so the rest of its tests
+        // (terrain included) run first.
+        if (b1 && b2) {
+          WakeBody_(b1);
+          WakeBody_(b2);
+        }
+      }
+    }
+  }
+}
+
+namespace {
+
+struct QueryState {
+  dGeomID query_geom;
+  Vector3f origin;
+  std::vector<Dynamics::QueryHit>* hits;
+};
+
+}  // namespace
+
+static void TestQueryGeom(QueryState* state, dGeomID geom) {
+  auto* body = static_cast<RigidBody*>(dGeomGetData(geom));
+  if (body == nullptr) {
+    return;
+  }
+  dContactGeom contact;
+  if (!dCollide(state->query_geom, geom, 1, &contact, sizeof(contact))) {
+    return;
+  }
+  Dynamics::QueryHit hit;
+  hit.body = body;
+  if (dGeomGetClass(state->query_geom) == dRayClass) {
+    // Ray contacts give distance along the ray as their depth.
+    hit.position = Vector3f(contact.pos);
+    hit.normal = Vector3f(contact.normal);
+    hit.distance = contact.depth;
+    dVector3 start, direction;
+    dGeomRayGet(state->query_geom, start, direction);
+    if (hit.normal.Dot(Vector3f(direction)) > 0.0f) {
+      hit.normal = -hit.normal;
+    }
+  } else {
+    hit.position = dGeomGetClass(geom) == dTriMeshClass
+                       ? Vector3f(contact.pos)
+                       : Vector3f(dGeomGetPosition(geom));
+    hit.distance = (hit.position - state->origin).Length();
+  }
+
+  // Bodies can be made of several geoms; keep the nearest hit for each.
+  for (auto&& existing : *state->hits) {
+    if (existing.body == body) {
+      if (hit.distance < existing.distance) {
+        existing = hit;
       }
+      return;
     }
   }
+  state->hits->push_back(hit);
+}
+
+static auto AABBsOverlap(const dReal* a, const dReal* b) -> bool {
+  return a[0] <= b[1] && a[1] >= b[0] && a[2] <= b[3] && a[3] >= b[2]
+         && a[4] <= b[5] && a[5] >= b[4];
+}
+
+static void DoQueryCallback(void* data, dGeomID o1, dGeomID o2) {
+  auto* state = static_cast<QueryState*>(data);
+  TestQueryGeom(state, o1 == state->query_geom ? o2 : o1);
+}
+
+void Dynamics::RunQuery_(dGeomID query_geom, const Vector3f& origin,
+                         std::vector<QueryHit>* hits) {
+  assert(hits);
+  hits->clear();
+  QueryState state{query_geom, origin, hits};
+
+  // The space's own broadphase culls everything that moves.
+  query_geom->recomputeAABB();
+  dSpaceCollide2(query_geom, static_cast<dGeomID>(ode_space_), &state,
+                 &DoQueryCallback);
+
+  // Terrain isn't in the space, but there are only ever a handful of
+  // trimeshes and their aabbs are kept current (see AddTrimesh()).
+  for (auto&& trimesh : trimeshes_) {
+    if (AABBsOverlap(query_geom->aabb, trimesh->aabb)) {
+      TestQueryGeom(&state, trimesh);
+    }
+  }
+  std::sort(hits->begin(), hits->end(),
+            [](const QueryHit& a, const QueryHit& b) {
+              return a.distance < b.distance;
+            });
+}
+
+void Dynamics::QuerySphere(const Vector3f& center, float radius,
+                           std::vector<QueryHit>* hits) {
+  assert(query_sphere_);
+  dGeomSphereSetRadius(query_sphere_, radius);
+  dGeomSetPosition(query_sphere_, center.x, center.y, center.z);
+  RunQuery_(query_sphere_, center, hits);
+}
+
+void Dynamics::QueryBox(const Vector3f& center, const Vector3f& size,
+                        std::vector<QueryHit>* hits) {
+  assert(query_box_);
+  dGeomBoxSetLengths(query_box_, size.x, size.y, size.z);
+  dGeomSetPosition(query_box_, center.x, center.y, center.z);
+  RunQuery_(query_box_, center, hits);
+}
+
+void Dynamics::QueryRay(const Vector3f& start, const Vector3f& direction,
+                        float length, std::vector<QueryHit>* hits) {
+  assert(query_ray_);
+  dGeomRaySetLength(query_ray_, length);
+  dGeomRaySet(query_ray_, start.x, start.y, start.z, direction.x,
+              direction.y, direction.z);
+  RunQuery_(query_ray_, start, hits);
+}
+
+auto Dynamics::RaycastTerrain(const Vector3f& start, const Vector3f& end,
+                              QueryHit* hit) -> bool {
+  assert(query_ray_ && hit);
+  Vector3f diff{end - start};
+  float length{diff.Length()};
+  if (length <= 0.0f) {
+    return false;
+  }
+  dGeomRaySetLength(query_ray_, length);
+  dGeomRaySet(query_ray_, start.x, start.y, start.z, diff.x / length,
+              diff.y / length, diff.z / length);
+  query_ray_->recomputeAABB();
+  bool found{};
+  for (auto&& trimesh : trimeshes_) {
+    if (!AABBsOverlap(query_ray_->aabb, trimesh->aabb)) {
+      continue;
+    }
+    dContactGeom contact;
+    if (dCollide(query_ray_, trimesh, 1, &contact, sizeof(contact))
+        && (!found || contact.depth < hit->distance)) {
+      found = true;
+      hit->body = static_cast<RigidBody*>(dGeomGetData(trimesh));
+      hit->position = Vector3f(contact.pos);
+      hit->normal = Vector3f(contact.normal);
+      if (hit->normal.Dot(diff) > 0.0f) {
+        hit->normal = -hit->normal;
+      }
+      hit->distance = contact.depth;
+    }
+  }
+  return found;
 }
 
 void Dynamics::ShutdownODE_() {
+  for (dGeomID* geom : {&query_sphere_, &query_box_, &query_ray_}) {
+    if (*geom) {
+      dGeomDestroy(*geom);
+      *geom = nullptr;
+    }
+  }
   if (ode_space_) {
     dSpaceDestroy(ode_space_);
     ode_space_ = nullptr;
@@ -1130,16 +1442,22 @@ void Dynamics::ResetODE_() {
   dWorldSetGravity(ode_world_, 0, -20, 0);
   dWorldSetContactSurfaceLayer(ode_world_, 0.001f);
   dWorldSetAutoDisableFlag(ode_world_, true);
-  dWorldSetAutoDisableSteps(ode_world_, 5);
-  dWorldSetAutoDisableLinearThreshold(ode_world_, 0.1f);
-  dWorldSetAutoDisableAngularThreshold(ode_world_, 0.1f);
-  dWorldSetAutoDisableSteps(ode_world_, 10);
+  dWorldSetAutoDisableSteps(ode_world_, kAutoDisableSteps);
+  dWorldSetAutoDisableLinearThreshold(ode_world_, kAutoDisableLinearThreshold);
+  dWorldSetAutoDisableAngularThreshold(ode_world_,
+                                       kAutoDisableAngularThreshold);
   dWorldSetAutoDisableTime(ode_world_, 0);
   dWorldSetQuickStepNumIterations(ode_world_, 10);
   ode_space_ = dHashSpaceCreate(nullptr);
   assert(ode_space_);
   ode_contact_group_ = dJointGroupCreate(0);
   assert(ode_contact_group_);
+
+  // Standalone geoms we reposition for spatial queries.
+  query_sphere_ = dCreateSphere(nullptr, 1.0f);
+  query_box_ = dCreateBox(nullptr, 1.0f, 1.0f, 1.0f);
+  query_ray_ = dCreateRay(nullptr, 1.0f);
+  dGeomRaySetClosestHit(query_ray_, 1);
   dRandSetSeed(5432);
 }
 
@@ -4,17 +4,35 @@
 #define BALLISTICA_SCENE_V1_DYNAMICS_DYNAMICS_H_
 
 #include <memory>
+#include <set>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 #include "ballistica/base/base.h"
 #include "ballistica/scene_v1/scene_v1.h"
 #include "ballistica/shared/foundation/object.h"
+#include "ballistica/shared/math/vector3f.h"
 #include "ode/ode.h"
 
 namespace ballistica::scene_v1 {
 
 class Dynamics : public Object {
  public:
+  /// A rigid body found by one of the spatial queries.
+  struct QueryHit {
+    RigidBody* body{};
+    /// For overlap queries, the body's center (or the contact point for
+    /// terrain, which has no meaningful center). For raycasts, the point
+    /// where the ray hit.
+    Vector3f position{0.0f, 0.0f, 0.0f};
+    /// Surface normal at a raycast hit (facing back along the ray); zero
+    /// for overlap queries.
+    Vector3f normal{0.0f, 0.0f, 0.0f};
+    /// Distance from the query center or ray start to position.
+    float distance{};
+  };
+
   explicit Dynamics(Scene* scene);
   ~Dynamics() override;
   void Draw(base::FrameDef* frame_def);  // Draw any debug stuff, etc.
@@ -55,6 +73,20 @@ class Dynamics : public Object {
     collide_message_reverse_order_ = target_other;
   }
   auto in_collide_message() const { return in_collide_message_; }
+
+  // Used by batched actions (python calls and messages) with events
+  // pending; we run them all once we're done processing collisions for the
+  // step.
+  void AddBatchedAction(MaterialAction* action);
+
+  // Used by message actions to coalesce repeats. When several parts of
+  // two nodes touch in the same step, each part pair fires the same
+  // connect actions; this returns true only the first time a given action
+  // delivers to a given target/other node id pair while executing a
+  // step's collision events.
+  auto ClaimMessageDelivery(const MaterialAction* action, int64_t target_id,
+                            int64_t other_id) -> bool;
+
   void Process();
   void IncrementSkidSoundCount() { skid_sound_count_++; }
   void DecrementSkidSoundCount() { skid_sound_count_--; }
@@ -69,6 +101,34 @@ class Dynamics : public Object {
   void AddTrimesh(dGeomID g);
   void RemoveTrimesh(dGeomID g);
 
+  // Trimeshes remember which of their triangles were near each geom last
+  // step; this must be called before a geom in our space is destroyed or
+  // resized so nothing stale carries over.
+  void ForgetTerrainContacts(dGeomID g);
+
+  // Spatial queries for game code. These test against the same ODE space
+  // and terrain list the simulation itself uses, so they always see
+  // current positions. Results hold one entry per rigid body, nearest
+  // first.
+  void QuerySphere(const Vector3f& center, float radius,
+                   std::vector<QueryHit>* hits);
+  void QueryBox(const Vector3f& center, const Vector3f& size,
+                std::vector<QueryHit>* hits);
+  void QueryRay(const Vector3f& start, const Vector3f& direction,
+                float length, std::vector<QueryHit>* hits);
+
+  // Cast a ray against terrain only; returns whether anything was hit and
+  // fills in the nearest hit if so. Cheap enough to use for batches of
+  // line-of-sight checks.
+  auto RaycastTerrain(const Vector3f& start, const Vector3f& end,
+                      QueryHit* hit) -> bool;
+
+  // Roughly the impulse needed to stop two bodies closing along a contact
+  // normal. Either body can be null for static geoms, which count as
+  // infinitely heavy.
+  static auto ClosingImpulse(dBodyID b1, dBodyID b2,
+                             const dContactGeom& contact) -> float;
+
   auto collision_count() const { return collision_count_; }
   auto process_real_time() const { return real_time_; }
   auto last_impact_sound_time() const { return last_impact_sound_time_; }
@@ -90,11 +150,19 @@ class Dynamics : public Object {
                     MaterialContext** cc2) -> Collision*;
 
   std::vector<CollisionEvent_> collision_events_;
+  std::vector<Object::Ref<MaterialAction>> batched_actions_;
+  std::set<std::tuple<const MaterialAction*, int64_t, int64_t>>
+      delivered_messages_;
   void ResetODE_();
   void ShutdownODE_();
   static void DoCollideCallback_(void* data, dGeomID o1, dGeomID o2);
   void CollideCallback_(dGeomID o1, dGeomID o2);
+  void CollideSleepingPairs_();
+  void ClaimExistingCollision_(RigidBody* r1, RigidBody* r2);
+  void WakeBody_(dBodyID body);
   void ProcessCollision_();
+  void RunQuery_(dGeomID query_geom, const Vector3f& origin,
+                 std::vector<QueryHit>* hits);
 
   int skid_sound_count_{};
   int roll_sound_count_{};
@@ -106,6 +174,9 @@ class Dynamics : public Object {
   dWorldID ode_world_{};
   dJointGroupID ode_contact_group_{};
   dSpaceID ode_space_{};
+  dGeomID query_sphere_{};
+  dGeomID query_box_{};
+  dGeomID query_ray_{};
   millisecs_t real_time_{};
   millisecs_t last_impact_sound_time_{};
   Scene* scene_{};
@@ -113,6 +184,7 @@ class Dynamics : public Object {
   Object::WeakRef<Node> active_collide_src_node_;
   Object::WeakRef<Node> active_collide_dst_node_;
   std::vector<dGeomID> trimeshes_;
+  std::vector<std::pair<dGeomID, dGeomID>> sleeping_pairs_;
   std::unique_ptr<Impl_> impl_;
   std::unique_ptr<base::CollisionCache> collision_cache_;
 };
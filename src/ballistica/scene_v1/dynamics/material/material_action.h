@@ -28,6 +28,11 @@ class MaterialAction : public Object {
                      const Part* dst_part,
                      const Object::Ref<MaterialAction>& p) = 0;
   virtual void Execute(Node* node1, Node* node2, Scene* scene) {}
+
+  /// Batched actions only record events in Execute() and register with
+  /// Dynamics::AddBatchedAction(), which calls this once they've all run
+  /// for the step.
+  virtual void RunBatch() {}
   virtual auto GetFlattenedSize() -> size_t { return 0; }
   virtual void Flatten(char** buffer, SessionStream* output_stream) {}
   virtual void Restore(const char** buffer, ClientSession* cs) {}
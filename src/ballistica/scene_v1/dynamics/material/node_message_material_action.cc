@@ -4,10 +4,30 @@
 
 #include "ballistica/scene_v1/dynamics/dynamics.h"
 #include "ballistica/scene_v1/dynamics/material/material_context.h"
+#include "ballistica/scene_v1/node/node.h"
 #include "ballistica/scene_v1/support/scene.h"
 
 namespace ballistica::scene_v1 {
 
+// Messages where getting the same one several times in a step does
+// nothing more than getting it once.
+static auto IsIdempotent(NodeMessageType type) -> bool {
+  switch (type) {
+    case NodeMessageType::kFlash:
+    case NodeMessageType::kCelebrate:
+    case NodeMessageType::kCelebrateL:
+    case NodeMessageType::kCelebrateR:
+    case NodeMessageType::kHurtSound:
+    case NodeMessageType::kPickedUp:
+    case NodeMessageType::kJumpSound:
+    case NodeMessageType::kAttackSound:
+    case NodeMessageType::kScreamSound:
+      return true;
+    default:
+      return false;
+  }
+}
+
 NodeMessageMaterialAction::NodeMessageMaterialAction(bool target_other_in,
                                                      bool at_disconnect_in,
                                                      const char* data_in,
@@ -34,6 +54,11 @@ void NodeMessageMaterialAction::Execute(Node* node1, Node* node2,
                                         Scene* scene) {
   Node* node = target_other ? node2 : node1;
   if (node) {
+    Node* other = target_other ? node1 : node2;
+    if (!ShouldDeliver(scene->dynamics(), this, data.data(), at_disconnect,
+                       node->id(), other ? other->id() : -1)) {
+      return;
+    }
     scene->dynamics()->set_collide_message_state(true, target_other);
     assert(node);
     assert(data.data());
@@ -42,4 +67,17 @@ void NodeMessageMaterialAction::Execute(Node* node1, Node* node2,
   }
 }
 
+auto NodeMessageMaterialAction::ShouldDeliver(Dynamics* dynamics,
+                                              const MaterialAction* action,
+                                              const char* data,
+                                              bool at_disconnect,
+                                              int64_t target_id,
+                                              int64_t other_id) -> bool {
+  assert(dynamics && data);
+  if (at_disconnect || !IsIdempotent(Node::extract_node_message_type(&data))) {
+    return true;
+  }
+  return dynamics->ClaimMessageDelivery(action, target_id, other_id);
+}
+
 }  // namespace ballistica::scene_v1
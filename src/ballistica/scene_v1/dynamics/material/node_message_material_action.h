@@ -20,6 +20,15 @@ class NodeMessageMaterialAction : public MaterialAction {
              const Part* dst_part,
              const Object::Ref<MaterialAction>& p) override;
   void Execute(Node* node1, Node* node2, Scene* scene) override;
+
+  /// Whether a message from an action should go out, given what has
+  /// already been delivered this step. Repeat connect messages of types
+  /// where extra deliveries change nothing (flashes, sounds, etc.) to the
+  /// same node pair are dropped; everything else always goes out.
+  static auto ShouldDeliver(Dynamics* dynamics, const MaterialAction* action,
+                            const char* data, bool at_disconnect,
+                            int64_t target_id, int64_t other_id) -> bool;
+
   bool target_other{};
   bool at_disconnect{};
   Buffer<char> data;
@@ -2,15 +2,25 @@
 
 #include "ballistica/scene_v1/dynamics/material/node_user_msg_mat_action.h"
 
+#include <vector>
+
+#include "ballistica/core/core.h"
+#include "ballistica/core/logging/logging.h"
 #include "ballistica/scene_v1/dynamics/dynamics.h"
 #include "ballistica/scene_v1/dynamics/material/material_context.h"
+#include "ballistica/scene_v1/node/node.h"
+#include "ballistica/scene_v1/python/scene_v1_python.h"
 #include "ballistica/scene_v1/support/scene.h"
+#include "ballistica/shared/python/python_macros.h"
 
 namespace ballistica::scene_v1 {
 
 NodeUserMessageMaterialAction::NodeUserMessageMaterialAction(
-    bool target_other_in, bool at_disconnect_in, PyObject* user_message_obj_in)
-    : target_other(target_other_in), at_disconnect(at_disconnect_in) {
+    bool target_other_in, bool at_disconnect_in, PyObject* user_message_obj_in,
+    bool batched_in)
+    : target_other(target_other_in),
+      at_disconnect(at_disconnect_in),
+      batched(batched_in) {
   user_message_obj.Acquire(user_message_obj_in);
 }
 
@@ -48,6 +58,30 @@ void NodeUserMessageMaterialAction::Execute(Node* node1, Node* node2,
     }
   }
 
+  if (batched) {
+    Dynamics* dynamics = scene->dynamics();
+    if (batches_.empty()) {
+      dynamics->AddBatchedAction(this);
+    }
+
+    // Contacts for the same target go together; there are rarely more
+    // than a handful of targets in a step so a scan is fine.
+    Batch_* batch{};
+    for (auto&& i : batches_) {
+      if (i.target.get() == target_node) {
+        batch = &i;
+        break;
+      }
+    }
+    if (!batch) {
+      batch = &batches_.emplace_back();
+      batch->target = target_node;
+    }
+    batch->events.push_back(
+        PythonCallMaterialAction::MakeBatchedEvent(dynamics, node1, node2));
+    return;
+  }
+
   base::ScopedSetContext ssc(target_node->context_ref());
   scene->dynamics()->set_collide_message_state(true, target_other);
   target_node->DispatchUserMessage(user_message_obj.get(),
@@ -55,4 +89,46 @@ void NodeUserMessageMaterialAction::Execute(Node* node1, Node* node2,
   scene->dynamics()->set_collide_message_state(false);
 }
 
+void NodeUserMessageMaterialAction::RunBatch() {
+  // Pull everything out before delivering; handlers may well trigger more
+  // collision processing down the line.
+  std::vector<Batch_> batches;
+  batches.swap(batches_);
+  for (auto&& batch : batches) {
+    Node* target_node = batch.target.get();
+    if (!target_node) {
+      continue;
+    }
+    base::ScopedSetContext ssc(target_node->context_ref());
+    PythonRef message{BatchedMessage(user_message_obj.get(), batch.events)};
+    if (!message.exists()) {
+      continue;
+    }
+    target_node->DispatchUserMessage(message.get(),
+                                     "Material Batched-Message dispatch");
+  }
+}
+
+auto NodeUserMessageMaterialAction::BatchedMessage(
+    PyObject* message,
+    const std::vector<PythonCallMaterialAction::BatchedEvent>& events)
+    -> PythonRef {
+  assert(message);
+  PythonRef py_events{PythonCallMaterialAction::BatchedEventList(events)};
+  if (!py_events.exists()) {
+    return {};
+  }
+  PythonRef args(Py_BuildValue("(OO)", message, py_events.get()),
+                 PythonRef::kSteal);
+  PythonRef instance{
+      g_scene_v1->python->objs()
+          .Get(SceneV1Python::ObjID::kBatchedMessageClass)
+          .Call(args)};
+  if (!instance.exists()) {
+    g_core->logging->Log(LogName::kBa, LogLevel::kError,
+                         "Error creating BatchedMessage");
+  }
+  return instance;
+}
+
 }  // namespace ballistica::scene_v1
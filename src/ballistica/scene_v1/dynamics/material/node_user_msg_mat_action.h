@@ -3,7 +3,10 @@
 #ifndef BALLISTICA_SCENE_V1_DYNAMICS_MATERIAL_NODE_USER_MSG_MAT_ACTION_H_
 #define BALLISTICA_SCENE_V1_DYNAMICS_MATERIAL_NODE_USER_MSG_MAT_ACTION_H_
 
+#include <vector>
+
 #include "ballistica/scene_v1/dynamics/material/material_action.h"
+#include "ballistica/scene_v1/dynamics/material/python_call_material_action.h"
 #include "ballistica/shared/ballistica.h"
 #include "ballistica/shared/python/python_ref.h"
 
@@ -13,16 +16,38 @@ namespace ballistica::scene_v1 {
 class NodeUserMessageMaterialAction : public MaterialAction {
  public:
   NodeUserMessageMaterialAction(bool target_other, bool at_disconnect,
-                                PyObject* user_message);
+                                PyObject* user_message, bool batched = false);
   ~NodeUserMessageMaterialAction() override;
   void Apply(MaterialContext* context, const Part* src_part,
              const Part* dst_part,
              const Object::Ref<MaterialAction>& p) override;
   void Execute(Node* node1, Node* node2, Scene* scene) override;
+
+  /// In batched mode, Execute() just records the event under its target
+  /// node and Dynamics calls this once at the end of collision processing
+  /// so each target gets a single bascenev1.BatchedMessage holding our
+  /// message and everything recorded for it that step.
+  void RunBatch() override;
+
+  /// Build the bascenev1.BatchedMessage a batched action delivers for some
+  /// events. Returns an empty ref (and logs) on errors.
+  static auto BatchedMessage(
+      PyObject* message,
+      const std::vector<PythonCallMaterialAction::BatchedEvent>& events)
+      -> PythonRef;
+
   bool target_other;
   bool at_disconnect;
+  bool batched;
   PythonRef user_message_obj;
   auto GetType() const -> Type override { return Type::NODE_USER_MESSAGE; }
+
+ private:
+  struct Batch_ {
+    Object::WeakRef<Node> target;
+    std::vector<PythonCallMaterialAction::BatchedEvent> events;
+  };
+  std::vector<Batch_> batches_;
 };
 
 }  // namespace ballistica::scene_v1
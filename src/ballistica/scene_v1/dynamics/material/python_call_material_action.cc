@@ -2,15 +2,25 @@
 
 #include "ballistica/scene_v1/dynamics/material/python_call_material_action.h"
 
+#include <vector>
+
+#include "ballistica/base/python/class/python_class_vec3.h"
+#include "ballistica/core/core.h"
+#include "ballistica/core/logging/logging.h"
+#include "ballistica/scene_v1/dynamics/collision.h"
 #include "ballistica/scene_v1/dynamics/dynamics.h"
 #include "ballistica/scene_v1/dynamics/material/material_context.h"
+#include "ballistica/scene_v1/node/node.h"
+#include "ballistica/scene_v1/python/scene_v1_python.h"
 #include "ballistica/scene_v1/support/scene.h"
 
 namespace ballistica::scene_v1 {
 
 PythonCallMaterialAction::PythonCallMaterialAction(bool at_disconnect_in,
-                                                   PyObject* call_obj_in)
+                                                   PyObject* call_obj_in,
+                                                   bool batched_in)
     : at_disconnect(at_disconnect_in),
+      batched(batched_in),
       call(Object::New<base::PythonContextCall>(call_obj_in)) {}
 
 void PythonCallMaterialAction::Apply(MaterialContext* context,
@@ -25,24 +35,92 @@ void PythonCallMaterialAction::Apply(MaterialContext* context,
 }
 
 void PythonCallMaterialAction::Execute(Node* node1, Node* node2, Scene* scene) {
-  scene->dynamics()->set_collide_message_state(true, false);
-
   // Only run connect commands if both nodes still exist.
   // This way most collision commands can assume both
   // members of the collision exist.
-  if (!at_disconnect) {
-    if (node1 && node2) {
-      call->Run();
-    }
-  } else {
-    // Its a disconnect. Run it if the src node still exists
-    // (nodes should know if they've disconnected from others even if
-    // it was through death)
-    if (node1) {
-      call->Run();
+  // For disconnects, run if the src node still exists
+  // (nodes should know if they've disconnected from others even if
+  // it was through death)
+  if (at_disconnect ? !node1 : !(node1 && node2)) {
+    return;
+  }
+
+  if (batched) {
+    Dynamics* dynamics = scene->dynamics();
+    if (batched_events_.empty()) {
+      dynamics->AddBatchedAction(this);
     }
+    batched_events_.push_back(MakeBatchedEvent(dynamics, node1, node2));
+    return;
   }
+
+  scene->dynamics()->set_collide_message_state(true, false);
+  call->Run();
   scene->dynamics()->set_collide_message_state(false);
 }
 
+auto PythonCallMaterialAction::MakeBatchedEvent(Dynamics* dynamics,
+                                                Node* node1, Node* node2)
+    -> BatchedEvent {
+  Collision* c = dynamics->active_collision();
+  assert(c);
+  BatchedEvent event;
+  event.source_node = node1;
+  event.opposing_node = node2;
+
+  // Same body getcollision().opposingbody would give us.
+  event.opposing_body = c->body_id_1;
+  event.position[0] = c->x;
+  event.position[1] = c->y;
+  event.position[2] = c->z;
+  event.depth = c->depth;
+  event.impulse = c->impulse;
+  return event;
+}
+
+void PythonCallMaterialAction::RunBatch() {
+  if (batched_events_.empty()) {
+    return;
+  }
+
+  // Build everything before calling out; the call may well trigger more
+  // collision processing down the line.
+  std::vector<BatchedEvent> events;
+  events.swap(batched_events_);
+  PythonRef py_events{BatchedEventList(events)};
+  if (!py_events.exists()) {
+    return;
+  }
+  PythonRef call_args(PyTuple_Pack(1, py_events.get()), PythonRef::kSteal);
+  call->Run(call_args);
+}
+
+auto PythonCallMaterialAction::BatchedEventList(
+    const std::vector<BatchedEvent>& events) -> PythonRef {
+  PythonRef event_class{g_scene_v1->python->objs().Get(
+      SceneV1Python::ObjID::kCollisionEventClass)};
+  PythonRef py_events{PyList_New(0), PythonRef::kSteal};
+  for (auto&& event : events) {
+    Node* source_node = event.source_node.get();
+    Node* opposing_node = event.opposing_node.get();
+    PythonRef position(base::PythonClassVec3::Create(Vector3f(event.position)),
+                       PythonRef::kSteal);
+    PythonRef args(
+        Py_BuildValue("(OOiOff)",
+                      source_node ? source_node->BorrowPyRef() : Py_None,
+                      opposing_node ? opposing_node->BorrowPyRef() : Py_None,
+                      event.opposing_body, position.get(), event.depth,
+                      event.impulse),
+        PythonRef::kSteal);
+    PythonRef instance{event_class.Call(args)};
+    if (!instance.exists()) {
+      g_core->logging->Log(LogName::kBa, LogLevel::kError,
+                           "Error creating CollisionEvent");
+      return {};
+    }
+    PyList_Append(py_events.get(), instance.get());
+  }
+  return py_events;
+}
+
 }  // namespace ballistica::scene_v1
@@ -3,6 +3,8 @@
 #ifndef BALLISTICA_SCENE_V1_DYNAMICS_MATERIAL_PYTHON_CALL_MATERIAL_ACTION_H_
 #define BALLISTICA_SCENE_V1_DYNAMICS_MATERIAL_PYTHON_CALL_MATERIAL_ACTION_H_
 
+#include <vector>
+
 #include "ballistica/base/python/support/python_context_call.h"
 #include "ballistica/scene_v1/dynamics/material/material_action.h"
 
@@ -10,14 +12,46 @@ namespace ballistica::scene_v1 {
 
 class PythonCallMaterialAction : public MaterialAction {
  public:
-  PythonCallMaterialAction(bool at_disconnect_in, PyObject* call_obj_in);
+  PythonCallMaterialAction(bool at_disconnect_in, PyObject* call_obj_in,
+                           bool batched_in = false);
   void Apply(MaterialContext* context, const Part* src_part,
              const Part* dst_part,
              const Object::Ref<MaterialAction>& p) override;
   void Execute(Node* node1, Node* node2, Scene* scene) override;
+
+  /// What a batched call hears about one contact. Filled in from the
+  /// active collision when the event is executed, so nothing needs to be
+  /// looked up later.
+  struct BatchedEvent {
+    Object::WeakRef<Node> source_node;
+    Object::WeakRef<Node> opposing_node;
+    int opposing_body{};
+    float position[3]{};
+    float depth{};
+    float impulse{};
+  };
+
+  /// Fill out an event from the collision being executed.
+  static auto MakeBatchedEvent(Dynamics* dynamics, Node* node1, Node* node2)
+      -> BatchedEvent;
+
+  /// In batched mode, Execute() just records the event and Dynamics calls
+  /// this once at the end of collision processing to hand everything
+  /// recorded that step to the call as a single list.
+  void RunBatch() override;
+
+  /// Build the list of bascenev1.CollisionEvents a batched call is passed
+  /// for some events. Returns an empty ref (and logs) on errors.
+  static auto BatchedEventList(const std::vector<BatchedEvent>& events)
+      -> PythonRef;
+
   bool at_disconnect;
+  bool batched;
   Object::Ref<base::PythonContextCall> call;
   auto GetType() const -> Type override { return Type::SCRIPT_CALL; }
+
+ private:
+  std::vector<BatchedEvent> batched_events_;
 };
 
 }  // namespace ballistica::scene_v1
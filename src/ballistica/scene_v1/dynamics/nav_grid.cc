@@ -0,0 +1,352 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/scene_v1/dynamics/nav_grid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "ballistica/scene_v1/dynamics/dynamics.h"
+
+namespace ballistica::scene_v1 {
+
+// Floors steeper than this aren't walkable (minimum normal y).
+const float kMinFloorNormalY{0.7f};
+
+// Height above the floor at which we check for walls between cells.
+const float kWallProbeHeight{0.4f};
+
+// How many cells out we'll look for somewhere walkable near a query point.
+const int kWalkableSearchRadius{3};
+
+// Distance fields we keep around before starting over.
+const size_t kMaxCachedFields{16};
+
+// Neighbor directions; orthogonal first, then diagonal.
+const int kDirX[8]{1, -1, 0, 0, 1, 1, -1, -1};
+const int kDirZ[8]{0, 0, 1, -1, 1, -1, 1, -1};
+const float kDirCost[8]{1.0f,     1.0f,     1.0f,     1.0f,
+                        1.41421f, 1.41421f, 1.41421f, 1.41421f};
+
+const float kInfinity{std::numeric_limits<float>::infinity()};
+
+namespace {
+
+// Orthogonal direction index for a single-axis step.
+auto OrthoDir(int dx, int dz) -> int {
+  if (dx > 0) {
+    return 0;
+  }
+  if (dx < 0) {
+    return 1;
+  }
+  return dz > 0 ? 2 : 3;
+}
+
+auto OctileDistance(int dx, int dz) -> float {
+  dx = std::abs(dx);
+  dz = std::abs(dz);
+  auto lo{static_cast<float>(std::min(dx, dz))};
+  auto hi{static_cast<float>(std::max(dx, dz))};
+  return hi - lo + kDirCost[4] * lo;
+}
+
+using QueueEntry = std::pair<float, int>;
+using OpenQueue = std::priority_queue<QueueEntry, std::vector<QueueEntry>,
+                                      std::greater<QueueEntry>>;
+
+}  // namespace
+
+NavGrid::NavGrid(Dynamics* dynamics, const float* bounds_min,
+                 const float* bounds_max, float cell_size, float max_step)
+    : origin_x_{bounds_min[0]},
+      origin_z_{bounds_min[2]},
+      cell_size_{cell_size} {
+  assert(dynamics);
+  assert(cell_size > 0.0f);
+  width_ = std::max(1, static_cast<int>(std::ceil(
+                           (bounds_max[0] - bounds_min[0]) / cell_size)));
+  depth_ = std::max(1, static_cast<int>(std::ceil(
+                           (bounds_max[2] - bounds_min[2]) / cell_size)));
+  auto cell_count{static_cast<size_t>(width_) * static_cast<size_t>(depth_)};
+  floor_.assign(cell_count, std::nanf(""));
+  links_.assign(cell_count, 0);
+
+  // Find floors by casting straight down through each cell center.
+  Dynamics::QueryHit hit;
+  for (int cell = 0; cell < static_cast<int>(cell_count); ++cell) {
+    Vector3f center{CellCenter_(cell)};
+    if (dynamics->RaycastTerrain({center.x, bounds_max[1], center.z},
+                                 {center.x, bounds_min[1], center.z}, &hit)
+        && hit.normal.y >= kMinFloorNormalY) {
+      floor_[cell] = hit.position.y;
+      walkable_count_++;
+    }
+  }
+
+  // Link orthogonal neighbors whose floors are close enough in height and
+  // that don't have a wall between them. Links are symmetric, so we only
+  // need to look in the positive directions.
+  for (int z = 0; z < depth_; ++z) {
+    for (int x = 0; x < width_; ++x) {
+      int cell{z * width_ + x};
+      if (std::isnan(floor_[cell])) {
+        continue;
+      }
+      for (int dir : {0, 2}) {
+        int nx{x + kDirX[dir]};
+        int nz{z + kDirZ[dir]};
+        if (nx >= width_ || nz >= depth_) {
+          continue;
+        }
+        int neighbor{nz * width_ + nx};
+        if (std::isnan(floor_[neighbor])
+            || std::abs(floor_[neighbor] - floor_[cell]) > max_step) {
+          continue;
+        }
+        float probe_y{std::max(floor_[cell], floor_[neighbor])
+                      + kWallProbeHeight};
+        Vector3f from{CellCenter_(cell)};
+        Vector3f to{CellCenter_(neighbor)};
+        if (dynamics->RaycastTerrain({from.x, probe_y, from.z},
+                                     {to.x, probe_y, to.z}, &hit)) {
+          continue;
+        }
+        links_[cell] |= static_cast<uint8_t>(1u << dir);
+        links_[neighbor] |= static_cast<uint8_t>(1u << (dir + 1));
+      }
+    }
+  }
+
+  // Diagonals only link when both orthogonal routes around the corner do,
+  // so paths never cut corners.
+  std::vector<uint8_t> diagonals(cell_count);
+  for (int z = 0; z < depth_; ++z) {
+    for (int x = 0; x < width_; ++x) {
+      int cell{z * width_ + x};
+      for (int dir = 4; dir < 8; ++dir) {
+        int dir_x{OrthoDir(kDirX[dir], 0)};
+        int dir_z{OrthoDir(0, kDirZ[dir])};
+        if (!Linked_(cell, dir_x) || !Linked_(cell, dir_z)) {
+          continue;
+        }
+        int cell_x{cell + kDirX[dir]};
+        int cell_z{cell + kDirZ[dir] * width_};
+        if (Linked_(cell_x, dir_z) && Linked_(cell_z, dir_x)) {
+          diagonals[cell] |= static_cast<uint8_t>(1u << dir);
+        }
+      }
+    }
+  }
+  for (size_t i = 0; i < cell_count; ++i) {
+    links_[i] |= diagonals[i];
+  }
+}
+
+auto NavGrid::CellAt_(float x, float z) const -> int {
+  auto cx{static_cast<int>(std::floor((x - origin_x_) / cell_size_))};
+  auto cz{static_cast<int>(std::floor((z - origin_z_) / cell_size_))};
+  if (cx < 0 || cz < 0 || cx >= width_ || cz >= depth_) {
+    return -1;
+  }
+  return cz * width_ + cx;
+}
+
+auto NavGrid::CellCenter_(int cell) const -> Vector3f {
+  int x{cell % width_};
+  int z{cell / width_};
+  return {origin_x_ + (static_cast<float>(x) + 0.5f) * cell_size_,
+          floor_[cell],
+          origin_z_ + (static_cast<float>(z) + 0.5f) * cell_size_};
+}
+
+auto NavGrid::FindWalkableCell_(const Vector3f& pos) const -> int {
+  // Positions slightly off the grid or over a gap (mid-jump, say) should
+  // still resolve to the nearest floor.
+  auto cx{static_cast<int>(std::floor((pos.x - origin_x_) / cell_size_))};
+  auto cz{static_cast<int>(std::floor((pos.z - origin_z_) / cell_size_))};
+  int best{-1};
+  float best_dist_sq{kInfinity};
+  for (int radius = 0; radius <= kWalkableSearchRadius; ++radius) {
+    for (int z = cz - radius; z <= cz + radius; ++z) {
+      for (int x = cx - radius; x <= cx + radius; ++x) {
+        // Only visit the ring at this radius.
+        if (std::max(std::abs(x - cx), std::abs(z - cz)) != radius
+            || x < 0 || z < 0 || x >= width_ || z >= depth_) {
+          continue;
+        }
+        int cell{z * width_ + x};
+        if (std::isnan(floor_[cell])) {
+          continue;
+        }
+        Vector3f center{CellCenter_(cell)};
+        float dx{center.x - pos.x};
+        float dz{center.z - pos.z};
+        float dist_sq{dx * dx + dz * dz};
+        if (dist_sq < best_dist_sq) {
+          best = cell;
+          best_dist_sq = dist_sq;
+        }
+      }
+    }
+    if (best != -1) {
+      return best;
+    }
+  }
+  return -1;
+}
+
+auto NavGrid::GetField_(int target_cell) -> const std::vector<float>& {
+  auto i{fields_.find(target_cell)};
+  if (i != fields_.end()) {
+    return i->second;
+  }
+  if (fields_.size() >= kMaxCachedFields) {
+    fields_.clear();
+  }
+
+  // Plain Dijkstra out from the target; links are symmetric so this gives
+  // each cell's distance to it.
+  auto& field{fields_[target_cell]};
+  field.assign(floor_.size(), kInfinity);
+  field[target_cell] = 0.0f;
+  OpenQueue open;
+  open.emplace(0.0f, target_cell);
+  while (!open.empty()) {
+    auto [dist, cell] = open.top();
+    open.pop();
+    if (dist > field[cell]) {
+      continue;
+    }
+    for (int dir = 0; dir < 8; ++dir) {
+      if (!Linked_(cell, dir)) {
+        continue;
+      }
+      int neighbor{cell + kDirX[dir] + kDirZ[dir] * width_};
+      float neighbor_dist{dist + kDirCost[dir]};
+      if (neighbor_dist < field[neighbor]) {
+        field[neighbor] = neighbor_dist;
+        open.emplace(neighbor_dist, neighbor);
+      }
+    }
+  }
+  return field;
+}
+
+auto NavGrid::FindPath(const Vector3f& start, const Vector3f& end,
+                       std::vector<Vector3f>* path) -> bool {
+  assert(path);
+  path->clear();
+  int start_cell{FindWalkableCell_(start)};
+  int end_cell{FindWalkableCell_(end)};
+  if (start_cell == -1 || end_cell == -1) {
+    return false;
+  }
+  int end_x{end_cell % width_};
+  int end_z{end_cell / width_};
+
+  std::vector<float> cost(floor_.size(), kInfinity);
+  std::vector<int> came_from(floor_.size(), -1);
+  OpenQueue open;
+  cost[start_cell] = 0.0f;
+  open.emplace(OctileDistance(start_cell % width_ - end_x,
+                              start_cell / width_ - end_z),
+               start_cell);
+  bool found{};
+  while (!open.empty()) {
+    int cell{open.top().second};
+    open.pop();
+    if (cell == end_cell) {
+      found = true;
+      break;
+    }
+    int x{cell % width_};
+    int z{cell / width_};
+    for (int dir = 0; dir < 8; ++dir) {
+      if (!Linked_(cell, dir)) {
+        continue;
+      }
+      int neighbor{cell + kDirX[dir] + kDirZ[dir] * width_};
+      float neighbor_cost{cost[cell] + kDirCost[dir]};
+      if (neighbor_cost < cost[neighbor]) {
+        cost[neighbor] = neighbor_cost;
+        came_from[neighbor] = cell;
+        open.emplace(neighbor_cost
+                         + OctileDistance(x + kDirX[dir] - end_x,
+                                          z + kDirZ[dir] - end_z),
+                     neighbor);
+      }
+    }
+  }
+  if (!found) {
+    return false;
+  }
+
+  // Walk back from the end, keeping only cells where the path turns.
+  std::vector<int> cells;
+  for (int cell = end_cell; cell != -1; cell = came_from[cell]) {
+    cells.push_back(cell);
+  }
+  std::reverse(cells.begin(), cells.end());
+  for (size_t i = 0; i < cells.size(); ++i) {
+    if (i > 0 && i + 1 < cells.size()
+        && cells[i] - cells[i - 1] == cells[i + 1] - cells[i]) {
+      continue;
+    }
+    path->push_back(CellCenter_(cells[i]));
+  }
+
+  // End exactly where asked (on the floor).
+  path->back().x = end.x;
+  path->back().z = end.z;
+  return true;
+}
+
+auto NavGrid::GetDirection(const Vector3f& position, const Vector3f& target,
+                           float* dir_x, float* dir_z) -> bool {
+  assert(dir_x && dir_z);
+  int cell{FindWalkableCell_(position)};
+  int target_cell{FindWalkableCell_(target)};
+  if (cell == -1 || target_cell == -1) {
+    return false;
+  }
+
+  // Once we're in the target's cell, just head straight for it.
+  Vector3f goal{target};
+  if (cell != target_cell) {
+    const std::vector<float>& field{GetField_(target_cell)};
+    if (field[cell] == kInfinity) {
+      return false;
+    }
+    int best{-1};
+    float best_dist{field[cell]};
+    for (int dir = 0; dir < 8; ++dir) {
+      if (!Linked_(cell, dir)) {
+        continue;
+      }
+      int neighbor{cell + kDirX[dir] + kDirZ[dir] * width_};
+      if (field[neighbor] < best_dist) {
+        best = neighbor;
+        best_dist = field[neighbor];
+      }
+    }
+    assert(best != -1);
+    goal = CellCenter_(best);
+  }
+  float dx{goal.x - position.x};
+  float dz{goal.z - position.z};
+  float length{std::sqrt(dx * dx + dz * dz)};
+  if (length > 0.0f) {
+    dx /= length;
+    dz /= length;
+  }
+  *dir_x = dx;
+  *dir_z = dz;
+  return true;
+}
+
+}  // namespace ballistica::scene_v1
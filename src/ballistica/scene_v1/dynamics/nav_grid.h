@@ -0,0 +1,66 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_SCENE_V1_DYNAMICS_NAV_GRID_H_
+#define BALLISTICA_SCENE_V1_DYNAMICS_NAV_GRID_H_
+
+#include <unordered_map>
+#include <vector>
+
+#include "ballistica/scene_v1/scene_v1.h"
+#include "ballistica/shared/foundation/object.h"
+#include "ballistica/shared/math/vector3f.h"
+
+namespace ballistica::scene_v1 {
+
+/// A walkability grid over a scene's terrain, for bot navigation.
+///
+/// Cells are laid out over the map bounds in x/z. Each holds the height of
+/// the topmost walkable floor found by casting down onto the terrain, if
+/// any. Neighboring cells (including diagonals) link up when the step
+/// between their floors is small enough. Terrain is static, so the grid is
+/// built once and then only queried.
+class NavGrid : public Object {
+ public:
+  NavGrid(Dynamics* dynamics, const float* bounds_min, const float* bounds_max,
+          float cell_size, float max_step);
+
+  /// Find a walkable path between two points with A*. On success, fills
+  /// `path` with points on the floor running from start to end (with
+  /// straight runs collapsed) and returns true.
+  auto FindPath(const Vector3f& start, const Vector3f& end,
+                std::vector<Vector3f>* path) -> bool;
+
+  /// Get the (normalized, x/z) direction to move in from `position` to
+  /// head toward `target` along the grid. Returns false if the target
+  /// can't be reached. Distance fields toward recent target cells are
+  /// cached, so many callers chasing the same few targets are cheap.
+  auto GetDirection(const Vector3f& position, const Vector3f& target,
+                    float* dir_x, float* dir_z) -> bool;
+
+  auto width() const { return width_; }
+  auto depth() const { return depth_; }
+  auto walkable_count() const { return walkable_count_; }
+
+ private:
+  auto CellAt_(float x, float z) const -> int;
+  auto CellCenter_(int cell) const -> Vector3f;
+  auto FindWalkableCell_(const Vector3f& pos) const -> int;
+  auto GetField_(int target_cell) -> const std::vector<float>&;
+  auto Linked_(int cell, int dir) const -> bool {
+    return (links_[cell] & (1u << dir)) != 0;
+  }
+
+  float origin_x_{};
+  float origin_z_{};
+  float cell_size_{};
+  int width_{};
+  int depth_{};
+  int walkable_count_{};
+  std::vector<float> floor_;    // Floor height per cell; NaN if none.
+  std::vector<uint8_t> links_;  // Bit per walkable neighbor direction.
+  std::unordered_map<int, std::vector<float>> fields_;
+};
+
+}  // namespace ballistica::scene_v1
+
+#endif  // BALLISTICA_SCENE_V1_DYNAMICS_NAV_GRID_H_
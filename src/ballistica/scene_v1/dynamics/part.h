@@ -88,6 +88,8 @@ class Part : public Object {
   // reset their birth times.  Nodes have a function to do so for all their
   // contained parts as well.
   void UpdateBirthTime();
+  auto birth_time() const -> millisecs_t { return birth_time_; }
+  void set_birth_time(millisecs_t val) { birth_time_ = val; }
   auto last_impact_sound_time() const -> millisecs_t {
     return last_impact_sound_time_;
   }
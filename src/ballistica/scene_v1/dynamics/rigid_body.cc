@@ -247,6 +247,9 @@ RigidBody::~RigidBody() {
   }
   assert(!geoms_.empty());
   for (auto&& i : geoms_) {
+    if (shape_ != Shape::kTrimesh) {
+      dynamics_->ForgetTerrainContacts(i);
+    }
     dGeomDestroy(i);
   }
 }
@@ -371,6 +374,34 @@ void RigidBody::ExtractFull(const char** buffer) {
   }
 }
 
+void RigidBody::GetRestState_(dReal* state) const {
+  memcpy(state, dBodyGetPosition(body_), sizeof(dReal) * 3);
+  memcpy(state + 3, dBodyGetQuaternion(body_), sizeof(dReal) * 4);
+  memcpy(state + 7, dBodyGetLinearVel(body_), sizeof(dReal) * 3);
+  memcpy(state + 10, dBodyGetAngularVel(body_), sizeof(dReal) * 3);
+}
+
+auto RigidBody::IsRestReported() const -> bool {
+  assert(type_ == Type::kBody);
+  if (!rest_reported_ || dBodyIsEnabled(body_)) {
+    return false;
+  }
+
+  // Sleeping bodies can still be moved directly (attr sets, snapshot
+  // restores, etc.) so make sure we're where we said we were.
+  dReal state[13];
+  GetRestState_(state);
+  return !memcmp(state, reported_rest_state_, sizeof(state));
+}
+
+void RigidBody::MarkCorrectionSent() {
+  assert(type_ == Type::kBody);
+  rest_reported_ = !dBodyIsEnabled(body_);
+  if (rest_reported_) {
+    GetRestState_(reported_rest_state_);
+  }
+}
+
 void RigidBody::Draw(base::RenderPass* pass, bool shaded) {
   assert(pass);
   base::RenderPass::Type pass_type = pass->type();
@@ -416,6 +447,12 @@ void RigidBody::SetDimensions(float d1, float d2, float d3, float m1, float m2,
 
   float density = 5.0f * density_mult;
 
+  if (shape_ != Shape::kTrimesh) {
+    for (auto&& i : geoms_) {
+      dynamics_->ForgetTerrainContacts(i);
+    }
+  }
+
   switch (shape_) {
     case Shape::kSphere:
       dGeomSphereSetRadius(geoms_[0], dimensions_[0]);
@@ -82,6 +82,13 @@ class RigidBody : public Object {
   auto GetEmbeddedSizeFull() -> int;
   void ExtractFull(const char** buffer);
   void EmbedFull(char** buffer);
+
+  // Used to leave sleeping bodies out of correction messages once clients
+  // have been sent the state they came to rest in. IsRestReported()
+  // returns true if we're asleep in exactly the state last passed to
+  // MarkCorrectionSent().
+  auto IsRestReported() const -> bool;
+  void MarkCorrectionSent();
   RigidBody(int id_in, Part* part_in, Type type_in, Shape shape_in,
             uint32_t collide_type_in, uint32_t collide_mask_in,
             SceneCollisionMesh* collision_mesh_in = nullptr,
@@ -213,6 +220,11 @@ class RigidBody : public Object {
   };
   std::vector<CollideCallback> collide_callbacks_;
   uint32_t flags_{};
+  bool rest_reported_{};
+
+  // Position, quaternion, and linear and angular velocity.
+  dReal reported_rest_state_[13]{};
+  void GetRestState_(dReal* state) const;
 };
 
 }  // namespace ballistica::scene_v1
@@ -94,22 +94,17 @@ auto AnimCurveNode::GetOut() -> float {
         if (!got) {
           // out_ = keyframes_[0].value;
 
-          // Ok we know we've got at least 2 keyframes.
-          auto i1 = keyframes_.begin();
-          auto i2 = keyframes_.begin();
-          auto i = keyframes_.begin();
-          while (true) {
-            if (i == keyframes_.end()) {
-              break;
-            }
-            if (static_cast<float>(i->time) < in_val) {
-              i++;
-              i1 = i2;
-              i2 = i;
-            } else {
-              break;
-            }
+          // Ok we know we've got at least 2 keyframes; blend between the
+          // first one at or past our input and the one before it.
+          auto i2 = std::lower_bound(
+              keyframes_.begin(), keyframes_.end(), in_val,
+              [](const Keyframe& key, float val) {
+                return static_cast<float>(key.time) < val;
+              });
+          if (i2 == keyframes_.end()) {
+            --i2;
           }
+          auto i1 = (i2 == keyframes_.begin()) ? i2 : i2 - 1;
           if (i2->time - i1->time == 0) {
             out_ = i1->value;
           } else {
@@ -0,0 +1,165 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/scene_v1/node/anim_track_node.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "ballistica/core/logging/logging_macros.h"
+#include "ballistica/scene_v1/node/node_attribute.h"
+#include "ballistica/scene_v1/node/node_type.h"
+#include "ballistica/scene_v1/support/scene.h"
+
+namespace ballistica::scene_v1 {
+
+// Most channels anyone should need (colors, positions, scales, etc.)
+const int kMaxTrackSize{16};
+
+class AnimTrackNodeType : public NodeType {
+ public:
+#define BA_NODE_TYPE_CLASS AnimTrackNode
+  BA_NODE_CREATE_CALL(CreateAnimTrack);
+  BA_INT_ATTR(size, size, set_size);
+  BA_BOOL_ATTR(loop, loop, set_loop);
+  BA_INT64_ARRAY_ATTR(times, times, set_times);
+  BA_FLOAT_ARRAY_ATTR(values, values, set_values);
+  BA_FLOAT_ATTR(offset, offset, set_offset);
+  BA_FLOAT_ATTR_READONLY(out, GetOut);
+  BA_FLOAT_ARRAY_ATTR_READONLY(output, GetOutput);
+#undef BA_NODE_TYPE_CLASS
+
+  AnimTrackNodeType()
+      : NodeType("animtrack", CreateAnimTrack),
+        size(this),
+        loop(this),
+        times(this),
+        values(this),
+        offset(this),
+        out(this),
+        output(this) {}
+};
+
+static NodeType* node_type{};
+
+auto AnimTrackNode::InitType() -> NodeType* {
+  node_type = new AnimTrackNodeType();
+  return node_type;
+}
+
+AnimTrackNode::AnimTrackNode(Scene* scene) : Node(scene, node_type) {}
+
+AnimTrackNode::~AnimTrackNode() = default;
+
+void AnimTrackNode::set_size(int val) {
+  if (val < 1 || val > kMaxTrackSize) {
+    throw Exception("Expected a size between 1 and "
+                        + std::to_string(kMaxTrackSize) + " for animtrack",
+                    PyExcType::kValue);
+  }
+  size_ = val;
+  keys_dirty_ = true;
+}
+
+auto AnimTrackNode::GetOut() -> float {
+  Update_();
+  return output_[0];
+}
+
+auto AnimTrackNode::GetOutput() -> std::vector<float> {
+  Update_();
+  return output_;
+}
+
+void AnimTrackNode::RebuildKeys_() {
+  auto size{static_cast<size_t>(size_)};
+  key_times_.resize(std::min(times_.size(), values_.size() / size));
+  for (size_t i = 0; i < key_times_.size(); ++i) {
+    key_times_[i] = static_cast<float>(times_[i]);
+  }
+  if (!std::is_sorted(key_times_.begin(), key_times_.end())) {
+    BA_LOG_ONCE(LogName::kBa, LogLevel::kError,
+                "AnimTrackNode times are not in order for " + label());
+
+    // Values won't line up anymore but lookups at least stay in bounds.
+    std::sort(key_times_.begin(), key_times_.end());
+  }
+  segment_ = 0;
+  output_.assign(size, 0.0f);
+  keys_dirty_ = false;
+  out_dirty_ = true;
+}
+
+auto AnimTrackNode::FindSegment_(const std::vector<float>& key_times,
+                                 float time, size_t* segment) -> size_t {
+  // Callers guarantee key_times.front() < time < key_times.back(); we
+  // want the segment with key_times[i] < time <= key_times[i + 1].
+  size_t key_count{key_times.size()};
+  for (size_t i = *segment; i < *segment + 2 && i + 1 < key_count; ++i) {
+    if (key_times[i] < time && time <= key_times[i + 1]) {
+      *segment = i;
+      return i;
+    }
+  }
+  auto upper{std::lower_bound(key_times.begin(), key_times.end(), time)};
+  *segment = static_cast<size_t>(upper - key_times.begin()) - 1;
+  return *segment;
+}
+
+void AnimTrackNode::Update_() {
+  if (keys_dirty_) {
+    RebuildKeys_();
+  }
+  millisecs_t now{scene()->time()};
+  if (!out_dirty_ && now == out_time_) {
+    return;
+  }
+  out_time_ = now;
+  out_dirty_ = false;
+  Evaluate(key_times_, values_.data(), static_cast<size_t>(size_), loop_,
+           static_cast<float>(now) - offset_, &segment_, output_.data());
+}
+
+void AnimTrackNode::Evaluate(const std::vector<float>& key_times,
+                             const float* values, size_t size, bool loop,
+                             float time, size_t* segment, float* out) {
+  assert(segment && out);
+  if (key_times.empty()) {
+    std::fill(out, out + size, 0.0f);
+    return;
+  }
+
+  // Same timing behavior as animcurve nodes: loops repeat every
+  // (last - first) and hold the first value until it is reached.
+  float start{key_times.front()};
+  float end{key_times.back()};
+  if (loop && end > start) {
+    time = fmodf(time, end - start);
+    if (time < 0.0f) {
+      time += end - start;
+    }
+  }
+  if (time <= start) {
+    std::copy(values, values + size, out);
+    return;
+  }
+  if (time >= end) {
+    const float* last{values + (key_times.size() - 1) * size};
+    std::copy(last, last + size, out);
+    return;
+  }
+
+  // Blend all channels in one flat pass (the compiler vectorizes this).
+  size_t seg{FindSegment_(key_times, time, segment)};
+  float t0{key_times[seg]};
+  float t1{key_times[seg + 1]};
+  float blend{(time - t0) / (t1 - t0)};
+  const float* a{values + seg * size};
+  const float* b{a + size};
+  for (size_t i = 0; i < size; ++i) {
+    out[i] = a[i] + (b[i] - a[i]) * blend;
+  }
+}
+
+}  // namespace ballistica::scene_v1
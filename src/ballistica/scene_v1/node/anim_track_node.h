@@ -0,0 +1,92 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_SCENE_V1_NODE_ANIM_TRACK_NODE_H_
+#define BALLISTICA_SCENE_V1_NODE_ANIM_TRACK_NODE_H_
+
+#include <vector>
+
+#include "ballistica/scene_v1/node/node.h"
+
+namespace ballistica::scene_v1 {
+
+// Node containing a keyframed track of one or more float channels driven
+// directly by scene time. Covers what used to take an animcurve node per
+// channel (each wired to the globals time attr) plus a combine node, so
+// one of these and a single connection can drive any float or float-array
+// attr. Requires protocol 36.
+class AnimTrackNode : public Node {
+ public:
+  static auto InitType() -> NodeType*;
+
+  explicit AnimTrackNode(Scene* scene);
+  ~AnimTrackNode() override;
+
+  auto size() const -> int { return size_; }
+  void set_size(int val);
+
+  auto loop() const -> bool { return loop_; }
+  void set_loop(bool val) {
+    loop_ = val;
+    out_dirty_ = true;
+  }
+
+  auto times() const -> const std::vector<millisecs_t>& { return times_; }
+  void set_times(const std::vector<millisecs_t>& vals) {
+    times_ = vals;
+    keys_dirty_ = true;
+  }
+
+  /// Key values, `size` channels per key, one key after another.
+  auto values() const -> const std::vector<float>& { return values_; }
+  void set_values(const std::vector<float>& vals) {
+    values_ = vals;
+    keys_dirty_ = true;
+  }
+
+  auto offset() const -> float { return offset_; }
+  void set_offset(float val) {
+    offset_ = val;
+    out_dirty_ = true;
+  }
+
+  auto GetOut() -> float;
+  auto GetOutput() -> std::vector<float>;
+
+  /// Evaluate a track at `time` (offset already applied) into the `size`
+  /// floats at `out`. Key times must be in order, with `size` values per
+  /// key at `values`. `segment` is where the last lookup landed; it is
+  /// used as a starting guess and updated.
+  static void Evaluate(const std::vector<float>& key_times,
+                       const float* values, size_t size, bool loop,
+                       float time, size_t* segment, float* out);
+
+ private:
+  void Update_();
+  void RebuildKeys_();
+  static auto FindSegment_(const std::vector<float>& key_times, float time,
+                           size_t* segment) -> size_t;
+
+  int size_{1};
+  bool loop_{};
+  float offset_{};
+  std::vector<millisecs_t> times_;
+  std::vector<float> values_;
+
+  // Key times as floats, checked for being in order; one per key with a
+  // full set of values.
+  std::vector<float> key_times_;
+
+  // The segment we last evaluated in; animations mostly move forward
+  // through their keys, so we check here (and just past) before falling
+  // back to a binary search.
+  size_t segment_{};
+
+  bool keys_dirty_{true};
+  bool out_dirty_{true};
+  millisecs_t out_time_{-1};
+  std::vector<float> output_;
+};
+
+}  // namespace ballistica::scene_v1
+
+#endif  // BALLISTICA_SCENE_V1_NODE_ANIM_TRACK_NODE_H_
@@ -6,6 +6,7 @@
 #include <vector>
 
 #include "ballistica/base/python/support/python_context_call.h"
+#include "ballistica/base/support/step_profiler.h"
 #include "ballistica/core/core.h"
 #include "ballistica/scene_v1/dynamics/part.h"
 #include "ballistica/scene_v1/node/node_attribute.h"
@@ -412,6 +413,8 @@ void Node::DispatchUserMessage(PyObject* obj, const char* label) {
       PythonRef c(handlemessage_obj, PythonRef::kSteal);
       {
         Python::ScopedCallLabel lscope(label);
+        base::StepProfiler::ScopedSample sample{
+            base::StepProfiler::Category::kHandleMessage, c.get()};
         c.Call(PythonRef(Py_BuildValue("(O)", obj), PythonRef::kSteal));
       }
     } catch (const std::exception& e) {
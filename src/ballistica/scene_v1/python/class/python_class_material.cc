@@ -362,6 +362,14 @@ PyMethodDef PythonClassMaterial::tp_methods[] = {
      "  contact; ``'at_disconnect'`` means to fire once they cease being\n"
      "  in contact.\n"
      "\n"
+     "``('batch_call', when, callable)``\n"
+     "  Like ``'call'``, but instead of firing once per contact, gathers\n"
+     "  every contact from a sim step and calls ``callable`` once at the\n"
+     "  end of the step with a list of :class:`bascenev1.CollisionEvent`\n"
+     "  objects. :func:`bascenev1.getcollision()` is not usable from\n"
+     "  these calls; everything it would provide is in the events. Much\n"
+     "  cheaper than ``'call'`` for materials that see lots of contacts.\n"
+     "\n"
      "``('message', who, when, message_obj)``\n"
      "  Sends a message object; ``who`` can be either ``'our_node'`` or\n"
      "  ``'their_node'``, ``when`` can be ``'at_connect'`` or\n"
@@ -369,6 +377,15 @@ PyMethodDef PythonClassMaterial::tp_methods[] = {
      "  send. This has the same effect as calling the node's\n"
      "  :meth:`bascenev1.Node.handlemessage()` method.\n"
      "\n"
+     "``('batch_message', who, when, message_obj)``\n"
+     "  Like ``'message'``, but instead of sending once per contact,\n"
+     "  gathers every contact from a sim step and sends each target node a\n"
+     "  single :class:`bascenev1.BatchedMessage` at the end of the step\n"
+     "  holding ``message_obj`` and a list of\n"
+     "  :class:`bascenev1.CollisionEvent` objects for its contacts.\n"
+     "  :func:`bascenev1.getcollision()` is not usable from handlers of\n"
+     "  these; everything it would provide is in the events.\n"
+     "\n"
      "``('modify_part_collision', attr, value)``\n"
      "  Changes some characteristic of the physical collision that will\n"
      "  occur between our part and their part. This change will remain in\n"
@@ -605,7 +622,7 @@ void DoAddAction(PyObject* actions_obj,
   assert(size > 0);
   PyObject* obj = PyTuple_GET_ITEM(actions_obj, 0);
   std::string type = Python::GetString(obj);
-  if (type == "call") {
+  if (type == "call" || type == "batch_call") {
     if (size != 3) {
       throw Exception("Expected 3 values for command action tuple.",
                       PyExcType::kValue);
@@ -622,8 +639,8 @@ void DoAddAction(PyObject* actions_obj,
     }
     PyObject* call_obj = PyTuple_GET_ITEM(actions_obj, 2);
     (*actions).push_back(Object::New<MaterialAction, PythonCallMaterialAction>(
-        at_disconnect, call_obj));
-  } else if (type == "message") {
+        at_disconnect, call_obj, type == "batch_call"));
+  } else if (type == "message" || type == "batch_message") {
     if (size < 4) {
       throw Exception("Expected >= 4 values for message action tuple.",
                       PyExcType::kValue);
@@ -653,10 +670,15 @@ void DoAddAction(PyObject* actions_obj,
     std::vector<char> b;
     PyObject* user_message_obj = nullptr;
     SceneV1Python::DoBuildNodeMessage(actions_obj, 3, &b, &user_message_obj);
+    if (type == "batch_message" && !user_message_obj) {
+      throw Exception("batch_message actions require a message object.",
+                      PyExcType::kValue);
+    }
     if (user_message_obj) {
       (*actions).push_back(
           Object::New<MaterialAction, NodeUserMessageMaterialAction>(
-              target_other_val, at_disconnect, user_message_obj));
+              target_other_val, at_disconnect, user_message_obj,
+              type == "batch_message"));
     } else if (!b.empty()) {
       (*actions).push_back(
           Object::New<MaterialAction, NodeMessageMaterialAction>(
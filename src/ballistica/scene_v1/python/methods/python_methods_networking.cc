@@ -20,6 +20,7 @@
 #include "ballistica/shared/networking/sockaddr.h"
 #include "ballistica/shared/python/python.h"
 #include "ballistica/shared/python/python_macros.h"
+#include "ballistica/shared/python/python_ref.h"
 
 namespace ballistica::scene_v1 {
 
@@ -676,6 +677,130 @@ static PyMethodDef PyGetClientPublicDeviceUUIDDef = {
     "periodically with updates to the game or operating system.",
 };
 
+// --------------------------- get_client_usage --------------------------------
+
+static auto UsageDict(const ConnectionToClient::Usage& usage, int64_t bytes_out)
+    -> PythonRef {
+  return PythonRef::Stolen(Py_BuildValue(
+      "{s:d,s:L,s:L,s:L}", "process_ms",
+      static_cast<double>(usage.process_time) / 1000.0, "bytes_in",
+      static_cast<long long>(usage.bytes_in),  // NOLINT
+      "bytes_out",
+      static_cast<long long>(bytes_out),  // NOLINT
+      "messages_in",
+      static_cast<long long>(usage.messages_in)));  // NOLINT
+}
+
+static auto PyGetClientUsage(PyObject* self, PyObject* args, PyObject* keywds)
+    -> PyObject* {
+  BA_PYTHON_TRY;
+  int client_id;
+  static const char* kwlist[] = {"client_id", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "i",
+                                   const_cast<char**>(kwlist), &client_id)) {
+    return nullptr;
+  }
+  auto* appmode = classic::ClassicAppMode::GetActiveOrThrow();
+
+  auto&& connection{
+      appmode->connections()->connections_to_clients().find(client_id)};
+  if (connection == appmode->connections()->connections_to_clients().end()) {
+    Py_RETURN_NONE;
+  }
+  auto* client{connection->second.get()};
+  assert(client);
+
+  auto message_counts{PythonRef::Stolen(PyDict_New())};
+  for (int i = 0; i < 256; ++i) {
+    if (auto count{client->message_counts()[i]}) {
+      auto key{PythonRef::Stolen(PyLong_FromLong(i))};
+      auto value{PythonRef::Stolen(PyLong_FromLongLong(count))};
+      PyDict_SetItem(message_counts.get(), key.get(), value.get());
+    }
+  }
+  auto total{UsageDict(client->usage_total(), client->GetBytesOutTotal())};
+  auto last_second{UsageDict(client->usage_last_second(),
+                             client->GetBytesOutPerSecond())};
+  return Py_BuildValue("{s:O,s:O,s:O,s:i,s:O}", "total", total.get(),
+                       "last_second", last_second.get(), "message_counts",
+                       message_counts.get(), "strikes",
+                       client->limit_strikes(), "throttled",
+                       client->throttled() ? Py_True : Py_False);
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyGetClientUsageDef = {
+    "get_client_usage",             // name
+    (PyCFunction)PyGetClientUsage,  // method
+    METH_VARARGS | METH_KEYWORDS,   // flags
+
+    "get_client_usage(client_id: int) -> dict[str, Any] | None\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Return what a connected client is costing us, or None if there is\n"
+    "no such client. 'total' and 'last_second' each contain\n"
+    "'process_ms', 'bytes_in', 'bytes_out', and 'messages_in'.\n"
+    "'message_counts' maps incoming message types to counts, 'strikes'\n"
+    "is how many seconds in a row the client has been over its limits,\n"
+    "and 'throttled' is whether its traffic is currently being ignored.",
+};
+
+// --------------------------- set_client_limits -------------------------------
+
+static auto PySetClientLimits(PyObject* self, PyObject* args, PyObject* keywds)
+    -> PyObject* {
+  BA_PYTHON_TRY;
+  double process_ms_per_second{};
+  int bytes_in_per_second{};
+  int messages_in_per_second{};
+  int strikes_to_kick{};
+  int ban_seconds{300};
+  static const char* kwlist[] = {"process_ms_per_second",
+                                 "bytes_in_per_second",
+                                 "messages_in_per_second",
+                                 "strikes_to_kick",
+                                 "ban_seconds",
+                                 nullptr};
+  if (!PyArg_ParseTupleAndKeywords(
+          args, keywds, "|diiii", const_cast<char**>(kwlist),
+          &process_ms_per_second, &bytes_in_per_second,
+          &messages_in_per_second, &strikes_to_kick, &ban_seconds)) {
+    return nullptr;
+  }
+  auto* appmode = classic::ClassicAppMode::GetActiveOrThrow();
+  ConnectionSet::ClientLimits limits;
+  limits.process_time_per_second =
+      static_cast<microsecs_t>(process_ms_per_second * 1000.0);
+  limits.bytes_in_per_second = bytes_in_per_second;
+  limits.messages_in_per_second = messages_in_per_second;
+  limits.strikes_to_kick = strikes_to_kick;
+  limits.ban_seconds = ban_seconds;
+  appmode->connections()->set_client_limits(limits);
+  Py_RETURN_NONE;
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PySetClientLimitsDef = {
+    "set_client_limits",             // name
+    (PyCFunction)PySetClientLimits,  // method
+    METH_VARARGS | METH_KEYWORDS,    // flags
+
+    "set_client_limits(process_ms_per_second: float = 0.0,\n"
+    "  bytes_in_per_second: int = 0,\n"
+    "  messages_in_per_second: int = 0,\n"
+    "  strikes_to_kick: int = 0,\n"
+    "  ban_seconds: int = 300) -> None\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Limit what each connected client can cost us per second. A client\n"
+    "going over any limit has its traffic ignored for the rest of that\n"
+    "second, and one doing so for strikes_to_kick seconds in a row gets\n"
+    "kicked and banned for ban_seconds (subject to the\n"
+    "client_over_limits hook). Zero values mean no limit.",
+};
+
 // ----------------------------- get_game_port ---------------------------------
 
 static auto PyGetGamePort(PyObject* self, PyObject* args) -> PyObject* {
@@ -900,6 +1025,8 @@ auto PythonMethodsNetworking::GetMethods() -> std::vector<PyMethodDef> {
       PyDisconnectFromHostDef,
       PyDisconnectClientDef,
       PyGetClientPublicDeviceUUIDDef,
+      PyGetClientUsageDef,
+      PySetClientLimitsDef,
       PyGetConnectionToHostInfoDef,
       PyGetConnectionToHostInfo2Def,
       PyClientInfoQueryResponseDef,
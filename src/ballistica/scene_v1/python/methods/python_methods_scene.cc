@@ -3,6 +3,7 @@
 #include "ballistica/scene_v1/python/methods/python_methods_scene.h"
 
 #include <cstdio>
+#include <cstring>
 #include <list>
 #include <string>
 #include <vector>
@@ -22,6 +23,9 @@
 #include "ballistica/scene_v1/connection/connection_to_client.h"
 #include "ballistica/scene_v1/dynamics/collision.h"
 #include "ballistica/scene_v1/dynamics/dynamics.h"
+#include "ballistica/scene_v1/dynamics/nav_grid.h"
+#include "ballistica/scene_v1/dynamics/part.h"
+#include "ballistica/scene_v1/dynamics/rigid_body.h"
 #include "ballistica/scene_v1/node/node_type.h"
 #include "ballistica/scene_v1/python/class/python_class_activity_data.h"
 #include "ballistica/scene_v1/python/class/python_class_session_data.h"
@@ -30,8 +34,10 @@
 #include "ballistica/scene_v1/support/host_activity.h"
 #include "ballistica/scene_v1/support/host_session.h"
 #include "ballistica/scene_v1/support/scene.h"
+#include "ballistica/scene_v1/support/scene_snapshot.h"
 #include "ballistica/scene_v1/support/scene_v1_input_device_delegate.h"
 #include "ballistica/scene_v1/support/session_stream.h"
+#include "ballistica/scene_v1/support/state_hasher.h"
 #include "ballistica/shared/generic/json.h"
 #include "ballistica/shared/generic/utils.h"
 
@@ -899,6 +905,799 @@ static PyMethodDef PyGetNodesDef = {
     "Return all nodes in the current scene context.",
 };
 
+// ---------------------------- spatial queries --------------------------------
+
+static auto GetQueryDynamics() -> Dynamics* {
+  HostActivity* host_activity =
+      ContextRefSceneV1::FromCurrent().GetHostActivity();
+  if (!host_activity) {
+    throw Exception(PyExcType::kContext);
+  }
+  Dynamics* dynamics = host_activity->scene()->dynamics();
+  assert(dynamics);
+  return dynamics;
+}
+
+namespace {
+
+// Optional filters shared by all spatial queries.
+class QueryFilter {
+ public:
+  QueryFilter(PyObject* material_obj, PyObject* nodetype_obj) {
+    material_ = SceneV1Python::GetPyMaterial(material_obj, false, true);
+    if (nodetype_obj != Py_None) {
+      nodetype_ = Python::GetString(nodetype_obj);
+      if (!g_scene_v1->node_types().count(nodetype_)) {
+        throw Exception("Invalid node type: '" + nodetype_ + "'.",
+                        PyExcType::kValue);
+      }
+    }
+  }
+
+  // Return the hit's node if it passes, otherwise nullptr.
+  auto Check(const Dynamics::QueryHit& hit) const -> Node* {
+    Part* part = hit.body->part();
+    Node* node = part ? part->node() : nullptr;
+    if (!node) {
+      return nullptr;
+    }
+    if (material_ && !part->ContainsMaterial(material_)) {
+      return nullptr;
+    }
+    if (!nodetype_.empty() && node->type()->name() != nodetype_) {
+      return nullptr;
+    }
+    return node;
+  }
+
+  // Build a list of passing nodes (each only once) in hit order.
+  auto NodeList(const std::vector<Dynamics::QueryHit>& hits,
+                size_t max_count) const -> PyObject* {
+    std::vector<Node*> nodes;
+    for (auto&& hit : hits) {
+      if (nodes.size() >= max_count) {
+        break;
+      }
+      Node* node = Check(hit);
+      if (node && std::find(nodes.begin(), nodes.end(), node) == nodes.end()) {
+        nodes.push_back(node);
+      }
+    }
+    PyObject* py_list = PyList_New(0);
+    for (auto* node : nodes) {
+      PyList_Append(py_list, node->BorrowPyRef());
+    }
+    return py_list;
+  }
+
+ private:
+  Material* material_{};
+  std::string nodetype_;
+};
+
+}  // namespace
+
+static auto PyGetNodesInSphere(PyObject* self, PyObject* args,
+                               PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  PyObject* position_obj;
+  float radius;
+  PyObject* material_obj{Py_None};
+  PyObject* nodetype_obj{Py_None};
+  static const char* kwlist[] = {"position", "radius", "material", "nodetype",
+                                 nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "Of|OO",
+                                   const_cast<char**>(kwlist), &position_obj,
+                                   &radius, &material_obj, &nodetype_obj)) {
+    return nullptr;
+  }
+  if (!(radius >= 0.0f)) {
+    throw Exception("Radius must be >= 0.", PyExcType::kValue);
+  }
+  QueryFilter filter{material_obj, nodetype_obj};
+  Vector3f position = base::BasePython::GetPyVector3f(position_obj);
+  std::vector<Dynamics::QueryHit> hits;
+  GetQueryDynamics()->QuerySphere(position, radius, &hits);
+  return filter.NodeList(hits, hits.size());
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyGetNodesInSphereDef = {
+    "get_nodes_in_sphere",            // name
+    (PyCFunction)PyGetNodesInSphere,  // method
+    METH_VARARGS | METH_KEYWORDS,     // flags
+
+    "get_nodes_in_sphere(position: Sequence[float], radius: float,\n"
+    "  material: bascenev1.Material | None = None,\n"
+    "  nodetype: str | None = None) -> list[bascenev1.Node]\n"
+    "\n"
+    "Return nodes with collision geometry overlapping a sphere.\n"
+    "\n"
+    "Results are ordered nearest first. If material is passed, only parts\n"
+    "containing that material count; if nodetype is passed, only nodes of\n"
+    "that type are returned. This runs against the live collision world,\n"
+    "so is much cheaper than looping over getnodes() in Python.",
+};
+
+static auto PyGetNodesInBox(PyObject* self, PyObject* args, PyObject* keywds)
+    -> PyObject* {
+  BA_PYTHON_TRY;
+  PyObject* position_obj;
+  PyObject* size_obj;
+  PyObject* material_obj{Py_None};
+  PyObject* nodetype_obj{Py_None};
+  static const char* kwlist[] = {"position", "size", "material", "nodetype",
+                                 nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "OO|OO",
+                                   const_cast<char**>(kwlist), &position_obj,
+                                   &size_obj, &material_obj, &nodetype_obj)) {
+    return nullptr;
+  }
+  QueryFilter filter{material_obj, nodetype_obj};
+  Vector3f position = base::BasePython::GetPyVector3f(position_obj);
+  Vector3f size = base::BasePython::GetPyVector3f(size_obj);
+  if (!(size.x >= 0.0f && size.y >= 0.0f && size.z >= 0.0f)) {
+    throw Exception("Size values must be >= 0.", PyExcType::kValue);
+  }
+  std::vector<Dynamics::QueryHit> hits;
+  GetQueryDynamics()->QueryBox(position, size, &hits);
+  return filter.NodeList(hits, hits.size());
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyGetNodesInBoxDef = {
+    "get_nodes_in_box",            // name
+    (PyCFunction)PyGetNodesInBox,  // method
+    METH_VARARGS | METH_KEYWORDS,  // flags
+
+    "get_nodes_in_box(position: Sequence[float], size: Sequence[float],\n"
+    "  material: bascenev1.Material | None = None,\n"
+    "  nodetype: str | None = None) -> list[bascenev1.Node]\n"
+    "\n"
+    "Return nodes with collision geometry overlapping an axis-aligned box.\n"
+    "\n"
+    "The box is centered on position with full extents of size. Results\n"
+    "and filters work the same as for get_nodes_in_sphere().",
+};
+
+static auto PyGetNearestNodes(PyObject* self, PyObject* args,
+                              PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  PyObject* position_obj;
+  int count;
+  float radius;
+  PyObject* material_obj{Py_None};
+  PyObject* nodetype_obj{Py_None};
+  static const char* kwlist[] = {"position", "count",    "radius",
+                                 "material", "nodetype", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(
+          args, keywds, "Oif|OO", const_cast<char**>(kwlist), &position_obj,
+          &count, &radius, &material_obj, &nodetype_obj)) {
+    return nullptr;
+  }
+  if (count < 0) {
+    throw Exception("Count must be >= 0.", PyExcType::kValue);
+  }
+  if (!(radius >= 0.0f)) {
+    throw Exception("Radius must be >= 0.", PyExcType::kValue);
+  }
+  QueryFilter filter{material_obj, nodetype_obj};
+  Vector3f position = base::BasePython::GetPyVector3f(position_obj);
+  std::vector<Dynamics::QueryHit> hits;
+  GetQueryDynamics()->QuerySphere(position, radius, &hits);
+  return filter.NodeList(hits, static_cast<size_t>(count));
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyGetNearestNodesDef = {
+    "get_nearest_nodes",             // name
+    (PyCFunction)PyGetNearestNodes,  // method
+    METH_VARARGS | METH_KEYWORDS,    // flags
+
+    "get_nearest_nodes(position: Sequence[float], count: int,\n"
+    "  radius: float, material: bascenev1.Material | None = None,\n"
+    "  nodetype: str | None = None) -> list[bascenev1.Node]\n"
+    "\n"
+    "Return up to count nodes nearest to a point, nearest first.\n"
+    "\n"
+    "Only nodes with collision geometry within radius are considered;\n"
+    "distance is measured to each body's center. Filters work the same as\n"
+    "for get_nodes_in_sphere().",
+};
+
+static auto PyRaycast(PyObject* self, PyObject* args, PyObject* keywds)
+    -> PyObject* {
+  BA_PYTHON_TRY;
+  PyObject* start_obj;
+  PyObject* direction_obj;
+  float length;
+  PyObject* material_obj{Py_None};
+  PyObject* nodetype_obj{Py_None};
+  static const char* kwlist[] = {"start",    "direction", "length",
+                                 "material", "nodetype",  nullptr};
+  if (!PyArg_ParseTupleAndKeywords(
+          args, keywds, "OOf|OO", const_cast<char**>(kwlist), &start_obj,
+          &direction_obj, &length, &material_obj, &nodetype_obj)) {
+    return nullptr;
+  }
+  if (!(length > 0.0f)) {
+    throw Exception("Length must be > 0.", PyExcType::kValue);
+  }
+  QueryFilter filter{material_obj, nodetype_obj};
+  Vector3f start = base::BasePython::GetPyVector3f(start_obj);
+  Vector3f direction = base::BasePython::GetPyVector3f(direction_obj);
+  if (!(direction.LengthSquared() > 0.0f)) {
+    throw Exception("Direction must be non-zero.", PyExcType::kValue);
+  }
+  std::vector<Dynamics::QueryHit> hits;
+  GetQueryDynamics()->QueryRay(start, direction.Normalized(), length, &hits);
+  for (auto&& hit : hits) {
+    if (Node* node = filter.Check(hit)) {
+      return Py_BuildValue("(O(fff)(fff)f)", node->BorrowPyRef(),
+                           hit.position.x, hit.position.y, hit.position.z,
+                           hit.normal.x, hit.normal.y, hit.normal.z,
+                           hit.distance);
+    }
+  }
+  Py_RETURN_NONE;
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyRaycastDef = {
+    "raycast",                     // name
+    (PyCFunction)PyRaycast,        // method
+    METH_VARARGS | METH_KEYWORDS,  // flags
+
+    "raycast(start: Sequence[float], direction: Sequence[float],\n"
+    "  length: float, material: bascenev1.Material | None = None,\n"
+    "  nodetype: str | None = None)\n"
+    "  -> tuple[bascenev1.Node, tuple[float, float, float],\n"
+    "  tuple[float, float, float], float] | None\n"
+    "\n"
+    "Cast a ray and return the first node it hits.\n"
+    "\n"
+    "The result is (node, position, normal, distance) or None if nothing\n"
+    "passing the filters was hit. Terrain counts as a hit like anything\n"
+    "else, so pass a material or nodetype to see through it.",
+};
+
+// ------------------------------ navigation -----------------------------------
+
+static auto GetContextHostActivity() -> HostActivity* {
+  HostActivity* host_activity =
+      ContextRefSceneV1::FromCurrent().GetHostActivity();
+  if (!host_activity) {
+    throw Exception(PyExcType::kContext);
+  }
+  return host_activity;
+}
+
+static auto GetActivityScene() -> Scene* {
+  return GetContextHostActivity()->scene();
+}
+
+static auto GetNavGrid() -> NavGrid* {
+  NavGrid* nav_grid = GetActivityScene()->nav_grid();
+  if (!nav_grid) {
+    throw Exception("No nav grid has been built for this activity.",
+                    PyExcType::kRuntime);
+  }
+  return nav_grid;
+}
+
+void PythonMethodsScene::GetPointPair(PyObject* obj, Vector3f* start,
+                                      Vector3f* end) {
+  if (!PySequence_Check(obj) || PySequence_Size(obj) != 2) {
+    throw Exception("Expected a (start, end) pair of points.",
+                    PyExcType::kType);
+  }
+  PythonRef start_obj{PySequence_GetItem(obj, 0), PythonRef::kSteal};
+  PythonRef end_obj{PySequence_GetItem(obj, 1), PythonRef::kSteal};
+  *start = base::BasePython::GetPyVector3f(start_obj.get());
+  *end = base::BasePython::GetPyVector3f(end_obj.get());
+}
+
+auto PythonMethodsScene::NavPathResult(NavGrid* nav_grid,
+                                       const Vector3f& start,
+                                       const Vector3f& end,
+                                       std::vector<Vector3f>* path)
+    -> PyObject* {
+  if (!nav_grid->FindPath(start, end, path)) {
+    return Py_NewRef(Py_None);
+  }
+  PyObject* result = PyList_New(static_cast<Py_ssize_t>(path->size()));
+  for (size_t i = 0; i < path->size(); ++i) {
+    const Vector3f& point{(*path)[i]};
+    PyList_SET_ITEM(result, static_cast<Py_ssize_t>(i),
+                    Py_BuildValue("(fff)", point.x, point.y, point.z));
+  }
+  return result;
+}
+
+auto PythonMethodsScene::NavDirectionResult(NavGrid* nav_grid,
+                                            const Vector3f& position,
+                                            const Vector3f& target)
+    -> PyObject* {
+  float dir_x, dir_z;
+  if (!nav_grid->GetDirection(position, target, &dir_x, &dir_z)) {
+    return Py_NewRef(Py_None);
+  }
+  return Py_BuildValue("(ff)", dir_x, dir_z);
+}
+
+static auto PyBuildNavGrid(PyObject* self, PyObject* args, PyObject* keywds)
+    -> PyObject* {
+  BA_PYTHON_TRY;
+  float cell_size{0.5f};
+  float max_step{0.5f};
+  static const char* kwlist[] = {"cell_size", "max_step", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "|ff",
+                                   const_cast<char**>(kwlist), &cell_size,
+                                   &max_step)) {
+    return nullptr;
+  }
+  if (!(cell_size >= 0.1f) || !(max_step >= 0.0f)) {
+    throw Exception("Invalid cell_size or max_step.", PyExcType::kValue);
+  }
+  Scene* scene = GetActivityScene();
+  const float* bounds_min = scene->bounds_min();
+  const float* bounds_max = scene->bounds_max();
+  float cells = ((bounds_max[0] - bounds_min[0]) / cell_size)
+                * ((bounds_max[2] - bounds_min[2]) / cell_size);
+  if (!(cells <= 1000000.0f)) {
+    throw Exception("cell_size is too small for these map bounds.",
+                    PyExcType::kValue);
+  }
+  auto nav_grid{Object::New<NavGrid>(scene->dynamics(), bounds_min,
+                                     bounds_max, cell_size, max_step)};
+  scene->set_nav_grid(nav_grid.get());
+  return PyLong_FromLong(scene->nav_grid()->walkable_count());
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyBuildNavGridDef = {
+    "build_nav_grid",              // name
+    (PyCFunction)PyBuildNavGrid,   // method
+    METH_VARARGS | METH_KEYWORDS,  // flags
+
+    "build_nav_grid(cell_size: float = 0.5, max_step: float = 0.5) -> int\n"
+    "\n"
+    "Build a navigation grid over the current activity's terrain.\n"
+    "\n"
+    "The grid covers the map bounds with square cells of cell_size. Cells\n"
+    "get the height of the floor found there, and neighboring cells link\n"
+    "up when their floors are within max_step of each other with no wall\n"
+    "between. Call this once the map exists (terrain doesn't move); it\n"
+    "replaces any previous grid. Returns the number of walkable cells.",
+};
+
+static auto PyHaveNavGrid(PyObject* self) -> PyObject* {
+  BA_PYTHON_TRY;
+  if (GetActivityScene()->nav_grid()) {
+    Py_RETURN_TRUE;
+  }
+  Py_RETURN_FALSE;
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyHaveNavGridDef = {
+    "have_nav_grid",             // name
+    (PyCFunction)PyHaveNavGrid,  // method
+    METH_NOARGS,                 // flags
+
+    "have_nav_grid() -> bool\n"
+    "\n"
+    "Return whether build_nav_grid() has been run for this activity.",
+};
+
+static auto PyFindNavPaths(PyObject* self, PyObject* args, PyObject* keywds)
+    -> PyObject* {
+  BA_PYTHON_TRY;
+  PyObject* requests_obj;
+  static const char* kwlist[] = {"requests", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "O",
+                                   const_cast<char**>(kwlist),
+                                   &requests_obj)) {
+    return nullptr;
+  }
+  NavGrid* nav_grid = GetNavGrid();
+  PythonRef requests{PySequence_Fast(requests_obj, "Expected a sequence."),
+                     PythonRef::kSteal};
+  if (!requests.exists()) {
+    return nullptr;
+  }
+  Py_ssize_t count = PySequence_Fast_GET_SIZE(requests.get());
+  PythonRef results{PyList_New(count), PythonRef::kSteal};
+  std::vector<Vector3f> path;
+  for (Py_ssize_t i = 0; i < count; ++i) {
+    Vector3f start, end;
+    PythonMethodsScene::GetPointPair(
+        PySequence_Fast_GET_ITEM(requests.get(), i), &start, &end);
+    PyList_SET_ITEM(
+        results.get(), i,
+        PythonMethodsScene::NavPathResult(nav_grid, start, end, &path));
+  }
+  return results.HandOver();
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyFindNavPathsDef = {
+    "find_nav_paths",              // name
+    (PyCFunction)PyFindNavPaths,   // method
+    METH_VARARGS | METH_KEYWORDS,  // flags
+
+    "find_nav_paths(requests: Sequence[tuple[Sequence[float],\n"
+    "  Sequence[float]]]) -> list[list[tuple[float, float, float]] | None]\n"
+    "\n"
+    "Find walkable paths for a batch of (start, end) point pairs.\n"
+    "\n"
+    "Each result is a list of waypoints from start to end (with straight\n"
+    "runs collapsed) or None if there is no route. Requires a grid from\n"
+    "build_nav_grid().",
+};
+
+static auto PyGetNavDirections(PyObject* self, PyObject* args,
+                               PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  PyObject* requests_obj;
+  static const char* kwlist[] = {"requests", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "O",
+                                   const_cast<char**>(kwlist),
+                                   &requests_obj)) {
+    return nullptr;
+  }
+  NavGrid* nav_grid = GetNavGrid();
+  PythonRef requests{PySequence_Fast(requests_obj, "Expected a sequence."),
+                     PythonRef::kSteal};
+  if (!requests.exists()) {
+    return nullptr;
+  }
+  Py_ssize_t count = PySequence_Fast_GET_SIZE(requests.get());
+  PythonRef results{PyList_New(count), PythonRef::kSteal};
+  for (Py_ssize_t i = 0; i < count; ++i) {
+    Vector3f position, target;
+    PythonMethodsScene::GetPointPair(
+        PySequence_Fast_GET_ITEM(requests.get(), i), &position, &target);
+    PyList_SET_ITEM(
+        results.get(), i,
+        PythonMethodsScene::NavDirectionResult(nav_grid, position, target));
+  }
+  return results.HandOver();
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyGetNavDirectionsDef = {
+    "get_nav_directions",             // name
+    (PyCFunction)PyGetNavDirections,  // method
+    METH_VARARGS | METH_KEYWORDS,     // flags
+
+    "get_nav_directions(requests: Sequence[tuple[Sequence[float],\n"
+    "  Sequence[float]]]) -> list[tuple[float, float] | None]\n"
+    "\n"
+    "Get which way to move for a batch of (position, target) pairs.\n"
+    "\n"
+    "Each result is a normalized (x, z) direction that heads along the\n"
+    "walkable grid toward the target, or None if it can't be reached.\n"
+    "Distance fields toward recent targets are cached natively, so lots\n"
+    "of bots chasing a few players is cheap. Requires a grid from\n"
+    "build_nav_grid().",
+};
+
+static auto PyCheckLineOfSight(PyObject* self, PyObject* args,
+                               PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  PyObject* segments_obj;
+  static const char* kwlist[] = {"segments", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "O",
+                                   const_cast<char**>(kwlist),
+                                   &segments_obj)) {
+    return nullptr;
+  }
+  Dynamics* dynamics = GetActivityScene()->dynamics();
+  PythonRef segments{PySequence_Fast(segments_obj, "Expected a sequence."),
+                     PythonRef::kSteal};
+  if (!segments.exists()) {
+    return nullptr;
+  }
+  Py_ssize_t count = PySequence_Fast_GET_SIZE(segments.get());
+  PythonRef results{PyList_New(count), PythonRef::kSteal};
+  Dynamics::QueryHit hit;
+  for (Py_ssize_t i = 0; i < count; ++i) {
+    Vector3f start, end;
+    PythonMethodsScene::GetPointPair(
+        PySequence_Fast_GET_ITEM(segments.get(), i), &start, &end);
+    bool blocked = dynamics->RaycastTerrain(start, end, &hit);
+    PyList_SET_ITEM(results.get(), i, PyBool_FromLong(!blocked));
+  }
+  return results.HandOver();
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyCheckLineOfSightDef = {
+    "check_line_of_sight",            // name
+    (PyCFunction)PyCheckLineOfSight,  // method
+    METH_VARARGS | METH_KEYWORDS,     // flags
+
+    "check_line_of_sight(segments: Sequence[tuple[Sequence[float],\n"
+    "  Sequence[float]]]) -> list[bool]\n"
+    "\n"
+    "Check a batch of (start, end) segments against the terrain.\n"
+    "\n"
+    "Each result is True if nothing in the map's terrain blocks the\n"
+    "segment. Nodes other than terrain are ignored.",
+};
+
+// ------------------------------ state hashing --------------------------------
+
+static auto PyGetStateHash(PyObject* self) -> PyObject* {
+  BA_PYTHON_TRY;
+  return PyLong_FromUnsignedLongLong(
+      StateHasher::HashScene(GetActivityScene()));
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyGetStateHashDef = {
+    "get_state_hash",             // name
+    (PyCFunction)PyGetStateHash,  // method
+    METH_NOARGS,                  // flags
+
+    "get_state_hash() -> int\n"
+    "\n"
+    "Return a hash of the current activity's simulation state.\n"
+    "\n"
+    "This covers scene time, node attribute values and rigid body\n"
+    "positions and velocities. Two runs fed the same inputs should\n"
+    "produce the same hash at the same step.",
+};
+
+static auto PyBeginStateHashLog(PyObject* self, PyObject* args,
+                                PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  int per_node{};
+  PyObject* seed_obj{Py_None};
+  static const char* kwlist[] = {"per_node", "seed", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "|pO",
+                                   const_cast<char**>(kwlist), &per_node,
+                                   &seed_obj)) {
+    return nullptr;
+  }
+  Scene* scene = GetActivityScene();
+  if (seed_obj != Py_None) {
+    srand(static_cast<unsigned int>(  // NOLINT
+        Python::GetInt64(seed_obj)));
+  }
+  scene->BeginStateHashLog(per_node);
+  Py_RETURN_NONE;
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyBeginStateHashLogDef = {
+    "begin_state_hash_log",            // name
+    (PyCFunction)PyBeginStateHashLog,  // method
+    METH_VARARGS | METH_KEYWORDS,      // flags
+
+    "begin_state_hash_log(per_node: bool = False, seed: int | None = None)\n"
+    "  -> None\n"
+    "\n"
+    "Start recording a state hash after every step of this activity.\n"
+    "\n"
+    "See get_state_hash(). With per_node, each node's own hash is kept\n"
+    "too so divergences can be pinned down (this is much slower). If seed\n"
+    "is passed, the native random number generator is reseeded with it\n"
+    "so effects using it can match between runs.",
+};
+
+auto PythonMethodsScene::StateHashLogToPython(const StateHashLog& log)
+    -> PythonRef {
+  PythonRef steps{PyList_New(static_cast<Py_ssize_t>(log.steps.size())),
+                  PythonRef::kSteal};
+  for (size_t i = 0; i < log.steps.size(); ++i) {
+    auto& step{log.steps[i]};
+    PythonRef node_hashes{PyDict_New(), PythonRef::kSteal};
+    for (auto&& node_hash : step.node_hashes) {
+      PythonRef key{PyLong_FromLongLong(node_hash.first), PythonRef::kSteal};
+      PythonRef val{PyLong_FromUnsignedLongLong(node_hash.second),
+                    PythonRef::kSteal};
+      PyDict_SetItem(node_hashes.get(), key.get(), val.get());
+    }
+    PyObject* entry{Py_BuildValue(
+        "(LKO)", static_cast<long long>(step.stepnum),  // NOLINT
+        static_cast<unsigned long long>(step.hash),     // NOLINT
+        node_hashes.get())};
+    if (!entry) {
+      throw Exception();
+    }
+    PyList_SET_ITEM(steps.get(), static_cast<Py_ssize_t>(i), entry);
+  }
+  PythonRef descriptions{PyDict_New(), PythonRef::kSteal};
+  for (auto&& description : log.node_descriptions) {
+    PythonRef key{PyLong_FromLongLong(description.first), PythonRef::kSteal};
+    PythonRef val{PyUnicode_FromString(description.second.c_str()),
+                  PythonRef::kSteal};
+    PyDict_SetItem(descriptions.get(), key.get(), val.get());
+  }
+  return PythonRef::Stolen(Py_BuildValue("{sOsO}", "steps", steps.get(),
+                                         "nodes", descriptions.get()));
+}
+
+static auto PyEndStateHashLog(PyObject* self) -> PyObject* {
+  BA_PYTHON_TRY;
+  auto log{GetActivityScene()->EndStateHashLog()};
+  if (!log) {
+    Py_RETURN_NONE;
+  }
+  return PythonMethodsScene::StateHashLogToPython(*log).HandOver();
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyEndStateHashLogDef = {
+    "end_state_hash_log",            // name
+    (PyCFunction)PyEndStateHashLog,  // method
+    METH_NOARGS,                     // flags
+
+    "end_state_hash_log() -> dict[str, Any] | None\n"
+    "\n"
+    "Stop recording state hashes and return what was recorded.\n"
+    "\n"
+    "The result has 'steps', a list of (step, hash, node_hashes) with\n"
+    "node_hashes mapping node ids to their hashes (empty unless per_node\n"
+    "was set), and 'nodes', mapping node ids to descriptions. Returns\n"
+    "None if no log was running.",
+};
+
+void PythonMethodsScene::GetSnapshotBytes(PyObject* obj, const uint8_t** data,
+                                          size_t* size) {
+  if (!PyBytes_Check(obj)) {
+    throw Exception("Expected a snapshot (bytes).", PyExcType::kType);
+  }
+  *data = reinterpret_cast<const uint8_t*>(PyBytes_AS_STRING(obj));
+  *size = static_cast<size_t>(PyBytes_GET_SIZE(obj));
+}
+
+static auto PySnapshotScene(PyObject* self, PyObject* args, PyObject* keywds)
+    -> PyObject* {
+  BA_PYTHON_TRY;
+  PyObject* previous_obj{Py_None};
+  static const char* kwlist[] = {"previous", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "|O",
+                                   const_cast<char**>(kwlist),
+                                   &previous_obj)) {
+    return nullptr;
+  }
+  const uint8_t* previous{};
+  size_t previous_size{};
+  if (previous_obj != Py_None) {
+    PythonMethodsScene::GetSnapshotBytes(previous_obj, &previous,
+                                         &previous_size);
+  }
+  auto snapshot{SceneSnapshot::Capture(GetContextHostActivity(), previous,
+                                       previous_size)};
+  return PyBytes_FromStringAndSize(
+      reinterpret_cast<const char*>(snapshot.data()),
+      static_cast<Py_ssize_t>(snapshot.size()));
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PySnapshotSceneDef = {
+    "snapshot_scene",              // name
+    (PyCFunction)PySnapshotScene,  // method
+    METH_VARARGS | METH_KEYWORDS,  // flags
+
+    "snapshot_scene(previous: bytes | None = None) -> bytes\n"
+    "\n"
+    "Capture the current activity's simulation state in memory.\n"
+    "\n"
+    "This covers scene time, sim timer schedules, node attrs and rigid\n"
+    "body states, in a compact binary form to pass to\n"
+    "restore_scene_snapshot() later. Passing the previous snapshot of\n"
+    "this activity lets nodes that haven't changed skip rehashing.",
+};
+
+static auto PyRestoreSceneSnapshot(PyObject* self, PyObject* args,
+                                   PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  PyObject* snapshot_obj;
+  static const char* kwlist[] = {"snapshot", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "O",
+                                   const_cast<char**>(kwlist),
+                                   &snapshot_obj)) {
+    return nullptr;
+  }
+  const uint8_t* data;
+  size_t size;
+  PythonMethodsScene::GetSnapshotBytes(snapshot_obj, &data, &size);
+  return PyLong_FromLong(
+      SceneSnapshot::Restore(GetContextHostActivity(), data, size));
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyRestoreSceneSnapshotDef = {
+    "restore_scene_snapshot",             // name
+    (PyCFunction)PyRestoreSceneSnapshot,  // method
+    METH_VARARGS | METH_KEYWORDS,         // flags
+
+    "restore_scene_snapshot(snapshot: bytes) -> int\n"
+    "\n"
+    "Roll the current activity back to a snapshot_scene() snapshot.\n"
+    "\n"
+    "Only nodes whose state differs from the snapshot are touched; the\n"
+    "number of those is returned. Nodes and timers that have died since\n"
+    "can't be brought back, and ones created since are left alone.\n"
+    "Nothing is sent to clients, so this raises an error while clients\n"
+    "are connected or a replay is being recorded. The whole snapshot is\n"
+    "checked before anything is changed.",
+};
+
+static auto PyGetSnapshotHash(PyObject* self, PyObject* args,
+                              PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  PyObject* snapshot_obj;
+  static const char* kwlist[] = {"snapshot", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "O",
+                                   const_cast<char**>(kwlist),
+                                   &snapshot_obj)) {
+    return nullptr;
+  }
+  const uint8_t* data;
+  size_t size;
+  PythonMethodsScene::GetSnapshotBytes(snapshot_obj, &data, &size);
+  return PyLong_FromUnsignedLongLong(SceneSnapshot::GetHash(data, size));
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyGetSnapshotHashDef = {
+    "get_snapshot_hash",             // name
+    (PyCFunction)PyGetSnapshotHash,  // method
+    METH_VARARGS | METH_KEYWORDS,    // flags
+
+    "get_snapshot_hash(snapshot: bytes) -> int\n"
+    "\n"
+    "Return the state hash stored in a snapshot_scene() snapshot.",
+};
+
+// --------------------------- get_dynamics_stats ------------------------------
+
+static auto PyGetDynamicsStats(PyObject* self) -> PyObject* {
+  BA_PYTHON_TRY;
+  Scene* scene = GetActivityScene();
+  int64_t bodies{};
+  int64_t sleeping{};
+  for (auto&& node : scene->nodes()) {
+    for (Part* part : node->parts()) {
+      for (RigidBody* body : part->rigid_bodies()) {
+        if (body->type() == RigidBody::Type::kBody) {
+          bodies++;
+          sleeping += !dBodyIsEnabled(body->body());
+        }
+      }
+    }
+  }
+  int64_t contacts{scene->dynamics()->collision_count()};
+  return Py_BuildValue("{s:L,s:L,s:L}", "bodies",
+                       static_cast<long long>(bodies),  // NOLINT
+                       "sleeping",
+                       static_cast<long long>(sleeping),  // NOLINT
+                       "contacts",
+                       static_cast<long long>(contacts));  // NOLINT
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyGetDynamicsStatsDef = {
+    "get_dynamics_stats",             // name
+    (PyCFunction)PyGetDynamicsStats,  // method
+    METH_NOARGS,                      // flags
+
+    "get_dynamics_stats() -> dict[str, int]\n"
+    "\n"
+    "Return rigid body counts for the current activity.\n"
+    "\n"
+    "'bodies' counts dynamic bodies, 'sleeping' how many of those have\n"
+    "come to rest and dropped out of the simulation until something\n"
+    "touches them, and 'contacts' the contacts made in the last step.\n"
+    "\n"
+    ":meta private:",
+};
+
 // -------------------------- get_collision_info -------------------------------
 
 static auto DoGetCollideValue(Dynamics* dynamics, const Collision* c,
@@ -1761,6 +2560,22 @@ auto PythonMethodsScene::GetMethods() -> std::vector<PyMethodDef> {
       PyCameraShakeDef,
       PyGetCollisionInfoDef,
       PyGetNodesDef,
+      PyGetNodesInSphereDef,
+      PyGetNodesInBoxDef,
+      PyGetNearestNodesDef,
+      PyRaycastDef,
+      PyBuildNavGridDef,
+      PyHaveNavGridDef,
+      PyFindNavPathsDef,
+      PyGetNavDirectionsDef,
+      PyCheckLineOfSightDef,
+      PyGetStateHashDef,
+      PyBeginStateHashLogDef,
+      PyEndStateHashLogDef,
+      PySnapshotSceneDef,
+      PyRestoreSceneSnapshotDef,
+      PyGetSnapshotHashDef,
+      PyGetDynamicsStatsDef,
       PySetInternalMusicDef,
       PyPrintNodesDef,
       PyNewNodeDef,
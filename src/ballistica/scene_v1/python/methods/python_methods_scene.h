@@ -5,7 +5,7 @@
 
 #include <vector>
 
-#include "ballistica/shared/ballistica.h"
+#include "ballistica/scene_v1/scene_v1.h"
 
 namespace ballistica::scene_v1 {
 
@@ -13,6 +13,25 @@ namespace ballistica::scene_v1 {
 class PythonMethodsScene {
  public:
   static auto GetMethods() -> std::vector<PyMethodDef>;
+
+  /// Pull a (start, end) pair of points out of a sequence item.
+  static void GetPointPair(PyObject* obj, Vector3f* start, Vector3f* end);
+
+  /// Waypoint list for a path request, or None if there's no route.
+  static auto NavPathResult(NavGrid* nav_grid, const Vector3f& start,
+                            const Vector3f& end, std::vector<Vector3f>* path)
+      -> PyObject*;
+
+  /// (x, z) direction for a direction request, or None if there's no route.
+  static auto NavDirectionResult(NavGrid* nav_grid, const Vector3f& position,
+                                 const Vector3f& target) -> PyObject*;
+
+  /// Build the per-step list state_hash_log() returns.
+  static auto StateHashLogToPython(const StateHashLog& log) -> PythonRef;
+
+  /// Pull snapshot bytes out of an arg.
+  static void GetSnapshotBytes(PyObject* obj, const uint8_t** data,
+                               size_t* size);
 };
 
 }  // namespace ballistica::scene_v1
@@ -0,0 +1,2341 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/scene_v1/python/methods/python_methods_testing.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "ballistica/base/app_adapter/app_adapter.h"
+#include "ballistica/base/dynamics/bg/bg_dynamics_budget.h"
+#include "ballistica/base/dynamics/collision_cache.h"
+#include "ballistica/base/graphics/graphics_server.h"
+#include "ballistica/base/graphics/renderer/renderer_validating.h"
+#include "ballistica/base/graphics/support/frame_def.h"
+#include "ballistica/base/graphics/support/frame_pacer.h"
+#include "ballistica/base/graphics/support/render_command_buffer.h"
+#include "ballistica/base/graphics/texture/texture_stream_plan.h"
+#include "ballistica/base/input/support/input_latency.h"
+#include "ballistica/base/input/support/remote_app_server.h"
+#include "ballistica/base/networking/networking.h"
+#include "ballistica/base/networking/udp_admission.h"
+#include "ballistica/base/python/base_python.h"
+#include "ballistica/base/python/methods/python_methods_base_1.h"
+#include "ballistica/base/python/methods/python_methods_base_3.h"
+#include "ballistica/base/support/step_profiler.h"
+#include "ballistica/core/platform/core_platform.h"
+#include "ballistica/scene_v1/connection/connection_set.h"
+#include "ballistica/scene_v1/connection/connection_to_client.h"
+#include "ballistica/scene_v1/dynamics/dynamics.h"
+#include "ballistica/scene_v1/dynamics/material/node_message_material_action.h"
+#include "ballistica/scene_v1/dynamics/material/node_user_msg_mat_action.h"
+#include "ballistica/scene_v1/dynamics/material/python_call_material_action.h"
+#include "ballistica/scene_v1/dynamics/nav_grid.h"
+#include "ballistica/scene_v1/node/anim_track_node.h"
+#include "ballistica/scene_v1/python/methods/python_methods_scene.h"
+#include "ballistica/scene_v1/python/scene_v1_python.h"
+#include "ballistica/scene_v1/support/client_handshake_info.h"
+#include "ballistica/scene_v1/support/scene.h"
+#include "ballistica/scene_v1/support/scene_snapshot.h"
+#include "ballistica/scene_v1/support/session_snapshot.h"
+#include "ballistica/scene_v1/support/state_hasher.h"
+#include "ballistica/shared/networking/sockaddr.h"
+#include "ballistica/shared/python/python.h"
+#include "ballistica/shared/python/python_macros.h"
+
+// These drive engine internals with synthetic inputs for our test suite.
+// They aren't part of any public api, so only debug and test builds carry
+// them.
+#if BA_DEBUG_BUILD || BA_VARIANT_TEST_BUILD
+
+namespace ballistica::base {
+
+// -------------------------- step_profile_simulate ----------------------------
+
+namespace {
+
+class StepProfileSimulation {
+ public:
+  explicit StepProfileSimulation(int interval) {
+    profiler_.SetSyntheticTime(time_);
+    profiler_.Start(interval);
+  }
+
+  void RunOp(PyObject* op) {
+    if (PyUnicode_Check(op)) {
+      std::string command{PyUnicode_AsUTF8(op)};
+      if (command == "update") {
+        profiler_.OnSessionUpdate();
+      } else if (command == "reset") {
+        profiler_.Reset();
+      } else if (command == "stop") {
+        profiler_.Stop();
+      } else {
+        throw Exception("Invalid op: '" + command + "'.", PyExcType::kValue);
+      }
+      return;
+    }
+    const char* category_name;
+    PyObject* key;
+    long long duration;  // NOLINT
+    PyObject* children{};
+    if (!PyArg_ParseTuple(op, "sOL|O", &category_name, &key, &duration,
+                          &children)) {
+      throw Exception();
+    }
+    if (duration < 0) {
+      throw Exception("Sample durations can't be negative.",
+                      PyExcType::kValue);
+    }
+    auto category{CategoryFromName_(category_name)};
+
+    // Strings are native things (node types, etc.); anything else is a
+    // Python callable.
+    std::optional<StepProfiler::ScopedSample> sample;
+    if (PyUnicode_Check(key)) {
+      auto& name{*names_.emplace(PyUnicode_AsUTF8(key)).first};
+      sample.emplace(&profiler_, category, &name, name.c_str());
+    } else {
+      sample.emplace(&profiler_, category, key);
+    }
+    if (children) {
+      if (!PyList_Check(children)) {
+        throw Exception("Expected a list of child ops.", PyExcType::kType);
+      }
+      for (Py_ssize_t i = 0; i < PyList_GET_SIZE(children); ++i) {
+        RunOp(PyList_GET_ITEM(children, i));
+      }
+    }
+    time_ += duration;
+    profiler_.SetSyntheticTime(time_);
+  }
+
+  auto profiler() const -> const StepProfiler& { return profiler_; }
+
+ private:
+  static auto CategoryFromName_(const std::string& name)
+      -> StepProfiler::Category {
+    for (auto category :
+         {StepProfiler::Category::kSceneStep, StepProfiler::Category::kNodeStep,
+          StepProfiler::Category::kNodeConnections,
+          StepProfiler::Category::kMaterialAction,
+          StepProfiler::Category::kPythonCall,
+          StepProfiler::Category::kHandleMessage}) {
+      if (name == StepProfiler::CategoryName(category)) {
+        return category;
+      }
+    }
+    throw Exception("Invalid category: '" + name + "'.", PyExcType::kValue);
+  }
+
+  StepProfiler profiler_;
+  std::set<std::string> names_;
+  microsecs_t time_{};
+};
+
+}  // namespace
+
+static auto PyStepProfileSimulate(PyObject* self, PyObject* args,
+                                  PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  PyObject* ops_obj;
+  int interval{1};
+  int max_entries{30};
+  static const char* kwlist[] = {"ops", "interval", "max_entries", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "O|ii",
+                                   const_cast<char**>(kwlist), &ops_obj,
+                                   &interval, &max_entries)) {
+    return nullptr;
+  }
+  if (!PyList_Check(ops_obj)) {
+    throw Exception("Expected a list of ops.", PyExcType::kType);
+  }
+  if (interval < 1) {
+    throw Exception("interval must be at least 1.", PyExcType::kValue);
+  }
+  StepProfileSimulation simulation{interval};
+  for (Py_ssize_t i = 0; i < PyList_GET_SIZE(ops_obj); ++i) {
+    simulation.RunOp(PyList_GET_ITEM(ops_obj, i));
+  }
+  auto& profiler{simulation.profiler()};
+  auto entries{PythonMethodsBase1::StepProfileEntriesToPython(profiler)};
+  return Py_BuildValue(
+      "{sOsLsLss}", "entries", entries.get(), "sampled_updates",
+      static_cast<long long>(profiler.sampled_updates()),  // NOLINT
+      "total_updates",
+      static_cast<long long>(profiler.total_updates()),  // NOLINT
+      "report", profiler.GetReport(max_entries).c_str());
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyStepProfileSimulateDef = {
+    "step_profile_simulate",             // name
+    (PyCFunction)PyStepProfileSimulate,  // method
+    METH_VARARGS | METH_KEYWORDS,        // flags
+
+    "step_profile_simulate(ops: list[Any], interval: int = 1,\n"
+    "  max_entries: int = 30) -> dict[str, Any]\n"
+    "\n"
+    "Run a fresh step profiler through a sequence of ops on a synthetic\n"
+    "clock.\n"
+    "\n"
+    "Ops are 'update' (a session update begins), 'reset', 'stop', or a\n"
+    "(category, key, microseconds, children) sample; children is an\n"
+    "optional list of ops run within the sample before its own time\n"
+    "passes. String keys are native names; anything else is a Python\n"
+    "callable. Returns a dict with 'entries' (as from\n"
+    "step_profile_entries()), 'sampled_updates', 'total_updates' and\n"
+    "'report'.\n"
+    "\n"
+    ":meta private:",
+};
+
+// ------------------------ texture_stream_schedule ----------------------------
+
+static auto PyTextureStreamSchedule(PyObject* self, PyObject* args,
+                                    PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  int width;
+  int height;
+  PyObject* level_sizes_obj;
+  int64_t frame_budget;
+  static const char* kwlist[] = {"width", "height", "level_sizes",
+                                 "frame_budget", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "iiOL",
+                                   const_cast<char**>(kwlist), &width,
+                                   &height, &level_sizes_obj, &frame_budget)) {
+    return nullptr;
+  }
+  if (width <= 0 || height <= 0 || frame_budget <= 0) {
+    throw Exception("Dimensions and budget must be positive.",
+                    PyExcType::kValue);
+  }
+  std::vector<TextureStreamPlan::Level> levels;
+  for (auto&& size : Python::GetInts64(level_sizes_obj)) {
+    if (size < 0) {
+      throw Exception("Level sizes must not be negative.", PyExcType::kValue);
+    }
+    levels.push_back({width, height, static_cast<size_t>(size)});
+    width = std::max(1, width / 2);
+    height = std::max(1, height / 2);
+  }
+  TextureStreamPlan plan(std::move(levels));
+
+  // The first batch is what goes up at load time; each one after is a
+  // frame's worth of streaming.
+  auto batches{PythonRef::Stolen(PyList_New(0))};
+  auto batch{PythonRef::Stolen(PyList_New(0))};
+  for (int i = plan.level_count() - 1; i >= plan.initial_level(); --i) {
+    PyList_Append(batch.get(), PythonRef::Stolen(PyLong_FromLong(i)).get());
+  }
+  PyList_Append(batches.get(), batch.get());
+  while (plan.streaming()) {
+    batch.Steal(PyList_New(0));
+    auto budget{static_cast<size_t>(frame_budget)};
+    bool oversized_ok{true};
+    int level;
+    while ((level = plan.PopLevel(&budget, oversized_ok)) != -1) {
+      oversized_ok = false;
+      PyList_Append(batch.get(),
+                    PythonRef::Stolen(PyLong_FromLong(level)).get());
+    }
+    PyList_Append(batches.get(), batch.get());
+  }
+  return batches.HandOver();
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyTextureStreamScheduleDef = {
+    "texture_stream_schedule",             // name
+    (PyCFunction)PyTextureStreamSchedule,  // method
+    METH_VARARGS | METH_KEYWORDS,          // flags
+
+    "texture_stream_schedule(width: int, height: int,\n"
+    "  level_sizes: Sequence[int], frame_budget: int) -> list[list[int]]\n"
+    "\n"
+    "Return the order streamed texture mip levels would be uploaded in.\n"
+    "\n"
+    "Levels are given largest-first, starting at the provided dimensions\n"
+    "and halving for each subsequent one. The first list returned is what\n"
+    "uploads when the texture loads; each following list is one frame of\n"
+    "streaming under the provided byte budget.\n"
+    "\n"
+    ":meta private:",
+};
+
+// ------------------------- frame_pacing_simulate -----------------------------
+
+static auto PyFramePacingSimulate(PyObject* self, PyObject* args,
+                                  PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  double refresh_rate;
+  double build_ms;
+  double render_ms;
+  int frames{600};
+  int paced{1};
+  double jitter_ms{0.0};
+  static const char* kwlist[] = {"refresh_rate", "build_ms", "render_ms",
+                                 "frames",       "paced",    "jitter_ms",
+                                 nullptr};
+  if (!PyArg_ParseTupleAndKeywords(
+          args, keywds, "ddd|ipd", const_cast<char**>(kwlist), &refresh_rate,
+          &build_ms, &render_ms, &frames, &paced, &jitter_ms)) {
+    return nullptr;
+  }
+  if (refresh_rate <= 0.0 || build_ms < 0.0 || render_ms < 0.0
+      || jitter_ms < 0.0 || frames < 2) {
+    throw Exception("Invalid simulation parameters.", PyExcType::kValue);
+  }
+
+  // Run the pipeline the way the graphics server and logic thread do,
+  // but against a synthetic vsync clock and with simulated work, so no
+  // actual waiting (or display) is involved.
+  auto interval{static_cast<microsecs_t>(1000000.0 / refresh_rate)};
+  FramePacer pacer;
+  pacer.SetSyntheticVSync(interval, 0);
+  std::mt19937 rng(1234);
+  std::uniform_real_distribution<double> jitter(0.0, jitter_ms * 1000.0);
+  auto work{[&](double ms) {
+    return static_cast<microsecs_t>(ms * 1000.0 + jitter(rng));
+  }};
+
+  // Frame 0 is waiting for the graphics thread at time 0.
+  microsecs_t pick_time{};
+  microsecs_t build_start_time{-work(build_ms)};
+  int missed{};
+  double latency_total{};
+  microsecs_t latency_max{};
+  for (int i = 0; i < frames; ++i) {
+    // The graphics thread picks up a frame and requests the next.
+    auto next_build_start_time{paced ? pacer.BuildStartTime(pick_time)
+                                     : pick_time};
+    auto build_time{work(build_ms)};
+    pacer.OnFrameBuilt(build_time);
+    auto next_ready_time{next_build_start_time + build_time};
+
+    // It renders and presents the frame it picked up.
+    auto render_time{work(render_ms)};
+    pacer.OnFrameRendered(render_time);
+    auto present_time{pacer.NextVSyncTime(pick_time + render_time)};
+
+    // Latency here is from when the frame started building (and thus
+    // sampled input) to when it hit the screen.
+    if (i > 0) {
+      auto latency{present_time - build_start_time};
+      latency_total += static_cast<double>(latency);
+      latency_max = std::max(latency_max, latency);
+    }
+
+    // If the next frame isn't ready by the time this one has been
+    // presented, the display shows this one again.
+    if (next_ready_time > present_time) {
+      missed++;
+    }
+    pick_time = std::max(present_time, next_ready_time);
+    build_start_time = next_build_start_time;
+  }
+  return Py_BuildValue("{s:i,s:i,s:d,s:d}", "frames", frames, "missed", missed,
+                       "mean_latency_ms",
+                       latency_total / (frames - 1) / 1000.0, "max_latency_ms",
+                       static_cast<double>(latency_max) / 1000.0);
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyFramePacingSimulateDef = {
+    "frame_pacing_simulate",             // name
+    (PyCFunction)PyFramePacingSimulate,  // method
+    METH_VARARGS | METH_KEYWORDS,        // flags
+
+    "frame_pacing_simulate(refresh_rate: float, build_ms: float,\n"
+    "  render_ms: float, frames: int = 600, paced: bool = True,\n"
+    "  jitter_ms: float = 0.0) -> dict[str, Any]\n"
+    "\n"
+    "Simulate frame-def pacing against a synthetic vsync clock.\n"
+    "\n"
+    "Runs the frame pipeline with the provided build/render times (plus up\n"
+    "to jitter_ms of random extra time for each) without any actual\n"
+    "waiting, so it works in headless builds. Returns a dict with 'frames',\n"
+    "'missed' (frames not ready in time for their vsync),\n"
+    "'mean_latency_ms' and 'max_latency_ms' (from frame build start to\n"
+    "present) entries. Pass paced=False to see how things go when frames\n"
+    "are requested immediately.\n"
+    "\n"
+    ":meta private:",
+};
+
+// ------------------------ input_latency_simulate -----------------------------
+
+static auto PyInputLatencySimulate(PyObject* self, PyObject* args,
+                                   PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  PyObject* ops_obj;
+  static const char* kwlist[] = {"ops", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "O",
+                                   const_cast<char**>(kwlist), &ops_obj)) {
+    return nullptr;
+  }
+  if (!PyList_Check(ops_obj)) {
+    throw Exception("Expected a list of ops.", PyExcType::kType);
+  }
+
+  // Run a fresh tracker through the provided sequence of events against
+  // a synthetic clock.
+  InputLatency latency;
+  Py_ssize_t count{PyList_GET_SIZE(ops_obj)};
+  for (Py_ssize_t i = 0; i < count; ++i) {
+    const char* op;
+    int64_t time;
+    int64_t event_time;
+    if (!PyArg_ParseTuple(PyList_GET_ITEM(ops_obj, i), "sLL", &op, &time,
+                          &event_time)) {
+      return nullptr;
+    }
+    latency.SetSyntheticTime(time);
+    if (!strcmp(op, "dispatch")) {
+      latency.OnEventDispatched(event_time);
+    } else if (!strcmp(op, "consume")) {
+      latency.OnEventConsumed(event_time);
+    } else if (!strcmp(op, "sim")) {
+      latency.OnSimStep();
+    } else if (!strcmp(op, "frame")) {
+      latency.TakeFrameEventTime();
+    } else if (!strcmp(op, "present")) {
+      latency.OnFramePresented(event_time);
+    } else if (!strcmp(op, "send")) {
+      latency.OnEventSent(event_time);
+    } else {
+      throw Exception("Invalid op: '" + std::string(op) + "'.",
+                      PyExcType::kValue);
+    }
+  }
+  return PythonMoethodsBase3::InputLatencyStatsToPython(latency).HandOver();
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyInputLatencySimulateDef = {
+    "input_latency_simulate",             // name
+    (PyCFunction)PyInputLatencySimulate,  // method
+    METH_VARARGS | METH_KEYWORDS,         // flags
+
+    "input_latency_simulate(ops: list[tuple[str, int, int]])\n"
+    "  -> dict[str, dict[str, float]]\n"
+    "\n"
+    "Run an input latency tracker through a sequence of events.\n"
+    "\n"
+    "Each op is a (name, time, event_time) tuple with times in\n"
+    "microseconds. Names are 'dispatch', 'consume' (applied to a local\n"
+    "player), 'sim', 'frame', 'present' and 'send'; event_time is ignored\n"
+    "for 'sim' and 'frame'. Returns stats in the same form as\n"
+    "input_latency_stats().\n"
+    "\n"
+    ":meta private:",
+};
+
+// -------------------- remote_app_state_sequence_simulate ---------------------
+
+static auto PyRemoteAppStateSequenceSimulate(PyObject* self, PyObject* args,
+                                             PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  PyObject* packets_obj;
+  static const char* kwlist[] = {"packets", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "O",
+                                   const_cast<char**>(kwlist), &packets_obj)) {
+    return nullptr;
+  }
+  if (!PyList_Check(packets_obj)) {
+    throw Exception("Expected a list of packets.", PyExcType::kType);
+  }
+  RemoteAppStateSequencer sequencer;
+  Py_ssize_t count{PyList_GET_SIZE(packets_obj)};
+  auto results{PythonRef::Stolen(PyList_New(count))};
+  for (Py_ssize_t i = 0; i < count; ++i) {
+    int64_t time;
+    uint32_t seq;
+    if (!PyArg_ParseTuple(PyList_GET_ITEM(packets_obj, i), "LI", &time,
+                          &seq)) {
+      return nullptr;
+    }
+    bool send_ack{};
+    bool applied{sequencer.OnState(seq, time, &send_ack)};
+    PyList_SET_ITEM(results.get(), i,
+                    Py_BuildValue("(OOI)", applied ? Py_True : Py_False,
+                                  send_ack ? Py_True : Py_False,
+                                  sequencer.seq()));
+  }
+  return results.HandOver();
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyRemoteAppStateSequenceSimulateDef = {
+    "remote_app_state_sequence_simulate",           // name
+    (PyCFunction)PyRemoteAppStateSequenceSimulate,  // method
+    METH_VARARGS | METH_KEYWORDS,                   // flags
+
+    "remote_app_state_sequence_simulate(packets: list[tuple[int, int]])\n"
+    "  -> list[tuple[bool, bool, int]]\n"
+    "\n"
+    "Run remote app v3 state packets through a fresh sequencer.\n"
+    "\n"
+    "Each packet is a (time-millisecs, sequence-number) tuple. Returns an\n"
+    "(applied, acked, ack-sequence-number) tuple for each.\n"
+    "\n"
+    ":meta private:",
+};
+
+// ------------------------- udp_admission_simulate ----------------------------
+
+static auto PyUDPAdmissionSimulate(PyObject* self, PyObject* args,
+                                   PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  PyObject* packets_obj;
+  const char* client_addr{};
+  const char* host_addr{};
+  static const char* kwlist[] = {"packets", "client_addr", "host_addr",
+                                 nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "O|zz",
+                                   const_cast<char**>(kwlist), &packets_obj,
+                                   &client_addr, &host_addr)) {
+    return nullptr;
+  }
+  if (!PyList_Check(packets_obj)) {
+    throw Exception("Expected a list of packets.", PyExcType::kType);
+  }
+
+  // Peers are given as 'ip:port' strings.
+  auto parse_addr{[](const char* addr) {
+    std::string str{addr};
+    auto colon{str.rfind(':')};
+    if (colon == std::string::npos) {
+      throw Exception("Expected 'ip:port'; got '" + str + "'.",
+                      PyExcType::kValue);
+    }
+    return SockAddr(str.substr(0, colon), std::stoi(str.substr(colon + 1)));
+  }};
+
+  auto admission{std::make_unique<UDPAdmission>()};
+  if (client_addr) {
+    admission->SetClientAddr(0, parse_addr(client_addr));
+  }
+  if (host_addr) {
+    admission->SetHostAddr(parse_addr(host_addr));
+  }
+  Py_ssize_t count{PyList_GET_SIZE(packets_obj)};
+  auto results{PythonRef::Stolen(PyList_New(count))};
+  for (Py_ssize_t i = 0; i < count; ++i) {
+    double time;
+    const char* kind;
+    const char* addr;
+    if (!PyArg_ParseTuple(PyList_GET_ITEM(packets_obj, i), "dss", &time,
+                          &kind, &addr)) {
+      return nullptr;
+    }
+    admission->SetSyntheticTime(static_cast<microsecs_t>(time * 1000000.0));
+    auto sockaddr{parse_addr(addr)};
+    sockaddr_storage from{};
+    memcpy(&from, sockaddr.AsSockAddr(), sockaddr.GetSockAddrLen());
+
+    // Request bodies: protocol version, request id, and session id.
+    uint8_t data[32]{};
+    size_t size{};
+    bool query{};
+    if (!strcmp(kind, "request")) {
+      uint8_t request[] = {BA_PACKET_CLIENT_REQUEST, 1, 2, 3, 4};
+      size = sizeof(request);
+      memcpy(data, request, size);
+    } else if (!strcmp(kind, "cookie_request")
+               || !strcmp(kind, "bad_cookie_request")) {
+      auto cookie{admission->CurrentCookie(from)};
+      if (!strcmp(kind, "bad_cookie_request")) {
+        cookie++;
+      }
+      data[0] = BA_PACKET_CLIENT_REQUEST_COOKIE;
+      memcpy(data + 1, &cookie, sizeof(cookie));
+      uint8_t request[] = {1, 2, 3, 4};
+      memcpy(data + 9, request, sizeof(request));
+      size = 9 + sizeof(request);
+    } else if (!strcmp(kind, "client_packet")) {
+      uint8_t packet[] = {BA_PACKET_CLIENT_GAMEPACKET_COMPRESSED, 0, 1};
+      size = sizeof(packet);
+      memcpy(data, packet, size);
+    } else if (!strcmp(kind, "host_packet")) {
+      uint8_t packet[] = {BA_PACKET_HOST_GAMEPACKET_COMPRESSED, 1};
+      size = sizeof(packet);
+      memcpy(data, packet, size);
+    } else if (!strcmp(kind, "query")) {
+      query = true;
+    } else {
+      throw Exception("Invalid packet kind: '" + std::string(kind) + "'.",
+                      PyExcType::kValue);
+    }
+
+    // Figure out what happened from which counter moved.
+    int64_t drops_before[static_cast<int>(UDPDropReason::kLast)];
+    for (int r = 0; r < static_cast<int>(UDPDropReason::kLast); ++r) {
+      drops_before[r] = admission->drop_count(static_cast<UDPDropReason>(r));
+    }
+    auto cookies_before{admission->cookies_sent_count()};
+    bool admitted{query ? admission->AdmitQueryPacket(from)
+                        : admission->AdmitConnectionPacket(
+                            -1, data, &size, from,
+                            sockaddr.GetSockAddrLen())};
+    std::string result{admitted ? "admitted" : "ignored"};
+    if (admission->cookies_sent_count() != cookies_before) {
+      result = "cookie";
+    }
+    for (int r = 0; r < static_cast<int>(UDPDropReason::kLast); ++r) {
+      auto reason{static_cast<UDPDropReason>(r)};
+      if (admission->drop_count(reason) != drops_before[r]) {
+        result = UDPAdmission::DropReasonName(reason);
+      }
+    }
+    PyList_SET_ITEM(results.get(), i, PyUnicode_FromString(result.c_str()));
+  }
+  return results.HandOver();
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyUDPAdmissionSimulateDef = {
+    "udp_admission_simulate",             // name
+    (PyCFunction)PyUDPAdmissionSimulate,  // method
+    METH_VARARGS | METH_KEYWORDS,         // flags
+
+    "udp_admission_simulate(packets: list[tuple[float, str, str]],\n"
+    "  client_addr: str | None = None, host_addr: str | None = None)\n"
+    "  -> list[str]\n"
+    "\n"
+    "Run packets through a fresh udp admission filter.\n"
+    "\n"
+    "Each packet is a (time-seconds, kind, 'ip:port') tuple, where kind is\n"
+    "'request', 'cookie_request' (echoing a valid cookie),\n"
+    "'bad_cookie_request', 'client_packet' (for client 0), 'host_packet',\n"
+    "or 'query'. If given, client_addr is registered as client 0 and\n"
+    "host_addr as our host. Returns 'admitted', 'cookie' (a cookie was sent\n"
+    "instead), 'ignored', or a drop reason for each. Nothing is actually\n"
+    "sent anywhere.\n"
+    "\n"
+    ":meta private:",
+};
+
+// ------------------------ bg_dynamics_budget_simulate ------------------------
+
+static auto PyBGDynamicsBudgetSimulate(PyObject* self, PyObject* args,
+                                       PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  PyObject* steps_obj;
+  PyObject* emissions_obj;
+  static const char* kwlist[] = {"steps", "emissions", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "OO",
+                                   const_cast<char**>(kwlist), &steps_obj,
+                                   &emissions_obj)) {
+    return nullptr;
+  }
+  if (!PyList_Check(steps_obj) || !PyList_Check(emissions_obj)) {
+    throw Exception("Expected lists of steps and emissions.",
+                    PyExcType::kType);
+  }
+  BGDynamicsBudget budget;
+  for (Py_ssize_t i = 0; i < PyList_GET_SIZE(steps_obj); ++i) {
+    double duration, interval;
+    int frames_over_budget;
+    if (!PyArg_ParseTuple(PyList_GET_ITEM(steps_obj, i), "ddp", &duration,
+                          &interval, &frames_over_budget)) {
+      return nullptr;
+    }
+    budget.OnStep(static_cast<microsecs_t>(duration * 1000000.0),
+                  static_cast<microsecs_t>(interval * 1000000.0),
+                  frames_over_budget);
+  }
+  auto counts{PythonRef::Stolen(PyList_New(PyList_GET_SIZE(emissions_obj)))};
+  for (Py_ssize_t i = 0; i < PyList_GET_SIZE(emissions_obj); ++i) {
+    int count;
+    float x, y, z, size, cam_x, cam_y, cam_z;
+    if (!PyArg_ParseTuple(PyList_GET_ITEM(emissions_obj, i), "i(fff)f(fff)",
+                          &count, &x, &y, &z, &size, &cam_x, &cam_y,
+                          &cam_z)) {
+      return nullptr;
+    }
+    auto scaled{
+        budget.ScaleCount(count, {x, y, z}, size, {cam_x, cam_y, cam_z})};
+    PyList_SET_ITEM(counts.get(), i, PyLong_FromLong(scaled));
+  }
+  return Py_BuildValue("(dO)", static_cast<double>(budget.load_scale()),
+                       counts.get());
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyBGDynamicsBudgetSimulateDef = {
+    "bg_dynamics_budget_simulate",            // name
+    (PyCFunction)PyBGDynamicsBudgetSimulate,  // method
+    METH_VARARGS | METH_KEYWORDS,             // flags
+
+    "bg_dynamics_budget_simulate(steps: list[tuple[float, float, bool]],\n"
+    "  emissions: list[tuple[int, tuple[float, float, float], float,\n"
+    "  tuple[float, float, float]]]) -> tuple[float, list[int]]\n"
+    "\n"
+    "Run a fresh bg-dynamics budget through some steps and emissions.\n"
+    "\n"
+    "Steps are (duration-seconds, interval-seconds, frames-over-budget)\n"
+    "and are all run first. Emissions are (count, position, size,\n"
+    "camera-position). Returns the resulting load scale and the scaled\n"
+    "count for each emission. Works in headless builds too.\n"
+    "\n"
+    ":meta private:",
+};
+
+// ------------------------- validating_renderer_frame -------------------------
+
+namespace {
+
+// Shading types whose binds carry no textures, which is all a buffer
+// built without assets can hold.
+const std::pair<const char*, ShadingType> kTestFrameShadingTypes[] = {
+    {"simple_color", ShadingType::kSimpleColor},
+    {"simple_color_transparent", ShadingType::kSimpleColorTransparent},
+    {"shield", ShadingType::kShield},
+    {"post_process", ShadingType::kPostProcess},
+    {"post_process_normal_distort", ShadingType::kPostProcessNormalDistort},
+};
+
+const std::pair<const char*, RenderCommandBuffer::Command>
+    kTestFrameCommands[] = {
+        {"shader", RenderCommandBuffer::Command::kShader},
+        {"draw_screen_quad", RenderCommandBuffer::Command::kDrawScreenQuad},
+        {"push_transform", RenderCommandBuffer::Command::kPushTransform},
+        {"pop_transform", RenderCommandBuffer::Command::kPopTransform},
+        {"translate2", RenderCommandBuffer::Command::kTranslate2},
+        {"scale_uniform", RenderCommandBuffer::Command::kScaleUniform},
+        {"rotate", RenderCommandBuffer::Command::kRotate},
+        {"flip_cull_face", RenderCommandBuffer::Command::kFlipCullFace},
+        {"scissor_pop", RenderCommandBuffer::Command::kScissorPop},
+        {"simple_inline_color",
+         RenderCommandBuffer::Command::kSimpleComponentInlineColor},
+        {"object_inline_color",
+         RenderCommandBuffer::Command::kObjectComponentInlineColor},
+};
+
+}  // namespace
+
+static auto PyValidatingRendererFrame(PyObject* self, PyObject* args,
+                                      PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  PyObject* commands_obj;
+  int width, height;
+  const char* capture_path{""};
+  static const char* kwlist[] = {"commands", "size", "capture_path", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "O(ii)|s",
+                                   const_cast<char**>(kwlist), &commands_obj,
+                                   &width, &height, &capture_path)) {
+    return nullptr;
+  }
+  if (!PyList_Check(commands_obj)) {
+    throw Exception("Expected a list of commands.", PyExcType::kType);
+  }
+  if (width <= 0 || height <= 0 || width > 1024 || height > 1024) {
+    throw Exception("Invalid frame size.", PyExcType::kValue);
+  }
+
+  // Frame-defs belong to the logic thread; the renderer only reads from
+  // this one's passes.
+  FrameDef frame_def;
+  RenderCommandBuffer buffer;
+  buffer.set_frame_def(&frame_def);
+  for (Py_ssize_t i = 0; i < PyList_GET_SIZE(commands_obj); ++i) {
+    const char* name;
+    PyObject* ints_obj;
+    PyObject* floats_obj;
+    if (!PyArg_ParseTuple(PyList_GET_ITEM(commands_obj, i), "sOO", &name,
+                          &ints_obj, &floats_obj)) {
+      return nullptr;
+    }
+    auto ints{Python::GetInts(ints_obj)};
+    auto floats{Python::GetFloats(floats_obj)};
+    std::optional<RenderCommandBuffer::Command> command;
+    for (auto&& [command_name, value] : kTestFrameCommands) {
+      if (!strcmp(name, command_name)) {
+        command = value;
+      }
+    }
+    for (auto&& [type_name, type] : kTestFrameShadingTypes) {
+      if (!strcmp(name, type_name)) {
+        command = RenderCommandBuffer::Command::kShader;
+        ints.insert(ints.begin(), static_cast<int>(type));
+      }
+    }
+    if (!command) {
+      throw Exception("Unknown command '" + std::string(name) + "'.",
+                      PyExcType::kValue);
+    }
+    buffer.PutCommand(*command);
+    for (auto val : ints) {
+      buffer.PutInt(val);
+    }
+    for (auto val : floats) {
+      buffer.PutFloat(val);
+    }
+  }
+  buffer.Finalize();
+
+  // Renderers live in the graphics context, so we run the frame there and
+  // wait for it. Builds that already have a renderer of their own decline.
+  std::mutex mutex;
+  std::condition_variable cv;
+  bool done{};
+  bool ran{};
+  std::string exception;
+  RendererValidating::Stats stats;
+  std::string error;
+  std::string capture{capture_path};
+  g_base->app_adapter->PushGraphicsContextCall([&] {
+    try {
+      if (!g_base->graphics_server->renderer()) {
+        RendererValidating renderer;
+        renderer.ProcessTestFrame(&buffer, *frame_def.overlay_pass(), width,
+                                  height, capture, &stats, &error);
+        ran = true;
+      }
+    } catch (const std::exception& e) {
+      exception = e.what();
+    }
+    {
+      std::scoped_lock lock(mutex);
+      done = true;
+    }
+    cv.notify_one();
+  });
+  {
+    std::unique_lock lock(mutex);
+    cv.wait(lock, [&done] { return done; });
+  }
+  if (!exception.empty()) {
+    throw Exception(exception);
+  }
+  if (!ran) {
+    Py_RETURN_NONE;
+  }
+  auto stats_dict{PythonMoethodsBase3::RendererStatsToPython(stats)};
+  return Py_BuildValue("{s:O,s:s}", "stats", stats_dict.get(), "error",
+                       error.c_str());
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyValidatingRendererFrameDef = {
+    "validating_renderer_frame",             // name
+    (PyCFunction)PyValidatingRendererFrame,  // method
+    METH_VARARGS | METH_KEYWORDS,            // flags
+
+    "validating_renderer_frame(commands: list[tuple[str, list[int],\n"
+    "  list[float]]], size: tuple[int, int], capture_path: str = '')\n"
+    "  -> dict[str, Any] | None\n"
+    "\n"
+    "Run a built command buffer through a fresh validating renderer.\n"
+    "\n"
+    "Each command is a (name, ints, floats) tuple; the values are written\n"
+    "to the buffer after the command as-is. Names are render-command-buffer\n"
+    "commands ('draw_screen_quad', 'push_transform', 'translate2', etc.)\n"
+    "or texture-free shading types ('simple_color',\n"
+    "'simple_color_transparent', 'shield', 'post_process',\n"
+    "'post_process_normal_distort'), which write a shader bind for that\n"
+    "type. The frame is drawn to an offscreen target of the given size and\n"
+    "written as a binary PPM to capture_path if given. Returns the frame's\n"
+    "'stats' (as in renderer_stats()) and last 'error', or None if the\n"
+    "app already has a renderer.\n"
+    "\n"
+    ":meta private:",
+};
+
+}  // namespace ballistica::base
+
+namespace ballistica::scene_v1 {
+
+namespace {
+
+// Static terrain made of boxes in a standalone Dynamics, for testing
+// terrain queries without a scene or nodes.
+class TestTerrain {
+ public:
+  explicit TestTerrain(Dynamics* dynamics) : dynamics_{dynamics} {}
+
+  ~TestTerrain() {
+    for (auto&& geom : geoms_) {
+      dynamics_->RemoveTrimesh(geom.first);
+      dGeomDestroy(geom.first);
+      dGeomTriMeshDataDestroy(geom.second);
+    }
+  }
+
+  // Add an axis-aligned box of terrain. A box with zero height is just an
+  // upward-facing floor.
+  auto AddBox(const Vector3f& center, const Vector3f& size) -> dGeomID {
+    std::vector<dReal>& vertices{vertices_.emplace_back()};
+    std::vector<uint32_t>& indices{indices_.emplace_back()};
+    for (int axis = 0; axis < 3; ++axis) {
+      for (float sign : {1.0f, -1.0f}) {
+        if (size.y == 0.0f && (axis != 1 || sign < 0.0f)) {
+          continue;
+        }
+        // Corners run counterclockwise about +axis in the (u, v) plane.
+        int u{(axis + 1) % 3};
+        int v{(axis + 2) % 3};
+        auto first{static_cast<uint32_t>(vertices.size() / 3)};
+        for (auto [su, sv] : {std::pair{-1.0f, -1.0f}, std::pair{1.0f, -1.0f},
+                              std::pair{1.0f, 1.0f}, std::pair{-1.0f, 1.0f}}) {
+          Vector3f corner{center};
+          corner.v[axis] += sign * size.v[axis] * 0.5f;
+          corner.v[u] += su * size.v[u] * 0.5f;
+          corner.v[v] += sv * size.v[v] * 0.5f;
+          vertices.insert(vertices.end(), {corner.x, corner.y, corner.z});
+        }
+        if (sign > 0.0f) {
+          indices.insert(indices.end(), {first, first + 1, first + 2, first,
+                                         first + 2, first + 3});
+        } else {
+          indices.insert(indices.end(), {first, first + 2, first + 1, first,
+                                         first + 3, first + 2});
+        }
+      }
+    }
+    dTriMeshDataID data = dGeomTriMeshDataCreate();
+    dGeomTriMeshDataBuildSingle(
+        data, vertices.data(), 3 * sizeof(dReal),
+        static_cast<int>(vertices.size() / 3), indices.data(),
+        static_cast<int>(indices.size()), 3 * sizeof(uint32_t));
+    dGeomID geom = dCreateTriMesh(nullptr, data, nullptr, nullptr, nullptr);
+    geoms_.emplace_back(geom, data);
+    dynamics_->AddTrimesh(geom);
+    return geom;
+  }
+
+ private:
+  Dynamics* dynamics_{};
+  // Trimesh data points into these, so they must outlive the geoms.
+  std::list<std::vector<dReal>> vertices_;
+  std::list<std::vector<uint32_t>> indices_;
+  std::vector<std::pair<dGeomID, dTriMeshDataID>> geoms_;
+};
+
+}  // namespace
+
+
+// ---------------------- client_throttled_handling ----------------------------
+
+static auto PyClientThrottledHandling(PyObject* self, PyObject* args)
+    -> PyObject* {
+  BA_PYTHON_TRY;
+  const char* data;
+  Py_ssize_t data_size;
+  if (!PyArg_ParseTuple(args, "y#", &data, &data_size)) {
+    return nullptr;
+  }
+  std::vector<uint8_t> packet(data, data + data_size);
+  switch (ConnectionToClient::GetThrottledHandling(packet)) {
+    case ConnectionToClient::ThrottledHandling::kFull:
+      return PyUnicode_FromString("full");
+    case ConnectionToClient::ThrottledHandling::kAcksOnly:
+      return PyUnicode_FromString("acks_only");
+    default:
+      return PyUnicode_FromString("ignore");
+  }
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyClientThrottledHandlingDef = {
+    "client_throttled_handling",  // name
+    PyClientThrottledHandling,    // method
+    METH_VARARGS,                 // flags
+
+    "client_throttled_handling(data: bytes) -> str\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Return how much of a game packet we handle from a throttled client:\n"
+    "'full', 'acks_only', or 'ignore'.\n"
+    "\n"
+    ":meta private:",
+};
+
+// ----------------------- client_message_hold_simulate ------------------------
+
+static auto PyClientMessageHoldSimulate(PyObject* self, PyObject* args)
+    -> PyObject* {
+  BA_PYTHON_TRY;
+  PyObject* events_obj;
+  if (!PyArg_ParseTuple(args, "O", &events_obj)) {
+    return nullptr;
+  }
+  PythonRef events_seq{PySequence_Fast(events_obj, "Expected a sequence."),
+                       PythonRef::kSteal};
+  if (!events_seq.exists()) {
+    return nullptr;
+  }
+
+  // Feed messages through a hold the way ConnectionToClient does; binary
+  // client-info starts holding and its decode finishing releases.
+  ConnectionToClient::MessageHold hold;
+  int build_number{};
+  PythonRef handled{PythonRef::Stolen(PyList_New(0))};
+  auto handle = [&handled, &build_number](const std::vector<uint8_t>& msg) {
+    PythonRef item{
+        PythonRef::Stolen(Py_BuildValue("(ii)", msg[0], build_number))};
+    PyList_Append(handled.get(), item.get());
+  };
+  for (Py_ssize_t i = 0; i < PySequence_Fast_GET_SIZE(events_seq.get()); ++i) {
+    PyObject* event = PySequence_Fast_GET_ITEM(events_seq.get(), i);
+    if (PyBytes_Check(event)) {
+      std::vector<uint8_t> msg(
+          PyBytes_AS_STRING(event),
+          PyBytes_AS_STRING(event) + PyBytes_GET_SIZE(event));
+      if (msg.empty()) {
+        throw Exception("Messages can't be empty.", PyExcType::kValue);
+      }
+      if (hold.Hold(msg)) {
+        continue;
+      }
+      handle(msg);
+      if (msg[0] == BA_MESSAGE_CLIENT_INFO_BINARY) {
+        hold.Start();
+      }
+    } else {
+      if (!hold.holding()) {
+        throw Exception("Nothing is being decoded.", PyExcType::kValue);
+      }
+      build_number = Python::GetInt(event);
+      for (auto&& msg : hold.Release()) {
+        handle(msg);
+      }
+    }
+  }
+  return Py_BuildValue("{sOsOsO}", "handled", handled.get(), "holding",
+                       hold.holding() ? Py_True : Py_False, "overflowed",
+                       hold.overflowed() ? Py_True : Py_False);
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyClientMessageHoldSimulateDef = {
+    "client_message_hold_simulate",  // name
+    PyClientMessageHoldSimulate,     // method
+    METH_VARARGS,                    // flags
+
+    "client_message_hold_simulate(events: Sequence[bytes | int]) -> dict\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Run messages from a client (bytes) and finished client-info decodes\n"
+    "(the decoded build-number) through a client-connection's message\n"
+    "hold. Returns the (message-type, build-number) each message got\n"
+    "handled with, in order, and whether the hold is still holding or\n"
+    "has overflowed.\n"
+    "\n"
+    ":meta private:",
+};
+
+// ------------------------ screen_message_payloads ----------------------------
+
+static auto PyScreenMessagePayloads(PyObject* self, PyObject* args)
+    -> PyObject* {
+  BA_PYTHON_TRY;
+  PyObject* messages_obj;
+  int build_number;
+  int batch_format{};
+  if (!PyArg_ParseTuple(args, "Oi|i", &messages_obj, &build_number,
+                        &batch_format)) {
+    return nullptr;
+  }
+  std::vector<ConnectionSet::PendingScreenMessage> messages;
+  std::vector<size_t> indices;
+  for (auto&& message : Python::GetStrings(messages_obj)) {
+    indices.push_back(messages.size());
+    messages.push_back({message, 1.0f, 1.0f, 1.0f, true, {}});
+  }
+  auto payloads{ConnectionSet::ScreenMessagePayloads(
+      messages, indices, build_number, batch_format)};
+  PyObject* py_list = PyList_New(0);
+  for (auto&& payload : payloads) {
+    PythonRef item{PythonRef::Stolen(PyBytes_FromStringAndSize(
+        reinterpret_cast<const char*>(payload->data()),
+        static_cast<Py_ssize_t>(payload->size())))};
+    PyList_Append(py_list, item.get());
+  }
+  return py_list;
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyScreenMessagePayloadsDef = {
+    "screen_message_payloads",  // name
+    PyScreenMessagePayloads,    // method
+    METH_VARARGS,               // flags
+
+    "screen_message_payloads(messages: list[str], build_number: int,\n"
+    "  batch_format: int = 0) -> list[bytes]\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Return the reliable-message payloads a client of the given build\n"
+    "and advertised batch format would be sent for a set of screen\n"
+    "messages.\n"
+    "\n"
+    ":meta private:",
+};
+
+// ---------------------- client_handshake_info_encode -------------------------
+
+static auto PyClientHandshakeInfoEncode(PyObject* self, PyObject* args)
+    -> PyObject* {
+  BA_PYTHON_TRY;
+  int build_number;
+  const char* token;
+  const char* peer_hash;
+  PyObject* profiles;
+  if (!PyArg_ParseTuple(args, "issO", &build_number, &token, &peer_hash,
+                        &profiles)) {
+    return nullptr;
+  }
+  ClientHandshakeInfo info;
+  info.build_number = build_number;
+  info.token = token;
+  info.peer_hash = peer_hash;
+  info.SetPlayerProfilesFromPython(profiles);
+  auto data{info.Encode()};
+  return PyBytes_FromStringAndSize(reinterpret_cast<const char*>(data.data()),
+                                   static_cast<Py_ssize_t>(data.size()));
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyClientHandshakeInfoEncodeDef = {
+    "client_handshake_info_encode",  // name
+    PyClientHandshakeInfoEncode,     // method
+    METH_VARARGS,                    // flags
+
+    "client_handshake_info_encode(build_number: int, token: str,\n"
+    "  peer_hash: str, profiles: dict) -> bytes\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Build a binary client-info message as a client would send it.\n"
+    "\n"
+    ":meta private:",
+};
+
+// ---------------------- client_handshake_info_decode -------------------------
+
+static auto PyClientHandshakeInfoDecode(PyObject* self, PyObject* args)
+    -> PyObject* {
+  BA_PYTHON_TRY;
+  const char* data;
+  Py_ssize_t data_size;
+  if (!PyArg_ParseTuple(args, "y#", &data, &data_size)) {
+    return nullptr;
+  }
+  ClientHandshakeInfo info;
+  std::string error;
+  if (!info.Decode(std::vector<uint8_t>(data, data + data_size), &error)) {
+    throw Exception("Invalid client-info: " + error + ".", PyExcType::kValue);
+  }
+  auto profiles{info.GetPlayerProfilesAsPython()};
+  return Py_BuildValue("(issO)", info.build_number, info.token.c_str(),
+                       info.peer_hash.c_str(), profiles.get());
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyClientHandshakeInfoDecodeDef = {
+    "client_handshake_info_decode",  // name
+    PyClientHandshakeInfoDecode,     // method
+    METH_VARARGS,                    // flags
+
+    "client_handshake_info_decode(data: bytes)\n"
+    "  -> tuple[int, str, str, dict]\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Decode a binary client-info message as a host would. Returns build\n"
+    "number, token, peer hash, and player profiles. Raises ValueError\n"
+    "for anything a host would reject.\n"
+    "\n"
+    ":meta private:",
+};
+
+// ------------------------- session_snapshot_compress -------------------------
+
+static auto PySessionSnapshotCompress(PyObject* self, PyObject* args)
+    -> PyObject* {
+  BA_PYTHON_TRY;
+  const char* data;
+  Py_ssize_t data_size;
+  if (!PyArg_ParseTuple(args, "y#", &data, &data_size)) {
+    return nullptr;
+  }
+  std::vector<uint8_t> commands(data, data + data_size);
+  auto snapshot{SessionSnapshot::Compress(commands)};
+  return PyBytes_FromStringAndSize(
+      reinterpret_cast<const char*>(snapshot.data()),
+      static_cast<Py_ssize_t>(snapshot.size()));
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PySessionSnapshotCompressDef = {
+    "session_snapshot_compress",  // name
+    PySessionSnapshotCompress,    // method
+    METH_VARARGS,                 // flags
+
+    "session_snapshot_compress(commands: bytes) -> bytes\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Pack a session-commands message into a session-snapshot message.\n"
+    "\n"
+    ":meta private:",
+};
+
+// ------------------------ session_snapshot_decompress ------------------------
+
+static auto PySessionSnapshotDecompress(PyObject* self, PyObject* args)
+    -> PyObject* {
+  BA_PYTHON_TRY;
+  const char* data;
+  Py_ssize_t data_size;
+  if (!PyArg_ParseTuple(args, "y#", &data, &data_size)) {
+    return nullptr;
+  }
+  std::vector<uint8_t> snapshot(data, data + data_size);
+  std::vector<uint8_t> commands;
+  if (!SessionSnapshot::Decompress(snapshot, &commands)) {
+    Py_RETURN_NONE;
+  }
+  return PyBytes_FromStringAndSize(
+      reinterpret_cast<const char*>(commands.data()),
+      static_cast<Py_ssize_t>(commands.size()));
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PySessionSnapshotDecompressDef = {
+    "session_snapshot_decompress",  // name
+    PySessionSnapshotDecompress,    // method
+    METH_VARARGS,                   // flags
+
+    "session_snapshot_decompress(snapshot: bytes) -> bytes | None\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Expand a session-snapshot message back into session commands.\n"
+    "\n"
+    "Returns None if the snapshot is malformed.\n"
+    "\n"
+    ":meta private:",
+};
+
+// ------------------------- spatial_query_simulate ----------------------------
+
+static auto PySpatialQuerySimulate(PyObject* self, PyObject* args)
+    -> PyObject* {
+  BA_PYTHON_TRY;
+  PyObject* geoms_obj;
+  PyObject* query_obj;
+  if (!PyArg_ParseTuple(args, "OO", &geoms_obj, &query_obj)) {
+    return nullptr;
+  }
+
+  // Parse everything up front so nothing below can bail out half built.
+  struct GeomDef {
+    int body;
+    std::string shape;
+    Vector3f position;
+    Vector3f size;
+  };
+  std::vector<GeomDef> geom_defs;
+  PythonRef geoms_seq{PySequence_Fast(geoms_obj, "Expected a sequence."),
+                      PythonRef::kSteal};
+  int max_body{};
+  for (Py_ssize_t i = 0; i < PySequence_Fast_GET_SIZE(geoms_seq.get()); ++i) {
+    PyObject* item = PySequence_Fast_GET_ITEM(geoms_seq.get(), i);
+    int body;
+    const char* shape;
+    PyObject* position_obj;
+    PyObject* size_obj;
+    if (!PyArg_ParseTuple(item, "isOO", &body, &shape, &position_obj,
+                          &size_obj)) {
+      return nullptr;
+    }
+    if (body < 0) {
+      throw Exception("Body ids must be >= 0.", PyExcType::kValue);
+    }
+    GeomDef def{body, shape, base::BasePython::GetPyVector3f(position_obj),
+                base::BasePython::GetPyVector3f(size_obj)};
+    if (def.shape != "sphere" && def.shape != "box"
+        && def.shape != "terrain") {
+      throw Exception("Invalid shape: '" + def.shape + "'.",
+                      PyExcType::kValue);
+    }
+    max_body = std::max(max_body, body);
+    geom_defs.push_back(def);
+  }
+  if (!PyTuple_Check(query_obj) || PyTuple_GET_SIZE(query_obj) < 1) {
+    throw Exception("Expected a query tuple.", PyExcType::kType);
+  }
+  std::string kind{Python::GetString(PyTuple_GET_ITEM(query_obj, 0))};
+  const char* kind_str;
+  PyObject* origin_obj;
+  PyObject* extent_obj{};
+  float scalar{};
+  if (kind == "sphere") {
+    if (!PyArg_ParseTuple(query_obj, "sOf", &kind_str, &origin_obj,
+                          &scalar)) {
+      return nullptr;
+    }
+  } else if (kind == "box") {
+    if (!PyArg_ParseTuple(query_obj, "sOO", &kind_str, &origin_obj,
+                          &extent_obj)) {
+      return nullptr;
+    }
+  } else if (kind == "ray") {
+    if (!PyArg_ParseTuple(query_obj, "sOOf", &kind_str, &origin_obj,
+                          &extent_obj, &scalar)) {
+      return nullptr;
+    }
+  } else {
+    throw Exception("Invalid query: '" + kind + "'.", PyExcType::kValue);
+  }
+  Vector3f origin{base::BasePython::GetPyVector3f(origin_obj)};
+  Vector3f extent{extent_obj ? base::BasePython::GetPyVector3f(extent_obj)
+                             : Vector3f{0.0f, 0.0f, 0.0f}};
+
+  // A standalone dynamics with raw geoms standing in for rigid bodies.
+  // Queries only use body pointers for identity, so we hand out addresses
+  // within a buffer and map them back to ids afterwards.
+  Dynamics dynamics{nullptr};
+  std::vector<char> bodies(static_cast<size_t>(max_body) + 1);
+  TestTerrain terrain{&dynamics};
+  for (auto&& def : geom_defs) {
+    dGeomID geom;
+    if (def.shape == "sphere") {
+      geom = dCreateSphere(dynamics.ode_space(), def.size.x);
+      dGeomSetPosition(geom, def.position.x, def.position.y, def.position.z);
+    } else if (def.shape == "box") {
+      geom = dCreateBox(dynamics.ode_space(), def.size.x, def.size.y,
+                        def.size.z);
+      dGeomSetPosition(geom, def.position.x, def.position.y, def.position.z);
+    } else {
+      geom = terrain.AddBox(def.position, def.size);
+    }
+    dGeomSetData(geom, &bodies[def.body]);
+  }
+
+  std::vector<Dynamics::QueryHit> hits;
+  if (kind == "sphere") {
+    dynamics.QuerySphere(origin, scalar, &hits);
+  } else if (kind == "box") {
+    dynamics.QueryBox(origin, extent, &hits);
+  } else {
+    dynamics.QueryRay(origin, extent.Normalized(), scalar, &hits);
+  }
+
+  PyObject* py_list = PyList_New(0);
+  for (auto&& hit : hits) {
+    auto body{reinterpret_cast<char*>(hit.body) - bodies.data()};
+    PythonRef item{PythonRef::Stolen(Py_BuildValue(
+        "(n(fff)(fff)f)", static_cast<Py_ssize_t>(body), hit.position.x,
+        hit.position.y, hit.position.z, hit.normal.x, hit.normal.y,
+        hit.normal.z, hit.distance))};
+    PyList_Append(py_list, item.get());
+  }
+
+  return py_list;
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PySpatialQuerySimulateDef = {
+    "spatial_query_simulate",  // name
+    PySpatialQuerySimulate,    // method
+    METH_VARARGS,              // flags
+
+    "spatial_query_simulate(\n"
+    "  geoms: Sequence[tuple[int, str, Sequence[float], Sequence[float]]],\n"
+    "  query: tuple)\n"
+    "  -> list[tuple[int, tuple[float, float, float],\n"
+    "  tuple[float, float, float], float]]\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Run a spatial query against standalone collision geoms.\n"
+    "\n"
+    "Geoms are (body, shape, position, size) with shape 'sphere' (size[0]\n"
+    "is the radius), 'box', or 'terrain' (a box of terrain; just a floor\n"
+    "if its height is zero). Geoms sharing a body id act as one body.\n"
+    "The query is ('sphere', center, radius), ('box', center, size) or\n"
+    "('ray', start, direction, length). Returns (body, position, normal,\n"
+    "distance) hits in the order the real queries would.\n"
+    "\n"
+    ":meta private:",
+};
+
+// ------------------------ terrain_contact_simulate ---------------------------
+
+namespace {
+
+// Collects terrain contacts for a set of geoms, tagged by geom index.
+struct TerrainContactRecorder {
+  std::unordered_map<dGeomID, int> indices;
+  std::vector<std::pair<int, dContactGeom>> contacts;
+
+  static void Collide(void* data, dGeomID o1, dGeomID o2) {
+    auto* recorder{static_cast<TerrainContactRecorder*>(data)};
+    dContactGeom contacts[16];
+    int count{dCollide(o1, o2, 16, contacts, sizeof(dContactGeom))};
+    int index{recorder->indices.at(o1)};
+    for (int i = 0; i < count; ++i) {
+      recorder->contacts.emplace_back(index, contacts[i]);
+    }
+  }
+
+  // Contacts for a step, grouped by geom but otherwise in the order they
+  // were found.
+  auto TakeStep() -> PythonRef {
+    std::stable_sort(
+        contacts.begin(), contacts.end(),
+        [](const auto& a, const auto& b) { return a.first < b.first; });
+    PythonRef list{PythonRef::Stolen(PyList_New(0))};
+    for (auto&& [index, contact] : contacts) {
+      PythonRef item{PythonRef::Stolen(Py_BuildValue(
+          "(i(fff)(fff)f)", index, contact.pos[0], contact.pos[1],
+          contact.pos[2], contact.normal[0], contact.normal[1],
+          contact.normal[2], contact.depth))};
+      PyList_Append(list.get(), item.get());
+    }
+    contacts.clear();
+    return list;
+  }
+};
+
+}  // namespace
+
+static auto PyTerrainContactSimulate(PyObject* self, PyObject* args,
+                                     PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  PyObject* terrain_obj;
+  PyObject* geoms_obj;
+  int steps{};
+  static const char* kwlist[] = {"terrain", "geoms", "steps", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "OOi",
+                                   const_cast<char**>(kwlist), &terrain_obj,
+                                   &geoms_obj, &steps)) {
+    return nullptr;
+  }
+  if (steps < 0) {
+    throw Exception("steps can't be negative.", PyExcType::kValue);
+  }
+
+  // Parse everything up front so nothing below can bail out half built.
+  std::vector<std::pair<Vector3f, Vector3f>> boxes;
+  PythonRef terrain_seq{PySequence_Fast(terrain_obj, "Expected a sequence."),
+                        PythonRef::kSteal};
+  if (!terrain_seq.exists()) {
+    return nullptr;
+  }
+  for (Py_ssize_t i = 0; i < PySequence_Fast_GET_SIZE(terrain_seq.get());
+       ++i) {
+    PyObject* center_obj;
+    PyObject* size_obj;
+    if (!PyArg_ParseTuple(PySequence_Fast_GET_ITEM(terrain_seq.get(), i),
+                          "OO", &center_obj, &size_obj)) {
+      return nullptr;
+    }
+    boxes.emplace_back(base::BasePython::GetPyVector3f(center_obj),
+                       base::BasePython::GetPyVector3f(size_obj));
+  }
+  struct GeomDef {
+    bool sphere;
+    Vector3f position;
+    Vector3f size;
+    Vector3f velocity;
+    float growth;
+  };
+  std::vector<GeomDef> geom_defs;
+  PythonRef geoms_seq{PySequence_Fast(geoms_obj, "Expected a sequence."),
+                      PythonRef::kSteal};
+  if (!geoms_seq.exists()) {
+    return nullptr;
+  }
+  for (Py_ssize_t i = 0; i < PySequence_Fast_GET_SIZE(geoms_seq.get()); ++i) {
+    const char* shape;
+    PyObject* position_obj;
+    PyObject* size_obj;
+    PyObject* velocity_obj;
+    float growth;
+    if (!PyArg_ParseTuple(PySequence_Fast_GET_ITEM(geoms_seq.get(), i),
+                          "sOOOf", &shape, &position_obj, &size_obj,
+                          &velocity_obj, &growth)) {
+      return nullptr;
+    }
+    if (strcmp(shape, "sphere") != 0 && strcmp(shape, "box") != 0) {
+      throw Exception("Invalid shape: '" + std::string(shape) + "'.",
+                      PyExcType::kValue);
+    }
+    geom_defs.push_back({strcmp(shape, "sphere") == 0,
+                         base::BasePython::GetPyVector3f(position_obj),
+                         base::BasePython::GetPyVector3f(size_obj),
+                         base::BasePython::GetPyVector3f(velocity_obj),
+                         growth});
+  }
+
+  // Geoms go into a standalone space and get collided against terrain
+  // through a collision cache exactly as a step does, with triangle lists
+  // kept between steps. Each step we then collide them again straight
+  // against the terrain with nothing cached, which is what the cached
+  // results need to match.
+  Dynamics dynamics{nullptr};
+  TestTerrain terrain{&dynamics};
+  std::vector<dGeomID> trimeshes;
+  for (auto&& box : boxes) {
+    trimeshes.push_back(terrain.AddBox(box.first, box.second));
+  }
+  base::CollisionCache cache;
+  cache.SetGeoms(trimeshes);
+  TerrainContactRecorder recorder;
+  std::vector<dGeomID> geoms;
+  for (auto&& def : geom_defs) {
+    dGeomID geom{def.sphere ? dCreateSphere(dynamics.ode_space(), def.size.x)
+                            : dCreateBox(dynamics.ode_space(), def.size.x,
+                                         def.size.y, def.size.z)};
+    recorder.indices[geom] = static_cast<int>(geoms.size());
+    geoms.push_back(geom);
+  }
+
+  PythonRef cached_steps{PythonRef::Stolen(PyList_New(0))};
+  PythonRef plain_steps{PythonRef::Stolen(PyList_New(0))};
+  microsecs_t cached_time{};
+  microsecs_t plain_time{};
+  for (int stepnum = 0; stepnum < steps; ++stepnum) {
+    for (size_t i = 0; i < geoms.size(); ++i) {
+      GeomDef& def{geom_defs[i]};
+      Vector3f position{def.position + def.velocity * kGameStepSeconds
+                                           * static_cast<float>(stepnum)};
+      dGeomSetPosition(geoms[i], position.x, position.y, position.z);
+
+      // Resizing works like it does for rigid bodies; what was cached for
+      // the old size has to go first.
+      if (stepnum > 0 && def.growth != 0.0f) {
+        cache.ForgetGeom(geoms[i]);
+        def.size += Vector3f{def.growth, def.growth, def.growth};
+        if (def.sphere) {
+          dGeomSphereSetRadius(geoms[i], def.size.x);
+        } else {
+          dGeomBoxSetLengths(geoms[i], def.size.x, def.size.y, def.size.z);
+        }
+      }
+    }
+    auto start_time{core::CorePlatform::TimeMonotonicMicrosecs()};
+    cache.CollideAgainstSpace(dynamics.ode_space(), &recorder,
+                              &TerrainContactRecorder::Collide);
+    cached_time += core::CorePlatform::TimeMonotonicMicrosecs() - start_time;
+    PyList_Append(cached_steps.get(), recorder.TakeStep().get());
+
+    start_time = core::CorePlatform::TimeMonotonicMicrosecs();
+    for (dGeomID geom : geoms) {
+      for (dGeomID trimesh : trimeshes) {
+        TerrainContactRecorder::Collide(&recorder, geom, trimesh);
+      }
+    }
+    plain_time += core::CorePlatform::TimeMonotonicMicrosecs() - start_time;
+    PyList_Append(plain_steps.get(), recorder.TakeStep().get());
+  }
+  for (dGeomID geom : geoms) {
+    dGeomDestroy(geom);
+  }
+
+  return Py_BuildValue("{sOsOsdsd}", "cached", cached_steps.get(), "plain",
+                       plain_steps.get(), "cached_time",
+                       static_cast<double>(cached_time) / 1000000.0,
+                       "plain_time",
+                       static_cast<double>(plain_time) / 1000000.0);
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyTerrainContactSimulateDef = {
+    "terrain_contact_simulate",             // name
+    (PyCFunction)PyTerrainContactSimulate,  // method
+    METH_VARARGS | METH_KEYWORDS,           // flags
+
+    "terrain_contact_simulate(\n"
+    "  terrain: Sequence[tuple[Sequence[float], Sequence[float]]],\n"
+    "  geoms: Sequence[tuple[str, Sequence[float], Sequence[float],\n"
+    "  Sequence[float], float]], steps: int) -> dict[str, Any]\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Collide moving standalone geoms against terrain for a number of steps.\n"
+    "\n"
+    "Terrain is a list of (center, size) boxes. Geoms are (shape, position,\n"
+    "size, velocity, growth) with shape 'sphere' (size[0] is the radius) or\n"
+    "'box'; growth is added to each dimension every step. Returns\n"
+    "per-step contact lists of (geom index, position, normal, depth) under\n"
+    "'cached' (collided the way a step does, reusing triangle lists) and\n"
+    "'plain' (straight collides with nothing reused), along with the\n"
+    "seconds spent on each under 'cached_time' and 'plain_time'.\n"
+    "\n"
+    ":meta private:",
+};
+
+// ------------------------ collision_closing_impulse --------------------------
+
+static auto PyCollisionClosingImpulse(PyObject* self, PyObject* args)
+    -> PyObject* {
+  BA_PYTHON_TRY;
+  PyObject* body_objs[2];
+  PyObject* position_obj;
+  PyObject* normal_obj;
+  if (!PyArg_ParseTuple(args, "OOOO", &body_objs[0], &body_objs[1],
+                        &position_obj, &normal_obj)) {
+    return nullptr;
+  }
+  struct BodyDef {
+    bool exists;
+    float mass;
+    Vector3f velocity;
+    Vector3f angular_velocity;
+  };
+  BodyDef body_defs[2]{};
+  for (int i = 0; i < 2; ++i) {
+    if (body_objs[i] == Py_None) {
+      continue;
+    }
+    PyObject* velocity_obj;
+    PyObject* angular_velocity_obj;
+    if (!PyArg_ParseTuple(body_objs[i], "fOO", &body_defs[i].mass,
+                          &velocity_obj, &angular_velocity_obj)) {
+      return nullptr;
+    }
+    if (!(body_defs[i].mass > 0.0f)) {
+      throw Exception("Mass must be > 0.", PyExcType::kValue);
+    }
+    body_defs[i].exists = true;
+    body_defs[i].velocity = base::BasePython::GetPyVector3f(velocity_obj);
+    body_defs[i].angular_velocity =
+        base::BasePython::GetPyVector3f(angular_velocity_obj);
+  }
+  dContactGeom contact{};
+  Vector3f position{base::BasePython::GetPyVector3f(position_obj)};
+  Vector3f normal{base::BasePython::GetPyVector3f(normal_obj).Normalized()};
+  for (int i = 0; i < 3; ++i) {
+    contact.pos[i] = position.v[i];
+    contact.normal[i] = normal.v[i];
+  }
+
+  // Bodies sit at the origin of a throwaway world.
+  dWorldID world = dWorldCreate();
+  dBodyID bodies[2]{};
+  for (int i = 0; i < 2; ++i) {
+    if (!body_defs[i].exists) {
+      continue;
+    }
+    const BodyDef& def{body_defs[i]};
+    bodies[i] = dBodyCreate(world);
+    dMass mass;
+    dMassSetSphereTotal(&mass, def.mass, 0.5f);
+    dBodySetMass(bodies[i], &mass);
+    dBodySetLinearVel(bodies[i], def.velocity.x, def.velocity.y,
+                      def.velocity.z);
+    dBodySetAngularVel(bodies[i], def.angular_velocity.x,
+                       def.angular_velocity.y, def.angular_velocity.z);
+  }
+  float impulse{Dynamics::ClosingImpulse(bodies[0], bodies[1], contact)};
+  dWorldDestroy(world);
+  return PyFloat_FromDouble(impulse);
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyCollisionClosingImpulseDef = {
+    "collision_closing_impulse",  // name
+    PyCollisionClosingImpulse,    // method
+    METH_VARARGS,                 // flags
+
+    "collision_closing_impulse(\n"
+    "  body1: tuple[float, Sequence[float], Sequence[float]] | None,\n"
+    "  body2: tuple[float, Sequence[float], Sequence[float]] | None,\n"
+    "  position: Sequence[float], normal: Sequence[float]) -> float\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Return the impulse a collision would report for a contact.\n"
+    "\n"
+    "Bodies are (mass, velocity, angular_velocity) and sit at the origin;\n"
+    "None stands in for static geometry.\n"
+    "\n"
+    ":meta private:",
+};
+
+// -------------------------- collision_event_list -----------------------------
+
+// Events given as (opposing_body, position, depth, impulse) tuples.
+static auto GetBatchedEvents(PyObject* events_obj)
+    -> std::vector<PythonCallMaterialAction::BatchedEvent> {
+  std::vector<PythonCallMaterialAction::BatchedEvent> events;
+  PythonRef events_seq{PySequence_Fast(events_obj, "Expected a sequence."),
+                       PythonRef::kSteal};
+  if (!events_seq.exists()) {
+    throw Exception("Expected a sequence of events.", PyExcType::kType);
+  }
+  for (Py_ssize_t i = 0; i < PySequence_Fast_GET_SIZE(events_seq.get()); ++i) {
+    PyObject* item = PySequence_Fast_GET_ITEM(events_seq.get(), i);
+    PythonCallMaterialAction::BatchedEvent event;
+    PyObject* position_obj;
+    if (!PyArg_ParseTuple(item, "iOff", &event.opposing_body, &position_obj,
+                          &event.depth, &event.impulse)) {
+      throw Exception("Invalid event.", PyExcType::kType);
+    }
+    Vector3f position{base::BasePython::GetPyVector3f(position_obj)};
+    for (int j = 0; j < 3; ++j) {
+      event.position[j] = position.v[j];
+    }
+    events.push_back(event);
+  }
+  return events;
+}
+
+static auto PyCollisionEventList(PyObject* self, PyObject* args)
+    -> PyObject* {
+  BA_PYTHON_TRY;
+  PyObject* events_obj;
+  if (!PyArg_ParseTuple(args, "O", &events_obj)) {
+    return nullptr;
+  }
+  auto events{GetBatchedEvents(events_obj)};
+  PythonRef py_events{PythonCallMaterialAction::BatchedEventList(events)};
+  if (!py_events.exists()) {
+    throw Exception("Error building collision events.");
+  }
+  return py_events.NewRef();
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyCollisionEventListDef = {
+    "collision_event_list",  // name
+    PyCollisionEventList,    // method
+    METH_VARARGS,            // flags
+
+    "collision_event_list(\n"
+    "  events: Sequence[tuple[int, Sequence[float], float, float]])\n"
+    "  -> list[bascenev1.CollisionEvent]\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Return the list a batched material call would be passed for events\n"
+    "given as (opposing_body, position, depth, impulse), with nodes that\n"
+    "have since died.\n"
+    "\n"
+    ":meta private:",
+};
+
+// ---------------------------- batched_message --------------------------------
+
+static auto PyBatchedMessage(PyObject* self, PyObject* args) -> PyObject* {
+  BA_PYTHON_TRY;
+  PyObject* message_obj;
+  PyObject* events_obj;
+  if (!PyArg_ParseTuple(args, "OO", &message_obj, &events_obj)) {
+    return nullptr;
+  }
+  auto events{GetBatchedEvents(events_obj)};
+  PythonRef message{
+      NodeUserMessageMaterialAction::BatchedMessage(message_obj, events)};
+  if (!message.exists()) {
+    throw Exception("Error building batched message.");
+  }
+  return message.NewRef();
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyBatchedMessageDef = {
+    "batched_message",  // name
+    PyBatchedMessage,   // method
+    METH_VARARGS,       // flags
+
+    "batched_message(message: Any,\n"
+    "  events: Sequence[tuple[int, Sequence[float], float, float]])\n"
+    "  -> bascenev1.BatchedMessage\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Return what a batched material message would deliver for a message\n"
+    "and events given as (opposing_body, position, depth, impulse), with\n"
+    "nodes that have since died.\n"
+    "\n"
+    ":meta private:",
+};
+
+// ----------------------- material_message_deliveries -------------------------
+
+static auto PyMaterialMessageDeliveries(PyObject* self, PyObject* args)
+    -> PyObject* {
+  BA_PYTHON_TRY;
+  PyObject* steps_obj;
+  if (!PyArg_ParseTuple(args, "O", &steps_obj)) {
+    return nullptr;
+  }
+  struct Delivery {
+    int action;
+    std::vector<char> data;
+    bool at_disconnect;
+    int64_t target;
+    int64_t other;
+  };
+  std::vector<std::vector<Delivery>> steps;
+  int max_action{};
+  PythonRef steps_seq{PySequence_Fast(steps_obj, "Expected a sequence."),
+                      PythonRef::kSteal};
+  if (!steps_seq.exists()) {
+    return nullptr;
+  }
+  for (Py_ssize_t i = 0; i < PySequence_Fast_GET_SIZE(steps_seq.get()); ++i) {
+    PythonRef step_seq{
+        PySequence_Fast(PySequence_Fast_GET_ITEM(steps_seq.get(), i),
+                        "Expected a sequence."),
+        PythonRef::kSteal};
+    if (!step_seq.exists()) {
+      return nullptr;
+    }
+    auto& step{steps.emplace_back()};
+    for (Py_ssize_t j = 0; j < PySequence_Fast_GET_SIZE(step_seq.get());
+         ++j) {
+      Delivery delivery{};
+      PyObject* message_obj;
+      int at_disconnect;
+      if (!PyArg_ParseTuple(PySequence_Fast_GET_ITEM(step_seq.get(), j),
+                            "iO!pLL", &delivery.action, &PyTuple_Type,
+                            &message_obj, &at_disconnect, &delivery.target,
+                            &delivery.other)) {
+        return nullptr;
+      }
+      if (delivery.action < 0) {
+        throw Exception("Action ids must be >= 0.", PyExcType::kValue);
+      }
+      PyObject* user_message_obj{};
+      SceneV1Python::DoBuildNodeMessage(message_obj, 0, &delivery.data,
+                                        &user_message_obj);
+      if (user_message_obj) {
+        throw Exception("Only native node messages are supported.",
+                        PyExcType::kValue);
+      }
+      delivery.at_disconnect = at_disconnect;
+      max_action = std::max(max_action, delivery.action);
+      step.push_back(std::move(delivery));
+    }
+  }
+
+  // Actions only matter for identity, so hand out addresses within a
+  // buffer. Each step gets a fresh dynamics, just as each real step starts
+  // with nothing delivered.
+  std::vector<char> actions(static_cast<size_t>(max_action) + 1);
+  PythonRef results{PyList_New(0), PythonRef::kSteal};
+  for (auto&& step : steps) {
+    Dynamics dynamics{nullptr};
+    PythonRef step_results{PyList_New(0), PythonRef::kSteal};
+    for (auto&& delivery : step) {
+      bool delivered{NodeMessageMaterialAction::ShouldDeliver(
+          &dynamics,
+          reinterpret_cast<const MaterialAction*>(&actions[delivery.action]),
+          delivery.data.data(), delivery.at_disconnect, delivery.target,
+          delivery.other)};
+      PyList_Append(step_results.get(), delivered ? Py_True : Py_False);
+    }
+    PyList_Append(results.get(), step_results.get());
+  }
+  return results.HandOver();
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyMaterialMessageDeliveriesDef = {
+    "material_message_deliveries",  // name
+    PyMaterialMessageDeliveries,    // method
+    METH_VARARGS,                   // flags
+
+    "material_message_deliveries(\n"
+    "  steps: Sequence[Sequence[tuple[int, tuple, bool, int, int]]])\n"
+    "  -> list[list[bool]]\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Return which material message actions would be delivered.\n"
+    "\n"
+    "Each step is a list of (action, message, at_disconnect, target,\n"
+    "other) deliveries, where message is a native node message tuple such\n"
+    "as ('flash',) and target and other are node ids.\n"
+    "\n"
+    ":meta private:",
+};
+
+// ---------------------------- nav_grid_simulate ------------------------------
+
+// Run a batch of (start, end) pair requests (or none for None) and return
+// a list with one result per pair.
+template <typename F>
+static auto PointPairResults(PyObject* pairs_obj, F&& get_result)
+    -> PyObject* {
+  if (pairs_obj == Py_None) {
+    return PyList_New(0);
+  }
+  PythonRef pairs{PySequence_Fast(pairs_obj, "Expected a sequence."),
+                  PythonRef::kSteal};
+  if (!pairs.exists()) {
+    throw Exception("Expected a sequence.", PyExcType::kType);
+  }
+  Py_ssize_t count = PySequence_Fast_GET_SIZE(pairs.get());
+  PythonRef results{PyList_New(count), PythonRef::kSteal};
+  for (Py_ssize_t i = 0; i < count; ++i) {
+    Vector3f start, end;
+    PythonMethodsScene::GetPointPair(PySequence_Fast_GET_ITEM(pairs.get(), i),
+                                     &start, &end);
+    PyList_SET_ITEM(results.get(), i, get_result(start, end));
+  }
+  return results.HandOver();
+}
+
+static auto PyNavGridSimulate(PyObject* self, PyObject* args,
+                              PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  PyObject* terrain_obj;
+  PyObject* bounds_min_obj;
+  PyObject* bounds_max_obj;
+  float cell_size{0.5f};
+  float max_step{0.5f};
+  PyObject* paths_obj{Py_None};
+  PyObject* directions_obj{Py_None};
+  PyObject* sight_lines_obj{Py_None};
+  static const char* kwlist[] = {"terrain",   "bounds_min", "bounds_max",
+                                 "cell_size", "max_step",   "paths",
+                                 "directions", "sight_lines", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(
+          args, keywds, "OOO|ffOOO", const_cast<char**>(kwlist),
+          &terrain_obj, &bounds_min_obj, &bounds_max_obj, &cell_size,
+          &max_step, &paths_obj, &directions_obj, &sight_lines_obj)) {
+    return nullptr;
+  }
+  if (!(cell_size >= 0.1f) || !(max_step >= 0.0f)) {
+    throw Exception("Invalid cell_size or max_step.", PyExcType::kValue);
+  }
+  Vector3f bounds_min{base::BasePython::GetPyVector3f(bounds_min_obj)};
+  Vector3f bounds_max{base::BasePython::GetPyVector3f(bounds_max_obj)};
+  std::vector<std::pair<Vector3f, Vector3f>> boxes;
+  PythonRef terrain_seq{PySequence_Fast(terrain_obj, "Expected a sequence."),
+                        PythonRef::kSteal};
+  if (!terrain_seq.exists()) {
+    return nullptr;
+  }
+  for (Py_ssize_t i = 0; i < PySequence_Fast_GET_SIZE(terrain_seq.get());
+       ++i) {
+    Vector3f center, size;
+    PythonMethodsScene::GetPointPair(
+        PySequence_Fast_GET_ITEM(terrain_seq.get(), i), &center, &size);
+    boxes.emplace_back(center, size);
+  }
+
+  Dynamics dynamics{nullptr};
+  TestTerrain terrain{&dynamics};
+  for (auto&& box : boxes) {
+    terrain.AddBox(box.first, box.second);
+  }
+  NavGrid nav_grid{&dynamics, bounds_min.v, bounds_max.v, cell_size,
+                   max_step};
+  std::vector<Vector3f> path;
+  PythonRef paths{
+      PointPairResults(paths_obj,
+                       [&](const Vector3f& start, const Vector3f& end) {
+                         return PythonMethodsScene::NavPathResult(
+                             &nav_grid, start, end, &path);
+                       }),
+      PythonRef::kSteal};
+  PythonRef directions{
+      PointPairResults(directions_obj,
+                       [&](const Vector3f& position, const Vector3f& target) {
+                         return PythonMethodsScene::NavDirectionResult(
+                             &nav_grid, position, target);
+                       }),
+      PythonRef::kSteal};
+  Dynamics::QueryHit hit;
+  PythonRef sight_lines{
+      PointPairResults(sight_lines_obj,
+                       [&](const Vector3f& start, const Vector3f& end) {
+                         return PyBool_FromLong(
+                             !dynamics.RaycastTerrain(start, end, &hit));
+                       }),
+      PythonRef::kSteal};
+  return Py_BuildValue("{sisisisOsOsO}", "width", nav_grid.width(), "depth",
+                       nav_grid.depth(), "walkable",
+                       nav_grid.walkable_count(), "paths", paths.get(),
+                       "directions", directions.get(), "sight_lines",
+                       sight_lines.get());
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyNavGridSimulateDef = {
+    "nav_grid_simulate",             // name
+    (PyCFunction)PyNavGridSimulate,  // method
+    METH_VARARGS | METH_KEYWORDS,    // flags
+
+    "nav_grid_simulate(\n"
+    "  terrain: Sequence[tuple[Sequence[float], Sequence[float]]],\n"
+    "  bounds_min: Sequence[float], bounds_max: Sequence[float],\n"
+    "  cell_size: float = 0.5, max_step: float = 0.5,\n"
+    "  paths: Sequence | None = None, directions: Sequence | None = None,\n"
+    "  sight_lines: Sequence | None = None) -> dict[str, Any]\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Build a nav grid over standalone terrain and run requests on it.\n"
+    "\n"
+    "Terrain is a list of (center, size) boxes (just a floor if a box's\n"
+    "height is zero). Requests are the same pairs find_nav_paths(),\n"
+    "get_nav_directions() and check_line_of_sight() take. Returns a dict\n"
+    "of the grid's width, depth and walkable cell count plus the results\n"
+    "for each type of request.\n"
+    "\n"
+    ":meta private:",
+};
+
+// --------------------------- anim_track_evaluate -----------------------------
+
+static auto PyAnimTrackEvaluate(PyObject* self, PyObject* args,
+                                PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  PyObject* times_obj;
+  PyObject* values_obj;
+  PyObject* query_times_obj;
+  int size{1};
+  int loop{};
+  float offset{};
+  static const char* kwlist[] = {"times", "values", "query_times", "size",
+                                 "loop",  "offset", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(
+          args, keywds, "OOO|ipf", const_cast<char**>(kwlist), &times_obj,
+          &values_obj, &query_times_obj, &size, &loop, &offset)) {
+    return nullptr;
+  }
+  if (size < 1) {
+    throw Exception("Size must be >= 1.", PyExcType::kValue);
+  }
+  std::vector<int64_t> times{Python::GetInts64(times_obj)};
+  std::vector<float> values{Python::GetFloats(values_obj)};
+  std::vector<int64_t> query_times{Python::GetInts64(query_times_obj)};
+
+  // Keys as an animtrack node sees them: one per time with a full set of
+  // values. Unlike the node, we don't fix up out-of-order times.
+  std::vector<float> key_times(std::min(
+      times.size(), values.size() / static_cast<size_t>(size)));
+  for (size_t i = 0; i < key_times.size(); ++i) {
+    key_times[i] = static_cast<float>(times[i]);
+  }
+  if (!std::is_sorted(key_times.begin(), key_times.end())) {
+    throw Exception("Times must be in order.", PyExcType::kValue);
+  }
+
+  // Evaluate in order with one segment hint, as a node stepping through
+  // scene time would.
+  size_t segment{};
+  std::vector<float> out(static_cast<size_t>(size));
+  PythonRef results{PyList_New(0), PythonRef::kSteal};
+  for (auto query_time : query_times) {
+    AnimTrackNode::Evaluate(key_times, values.data(),
+                            static_cast<size_t>(size), loop,
+                            static_cast<float>(query_time) - offset,
+                            &segment, out.data());
+    PythonRef py_out{PyList_New(0), PythonRef::kSteal};
+    for (float val : out) {
+      PythonRef py_val{PyFloat_FromDouble(val), PythonRef::kSteal};
+      PyList_Append(py_out.get(), py_val.get());
+    }
+    PyList_Append(results.get(), py_out.get());
+  }
+  return results.HandOver();
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyAnimTrackEvaluateDef = {
+    "anim_track_evaluate",             // name
+    (PyCFunction)PyAnimTrackEvaluate,  // method
+    METH_VARARGS | METH_KEYWORDS,      // flags
+
+    "anim_track_evaluate(times: Sequence[int], values: Sequence[float],\n"
+    "  query_times: Sequence[int], size: int = 1, loop: bool = False,\n"
+    "  offset: float = 0.0) -> list[list[float]]\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Return an animtrack node's output at each of a sequence of times.\n"
+    "\n"
+    ":meta private:",
+};
+
+// --------------------------- state_hash_simulate -----------------------------
+
+static auto PyStateHashSimulate(PyObject* self, PyObject* args,
+                                PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  PyObject* bodies_obj;
+  int steps{};
+  static const char* kwlist[] = {"bodies", "steps", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "Oi",
+                                   const_cast<char**>(kwlist), &bodies_obj,
+                                   &steps)) {
+    return nullptr;
+  }
+  if (steps < 0) {
+    throw Exception("steps can't be negative.", PyExcType::kValue);
+  }
+  PythonRef bodies_seq{PySequence_Fast(bodies_obj, "Expected a sequence."),
+                       PythonRef::kSteal};
+  if (!bodies_seq.exists()) {
+    return nullptr;
+  }
+
+  // Bodies go into a standalone world and are hashed after each step the
+  // same way a scene's rigid bodies are, with each one standing in for a
+  // node.
+  Dynamics dynamics{nullptr};
+  std::vector<std::pair<int64_t, dBodyID>> bodies;
+  auto destroy_bodies{[&bodies] {
+    for (auto&& body : bodies) {
+      dBodyDestroy(body.second);
+    }
+  }};
+  StateHashLog log;
+  log.per_node = true;
+  try {
+    Py_ssize_t count{PySequence_Fast_GET_SIZE(bodies_seq.get())};
+    for (Py_ssize_t i = 0; i < count; ++i) {
+      long long id;  // NOLINT
+      float px, py, pz, vx, vy, vz, ax, ay, az;
+      if (!PyArg_ParseTuple(
+              PySequence_Fast_GET_ITEM(bodies_seq.get(), i), "L(fff)(fff)(fff)",
+              &id, &px, &py, &pz, &vx, &vy, &vz, &ax, &ay, &az)) {
+        throw Exception();
+      }
+      dBodyID body{dBodyCreate(dynamics.ode_world())};
+      bodies.emplace_back(id, body);
+      dMass mass;
+      dMassSetSphere(&mass, 1.0f, 0.3f);
+      dBodySetMass(body, &mass);
+      dBodySetPosition(body, px, py, pz);
+      dBodySetLinearVel(body, vx, vy, vz);
+      dBodySetAngularVel(body, ax, ay, az);
+      log.node_descriptions[id] = "body " + std::to_string(id);
+    }
+    for (int stepnum = 1; stepnum <= steps; ++stepnum) {
+      dWorldQuickStep(dynamics.ode_world(), kGameStepSeconds);
+      auto& step{log.steps.emplace_back()};
+      step.stepnum = stepnum;
+      StateHasher hasher;
+      hasher.Add(step.stepnum);
+      hasher.Add(bodies.size());
+      for (auto&& body : bodies) {
+        StateHasher body_hasher;
+        body_hasher.Add(body.first);
+        body_hasher.AddBodyState(body.second);
+        hasher.Add(body_hasher.hash());
+        step.node_hashes.emplace_back(body.first, body_hasher.hash());
+      }
+      step.hash = hasher.hash();
+    }
+  } catch (...) {
+    destroy_bodies();
+    throw;
+  }
+  destroy_bodies();
+  return PythonMethodsScene::StateHashLogToPython(log).HandOver();
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyStateHashSimulateDef = {
+    "state_hash_simulate",             // name
+    (PyCFunction)PyStateHashSimulate,  // method
+    METH_VARARGS | METH_KEYWORDS,      // flags
+
+    "state_hash_simulate(\n"
+    "  bodies: Sequence[tuple[int, Sequence[float], Sequence[float],\n"
+    "  Sequence[float]]], steps: int) -> dict[str, Any]\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Step standalone rigid bodies and record a state hash log.\n"
+    "\n"
+    "Each body is an (id, position, velocity, angular-velocity) tuple.\n"
+    "Returns a log in the same form as end_state_hash_log() with\n"
+    "per-body hashes in place of per-node ones.\n"
+    "\n"
+    ":meta private:",
+};
+
+// --------------------------- scene_snapshot_check ----------------------------
+
+static auto PySceneSnapshotCheck(PyObject* self, PyObject* args,
+                                 PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  PyObject* snapshot_obj;
+  PyObject* nodes_obj;
+  static const char* kwlist[] = {"snapshot", "nodes", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "OO",
+                                   const_cast<char**>(kwlist), &snapshot_obj,
+                                   &nodes_obj)) {
+    return nullptr;
+  }
+  const uint8_t* data;
+  size_t size;
+  PythonMethodsScene::GetSnapshotBytes(snapshot_obj, &data, &size);
+  PythonRef nodes{PySequence_Fast(nodes_obj, "Expected a sequence."),
+                  PythonRef::kSteal};
+  if (!nodes.exists()) {
+    return nullptr;
+  }
+  std::unordered_map<int64_t, NodeType*> live_types;
+  Py_ssize_t count{PySequence_Fast_GET_SIZE(nodes.get())};
+  for (Py_ssize_t i = 0; i < count; ++i) {
+    long long id;  // NOLINT
+    const char* type_name;
+    if (!PyArg_ParseTuple(PySequence_Fast_GET_ITEM(nodes.get(), i), "Ls", &id,
+                          &type_name)) {
+      return nullptr;
+    }
+    auto type{g_scene_v1->node_types().find(type_name)};
+    if (type == g_scene_v1->node_types().end()) {
+      throw Exception("Invalid node type: '" + std::string(type_name) + "'.",
+                      PyExcType::kValue);
+    }
+    live_types[id] = type->second;
+  }
+  return PyLong_FromLong(SceneSnapshot::Check(data, size, live_types));
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PySceneSnapshotCheckDef = {
+    "scene_snapshot_check",             // name
+    (PyCFunction)PySceneSnapshotCheck,  // method
+    METH_VARARGS | METH_KEYWORDS,       // flags
+
+    "scene_snapshot_check(snapshot: bytes,\n"
+    "  nodes: Sequence[tuple[int, str]]) -> int\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Run restore_scene_snapshot()'s checks against (id, type-name) nodes.\n"
+    "\n"
+    "Raises an error if the snapshot couldn't be restored over them;\n"
+    "otherwise returns how many of its nodes are among them.\n"
+    "\n"
+    ":meta private:",
+};
+
+// ------------------------ resting_correction_schedule ------------------------
+
+static auto PyRestingCorrectionSchedule(PyObject* self, PyObject* args,
+                                        PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  PyObject* node_ids_obj;
+  int count{};
+  static const char* kwlist[] = {"node_ids", "count", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "Oi",
+                                   const_cast<char**>(kwlist), &node_ids_obj,
+                                   &count)) {
+    return nullptr;
+  }
+  if (count < 0) {
+    throw Exception("count can't be negative.", PyExcType::kValue);
+  }
+  std::vector<int64_t> node_ids;
+  PythonRef node_ids_seq{
+      PySequence_Fast(node_ids_obj, "Expected a sequence."), PythonRef::kSteal};
+  if (!node_ids_seq.exists()) {
+    return nullptr;
+  }
+  for (Py_ssize_t i = 0; i < PySequence_Fast_GET_SIZE(node_ids_seq.get());
+       ++i) {
+    int64_t node_id{
+        Python::GetInt64(PySequence_Fast_GET_ITEM(node_ids_seq.get(), i))};
+    if (node_id < 0) {
+      throw Exception("Node ids must be >= 0.", PyExcType::kValue);
+    }
+    node_ids.push_back(node_id);
+  }
+
+  PyObject* py_list = PyList_New(0);
+  for (int correction_num = 0; correction_num < count; ++correction_num) {
+    PythonRef due{PythonRef::Stolen(PyList_New(0))};
+    for (int64_t node_id : node_ids) {
+      if (Scene::IsRestingCorrectionDue(node_id, correction_num)) {
+        PythonRef item{PythonRef::Stolen(PyLong_FromLongLong(node_id))};
+        PyList_Append(due.get(), item.get());
+      }
+    }
+    PyList_Append(py_list, due.get());
+  }
+  return py_list;
+  BA_PYTHON_CATCH;
+}
+
+static PyMethodDef PyRestingCorrectionScheduleDef = {
+    "resting_correction_schedule",             // name
+    (PyCFunction)PyRestingCorrectionSchedule,  // method
+    METH_VARARGS | METH_KEYWORDS,              // flags
+
+    "resting_correction_schedule(node_ids: Sequence[int], count: int)\n"
+    "  -> list[list[int]]\n"
+    "\n"
+    "(internal)\n"
+    "\n"
+    "Return which resting nodes get resent in each physics correction.\n"
+    "\n"
+    "Periodic corrections leave out nodes lying exactly where clients were\n"
+    "last told they came to rest, apart from a few each time so they all\n"
+    "get refreshed now and then. This lists the ids that would go out\n"
+    "anyway in each of the first count corrections.\n"
+    "\n"
+    ":meta private:",
+};
+
+}  // namespace ballistica::scene_v1
+
+#endif  // BA_DEBUG_BUILD || BA_VARIANT_TEST_BUILD
+
+namespace ballistica::scene_v1 {
+
+auto PythonMethodsTesting::GetMethods() -> std::vector<PyMethodDef> {
+#if BA_DEBUG_BUILD || BA_VARIANT_TEST_BUILD
+  return {
+      base::PyStepProfileSimulateDef,
+      base::PyTextureStreamScheduleDef,
+      base::PyFramePacingSimulateDef,
+      base::PyInputLatencySimulateDef,
+      base::PyRemoteAppStateSequenceSimulateDef,
+      base::PyUDPAdmissionSimulateDef,
+      base::PyBGDynamicsBudgetSimulateDef,
+      base::PyValidatingRendererFrameDef,
+      PyClientThrottledHandlingDef,
+      PyClientMessageHoldSimulateDef,
+      PyScreenMessagePayloadsDef,
+      PyClientHandshakeInfoEncodeDef,
+      PyClientHandshakeInfoDecodeDef,
+      PySessionSnapshotCompressDef,
+      PySessionSnapshotDecompressDef,
+      PySpatialQuerySimulateDef,
+      PyTerrainContactSimulateDef,
+      PyCollisionClosingImpulseDef,
+      PyCollisionEventListDef,
+      PyBatchedMessageDef,
+      PyMaterialMessageDeliveriesDef,
+      PyNavGridSimulateDef,
+      PyAnimTrackEvaluateDef,
+      PyStateHashSimulateDef,
+      PySceneSnapshotCheckDef,
+      PyRestingCorrectionScheduleDef,
+  };
+#else
+  return {};
+#endif
+}
+
+}  // namespace ballistica::scene_v1
@@ -38,6 +38,7 @@
 #include "ballistica/scene_v1/python/methods/python_methods_input.h"
 #include "ballistica/scene_v1/python/methods/python_methods_networking.h"
 #include "ballistica/scene_v1/python/methods/python_methods_scene.h"
+#include "ballistica/scene_v1/python/methods/python_methods_testing.h"
 #include "ballistica/scene_v1/support/scene.h"
 #include "ballistica/scene_v1/support/scene_v1_input_device_delegate.h"
 #include "ballistica/scene_v1/support/session_stream.h"
@@ -59,6 +60,7 @@ extern "C" auto PyInit__bascenev1() -> PyObject* {
                                   PythonMethodsAssets::GetMethods(),
                                   PythonMethodsNetworking::GetMethods(),
                                   PythonMethodsScene::GetMethods(),
+                                  PythonMethodsTesting::GetMethods(),
                               },
                               [](PyObject* module) -> int {
                                 BA_PYTHON_TRY;
@@ -1160,6 +1162,21 @@ void SceneV1Python::HandleLocalChatMessage(const std::string& message) {
   objs().Get(ObjID::kHandleLocalChatMessageCall).Call(args);
 }
 
+auto SceneV1Python::ShouldKickClientOverLimits(int client_id,
+                                               const std::string& reason)
+    -> bool {
+  base::ScopedSetContext ssc(nullptr);
+  PythonRef args(Py_BuildValue("(is)", client_id, reason.c_str()),
+                 PythonRef::kSteal);
+  PythonRef result = objs().Get(ObjID::kClientOverLimitsCall).Call(args);
+
+  // If something went wrong, err on the side of protecting the server.
+  if (!result.exists()) {
+    return true;
+  }
+  return result.get() != Py_False;
+}
+
 // Put together a node message with all args on the provided tuple (starting
 // with arg_offset) returns false on failure, true on success.
 void SceneV1Python::DoBuildNodeMessage(PyObject* args, int arg_offset,
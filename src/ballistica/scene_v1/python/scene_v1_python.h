@@ -70,6 +70,10 @@ class SceneV1Python {
   /// Pass a chat message along to the python UI layer for handling..
   void HandleLocalChatMessage(const std::string& message);
 
+  /// Ask whether a client that has been over its limits should be kicked.
+  auto ShouldKickClientOverLimits(int client_id, const std::string& reason)
+      -> bool;
+
   /// Given an asset-package python object and a media name, verify
   /// that the asset-package is valid in the current context_ref and return
   /// its fully qualified name if so.  Throw an Exception if not.
@@ -95,6 +99,9 @@ class SceneV1Python {
     kFilterChatMessageCall,
     kHandleLocalChatMessageCall,
     kHostInfoClass,
+    kClientOverLimitsCall,
+    kCollisionEventClass,
+    kBatchedMessageClass,
     kLast  // Sentinel; must be at end.
   };
 
@@ -7,6 +7,7 @@
 #include <unordered_map>
 
 #include "ballistica/scene_v1/node/anim_curve_node.h"
+#include "ballistica/scene_v1/node/anim_track_node.h"
 #include "ballistica/scene_v1/node/bomb_node.h"
 #include "ballistica/scene_v1/node/combine_node.h"
 #include "ballistica/scene_v1/node/explosion_node.h"
@@ -99,7 +100,8 @@ SceneV1FeatureSet::SceneV1FeatureSet()
                                  ScorchNode::InitType(),
                                  FlashNode::InitType(),
                                  TextureSequenceNode::InitType(),
-                                 TimeDisplayNode::InitType()};
+                                 TimeDisplayNode::InitType(),
+                                 AnimTrackNode::InitType()};
 
   int next_type_id{};
   for (auto* t : init_node_types) {
@@ -42,7 +42,7 @@ const int kProtocolVersionHostMin = 33;
 const int kProtocolVersionClientMin = 24;
 
 // Newest protocol version we can act as a client OR host for.
-const int kProtocolVersionMax = 35;
+const int kProtocolVersionMax = 36;
 
 // The protocol version we actually host is now read as a setting; see
 // kSceneV1HostProtocol in ballistica/base/support/app_config.h.
@@ -74,6 +74,8 @@ const int kProtocolVersionMax = 35;
 // 34: New image_node enums, data assets.
 //
 // 35: Camera shake in netplay. how did I apparently miss this for 10 years!?!
+//
+// 36: Added animtrack node.
 
 // Sim step size in milliseconds.
 const int kGameStepMilliseconds = 8;
@@ -92,6 +94,7 @@ const int kMaxPacketSize = 700;
 // Predeclare types we use throughout our FeatureSet so most headers can get
 // away with just including this header.
 class ClientControllerInterface;
+class ClientHandshakeInfo;
 class ClientInputDevice;
 class ClientSession;
 class SceneCollisionMesh;
@@ -108,6 +111,7 @@ class Huffman;
 class SceneCubeMapTexture;
 class SceneDataAsset;
 class Dynamics;
+class NavGrid;
 class SceneV1FeatureSet;
 class GlobalsNode;
 class HostSession;
@@ -141,6 +145,7 @@ class ClientSessionReplay;
 class RigidBody;
 class SessionStream;
 class Scene;
+struct StateHashLog;
 class SceneV1FeatureSet;
 class Session;
 class SceneSound;
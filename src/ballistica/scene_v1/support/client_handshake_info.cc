@@ -0,0 +1,331 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/scene_v1/support/client_handshake_info.h"
+
+#include <Python.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ballistica/base/networking/networking.h"
+#include "ballistica/shared/generic/utils.h"
+#include "ballistica/shared/python/python.h"
+
+namespace ballistica::scene_v1 {
+
+// Wire layout (multi-byte values in host byte order like the rest of the
+// message layer; strings are a uint16 byte count followed by utf8):
+//
+//   uint8   BA_MESSAGE_CLIENT_INFO_BINARY
+//   uint8   format
+//   int32   build number
+//   string  token
+//   string  peer hash
+//   uint16  profile count
+//   per profile:
+//     string  name
+//     uint8   flags (kProfileHas* / kProfileGlobal)
+//     string  character  (if kProfileHasCharacter)
+//     string  icon       (if kProfileHasIcon)
+//     float32 color[3]     (if kProfileHasColor)
+//     float32 highlight[3] (if kProfileHasHighlight)
+
+const size_t kMaxTokenLength{4096};
+const size_t kMaxProfileStringLength{256};
+const size_t kMaxPlayerProfiles{256};
+
+const uint8_t kProfileHasCharacter{1u << 0u};
+const uint8_t kProfileHasIcon{1u << 1u};
+const uint8_t kProfileHasColor{1u << 2u};
+const uint8_t kProfileHasHighlight{1u << 3u};
+const uint8_t kProfileHasGlobal{1u << 4u};
+const uint8_t kProfileGlobal{1u << 5u};
+
+namespace {
+
+class Writer {
+ public:
+  explicit Writer(std::vector<uint8_t>* out) : out_{out} {}
+
+  template <typename T>
+  void Write(T val) {
+    auto offset{out_->size()};
+    out_->resize(offset + sizeof(T));
+    memcpy(out_->data() + offset, &val, sizeof(T));
+  }
+
+  void WriteString(const std::string& val) {
+    assert(val.size() <= 0xFFFF);
+    Write(static_cast<uint16_t>(val.size()));
+    out_->insert(out_->end(), val.begin(), val.end());
+  }
+
+ private:
+  std::vector<uint8_t>* out_;
+};
+
+class Reader {
+ public:
+  Reader(const uint8_t* data, size_t size) : data_{data}, remaining_{size} {}
+
+  template <typename T>
+  auto Read(T* val) -> bool {
+    if (remaining_ < sizeof(T)) {
+      return false;
+    }
+    memcpy(val, data_, sizeof(T));
+    data_ += sizeof(T);
+    remaining_ -= sizeof(T);
+    return true;
+  }
+
+  auto ReadString(std::string* val, size_t max_length) -> bool {
+    uint16_t length;
+    if (!Read(&length) || length > max_length || remaining_ < length) {
+      return false;
+    }
+    val->assign(reinterpret_cast<const char*>(data_), length);
+    data_ += length;
+    remaining_ -= length;
+    return Utils::IsValidUTF8(*val);
+  }
+
+  auto ReadColor(float* val) -> bool {
+    for (int i = 0; i < 3; ++i) {
+      if (!Read(&val[i]) || !std::isfinite(val[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  auto remaining() const { return remaining_; }
+
+ private:
+  const uint8_t* data_;
+  size_t remaining_;
+};
+
+auto GetColor(PyObject* obj, float* color) -> bool {
+  if (!PySequence_Check(obj) || PySequence_Size(obj) != 3) {
+    PyErr_Clear();
+    return false;
+  }
+  for (int i = 0; i < 3; ++i) {
+    PythonRef item{PySequence_GetItem(obj, i), PythonRef::kSteal};
+    if (!item.exists() || !Python::IsNumber(item.get())) {
+      PyErr_Clear();
+      return false;
+    }
+    color[i] = Python::GetFloat(item.get());
+    if (!std::isfinite(color[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+auto GetProfileString(PyObject* obj, std::string* val) -> bool {
+  if (!Python::IsString(obj)) {
+    return false;
+  }
+  *val = Python::GetString(obj);
+  return val->size() <= kMaxProfileStringLength;
+}
+
+auto ColorToPython(const float* color) -> PyObject* {
+  return Py_BuildValue("[fff]", color[0], color[1], color[2]);
+}
+
+}  // namespace
+
+auto ClientHandshakeInfo::Encode() const -> std::vector<uint8_t> {
+  std::vector<uint8_t> out;
+  Writer writer{&out};
+  writer.Write(static_cast<uint8_t>(BA_MESSAGE_CLIENT_INFO_BINARY));
+  writer.Write(static_cast<uint8_t>(kClientHandshakeInfoFormat));
+  writer.Write(static_cast<int32_t>(build_number));
+  writer.WriteString(token);
+  writer.WriteString(peer_hash);
+  auto profile_count{std::min(player_profiles.size(), kMaxPlayerProfiles)};
+  writer.Write(static_cast<uint16_t>(profile_count));
+  for (size_t i = 0; i < profile_count; ++i) {
+    auto& profile{player_profiles[i]};
+    uint8_t flags{};
+    if (profile.has_character) {
+      flags |= kProfileHasCharacter;
+    }
+    if (profile.has_icon) {
+      flags |= kProfileHasIcon;
+    }
+    if (profile.has_color) {
+      flags |= kProfileHasColor;
+    }
+    if (profile.has_highlight) {
+      flags |= kProfileHasHighlight;
+    }
+    if (profile.has_global) {
+      flags |= kProfileHasGlobal;
+      if (profile.global) {
+        flags |= kProfileGlobal;
+      }
+    }
+    writer.WriteString(profile.name);
+    writer.Write(flags);
+    if (profile.has_character) {
+      writer.WriteString(profile.character);
+    }
+    if (profile.has_icon) {
+      writer.WriteString(profile.icon);
+    }
+    if (profile.has_color) {
+      for (float val : profile.color) {
+        writer.Write(val);
+      }
+    }
+    if (profile.has_highlight) {
+      for (float val : profile.highlight) {
+        writer.Write(val);
+      }
+    }
+  }
+  return out;
+}
+
+auto ClientHandshakeInfo::Decode(const std::vector<uint8_t>& buffer,
+                                 std::string* error) -> bool {
+  assert(error);
+  Reader reader{buffer.data(), buffer.size()};
+  uint8_t message_type;
+  uint8_t format;
+  int32_t build;
+  if (!reader.Read(&message_type) || !reader.Read(&format)
+      || !reader.Read(&build)) {
+    *error = "truncated header";
+    return false;
+  }
+  if (message_type != BA_MESSAGE_CLIENT_INFO_BINARY) {
+    *error = "wrong message type";
+    return false;
+  }
+  if (format < 1 || format > kClientHandshakeInfoFormat) {
+    *error = "unsupported format " + std::to_string(format);
+    return false;
+  }
+  if (build < 0) {
+    *error = "invalid build number";
+    return false;
+  }
+  build_number = build;
+  if (!reader.ReadString(&token, kMaxTokenLength)
+      || !reader.ReadString(&peer_hash, kMaxTokenLength)) {
+    *error = "invalid token or peer hash";
+    return false;
+  }
+  uint16_t profile_count;
+  if (!reader.Read(&profile_count) || profile_count > kMaxPlayerProfiles) {
+    *error = "invalid profile count";
+    return false;
+  }
+  player_profiles.clear();
+  player_profiles.resize(profile_count);
+  for (auto&& profile : player_profiles) {
+    uint8_t flags;
+    if (!reader.ReadString(&profile.name, kMaxProfileStringLength)
+        || !reader.Read(&flags)) {
+      *error = "invalid profile";
+      return false;
+    }
+    profile.has_character = (flags & kProfileHasCharacter) != 0;
+    profile.has_icon = (flags & kProfileHasIcon) != 0;
+    profile.has_color = (flags & kProfileHasColor) != 0;
+    profile.has_highlight = (flags & kProfileHasHighlight) != 0;
+    profile.has_global = (flags & kProfileHasGlobal) != 0;
+    profile.global = (flags & kProfileGlobal) != 0;
+    if ((profile.has_character
+         && !reader.ReadString(&profile.character, kMaxProfileStringLength))
+        || (profile.has_icon
+            && !reader.ReadString(&profile.icon, kMaxProfileStringLength))
+        || (profile.has_color && !reader.ReadColor(profile.color))
+        || (profile.has_highlight && !reader.ReadColor(profile.highlight))) {
+      *error = "invalid profile '" + profile.name + "'";
+      return false;
+    }
+  }
+  if (reader.remaining() != 0) {
+    *error = "trailing data";
+    return false;
+  }
+  return true;
+}
+
+void ClientHandshakeInfo::SetPlayerProfilesFromPython(PyObject* profiles) {
+  player_profiles.clear();
+  if (profiles == nullptr || !PyDict_Check(profiles)) {
+    return;
+  }
+  PyObject* key;
+  PyObject* value;
+  Py_ssize_t pos{};
+  while (PyDict_Next(profiles, &pos, &key, &value)
+         && player_profiles.size() < kMaxPlayerProfiles) {
+    PlayerProfile profile;
+    if (!GetProfileString(key, &profile.name) || !PyDict_Check(value)) {
+      continue;
+    }
+    if (PyObject* obj = PyDict_GetItemString(value, "character")) {
+      profile.has_character = GetProfileString(obj, &profile.character);
+    }
+    if (PyObject* obj = PyDict_GetItemString(value, "icon")) {
+      profile.has_icon = GetProfileString(obj, &profile.icon);
+    }
+    if (PyObject* obj = PyDict_GetItemString(value, "color")) {
+      profile.has_color = GetColor(obj, profile.color);
+    }
+    if (PyObject* obj = PyDict_GetItemString(value, "highlight")) {
+      profile.has_highlight = GetColor(obj, profile.highlight);
+    }
+    if (PyObject* obj = PyDict_GetItemString(value, "global")) {
+      profile.has_global = true;
+      profile.global = PyObject_IsTrue(obj) == 1;
+    }
+    player_profiles.push_back(std::move(profile));
+  }
+}
+
+auto ClientHandshakeInfo::GetPlayerProfilesAsPython() const -> PythonRef {
+  PythonRef profiles{PyDict_New(), PythonRef::kSteal};
+  for (auto&& profile : player_profiles) {
+    PythonRef entry{PyDict_New(), PythonRef::kSteal};
+    if (profile.has_character) {
+      PythonRef val{PyUnicode_FromString(profile.character.c_str()),
+                    PythonRef::kSteal};
+      PyDict_SetItemString(entry.get(), "character", val.get());
+    }
+    if (profile.has_icon) {
+      PythonRef val{PyUnicode_FromString(profile.icon.c_str()),
+                    PythonRef::kSteal};
+      PyDict_SetItemString(entry.get(), "icon", val.get());
+    }
+    if (profile.has_color) {
+      PythonRef val{ColorToPython(profile.color), PythonRef::kSteal};
+      PyDict_SetItemString(entry.get(), "color", val.get());
+    }
+    if (profile.has_highlight) {
+      PythonRef val{ColorToPython(profile.highlight), PythonRef::kSteal};
+      PyDict_SetItemString(entry.get(), "highlight", val.get());
+    }
+    if (profile.has_global) {
+      PyDict_SetItemString(entry.get(), "global",
+                           profile.global ? Py_True : Py_False);
+    }
+    PyDict_SetItemString(profiles.get(), profile.name.c_str(), entry.get());
+  }
+  return profiles;
+}
+
+}  // namespace ballistica::scene_v1
@@ -0,0 +1,66 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_SCENE_V1_SUPPORT_CLIENT_HANDSHAKE_INFO_H_
+#define BALLISTICA_SCENE_V1_SUPPORT_CLIENT_HANDSHAKE_INFO_H_
+
+#include <string>
+#include <vector>
+
+#include "ballistica/scene_v1/scene_v1.h"
+#include "ballistica/shared/python/python_ref.h"
+
+namespace ballistica::scene_v1 {
+
+/// Newest binary client-info format we can read or write. Hosts advertise
+/// this in their handshake and clients answer with a
+/// BA_MESSAGE_CLIENT_INFO_BINARY message in place of the older json
+/// client-info and player-profiles messages.
+const int kClientHandshakeInfoFormat = 1;
+
+/// Everything a client tells a host about itself on connecting, in native
+/// form.
+///
+/// Hosts decode this from the wire away from the logic thread; anything
+/// that comes out of Decode() has been bounds checked and has valid utf8
+/// strings and finite colors, so the logic thread can apply it as-is.
+class ClientHandshakeInfo {
+ public:
+  struct PlayerProfile {
+    std::string name;
+    std::string character;
+    std::string icon;
+    float color[3]{};
+    float highlight[3]{};
+    bool has_character{};
+    bool has_icon{};
+    bool has_color{};
+    bool has_highlight{};
+    bool has_global{};
+    bool global{};
+  };
+
+  int build_number{};
+  std::string token;
+  std::string peer_hash;
+  std::vector<PlayerProfile> player_profiles;
+
+  /// Build a complete BA_MESSAGE_CLIENT_INFO_BINARY message.
+  auto Encode() const -> std::vector<uint8_t>;
+
+  /// Fill in from a complete BA_MESSAGE_CLIENT_INFO_BINARY message.
+  /// Returns false and sets `error` for anything malformed. Does not touch
+  /// Python or any global state, so is safe to call from any thread.
+  auto Decode(const std::vector<uint8_t>& buffer, std::string* error) -> bool;
+
+  /// Fill in player_profiles from a Python player-profiles dict (as found
+  /// in the app config). Entries or values we can't represent are skipped.
+  void SetPlayerProfilesFromPython(PyObject* profiles);
+
+  /// Return player_profiles as a Python dict in the same shape as the app
+  /// config uses.
+  auto GetPlayerProfilesAsPython() const -> PythonRef;
+};
+
+}  // namespace ballistica::scene_v1
+
+#endif  // BALLISTICA_SCENE_V1_SUPPORT_CLIENT_HANDSHAKE_INFO_H_
@@ -24,6 +24,7 @@
 #include "ballistica/scene_v1/node/node_type.h"
 #include "ballistica/scene_v1/python/scene_v1_python.h"
 #include "ballistica/scene_v1/support/scene.h"
+#include "ballistica/scene_v1/support/session_snapshot.h"
 #include "ballistica/scene_v1/support/session_stream.h"
 
 namespace ballistica::scene_v1 {
@@ -1004,8 +1005,12 @@ void ClientSession::HandleSessionMessage(const std::vector<uint8_t>& buffer) {
       std::vector<uint8_t> sub_buffer;
       while (true) {
         uint16_t size;
+        if (offset + 2 > buffer.size()) {
+          Error("invalid state message");
+          return;
+        }
         memcpy(&size, &(buffer[offset]), 2);
-        if (offset + size > buffer.size()) {
+        if (offset + 2 + size > buffer.size()) {
           Error("invalid state message");
           return;
         }
@@ -1026,6 +1031,19 @@ void ClientSession::HandleSessionMessage(const std::vector<uint8_t>& buffer) {
       break;
     }
 
+    case BA_MESSAGE_SESSION_SNAPSHOT: {
+      // Hosts send this compressed form of a session-commands message to
+      // bring us up to speed when we join mid-session. Expand it and
+      // feed it back through as the commands message it came from.
+      std::vector<uint8_t> commands;
+      if (!SessionSnapshot::Decompress(buffer, &commands)) {
+        Error("invalid session snapshot");
+        return;
+      }
+      HandleSessionMessage(commands);
+      break;
+    }
+
     case BA_MESSAGE_SESSION_DYNAMICS_CORRECTION: {
       // Just drop this in the game's command-stream verbatim, except switch its
       // state-ID to a command-ID.
@@ -9,6 +9,7 @@
 #include "ballistica/base/graphics/graphics.h"
 #include "ballistica/base/graphics/support/net_graph.h"
 #include "ballistica/base/logic/logic.h"
+#include "ballistica/base/networking/networking.h"
 #include "ballistica/classic/support/classic_app_mode.h"
 #include "ballistica/core/core.h"
 #include "ballistica/core/logging/logging.h"
@@ -208,10 +209,11 @@ void ClientSessionNet::OnBaseTimeStepAdded(int step) {
 void ClientSessionNet::HandleSessionMessage(
     const std::vector<uint8_t>& message) {
   // Do the standard thing, but also write this message straight to our replay
-  // stream if we have one.
+  // stream if we have one. (Snapshots get expanded and come back through
+  // here as plain session-commands, so that's what our replay gets.)
   ClientSession::HandleSessionMessage(message);
 
-  if (writing_replay_) {
+  if (writing_replay_ && message[0] != BA_MESSAGE_SESSION_SNAPSHOT) {
     assert(g_base->assets_server);
     assert(replay_writer_);
     replay_writer_->PushAddMessageToReplayCall(message);
@@ -48,6 +48,7 @@ class HostActivity : public SceneV1Context {
     assert(scene_.exists());
     return scene_.get();
   }
+  auto scene_timers() -> TimerList& { return scene_timers_; }
   void Start();
 
   // A utility function; faster than dynamic_cast.
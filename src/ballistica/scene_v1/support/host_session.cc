@@ -9,8 +9,10 @@
 #include <vector>
 
 #include "ballistica/base/graphics/graphics.h"
+#include "ballistica/base/input/input.h"
 #include "ballistica/base/python/base_python.h"
 #include "ballistica/base/python/support/python_context_call.h"
+#include "ballistica/base/support/step_profiler.h"
 #include "ballistica/classic/support/classic_app_mode.h"
 #include "ballistica/core/core.h"
 #include "ballistica/core/logging/logging.h"
@@ -480,6 +482,11 @@ void HostSession::ProcessPlayerTimeOuts() {
 }
 
 void HostSession::StepScene() {
+  // Local player input received since the last step takes effect now.
+  // Activities step on their own timers (and there can be more than one
+  // of them during transitions), so we note this once per step here.
+  g_base->input->latency().OnSimStep();
+
   // Run up our game-time timers.
   sim_timers_.Run(scene()->time());
 
@@ -490,6 +497,8 @@ void HostSession::StepScene() {
 void HostSession::Update(int time_advance_millisecs, double time_advance) {
   assert(g_base->InLogicThread());
 
+  g_base->step_profiler->OnSessionUpdate();
+
   millisecs_t update_time_start = core::CorePlatform::TimeMonotonicMillisecs();
 
   // HACK: we used to do a bunch of fudging to try and advance time by
@@ -759,12 +768,13 @@ void HostSession::DumpFullState(SessionStream* out) {
 }
 
 void HostSession::GetCorrectionMessages(
-    bool blend, std::vector<std::vector<uint8_t> >* messages) {
+    bool blend, bool skip_resting,
+    std::vector<std::vector<uint8_t> >* messages) {
   std::vector<uint8_t> message;
 
   // Grab correction for session scene (though there shouldn't be one).
   if (scene_.exists()) {
-    message = scene_->GetCorrectionMessage(blend);
+    message = scene_->GetCorrectionMessage(blend, skip_resting);
     if (message.size() > 4) {
       // A correction packet of size 4 is empty; ignore it.
       messages->push_back(message);
@@ -775,7 +785,7 @@ void HostSession::GetCorrectionMessages(
   for (auto&& i : host_activities_) {
     if (HostActivity* ha = i.get()) {
       if (Scene* sg = ha->scene()) {
-        message = sg->GetCorrectionMessage(blend);
+        message = sg->GetCorrectionMessage(blend, skip_resting);
         if (message.size() > 4) {
           // A correction packet of size 4 is empty; ignore it.
           messages->push_back(message);
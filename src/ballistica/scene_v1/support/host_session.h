@@ -83,7 +83,7 @@ class HostSession : public Session {
     return is_main_menu_;
   }  // fixme remove this
   void DumpFullState(SessionStream* out) override;
-  void GetCorrectionMessages(bool blend,
+  void GetCorrectionMessages(bool blend, bool skip_resting,
                              std::vector<std::vector<uint8_t> >* messages);
   auto base_time() const -> millisecs_t { return base_time_millisecs_; }
   auto players() const -> const std::vector<Object::Ref<Player> >& {
@@ -2,7 +2,10 @@
 
 #include "ballistica/scene_v1/support/scene.h"
 
+#include <algorithm>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "ballistica/base/audio/audio.h"
@@ -11,20 +14,28 @@
 #include "ballistica/base/graphics/support/camera.h"
 #include "ballistica/base/networking/networking.h"
 #include "ballistica/base/python/support/python_context_call.h"
+#include "ballistica/base/support/step_profiler.h"
 #include "ballistica/classic/support/classic_app_mode.h"
 #include "ballistica/core/core.h"
 #include "ballistica/core/logging/logging_macros.h"
 #include "ballistica/scene_v1/assets/scene_sound.h"
 #include "ballistica/scene_v1/dynamics/dynamics.h"
+#include "ballistica/scene_v1/dynamics/nav_grid.h"
 #include "ballistica/scene_v1/dynamics/part.h"
 #include "ballistica/scene_v1/node/node_attribute.h"
 #include "ballistica/scene_v1/node/node_attribute_connection.h"
 #include "ballistica/scene_v1/node/node_type.h"
 #include "ballistica/scene_v1/node/player_node.h"
 #include "ballistica/scene_v1/support/session_stream.h"
+#include "ballistica/scene_v1/support/state_hasher.h"
 
 namespace ballistica::scene_v1 {
 
+// Resting nodes left out of correction messages still go out in one of
+// every this many, so anything a client missed or got wrong gets fixed
+// eventually. Nodes take turns so they don't all land in one message.
+const int kRestingCorrectionInterval{10};
+
 auto Scene::GetSceneStream() const -> SessionStream* {
   return output_stream_.get();
 }
@@ -39,6 +50,8 @@ void Scene::SetMapBounds(float xmin, float ymin, float zmin, float xmax,
   bounds_max_[2] = zmax;
 }
 
+void Scene::set_nav_grid(NavGrid* val) { nav_grid_ = val; }
+
 Scene::Scene(millisecs_t start_time)
     : time_(start_time),
       stepnum_(start_time / kGameStepMilliseconds),
@@ -140,6 +153,9 @@ auto Scene::GetPlayerNode(int id) -> PlayerNode* {
 }
 
 void Scene::Step() {
+  using base::StepProfiler;
+  StepProfiler::ScopedSample step_sample{StepProfiler::Category::kSceneStep,
+                                         nullptr, "Scene::Step"};
   out_of_bounds_nodes_.clear();
 
   auto* appmode = classic::ClassicAppMode::GetActiveOrFatal();
@@ -150,10 +166,20 @@ void Scene::Step() {
     last_step_real_time_ = g_core->AppTimeMillisecs();
     for (auto&& i : nodes_) {
       Node* node = i.get();
-      node->Step();
+      NodeType* node_type = node->type();
+      {
+        StepProfiler::ScopedSample sample{StepProfiler::Category::kNodeStep,
+                                          node_type, node_type->name().c_str()};
+        node->Step();
+      }
 
       // Now that it's stepped, pump new values to any nodes it's connected to.
-      node->UpdateConnections();
+      {
+        StepProfiler::ScopedSample sample{
+            StepProfiler::Category::kNodeConnections, node_type,
+            node_type->name().c_str()};
+        node->UpdateConnections();
+      }
     }
     in_step_ = false;
   }
@@ -179,6 +205,31 @@ void Scene::Step() {
 
   time_ += kGameStepMilliseconds;
   stepnum_++;
+
+  if (state_hash_log_) {
+    auto& step{state_hash_log_->steps.emplace_back()};
+    step.stepnum = stepnum_;
+    if (state_hash_log_->per_node) {
+      step.hash = StateHasher::HashScene(this, &step.node_hashes);
+      auto& descriptions{state_hash_log_->node_descriptions};
+      for (auto&& node : nodes_) {
+        if (descriptions.find(node->id()) == descriptions.end()) {
+          descriptions[node->id()] = node->GetObjectDescription();
+        }
+      }
+    } else {
+      step.hash = StateHasher::HashScene(this);
+    }
+  }
+}
+
+void Scene::BeginStateHashLog(bool per_node) {
+  state_hash_log_ = std::make_unique<StateHashLog>();
+  state_hash_log_->per_node = per_node;
+}
+
+auto Scene::EndStateHashLog() -> std::unique_ptr<StateHashLog> {
+  return std::move(state_hash_log_);
 }
 
 void Scene::DeleteNode(Node* node) {
@@ -445,7 +496,8 @@ void Scene::DumpNodes(SessionStream* out) {
   }
 }
 
-auto Scene::GetCorrectionMessage(bool blended) -> std::vector<uint8_t> {
+auto Scene::GetCorrectionMessage(bool blended, bool skip_resting)
+    -> std::vector<uint8_t> {
   // Let's loop over our nodes sending a bit of correction data.
 
   // Go through until we find at least 1 node to send corrections for,
@@ -458,6 +510,7 @@ auto Scene::GetCorrectionMessage(bool blended) -> std::vector<uint8_t> {
   int node_count = 0;
 
   std::vector<RigidBody*> dynamic_bodies;
+  int64_t correction_num{skip_resting ? resting_correction_count_++ : 0};
 
   for (auto&& i : nodes_) {
     Node* n = i.get();
@@ -474,6 +527,17 @@ auto Scene::GetCorrectionMessage(bool blended) -> std::vector<uint8_t> {
         }
       }
       if (!dynamic_bodies.empty()) {
+        int resync_data_size = n->GetResyncDataSize();
+
+        // Clients already have the final state of anything that has been
+        // lying still since the last correction; no need to keep sending
+        // it (aside from the occasional refresher).
+        if (skip_resting && resync_data_size == 0
+            && !IsRestingCorrectionDue(n->id(), correction_num)
+            && std::all_of(dynamic_bodies.begin(), dynamic_bodies.end(),
+                           [](RigidBody* b) { return b->IsRestReported(); })) {
+          continue;
+        }
         int node_embed_size = 5;  // 4 byte node-ID and 1 byte body-count
         int body_count = 0;
         for (auto&& i2 : dynamic_bodies) {
@@ -483,7 +547,6 @@ auto Scene::GetCorrectionMessage(bool blended) -> std::vector<uint8_t> {
 
         // Lastly add custom data.
         node_embed_size += 2;  // size
-        int resync_data_size = n->GetResyncDataSize();
         node_embed_size += resync_data_size;
 
         // If this size puts us over our max packet size (and we've got
@@ -515,6 +578,9 @@ auto Scene::GetCorrectionMessage(bool blended) -> std::vector<uint8_t> {
             char* p2 = p1;
             i2->EmbedFull(&p2);
             assert(p2 - p1 == body_embed_size);
+            if (skip_resting) {
+              i2->MarkCorrectionSent();
+            }
             offset += body_embed_size;
           }
 
@@ -543,6 +609,11 @@ auto Scene::GetCorrectionMessage(bool blended) -> std::vector<uint8_t> {
   return message;
 }
 
+auto Scene::IsRestingCorrectionDue(int64_t node_id, int64_t correction_num)
+    -> bool {
+  return (node_id + correction_num) % kRestingCorrectionInterval == 0;
+}
+
 void Scene::SetOutputStream(SessionStream* val) { output_stream_ = val; }
 
 void Scene::AddNode(Node* node, int64_t* node_id, NodeList::iterator* i) {
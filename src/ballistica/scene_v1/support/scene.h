@@ -3,6 +3,7 @@
 #ifndef BALLISTICA_SCENE_V1_SUPPORT_SCENE_H_
 #define BALLISTICA_SCENE_V1_SUPPORT_SCENE_H_
 
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -30,6 +31,12 @@ class Scene : public Object {
   static auto GetNodeMessageFormat(NodeMessageType type) -> const char*;
   auto time() const -> millisecs_t { return time_; }
   auto stepnum() const -> int64_t { return stepnum_; }
+
+  /// Jump to a saved time and step number (when restoring a snapshot).
+  void RestoreTime(millisecs_t time, int64_t stepnum) {
+    time_ = time;
+    stepnum_ = stepnum;
+  }
   auto nodes() const -> const NodeList& { return nodes_; }
   void AddNode(Node*, int64_t* node_id, NodeList::iterator* i);
   void AddOutOfBoundsNode(Node* n) { out_of_bounds_nodes_.emplace_back(n); }
@@ -40,6 +47,12 @@ class Scene : public Object {
   }
   auto in_step() const -> bool { return in_step_; }
   void SetMapBounds(float x, float y, float z, float X, float Y, float Z);
+  auto bounds_min() const -> const float* { return bounds_min_; }
+  auto bounds_max() const -> const float* { return bounds_max_; }
+
+  /// Bot navigation grid over our terrain, if one has been built.
+  auto nav_grid() const -> NavGrid* { return nav_grid_.get(); }
+  void set_nav_grid(NavGrid* val);
   void OnScreenSizeChange();
   void LanguageChanged();
   auto out_of_bounds_nodes() -> const std::vector<Object::WeakRef<Node> >& {
@@ -58,7 +71,20 @@ class Scene : public Object {
   auto has_bg_cover() const -> bool { return (bg_cover_count_ > 0); }
   void Dump(SessionStream* out);
   void DumpNodes(SessionStream* out);
-  auto GetCorrectionMessage(bool blended) -> std::vector<uint8_t>;
+
+  /// Build a message correcting clients' rigid bodies and resync data.
+  /// With skip_resting, nodes whose bodies are all still asleep exactly
+  /// as last sent with skip_resting are left out, except when
+  /// IsRestingCorrectionDue() says it's their turn to go out again; only
+  /// use that for messages going to everyone (clients and replays alike).
+  auto GetCorrectionMessage(bool blended, bool skip_resting = false)
+      -> std::vector<uint8_t>;
+
+  /// Whether a resting node gets resent anyway in the given skip_resting
+  /// correction (counting from 0). Each node comes up once every so many
+  /// corrections, with different nodes coming up at different times.
+  static auto IsRestingCorrectionDue(int64_t node_id, int64_t correction_num)
+      -> bool;
 
   void SetOutputStream(SessionStream* val);
   auto stream_id() const -> int64_t { return stream_id_; }
@@ -77,6 +103,14 @@ class Scene : public Object {
   auto globals_node() const -> GlobalsNode* { return globals_node_; }
   void set_globals_node(GlobalsNode* node) { globals_node_ = node; }
 
+  /// Start recording a state hash at the end of every step (optionally
+  /// with a hash for each node), for determinism checking. Replaces any
+  /// log in progress.
+  void BeginStateHashLog(bool per_node);
+
+  /// Stop recording and return what was recorded (null if not logging).
+  auto EndStateHashLog() -> std::unique_ptr<StateHashLog>;
+
  private:
   GlobalsNode* globals_node_{};  // Current globals node (if any).
   std::unordered_map<int, Object::WeakRef<PlayerNode> > player_nodes_;
@@ -88,6 +122,7 @@ class Scene : public Object {
   int64_t stepnum_{};
   bool in_step_{};
   int64_t next_node_id_{};
+  int64_t resting_correction_count_{};
 
   // For globals real_time attr (so is consistent through the step.)
   millisecs_t last_step_real_time_{};
@@ -98,6 +133,8 @@ class Scene : public Object {
   std::vector<Object::WeakRef<Node> > out_of_bounds_nodes_;
   NodeList nodes_;
   Object::Ref<Dynamics> dynamics_;
+  Object::Ref<NavGrid> nav_grid_;
+  std::unique_ptr<StateHashLog> state_hash_log_;
 };
 
 }  // namespace ballistica::scene_v1
@@ -0,0 +1,611 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/scene_v1/support/scene_snapshot.h"
+
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "ballistica/core/logging/logging_macros.h"
+#include "ballistica/scene_v1/dynamics/part.h"
+#include "ballistica/scene_v1/dynamics/rigid_body.h"
+#include "ballistica/scene_v1/node/node.h"
+#include "ballistica/scene_v1/node/node_attribute.h"
+#include "ballistica/scene_v1/node/node_type.h"
+#include "ballistica/scene_v1/support/host_activity.h"
+#include "ballistica/scene_v1/support/scene.h"
+#include "ballistica/scene_v1/support/session_stream.h"
+#include "ballistica/scene_v1/support/state_hasher.h"
+
+namespace ballistica::scene_v1 {
+
+const uint32_t kSnapshotMagic{0x50414E53};  // 'SNAP'
+const uint32_t kSnapshotVersion{1};
+
+namespace {
+
+class Writer {
+ public:
+  explicit Writer(std::vector<uint8_t>* out) : out_(out) {}
+  void Write(const void* data, size_t size) {
+    auto* bytes{static_cast<const uint8_t*>(data)};
+    out_->insert(out_->end(), bytes, bytes + size);
+  }
+  template <typename T>
+  void Write(const T& val) {
+    Write(&val, sizeof(val));
+  }
+  auto size() const -> size_t { return out_->size(); }
+
+  // Fill in a value written earlier as a placeholder.
+  template <typename T>
+  void Patch(size_t offset, const T& val) {
+    assert(offset + sizeof(val) <= out_->size());
+    memcpy(out_->data() + offset, &val, sizeof(val));
+  }
+
+ private:
+  std::vector<uint8_t>* out_;
+};
+
+class Reader {
+ public:
+  Reader(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+  auto Skip(size_t size) -> const uint8_t* {
+    if (size > size_ - offset_) {
+      throw Exception("Invalid scene snapshot.", PyExcType::kValue);
+    }
+    const uint8_t* out{data_ + offset_};
+    offset_ += size;
+    return out;
+  }
+  template <typename T>
+  auto Read() -> T {
+    T val;
+    memcpy(&val, Skip(sizeof(val)), sizeof(val));
+    return val;
+  }
+  auto done() const -> bool { return offset_ == size_; }
+
+ private:
+  const uint8_t* data_;
+  size_t size_;
+  size_t offset_{};
+};
+
+struct Header {
+  uint64_t hash{};
+  millisecs_t time{};
+  int64_t stepnum{};
+  std::vector<TimerList::TimerState> timers;
+};
+
+struct NodeChunk {
+  int64_t id{};
+  int type_id{};
+  uint64_t hash{};
+  const uint8_t* data{};
+  uint32_t size{};
+};
+
+// Offset of the overall hash within a snapshot.
+const size_t kHashOffset{sizeof(uint32_t) * 2};
+
+// Whether we save and restore an attr. Read-only attrs can't be restored
+// and asset/material attrs don't change during simulation.
+auto IsSnapshotAttr(NodeAttributeUnbound* attr) -> bool {
+  if (attr->is_read_only()) {
+    return false;
+  }
+  switch (attr->type()) {
+    case NodeAttributeType::kFloat:
+    case NodeAttributeType::kFloatArray:
+    case NodeAttributeType::kInt:
+    case NodeAttributeType::kIntArray:
+    case NodeAttributeType::kBool:
+    case NodeAttributeType::kString:
+    case NodeAttributeType::kNode:
+    case NodeAttributeType::kNodeArray:
+      return true;
+    default:
+      return false;
+  }
+}
+
+auto NodeId(Node* node) -> int64_t { return node ? node->id() : -1; }
+
+template <typename T>
+void WriteArray(Writer* out, const std::vector<T>& vals) {
+  out->Write(static_cast<uint32_t>(vals.size()));
+  out->Write(vals.data(), vals.size() * sizeof(T));
+}
+
+template <typename T>
+auto ReadArray(Reader* in) -> std::vector<T> {
+  auto count{in->Read<uint32_t>()};
+  const uint8_t* data{in->Skip(count * sizeof(T))};
+  std::vector<T> vals(count);
+  memcpy(vals.data(), data, count * sizeof(T));
+  return vals;
+}
+
+auto ReadString(Reader* in) -> std::string {
+  auto size{in->Read<uint32_t>()};
+  return {reinterpret_cast<const char*>(in->Skip(size)), size};
+}
+
+// Write an attr's value preceded by a flag byte (zero if it couldn't be
+// read).
+void WriteAttr(Writer* out, Node* node, NodeAttributeUnbound* attr) {
+  try {
+    switch (attr->type()) {
+      case NodeAttributeType::kFloat: {
+        auto val{attr->GetAsFloat(node)};
+        out->Write(uint8_t{1});
+        out->Write(val);
+        break;
+      }
+      case NodeAttributeType::kInt: {
+        auto val{attr->GetAsInt(node)};
+        out->Write(uint8_t{1});
+        out->Write(val);
+        break;
+      }
+      case NodeAttributeType::kBool: {
+        auto val{attr->GetAsBool(node)};
+        out->Write(uint8_t{1});
+        out->Write(static_cast<uint8_t>(val));
+        break;
+      }
+      case NodeAttributeType::kString: {
+        auto val{attr->GetAsString(node)};
+        out->Write(uint8_t{1});
+        out->Write(static_cast<uint32_t>(val.size()));
+        out->Write(val.data(), val.size());
+        break;
+      }
+      case NodeAttributeType::kFloatArray: {
+        auto vals{attr->GetAsFloats(node)};
+        out->Write(uint8_t{1});
+        WriteArray(out, vals);
+        break;
+      }
+      case NodeAttributeType::kIntArray: {
+        auto vals{attr->GetAsInts(node)};
+        out->Write(uint8_t{1});
+        WriteArray(out, vals);
+        break;
+      }
+      case NodeAttributeType::kNode: {
+        auto val{NodeId(attr->GetAsNode(node))};
+        out->Write(uint8_t{1});
+        out->Write(val);
+        break;
+      }
+      case NodeAttributeType::kNodeArray: {
+        std::vector<int64_t> ids;
+        for (Node* val : attr->GetAsNodes(node)) {
+          ids.push_back(NodeId(val));
+        }
+        out->Write(uint8_t{1});
+        WriteArray(out, ids);
+        break;
+      }
+      default:
+        assert(false);
+        break;
+    }
+  } catch (const std::exception&) {
+    out->Write(uint8_t{0});
+  }
+}
+
+// Set an attr to a value if it differs from the current one. Setters
+// refusing values are logged but don't stop the restore. A null node just
+// means we're checking that the data parses.
+template <typename T, typename Getter>
+void SetIfChanged(Node* node, NodeAttributeUnbound* attr, const T& val,
+                  Getter get) {
+  if (!node) {
+    return;
+  }
+  try {
+    if (get() != val) {
+      attr->Set(node, val);
+    }
+  } catch (const std::exception& e) {
+    BA_LOG_ONCE(LogName::kBa, LogLevel::kWarning,
+                "Error restoring " + node->type()->name() + "."
+                    + attr->name() + " from snapshot: " + e.what());
+  }
+}
+
+void ApplyAttr(Reader* in, Node* node, NodeAttributeUnbound* attr,
+               const std::unordered_map<int64_t, Node*>& nodes) {
+  if (in->Read<uint8_t>() == 0) {
+    return;
+  }
+  auto get_node{[&nodes](int64_t id) -> Node* {
+    auto i{nodes.find(id)};
+    return i == nodes.end() ? nullptr : i->second;
+  }};
+  switch (attr->type()) {
+    case NodeAttributeType::kFloat:
+      SetIfChanged(node, attr, in->Read<float>(),
+                   [&] { return attr->GetAsFloat(node); });
+      break;
+    case NodeAttributeType::kInt:
+      SetIfChanged(node, attr, in->Read<int64_t>(),
+                   [&] { return attr->GetAsInt(node); });
+      break;
+    case NodeAttributeType::kBool:
+      SetIfChanged(node, attr, in->Read<uint8_t>() != 0,
+                   [&] { return attr->GetAsBool(node); });
+      break;
+    case NodeAttributeType::kString:
+      SetIfChanged(node, attr, ReadString(in),
+                   [&] { return attr->GetAsString(node); });
+      break;
+    case NodeAttributeType::kFloatArray:
+      SetIfChanged(node, attr, ReadArray<float>(in),
+                   [&] { return attr->GetAsFloats(node); });
+      break;
+    case NodeAttributeType::kIntArray:
+      SetIfChanged(node, attr, ReadArray<int64_t>(in),
+                   [&] { return attr->GetAsInts(node); });
+      break;
+    case NodeAttributeType::kNode:
+      SetIfChanged(node, attr, get_node(in->Read<int64_t>()),
+                   [&] { return attr->GetAsNode(node); });
+      break;
+    case NodeAttributeType::kNodeArray: {
+      std::vector<Node*> vals;
+      for (int64_t id : ReadArray<int64_t>(in)) {
+        vals.push_back(get_node(id));
+      }
+      SetIfChanged(node, attr, vals, [&] { return attr->GetAsNodes(node); });
+      break;
+    }
+    default:
+      assert(false);
+      break;
+  }
+}
+
+void WriteNode(Writer* out, Node* node) {
+  for (NodeAttributeUnbound* attr : node->type()->attributes_by_index()) {
+    if (IsSnapshotAttr(attr)) {
+      WriteAttr(out, node, attr);
+    }
+  }
+  WriteArray(out, node->GetResyncData());
+
+  out->Write(static_cast<uint32_t>(node->parts().size()));
+  for (Part* part : node->parts()) {
+    out->Write(part->birth_time());
+    out->Write(part->last_impact_sound_time());
+    out->Write(part->last_skid_sound_time());
+    out->Write(part->last_roll_sound_time());
+    out->Write(static_cast<uint32_t>(part->rigid_bodies().size()));
+    for (RigidBody* body : part->rigid_bodies()) {
+      dBodyID b{body->body()};
+      out->Write(body->id());
+      out->Write(static_cast<uint8_t>(b != nullptr));
+      if (b) {
+        out->Write(dBodyGetPosition(b), sizeof(dReal) * 3);
+        out->Write(dBodyGetQuaternion(b), sizeof(dReal) * 4);
+        out->Write(dBodyGetLinearVel(b), sizeof(dReal) * 3);
+        out->Write(dBodyGetAngularVel(b), sizeof(dReal) * 3);
+        out->Write(static_cast<uint8_t>(dBodyIsEnabled(b) != 0));
+      }
+    }
+  }
+}
+
+void ApplyBody(Reader* in, RigidBody* body) {
+  auto id{in->Read<int>()};
+  if (in->Read<uint8_t>() == 0) {
+    return;
+  }
+  auto* p{reinterpret_cast<const dReal*>(in->Skip(sizeof(dReal) * 3))};
+  auto* q{reinterpret_cast<const dReal*>(in->Skip(sizeof(dReal) * 4))};
+  auto* lv{reinterpret_cast<const dReal*>(in->Skip(sizeof(dReal) * 3))};
+  auto* av{reinterpret_cast<const dReal*>(in->Skip(sizeof(dReal) * 3))};
+  bool enabled{in->Read<uint8_t>() != 0};
+  dBodyID b{body ? body->body() : nullptr};
+  if (!b || body->id() != id) {
+    return;
+  }
+
+  // Snapshot data isn't necessarily aligned for dReal.
+  dReal vals[13];
+  memcpy(vals, p, sizeof(dReal) * 3);
+  memcpy(vals + 3, q, sizeof(dReal) * 4);
+  memcpy(vals + 7, lv, sizeof(dReal) * 3);
+  memcpy(vals + 10, av, sizeof(dReal) * 3);
+  dBodySetPosition(b, vals[0], vals[1], vals[2]);
+  dBodySetQuaternion(b, vals + 3);
+  dBodySetLinearVel(b, vals[7], vals[8], vals[9]);
+  dBodySetAngularVel(b, vals[10], vals[11], vals[12]);
+  if (enabled) {
+    dBodyEnable(b);
+  } else {
+    dBodyDisable(b);
+  }
+}
+
+// Apply a node chunk of the given type. With a null node this just reads
+// through the chunk, so it can be checked before anything gets touched.
+void ApplyNode(Reader* in, NodeType* type, Node* node,
+               const std::unordered_map<int64_t, Node*>& nodes) {
+  assert(!node || node->type() == type);
+  for (NodeAttributeUnbound* attr : type->attributes_by_index()) {
+    if (IsSnapshotAttr(attr)) {
+      ApplyAttr(in, node, attr, nodes);
+    }
+  }
+  auto resync_data{ReadArray<uint8_t>(in)};
+  if (node && !resync_data.empty()) {
+    node->ApplyResyncData(resync_data);
+  }
+
+  // Parts and bodies are matched up by index; any that have come or gone
+  // since are skipped.
+  auto part_count{in->Read<uint32_t>()};
+  for (uint32_t i = 0; i < part_count; ++i) {
+    Part* part{node && i < node->parts().size() ? node->parts()[i] : nullptr};
+    auto birth_time{in->Read<millisecs_t>()};
+    auto impact_sound_time{in->Read<millisecs_t>()};
+    auto skid_sound_time{in->Read<millisecs_t>()};
+    auto roll_sound_time{in->Read<millisecs_t>()};
+    if (part) {
+      part->set_birth_time(birth_time);
+      part->set_last_impact_sound_time(impact_sound_time);
+      part->set_last_skid_sound_time(skid_sound_time);
+      part->set_last_roll_sound_time(roll_sound_time);
+    }
+    auto body_count{in->Read<uint32_t>()};
+    for (uint32_t j = 0; j < body_count; ++j) {
+      RigidBody* body{part && j < part->rigid_bodies().size()
+                          ? part->rigid_bodies()[j]
+                          : nullptr};
+      ApplyBody(in, body);
+    }
+  }
+}
+
+auto ReadHeader(Reader* in) -> Header {
+  if (in->Read<uint32_t>() != kSnapshotMagic
+      || in->Read<uint32_t>() != kSnapshotVersion) {
+    throw Exception("Invalid scene snapshot.", PyExcType::kValue);
+  }
+  Header header;
+  header.hash = in->Read<uint64_t>();
+  header.time = in->Read<millisecs_t>();
+  header.stepnum = in->Read<int64_t>();
+  auto timer_count{in->Read<uint32_t>()};
+  header.timers.resize(timer_count);
+  for (auto&& timer : header.timers) {
+    timer.id = in->Read<int>();
+    timer.last_run_time = in->Read<TimerMedium>();
+    timer.expire_time = in->Read<TimerMedium>();
+    timer.length = in->Read<TimerMedium>();
+    timer.repeat_count = in->Read<int>();
+    timer.initial = in->Read<uint8_t>() != 0;
+  }
+  return header;
+}
+
+auto ReadNodeChunks(Reader* in) -> std::vector<NodeChunk> {
+  std::vector<NodeChunk> chunks(in->Read<uint32_t>());
+  for (auto&& chunk : chunks) {
+    chunk.id = in->Read<int64_t>();
+    chunk.type_id = in->Read<int>();
+    chunk.hash = in->Read<uint64_t>();
+    chunk.size = in->Read<uint32_t>();
+    chunk.data = in->Skip(chunk.size);
+  }
+  if (!in->done()) {
+    throw Exception("Invalid scene snapshot.", PyExcType::kValue);
+  }
+  return chunks;
+}
+
+// Parse a snapshot and make sure every chunk for a live node matches that
+// node's type and reads cleanly, so a restore can't fail part way through.
+auto ReadForRestore(const uint8_t* data, size_t size,
+                    const std::unordered_map<int64_t, NodeType*>& live_types,
+                    Header* header) -> std::vector<NodeChunk> {
+  Reader in{data, size};
+  *header = ReadHeader(&in);
+  auto chunks{ReadNodeChunks(&in)};
+  std::unordered_map<int64_t, Node*> no_nodes;
+  for (auto&& chunk : chunks) {
+    auto i{live_types.find(chunk.id)};
+    if (i == live_types.end()) {
+      continue;  // Died since.
+    }
+    if (i->second->id() != chunk.type_id) {
+      throw Exception("Snapshot does not match this activity.",
+                      PyExcType::kValue);
+    }
+    Reader node_in{chunk.data, chunk.size};
+    ApplyNode(&node_in, i->second, nullptr, no_nodes);
+    if (!node_in.done()) {
+      throw Exception("Invalid scene snapshot.", PyExcType::kValue);
+    }
+  }
+  return chunks;
+}
+
+}  // namespace
+
+auto SceneSnapshot::Capture(HostActivity* activity, const uint8_t* previous,
+                            size_t previous_size) -> std::vector<uint8_t> {
+  assert(activity);
+  Scene* scene{activity->scene()};
+
+  // Hashes of unchanged node chunks can be pulled from the previous
+  // snapshot; comparing bytes is much cheaper than hashing them.
+  std::unordered_map<int64_t, NodeChunk> previous_chunks;
+  if (previous) {
+    Reader in{previous, previous_size};
+    ReadHeader(&in);
+    for (auto&& chunk : ReadNodeChunks(&in)) {
+      previous_chunks[chunk.id] = chunk;
+    }
+  }
+
+  std::vector<uint8_t> data;
+  if (previous) {
+    data.reserve(previous_size);
+  }
+  Writer out{&data};
+  out.Write(kSnapshotMagic);
+  out.Write(kSnapshotVersion);
+  assert(out.size() == kHashOffset);
+  out.Write(uint64_t{});  // Overall hash; filled in below.
+  out.Write(scene->time());
+  out.Write(scene->stepnum());
+  auto timers{activity->scene_timers().GetTimerStates()};
+  out.Write(static_cast<uint32_t>(timers.size()));
+  for (auto&& timer : timers) {
+    out.Write(timer.id);
+    out.Write(timer.last_run_time);
+    out.Write(timer.expire_time);
+    out.Write(timer.length);
+    out.Write(timer.repeat_count);
+    out.Write(static_cast<uint8_t>(timer.initial));
+  }
+  size_t nodes_start{out.size()};
+
+  StateHasher hasher;
+  out.Write(static_cast<uint32_t>(scene->nodes().size()));
+  for (auto&& node : scene->nodes()) {
+    out.Write(node->id());
+    out.Write(node->type()->id());
+    size_t hash_offset{out.size()};
+    out.Write(uint64_t{});
+    out.Write(uint32_t{});
+    size_t start{out.size()};
+    WriteNode(&out, node.get());
+    auto size{static_cast<uint32_t>(out.size() - start)};
+    const uint8_t* chunk_data{data.data() + start};
+
+    uint64_t hash;
+    auto i{previous_chunks.find(node->id())};
+    if (i != previous_chunks.end() && i->second.size == size
+        && !memcmp(i->second.data, chunk_data, size)) {
+      hash = i->second.hash;
+    } else {
+      StateHasher node_hasher;
+      node_hasher.Add(chunk_data, size);
+      hash = node_hasher.hash();
+    }
+    out.Patch(hash_offset, hash);
+    out.Patch(hash_offset + sizeof(hash), size);
+    hasher.Add(node->id());
+    hasher.Add(hash);
+  }
+
+  // The overall hash covers the header (minus the hash itself) plus each
+  // node's id and hash.
+  hasher.Add(data.data() + kHashOffset + sizeof(uint64_t),
+             nodes_start - kHashOffset - sizeof(uint64_t));
+  out.Patch(kHashOffset, hasher.hash());
+  return data;
+}
+
+auto SceneSnapshot::Restore(HostActivity* activity, const uint8_t* data,
+                            size_t size) -> int {
+  assert(activity);
+  Scene* scene{activity->scene()};
+  if (scene->in_step()) {
+    throw Exception("Can't restore a snapshot during a sim step.");
+  }
+
+  // Restored attrs are set directly and never go out through the
+  // session stream, so anyone watching it would fall out of sync.
+  SessionStream* stream{scene->GetSceneStream()};
+  if (stream && stream->HasAudience()) {
+    throw Exception(
+        "Can't restore a snapshot while clients are connected or a replay"
+        " is being recorded.");
+  }
+
+  std::unordered_map<int64_t, Node*> nodes;
+  std::unordered_map<int64_t, NodeType*> live_types;
+  nodes.reserve(scene->nodes().size());
+  live_types.reserve(scene->nodes().size());
+  for (auto&& node : scene->nodes()) {
+    nodes[node->id()] = node.get();
+    live_types[node->id()] = node->type();
+  }
+
+  // Check everything up front so bad data doesn't leave us half-restored.
+  Header header;
+  auto chunks{ReadForRestore(data, size, live_types, &header)};
+
+  scene->RestoreTime(header.time, header.stepnum);
+  for (auto&& timer : header.timers) {
+    activity->scene_timers().RestoreTimerState(timer);
+  }
+
+  int changed{};
+  std::vector<uint8_t> current;
+  for (auto&& chunk : chunks) {
+    auto i{nodes.find(chunk.id)};
+    if (i == nodes.end()) {
+      continue;  // Died since.
+    }
+    Node* node{i->second};
+    current.clear();
+    Writer out{&current};
+    WriteNode(&out, node);
+    if (current.size() == chunk.size
+        && !memcmp(current.data(), chunk.data, chunk.size)) {
+      continue;
+    }
+    Reader node_in{chunk.data, chunk.size};
+    ApplyNode(&node_in, node->type(), node, nodes);
+    changed++;
+  }
+
+  // Nodes born after the snapshot stay, but their parts can't be born in
+  // the future.
+  for (auto&& node : scene->nodes()) {
+    for (Part* part : node->parts()) {
+      if (part->birth_time() > header.time) {
+        part->set_birth_time(header.time);
+      }
+    }
+  }
+
+  // A client joining later gets a fresh dump of our restored state.
+  if (stream) {
+    stream->InvalidateJoinSnapshot();
+  }
+  return changed;
+}
+
+auto SceneSnapshot::Check(
+    const uint8_t* data, size_t size,
+    const std::unordered_map<int64_t, NodeType*>& live_types) -> int {
+  Header header;
+  auto chunks{ReadForRestore(data, size, live_types, &header)};
+  int restorable{};
+  for (auto&& chunk : chunks) {
+    if (live_types.find(chunk.id) != live_types.end()) {
+      restorable++;
+    }
+  }
+  return restorable;
+}
+
+auto SceneSnapshot::GetHash(const uint8_t* data, size_t size) -> uint64_t {
+  Reader in{data, size};
+  return ReadHeader(&in).hash;
+}
+
+}  // namespace ballistica::scene_v1
@@ -0,0 +1,64 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_SCENE_V1_SUPPORT_SCENE_SNAPSHOT_H_
+#define BALLISTICA_SCENE_V1_SUPPORT_SCENE_SNAPSHOT_H_
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "ballistica/scene_v1/scene_v1.h"
+
+namespace ballistica::scene_v1 {
+
+/// Compact in-memory binary snapshots of a host activity's simulation
+/// state, for rolling back and re-simulating (prediction, replay seeking,
+/// determinism checks) without going through session-stream commands.
+///
+/// A snapshot holds scene time, the schedule of the activity's sim timers,
+/// and for each node its plain data attrs (floats, ints, bools, strings,
+/// arrays of those and node references), its resync data, its parts'
+/// birth and sound times and its rigid bodies' exact positions,
+/// orientations, velocities and enabled states.
+///
+/// Each node's chunk carries a hash. When capturing with a previous
+/// snapshot to compare against, chunks that haven't changed reuse their
+/// old hash instead of being rehashed, and restoring only touches nodes
+/// whose current state differs from the snapshot.
+///
+/// Restoring can't bring back nodes or timers that have died since, and
+/// leaves ones created since in place (their owners on the Python side
+/// wouldn't expect otherwise). Contacts are rebuilt by the physics engine
+/// each step; the material collision records that drive connect and
+/// disconnect actions are left alone so those don't fire spuriously.
+/// Restored values are set directly on nodes and never go out through the
+/// session stream, so restoring is refused while clients are connected or
+/// a replay is being recorded; this is a local tool.
+class SceneSnapshot {
+ public:
+  /// Capture a snapshot. Passing the previous snapshot of the same
+  /// activity lets unchanged nodes skip rehashing.
+  static auto Capture(HostActivity* activity,
+                      const uint8_t* previous = nullptr,
+                      size_t previous_size = 0) -> std::vector<uint8_t>;
+
+  /// Restore a snapshot captured from this same activity. Returns the
+  /// number of nodes that had to be changed. The whole snapshot is
+  /// checked against the live nodes before anything is touched.
+  static auto Restore(HostActivity* activity, const uint8_t* data,
+                      size_t size) -> int;
+
+  /// Run the checks Restore() makes over live nodes with the given ids
+  /// and types, without touching anything. Throws if the snapshot can't
+  /// be restored; otherwise returns how many of its nodes are live.
+  static auto Check(const uint8_t* data, size_t size,
+                    const std::unordered_map<int64_t, NodeType*>& live_types)
+      -> int;
+
+  /// Return the overall state hash stored in a snapshot.
+  static auto GetHash(const uint8_t* data, size_t size) -> uint64_t;
+};
+
+}  // namespace ballistica::scene_v1
+
+#endif  // BALLISTICA_SCENE_V1_SUPPORT_SCENE_SNAPSHOT_H_
@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "ballistica/base/input/device/input_device.h"
+#include "ballistica/base/input/input.h"
 #include "ballistica/base/networking/networking.h"
 #include "ballistica/base/support/plus_soft.h"
 #include "ballistica/classic/support/classic_app_mode.h"
@@ -175,9 +176,21 @@ std::string SceneV1InputDeviceDelegate::DescribeAttachedTo() const {
 }
 
 void SceneV1InputDeviceDelegate::InputCommand(InputType type, float value) {
+  auto event_time{g_base->input->current_event_time()};
   if (Player* p = player_.get()) {
     p->InputCommand(type, value);
+    if (event_time >= 0) {
+      g_base->input->latency().OnEventConsumed(event_time);
+    }
   } else if (remote_player_.exists()) {
+    // Keep track of the oldest event in the buffer so we can measure how
+    // long it takes to go out.
+    if (event_time >= 0
+        && (remote_input_commands_event_time_ < 0
+            || event_time < remote_input_commands_event_time_)) {
+      remote_input_commands_event_time_ = event_time;
+    }
+
     // Add to existing buffer of input-commands.
     {
       size_t size = remote_input_commands_buffer_.size();
@@ -216,6 +229,10 @@ void SceneV1InputDeviceDelegate::ShipBufferIfFull() {
     last_remote_input_commands_send_time_ = real_time;
     hc->SendReliableMessage(remote_input_commands_buffer_);
     remote_input_commands_buffer_.clear();
+    if (remote_input_commands_event_time_ >= 0) {
+      g_base->input->latency().OnEventSent(remote_input_commands_event_time_);
+      remote_input_commands_event_time_ = -1;
+    }
   }
 }
 
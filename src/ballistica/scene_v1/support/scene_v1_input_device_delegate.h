@@ -75,6 +75,7 @@ class SceneV1InputDeviceDelegate : public base::InputDeviceDelegate {
   Object::WeakRef<ConnectionToHost> remote_player_;
 
   millisecs_t last_remote_input_commands_send_time_{};
+  microsecs_t remote_input_commands_event_time_{-1};
   std::vector<uint8_t> remote_input_commands_buffer_;
   int remote_player_id_{-1};
 
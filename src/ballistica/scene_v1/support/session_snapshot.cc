@@ -0,0 +1,206 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/scene_v1/support/session_snapshot.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "ballistica/base/networking/networking.h"
+
+namespace ballistica::scene_v1 {
+
+// Message layout:
+//
+//   uint8   BA_MESSAGE_SESSION_SNAPSHOT
+//   uint8   format
+//   uint32  uncompressed size
+//   ...     compressed commands message
+//
+// The compressed data is a series of sequences, each a token byte (high
+// nibble literal count, low nibble match length minus kMinMatch; 15 in
+// either means more length bytes follow, each added until one is < 255),
+// the literals, then a uint16 match offset and any extra match length
+// bytes. The final sequence is literals only.
+
+const size_t kHeaderSize{6};
+const size_t kMinMatch{4};
+const size_t kMaxOffset{65535};
+const int kHashBits{14};
+
+// Anything claiming to be bigger than this is garbage.
+const uint32_t kMaxSnapshotSize{64 * 1024 * 1024};
+
+// No compressed byte can expand to more than this (a maxed-out length
+// byte adds 255), so claims beyond it for a given input are garbage too.
+const size_t kMaxExpansion{255};
+
+// We don't allocate more than this multiple of the compressed size up
+// front no matter what the header claims; real snapshots that expand
+// further just grow the buffer as they go.
+const size_t kReserveExpansion{8};
+
+namespace {
+
+auto Hash(const uint8_t* ptr) -> uint32_t {
+  uint32_t val;
+  memcpy(&val, ptr, sizeof(val));
+  return (val * 2654435761u) >> (32 - kHashBits);
+}
+
+void WriteLength(std::vector<uint8_t>* out, size_t length) {
+  while (length >= 255) {
+    out->push_back(255);
+    length -= 255;
+  }
+  out->push_back(static_cast<uint8_t>(length));
+}
+
+auto ReadLength(const uint8_t** ptr, const uint8_t* end, size_t* length)
+    -> bool {
+  while (true) {
+    if (*ptr >= end) {
+      return false;
+    }
+    uint8_t val{*(*ptr)++};
+    *length += val;
+    if (val != 255) {
+      return true;
+    }
+  }
+}
+
+void WriteSequence(std::vector<uint8_t>* out, const uint8_t* literals,
+                   size_t literal_count, size_t offset, size_t match_length) {
+  size_t match_extra{match_length ? match_length - kMinMatch : 0};
+  auto token{static_cast<uint8_t>(
+      ((literal_count < 15 ? literal_count : 15) << 4u)
+      | (match_extra < 15 ? match_extra : 15))};
+  out->push_back(token);
+  if (literal_count >= 15) {
+    WriteLength(out, literal_count - 15);
+  }
+  out->insert(out->end(), literals, literals + literal_count);
+  if (match_length) {
+    auto offset16{static_cast<uint16_t>(offset)};
+    auto size{out->size()};
+    out->resize(size + sizeof(offset16));
+    memcpy(out->data() + size, &offset16, sizeof(offset16));
+    if (match_extra >= 15) {
+      WriteLength(out, match_extra - 15);
+    }
+  }
+}
+
+}  // namespace
+
+auto SessionSnapshot::Compress(const std::vector<uint8_t>& commands_message)
+    -> std::vector<uint8_t> {
+  const uint8_t* src{commands_message.data()};
+  size_t size{commands_message.size()};
+
+  std::vector<uint8_t> out(kHeaderSize);
+  out.reserve(kHeaderSize + size / 2);
+  out[0] = BA_MESSAGE_SESSION_SNAPSHOT;
+  out[1] = static_cast<uint8_t>(kSessionSnapshotFormat);
+  auto size32{static_cast<uint32_t>(size)};
+  memcpy(out.data() + 2, &size32, sizeof(size32));
+
+  // Positions+1 of the most recent occurrence of each hashed 4-byte run.
+  std::vector<uint32_t> table(1u << kHashBits);
+
+  size_t pos{};
+  size_t literal_start{};
+  while (size >= kMinMatch && pos <= size - kMinMatch) {
+    uint32_t hash{Hash(src + pos)};
+    size_t candidate{table[hash]};
+    table[hash] = static_cast<uint32_t>(pos + 1);
+    if (candidate == 0 || pos - (candidate - 1) > kMaxOffset
+        || memcmp(src + candidate - 1, src + pos, kMinMatch) != 0) {
+      ++pos;
+      continue;
+    }
+    --candidate;
+    size_t match_length{kMinMatch};
+    while (pos + match_length < size
+           && src[candidate + match_length] == src[pos + match_length]) {
+      ++match_length;
+    }
+    WriteSequence(&out, src + literal_start, pos - literal_start,
+                  pos - candidate, match_length);
+    pos += match_length;
+    literal_start = pos;
+  }
+  WriteSequence(&out, src + literal_start, size - literal_start, 0, 0);
+  return out;
+}
+
+auto SessionSnapshot::Decompress(const std::vector<uint8_t>& snapshot_message,
+                                 std::vector<uint8_t>* commands_message)
+    -> bool {
+  assert(commands_message);
+  if (snapshot_message.size() < kHeaderSize
+      || snapshot_message[0] != BA_MESSAGE_SESSION_SNAPSHOT
+      || snapshot_message[1] < 1
+      || snapshot_message[1] > kSessionSnapshotFormat) {
+    return false;
+  }
+  uint32_t size;
+  memcpy(&size, snapshot_message.data() + 2, sizeof(size));
+  size_t compressed_size{snapshot_message.size() - kHeaderSize};
+  if (size > kMaxSnapshotSize || size > compressed_size * kMaxExpansion) {
+    return false;
+  }
+  auto& out{*commands_message};
+  out.clear();
+  out.reserve(std::min(static_cast<size_t>(size),
+                       compressed_size * kReserveExpansion));
+
+  const uint8_t* ptr{snapshot_message.data() + kHeaderSize};
+  const uint8_t* end{snapshot_message.data() + snapshot_message.size()};
+  bool got_final_sequence{};
+  while (ptr < end) {
+    uint8_t token{*ptr++};
+    size_t literal_count{static_cast<size_t>(token >> 4u)};
+    if (literal_count == 15 && !ReadLength(&ptr, end, &literal_count)) {
+      return false;
+    }
+    if (literal_count > static_cast<size_t>(end - ptr)
+        || out.size() + literal_count > size) {
+      return false;
+    }
+    out.insert(out.end(), ptr, ptr + literal_count);
+    ptr += literal_count;
+
+    // The final sequence has no match.
+    if (ptr == end) {
+      got_final_sequence = true;
+      break;
+    }
+    uint16_t offset;
+    if (static_cast<size_t>(end - ptr) < sizeof(offset)) {
+      return false;
+    }
+    memcpy(&offset, ptr, sizeof(offset));
+    ptr += sizeof(offset);
+    size_t match_length{static_cast<size_t>(token & 15u)};
+    if (match_length == 15 && !ReadLength(&ptr, end, &match_length)) {
+      return false;
+    }
+    match_length += kMinMatch;
+    if (offset == 0 || offset > out.size()
+        || out.size() + match_length > size) {
+      return false;
+    }
+
+    // Matches may overlap what they're producing, so go byte by byte.
+    size_t from{out.size() - offset};
+    for (size_t i = 0; i < match_length; ++i) {
+      out.push_back(out[from + i]);
+    }
+  }
+  return got_final_sequence && out.size() == size && !out.empty()
+         && out[0] == BA_MESSAGE_SESSION_COMMANDS;
+}
+
+}  // namespace ballistica::scene_v1
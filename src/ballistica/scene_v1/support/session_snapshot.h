@@ -0,0 +1,40 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_SCENE_V1_SUPPORT_SESSION_SNAPSHOT_H_
+#define BALLISTICA_SCENE_V1_SUPPORT_SESSION_SNAPSHOT_H_
+
+#include <vector>
+
+#include "ballistica/scene_v1/scene_v1.h"
+
+namespace ballistica::scene_v1 {
+
+/// Newest session-snapshot format we can read or write. Clients advertise
+/// this in their handshake response; hosts only send
+/// BA_MESSAGE_SESSION_SNAPSHOT messages to clients that do.
+const int kSessionSnapshotFormat = 1;
+
+/// Packs the session-commands message that recreates a host-session's full
+/// state (see HostSession::DumpFullState()) into a compressed
+/// BA_MESSAGE_SESSION_SNAPSHOT message and back.
+///
+/// Full-state dumps are long runs of near-identical commands, which the
+/// per-packet huffman pass does little with but an LZ pass over the whole
+/// thing shrinks considerably.
+class SessionSnapshot {
+ public:
+  /// Compress a BA_MESSAGE_SESSION_COMMANDS message into a
+  /// BA_MESSAGE_SESSION_SNAPSHOT message.
+  static auto Compress(const std::vector<uint8_t>& commands_message)
+      -> std::vector<uint8_t>;
+
+  /// Expand a BA_MESSAGE_SESSION_SNAPSHOT message back into the
+  /// BA_MESSAGE_SESSION_COMMANDS message it was made from. Returns false
+  /// for anything malformed.
+  static auto Decompress(const std::vector<uint8_t>& snapshot_message,
+                         std::vector<uint8_t>* commands_message) -> bool;
+};
+
+}  // namespace ballistica::scene_v1
+
+#endif  // BALLISTICA_SCENE_V1_SUPPORT_SESSION_SNAPSHOT_H_
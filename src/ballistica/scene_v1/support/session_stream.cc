@@ -25,6 +25,7 @@
 #include "ballistica/scene_v1/support/host_session.h"
 #include "ballistica/scene_v1/support/replay_writer.h"
 #include "ballistica/scene_v1/support/scene.h"
+#include "ballistica/scene_v1/support/session_snapshot.h"
 
 namespace ballistica::scene_v1 {
 
@@ -385,9 +386,21 @@ void SessionStream::ShipSessionCommandsMessage() {
     AddMessageToReplay(out_message_);
   }
   out_message_.clear();
+
+  // Any snapshot we were holding for joining clients is stale now.
+  InvalidateJoinSnapshot();
   last_send_time_ = g_core->AppTimeMillisecs();
 }
 
+void SessionStream::InvalidateJoinSnapshot() {
+  if (snapshot_valid_) {
+    snapshot_message_ = {};
+    snapshot_message_compressed_ = {};
+    snapshot_corrections_ = {};
+    snapshot_valid_ = false;
+  }
+}
+
 void SessionStream::AddMessageToReplay(const std::vector<uint8_t>& message) {
   assert(writing_replay_);
   assert(g_base->assets_server);
@@ -412,8 +425,10 @@ void SessionStream::AddMessageToReplay(const std::vector<uint8_t>& message) {
 void SessionStream::SendPhysicsCorrection(bool blend) {
   assert(host_session_);
 
+  // Everyone (replays included) gets these, so we can leave out bodies
+  // they've all already seen come to rest.
   std::vector<std::vector<uint8_t> > messages;
-  host_session_->GetCorrectionMessages(blend, &messages);
+  host_session_->GetCorrectionMessages(blend, true, &messages);
 
   // FIXME - have to send reliably at the moment since these will most likely be
   //  bigger than our unreliable packet limit. :-(
@@ -1238,27 +1253,53 @@ void SessionStream::OnClientConnected(ConnectionToClient* c) {
 
     connections_to_clients_.push_back(c);
 
-    // We create a temporary output stream just for the purpose of building
-    // a giant session-commands message to reconstruct everything in our
-    // host-session in its current form.
-    SessionStream out(nullptr, false);
-
-    // Ask the host-session that we came from to dump it's complete state.
-    host_session_->DumpFullState(&out);
+    // Our state only changes when we ship commands, so everyone joining
+    // before the next ship can share the same snapshot (and dumping a big
+    // session is not cheap).
+    if (!snapshot_valid_) {
+      UpdateSnapshot_();
+    }
 
-    // Grab the message that's been built up.
-    // If its not empty, send it to the client.
-    std::vector<uint8_t> out_message = out.GetOutMessage();
-    if (!out_message.empty()) {
-      c->SendReliableMessage(out_message);
+    // Send it to the client; compressed if they can take it and it helps.
+    if (!snapshot_message_.empty()) {
+      if (c->session_snapshot_format() >= 1
+          && snapshot_message_compressed_.empty()) {
+        snapshot_message_compressed_ =
+            SessionSnapshot::Compress(snapshot_message_);
+      }
+      if (c->session_snapshot_format() >= 1
+          && snapshot_message_compressed_.size() < snapshot_message_.size()) {
+        c->SendReliableMessage(snapshot_message_compressed_);
+      } else {
+        c->SendReliableMessage(snapshot_message_);
+      }
     }
 
-    // Also send a correction packet to sync up all our dynamics.
-    // (technically could do this *just* for the new client)
-    SendPhysicsCorrection(false);
+    // Also send a correction packet to sync up all our dynamics. Everyone
+    // else is already in sync so this just goes to the new client.
+    for (auto&& message : snapshot_corrections_) {
+      c->SendReliableMessage(message);
+    }
   }
 }
 
+void SessionStream::UpdateSnapshot_() {
+  assert(host_session_);
+
+  // We create a temporary output stream just for the purpose of building
+  // a giant session-commands message to reconstruct everything in our
+  // host-session in its current form.
+  SessionStream out(nullptr, false);
+
+  // Ask the host-session that we came from to dump it's complete state.
+  host_session_->DumpFullState(&out);
+  snapshot_message_ = out.GetOutMessage();
+  snapshot_message_compressed_.clear();
+  snapshot_corrections_.clear();
+  host_session_->GetCorrectionMessages(false, false, &snapshot_corrections_);
+  snapshot_valid_ = true;
+}
+
 void SessionStream::OnClientDisconnected(ConnectionToClient* c) {
   // Search for it on either our ignored or regular lists.
   for (auto i = connections_to_clients_.begin();
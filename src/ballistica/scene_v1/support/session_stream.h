@@ -82,6 +82,16 @@ class SessionStream : public Object, public ClientControllerInterface {
   void OnClientDisconnected(ConnectionToClient* c) override;
   auto GetOutMessage() const -> std::vector<uint8_t>;
 
+  /// Whether a replay or any clients are being fed from this stream.
+  auto HasAudience() const -> bool {
+    return writing_replay_ || !connections_to_clients_.empty()
+           || !connections_to_clients_ignored_.empty();
+  }
+
+  /// Drop any full-state message held for joining clients; call this when
+  /// host state changes without going through the stream.
+  void InvalidateJoinSnapshot();
+
  private:
   // Make sure various components are part of our stream.
   auto IsValidScene(Scene* val) -> bool;
@@ -129,6 +139,8 @@ class SessionStream : public Object, public ClientControllerInterface {
   template <typename T>
   void Remove(T* val, std::vector<T*>* vec, std::vector<size_t>* free_indices);
 
+  void UpdateSnapshot_();
+
   HostSession* host_session_;
   millisecs_t next_flush_time_{};
 
@@ -137,6 +149,14 @@ class SessionStream : public Object, public ClientControllerInterface {
 
   // The complete message full of commands.
   std::vector<uint8_t> out_message_;
+
+  // Full-state messages for bringing joining clients up to speed; valid
+  // until we next ship commands.
+  std::vector<uint8_t> snapshot_message_;
+  std::vector<uint8_t> snapshot_message_compressed_;
+  std::vector<std::vector<uint8_t>> snapshot_corrections_;
+  bool snapshot_valid_{};
+
   std::vector<ConnectionToClient*> connections_to_clients_;
   std::vector<ConnectionToClient*> connections_to_clients_ignored_;
   classic::ClassicAppMode* app_mode_;
@@ -0,0 +1,135 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/scene_v1/support/state_hasher.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ballistica/scene_v1/dynamics/part.h"
+#include "ballistica/scene_v1/dynamics/rigid_body.h"
+#include "ballistica/scene_v1/node/node.h"
+#include "ballistica/scene_v1/node/node_attribute.h"
+#include "ballistica/scene_v1/node/node_type.h"
+#include "ballistica/scene_v1/support/scene.h"
+
+namespace ballistica::scene_v1 {
+
+const uint64_t kFNVPrime{1099511628211ULL};
+
+void StateHasher::Add(const void* data, size_t size) {
+  auto* bytes{static_cast<const uint8_t*>(data)};
+  for (size_t i = 0; i < size; ++i) {
+    hash_ = (hash_ ^ bytes[i]) * kFNVPrime;
+  }
+}
+
+void StateHasher::AddNode(Node* node) {
+  assert(node);
+  Add(node->id());
+  Add(node->type()->id());
+  for (NodeAttributeUnbound* attr : node->type()->attributes_by_index()) {
+    // Some getters throw when a node isn't set up to provide a value; that
+    // is just as deterministic as anything else so we hash a marker.
+    try {
+      switch (attr->type()) {
+        case NodeAttributeType::kFloat:
+          Add(attr->GetAsFloat(node));
+          break;
+        case NodeAttributeType::kInt:
+          Add(attr->GetAsInt(node));
+          break;
+        case NodeAttributeType::kBool:
+          Add(attr->GetAsBool(node));
+          break;
+        case NodeAttributeType::kString: {
+          auto val{attr->GetAsString(node)};
+          Add(val.data(), val.size());
+          break;
+        }
+        case NodeAttributeType::kFloatArray: {
+          auto vals{attr->GetAsFloats(node)};
+          Add(vals.size());
+          Add(vals.data(), vals.size() * sizeof(float));
+          break;
+        }
+        case NodeAttributeType::kIntArray: {
+          auto vals{attr->GetAsInts(node)};
+          Add(vals.size());
+          Add(vals.data(), vals.size() * sizeof(int64_t));
+          break;
+        }
+        case NodeAttributeType::kNode: {
+          Node* val{attr->GetAsNode(node)};
+          Add(val ? val->id() : int64_t{-1});
+          break;
+        }
+        case NodeAttributeType::kNodeArray: {
+          auto vals{attr->GetAsNodes(node)};
+          Add(vals.size());
+          for (Node* val : vals) {
+            Add(val ? val->id() : int64_t{-1});
+          }
+          break;
+        }
+        default:
+          break;
+      }
+    } catch (const std::exception&) {
+      Add(attr->index());
+    }
+  }
+  for (Part* part : node->parts()) {
+    for (RigidBody* body : part->rigid_bodies()) {
+      AddRigidBody(body);
+    }
+  }
+}
+
+void StateHasher::AddRigidBody(RigidBody* body) {
+  assert(body);
+  Add(body->id());
+  dBodyID b{body->body()};
+  if (!b) {
+    return;  // Geom-only; these are positioned by their node's attrs.
+  }
+  AddBodyState(b);
+}
+
+void StateHasher::AddBodyState(dBodyID body) {
+  assert(body);
+  Add(dBodyGetPosition(body), sizeof(dReal) * 3);
+  Add(dBodyGetQuaternion(body), sizeof(dReal) * 4);
+  Add(dBodyGetLinearVel(body), sizeof(dReal) * 3);
+  Add(dBodyGetAngularVel(body), sizeof(dReal) * 3);
+}
+
+auto StateHasher::HashNode(Node* node) -> uint64_t {
+  StateHasher hasher;
+  hasher.AddNode(node);
+  return hasher.hash();
+}
+
+auto StateHasher::HashScene(
+    Scene* scene, std::vector<std::pair<int64_t, uint64_t>>* node_hashes)
+    -> uint64_t {
+  assert(scene);
+  StateHasher hasher;
+  hasher.Add(scene->time());
+  hasher.Add(scene->stepnum());
+  hasher.Add(scene->nodes().size());
+  if (node_hashes) {
+    node_hashes->clear();
+    node_hashes->reserve(scene->nodes().size());
+  }
+  for (auto&& node : scene->nodes()) {
+    uint64_t node_hash{HashNode(node.get())};
+    hasher.Add(node_hash);
+    if (node_hashes) {
+      node_hashes->emplace_back(node->id(), node_hash);
+    }
+  }
+  return hasher.hash();
+}
+
+}  // namespace ballistica::scene_v1
@@ -0,0 +1,68 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_SCENE_V1_SUPPORT_STATE_HASHER_H_
+#define BALLISTICA_SCENE_V1_SUPPORT_STATE_HASHER_H_
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "ballistica/scene_v1/scene_v1.h"
+#include "ode/ode_objects.h"
+
+namespace ballistica::scene_v1 {
+
+/// Builds a 64 bit hash (FNV-1a) of simulation state for checking that two
+/// runs given the same inputs stay bit-for-bit in lockstep.
+///
+/// Nodes contribute their id, type, and the values of their plain data
+/// attrs (floats, ints, bools, strings and arrays of those, plus the ids
+/// of nodes they reference); assets and materials are left out. Rigid
+/// bodies contribute their position, orientation and velocities.
+class StateHasher {
+ public:
+  void Add(const void* data, size_t size);
+  template <typename T>
+  void Add(const T& val) {
+    Add(&val, sizeof(val));
+  }
+  void AddNode(Node* node);
+  void AddRigidBody(RigidBody* body);
+
+  /// Add an ODE body's position, orientation and velocities.
+  void AddBodyState(dBodyID body);
+  auto hash() const -> uint64_t { return hash_; }
+
+  static auto HashNode(Node* node) -> uint64_t;
+
+  /// Hash a scene's time and all of its nodes. If `node_hashes` is passed,
+  /// it is filled with each node's id and individual hash.
+  static auto HashScene(
+      Scene* scene,
+      std::vector<std::pair<int64_t, uint64_t>>* node_hashes = nullptr)
+      -> uint64_t;
+
+ private:
+  uint64_t hash_{14695981039346656037ULL};
+};
+
+/// Hashes recorded for a scene as it steps (see Scene::BeginStateHashLog).
+struct StateHashLog {
+  struct Step {
+    int64_t stepnum{};
+    uint64_t hash{};
+    std::vector<std::pair<int64_t, uint64_t>> node_hashes;
+  };
+  bool per_node{};
+  std::vector<Step> steps;
+
+  /// Descriptions of nodes by id as of when they were first hashed, so
+  /// divergences can be reported on nodes that have since died.
+  std::unordered_map<int64_t, std::string> node_descriptions;
+};
+
+}  // namespace ballistica::scene_v1
+
+#endif  // BALLISTICA_SCENE_V1_SUPPORT_STATE_HASHER_H_
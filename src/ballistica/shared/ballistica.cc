@@ -9,6 +9,7 @@
 #include "ballistica/core/platform/support/min_sdl.h"
 #include "ballistica/core/python/core_python.h"
 #include "ballistica/core/support/base_soft.h"
+#include "ballistica/core/support/startup_timeline.h"
 #include "ballistica/shared/foundation/fatal_error.h"
 #include "ballistica/shared/python/python.h"
 #include "ballistica/shared/python/python_command.h"
@@ -53,7 +54,7 @@ auto MonolithicMain(const core::CoreConfig& core_config) -> int {
   core::BaseSoftInterface* l_base{};
 
   try {
-    auto time1 = core::CorePlatform::TimeMonotonicMillisecs();
+    auto time1 = core::CorePlatform::TimeMonotonicMicrosecs();
 
     // Even at the absolute start of execution we should be able to
     // reasonably log errors. Set env var BA_CRASH_TEST=1 to test this.
@@ -68,7 +69,7 @@ auto MonolithicMain(const core::CoreConfig& core_config) -> int {
     // import it first thing even if we don't explicitly use it.
     l_core = core::CoreFeatureSet::Import(&core_config);
 
-    auto time2 = core::CorePlatform::TimeMonotonicMillisecs();
+    auto time2 = core::CorePlatform::TimeMonotonicMicrosecs();
 
     // If a command was passed, simply run it and exit. We want to act
     // simply as a Python interpreter in that case; we don't do any
@@ -103,7 +104,7 @@ auto MonolithicMain(const core::CoreConfig& core_config) -> int {
     // those modules get loaded from in the first place.
     l_core->python->MonolithicModeBaEnvConfigure();
 
-    auto time3 = core::CorePlatform::TimeMonotonicMillisecs();
+    auto time3 = core::CorePlatform::TimeMonotonicMicrosecs();
 
     // We need the base feature-set to run a full app but we don't have a hard
     // dependency to it. Let's see if it's available.
@@ -112,7 +113,27 @@ auto MonolithicMain(const core::CoreConfig& core_config) -> int {
       FatalError("Base module unavailable; can't run app.");
     }
 
-    auto time4 = core::CorePlatform::TimeMonotonicMillisecs();
+    auto time4 = core::CorePlatform::TimeMonotonicMicrosecs();
+
+    // In prefork mode, everything up to this point happens once in the
+    // parent; we now sit around forking workers which continue on from
+    // here with fresh threads and app state. We have to fork before
+    // StartApp() since only the forking thread survives into the child.
+    bool prefork_worker{};
+    if (l_core->core_config().prefork_control_path.has_value()) {
+      if (!l_core->python->MonolithicModePreforkServe()) {
+        // We're the parent and have been told to stop.
+        l_core->set_engine_done();
+        l_core->python->FinalizePython();
+        return 0;
+      }
+      prefork_worker = true;
+
+      // As far as this worker is concerned, startup begins now.
+      l_core->startup_timeline->Restart();
+      time1 = time2 = time3 = time4 =
+          core::CorePlatform::TimeMonotonicMicrosecs();
+    }
 
     // -------------------------------------------------------------------------
     // Phase 2: "The pieces are moving."
@@ -130,14 +151,22 @@ auto MonolithicMain(const core::CoreConfig& core_config) -> int {
     // until the app exits (or we return from this function and let the
     // environment do that part).
 
+    // Record our top level phases in the startup timeline.
+    auto time5 = core::CorePlatform::TimeMonotonicMicrosecs();
+    if (!prefork_worker) {
+      l_core->startup_timeline->AddPhase("core-import", time1, time2);
+      l_core->startup_timeline->AddPhase("baenv-configure", time2, time3);
+      l_core->startup_timeline->AddPhase("base-import", time3, time4);
+    }
+    l_core->startup_timeline->AddPhase("start-app", time4, time5);
+
     // Make noise if it takes us too long to get to this point.
-    auto time5 = core::CorePlatform::TimeMonotonicMillisecs();
-    auto total_duration = time5 - time1;
+    auto total_duration = (time5 - time1) / 1000;
     if (total_duration > 5000) {
-      auto core_import_duration = time2 - time1;
-      auto env_config_duration = time3 - time2;
-      auto base_import_duration = time4 - time3;
-      auto start_app_duration = time5 - time4;
+      auto core_import_duration = (time2 - time1) / 1000;
+      auto env_config_duration = (time3 - time2) / 1000;
+      auto base_import_duration = (time4 - time3) / 1000;
+      auto start_app_duration = (time5 - time4) / 1000;
       core::g_core->logging->Log(LogName::kBa, LogLevel::kWarning, [=] {
         return "MonolithicMain took too long (" + std::to_string(total_duration)
                + " ms; " + std::to_string(core_import_duration)
@@ -219,26 +248,39 @@ class IncrementalInitRunner_ {
     }
     try {
       switch (step_) {
-        case 0:
+        case 0: {
+          auto start_time = core::CorePlatform::TimeMonotonicMicrosecs();
           core_ = core::CoreFeatureSet::Import(&config_);
+          core_->startup_timeline->AddPhase(
+              "core-import", start_time,
+              core::CorePlatform::TimeMonotonicMicrosecs());
           step_++;
           return false;
-        case 1:
+        }
+        case 1: {
+          core::StartupTimeline::ScopedPhase phase("baenv-configure");
           core_->python->MonolithicModeBaEnvConfigure();
           step_++;
           return false;
-        case 2:
+        }
+        case 2: {
+          core::StartupTimeline::ScopedPhase phase("base-import");
           base_ = core_->SoftImportBase();
           if (!base_) {
             FatalError("Base module unavailable; can't run app.");
           }
           step_++;
           return false;
-        case 3:
-          base_->StartApp();
+        }
+        case 3: {
+          {
+            core::StartupTimeline::ScopedPhase phase("start-app");
+            base_->StartApp();
+          }
           Python::PermanentlyReleaseGIL();
           step_++;
           return false;
+        }
         default:
           return true;
       }
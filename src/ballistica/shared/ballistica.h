@@ -449,6 +449,7 @@ const int kDefaultPort = 43210;
 
 // Magic numbers at the start of our file types.
 const int kBobFileID = 45623;
+const int kBobAlignedFileID = 45624;
 const int kCobFileID = 13466;
 
 const float kPi = 3.1415926535897932384626433832795028841971693993751f;
@@ -2,6 +2,8 @@
 
 #include "ballistica/shared/generic/timer_list.h"
 
+#include <vector>
+
 #include "ballistica/core/core.h"
 #include "ballistica/core/logging/logging.h"
 #include "ballistica/shared/generic/runnable.h"
@@ -104,6 +106,33 @@ auto TimerList::PullTimer(int timer_id, bool remove) -> Timer* {
   return nullptr;
 }
 
+auto TimerList::GetTimerStates() const -> std::vector<TimerState> {
+  std::vector<TimerState> states;
+  states.reserve(timer_count_active_ + timer_count_inactive_);
+  for (Timer* list : {timers_, timers_inactive_}) {
+    for (Timer* t = list; t; t = t->next_) {
+      states.push_back({t->id_, t->last_run_time_, t->expire_time_,
+                        t->length_, t->repeat_count_, t->initial_});
+    }
+  }
+  return states;
+}
+
+auto TimerList::RestoreTimerState(const TimerState& state) -> bool {
+  Timer* t = PullTimer(state.id, false);
+  if (t == nullptr || !t->on_list_ || t->dead_) {
+    return false;
+  }
+  PullTimer(state.id);
+  t->last_run_time_ = state.last_run_time;
+  t->expire_time_ = state.expire_time;
+  t->length_ = state.length;
+  t->repeat_count_ = state.repeat_count;
+  t->initial_ = state.initial;
+  AddTimer(t);
+  return true;
+}
+
 void TimerList::Run(TimerMedium target_time) {
   assert(!are_clearing_);
 
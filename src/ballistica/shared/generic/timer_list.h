@@ -13,6 +13,17 @@ namespace ballistica {
 
 class TimerList {
  public:
+  // Scheduling state of a timer; lets timers be rolled back along with
+  // whatever they drive.
+  struct TimerState {
+    int id{};
+    TimerMedium last_run_time{};
+    TimerMedium expire_time{};
+    TimerMedium length{};
+    int repeat_count{};
+    bool initial{};
+  };
+
   TimerList();
   ~TimerList();
 
@@ -43,6 +54,14 @@ class TimerList {
 
   void Clear();
 
+  // Return the states of all queued timers (not including one that is
+  // currently running).
+  auto GetTimerStates() const -> std::vector<TimerState>;
+
+  // Put a queued timer back to a saved state. Returns false if the timer
+  // no longer exists or is currently running.
+  auto RestoreTimerState(const TimerState& state) -> bool;
+
  private:
   // Returns the next expired timer. When finished with the timer,
   // return it to the list with Timer::submit()
@@ -974,23 +974,8 @@ int dCollideCylinderTrimesh(dxGeom *o1, dxGeom *o2, int flags, dContactGeom *con
 	// TC results
 	if (cData.gTrimesh->doBoxTC)
 	{
-		dxTriMesh::BoxTC* BoxTC = 0;
-		for (int i = 0; i < cData.gTrimesh->BoxTCCache.size(); i++)
-		{
-			if (cData.gTrimesh->BoxTCCache[i].Geom == cData.gCylinder)
-			{
-				BoxTC = &cData.gTrimesh->BoxTCCache[i];
-				break;
-			}
-		}
-		if (!BoxTC)
-		{
-			cData.gTrimesh->BoxTCCache.push(dxTriMesh::BoxTC());
-
-			BoxTC = &cData.gTrimesh->BoxTCCache[cData.gTrimesh->BoxTCCache.size() - 1];
-			BoxTC->Geom = cData.gCylinder;
-			BoxTC->FatCoeff = REAL(1.0);
-		}
+		dxTriMesh::BoxTC* BoxTC =
+			cData.gTrimesh->GetBoxTC(cData.gCylinder, REAL(1.0));
 
 		// Intersect
 		Collider.SetTemporalCoherence(true);
@@ -319,25 +319,26 @@ dxTriMesh::~dxTriMesh(){
 
 
 void dxTriMesh::ClearTCCache(){
-  /* dxTriMesh::ClearTCCache uses dArray's setSize(0) to clear the caches -
-     but the destructor isn't called when doing this, so we would leak.
-     So, call the previous caches' containers' destructors by hand first. */
-	int i, n;
-	n = SphereTCCache.size();
-	for( i = 0; i < n; ++i ) {
-	  SphereTCCache[i].~SphereTC();
-	}
-	SphereTCCache.setSize(0);
-	n = BoxTCCache.size();
-	for( i = 0; i < n; ++i ) {
-	  BoxTCCache[i].~BoxTC();
+	SphereTCCache.clear();
+	BoxTCCache.clear();
+	CCylinderTCCache.clear();
+}
+
+dxTriMesh::SphereTC* dxTriMesh::GetSphereTC(dxGeom* geom){
+	auto result = SphereTCCache.try_emplace(geom);
+	if (result.second){
+		result.first->second.Geom = geom;
 	}
-	BoxTCCache.setSize(0);
-	n = CCylinderTCCache.size();
-	for( i = 0; i < n; ++i ) {
-	  CCylinderTCCache[i].~CCylinderTC();
+	return &result.first->second;
+}
+
+dxTriMesh::BoxTC* dxTriMesh::GetBoxTC(dxGeom* geom, float fatCoeff){
+	auto result = BoxTCCache.try_emplace(geom);
+	if (result.second){
+		result.first->second.Geom = geom;
+		result.first->second.FatCoeff = fatCoeff;
 	}
-	CCylinderTCCache.setSize(0);
+	return &result.first->second;
 }
 
 
@@ -481,6 +482,15 @@ void dGeomTriMeshClearTCCache(dGeomID g){
 	Geom->ClearTCCache();
 }
 
+void dGeomTriMeshClearTCCacheForGeom(dGeomID g, dGeomID geom){
+	dUASSERT(g && g->type == dTriMeshClass, "argument not a trimesh");
+
+	dxTriMesh* Geom = (dxTriMesh*)g;
+	Geom->SphereTCCache.erase(geom);
+	Geom->BoxTCCache.erase(geom);
+	Geom->CCylinderTCCache.erase(geom);
+}
+
 void dGeomTriMeshSetForceNormalMode(dGeomID g, int enable){
 	dUASSERT(g && g->type == dTriMeshClass, "argument not a trimesh");
 
@@ -137,6 +137,13 @@ int dGeomTriMeshIsTCEnabled(dGeomID g, int geomClass);
  */
 void dGeomTriMeshClearTCCache(dGeomID g);
 
+/*
+ * Removes just the temporal coherence entries held for one geom. Call
+ * this before destroying or resizing a geom that has been collided
+ * against the trimesh with temporal coherence enabled.
+ */
+void dGeomTriMeshClearTCCacheForGeom(dGeomID g, dGeomID geom);
+
 
 /*
  * sets the trimesh to "force-normal" mode in which its normals are always used
@@ -1222,20 +1222,8 @@ int dCollideBTL(dxGeom* g1, dxGeom* BoxGeom, int Flags, dContactGeom* Contacts,
 
   // TC results
   if (TriMesh->doBoxTC) {
-	dxTriMesh::BoxTC* BoxTC = 0;
-	for (int i = 0; i < TriMesh->BoxTCCache.size(); i++){
-		if (TriMesh->BoxTCCache[i].Geom == BoxGeom){
-			BoxTC = &TriMesh->BoxTCCache[i];
-			break;
-		}
-	}
-	if (!BoxTC){
-		TriMesh->BoxTCCache.push(dxTriMesh::BoxTC());
-
-		BoxTC = &TriMesh->BoxTCCache[TriMesh->BoxTCCache.size() - 1];
-		BoxTC->Geom = BoxGeom;
-    BoxTC->FatCoeff = 1.1f; // Pierre recommends this, instead of 1.0
-	}
+	// Pierre recommends 1.1 for the fat coefficient, instead of 1.0
+	dxTriMesh::BoxTC* BoxTC = TriMesh->GetBoxTC(BoxGeom, 1.1f);
 
 	// Intersect
 	Collider.SetTemporalCoherence(true);
@@ -942,20 +942,7 @@ int dCollideCCTL(dxGeom *o1, dxGeom *o2, int flags, dContactGeom *contact, int s
 
 	 // TC results
 	 if (TriMesh->doBoxTC) {
-		 dxTriMesh::BoxTC* BoxTC = 0;
-		 for (int i = 0; i < TriMesh->BoxTCCache.size(); i++){
-			 if (TriMesh->BoxTCCache[i].Geom == gCylinder){
-				 BoxTC = &TriMesh->BoxTCCache[i];
-				 break;
-			 }
-		 }
-		 if (!BoxTC){
-			 TriMesh->BoxTCCache.push(dxTriMesh::BoxTC());
-
-			 BoxTC = &TriMesh->BoxTCCache[TriMesh->BoxTCCache.size() - 1];
-			 BoxTC->Geom = gCylinder;
-			 BoxTC->FatCoeff = 1.0f;
-		 }
+		 dxTriMesh::BoxTC* BoxTC = TriMesh->GetBoxTC(gCylinder, 1.0f);
 
 		 // Intersect
 		 Collider.SetTemporalCoherence(true);
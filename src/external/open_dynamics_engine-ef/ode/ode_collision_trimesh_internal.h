@@ -40,6 +40,8 @@ int dCollideTPL(dxGeom *o1, dxGeom *o2, int flags, dContactGeom *contact, int sk
 
 #ifdef TRIMESH_INTERNAL
 
+#include <unordered_map>
+
 #include "ode/ode_collision_kernel.h"
 #include "ode/ode_collision_trimesh.h"
 
@@ -98,17 +100,18 @@ struct dxTriMesh : public dxGeom{
 	// Some constants
 	static CollisionFaces* Faces;
 
-	// Temporal coherence
+	// Temporal coherence. Caches are keyed by geom so finding a geom's
+	// entry doesn't mean scanning every other geom's on each collide.
 	struct SphereTC : public SphereCache{
 		dxGeom* Geom;
 	};
-	dArray<SphereTC> SphereTCCache;
+	std::unordered_map<dxGeom*, SphereTC> SphereTCCache;
 	static SphereCache* defaultSphereCache;
 
 	struct BoxTC : public OBBCache{
 		dxGeom* Geom;
 	};
-	dArray<BoxTC> BoxTCCache;
+	std::unordered_map<dxGeom*, BoxTC> BoxTCCache;
 
     // ericf change - we keep one of these per trimesh
     // so we can multithread..
@@ -118,7 +121,7 @@ struct dxTriMesh : public dxGeom{
 	struct CCylinderTC : public LSSCache{
 		dxGeom* Geom;
 	};
-	dArray<CCylinderTC> CCylinderTCCache;
+	std::unordered_map<dxGeom*, CCylinderTC> CCylinderTCCache;
 	static LSSCache* defaultCCylinderCache;
 
 	bool doSphereTC;
@@ -132,6 +135,11 @@ struct dxTriMesh : public dxGeom{
 
 	void ClearTCCache();
 
+	// Return a geom's temporal coherence entry, creating it if need be
+	// (box entries start out with the given fat coefficient).
+	SphereTC* GetSphereTC(dxGeom* geom);
+	BoxTC* GetBoxTC(dxGeom* geom, float fatCoeff);
+
 	void setForceNormalMode(int f) {forceNormalMode=f;}
 
 	int AABBTest(dxGeom* g, dReal aabb[6]);
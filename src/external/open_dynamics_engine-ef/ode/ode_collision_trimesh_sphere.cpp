@@ -297,20 +297,7 @@ int dCollideSTL(dxGeom* g1, dxGeom* SphereGeom, int Flags, dContactGeom* Contact
 
 	// TC results
 	if (TriMesh->doSphereTC) {
-		dxTriMesh::SphereTC* sphereTC = 0;
-		for (int i = 0; i < TriMesh->SphereTCCache.size(); i++){
-			if (TriMesh->SphereTCCache[i].Geom == SphereGeom){
-				sphereTC = &TriMesh->SphereTCCache[i];
-				break;
-			}
-		}
-
-		if (!sphereTC){
-			TriMesh->SphereTCCache.push(dxTriMesh::SphereTC());
-
-			sphereTC = &TriMesh->SphereTCCache[TriMesh->SphereTCCache.size() - 1];
-			sphereTC->Geom = SphereGeom;
-		}
+		dxTriMesh::SphereTC* sphereTC = TriMesh->GetSphereTC(SphereGeom);
 
 		// Intersect
 		Collider.SetTemporalCoherence(true);
@@ -10,7 +10,7 @@ from typing import TYPE_CHECKING
 import sys
 
 if TYPE_CHECKING:
-    from typing import Callable
+    from typing import Callable, Any
 
     import baenv
 
@@ -57,6 +57,120 @@ def import_baenv_and_run_configure(
         return traceback.format_exc()
 
 
+class _PythonBundleImporter:
+    """Serves imports out of a precompiled Python bundle.
+
+    Lookups and unmarshalling happen natively against a memory-mapped
+    file. The only filesystem access per module is a stat of its source
+    file; any module whose source no longer matches the mtime and size
+    recorded in the bundle is left to regular imports so edits to
+    scripts are never silently shadowed by stale bundled code. Specs
+    still point at the regular source locations so tracebacks,
+    package data lookups, and non-bundled submodules work as usual.
+    """
+
+    # baenv looks for this to remove us when using a custom app-python-dir.
+    ba_python_bundle = True
+
+    def __init__(
+        self,
+        app_python_dir: str,
+        find: Callable[[str], tuple[bool, str, int, int] | None],
+        get_code: Callable[[str], Any],
+    ) -> None:
+        self._app_python_dir = app_python_dir
+        self._find = find
+        self._get_code = get_code
+
+    def find_spec(
+        self, fullname: str, path: Any = None, target: Any = None
+    ) -> Any:
+        """Return a spec for a bundled module (or None)."""
+        import os
+        from importlib.machinery import ModuleSpec
+
+        del path, target  # Unused.
+        info = self._find(fullname)
+        if info is None:
+            return None
+        is_package, relpath, source_mtime, source_size = info
+        origin = self._origin(relpath)
+        try:
+            stat = os.stat(origin)
+        except OSError:
+            return None
+        if (int(stat.st_mtime) & 0xFFFFFFFF, stat.st_size & 0xFFFFFFFF) != (
+            source_mtime,
+            source_size,
+        ):
+            return None
+        spec = ModuleSpec(fullname, self, origin=origin, is_package=is_package)
+        spec.has_location = True
+        if is_package:
+            spec.submodule_search_locations = [os.path.dirname(origin)]
+        return spec
+
+    def create_module(self, spec: Any) -> None:
+        """Use default module creation."""
+        del spec  # Unused.
+
+    def exec_module(self, module: Any) -> None:
+        """Run a bundled module's code."""
+        # pylint: disable=exec-used
+        exec(self.get_code(module.__spec__.name), module.__dict__)
+
+    def get_code(self, fullname: str) -> Any:
+        """Return the code object for a bundled module."""
+        import _imp
+
+        info = self._find(fullname)
+        if info is None:
+            raise ImportError(f'{fullname!r} is not in the Python bundle.')
+        code = self._get_code(fullname)
+
+        # Point tracebacks at the real source location.
+        # pylint: disable=protected-access
+        _imp._fix_co_filename(code, self._origin(info[1]))
+        return code
+
+    def _origin(self, relpath: str) -> str:
+        import os
+
+        return os.path.join(self._app_python_dir, *relpath.split('/'))
+
+
+def install_python_bundle(
+    app_python_dir: str,
+    find: Callable[[str], tuple[bool, str, int, int] | None],
+    get_code: Callable[[str], Any],
+) -> None:
+    """Add a bundle importer ahead of regular path-based imports."""
+    from importlib.machinery import PathFinder
+
+    importer = _PythonBundleImporter(app_python_dir, find, get_code)
+    index = next(
+        (i for i, f in enumerate(sys.meta_path) if f is PathFinder),
+        len(sys.meta_path),
+    )
+    sys.meta_path.insert(index, importer)
+
+
+def run_prefork_server(control_path: str) -> bool | str:
+    """Run as a prefork parent until told to stop.
+
+    Returns True in forked workers and False in the parent once done. On
+    failure, attempts to return an error traceback as a string.
+    """
+    try:
+        from babase._prefork import serve
+
+        return serve(control_path)
+    except Exception:
+        import traceback
+
+        return traceback.format_exc()
+
+
 def get_env_config() -> baenv.EnvConfig:
     """Import baenv and get the config."""
     import baenv
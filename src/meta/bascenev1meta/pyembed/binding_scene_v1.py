@@ -11,6 +11,7 @@ from bascenev1._dependency import AssetPackage
 from bascenev1._activity import Activity
 from bascenev1._session import Session
 from bascenev1._net import HostInfo
+from bascenev1._collision import CollisionEvent, BatchedMessage
 import _bascenev1
 
 # The C++ layer looks for this variable:
@@ -19,6 +20,7 @@ values = [
     _hooks.get_player_icon,  # kGetPlayerIconCall
     _hooks.filter_chat_message,  # kFilterChatMessageCall
     _hooks.local_chat_message,  # kHandleLocalChatMessageCall
+    _hooks.client_over_limits,  # kClientOverLimitsCall
     _bascenev1.client_info_query_response,  # kClientInfoQueryResponseCall
     _messages.ShouldShatterMessage,  # kShouldShatterMessageClass
     _messages.ImpactDamageMessage,  # kImpactDamageMessageClass
@@ -32,4 +34,6 @@ values = [
     Activity,  # kActivityClass
     Session,  # kSceneV1SessionClass
     HostInfo,  # kHostInfoClass
+    CollisionEvent,  # kCollisionEventClass
+    BatchedMessage,  # kBatchedMessageClass
 ]
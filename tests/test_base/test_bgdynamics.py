@@ -0,0 +1,92 @@
+# Released under the MIT License. See LICENSE for details.
+#
+"""Testing bg-dynamics budgeting."""
+
+from __future__ import annotations
+
+import os
+import pytest
+
+from batools import apprun
+
+FAST_MODE = os.environ.get('BA_TEST_FAST_MODE') == '1'
+
+# Runs inside the (headless) app; there are no bg-dynamics there so we
+# should get None, but stats should come back sane if that ever changes.
+_TEST_CMD = """
+import _babase
+stats = _babase.bg_dynamics_stats(reset=True)
+if stats is not None:
+    assert set(stats) == {'load_scale', 'requested', 'created'}, stats
+    assert 0.0 < stats['load_scale'] <= 1.0, stats
+    stats = _babase.bg_dynamics_stats()
+    assert stats['created'] <= stats['requested'], stats
+"""
+
+
+# Runs inside the app; checks emission scaling math on fresh budgets. This
+# doesn't need actual bg-dynamics so it works in headless builds too.
+_BUDGET_TEST_CMD = """
+import _bascenev1
+sim = _bascenev1.bg_dynamics_budget_simulate
+near = (100, (0.0, 0.0, 0.0), 1.0, (0.0, 0.0, 10.0))
+mid = (100, (0.0, 0.0, 0.0), 1.0, (0.0, 0.0, 100.0))
+far = (100, (0.0, 0.0, 0.0), 1.0, (0.0, 0.0, 1000.0))
+
+# Unloaded, near emissions come through whole and far ones get cut down
+# to the minimum distance scale.
+scale, counts = sim([], [near, mid, far])
+assert scale == 1.0, scale
+assert counts[0] == 100, counts
+assert counts[1] in (33, 34), counts
+assert counts[2] == 25, counts
+
+# Rounding is deterministic; identical emissions come out identical.
+_, counts2 = sim([], [near, mid, far])
+assert counts2 == counts, (counts, counts2)
+
+# ..but averages out to the right amount across varied emissions.
+_, counts = sim(
+    [], [(1, ((i % 50) * 0.01, (i // 50) * 0.01, 0.0), 1.0, (0.0, 0.0, 100.0))
+         for i in range(3000)])
+assert 900 < sum(counts) < 1100, sum(counts)
+
+# Steps running over half their interval cut us back to the minimum load
+# scale, and one cheap step afterwards isn't enough to undo that.
+slow = [(0.008, 0.01, False)] * 30
+scale, counts = sim(slow, [near])
+assert abs(scale - 0.2) < 0.001, scale
+assert counts == [20], counts
+scale, _ = sim(slow + [(0.0, 0.01, False)], [])
+assert abs(scale - 0.2) < 0.001, scale
+
+# A run of cheap steps brings us all the way back.
+scale, counts = sim(slow + [(0.0, 0.01, False)] * 200, [near])
+assert scale == 1.0 and counts == [100], (scale, counts)
+
+# Slow frames cut us back even when steps themselves are cheap.
+scale, _ = sim([(0.0, 0.01, True)] * 30, [])
+assert abs(scale - 0.2) < 0.001, scale
+"""
+
+
+@pytest.mark.skipif(
+    apprun.test_runs_disabled(), reason=apprun.test_runs_disabled_reason()
+)
+@pytest.mark.skipif(FAST_MODE, reason='fast mode')
+def test_bg_dynamics_stats() -> None:
+    """Make sure bg-dynamics stats are available."""
+    apprun.python_command(_TEST_CMD, purpose='bg-dynamics testing')
+
+
+@pytest.mark.skipif(
+    apprun.test_runs_disabled(), reason=apprun.test_runs_disabled_reason()
+)
+@pytest.mark.skipif(
+    apprun.test_bindings_disabled(),
+    reason=apprun.test_bindings_disabled_reason(),
+)
+@pytest.mark.skipif(FAST_MODE, reason='fast mode')
+def test_bg_dynamics_budget() -> None:
+    """Make sure bg-dynamics emissions get scaled sensibly."""
+    apprun.python_command(_BUDGET_TEST_CMD, purpose='bg-dynamics testing')
@@ -0,0 +1,77 @@
+# Released under the MIT License. See LICENSE for details.
+#
+"""Testing frame pacing functionality."""
+
+from __future__ import annotations
+
+import os
+import pytest
+
+from batools import apprun
+
+FAST_MODE = os.environ.get('BA_TEST_FAST_MODE') == '1'
+
+# Runs inside the app against a synthetic vsync clock and checks the
+# resulting latencies against what the pacing math says they should be.
+_TEST_CMD = """
+import _bascenev1
+
+# Light load at 60hz with no jitter. Unpaced, each frame is built right
+# as the previous one is picked up so it sits around for a full extra
+# refresh. Paced, builds start just early enough to finish (plus margin)
+# before they're needed; only the first frame goes out unpaced.
+interval = 1000000 // 60 / 1000.0
+margin = max(1.0, 1000000 // 60 // 8 / 1000.0)
+unpaced = _bascenev1.frame_pacing_simulate(60.0, 2.0, 4.0, paced=False)
+paced = _bascenev1.frame_pacing_simulate(60.0, 2.0, 4.0, paced=True)
+assert unpaced['missed'] == 0 and paced['missed'] == 0, (unpaced, paced)
+assert abs(unpaced['mean_latency_ms'] - 2.0 * interval) < 0.01, unpaced
+expected = (2.0 * interval + 598 * (interval + 2.0 + margin)) / 599
+assert abs(paced['mean_latency_ms'] - expected) < 0.01, (paced, expected)
+
+# When builds take longer than a refresh there's nothing to gain by
+# waiting, so pacing must build immediately and behave identically.
+unpaced = _bascenev1.frame_pacing_simulate(60.0, 20.0, 4.0, paced=False)
+paced = _bascenev1.frame_pacing_simulate(60.0, 20.0, 4.0, paced=True)
+assert paced == unpaced, (paced, unpaced)
+assert unpaced['missed'] > 480, unpaced
+
+# With jitter, pacing still has to win on latency without extra misses.
+for hz, build, render, jitter in [
+    (60.0, 2.0, 4.0, 1.0),
+    (120.0, 3.0, 5.0, 2.0),
+    (60.0, 12.0, 10.0, 2.0),
+]:
+    unpaced = _bascenev1.frame_pacing_simulate(
+        hz, build, render, paced=False, jitter_ms=jitter
+    )
+    paced = _bascenev1.frame_pacing_simulate(
+        hz, build, render, paced=True, jitter_ms=jitter
+    )
+    assert paced['missed'] <= unpaced['missed'], (paced, unpaced)
+    assert paced['mean_latency_ms'] < unpaced['mean_latency_ms'], (
+        paced,
+        unpaced,
+    )
+
+for args in ((0.0, 2.0, 4.0), (60.0, -1.0, 4.0)):
+    try:
+        _bascenev1.frame_pacing_simulate(*args)
+    except ValueError:
+        pass
+    else:
+        raise RuntimeError(f'Expected ValueError for {args}.')
+"""
+
+
+@pytest.mark.skipif(
+    apprun.test_runs_disabled(), reason=apprun.test_runs_disabled_reason()
+)
+@pytest.mark.skipif(
+    apprun.test_bindings_disabled(),
+    reason=apprun.test_bindings_disabled_reason(),
+)
+@pytest.mark.skipif(FAST_MODE, reason='fast mode')
+def test_frame_pacing_simulation() -> None:
+    """Make sure paced frames show up sooner without extra misses."""
+    apprun.python_command(_TEST_CMD, purpose='frame pacing testing')
@@ -0,0 +1,97 @@
+# Released under the MIT License. See LICENSE for details.
+#
+"""Testing input latency instrumentation."""
+
+from __future__ import annotations
+
+import os
+import pytest
+
+from batools import apprun
+
+FAST_MODE = os.environ.get('BA_TEST_FAST_MODE') == '1'
+
+# Runs inside the app; drives the latency tracker through scripted event
+# sequences against a synthetic clock and checks what gets recorded.
+_TEST_CMD = """
+import _babase
+import _bascenev1
+
+stats = _babase.input_latency_stats(reset=True)
+assert set(stats) == {'dispatch', 'sim', 'frame', 'present', 'network'}, stats
+assert all(s['count'] == 0 for s in _babase.input_latency_stats().values())
+assert 'Late Input Sampling' in _babase.get_appconfig_builtin_keys()
+
+# Dispatch stats are over individual events.
+stats = _bascenev1.input_latency_simulate(
+    [('dispatch', 5000 + i * 1000, 4000) for i in range(4)]
+)['dispatch']
+assert stats['count'] == 4, stats
+assert (stats['mean_ms'], stats['p50_ms'], stats['max_ms']) == (
+    2.5, 3.0, 4.0
+), stats
+
+# Only the most recent samples count towards stats.
+stats = _bascenev1.input_latency_simulate(
+    [('dispatch', i, 0) for i in range(300)]
+)['dispatch']
+assert stats['count'] == 300, stats
+assert stats['max_ms'] == 0.299 and stats['p50_ms'] == 0.172, stats
+
+# The oldest event applied since the last step is what gets tracked
+# through sim, frame and present; steps and frames without new input
+# record nothing.
+stats = _bascenev1.input_latency_simulate(
+    [
+        ('sim', 500, 0),
+        ('frame', 600, 0),
+        ('consume', 1000, 1000),
+        ('consume', 2000, 2000),
+        ('sim', 5000, 0),
+        ('sim', 6000, 0),
+        ('frame', 9000, 0),
+        ('frame', 10000, 0),
+        ('present', 20000, 1000),
+        ('send', 3500, 2000),
+    ]
+)
+assert stats['sim']['count'] == 1 and stats['sim']['max_ms'] == 4.0, stats
+assert stats['frame']['count'] == 1 and stats['frame']['max_ms'] == 8.0
+assert stats['present']['max_ms'] == 19.0, stats
+assert stats['network']['max_ms'] == 1.5, stats
+
+# A frame built between two steps still picks up the first one's input
+# even if more comes in before the next step.
+stats = _bascenev1.input_latency_simulate(
+    [
+        ('consume', 1000, 1000),
+        ('sim', 2000, 0),
+        ('consume', 2500, 2500),
+        ('sim', 3000, 0),
+        ('frame', 4000, 0),
+        ('frame', 5000, 0),
+    ]
+)
+assert stats['sim']['count'] == 2 and stats['frame']['count'] == 1, stats
+assert stats['frame']['max_ms'] == 3.0, stats
+
+try:
+    _bascenev1.input_latency_simulate([('bogus', 0, 0)])
+except ValueError:
+    pass
+else:
+    raise RuntimeError('Expected ValueError.')
+"""
+
+
+@pytest.mark.skipif(
+    apprun.test_runs_disabled(), reason=apprun.test_runs_disabled_reason()
+)
+@pytest.mark.skipif(
+    apprun.test_bindings_disabled(),
+    reason=apprun.test_bindings_disabled_reason(),
+)
+@pytest.mark.skipif(FAST_MODE, reason='fast mode')
+def test_input_latency_tracking() -> None:
+    """Make sure input latency gets attributed to the right stages."""
+    apprun.python_command(_TEST_CMD, purpose='input latency testing')
@@ -0,0 +1,128 @@
+# Released under the MIT License. See LICENSE for details.
+#
+"""Testing mesh file loading functionality."""
+
+from __future__ import annotations
+
+import os
+import struct
+import tempfile
+
+import pytest
+
+from efro.error import CleanError
+from efrotools.pcommands import _align_bob_file
+from batools import apprun
+
+FAST_MODE = os.environ.get('BA_TEST_FAST_MODE') == '1'
+
+# Runs inside the app; writes the same small mesh in legacy and aligned
+# bob layouts and makes sure mapped and plain loads all agree.
+_TEST_CMD = """
+import os
+import struct
+import tempfile
+import _babase
+verts = b''.join(struct.pack('<3f2H3h2x', i, i * 2, i * 3, i, i, 1, 2, 3)
+                 for i in range(5))
+indices = struct.pack('<6H', 0, 1, 2, 2, 3, 4)
+legacy = struct.pack('<4I', 45623, 1, 5, 2) + verts + indices
+index_offset = (32 + len(verts) + 15) // 16 * 16
+aligned = bytearray(index_offset + len(indices))
+struct.pack_into('<8I', aligned, 0, 45624, 1, 1, 5, 2, 32, index_offset,
+                 len(aligned))
+aligned[32:32 + len(verts)] = verts
+aligned[index_offset:] = indices
+with tempfile.TemporaryDirectory() as tmpdir:
+    paths = []
+    for name, data in (('legacy', legacy), ('aligned', bytes(aligned))):
+        paths.append(os.path.join(tmpdir, name + '.bob'))
+        with open(paths[-1], 'wb') as outfile:
+            outfile.write(data)
+    sums = {(path, mapped): _babase.mesh_load_benchmark(
+                [path], mapped=mapped)['checksum']
+            for path in paths for mapped in (False, True)}
+    assert len(set(sums.values())) == 1, sums
+    result = _babase.mesh_load_benchmark(paths, iterations=2)
+    assert result['files'] == 4, result
+    bad = os.path.join(tmpdir, 'bad.bob')
+    with open(bad, 'wb') as outfile:
+        outfile.write(legacy[:-4])
+    try:
+        _babase.mesh_load_benchmark([bad])
+    except Exception:
+        pass
+    else:
+        raise RuntimeError('Expected truncated mesh to fail.')
+"""
+
+
+@pytest.mark.skipif(
+    apprun.test_runs_disabled(), reason=apprun.test_runs_disabled_reason()
+)
+@pytest.mark.skipif(FAST_MODE, reason='fast mode')
+def test_mesh_load() -> None:
+    """Make sure legacy and aligned meshes load identically."""
+    apprun.python_command(_TEST_CMD, purpose='mesh load testing')
+
+
+def _legacy_bob(vertex_count: int, face_count: int, mesh_format: int) -> bytes:
+    index_size = {0: 1, 1: 2, 2: 4}[mesh_format]
+    verts = bytes(range(256)) * (vertex_count * 24 // 256 + 1)
+    indices = bytes(reversed(range(256))) * (
+        face_count * 3 * index_size // 256 + 1
+    )
+    return (
+        struct.pack('<4I', 45623, mesh_format, vertex_count, face_count)
+        + verts[: vertex_count * 24]
+        + indices[: face_count * 3 * index_size]
+    )
+
+
+def test_align_bob_file() -> None:
+    """Make sure legacy bobs convert to the aligned layout losslessly."""
+    with tempfile.TemporaryDirectory() as tmpdir:
+        path = os.path.join(tmpdir, 'mesh.bob')
+        for vertex_count, face_count, mesh_format in [
+            (5, 2, 1),
+            (3, 1, 0),
+            (7, 4, 2),
+            (0, 0, 1),
+        ]:
+            legacy = _legacy_bob(vertex_count, face_count, mesh_format)
+            with open(path, 'wb') as outfile:
+                outfile.write(legacy)
+            _align_bob_file(path)
+            with open(path, 'rb') as infile:
+                aligned = infile.read()
+            header = struct.unpack_from('<8I', aligned)
+            fid, ver, fmt, vcount, fcount, voffs, ioffs, size = header
+            assert (fid, ver, fmt) == (45624, 1, mesh_format)
+            assert (vcount, fcount) == (vertex_count, face_count)
+            assert voffs % 16 == 0 and ioffs % 16 == 0
+            assert size == len(aligned)
+            vbytes = vertex_count * 24
+            assert ioffs >= voffs + vbytes
+            assert aligned[voffs : voffs + vbytes] == legacy[16 : 16 + vbytes]
+            assert aligned[ioffs:] == legacy[16 + vbytes :]
+
+            # Running again on an aligned file should change nothing.
+            _align_bob_file(path)
+            with open(path, 'rb') as infile:
+                assert infile.read() == aligned
+
+
+def test_align_bob_file_errors() -> None:
+    """Make sure malformed bobs are rejected rather than mangled."""
+    legacy = _legacy_bob(5, 2, 1)
+    bad_id = struct.pack('<I', 12345) + legacy[4:]
+    bad_format = legacy[:4] + struct.pack('<I', 7) + legacy[8:]
+    with tempfile.TemporaryDirectory() as tmpdir:
+        path = os.path.join(tmpdir, 'mesh.bob')
+        for data in (legacy[:-4], legacy + b'\0', bad_id, bad_format, b'ab'):
+            with open(path, 'wb') as outfile:
+                outfile.write(data)
+            with pytest.raises(CleanError):
+                _align_bob_file(path)
+            with open(path, 'rb') as infile:
+                assert infile.read() == data
@@ -0,0 +1,151 @@
+# Released under the MIT License. See LICENSE for details.
+#
+"""Testing precompiled Python bundle functionality."""
+
+from __future__ import annotations
+
+import os
+import struct
+import marshal
+import tempfile
+import importlib.util
+from typing import TYPE_CHECKING
+
+from batools.pybundle import build_python_bundle, BUNDLE_MAGIC
+
+
+if TYPE_CHECKING:
+    from typing import Any
+
+_ENV_PATH = os.path.join(
+    os.path.dirname(__file__),
+    '..',
+    '..',
+    'src',
+    'meta',
+    'bacoremeta',
+    'pyembed',
+    'env.py',
+)
+
+_FILES = {
+    'top.py': 'VAL = 1\n',
+    'pkg/__init__.py': 'VAL = 2\n',
+    'pkg/mod.py': 'VAL = 3\n',
+    'pkg/sub/__init__.py': '',
+    'notapkg/skipped.py': '',
+}
+
+
+def _write_sources(src: str) -> None:
+    for path, contents in _FILES.items():
+        os.makedirs(os.path.dirname(os.path.join(src, path)), exist_ok=True)
+        with open(os.path.join(src, path), 'w', encoding='utf-8') as f:
+            f.write(contents)
+
+
+def _read_bundle(data: bytes) -> dict[str, tuple[str, Any, bool, int, int]]:
+    """Parse a bundle the same way the native reader does."""
+    magic, _ver, pymagic, optimize, count, index_offset, size = (
+        struct.unpack('<8s6I', data[:32])
+    )
+    assert magic == BUNDLE_MAGIC
+    assert pymagic == struct.unpack('<I', importlib.util.MAGIC_NUMBER)[0]
+    assert optimize == 1
+    assert size == len(data)
+    entries = {}
+    for i in range(count):
+        start = index_offset + i * 40
+        noff, nsize, poff, psize, coff, csize, ispkg, mtime, fsize, _ = (
+            struct.unpack('<10I', data[start : start + 40])
+        )
+        entries[data[noff : noff + nsize].decode()] = (
+            data[poff : poff + psize].decode(),
+            marshal.loads(data[coff : coff + csize]),
+            bool(ispkg),
+            mtime,
+            fsize,
+        )
+    return entries
+
+
+def test_python_bundle_layout() -> None:
+    """Make sure bundles are laid out how the native reader expects."""
+    with tempfile.TemporaryDirectory() as tempdir:
+        src = os.path.join(tempdir, 'src')
+        _write_sources(src)
+        dst = os.path.join(tempdir, 'python.babundle')
+        assert build_python_bundle(src, dst, optimize=1) == 4
+        with open(dst, 'rb') as infile:
+            entries = _read_bundle(infile.read())
+        modstat = os.stat(os.path.join(src, 'pkg', 'mod.py'))
+
+    # Names must be bytewise sorted for the native binary search.
+    names = list(entries)
+    assert names == sorted(names, key=str.encode)
+    assert names == ['pkg', 'pkg.mod', 'pkg.sub', 'top']
+    assert entries['pkg'][0] == 'pkg/__init__.py' and entries['pkg'][2]
+    assert entries['pkg.mod'][0] == 'pkg/mod.py' and not entries['pkg.mod'][2]
+    assert entries['pkg.mod'][3:] == (
+        int(modstat.st_mtime),
+        modstat.st_size,
+    )
+
+    scope: dict = {}
+    exec(entries['pkg.mod'][1], scope)  # pylint: disable=exec-used
+    assert scope['VAL'] == 3
+
+
+def test_python_bundle_staleness() -> None:
+    """Make sure edited sources take precedence over bundled code."""
+    spec = importlib.util.spec_from_file_location('_test_env', _ENV_PATH)
+    assert spec is not None and spec.loader is not None
+    env = importlib.util.module_from_spec(spec)
+    spec.loader.exec_module(env)
+
+    with tempfile.TemporaryDirectory() as tempdir:
+        src = os.path.join(tempdir, 'src')
+        _write_sources(src)
+        dst = os.path.join(tempdir, 'python.babundle')
+        build_python_bundle(src, dst, optimize=1)
+        with open(dst, 'rb') as infile:
+            entries = _read_bundle(infile.read())
+
+        def _find(name: str) -> tuple[bool, str, int, int] | None:
+            entry = entries.get(name)
+            if entry is None:
+                return None
+            return entry[2], entry[0], entry[3], entry[4]
+
+        # pylint: disable=protected-access
+        importer = env._PythonBundleImporter(
+            src, _find, lambda name: entries[name][1]
+        )
+        assert importer.find_spec('notapkg.skipped') is None
+
+        modspec = importer.find_spec('pkg.mod')
+        assert modspec is not None and modspec.loader is importer
+        assert modspec.origin == os.path.join(src, 'pkg', 'mod.py')
+        module = importlib.util.module_from_spec(modspec)
+        importer.exec_module(module)
+        assert module.VAL == 3
+
+        pkgspec = importer.find_spec('pkg')
+        assert pkgspec is not None
+        assert pkgspec.submodule_search_locations == [os.path.join(src, 'pkg')]
+
+        # Changed contents, a changed mtime alone, or a missing source
+        # should all send us back to regular imports.
+        modpath = os.path.join(src, 'pkg', 'mod.py')
+        with open(modpath, 'w', encoding='utf-8') as outfile:
+            outfile.write('VAL = 33\n')
+        assert importer.find_spec('pkg.mod') is None
+
+        toppath = os.path.join(src, 'top.py')
+        topstat = os.stat(toppath)
+        os.utime(toppath, (topstat.st_atime, topstat.st_mtime + 10))
+        assert importer.find_spec('top') is None
+
+        os.remove(os.path.join(src, 'pkg', '__init__.py'))
+        assert importer.find_spec('pkg') is None
+        assert importer.find_spec('pkg.sub') is not None
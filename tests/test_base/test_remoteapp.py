@@ -0,0 +1,58 @@
+# Released under the MIT License. See LICENSE for details.
+#
+"""Testing remote app functionality."""
+
+from __future__ import annotations
+
+import os
+import pytest
+
+from batools import apprun
+
+FAST_MODE = os.environ.get('BA_TEST_FAST_MODE') == '1'
+
+# Runs inside the app; feeds v3 state packets through the same sequencer
+# the network reader uses and checks what gets applied and acked.
+_TEST_CMD = """
+import _bascenev1
+
+results = _bascenev1.remote_app_state_sequence_simulate(
+    [(1000, 5), (1005, 6), (1010, 7), (1021, 8), (1022, 7), (1023, 8),
+     (1030, 9)]
+)
+assert results == [
+    (True, True, 5),  # First state always gets acked.
+    (True, False, 6),  # Streaming; acks are rate limited...
+    (True, False, 7),
+    (True, True, 8),  # ...until the ack interval has passed.
+    (False, True, 8),  # Stale states are dropped but acked right away.
+    (False, True, 8),  # Same for repeats.
+    (True, False, 9),  # And they count towards the ack interval.
+], results
+
+# Sequence numbers wrap.
+results = _bascenev1.remote_app_state_sequence_simulate(
+    [(0, 0xFFFFFFFE), (100, 0xFFFFFFFF), (200, 0), (300, 1), (400, 0xFFFFFFFF)]
+)
+assert [r[0] for r in results] == [True, True, True, True, False], results
+assert [r[2] for r in results] == [0xFFFFFFFE, 0xFFFFFFFF, 0, 1, 1], results
+
+# Anything half the sequence space or more ahead counts as old.
+results = _bascenev1.remote_app_state_sequence_simulate(
+    [(0, 10), (100, 10 + 0x80000000), (200, 10 + 0x7FFFFFFF)]
+)
+assert [r[0] for r in results] == [True, False, True], results
+"""
+
+
+@pytest.mark.skipif(
+    apprun.test_runs_disabled(), reason=apprun.test_runs_disabled_reason()
+)
+@pytest.mark.skipif(
+    apprun.test_bindings_disabled(),
+    reason=apprun.test_bindings_disabled_reason(),
+)
+@pytest.mark.skipif(FAST_MODE, reason='fast mode')
+def test_remote_app_state_sequencing() -> None:
+    """Make sure v3 remote states are applied and acked correctly."""
+    apprun.python_command(_TEST_CMD, purpose='remote app testing')
@@ -0,0 +1,140 @@
+# Released under the MIT License. See LICENSE for details.
+#
+"""Testing the validating renderer."""
+
+from __future__ import annotations
+
+import os
+import pytest
+
+from batools import apprun
+
+FAST_MODE = os.environ.get('BA_TEST_FAST_MODE') == '1'
+
+# Runs inside the (headless) app; there's no validating renderer there so
+# these should politely decline.
+_TEST_CMD = """
+import _babase
+assert _babase.renderer_stats() is None
+assert _babase.renderer_stats(reset=True) is None
+assert _babase.renderer_capture('/tmp/nonexistent.ppm') is False
+"""
+
+# Runs inside the app; feeds hand-built command buffers through a fresh
+# validating renderer and checks what it counts, flags, and draws.
+_FRAME_TEST_CMD = """
+import os
+import tempfile
+import _bascenev1
+
+frame = _bascenev1.validating_renderer_frame
+
+def run():
+    commands = [
+        ('simple_color', [], [1, 0, 0]),
+        ('draw_screen_quad', [], []),
+        ('simple_color_transparent', [0], [0, 0, 1, 0.5]),
+        ('draw_screen_quad', [], []),
+        ('push_transform', [], []),
+        ('translate2', [], [3, 4]),
+        ('scale_uniform', [], [2]),
+        ('pop_transform', [], []),
+        ('simple_color_transparent', [0], [0, 0, 1, 0.5]),
+        ('simple_inline_color', [], [0, 1, 0, 0.25]),
+        ('draw_screen_quad', [], []),
+        # Shields don't show up in our flat rasterizing.
+        ('shield', [], []),
+        ('draw_screen_quad', [], []),
+    ]
+    with tempfile.TemporaryDirectory() as tempdir:
+        path = os.path.join(tempdir, 'frame.ppm')
+        res = frame(commands, (8, 4), path)
+
+        # Builds with a renderer of their own can't make another.
+        if res is None:
+            return
+        assert res['error'] == '', res
+        stats = res['stats']
+        expected = {
+            'frames': 1,
+            'command_buffers': 1,
+            'commands': 13,
+            'shader_binds': 4,
+            'shader_changes': 3,
+            'texture_refs': 0,
+            'draws': 4,
+            'triangles': 8,
+            'transform_ops': 4,
+            'scissor_pushes': 0,
+            'mesh_updates': 0,
+            'errors': 0,
+        }
+        for key, val in expected.items():
+            assert stats[key] == val, (key, stats)
+
+        # Red, then half blue over that, then a quarter green over that.
+        with open(path, 'rb') as infile:
+            assert infile.read() == b'P6\\n8 4\\n255\\n' + bytes(
+                [96, 64, 96]) * 32
+
+        # Same counts when we're not rasterizing, and nothing written.
+        res = frame(commands, (8, 4))
+        assert res is not None
+        for key, val in expected.items():
+            assert res['stats'][key] == val, (key, res)
+        assert os.listdir(tempdir) == ['frame.ppm']
+
+    # Malformed or unbalanced buffers get flagged.
+    for commands, error in [
+        ([('draw_screen_quad', [], [])], 'Draw with no shader bound.'),
+        ([('simple_color', [], [1, 0])], 'ran out of data'),
+        ([('simple_color', [], [1, 0, 0, 1])], 'unread data left over'),
+        ([('shader', [999], [])], 'Invalid shading type 999.'),
+        ([('pop_transform', [], [])], 'Transform pop with no transform'),
+        ([('push_transform', [], [])], 'left 1 transform(s) pushed.'),
+        ([('flip_cull_face', [], [])], 'left the cull face flipped.'),
+        ([('scissor_pop', [], [])], 'Scissor pop with no scissor'),
+        ([('simple_color', [], [1, 1, 1]),
+          ('object_inline_color', [], [1, 1, 1, 1])],
+         'Inline color for a shader that does not take one.'),
+    ]:
+        res = frame(commands, (4, 4))
+        assert res is not None
+        assert res['stats']['errors'] >= 1, (commands, res)
+        assert error in res['error'], (commands, res)
+
+    for args in [([('bogus', [], [])], (4, 4)),
+                 ([('simple_color', ['a'], [])], (4, 4)),
+                 ([], (0, 4)),
+                 ([], (4, 100000))]:
+        try:
+            frame(*args)
+        except Exception:
+            pass
+        else:
+            raise RuntimeError(f'Expected an error for {args}.')
+
+run()
+"""
+
+
+@pytest.mark.skipif(
+    apprun.test_runs_disabled(), reason=apprun.test_runs_disabled_reason()
+)
+@pytest.mark.skipif(FAST_MODE, reason='fast mode')
+def test_renderer_calls_without_renderer() -> None:
+    """Make sure renderer calls are safe with no validating renderer."""
+    apprun.python_command(_TEST_CMD, purpose='renderer testing')
+
+
+@pytest.mark.skipif(
+    apprun.test_runs_disabled(), reason=apprun.test_runs_disabled_reason()
+)
+@pytest.mark.skipif(
+    apprun.test_bindings_disabled(),
+    reason=apprun.test_bindings_disabled_reason(),
+)
+@pytest.mark.skipif(FAST_MODE, reason='fast mode')
+def test_command_buffer_frame() -> None:
+    """Make sure built command buffers get counted, checked, and drawn."""
+    apprun.python_command(_FRAME_TEST_CMD, purpose='renderer frame testing')
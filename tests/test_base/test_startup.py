@@ -0,0 +1,78 @@
+# Released under the MIT License. See LICENSE for details.
+#
+"""Testing startup timeline functionality."""
+
+from __future__ import annotations
+
+import os
+import pytest
+
+from batools import apprun
+
+FAST_MODE = os.environ.get('BA_TEST_FAST_MODE') == '1'
+
+# Runs inside the app; makes sure native phases got recorded, that
+# phases can be added and closed from Python, and that imports get timed.
+_TEST_CMD = """
+import sys
+import time
+import _babase
+import baenv
+report = _babase.startup_report()
+for name in ('core-import', 'start-app', 'logic-on-app-start'):
+    assert name in report, report
+_babase.startup_phase_begin('test-phase')
+_babase.startup_phase_end('test-phase')
+phases = {p[0]: p for p in _babase.startup_phases()}
+name, thread, start, end = phases['test-phase']
+assert end is not None and end >= start, phases['test-phase']
+
+# Phases timed on another clock get lined up with ours; ones from before
+# startup began get dropped.
+now = time.monotonic()
+_babase.startup_phases_add(
+    [
+        ('import:testmod', 'main', now - 0.5, now - 0.25),
+        ('import:ancient', 'main', now - 100000.0, now - 99999.0),
+    ],
+    now,
+)
+phases = {p[0]: p for p in _babase.startup_phases()}
+name, thread, start, end = phases['import:testmod']
+assert thread == 'main' and abs(end - start - 0.25) < 0.01, phases[name]
+assert 'import:ancient' not in phases
+try:
+    _babase.startup_phases_add([('bad', 'main', now, now - 1.0)], now)
+except ValueError:
+    pass
+else:
+    raise RuntimeError('Expected an error for a backwards phase.')
+
+# The import timer sees imports without leaving any trace on them.
+timer = baenv._ImportTimer()
+timer.MIN_DURATION = 0.0
+sys.modules.pop('colorsys', None)
+sys.meta_path.insert(0, timer)
+try:
+    import colorsys
+finally:
+    sys.meta_path.remove(timer)
+assert [r[0] for r in timer.records] == ['colorsys'], timer.records
+name, thread, start, end = timer.records[0]
+assert end >= start and thread, timer.records
+assert type(colorsys.__loader__).__name__ != '_TimedLoader'
+assert colorsys.__spec__.loader is colorsys.__loader__
+ready = _babase.mark_app_ready('test')
+assert ready >= 0.0
+assert _babase.mark_app_ready('test2') == ready
+assert _babase.app_ready_time() == ready
+"""
+
+
+@pytest.mark.skipif(
+    apprun.test_runs_disabled(), reason=apprun.test_runs_disabled_reason()
+)
+@pytest.mark.skipif(FAST_MODE, reason='fast mode')
+def test_startup_timeline() -> None:
+    """Make sure startup phases get recorded."""
+    apprun.python_command(_TEST_CMD, purpose='startup timeline testing')
@@ -0,0 +1,147 @@
+# Released under the MIT License. See LICENSE for details.
+#
+"""Testing the step profiler."""
+
+from __future__ import annotations
+
+import os
+import pytest
+
+from batools import apprun
+
+FAST_MODE = os.environ.get('BA_TEST_FAST_MODE') == '1'
+
+# Runs inside the app; feeds a fresh profiler samples on a synthetic
+# clock and checks what gets attributed where.
+_TEST_CMD = """
+import functools
+import babase
+import _bascenev1
+
+simulate = _bascenev1.step_profile_simulate
+
+def by_name(res):
+    return {e['name']: e for e in res['entries']}
+
+def close(a, b):
+    return abs(a - b) < 0.0000001
+
+# Only one of every 'interval' updates (and what follows it) is sampled.
+ops = []
+for _ in range(9):
+    ops += ['update', ('node step', 'prop', 100)]
+res = simulate(ops, interval=3)
+assert res['sampled_updates'] == 3 and res['total_updates'] == 9, res
+assert len(res['entries']) == 1, res
+prop = res['entries'][0]
+assert prop['category'] == 'node step' and prop['name'] == 'prop', prop
+assert prop['count'] == 3, prop
+assert close(prop['total'], 0.0003) and close(prop['max'], 0.0001), prop
+
+# Nothing is sampled before the first update.
+assert simulate([('node step', 'prop', 100)])['entries'] == []
+
+# Times are inclusive of whatever runs within them.
+def func():
+    pass
+
+res = simulate(['update', ('scene step', 'scene', 50, [
+    ('node step', 'spaz', 100, [('python call', func, 30)]),
+    ('node step', 'spaz', 20),
+])])
+assert [e['name'] for e in res['entries']][:2] == ['scene', 'spaz'], res
+entries = by_name(res)
+assert close(entries['scene']['total'], 0.0002), entries
+assert entries['spaz']['count'] == 2, entries
+assert close(entries['spaz']['total'], 0.00015), entries
+assert close(entries['spaz']['max'], 0.00013), entries
+assert len(res['entries']) == 3, res
+funcentry = res['entries'][2]
+assert funcentry['name'].startswith('func ('), funcentry
+assert close(funcentry['total'], 0.00003), funcentry
+
+# Python calls are attributed to the underlying function, however
+# they're wrapped; other callables are listed by type.
+class Foo:
+    def bar(self, val=None):
+        pass
+
+class Thing:
+    def __call__(self):
+        pass
+
+def baz(val):
+    pass
+
+foo1 = Foo()
+foo2 = Foo()
+res = simulate(['update',
+                ('python call', foo1.bar, 1),
+                ('python call', foo2.bar, 2),
+                ('python call', babase.Call(foo1.bar, 1), 3),
+                ('python call', babase.WeakCall(foo2.bar), 4),
+                ('python call', functools.partial(baz, 1), 5),
+                ('python call', Thing(), 6),
+                ('python call', Thing(), 7),
+                ('handlemessage', foo1.bar, 8)])
+names = [(e['category'], e['name'].split(' (')[0], e['count'])
+         for e in res['entries']]
+assert names == [('python call', 'Thing', 2), ('python call', 'Foo.bar', 4),
+                 ('handlemessage', 'Foo.bar', 1), ('python call', 'baz', 1)
+                 ], names
+assert by_name(res)['Thing (callable)']['count'] == 2, res
+
+# Resetting drops samples in flight as well as everything collected.
+res = simulate(['update', ('node step', 'a', 10, [
+    'reset', ('node step', 'b', 5),
+]), 'update', ('node step', 'c', 1)])
+assert [(e['name'], e['count']) for e in res['entries']] == [
+    ('b', 1), ('c', 1)], res
+assert res['total_updates'] == 1 and res['sampled_updates'] == 1, res
+
+# Stopping ends sampling; results stay.
+res = simulate(['update', ('node step', 'a', 10), 'stop',
+                ('node step', 'a', 10), 'update', ('node step', 'a', 10)])
+assert [(e['name'], e['count']) for e in res['entries']] == [('a', 1)], res
+assert res['total_updates'] == 1, res
+
+# Reports list the top entries with per-update times.
+ops = []
+for _ in range(4):
+    ops += ['update', ('node step', 'big', 3000), ('node step', 'small', 10)]
+report = simulate(ops, interval=2, max_entries=1)['report']
+lines = report.splitlines()
+assert lines[0] == 'Step profile: 2 of 4 updates sampled (every 2).', report
+assert len(lines) == 3, report
+assert lines[2].split() == ['6.00', '3.0000', '2', '3000', 'node', 'step',
+                            'big'], report
+assert simulate([], interval=2)['report'] == (
+    'Step profile: 0 of 0 updates sampled (every 2).\\n')
+
+for args in [
+    ([], 0),
+    (['update', ('not a category', 'a', 1)], 1),
+    (['not an op'], 1),
+    (['update', ('node step', 'a', -1)], 1),
+    ([('node step',)], 1),
+]:
+    try:
+        simulate(*args)
+    except Exception:
+        pass
+    else:
+        raise RuntimeError(f'Expected an error for {args}.')
+"""
+
+
+@pytest.mark.skipif(
+    apprun.test_runs_disabled(), reason=apprun.test_runs_disabled_reason()
+)
+@pytest.mark.skipif(
+    apprun.test_bindings_disabled(),
+    reason=apprun.test_bindings_disabled_reason(),
+)
+@pytest.mark.skipif(FAST_MODE, reason='fast mode')
+def test_step_profiler() -> None:
+    """Make sure logic time gets attributed to the right things."""
+    apprun.python_command(_TEST_CMD, purpose='step profiler testing')
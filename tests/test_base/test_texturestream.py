@@ -0,0 +1,72 @@
+# Released under the MIT License. See LICENSE for details.
+#
+"""Testing texture mip streaming functionality."""
+
+from __future__ import annotations
+
+import os
+import pytest
+
+from batools import apprun
+
+FAST_MODE = os.environ.get('BA_TEST_FAST_MODE') == '1'
+
+# Runs inside the app; checks mip ordering, per-frame budget adherence
+# and edge cases against the native scheduler.
+_TEST_CMD = """
+import _bascenev1
+
+def chain(width, height):
+    sizes = []
+    while True:
+        sizes.append(max(16, width * height))
+        if width == 1 and height == 1:
+            return sizes
+        width, height = max(1, width // 2), max(1, height // 2)
+
+# 2048x2048 at 1 MiB/frame: tail up front, then budget-limited frames
+# where a single oversized level may still go out alone.
+sizes = chain(2048, 2048)[:12]
+batches = _bascenev1.texture_stream_schedule(2048, 2048, sizes, 1024 * 1024)
+assert batches == [[11, 10, 9, 8, 7, 6, 5, 4], [3, 2], [1], [0]], batches
+for frame in batches[1:]:
+    assert len(frame) == 1 or sum(sizes[l] for l in frame) <= 1024 * 1024
+
+# A huge budget streams everything remaining in one frame.
+batches = _bascenev1.texture_stream_schedule(2048, 2048, sizes, 1 << 40)
+assert batches[1:] == [[3, 2, 1, 0]], batches
+
+# A tiny budget still makes progress one level at a time.
+batches = _bascenev1.texture_stream_schedule(2048, 2048, sizes, 1)
+assert batches[1:] == [[3], [2], [1], [0]], batches
+
+# Textures already within the tail size load fully up front.
+sizes = chain(128, 128)
+batches = _bascenev1.texture_stream_schedule(128, 128, sizes, 1024)
+assert batches == [list(reversed(range(len(sizes))))], batches
+
+# Non-square textures key off their larger dimension.
+sizes = chain(1024, 64)
+batches = _bascenev1.texture_stream_schedule(1024, 64, sizes, 1 << 40)
+assert batches[0][-1] == 3 and batches[1:] == [[2, 1, 0]], batches
+
+for args in ((0, 16, [16], 1), (16, 16, [16], 0), (16, 16, [-1], 1)):
+    try:
+        _bascenev1.texture_stream_schedule(*args)
+    except ValueError:
+        pass
+    else:
+        raise RuntimeError(f'Expected ValueError for {args}.')
+"""
+
+@pytest.mark.skipif(
+    apprun.test_runs_disabled(), reason=apprun.test_runs_disabled_reason()
+)
+@pytest.mark.skipif(
+    apprun.test_bindings_disabled(),
+    reason=apprun.test_bindings_disabled_reason(),
+)
+@pytest.mark.skipif(FAST_MODE, reason='fast mode')
+def test_texture_stream_schedule() -> None:
+    """Make sure streamed mips go smallest-first within budget."""
+    apprun.python_command(_TEST_CMD, purpose='texture stream testing')
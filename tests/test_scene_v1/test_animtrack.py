@@ -0,0 +1,107 @@
+# Released under the MIT License. See LICENSE for details.
+#
+"""Testing animtrack node interpolation."""
+
+from __future__ import annotations
+
+import os
+import pytest
+
+from batools import apprun
+
+FAST_MODE = os.environ.get('BA_TEST_FAST_MODE') == '1'
+
+# Runs inside the app; checks animtrack output against the behavior of an
+# animcurve node per channel (which is what animtrack replaces).
+_TEST_CMD = """
+import math
+import random
+import _bascenev1
+
+evaluate = _bascenev1.anim_track_evaluate
+
+def curve(times, values, time, loop, offset):
+    # A straight port of AnimCurveNode::GetOut().
+    count = min(len(times), len(values))
+    if count == 0:
+        return 0.0
+    start, end = times[0], times[count - 1]
+    t = time - offset
+    if end - start <= 0:
+        return values[0]
+    if loop:
+        t = math.fmod(t, end - start)
+        if t < 0:
+            t += end - start
+    elif t >= end:
+        return values[count - 1]
+    elif t <= start:
+        return values[0]
+    i2 = next((i for i in range(count) if times[i] >= t), count - 1)
+    i1 = max(i2 - 1, 0)
+    if times[i2] == times[i1]:
+        return values[i1]
+    return values[i1] + ((t - times[i1]) / (times[i2] - times[i1])
+                         * (values[i2] - values[i1]))
+
+def check(times, values, query_times, size=1, loop=False, offset=0.0):
+    results = evaluate(times, values, query_times, size=size, loop=loop,
+                       offset=offset)
+    assert len(results) == len(query_times)
+    count = min(len(times), len(values) // size)
+    for query_time, result in zip(query_times, results):
+        assert len(result) == size, result
+        for channel in range(size):
+            channel_values = values[channel:count * size:size]
+            expected = curve(times[:count], channel_values, query_time, loop,
+                             offset)
+            assert abs(result[channel] - expected) < 0.001, (
+                times, values, size, loop, offset, query_time, channel,
+                result, expected)
+
+# Simple cases, with exact values.
+assert evaluate([0, 100], [0.0, 1.0], [-50, 0, 25, 50, 100, 200]) == [
+    [0.0], [0.0], [0.25], [0.5], [1.0], [1.0]]
+assert evaluate([100, 200], [1, 2, 3, 5, 7, 9], [150], size=3) == [
+    [3.0, 4.5, 6.0]]
+assert evaluate([0, 100], [0, 10], [150, 250, -50], loop=True) == [
+    [5.0], [5.0], [5.0]]
+assert evaluate([0, 100], [0, 10], [100], offset=50.0) == [[5.0]]
+
+# Empty or single-key tracks.
+assert evaluate([], [], [0, 10], size=2) == [[0.0, 0.0], [0.0, 0.0]]
+assert evaluate([50], [3.0], [0, 50, 100], loop=True) == [
+    [3.0], [3.0], [3.0]]
+
+# Times without a full set of values are ignored.
+assert evaluate([0, 100, 200], [0, 0, 10, 10, 99], [150], size=2) == [
+    [10.0, 10.0]]
+
+# Random tracks, sampled moving forward (as scene time does), jumping
+# around, and sitting exactly on keys. Key times are never negative, as
+# with everything animate() creates.
+rng = random.Random(123)
+for _ in range(200):
+    size = rng.randint(1, 16)
+    count = rng.randint(1, 12)
+    times = sorted(rng.sample(range(0, 2500), count))
+    values = [rng.uniform(-10.0, 10.0) for _ in range(count * size)]
+    loop = rng.random() < 0.5
+    offset = rng.choice([0.0, rng.uniform(-300.0, 300.0)])
+    forward = list(range(-600, 4500, rng.randint(7, 90)))
+    jumps = [rng.randint(-1000, 5000) for _ in range(40)]
+    check(times, values, forward + jumps + times, size, loop, offset)
+"""
+
+
+@pytest.mark.skipif(
+    apprun.test_runs_disabled(), reason=apprun.test_runs_disabled_reason()
+)
+@pytest.mark.skipif(
+    apprun.test_bindings_disabled(),
+    reason=apprun.test_bindings_disabled_reason(),
+)
+@pytest.mark.skipif(FAST_MODE, reason='fast mode')
+def test_anim_track() -> None:
+    """Make sure animtrack nodes interpolate like animcurve nodes."""
+    apprun.python_command(_TEST_CMD, purpose='animtrack testing')
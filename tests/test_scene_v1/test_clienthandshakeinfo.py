@@ -0,0 +1,141 @@
+# Released under the MIT License. See LICENSE for details.
+#
+"""Testing binary client-info messages."""
+
+from __future__ import annotations
+
+import os
+import pytest
+
+from batools import apprun
+
+FAST_MODE = os.environ.get('BA_TEST_FAST_MODE') == '1'
+
+# Runs inside the app; makes sure what clients send comes out the same on
+# the host and that hosts reject anything malformed.
+_TEST_CMD = """
+import math
+import struct
+import _bascenev1
+encode = _bascenev1.client_handshake_info_encode
+decode = _bascenev1.client_handshake_info_decode
+
+def rejected(data):
+    try:
+        decode(data)
+    except ValueError:
+        return True
+    return False
+
+profiles = {
+    'Full': {
+        'character': 'Spaz',
+        'icon': 'x',
+        'color': [0.5, 0.25, 1.0],
+        'highlight': [1.0, 0.0, 0.5],
+        'global': True,
+    },
+    'Bare': {},
+    'Local': {'global': False, 'character': 'Zoe'},
+}
+data = encode(22457, 'token123', 'hash456', profiles)
+build, token, peer_hash, decoded = decode(data)
+assert (build, token, peer_hash) == (22457, 'token123', 'hash456')
+assert decoded == profiles, decoded
+
+# Values we can't represent get left out rather than sent.
+data = encode(1, 't', 'h', {
+    'Weird': {'color': [math.nan, 0.0, 0.0], 'icon': 5, 'highlight': [1]},
+    'x' * 1000: {},
+})
+assert decode(data)[3] == {'Weird': {}}, decode(data)
+
+# Anything truncated, padded, or mislabeled gets rejected.
+data = encode(22457, 'token123', 'hash456', profiles)
+assert all(rejected(data[:i]) for i in range(len(data)))
+assert rejected(data + b'\\0')
+assert rejected(bytes([21]) + data[1:])
+assert rejected(data[:1] + bytes([99]) + data[2:])
+
+# As do bad colors and strings.
+data = encode(1, 't', 'h', {'P': {'color': [0.5, 0.5, 0.5]}})
+assert data.count(struct.pack('=f', 0.5)) == 3
+inf = struct.pack('=f', math.inf)
+assert rejected(data.replace(struct.pack('=f', 0.5), inf))
+data = encode(1, 't', 'h', {'abc': {}})
+assert rejected(data.replace(b'abc', b'\\xff\\xfe\\xfd'))
+"""
+
+
+@pytest.mark.skipif(
+    apprun.test_runs_disabled(), reason=apprun.test_runs_disabled_reason()
+)
+@pytest.mark.skipif(
+    apprun.test_bindings_disabled(),
+    reason=apprun.test_bindings_disabled_reason(),
+)
+@pytest.mark.skipif(FAST_MODE, reason='fast mode')
+def test_client_handshake_info() -> None:
+    """Make sure binary client-info survives the trip and is validated."""
+    apprun.python_command(_TEST_CMD, purpose='client-info testing')
+
+
+# Runs inside the app; makes sure nothing a client sends while its
+# client-info is being decoded gets handled before that's applied.
+_HOLD_TEST_CMD = """
+import _bascenev1
+simulate = _bascenev1.client_message_hold_simulate
+CLIENT_INFO_BINARY = 22
+REQUEST_REMOTE_PLAYER = 4
+CHAT = 10
+info = bytes([CLIENT_INFO_BINARY, 1, 2, 3])
+join = bytes([REQUEST_REMOTE_PLAYER, 0])
+chat = bytes([CHAT]) + b'hi'
+
+# A join arriving during the decode waits and then sees the real build.
+res = simulate([info, join, 22456])
+assert res['handled'] == [(CLIENT_INFO_BINARY, 0),
+                          (REQUEST_REMOTE_PLAYER, 22456)], res
+assert not res['holding'] and not res['overflowed']
+
+# Order is kept, and things after the decode go straight through.
+res = simulate([info, chat, join, chat, 100, join])
+assert res['handled'] == [(CLIENT_INFO_BINARY, 0), (CHAT, 100),
+                          (REQUEST_REMOTE_PLAYER, 100), (CHAT, 100),
+                          (REQUEST_REMOTE_PLAYER, 100)], res
+
+# Still holding if the decode hasn't finished.
+res = simulate([info, join])
+assert res['handled'] == [(CLIENT_INFO_BINARY, 0)] and res['holding'], res
+
+# Nothing's held for clients that don't send binary client-info.
+res = simulate([join, chat])
+assert res['handled'] == [(REQUEST_REMOTE_PLAYER, 0), (CHAT, 0)], res
+
+# Floods during the decode get dropped instead of piling up.
+res = simulate([info] + [chat] * 1000 + [5])
+assert res['overflowed'] and res['handled'] == [(CLIENT_INFO_BINARY, 0)], res
+res = simulate([info, bytes([CHAT]) * 100000, 5])
+assert res['overflowed'] and res['handled'] == [(CLIENT_INFO_BINARY, 0)], res
+
+for events in [[5], [b''], [info, 'x']]:
+    try:
+        simulate(events)
+    except Exception:
+        pass
+    else:
+        raise RuntimeError(f'Expected an error for {events}.')
+"""
+
+
+@pytest.mark.skipif(
+    apprun.test_runs_disabled(), reason=apprun.test_runs_disabled_reason()
+)
+@pytest.mark.skipif(
+    apprun.test_bindings_disabled(),
+    reason=apprun.test_bindings_disabled_reason(),
+)
+@pytest.mark.skipif(FAST_MODE, reason='fast mode')
+def test_client_message_hold() -> None:
+    """Make sure joins during a client-info decode wait for it."""
+    apprun.python_command(_HOLD_TEST_CMD, purpose='client-info hold testing')
@@ -0,0 +1,52 @@
+# Released under the MIT License. See LICENSE for details.
+#
+"""Testing per-client limits."""
+
+from __future__ import annotations
+
+import os
+import pytest
+
+from bacommon.servermanager import ServerConfig
+from batools import apprun
+
+FAST_MODE = os.environ.get('BA_TEST_FAST_MODE') == '1'
+
+# Runs inside the app; makes sure throttled clients still get their acks
+# and disconnects through but nothing else.
+_TEST_CMD = """
+import _bascenev1
+handling = _bascenev1.client_throttled_handling
+keepalive = bytes([20, 1, 2, 3])
+disconnect = bytes([19])
+message = bytes([17, 1, 0, 1, 2, 3, 99])
+unreliable_message = bytes([18, 1, 0, 1, 0, 1, 2, 3, 99])
+handshake_response = bytes([16, 1, 2, 3])
+assert handling(keepalive) == 'full'
+assert handling(disconnect) == 'full'
+assert handling(message) == 'acks_only'
+assert handling(unreliable_message) == 'ignore'
+assert handling(handshake_response) == 'ignore'
+assert handling(b'') == 'ignore'
+"""
+
+
+def test_client_limit_defaults() -> None:
+    """Make sure server configs leave client limits off by default."""
+    config = ServerConfig()
+    assert config.client_process_ms_per_second is None
+    assert config.client_bytes_in_per_second is None
+    assert config.client_messages_in_per_second is None
+
+
+@pytest.mark.skipif(
+    apprun.test_runs_disabled(), reason=apprun.test_runs_disabled_reason()
+)
+@pytest.mark.skipif(
+    apprun.test_bindings_disabled(),
+    reason=apprun.test_bindings_disabled_reason(),
+)
+@pytest.mark.skipif(FAST_MODE, reason='fast mode')
+def test_client_throttled_handling() -> None:
+    """Make sure throttling never holds back acks or disconnects."""
+    apprun.python_command(_TEST_CMD, purpose='client limit testing')
@@ -0,0 +1,96 @@
+# Released under the MIT License. See LICENSE for details.
+#
+"""Testing batched collision callback events."""
+
+from __future__ import annotations
+
+import os
+import pytest
+
+from batools import apprun
+
+FAST_MODE = os.environ.get('BA_TEST_FAST_MODE') == '1'
+
+# Runs inside the app; checks the impulse collisions report and the
+# events batched calls and messages are handed.
+_TEST_CMD = """
+import _bascenev1
+import bascenev1
+
+def close(a, b):
+    return abs(a - b) < 0.001
+
+impulse = _bascenev1.collision_closing_impulse
+still = (0, 0, 0)
+
+# A body falling onto static ground has to lose all its momentum.
+assert close(impulse((1.0, (0, -2, 0), still), None, still, (0, 1, 0)), 2.0)
+assert close(impulse(None, (3.0, (0, -2, 0), still), still, (0, 1, 0)), 6.0)
+
+# Two bodies closing head on use their reduced mass.
+assert close(impulse((2.0, (1, 0, 0), still), (2.0, (-1, 0, 0), still),
+                     still, (1, 0, 0)), 2.0)
+assert close(impulse((1.0, (1, 0, 0), still), (3.0, (-1, 0, 0), still),
+                     still, (1, 0, 0)), 1.5)
+
+# Only motion along the normal counts.
+assert close(impulse((1.0, (5, 0, 0), still), None, still, (0, 1, 0)), 0.0)
+assert close(impulse((1.0, (3, -4, 0), still), None, still, (0, 2, 0)), 4.0)
+
+# Spin counts too, measured at the contact point.
+assert close(impulse((1.0, still, (0, 0, 1)), None, (1, 0, 0), (0, 1, 0)),
+             1.0)
+
+# Nothing moves when two static things touch.
+assert impulse(None, None, still, (0, 1, 0)) == 0.0
+
+events = _bascenev1.collision_event_list([
+    (2, (1, 2, 3), 0.25, 4.5),
+    (0, (-1, 0, 1), 0.5, 0.0),
+])
+assert len(events) == 2
+assert all(isinstance(e, bascenev1.CollisionEvent) for e in events)
+
+# Nodes that have died come through as None.
+assert events[0].sourcenode is None and events[0].opposingnode is None
+assert events[0].opposingbody == 2
+assert isinstance(events[0].position, bascenev1.Vec3)
+assert tuple(events[0].position) == (1.0, 2.0, 3.0)
+assert events[0].depth == 0.25 and events[0].impulse == 4.5
+assert events[1].opposingbody == 0
+assert tuple(events[1].position) == (-1.0, 0.0, 1.0)
+assert _bascenev1.collision_event_list([]) == []
+
+# Batched messages wrap the original message with a target's events.
+msg = bascenev1.DieMessage()
+batched = _bascenev1.batched_message(msg, [
+    (1, (0, 1, 0), 0.1, 2.0),
+    (3, (4, 5, 6), 0.2, 0.5),
+])
+assert isinstance(batched, bascenev1.BatchedMessage)
+assert batched.message is msg
+assert [e.opposingbody for e in batched.events] == [1, 3]
+assert tuple(batched.events[1].position) == (4.0, 5.0, 6.0)
+assert batched.events[0].impulse == 2.0
+assert _bascenev1.batched_message(msg, []).events == []
+for args in [(msg, [(1, (0, 0), 0.1, 2.0)]), (msg, 5)]:
+    try:
+        _bascenev1.batched_message(*args)
+    except Exception:
+        pass
+    else:
+        raise RuntimeError(f'Expected an error for {args}.')
+"""
+
+
+@pytest.mark.skipif(
+    apprun.test_runs_disabled(), reason=apprun.test_runs_disabled_reason()
+)
+@pytest.mark.skipif(
+    apprun.test_bindings_disabled(),
+    reason=apprun.test_bindings_disabled_reason(),
+)
+@pytest.mark.skipif(FAST_MODE, reason='fast mode')
+def test_collision_events() -> None:
+    """Make sure batched calls and messages get accurate events."""
+    apprun.python_command(_TEST_CMD, purpose='collision event testing')
@@ -0,0 +1,83 @@
+# Released under the MIT License. See LICENSE for details.
+#
+"""Testing material message delivery."""
+
+from __future__ import annotations
+
+import os
+import pytest
+
+from batools import apprun
+
+FAST_MODE = os.environ.get('BA_TEST_FAST_MODE') == '1'
+
+# Runs inside the app; checks which repeated material messages in a step
+# get coalesced and which always go out.
+_TEST_CMD = """
+import _bascenev1
+
+deliveries = _bascenev1.material_message_deliveries
+connect = False
+disconnect = True
+
+res = deliveries([
+    [
+        # Repeats of harmless messages to the same node pair are dropped,
+        # but different pairs and different actions still get theirs.
+        (0, ('flash',), connect, 1, 2),
+        (0, ('flash',), connect, 1, 2),
+        (0, ('flash',), connect, 1, 3),
+        (0, ('flash',), connect, 4, 2),
+        (1, ('flash',), connect, 1, 2),
+        (5, ('celebrate', 1000), connect, 1, 2),
+        (5, ('celebrate', 1000), connect, 1, 2),
+        (6, ('picked_up',), connect, 1, 2),
+        (6, ('picked_up',), connect, 1, 2),
+        (7, ('jump_sound',), connect, 1, -1),
+        (7, ('jump_sound',), connect, 1, -1),
+        # Receivers count footing messages, so every one goes out.
+        (2, ('footing', 1), connect, 1, 2),
+        (2, ('footing', 1), connect, 1, 2),
+        (2, ('footing', -1), disconnect, 1, 2),
+        (2, ('footing', -1), disconnect, 1, 2),
+        # As do messages where repeats have an effect.
+        (3, ('knockout', 100.0), connect, 1, 2),
+        (3, ('knockout', 100.0), connect, 1, 2),
+        # And anything at disconnect.
+        (4, ('hurt_sound',), disconnect, 1, 2),
+        (4, ('hurt_sound',), disconnect, 1, 2),
+    ],
+    # Each step starts over.
+    [
+        (0, ('flash',), connect, 1, 2),
+        (0, ('flash',), connect, 1, 2),
+    ],
+])
+assert res == [
+    [True, False, True, True, True, True, False, True, False, True, False,
+     True, True, True, True, True, True, True, True],
+    [True, False],
+], res
+
+for bad in [(0, ('not_a_message',), connect, 1, 2),
+            (0, (object(),), connect, 1, 2)]:
+    try:
+        deliveries([[bad]])
+    except Exception:
+        pass
+    else:
+        raise RuntimeError(f'Expected an error for {bad}.')
+"""
+
+
+@pytest.mark.skipif(
+    apprun.test_runs_disabled(), reason=apprun.test_runs_disabled_reason()
+)
+@pytest.mark.skipif(
+    apprun.test_bindings_disabled(),
+    reason=apprun.test_bindings_disabled_reason(),
+)
+@pytest.mark.skipif(FAST_MODE, reason='fast mode')
+def test_material_message_deliveries() -> None:
+    """Make sure only harmless repeat messages get coalesced."""
+    apprun.python_command(_TEST_CMD, purpose='material message testing')
@@ -0,0 +1,94 @@
+# Released under the MIT License. See LICENSE for details.
+#
+"""Testing native bot navigation."""
+
+from __future__ import annotations
+
+import os
+import pytest
+
+from batools import apprun
+
+FAST_MODE = os.environ.get('BA_TEST_FAST_MODE') == '1'
+
+# Runs inside the app; builds nav grids over simple standalone terrain
+# and checks paths, directions and line of sight.
+_TEST_CMD = """
+import math
+import _bascenev1
+
+def close(a, b):
+    return abs(a - b) < 0.001
+
+def vclose(a, b):
+    return all(close(x, y) for x, y in zip(a, b))
+
+def simulate(terrain, max_step=0.5, **kwargs):
+    return _bascenev1.nav_grid_simulate(
+        terrain, (0, -5, 0), (10, 5, 10), cell_size=1.0, max_step=max_step,
+        **kwargs)
+
+floor = ((5, -0.5, 5), (10, 1, 10))
+start = (1.5, 0, 5.5)
+end = (8.5, 0, 5.5)
+
+# A tall wall across the middle with gaps at either end; the gap nearest
+# z=10 is the shorter way around.
+wall = ((4.5, 1, 5), (1, 2, 8))
+res = simulate([floor, wall], paths=[(start, end), (start, (50, 0, 50))],
+               directions=[(start, end), ((1.2, 0, 1.5), (1.8, 0, 1.5)),
+                           (start, (50, 0, 50))],
+               sight_lines=[((2, 1, 5), (8, 1, 5)), ((2, 3, 5), (8, 3, 5)),
+                            ((2, 1, 0.5), (8, 1, 0.5))])
+assert res['width'] == 10 and res['depth'] == 10, res
+assert res['walkable'] == 100, res
+path, offgrid = res['paths']
+assert offgrid is None
+assert vclose(path[0], start), path
+assert vclose(path[-1], end), path
+assert all(close(p[1], 0.0) for p in path), path
+assert any(p[2] > 9.0 for p in path), path
+assert not any(4.0 < p[0] < 5.0 and 1.0 < p[2] < 9.0 for p in path), path
+around, same_cell, unreachable = res['directions']
+assert close(math.hypot(*around), 1.0), around
+assert around[1] > 0.5, around
+assert same_cell == (1.0, 0.0), same_cell
+assert unreachable is None
+assert res['sight_lines'] == [False, True, True], res
+
+# A fence too thin to stand on still splits the map, since neighbors only
+# link when nothing blocks the way between them.
+fence = ((5, 0.5, 5), (0.2, 1, 10))
+res = simulate([floor, fence], paths=[(start, end), (start, (3.5, 0, 1.5))],
+               directions=[(start, end)])
+assert res['walkable'] == 100, res
+assert res['paths'][0] is None, res
+path = res['paths'][1]
+assert vclose(path[0], start) and vclose(path[-1], (3.5, 0, 1.5)), path
+assert res['directions'] == [None], res
+
+# Small steps up are walkable; big ones aren't.
+step = ((7.5, 0.15, 5), (5, 0.3, 10))
+path = simulate([floor, step], paths=[(start, end)])['paths'][0]
+assert path is not None and close(path[-1][1], 0.3), path
+assert simulate([floor, step], max_step=0.2, paths=[(start, end)]) == {
+    'width': 10, 'depth': 10, 'walkable': 100, 'paths': [None],
+    'directions': [], 'sight_lines': []}
+
+# Holes in the floor aren't walkable.
+res = simulate([((5, -0.5, 2.5), (10, 1, 5))])
+assert res['walkable'] == 50, res
+"""
+
+
+@pytest.mark.skipif(
+    apprun.test_runs_disabled(), reason=apprun.test_runs_disabled_reason()
+)
+@pytest.mark.skipif(
+    apprun.test_bindings_disabled(),
+    reason=apprun.test_bindings_disabled_reason(),
+)
+@pytest.mark.skipif(FAST_MODE, reason='fast mode')
+def test_nav_grid() -> None:
+    """Make sure nav grids route around terrain the way bots should."""
+    apprun.python_command(_TEST_CMD, purpose='nav grid testing')
@@ -0,0 +1,64 @@
+# Released under the MIT License. See LICENSE for details.
+#
+"""Testing physics corrections for resting nodes."""
+
+from __future__ import annotations
+
+import os
+import pytest
+
+from batools import apprun
+
+FAST_MODE = os.environ.get('BA_TEST_FAST_MODE') == '1'
+
+# Runs inside the app; checks that resting nodes left out of periodic
+# corrections still get resent now and then, and spread out over time.
+_TEST_CMD = """
+import _bascenev1
+
+schedule = _bascenev1.resting_correction_schedule
+
+# Every resting node comes up again once per interval, forever.
+node_ids = [0, 1, 5, 9, 10, 11, 37, 123456789]
+sent = schedule(node_ids, 100)
+assert len(sent) == 100
+for node_id in node_ids:
+    turns = [num for num, due in enumerate(sent) if node_id in due]
+    assert turns, (node_id, sent)
+    assert turns[0] < 10, (node_id, turns)
+    assert all(b - a == 10 for a, b in zip(turns, turns[1:])), (node_id,
+                                                                turns)
+    assert len(turns) == 10, (node_id, turns)
+
+# Nodes take turns instead of all going out together.
+sent = schedule(range(50), 30)
+assert all(len(due) == 5 for due in sent), sent
+assert sorted(sum(sent[:10], [])) == list(range(50)), sent
+
+# Order of ids passed in is kept.
+assert schedule([20, 10, 0], 1) == [[20, 10, 0]]
+
+assert schedule([], 3) == [[], [], []]
+assert schedule([1, 2], 0) == []
+
+for args in [([1], -1), ([-1], 1), (['a'], 1), (5, 1)]:
+    try:
+        schedule(*args)
+    except Exception:
+        pass
+    else:
+        raise RuntimeError(f'Expected an error for {args}.')
+"""
+
+
+@pytest.mark.skipif(
+    apprun.test_runs_disabled(), reason=apprun.test_runs_disabled_reason()
+)
+@pytest.mark.skipif(
+    apprun.test_bindings_disabled(),
+    reason=apprun.test_bindings_disabled_reason(),
+)
+@pytest.mark.skipif(FAST_MODE, reason='fast mode')
+def test_resting_correction_schedule() -> None:
+    """Make sure resting nodes still get corrected now and then."""
+    apprun.python_command(_TEST_CMD, purpose='resting correction testing')
@@ -0,0 +1,100 @@
+# Released under the MIT License. See LICENSE for details.
+#
+"""Testing scene snapshot checks."""
+
+from __future__ import annotations
+
+import os
+import pytest
+
+from batools import apprun
+
+FAST_MODE = os.environ.get('BA_TEST_FAST_MODE') == '1'
+
+# Runs inside the app; builds snapshots by hand and checks which ones a
+# restore would accept before touching anything.
+_TEST_CMD = """
+import struct
+import _bascenev1
+
+check = _bascenev1.scene_snapshot_check
+
+# Null nodes (type id 0) have no attrs, which keeps hand-built chunks
+# simple: just empty resync data and a list of parts.
+NULL_TYPE = 0
+
+def part(bodies=()):
+    out = struct.pack('<qqqqI', 0, 0, 0, 0, len(bodies))
+    for body_id, has_body in bodies:
+        out += struct.pack('<iB', body_id, has_body)
+        if has_body:
+            out += struct.pack('<13fB', *([0.0] * 13), 1)
+    return out
+
+def null_chunk(parts=()):
+    return struct.pack('<II', 0, len(parts)) + b''.join(parts)
+
+def snapshot(chunks, timers=0, version=1, extra=b''):
+    out = struct.pack('<IIQqqI', 0x50414E53, version, 0, 1000, 10, timers)
+    out += struct.pack('<iqqqiB', 1, 0, 100, 100, 0, 0) * timers
+    out += struct.pack('<I', len(chunks))
+    for node_id, type_id, data in chunks:
+        out += struct.pack('<qiQI', node_id, type_id, 0, len(data)) + data
+    return out + extra
+
+def fails(snap, nodes):
+    try:
+        check(snap, nodes)
+    except Exception:
+        return True
+    return False
+
+live = [(1, 'null'), (2, 'null'), (3, 'math')]
+
+# Well formed snapshots pass, counting only nodes that are still around;
+# chunks for nodes that have died since aren't even looked at.
+good = snapshot([
+    (1, NULL_TYPE, null_chunk()),
+    (2, NULL_TYPE, null_chunk([part([(0, True), (1, False)]), part()])),
+    (7, 12345, b'whatever'),
+], timers=2)
+assert check(good, live) == 2
+assert check(good, []) == 0
+assert check(snapshot([]), live) == 0
+
+# A type mismatch anywhere rejects the whole snapshot, even after earlier
+# chunks checked out fine.
+assert fails(snapshot([(1, NULL_TYPE, null_chunk()),
+                       (2, NULL_TYPE, null_chunk()),
+                       (3, NULL_TYPE, null_chunk())]), live)
+assert not fails(snapshot([(1, NULL_TYPE, null_chunk()),
+                           (2, NULL_TYPE, null_chunk())]), live)
+
+# So does a chunk that doesn't read cleanly for its node's type.
+body = part([(0, True)])
+assert fails(snapshot([(1, NULL_TYPE, null_chunk()),
+                       (2, NULL_TYPE, null_chunk([body])[:-1])]), live)
+assert fails(snapshot([(1, NULL_TYPE, null_chunk()),
+                       (2, NULL_TYPE, null_chunk([body]) + b'x')]), live)
+assert fails(snapshot([(2, NULL_TYPE, struct.pack('<II', 0, 1))]), live)
+
+# As do bad headers or trailing data.
+assert fails(snapshot([], version=2), live)
+assert fails(snapshot([], extra=b'x'), live)
+assert fails(snapshot([(1, NULL_TYPE, null_chunk())])[:-1], live)
+assert fails(b'', live)
+assert fails(good, [(1, 'not_a_node_type')])
+"""
+
+
+@pytest.mark.skipif(
+    apprun.test_runs_disabled(), reason=apprun.test_runs_disabled_reason()
+)
+@pytest.mark.skipif(
+    apprun.test_bindings_disabled(),
+    reason=apprun.test_bindings_disabled_reason(),
+)
+@pytest.mark.skipif(FAST_MODE, reason='fast mode')
+def test_scene_snapshot_check() -> None:
+    """Make sure restores reject bad snapshots before changing anything."""
+    apprun.python_command(_TEST_CMD, purpose='scene snapshot testing')
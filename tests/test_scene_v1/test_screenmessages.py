@@ -0,0 +1,65 @@
+# Released under the MIT License. See LICENSE for details.
+#
+"""Testing screen messages sent to clients."""
+
+from __future__ import annotations
+
+import os
+import pytest
+
+from batools import apprun
+
+FAST_MODE = os.environ.get('BA_TEST_FAST_MODE') == '1'
+
+# Runs inside the app; makes sure each client build gets screen messages
+# in a format it understands.
+_TEST_CMD = """
+import json
+import babase
+import _bascenev1
+
+def jmessage(payload):
+    # Type byte, then null-terminated json.
+    assert payload[0] == 20 and payload[-1] == 0, payload
+    return json.loads(payload[1:-1])
+
+payloads = _bascenev1.screen_message_payloads
+
+# Clients that advertise batch support get all pending messages in one
+# batch.
+build = babase.app.env.engine_build_number
+res = payloads(['foo', 'bar'], build, 1)
+assert len(res) == 1, res
+msg = jmessage(res[0])
+assert msg['t'] == 1, msg
+assert [entry[0] for entry in msg['m']] == ['foo', 'bar'], msg
+
+# A lone message doesn't need batching.
+res = payloads(['foo'], build, 1)
+assert len(res) == 1 and jmessage(res[0])['t'] == 0, res
+
+# Clients that don't advertise it get them one at a time, whatever build
+# they report.
+for batch_format in [0, -1]:
+    res = payloads(['foo', 'bar'], build, batch_format)
+    assert len(res) == 2, res
+    assert [jmessage(p)['t'] for p in res] == [0, 0], res
+    assert [jmessage(p)['m'] for p in res] == ['foo', 'bar'], res
+
+# Ancient clients get them as chat messages.
+res = payloads(['foo', 'bar'], 14000, 1)
+assert len(res) == 2 and all(p[0] == 10 for p in res), res
+"""
+
+
+@pytest.mark.skipif(
+    apprun.test_runs_disabled(), reason=apprun.test_runs_disabled_reason()
+)
+@pytest.mark.skipif(
+    apprun.test_bindings_disabled(),
+    reason=apprun.test_bindings_disabled_reason(),
+)
+@pytest.mark.skipif(FAST_MODE, reason='fast mode')
+def test_screen_message_formats() -> None:
+    """Make sure clients only get batches when they can handle them."""
+    apprun.python_command(_TEST_CMD, purpose='screen message testing')
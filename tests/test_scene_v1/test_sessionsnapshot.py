@@ -0,0 +1,105 @@
+# Released under the MIT License. See LICENSE for details.
+#
+"""Testing compressed session snapshots."""
+
+from __future__ import annotations
+
+import os
+import pytest
+
+from batools import apprun
+
+FAST_MODE = os.environ.get('BA_TEST_FAST_MODE') == '1'
+
+# Runs inside the app; round-trips session-commands messages through the
+# snapshot codec and makes sure malformed snapshots get refused.
+_TEST_CMD = """
+import random
+import struct
+import _bascenev1
+
+compress = _bascenev1.session_snapshot_compress
+decompress = _bascenev1.session_snapshot_decompress
+
+def snapshot(size, stream, msgtype=23, fmt=1):
+    return bytes([msgtype, fmt]) + struct.pack('<I', size) + stream
+
+rng = random.Random(123)
+commands = [
+    b'\\x01',
+    b'\\x01abc',
+    b'\\x01' + bytes(100000),
+    b'\\x01' + bytes(rng.randrange(256) for _ in range(5000)),
+    b'\\x01' + b''.join(
+        struct.pack('<BiHf', rng.randrange(4), rng.randrange(50), 7, 1.5)
+        for _ in range(3000)
+    ),
+]
+
+# Everything comes back exactly as it went in, and repetitive stuff
+# (like full-state dumps) actually shrinks.
+for cmd in commands:
+    snap = compress(cmd)
+    assert snap[:2] == b'\\x17\\x01', snap[:2]
+    assert decompress(snap) == cmd, len(cmd)
+assert len(compress(commands[2])) < 1000
+assert len(compress(commands[4])) < len(commands[4]) // 2
+
+# Hand-built streams: a match copying earlier output, and one overlapping
+# what it produces.
+assert (
+    decompress(snapshot(8, b'\\x40\\x01abc\\x04\\x00\\x00'))
+    == b'\\x01abc' * 2
+)
+assert (
+    decompress(snapshot(12, b'\\x26\\x01a\\x01\\x00\\x00'))
+    == b'\\x01' + b'a' * 11
+)
+
+# Truncated anywhere.
+snap = compress(commands[4])
+for cut in range(len(snap)):
+    assert decompress(snap[:cut]) is None, cut
+
+# Match offsets of zero or reaching back before the start.
+assert decompress(snapshot(8, b'\\x40\\x01abc\\x00\\x00\\x00')) is None
+assert decompress(snapshot(8, b'\\x40\\x01abc\\x05\\x00\\x00')) is None
+
+# Output longer or shorter than the header says, and trailing junk.
+assert decompress(snapshot(7, b'\\x40\\x01abc\\x04\\x00\\x00')) is None
+assert decompress(snapshot(9, b'\\x40\\x01abc\\x04\\x00\\x00')) is None
+assert decompress(compress(commands[3]) + b'\\x10x') is None
+
+# Sizes no stream that short could expand to are refused up front.
+assert decompress(snapshot(48 * 1024 * 1024, b'\\x0f\\xff\\x00')) is None
+assert decompress(snapshot(0xFFFFFFFF, b'\\x00')) is None
+
+# Wrong message type, unknown formats, or something other than session
+# commands inside.
+assert decompress(b'\\x01' + compress(commands[1])[1:]) is None
+for fmt in [0, 2, 255]:
+    assert decompress(bytes([23, fmt]) + compress(commands[1])[2:]) is None
+assert decompress(compress(b'\\x02abc')) is None
+assert decompress(b'') is None and decompress(b'\\x17\\x01') is None
+
+# Random damage never gets past us as anything but None or bytes.
+for _ in range(2000):
+    bad = bytearray(snap)
+    for _ in range(rng.randrange(1, 4)):
+        bad[rng.randrange(6, len(bad))] = rng.randrange(256)
+    res = decompress(bytes(bad))
+    assert res is None or isinstance(res, bytes)
+"""
+
+
+@pytest.mark.skipif(
+    apprun.test_runs_disabled(), reason=apprun.test_runs_disabled_reason()
+)
+@pytest.mark.skipif(
+    apprun.test_bindings_disabled(),
+    reason=apprun.test_bindings_disabled_reason(),
+)
+@pytest.mark.skipif(FAST_MODE, reason='fast mode')
+def test_session_snapshot_codec() -> None:
+    """Make sure snapshots round-trip and bad ones get refused."""
+    apprun.python_command(_TEST_CMD, purpose='session snapshot testing')
@@ -0,0 +1,95 @@
+# Released under the MIT License. See LICENSE for details.
+#
+"""Testing native spatial queries."""
+
+from __future__ import annotations
+
+import os
+import pytest
+
+from batools import apprun
+
+FAST_MODE = os.environ.get('BA_TEST_FAST_MODE') == '1'
+
+# Runs inside the app; runs queries against standalone collision geoms
+# and checks what comes back and in what order.
+_TEST_CMD = """
+import _bascenev1
+
+def close(a, b):
+    return abs(a - b) < 0.001
+
+def vclose(a, b):
+    return all(close(x, y) for x, y in zip(a, b))
+
+query = _bascenev1.spatial_query_simulate
+geoms = [
+    (0, 'sphere', (0, 0, 0), (0.5, 0, 0)),
+    (1, 'sphere', (3, 0, 0), (0.5, 0, 0)),
+    (2, 'box', (-1.5, 0, 0), (1, 1, 1)),
+    # One body made of two geoms.
+    (3, 'sphere', (0, 0, 2), (0.5, 0, 0)),
+    (3, 'sphere', (0, 0, 6), (0.5, 0, 0)),
+]
+
+# Only overlapping bodies, nearest first, distance to body centers.
+hits = query(geoms, ('sphere', (0, 0, 0), 2.2))
+assert [h[0] for h in hits] == [0, 2, 3], hits
+assert [round(h[3], 3) for h in hits] == [0.0, 1.5, 2.0], hits
+assert vclose(hits[1][1], (-1.5, 0, 0)), hits
+assert all(h[2] == (0.0, 0.0, 0.0) for h in hits), hits
+
+# Bodies with several geoms hit show up once, at their nearest geom.
+hits = query(geoms, ('sphere', (0, 0, 0), 10.0))
+assert [h[0] for h in hits] == [0, 2, 3, 1], hits
+assert close(hits[2][3], 2.0), hits
+
+assert query(geoms, ('sphere', (50, 0, 0), 1.0)) == []
+
+hits = query(geoms, ('box', (3, 0, 0), (1, 1, 1)))
+assert [h[0] for h in hits] == [1], hits
+hits = query(geoms, ('box', (0, 0, 4), (1, 1, 9)))
+assert [h[0] for h in hits] == [3, 0], hits
+assert close(hits[0][3], 2.0), hits
+
+# Rays report where they hit with normals facing back along the ray.
+hits = query(geoms, ('ray', (-5, 0, 0), (2, 0, 0), 20.0))
+assert [h[0] for h in hits] == [2, 0, 1], hits
+assert [round(h[3], 3) for h in hits] == [3.0, 4.5, 7.5], hits
+assert vclose(hits[0][1], (-2, 0, 0)), hits
+assert vclose(hits[0][2], (-1, 0, 0)), hits
+assert vclose(hits[2][2], (-1, 0, 0)), hits
+assert query(geoms, ('ray', (-5, 0, 0), (1, 0, 0), 2.0)) == []
+
+# Terrain isn't in the collision space but still gets hit.
+ground = [(9, 'terrain', (0, -1, 0), (20, 0, 20))]
+hits = query(geoms + ground, ('ray', (0, 5, 0), (0, -1, 0), 10.0))
+assert [h[0] for h in hits] == [0, 9], hits
+assert [round(h[3], 3) for h in hits] == [4.5, 6.0], hits
+assert vclose(hits[0][2], (0, 1, 0)), hits
+assert vclose(hits[1][1], (0, -1, 0)), hits
+assert vclose(hits[1][2], (0, 1, 0)), hits
+hits = query(geoms + ground, ('sphere', (5, -1, 5), 0.5))
+assert [h[0] for h in hits] == [9], hits
+assert query(geoms + ground, ('sphere', (50, -1, 5), 0.5)) == []
+
+try:
+    query(geoms, ('cone', (0, 0, 0), 1.0))
+except ValueError:
+    pass
+else:
+    raise RuntimeError('Expected ValueError.')
+"""
+
+
+@pytest.mark.skipif(
+    apprun.test_runs_disabled(), reason=apprun.test_runs_disabled_reason()
+)
+@pytest.mark.skipif(
+    apprun.test_bindings_disabled(),
+    reason=apprun.test_bindings_disabled_reason(),
+)
+@pytest.mark.skipif(FAST_MODE, reason='fast mode')
+def test_spatial_queries() -> None:
+    """Make sure queries find the right bodies in the right order."""
+    apprun.python_command(_TEST_CMD, purpose='spatial query testing')
@@ -0,0 +1,127 @@
+# Released under the MIT License. See LICENSE for details.
+#
+"""Testing state hashing for determinism checks."""
+
+from __future__ import annotations
+
+import os
+import pytest
+
+from batools import apprun
+
+FAST_MODE = os.environ.get('BA_TEST_FAST_MODE') == '1'
+
+# Runs inside the app; hashes standalone rigid bodies as they step and
+# feeds the resulting logs through the determinism check's reporting.
+_TEST_CMD = """
+import logging
+import _bascenev1
+from baclassic._benchmark import _report_state_divergence
+
+simulate = _bascenev1.state_hash_simulate
+
+bodies = [
+    (1, (0, 5, 0), (1, 0, 0), (0, 0, 0)),
+    (2, (3, 5, 0), (0, 2, 0), (0, 1, 0)),
+    (3, (6, 5, 0), (0, 0, -1), (2, 0, 0)),
+]
+
+# Identical inputs give identical logs.
+log = simulate(bodies, 20)
+assert simulate(bodies, 20) == log
+assert [s[0] for s in log['steps']] == list(range(1, 21)), log
+assert all(sorted(s[2]) == [1, 2, 3] for s in log['steps']), log
+assert log['nodes'] == {1: 'body 1', 2: 'body 2', 3: 'body 3'}, log
+
+# Any change to a body's position, velocity or spin shows up in its
+# hash (and the overall one) from the first step on, without touching
+# the others.
+for changed in [
+    (2, (3, 5.01, 0), (0, 2, 0), (0, 1, 0)),
+    (2, (3, 5, 0), (0, 2.01, 0), (0, 1, 0)),
+    (2, (3, 5, 0), (0, 2, 0), (0, 1.01, 0)),
+]:
+    other = simulate([bodies[0], changed, bodies[2]], 20)
+    for (_, hash1, nodes1), (_, hash2, nodes2) in zip(log['steps'],
+                                                      other['steps']):
+        assert hash1 != hash2
+        assert nodes1[1] == nodes2[1] and nodes1[3] == nodes2[3]
+        assert nodes1[2] != nodes2[2]
+
+# The same bodies in a different order hash differently overall.
+reordered = simulate([bodies[1], bodies[0], bodies[2]], 20)
+assert reordered['steps'][0][2] == log['steps'][0][2]
+assert reordered['steps'][0][1] != log['steps'][0][1]
+
+class Capture(logging.Handler):
+    def __init__(self):
+        super().__init__(logging.INFO)
+        self.messages = []
+
+    def emit(self, record):
+        self.messages.append((record.levelno, record.getMessage()))
+
+def report(first, second, max_nodes=10):
+    capture = Capture()
+    logger = logging.getLogger()
+    oldlevel = logger.level
+    logger.addHandler(capture)
+    logger.setLevel(logging.INFO)
+    try:
+        _report_state_divergence(first, second, max_nodes=max_nodes)
+    finally:
+        logger.removeHandler(capture)
+        logger.setLevel(oldlevel)
+    assert len(capture.messages) == 1, capture.messages
+    return capture.messages[0]
+
+assert report(log, simulate(bodies, 20)) == (
+    logging.INFO, 'Determinism check: runs matched for all 20 steps.')
+
+# Bodies that only start to differ part way through are caught at the
+# step they diverge.
+late = simulate(bodies[:2], 10)
+late['steps'] += simulate(bodies[:2] + [(3, (6, 9, 0), (0, 0, 0),
+                                          (0, 0, 0))], 20)['steps'][10:]
+late['nodes'][3] = 'body 3'
+early = simulate(bodies[:2], 20)
+assert report(early, late) == (
+    logging.WARNING, 'Determinism check: runs diverged at step 11;'
+    ' 1 node(s) differ:\\n  body 3 (only in second run)')
+
+changed = simulate([bodies[0], (2, (3, 5, 0), (0, 2.01, 0), (0, 1, 0)),
+                    (3, (6, 5, 0), (0, 0, -1), (2, 0, 0.01))], 20)
+assert report(log, changed) == (
+    logging.WARNING, 'Determinism check: runs diverged at step 1;'
+    ' 2 node(s) differ:\\n  body 2\\n  body 3')
+assert report(log, changed, max_nodes=1) == (
+    logging.WARNING, 'Determinism check: runs diverged at step 1;'
+    ' 2 node(s) differ:\\n  body 2\\n  ...and 1 more')
+
+assert report(log, simulate(bodies, 15)) == (
+    logging.WARNING, 'Determinism check: runs matched but lasted different'
+    ' numbers of steps (20 vs 15).')
+
+for args in [([(1, (0, 0), (0, 0, 0), (0, 0, 0))], 1),
+             ([(1, (0, 0, 0), (0, 0, 0), (0, 0, 0))], -1),
+             (5, 1)]:
+    try:
+        simulate(*args)
+    except Exception:
+        pass
+    else:
+        raise RuntimeError(f'Expected an error for {args}.')
+"""
+
+
+@pytest.mark.skipif(
+    apprun.test_runs_disabled(), reason=apprun.test_runs_disabled_reason()
+)
+@pytest.mark.skipif(
+    apprun.test_bindings_disabled(),
+    reason=apprun.test_bindings_disabled_reason(),
+)
+@pytest.mark.skipif(FAST_MODE, reason='fast mode')
+def test_state_hash() -> None:
+    """Make sure state hashes and divergence reports track real changes."""
+    apprun.python_command(_TEST_CMD, purpose='state hash testing')
@@ -0,0 +1,94 @@
+# Released under the MIT License. See LICENSE for details.
+#
+"""Testing terrain collisions with triangle lists kept between steps."""
+
+from __future__ import annotations
+
+import os
+import pytest
+
+from batools import apprun
+
+FAST_MODE = os.environ.get('BA_TEST_FAST_MODE') == '1'
+
+# Runs inside the app; moves geoms over terrain and checks that colliding
+# them the way a step does (reusing triangle lists) finds exactly what
+# straight collides with nothing reused do.
+_TEST_CMD = """
+import random
+import _bascenev1
+
+simulate = _bascenev1.terrain_contact_simulate
+
+def check_same(res):
+    assert len(res['cached']) == len(res['plain'])
+    for stepnum, (cached, plain) in enumerate(zip(res['cached'],
+                                                  res['plain'])):
+        assert len(cached) == len(plain), (stepnum, cached, plain)
+        for (i1, pos1, norm1, depth1), (i2, pos2, norm2, depth2) in zip(
+                cached, plain):
+            assert i1 == i2, (stepnum, cached, plain)
+            for val1, val2 in zip(pos1 + norm1 + (depth1,),
+                                  pos2 + norm2 + (depth2,)):
+                assert abs(val1 - val2) < 0.00001, (stepnum, cached, plain)
+    return sum(len(step) for step in res['cached'])
+
+terrain = [
+    ((0, 0, 0), (20, 0, 20)),
+    ((3, 1, 0), (2, 2, 2)),
+    ((-4, 0.5, 2), (3, 1, 1)),
+]
+
+# Resting, creeping, fast and falling geoms, plus ones that grow while
+# sitting on terrain (their old triangle lists have to be dropped).
+res = simulate(terrain, [
+    ('sphere', (0, 0.4, 0), (0.5, 0, 0), (0, 0, 0), 0.0),
+    ('box', (1, 0.2, 1), (0.6, 0.6, 0.6), (0.5, 0, 0), 0.0),
+    ('sphere', (-6, 0.3, 2), (0.4, 0, 0), (3, 0, 0), 0.0),
+    ('sphere', (5, 3, 5), (0.5, 0, 0), (0, -2, 0), 0.0),
+    ('sphere', (2, 1.9, 0.5), (0.2, 0, 0), (0.05, 0, 0), 0.01),
+    ('box', (-4, 1.05, 2), (0.3, 0.3, 0.3), (0, 0, 0.1), 0.02),
+], 120)
+assert check_same(res) > 0
+assert any(contact[0] == 0 for contact in res['cached'][0]), res
+assert res['cached_time'] >= 0.0 and res['plain_time'] >= 0.0
+
+# Lots of geoms wandering around at random.
+rng = random.Random(123)
+geoms = []
+for _ in range(200):
+    geoms.append((rng.choice(['sphere', 'box']),
+                  (rng.uniform(-9, 9), rng.uniform(0, 3), rng.uniform(-9, 9)),
+                  (rng.uniform(0.1, 0.8), rng.uniform(0.1, 0.8),
+                   rng.uniform(0.1, 0.8)),
+                  (rng.uniform(-3, 3), rng.uniform(-1, 0), rng.uniform(-3, 3)),
+                  rng.choice([0.0, 0.0, 0.0, 0.005])))
+assert check_same(simulate(terrain, geoms, 60)) > 0
+
+assert simulate(terrain, [], 5)['cached'] == [[]] * 5
+assert simulate([], geoms, 2)['cached'] == [[], []]
+
+for args in [(terrain, [('cone', (0, 0, 0), (1, 1, 1), (0, 0, 0), 0.0)], 1),
+             (terrain, [('sphere', (0, 0), (1, 1, 1), (0, 0, 0), 0.0)], 1),
+             (terrain, [], -1),
+             ([((0, 0, 0),)], [], 1)]:
+    try:
+        simulate(*args)
+    except Exception:
+        pass
+    else:
+        raise RuntimeError(f'Expected an error for {args}.')
+"""
+
+
+@pytest.mark.skipif(
+    apprun.test_runs_disabled(), reason=apprun.test_runs_disabled_reason()
+)
+@pytest.mark.skipif(
+    apprun.test_bindings_disabled(),
+    reason=apprun.test_bindings_disabled_reason(),
+)
+@pytest.mark.skipif(FAST_MODE, reason='fast mode')
+def test_terrain_contacts() -> None:
+    """Make sure reused triangle lists don't change terrain contacts."""
+    apprun.python_command(_TEST_CMD, purpose='terrain contact testing')
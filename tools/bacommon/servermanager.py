@@ -41,6 +41,20 @@ class ServerConfig:
     # Whether the default kick-voting system is enabled.
     enable_default_kick_voting: bool = True
 
+    # Limits on what each connected client can cost the server per
+    # second: milliseconds of processing its traffic, bytes it sends us,
+    # and messages it sends us. Clients over a limit are ignored for the
+    # rest of that second, and ones that stay over for
+    # client_limit_strikes_to_kick seconds in a row get kicked and banned
+    # for client_limit_ban_seconds. The limits themselves are off (None)
+    # by default; something like 50.0, 200000, and 1000 respectively is a
+    # reasonable starting point if you need them.
+    client_process_ms_per_second: float | None = None
+    client_bytes_in_per_second: int | None = None
+    client_messages_in_per_second: int | None = None
+    client_limit_strikes_to_kick: int = 5
+    client_limit_ban_seconds: int = 300
+
     # To be included in the public server list, your server MUST be
     # accessible via an ipv4 address. By default, the master server will
     # try to use the address your server contacts it from, but this may
@@ -200,6 +214,12 @@ class ServerConfig:
     # modules on demand could cause visual hitches.
     dont_write_bytecode: bool = False
 
+    # If present, the server writes a small json file at this path once
+    # it is up and hosting (containing the time it took to get there).
+    # Orchestration tools can watch for this file instead of guessing at
+    # startup delays. Any existing file is removed at launch.
+    ready_file: str | None = None
+
 
 # NOTE: as much as possible, communication from the server-manager to
 # the child-process should go through these and not ad-hoc Python string
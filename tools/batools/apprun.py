@@ -35,6 +35,23 @@ def test_runs_disabled_reason() -> str:
     return 'App test runs disabled here.'
 
 
+def test_bindings_disabled() -> bool:
+    """Are native test bindings missing from the binaries we'd run?
+
+    Hooks for driving engine internals from tests are only compiled into
+    debug and test builds, so prefab release builds don't have them.
+    """
+    return os.environ.get('BA_APP_RUN_ENABLE_BUILDS') != '1'
+
+
+def test_bindings_disabled_reason() -> str:
+    """Why are test bindings unavailable here?"""
+    return (
+        'Native test bindings need local debug builds'
+        ' (set BA_APP_RUN_ENABLE_BUILDS=1).'
+    )
+
+
 def acquire_binary_for_python_command(purpose: str) -> str:
     """Run acquire_binary as used for python_command call."""
     return acquire_binary(assets=True, purpose=purpose)
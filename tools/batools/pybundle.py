@@ -0,0 +1,151 @@
+# Released under the MIT License. See LICENSE for details.
+#
+"""Functionality for building precompiled Python module bundles.
+
+A bundle packs marshalled code objects for a tree of Python modules into
+a single file which the engine memory-maps at launch and imports from
+directly (see core/python/python_bundle.h for the reader side). The
+bundle sits next to the source dir it was built from; for example
+ba_data/python.babundle for ba_data/python.
+"""
+
+from __future__ import annotations
+
+import os
+import struct
+import marshal
+import importlib.util
+
+BUNDLE_MAGIC = b'BAPYBNDL'
+BUNDLE_VERSION = 2
+
+# Header: magic, version, python-magic, optimize, entry-count,
+# index-offset, data-size.
+_HEADER_FORMAT = '<8s6I'
+
+# Entry: name offset/size, path offset/size, code offset/size,
+# is-package, source mtime/size, reserved.
+_ENTRY_FORMAT = '<10I'
+
+
+def gather_modules(src_dir: str) -> list[tuple[str, str, bool]]:
+    """Return (module-name, relative-path, is-package) for a source tree.
+
+    Only includes modules reachable through regular packages (dirs with
+    an __init__.py); anything else is left to normal imports.
+    """
+    modules: list[tuple[str, str, bool]] = []
+    for root, dirnames, filenames in os.walk(src_dir):
+        reldir = os.path.relpath(root, src_dir)
+        parts = [] if reldir == '.' else reldir.split(os.sep)
+
+        # Don't descend into non-package dirs (or caches).
+        dirnames[:] = sorted(
+            d
+            for d in dirnames
+            if d != '__pycache__'
+            and os.path.exists(os.path.join(root, d, '__init__.py'))
+        )
+        for fname in sorted(filenames):
+            if not fname.endswith('.py'):
+                continue
+            relpath = '/'.join(parts + [fname])
+            stem = fname[:-3]
+            if stem == '__init__':
+                if not parts:
+                    continue
+                modules.append(('.'.join(parts), relpath, True))
+            else:
+                modules.append(('.'.join(parts + [stem]), relpath, False))
+    return modules
+
+
+def build_python_bundle(src_dir: str, dst_path: str, optimize: int) -> int:
+    """Compile a tree of Python modules into a bundle file.
+
+    Modules are compiled with the running interpreter, so this must be
+    the same Python version the engine embeds (the engine ignores
+    bundles with a mismatched bytecode magic number). The mtime and size
+    of each source file are recorded so the engine can skip entries
+    whose source has since changed. Returns the number of modules
+    written.
+    """
+    # pylint: disable=too-many-locals
+    modules = gather_modules(src_dir)
+
+    # Names are looked up with a bytewise binary search.
+    modules.sort(key=lambda m: m[0].encode())
+
+    strings = bytearray()
+    codes = bytearray()
+    entries: list[tuple[int, int, int, int, int, int, bool, int, int]] = []
+    for name, relpath, is_package in modules:
+        srcpath = os.path.join(src_dir, *relpath.split('/'))
+        with open(srcpath, 'rb') as infile:
+            source = infile.read()
+            stat = os.fstat(infile.fileno())
+        code = compile(
+            source, relpath, 'exec', dont_inherit=True, optimize=optimize
+        )
+        codedata = marshal.dumps(code)
+        namedata = name.encode()
+        pathdata = relpath.encode()
+        entries.append(
+            (
+                len(strings),
+                len(namedata),
+                len(strings) + len(namedata),
+                len(pathdata),
+                len(codes),
+                len(codedata),
+                is_package,
+                int(stat.st_mtime) & 0xFFFFFFFF,
+                stat.st_size & 0xFFFFFFFF,
+            )
+        )
+        strings += namedata + pathdata
+        codes += codedata
+
+    header_size = struct.calcsize(_HEADER_FORMAT)
+    entry_size = struct.calcsize(_ENTRY_FORMAT)
+    index_offset = header_size
+    strings_offset = index_offset + entry_size * len(entries)
+    codes_offset = strings_offset + len(strings)
+    data_size = codes_offset + len(codes)
+
+    out = bytearray(
+        struct.pack(
+            _HEADER_FORMAT,
+            BUNDLE_MAGIC,
+            BUNDLE_VERSION,
+            struct.unpack('<I', importlib.util.MAGIC_NUMBER)[0],
+            optimize,
+            len(entries),
+            index_offset,
+            data_size,
+        )
+    )
+    for entry in entries:
+        out += struct.pack(
+            _ENTRY_FORMAT,
+            strings_offset + entry[0],
+            entry[1],
+            strings_offset + entry[2],
+            entry[3],
+            codes_offset + entry[4],
+            entry[5],
+            1 if entry[6] else 0,
+            entry[7],
+            entry[8],
+            0,
+        )
+    out += strings
+    out += codes
+    assert len(out) == data_size
+
+    # Write atomically so a running engine never maps a partial file.
+    tmppath = f'{dst_path}.tmp'
+    with open(tmppath, 'wb') as outfile:
+        outfile.write(out)
+    os.replace(tmppath, dst_path)
+    return len(entries)
@@ -51,6 +51,7 @@ class BuildStager:
         self.include_collision_meshes = True
         self.include_scripts = True
         self.include_python = True
+        self.include_python_bundle = False
         self.include_textures = True
         self.include_fonts = True
         self.include_json = True
@@ -117,6 +118,9 @@ class BuildStager:
         # Legacy assets going into ba_data.
         self._sync_ba_data_legacy()
 
+        # Precompiled bundle of our scripts (or lack thereof).
+        self._sync_python_bundle()
+
         # New asset-package stuff going into ba_data.
         if self.asset_package_flavor is not None:
             self._sync_ba_data_new()
@@ -202,6 +206,10 @@ class BuildStager:
             self.include_textures = False
             self.include_audio = False
             self.include_meshes = False
+            # Release servers import our scripts from a precompiled
+            # bundle; debug ones stick to regular imports for easy
+            # iteration.
+            self.include_python_bundle = not self.debug
             # Link/copy in a binary *if* builddir is provided.
             self.include_binary_executable = self.builddir is not None
             self.executable_name = 'ballisticakit_headless'
@@ -565,6 +573,26 @@ class BuildStager:
         self._purge_pycache_dirs(f'{self.dst}/ba_data/')
         subprocess.run(cmd, check=True)
 
+    def _sync_python_bundle(self) -> None:
+        from batools.pybundle import build_python_bundle
+
+        assert self.dst is not None
+        bundlepath = f'{self.dst}/ba_data/python.babundle'
+        if not self.include_python_bundle:
+            if os.path.exists(bundlepath):
+                os.remove(bundlepath)
+            return
+
+        count = build_python_bundle(
+            f'{self.dst}/ba_data/python',
+            bundlepath,
+            optimize=0 if self.debug else 1,
+        )
+        print(
+            f'{Clr.BLU}Wrote Python bundle with {count} modules.{Clr.RST}',
+            flush=True,
+        )
+
     def _sync_ba_data_new(self) -> None:
         # pylint: disable=too-many-locals
         import json
@@ -173,6 +173,24 @@ class LogHandler(logging.Handler):
         while not self._thread_bootstrapped:
             time.sleep(0.001)
 
+    def reinit_after_fork(self) -> None:
+        """Get things working again in a forked child process.
+
+        Only the forking thread survives a fork, so our background
+        thread (and anything it was in the middle of) is gone. This
+        spins up a fresh one. Entries still in flight to the old thread
+        at fork time are lost.
+        """
+        self._cache_lock = Lock()
+        self._file_chunk_ship_task = {'stdout': None, 'stderr': None}
+        self._thread_bootstrapped = False
+        self._thread = Thread(
+            target=self._log_thread_main, daemon=self._thread.daemon
+        )
+        self._thread.start()
+        while not self._thread_bootstrapped:
+            time.sleep(0.001)
+
     def add_callback(
         self, call: Callable[[LogEntry], None], feed_existing_logs: bool = False
     ) -> None:
@@ -555,6 +555,73 @@ def compile_mesh_file() -> None:
 
     assert os.path.exists(dst)
 
+    # Rewrite into the aligned layout the engine can use straight from a
+    # memory mapping.
+    _align_bob_file(dst)
+
+
+def _align_bob_file(path: str) -> None:
+    """Convert a legacy bob file in-place to the aligned bob layout.
+
+    Aligned files have a 32 byte header (id, version, mesh-format,
+    vertex-count, face-count, vertex-offset, index-offset, total-size)
+    with vertex and index data each starting on a 16 byte boundary.
+    Files already in the aligned layout are left alone.
+    """
+    import struct
+    from efro.error import CleanError
+
+    bob_file_id = 45623
+    bob_aligned_file_id = 45624
+    bob_aligned_version = 1
+    alignment = 16
+    vertex_size = 24
+    index_sizes = {0: 1, 1: 2, 2: 4}
+
+    with open(path, 'rb') as infile:
+        data = infile.read()
+    if len(data) < 16:
+        raise CleanError(f'Not a valid bob file: \'{path}\'.')
+    file_id, mesh_format, vertex_count, face_count = struct.unpack_from(
+        '<4I', data
+    )
+    if file_id == bob_aligned_file_id:
+        return
+    if file_id != bob_file_id or mesh_format not in index_sizes:
+        raise CleanError(f'Not a valid bob file: \'{path}\'.')
+
+    def _align(val: int) -> int:
+        return (val + alignment - 1) // alignment * alignment
+
+    vertex_bytes = vertex_count * vertex_size
+    index_bytes = face_count * 3 * index_sizes[mesh_format]
+    if len(data) != 16 + vertex_bytes + index_bytes:
+        raise CleanError(f'Unexpected size for bob file: \'{path}\'.')
+    vertex_offset = _align(32)
+    index_offset = _align(vertex_offset + vertex_bytes)
+    total_size = index_offset + index_bytes
+
+    out = bytearray(total_size)
+    struct.pack_into(
+        '<8I',
+        out,
+        0,
+        bob_aligned_file_id,
+        bob_aligned_version,
+        mesh_format,
+        vertex_count,
+        face_count,
+        vertex_offset,
+        index_offset,
+        total_size,
+    )
+    out[vertex_offset : vertex_offset + vertex_bytes] = data[
+        16 : 16 + vertex_bytes
+    ]
+    out[index_offset:] = data[16 + vertex_bytes :]
+    with open(path, 'wb') as outfile:
+        outfile.write(out)
+
 
 def compile_collision_mesh_file() -> None:
     """Compile a mesh file."""